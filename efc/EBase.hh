@@ -17,10 +17,12 @@
 #include "libc/inc/eso_buffer.h"
 #include "libc/inc/eso_canonicalize.h"
 #include "libc/inc/eso_conf.h"
+#include "libc/inc/eso_cpu.h"
 #include "libc/inc/eso_crc32.h"
 #include "libc/inc/eso_datetime.h"
 #include "libc/inc/eso_dso.h"
 #include "libc/inc/eso_debug.h"
+#include "libc/inc/eso_dtoa.h"
 #include "libc/inc/eso_encode.h"
 #include "libc/inc/eso_file.h"
 #include "libc/inc/eso_flip_buffer.h"
@@ -28,8 +30,10 @@
 #include "libc/inc/eso_hash.h"
 #include "libc/inc/eso_ini.h"
 #include "libc/inc/eso_json.h"
+#include "libc/inc/eso_jsonsimd.h"
 #include "libc/inc/eso_libc.h"
 #include "libc/inc/eso_locale_str.h"
+#include "libc/inc/eso_lz4.h"
 #include "libc/inc/eso_lz77.h"
 #include "libc/inc/eso_lzma.h"
 #include "libc/inc/eso_map.h"
@@ -52,6 +56,7 @@
 #include "libc/inc/eso_sigsegv.h"
 #include "libc/inc/eso_stack.h"
 #include "libc/inc/eso_string.h"
+#include "libc/inc/eso_strsimd.h"
 #include "libc/inc/eso_sys.h"
 #include "libc/inc/eso_thread.h"
 #include "libc/inc/eso_thread_cond.h"
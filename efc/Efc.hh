@@ -27,6 +27,11 @@
 #include "./inc/EBitSet.hh"
 #include "./inc/EBson.hh"
 #include "./inc/EBsonParser.hh"
+#include "./inc/EBsonView.hh"
+#include "./inc/EJsonValue.hh"
+#include "./inc/EJsonHandler.hh"
+#include "./inc/EJsonParser.hh"
+#include "./inc/EJsonWriter.hh"
 #include "./inc/EBoolean.hh"
 #include "./inc/EBufferedInputStream.hh"
 #include "./inc/EBufferedOutputStream.hh"
@@ -48,6 +53,7 @@
 #include "./inc/ECondition.hh"
 #include "./inc/EConfig.hh"
 #include "./inc/ECRC32.hh"
+#include "./inc/ECRC32C.hh"
 #include "./inc/EDataFormatException.hh"
 #include "./inc/EDatagramPacket.hh"
 #include "./inc/EDatagramSocket.hh"
@@ -60,6 +66,8 @@
 #include "./inc/EDeflaterOutputStream.hh"
 #include "./inc/EDeque.hh"
 #include "./inc/EDictionary.hh"
+#include "./inc/EDigestInputStream.hh"
+#include "./inc/EDigestOutputStream.hh"
 #include "./inc/EDouble.hh"
 #include "./inc/EFlushable.hh"
 #include "./inc/EEmptyStackException.hh"
@@ -78,6 +86,7 @@
 #include "./inc/EFilenameFilter.hh"
 #include "./inc/EFileNotFoundException.hh"
 #include "./inc/EFork.hh"
+#include "./inc/EHashing.hh"
 #include "./inc/EHashMap.hh"
 #include "./inc/EHashSet.hh"
 #include "./inc/EIllegalArgumentException.hh"
@@ -105,11 +114,16 @@
 #include "./inc/EList.hh"
 #include "./inc/ELLong.hh"
 #include "./inc/ELock.hh"
+#include "./inc/ELZ4InputStream.hh"
+#include "./inc/ELZ4OutputStream.hh"
+#include "./inc/ELZMAInputStream.hh"
+#include "./inc/ELZMAOutputStream.hh"
 #include "./inc/EMalformedURLException.hh"
 #include "./inc/EMap.hh"
 #include "./inc/EMatcher.hh"
 #include "./inc/EMatchResult.hh"
 #include "./inc/EMath.hh"
+#include "./inc/EMessageDigest.hh"
 #include "./inc/ENavigableMap.hh"
 #include "./inc/ENavigableSet.hh"
 #include "./inc/ENetWrapper.hh"
@@ -165,6 +179,7 @@
 #include "./inc/EStack.hh"
 #include "./inc/EStream.hh"
 #include "./inc/EString.hh"
+#include "./inc/EStringPool.hh"
 #include "./inc/EStringTokenizer.hh"
 #include "./inc/ESynchronizeable.hh"
 #include "./inc/ESystem.hh"
@@ -248,14 +263,21 @@
 #include "./nio/inc/EChannelInputStream.hh"
 #include "./nio/inc/EClosedChannelException.hh"
 #include "./nio/inc/EClosedSelectorException.hh"
+#include "./nio/inc/ECompletionHandler.hh"
+#include "./nio/inc/ECompositeByteBuffer.hh"
+#include "./nio/inc/EConnectionHandler.hh"
 #include "./nio/inc/EConnectionPendingException.hh"
 #include "./nio/inc/EDatagramChannel.hh"
+#include "./nio/inc/EDomainServerSocketChannel.hh"
+#include "./nio/inc/EDomainSocketChannel.hh"
 #include "./nio/inc/EFileChannel.hh"
 #include "./nio/inc/EFileDispatcher.hh"
 #include "./nio/inc/EFileKey.hh"
 #include "./nio/inc/EFileLock.hh"
 #include "./nio/inc/EInvalidMarkException.hh"
 #include "./nio/inc/EIOByteBuffer.hh"
+#include "./nio/inc/EIOByteBufferPool.hh"
+#include "./nio/inc/EIOUring.hh"
 #include "./nio/inc/EMappedByteBuffer.hh"
 #include "./nio/inc/EMembershipKey.hh"
 #include "./nio/inc/EMulticastChannel.hh"
@@ -263,15 +285,21 @@
 #include "./nio/inc/ENonReadableChannelException.hh"
 #include "./nio/inc/ENonWritableChannelException.hh"
 #include "./nio/inc/EOverlappingFileLockException.hh"
+#include "./nio/inc/EPipeChannel.hh"
 #include "./nio/inc/EReadOnlyBufferException.hh"
+#include "./nio/inc/EReactor.hh"
+#include "./nio/inc/EReactorGroup.hh"
 #include "./nio/inc/ESelectableChannel.hh"
 #include "./nio/inc/ESelectionKey.hh"
+#include "./nio/inc/ESelectionKeyConsumer.hh"
 #include "./nio/inc/ESelector.hh"
 #include "./nio/inc/EServerSocketChannel.hh"
 #include "./nio/inc/ESocketChannel.hh"
+#include "./nio/inc/ETimerWheel.hh"
 
 //efc::cpp11
 #include "./inc/cpp11/EScopeGuard.hh"
+#include "./inc/cpp11/EStructBinding.hh"
 
 using namespace efc;
 using namespace efc::nio;
@@ -18,6 +18,12 @@
 
 #define HAVE_EPOLL   //linux epoll
 
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define HAVE_IO_URING //linux io_uring, used if the running kernel has it
+#endif
+#endif
+
 #elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) //bsd
 
 #define __bsd__
@@ -100,6 +100,21 @@ public:
 	EBigInteger(const char* val);
 	EBigInteger(const EBigInteger& that);
 
+	/**
+	 * Translates the String representation of a BigInteger in the
+	 * specified radix into a BigInteger.  The String representation
+	 * consists of an optional minus or plus sign followed by a
+	 * sequence of one or more digits in the specified radix.
+	 *
+	 * @param val String representation of BigInteger.
+	 * @param radix radix to be used in interpreting {@code val}.
+	 * @throws NumberFormatException {@code val} is not a valid representation
+	 *         of a BigInteger in the specified radix, or {@code radix} is
+	 *         outside the range from {@link Character#MIN_RADIX} to
+	 *         {@link Character#MAX_RADIX}, inclusive.
+	 */
+	EBigInteger(const char* val, int radix);
+
 	/**
 	 *
 	 */
@@ -107,7 +122,9 @@ public:
 	void setSign(boolean negative);
 
 	/**
-	 *
+	 * Returns the decimal digits of the magnitude, least significant
+	 * first.  The vector is a snapshot owned by this object and rebuilt
+	 * on each call, changing it doesn't change the value.
 	 */
 	EVector<int>* getNumber();
 
@@ -177,6 +194,81 @@ public:
 	 */
 	EA<EBigInteger*> divideAndRemainder(EBigInteger& b);
 
+	/**
+	 * Returns a BigInteger whose value is <tt>(this<sup>exponent</sup>)</tt>.
+	 * Note that {@code exponent} is an integer rather than a BigInteger.
+	 *
+	 * @param  exponent exponent to which this BigInteger is to be raised.
+	 * @return <tt>this<sup>exponent</sup></tt>
+	 * @throws ArithmeticException {@code exponent} is negative.
+	 */
+	EBigInteger pow(int exponent);
+
+	/**
+	 * Returns a BigInteger whose value is
+	 * <tt>(this<sup>exponent</sup> mod m)</tt>.  (Unlike {@code pow}, this
+	 * method permits negative exponents.)
+	 *
+	 * <p>Odd moduli use Montgomery multiplication, all moduli a sliding
+	 * window over the exponent bits.  The running time depends on the
+	 * exponent, it is not meant to hide a secret exponent from timing.
+	 *
+	 * @param  exponent the exponent.
+	 * @param  m the modulus.
+	 * @return <tt>this<sup>exponent</sup> mod m</tt>
+	 * @throws ArithmeticException {@code m} &le; 0 or the exponent is
+	 *         negative and this BigInteger is not <i>relatively
+	 *         prime</i> to {@code m}.
+	 */
+	EBigInteger modPow(EBigInteger& exponent, EBigInteger& m);
+
+	/**
+	 * Returns a BigInteger whose value is {@code (this}<sup>-1</sup> {@code mod m)}.
+	 *
+	 * @param  m the modulus.
+	 * @return {@code this}<sup>-1</sup> {@code mod m}.
+	 * @throws ArithmeticException {@code  m} &le; 0, or this BigInteger
+	 *         has no multiplicative inverse mod m (that is, this BigInteger
+	 *         is not <i>relatively prime</i> to m).
+	 */
+	EBigInteger modInverse(EBigInteger& m);
+
+	/**
+	 * Returns a BigInteger whose value is {@code (this << n)}.
+	 * The shift distance, {@code n}, may be negative, in which case
+	 * this method performs a right shift.
+	 */
+	EBigInteger shiftLeft(int n);
+
+	/**
+	 * Returns a BigInteger whose value is {@code (this >> n)}.  Sign
+	 * extension is performed.  The shift distance, {@code n}, may be
+	 * negative, in which case this method performs a left shift.
+	 */
+	EBigInteger shiftRight(int n);
+
+	/**
+	 * Returns the number of bits in the minimal two's-complement
+	 * representation of this BigInteger, <i>excluding</i> a sign bit.
+	 */
+	int bitLength();
+
+	/**
+	 * Returns {@code true} if and only if the designated bit is set.
+	 * (Computes {@code ((this & (1<<n)) != 0)}.)
+	 *
+	 * @throws ArithmeticException {@code n} is negative.
+	 */
+	boolean testBit(int n);
+
+	/**
+	 * Returns the signum function of this BigInteger.
+	 *
+	 * @return -1, 0 or 1 as the value of this BigInteger is negative, zero or
+	 *         positive.
+	 */
+	int signum();
+
 	/**
 	 * Returns a BigInteger whose value is the absolute value of this
 	 * BigInteger.
@@ -185,6 +277,14 @@ public:
 	 */
 	EBigInteger abs();
 
+	/**
+	 * Returns the String representation of this BigInteger in the
+	 * given radix.  If the radix is outside the range from {@link
+	 * Character#MIN_RADIX} to {@link Character#MAX_RADIX} inclusive,
+	 * it will default to 10.
+	 */
+	EString toString(int radix);
+
 	virtual int hashCode();
 	virtual EString toString();
 	virtual int compareTo(EBigInteger* val);
@@ -196,10 +296,40 @@ public:
 	virtual double doubleValue();
 
 private:
+	class RadixPowers;
+
 	boolean sign;		//true - negative | false - positive
-	EStack<int> num;	//reverse integer array
+	es_uint32_t* mag;	//magnitude, little endian 32-bit words
+	int len;			//words in use, 0 for zero
+	int cap;			//words allocated
+	EStack<int>* num;	//decimal digits snapshot of getNumber()
+
+	es_uint32_t* alloc(int n);
+	void normalize();
+	void parse(const char* s, int radix);
+	EBigInteger slice(int from, int to) const;
+	int compareMagnitude(const EBigInteger& b) const;
 
-	void ltrimZero(EStack<int>& num);
+	static void addTo(EBigInteger& r, const EBigInteger& a,
+			const EBigInteger& b, boolean bsign);
+	static void multiplyTo(EBigInteger& r, const EBigInteger& a,
+			const EBigInteger& b);
+	static void divideTo(const EBigInteger& a, const EBigInteger& b,
+			EBigInteger* q, EBigInteger* r);
+	static EBigInteger multiplyToomCook3(const EBigInteger& a,
+			const EBigInteger& b);
+	static EBigInteger montgomeryPow(EBigInteger& base,
+			EBigInteger& exponent, EBigInteger& m);
+	static EBigInteger windowPow(EBigInteger& base,
+			EBigInteger& exponent, EBigInteger& m);
+	static void smallToString(EBigInteger& u, EString& sb, int radix,
+			int digits);
+	static void toString(EBigInteger& u, EString& sb, int radix,
+			int digits, RadixPowers& powers);
+	static void smallParse(EBigInteger& r, const char* s, int n,
+			int radix);
+	static void parse(EBigInteger& r, const char* s, int n, int radix,
+			RadixPowers& powers);
 };
 
 } /* namespace efc */
@@ -13,6 +13,7 @@
 #include "EIOException.hh"
 #include "ERuntimeException.hh"
 #include "ENumberFormatException.hh"
+#include "EDataFormatException.hh"
 #include "ENoSuchElementException.hh"
 
 namespace efc {
@@ -112,6 +113,15 @@ public:
 	static float nodeGetFloat(es_bson_node_t *node, float defaultValue) THROWS(ENumberFormatException);
 	static double nodeGetDouble(es_bson_node_t *node, double defaultValue) THROWS(ENumberFormatException);
 
+	/**
+	 * Converts a value by its data type like the node getters do, the string
+	 * values include the terminating '\0'.  A varint not ending within
+	 * <code>size</code> throws <code>EDataFormatException</code>.
+	 */
+	static EString valueGetString(int dtype, const void *data, es_size_t size) THROWS(EDataFormatException);
+	static llong valueGetLLong(int dtype, const void *data, es_size_t size) THROWS2(ENumberFormatException, EDataFormatException);
+	static double valueGetDouble(int dtype, const void *data, es_size_t size) THROWS2(ENumberFormatException, EDataFormatException);
+
 	static es_bson_node_t* nodeUpdate(es_bson_node_t *node, const char *key, const char *str);
 	static es_bson_node_t* nodeUpdate(es_bson_node_t *node, const char *key, const void *data, es_size_t size);
 	static es_bson_node_t* nodeUpdateFormat(es_bson_node_t *node, const char *key, const char *fmt, ...);
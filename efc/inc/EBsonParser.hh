@@ -14,30 +14,95 @@
 
 namespace efc {
 
+namespace nio {
+class EIOByteBuffer;
+}
+
+/**
+ * Parses a stream of bson documents.
+ *
+ * <p>A parser created with an input stream pulls the bytes and blocks in
+ * nextBson() until a document is complete.  A parser created without
+ * stream is push style: the bytes are given to feed() in chunks of any
+ * size, e.g. as they come from a non-blocking channel, and nextBson()
+ * never blocks, it parses what has been fed and resumes there next time.
+ *
+ * <pre>
+ * EBsonParser parser(64 * 1024);
+ * EBson bson;
+ * ...
+ * channel->read(buffer);
+ * buffer->flip();
+ * parser.feed(buffer);
+ * buffer->compact();
+ * while (parser.nextBson(&bson)) {
+ *     ...
+ * }
+ * </pre>
+ */
 class EBsonParser: public EObject {
 public:
 	virtual ~EBsonParser();
 
 	EBsonParser(EInputStream* is);
 
+	/**
+	 * Creates a push parser.
+	 *
+	 * @param maxBuffered  0 for no limit, or the bounded memory mode: the
+	 * fed bytes not parsed yet are limited to maxBuffered, and the nodes
+	 * are dropped from the bson once parsed and the parsing() events of
+	 * their following nodes are done, so the bson only keeps the path to
+	 * the last node and the documents must be read by parsing().
+	 */
+	explicit
+	EBsonParser(int maxBuffered=0);
+
 	// unsupported.
 	EBsonParser(const EBsonParser& that);
 	// unsupported.
 	EBsonParser& operator= (const EBsonParser& that);
 
+	/**
+	 * Gets the next document.
+	 *
+	 * <p>In push mode it returns false when the bytes fed are used up
+	 * before the document is complete, the next call with the same bson
+	 * resumes it.
+	 *
+	 * @throws EDataFormatException in bounded memory mode if a node larger
+	 * than maxBuffered is met.
+	 */
 	boolean nextBson(EBson* bson) THROWS(EDataFormateException);
 
+	/**
+	 * Push mode: appends the next bytes of the stream.
+	 *
+	 * @return the number of bytes taken, less than size only in bounded
+	 * memory mode; the buffer's position is advanced by this number.
+	 */
+	int feed(const void* data, int size);
+	int feed(nio::EIOByteBuffer* buffer);
+
+	/**
+	 * Returns the number of bytes fed but not parsed yet.
+	 */
+	int buffered();
+
 	virtual void parsing(es_bson_node_t* node) {};
 
 protected:
 	EInputStream* _is;
 	EBson* _bson;
+	int _maxBuffered;
 
 	struct Stream {
 		es_bson_stream_t stm;
 		EBsonParser* self;
 	} _es;
 
+	boolean nextPushed(EBson* bson);
+
 	static es_int32_t stream_read(void *s, void *buf, es_size_t *size);
 	static void parsed_node(void *s, es_bson_t *bson, es_bson_node_t *node);
 };
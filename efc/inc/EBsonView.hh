@@ -0,0 +1,143 @@
+/*
+ * EBsonView.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EBSONVIEW_HH_
+#define EBSONVIEW_HH_
+
+#include "EBson.hh"
+
+namespace efc {
+
+namespace nio {
+class EIOByteBuffer;
+}
+
+/**
+ * A read-only view of an exported bson document which reads the fields in
+ * place, without building the node tree of <code>EBson</code>.
+ *
+ * <p>The records are indexed lazily: a lookup scans the buffer only as far
+ * as the wanted field, and the offsets found are kept for later lookups.
+ * Names and values are returned as pointers into the buffer, so the buffer
+ * (a byte array, a mapped file, ...) must outlive the view and must not be
+ * changed meanwhile.
+ *
+ * <p>The paths are the same as the <code>EBson</code> ones:
+ * "/NAME1|IDX1/NAME2|IDX2", 1 is the first, 0 the last node of the name.
+ *
+ * <p>A malformed buffer is read up to the first bad record, the records
+ * after it are missing, see {@link #isCorrupted()}.
+ */
+
+class EBsonView: public EObject {
+public:
+	virtual ~EBsonView();
+
+	/**
+	 * Views the exported data (with or without the bson head).
+	 */
+	EBsonView(const void *data, int size);
+
+	/**
+	 * Views the bytes between the buffer's position and its limit.
+	 */
+	explicit
+	EBsonView(nio::EIOByteBuffer *buffer);
+
+	boolean isEmpty();
+
+	/**
+	 * Returns the index of the node of the path, or -1 if no such node.
+	 */
+	int find(const char *path);
+
+	/**
+	 * Returns the index of the node of the path below the given node, -1
+	 * for the top level.
+	 */
+	int find(int node, const char *path);
+
+	/**
+	 * Node accessors, <code>node</code> is an index returned by find().
+	 */
+	const char* nameOf(int node);
+	const void* valueOf(int node, es_size_t *size, int *dtype=null);
+	int parentOf(int node);
+	int firstChild(int node);
+	int nextSibling(int node);
+
+	const char* get(const char *path);
+	const void* get(const char *path, es_size_t *size, int *dtype=null);
+	EString getString(const char *path) THROWS(ENoSuchElementException);
+	byte getByte(const char *path) THROWS2(ENoSuchElementException, ENumberFormatException);
+	short getShort(const char *path) THROWS2(ENoSuchElementException, ENumberFormatException);
+	int getInt(const char *path) THROWS2(ENoSuchElementException, ENumberFormatException);
+	llong getLLong(const char *path) THROWS2(ENoSuchElementException, ENumberFormatException);
+	float getFloat(const char *path) THROWS2(ENoSuchElementException, ENumberFormatException);
+	double getDouble(const char *path) THROWS2(ENoSuchElementException, ENumberFormatException);
+
+	EString getString(const char *path, const char *defaultValue);
+	byte getByte(const char *path, byte defaultValue) THROWS(ENumberFormatException);
+	short getShort(const char *path, short defaultValue) THROWS(ENumberFormatException);
+	int getInt(const char *path, int defaultValue) THROWS(ENumberFormatException);
+	llong getLLong(const char *path, llong defaultValue) THROWS(ENumberFormatException);
+	float getFloat(const char *path, float defaultValue) THROWS(ENumberFormatException);
+	double getDouble(const char *path, double defaultValue) THROWS(ENumberFormatException);
+
+	/**
+	 * Returns the attribute of the node of the path, or null.
+	 */
+	const void* attrGet(const char *path, const char *key, es_size_t *size=null, int *dtype=null);
+	EString attrGetString(const char *path, const char *key) THROWS(ENoSuchElementException);
+	llong attrGetLLong(const char *path, const char *key) THROWS2(ENoSuchElementException, ENumberFormatException);
+
+	/**
+	 * Returns the number of nodes with the name of the path's node, from it
+	 * to the last sibling, like <code>EBson::count()</code>.
+	 */
+	int count(const char *path);
+
+	/**
+	 * Returns the number of nodes indexed so far.
+	 */
+	int indexed();
+
+	/**
+	 * Returns true if a malformed record was met.
+	 */
+	boolean isCorrupted();
+
+private:
+	struct Entry;
+
+	const es_uint8_t *data;
+	int size;
+	int pos;      // the offset of the next record to index
+	boolean done;
+	boolean corrupted;
+
+	Entry *entries;
+	int entryCount;
+	int entryCapacity;
+	int lastElement; // the last indexed element, -1 if none
+
+	void init(const void *data, int size);
+	boolean scanNext();
+	int newEntry();
+	int readRecord();
+	boolean readValue(int e);
+	int childOf(int parent);
+	int siblingOf(int node);
+	int locate(int parent, const char *path);
+	int findAttr(int node, const char *key);
+
+	EBsonView(const EBsonView& that);
+	EBsonView& operator= (const EBsonView& that);
+};
+
+} /* namespace efc */
+#endif /* EBSONVIEW_HH_ */
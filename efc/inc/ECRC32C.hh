@@ -0,0 +1,63 @@
+/*
+ * ECRC32C.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ECRC32CC_HH_
+#define ECRC32CC_HH_
+
+#include "EObject.hh"
+#include "EChecksum.hh"
+
+namespace efc {
+
+/**
+ * A class that can be used to compute the CRC-32C of a data stream.
+ *
+ * <p> CRC-32C is defined using the Castagnoli polynomial 0x1EDC6F41 and
+ * reflected, as RFC 3720 (iSCSI); it's computed with the SSE4.2 crc32
+ * instruction when the cpu has it.
+ *
+ * <p> Passing a {@code null} argument to a method in this class will cause
+ * a {@link NullPointerException} to be thrown.
+ *
+ * @see         Checksum
+ */
+
+class ECRC32C: virtual public EChecksum {
+public:
+	virtual ~ECRC32C();
+
+	/**
+	 * Creates a new CRC32C object.
+	 */
+	ECRC32C();
+
+	/**
+	 * Updates CRC-32C with specified byte.
+	 */
+	void update(byte b);
+
+	/**
+	 * Updates CRC-32C with specified array of bytes.
+	 */
+	void update(byte* b, int len);
+
+	/**
+	 * Returns CRC-32C value.
+	 */
+	llong getValue();
+
+	/**
+	 * Resets CRC-32C to initial value.
+	 */
+	void reset();
+
+private:
+	es_uint32_t _crc;
+};
+
+} /* namespace efc */
+#endif /* ECRC32CC_HH_ */
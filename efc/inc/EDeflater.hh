@@ -61,7 +61,7 @@ namespace efc {
  * @version 	1.45, 04/07/06
  */
 
-class EDeflater {
+class EDeflater: public EObject {
 public:
 	/**
 	 * Compression method for the deflate algorithm (the only one currently
@@ -0,0 +1,86 @@
+/*
+ * EDigestInputStream.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EDIGESTINPUTSTREAM_HH_
+#define EDIGESTINPUTSTREAM_HH_
+
+#include "EFilterInputStream.hh"
+#include "EMessageDigest.hh"
+
+namespace efc {
+
+/**
+ * A transparent stream that updates the associated message digest using
+ * the bits going through the stream.
+ *
+ * <p>To complete the message digest computation, call one of the
+ * {@code digest} methods on the associated message digest after your
+ * calls to one of this digest input stream's {@link #read() read} methods.
+ *
+ * @see MessageDigest
+ * @see DigestOutputStream
+ */
+
+class EDigestInputStream: public EFilterInputStream {
+public:
+	virtual ~EDigestInputStream();
+
+	/**
+	 * Creates a digest input stream, using the specified input stream and
+	 * message digest.
+	 * @param in the input stream
+	 * @param digest the message digest to associate with this stream
+	 */
+	EDigestInputStream(EInputStream* in, EMessageDigest* digest, boolean owned=false);
+
+	/**
+	 * Reads a byte, and updates the message digest (if the digest function
+	 * is on).
+	 * @return the byte read, or -1 if the end of the stream is reached.
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual int read() THROWS(EIOException);
+
+	/**
+	 * Reads into an array of bytes, and updates the message digest (if the
+	 * digest function is on) with the bytes read.
+	 * @param b the buffer into which the data is read
+	 * @param len the maximum number of bytes read
+	 * @return the actual number of bytes read, or -1 if the end of the
+	 *         stream is reached.
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual int read(void *b, int len) THROWS(EIOException);
+
+	/**
+	 * Turns the digest function on or off. The default is on.
+	 */
+	void on(boolean on);
+
+	/**
+	 * Returns the message digest associated with this stream.
+	 */
+	EMessageDigest* getMessageDigest();
+
+	/**
+	 * Associates the specified message digest with this stream.
+	 */
+	void setMessageDigest(EMessageDigest* digest);
+
+	/**
+	 * Prints a string representation of this digest input stream and its
+	 * associated message digest object.
+	 */
+	virtual EString toString();
+
+private:
+	EMessageDigest* _digest;
+	boolean _on;
+};
+
+} /* namespace efc */
+#endif /* EDIGESTINPUTSTREAM_HH_ */
@@ -0,0 +1,87 @@
+/*
+ * EDigestOutputStream.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EDIGESTOUTPUTSTREAM_HH_
+#define EDIGESTOUTPUTSTREAM_HH_
+
+#include "EFilterOutputStream.hh"
+#include "EMessageDigest.hh"
+
+namespace efc {
+
+/**
+ * A transparent stream that updates the associated message digest using
+ * the bits going through the stream.
+ *
+ * <p>To complete the message digest computation, call one of the
+ * {@code digest} methods on the associated message digest after your
+ * calls to one of this digest output stream's {@link #write(int) write}
+ * methods.
+ *
+ * @see MessageDigest
+ * @see DigestInputStream
+ */
+
+class EDigestOutputStream: public EFilterOutputStream {
+public:
+	virtual ~EDigestOutputStream();
+
+	/**
+	 * Creates a digest output stream, using the specified output stream and
+	 * message digest.
+	 * @param out the output stream
+	 * @param digest the message digest to associate with this stream
+	 */
+	EDigestOutputStream(EOutputStream* out, EMessageDigest* digest, boolean owned=false);
+
+	/**
+	 * Updates the message digest (if the digest function is on) using the
+	 * specified byte, and in any case writes the byte to the output stream.
+	 * @param b the byte to be written
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void write(int b) THROWS(EIOException);
+
+	/**
+	 * Updates the message digest (if the digest function is on) using the
+	 * specified subarray, and in any case writes the subarray to the output
+	 * stream.
+	 * @param b the data to be written
+	 * @param len the number of bytes to be written
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void write(const void *b, int len) THROWS(EIOException);
+	virtual void write(const char *s) THROWS(EIOException);
+
+	/**
+	 * Turns the digest function on or off. The default is on.
+	 */
+	void on(boolean on);
+
+	/**
+	 * Returns the message digest associated with this stream.
+	 */
+	EMessageDigest* getMessageDigest();
+
+	/**
+	 * Associates the specified message digest with this stream.
+	 */
+	void setMessageDigest(EMessageDigest* digest);
+
+	/**
+	 * Prints a string representation of this digest output stream and its
+	 * associated message digest object.
+	 */
+	virtual EString toString();
+
+private:
+	EMessageDigest* _digest;
+	boolean _on;
+};
+
+} /* namespace efc */
+#endif /* EDIGESTOUTPUTSTREAM_HH_ */
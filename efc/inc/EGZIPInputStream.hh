@@ -11,9 +11,19 @@
 #include "EInflaterInputStream.hh"
 #include "ECRC32.hh"
 #include "EEOFException.hh"
+#include "./concurrent/EExecutorService.hh"
+#include "./concurrent/EArrayBlockingQueue.hh"
 
 namespace efc {
 
+/**
+ * This class implements a stream filter for reading compressed data in
+ * the GZIP file format.
+ *
+ * <p>With an executor the data is inflated ahead by a task, a few blocks
+ * at most, so that the decompression overlaps with the caller's work.
+ */
+
 class EGZIPInputStream: public EInflaterInputStream {
 public:
 	virtual ~EGZIPInputStream();
@@ -27,6 +37,17 @@ public:
 	 */
 	EGZIPInputStream(EInputStream* in, int size = 512) THROWS(EIOException);
 
+	/**
+	 * Creates a new input stream which inflates ahead on the executor.
+	 * The header is read by the constructor, the errors of the data and of
+	 * the trailer are thrown by read().
+	 * @param in the input stream
+	 * @param executor runs the readahead task, it must outlive the stream
+	 * @param size the input buffer size
+	 * @exception IOException if an I/O error has occurred
+	 */
+	EGZIPInputStream(EInputStream* in, EExecutorService* executor, int size = 8192) THROWS(EIOException);
+
 	//TODO:
 	EGZIPInputStream(const EGZIPInputStream& that);
 	EGZIPInputStream& operator= (const EGZIPInputStream& that);
@@ -56,6 +77,12 @@ public:
 	 */
 	virtual void close() THROWS(EIOException);
 
+	/**
+	 * Returns 0 after EOF has been reached, otherwise always return 1 (or
+	 * the bytes already inflated ahead).
+	 */
+	virtual long available() THROWS(EIOException);
+
 protected:
 	/**
 	 * CRC-32 for uncompressed data.
@@ -68,9 +95,22 @@ protected:
 	boolean _eos;
 
 private:
+	class Readahead;
+
 	boolean _closed; // = false;
 	EInflater* _inf;
 
+	// the readahead mode
+	sp<EArrayBlockingQueue<EA<byte> > > _chunks; // an empty chunk at the end
+	sp<EFuture<EObject> > _task;
+	sp<EA<byte> > _chunk;
+	int _chunkPos;
+	volatile boolean _stopped;
+	EString _error;
+
+	int inflate(void* b, int len) THROWS(EIOException);
+	void stop();
+
 	/**
 	 * Check to make sure that this stream has not been closed
 	 */
@@ -10,6 +10,9 @@
 
 #include "EDeflaterOutputStream.hh"
 #include "ECRC32.hh"
+#include "EArrayDeque.hh"
+#include "./concurrent/EExecutorService.hh"
+#include "./concurrent/EConcurrentLinkedQueue.hh"
 
 namespace efc {
 
@@ -17,10 +20,21 @@ namespace efc {
  * This class implements a stream filter for writing compressed data in
  * the GZIP file format.
  *
+ * <p>With an executor the stream works like pigz: the data is cut into
+ * blocks which are deflated in parallel, each one primed with the last
+ * 32K of the previous block as dictionary and ended by a sync flush, then
+ * written in order with the crcs combined, so that the output is still a
+ * single standard gzip member.  The caller's thread only copies the data
+ * and writes the compressed blocks.
  */
 
 class EGZIPOutputStream: public EDeflaterOutputStream {
 public:
+	/**
+	 * The default block size of the parallel mode.
+	 */
+	static const int DEFAULT_BLOCK_SIZE = 128 * 1024;
+
 	virtual ~EGZIPOutputStream();
 
 	/**
@@ -40,6 +54,19 @@ public:
 	 */
 	EGZIPOutputStream(EOutputStream* out, int size=512, boolean syncFlush=false) THROWS(EIOException);
 
+	/**
+	 * Creates a new output stream which deflates on the executor.
+	 * @param out the output stream
+	 * @param executor runs the deflate tasks, it must outlive the stream
+	 * @param blockSize the uncompressed size of a block
+	 * @param level the compression level
+	 * @exception IOException If an I/O error has occurred.
+	 * @exception IllegalArgumentException if blockSize < 32K
+	 */
+	EGZIPOutputStream(EOutputStream* out, EExecutorService* executor,
+			int blockSize=DEFAULT_BLOCK_SIZE,
+			int level=EDeflater::DEFAULT_COMPRESSION) THROWS(EIOException);
+
 	//TODO:
 	EGZIPOutputStream(const EGZIPOutputStream& that);
 	EGZIPOutputStream& operator= (const EGZIPOutputStream& that);
@@ -63,6 +90,13 @@ public:
 	 */
 	virtual void finish() THROWS(EIOException);
 
+	/**
+	 * In the parallel mode, waits the blocks written so far and writes them
+	 * to the output stream, each block ends with a sync flush.  Otherwise
+	 * same as {@link DeflaterOutputStream#flush()}.
+	 */
+	virtual void flush() THROWS(EIOException);
+
 protected:
     /**
      * CRC-32 of uncompressed data.
@@ -81,7 +115,25 @@ protected:
 	void writeTrailer(byte buf[8]) THROWS(EIOException);
 
 private:
+	class Block;
+
 	EDeflater* _def;
+
+	// the parallel mode
+	EExecutorService* _executor;
+	int _level;
+	int _maxPending;
+	sp<EA<byte> > _block;        // the data of the next block
+	int _blockLen;
+	sp<EA<byte> > _prev;         // the last submitted block, for its dictionary
+	int _prevLen;
+	EArrayDeque<sp<Block> >* _pending;
+	sp<EConcurrentLinkedQueue<EDeflater> > _deflaters;
+	es_uint32_t _blockCrc;       // the crc of the written blocks
+	llong _totalIn;
+
+	void submit(boolean last) THROWS(EIOException);
+	void drain(int keep) THROWS(EIOException);
 };
 
 } /* namespace efc */
@@ -3,6 +3,7 @@
 
 #include "EAbstractMap.hh"
 #include "EInteger.hh"
+#include "EHashing.hh"
 #include "EIllegalStateException.hh"
 #include "ENoSuchElementException.hh"
 #include "EUnsupportedOperationException.hh"
@@ -418,6 +419,11 @@ private:
 	 */
 	float _loadFactor;
 
+	/**
+	 * The seed of the hashing policy, 0 for EHashing::JAVA.
+	 */
+	llong _hashSeed;
+
 	// Views
 	ESet<EMapEntry<K, V>*>* _entrySet;
 
@@ -444,6 +450,7 @@ private:
 			_capacity <<= 1;
 
 		_loadFactor = loadFactor;
+		_hashSeed = EHashing::seedOf(EHashing::getDefaultPolicy());
 		_threshold = (int) (_capacity * _loadFactor);
 		_table = new Entry*[_capacity]();
 		_entrySet = null;
@@ -537,6 +544,7 @@ public:
 		_capacity = t->_capacity;
 		_loadFactor = t->_loadFactor;
 		_threshold = t->_threshold;
+		_hashSeed = t->_hashSeed;
 		_entrySet = null;
 	}
 
@@ -579,6 +587,7 @@ public:
 		_capacity = t->_capacity;
 		_loadFactor = t->_loadFactor;
 		_threshold = t->_threshold;
+		_hashSeed = t->_hashSeed;
 		_entrySet = null;
 
 		return *this;
@@ -602,6 +611,13 @@ public:
 		return uh ^ (uh >> 7) ^ (uh >> 4);
 	}
 
+	/**
+	 * Hash of a non-null key by the hashing policy.
+	 */
+	int hashOf(K key) {
+		return _hashSeed ? EHashing::hash32(key, _hashSeed) : hashIt(key);
+	}
+
 	/**
 	 * Returns index for hash code h.
 	 */
@@ -609,6 +625,34 @@ public:
 		return h & (length - 1);
 	}
 
+	/**
+	 * Changes the hashing policy, the present entries are rehashed.
+	 *
+	 * @see EHashing
+	 */
+	void setHashPolicy(EHashing::Policy policy) {
+		llong seed = EHashing::seedOf(policy);
+		if (seed == _hashSeed) {
+			return;
+		}
+		_hashSeed = seed;
+
+		Entry **newTable = new Entry*[_capacity]();
+		for (int j = 0; j < (int)_capacity; j++) {
+			Entry *e = _table[j];
+			while (e != null) {
+				Entry *next = e->next;
+				e->hash = hashOf(e->key);
+				int k = indexFor(e->hash, _capacity);
+				e->next = newTable[k];
+				newTable[k] = e;
+				e = next;
+			}
+		}
+		delete[] _table;
+		_table = newTable;
+	}
+
 	/**
 	 * Returns the number of key-value mappings in this map.
 	 *
@@ -645,7 +689,7 @@ public:
 	 * @see #put(Object, Object)
 	 */
 	V get(K key) {
-		int hash = hashIt(key);
+		int hash = hashOf(key);
 		for (Entry *e = _table[indexFor(hash,
 				_capacity)]; e != null; e = e->next) {
 			if (e->hash == hash && (e->key == key))
@@ -672,7 +716,7 @@ public:
 	 * for the key.
 	 */
 	Entry* getEntry(K key) {
-		int hash = hashIt(key);
+		int hash = hashOf(key);
 		for (Entry *e = _table[indexFor(hash,
 				_capacity)]; e != null; e = e->next) {
 			if (e->hash == hash
@@ -696,7 +740,7 @@ public:
 	 *         previously associated <tt>null</tt> with <tt>key</tt>.)
 	 */
 	V put(K key, V value, boolean *absent=null) {
-		int hash = hashIt(key);
+		int hash = hashOf(key);
 		int i = indexFor(hash, _capacity);
 		for (Entry *e = _table[i]; e != null;
 				e = e->next) {
@@ -794,7 +838,7 @@ public:
 	 * for this key.
 	 */
 	Entry* removeEntryForKey(K key) {
-		int hash = hashIt(key);
+		int hash = hashOf(key);
 		int i = indexFor(hash, _capacity);
 		Entry *prev = _table[i];
 		Entry *e = prev;
@@ -824,7 +868,7 @@ public:
 	 */
 	Entry* removeMapping(EMapEntry<K,V> *entry) {
 		K key = entry->getKey();
-		int hash = hashIt(key);
+		int hash = hashOf(key);
 		int i = indexFor(hash, _capacity);
 		Entry *prev = _table[i];
 		Entry *e = prev;
@@ -1273,6 +1317,11 @@ private:
 	 */
 	float _loadFactor;
 
+	/**
+	 * The seed of the hashing policy, 0 for EHashing::JAVA.
+	 */
+	llong _hashSeed;
+
 	// Views
 	ESet<EMapEntry<K, V>*>* _entrySet;
 
@@ -1296,6 +1345,7 @@ private:
 			_capacity <<= 1;
 
 		_loadFactor = loadFactor;
+		_hashSeed = EHashing::seedOf(EHashing::getDefaultPolicy());
 		_threshold = (int) (_capacity * _loadFactor);
 		_table = new Entry*[_capacity]();
 		_entrySet = null;
@@ -1383,6 +1433,7 @@ public:
 		_capacity = t->_capacity;
 		_loadFactor = t->_loadFactor;
 		_threshold = t->_threshold;
+		_hashSeed = t->_hashSeed;
 		_entrySet = null;
 	}
 
@@ -1423,6 +1474,7 @@ public:
 		_capacity = t->_capacity;
 		_loadFactor = t->_loadFactor;
 		_threshold = t->_threshold;
+		_hashSeed = t->_hashSeed;
 		_entrySet = null;
 
 		return *this;
@@ -1446,6 +1498,13 @@ public:
 		return uh ^ (uh >> 7) ^ (uh >> 4);
 	}
 
+	/**
+	 * Hash of a non-null key by the hashing policy.
+	 */
+	int hashOf(K key) {
+		return _hashSeed ? EHashing::hash32(key, _hashSeed) : hashIt(key);
+	}
+
 	/**
 	 * Returns index for hash code h.
 	 */
@@ -1453,6 +1512,34 @@ public:
 		return h & (length - 1);
 	}
 
+	/**
+	 * Changes the hashing policy, the present entries are rehashed.
+	 *
+	 * @see EHashing
+	 */
+	void setHashPolicy(EHashing::Policy policy) {
+		llong seed = EHashing::seedOf(policy);
+		if (seed == _hashSeed) {
+			return;
+		}
+		_hashSeed = seed;
+
+		Entry **newTable = new Entry*[_capacity]();
+		for (int j = 0; j < (int)_capacity; j++) {
+			Entry *e = _table[j];
+			while (e != null) {
+				Entry *next = e->next;
+				e->hash = hashOf(e->key);
+				int k = indexFor(e->hash, _capacity);
+				e->next = newTable[k];
+				newTable[k] = e;
+				e = next;
+			}
+		}
+		delete[] _table;
+		_table = newTable;
+	}
+
 	/**
 	 * Returns the number of key-value mappings in this map.
 	 *
@@ -1489,7 +1576,7 @@ public:
 	 * @see #put(Object, Object)
 	 */
 	V get(K key) {
-		int hash = hashIt(key);
+		int hash = hashOf(key);
 		for (Entry *e = _table[indexFor(hash,
 				_capacity)]; e != null; e = e->next) {
 			if (e->hash == hash && (e->key == key))
@@ -1516,7 +1603,7 @@ public:
 	 * for the key.
 	 */
 	Entry* getEntry(K key) {
-		int hash = hashIt(key);
+		int hash = hashOf(key);
 		for (Entry *e = _table[indexFor(hash,
 				_capacity)]; e != null; e = e->next) {
 			if (e->hash == hash
@@ -1540,7 +1627,7 @@ public:
 	 *         previously associated <tt>null</tt> with <tt>key</tt>.)
 	 */
 	V put(K key, V value, boolean *absent=null) {
-		int hash = hashIt(key);
+		int hash = hashOf(key);
 		int i = indexFor(hash, _capacity);
 		for (Entry *e = _table[i]; e != null;
 				e = e->next) {
@@ -1638,7 +1725,7 @@ public:
 	 * for this key.
 	 */
 	Entry* removeEntryForKey(K key) {
-		int hash = hashIt(key);
+		int hash = hashOf(key);
 		int i = indexFor(hash, _capacity);
 		Entry *prev = _table[i];
 		Entry *e = prev;
@@ -1668,7 +1755,7 @@ public:
 	 */
 	Entry* removeMapping(EMapEntry<K,V> *entry) {
 		K key = entry->getKey();
-		int hash = hashIt(key);
+		int hash = hashOf(key);
 		int i = indexFor(hash, _capacity);
 		Entry *prev = _table[i];
 		Entry *e = prev;
@@ -2124,6 +2211,11 @@ private:
 	 */
 	float _loadFactor;
 
+	/**
+	 * The seed of the hashing policy, 0 for EHashing::JAVA.
+	 */
+	llong _hashSeed;
+
 	// Views
 	ESet<EMapEntry<K, V>*>* _entrySet;
 
@@ -2151,6 +2243,7 @@ private:
 			_capacity <<= 1;
 
 		_loadFactor = loadFactor;
+		_hashSeed = EHashing::seedOf(EHashing::getDefaultPolicy());
 		_threshold = (int) (_capacity * _loadFactor);
 		_table = new Entry*[_capacity]();
 		_entrySet = null;
@@ -2283,6 +2376,7 @@ public:
 		_capacity = t->_capacity;
 		_loadFactor = t->_loadFactor;
 		_threshold = t->_threshold;
+		_hashSeed = t->_hashSeed;
 		_entrySet = null;
 	}
 
@@ -2326,6 +2420,7 @@ public:
 		_capacity = t->_capacity;
 		_loadFactor = t->_loadFactor;
 		_threshold = t->_threshold;
+		_hashSeed = t->_hashSeed;
 		_entrySet = null;
 
 		return *this;
@@ -2349,6 +2444,13 @@ public:
 		return uh ^ (uh >> 7) ^ (uh >> 4);
 	}
 
+	/**
+	 * Hash of a non-null key by the hashing policy.
+	 */
+	int hashOf(K key) {
+		return _hashSeed ? EHashing::hash32(key, _hashSeed) : hashIt(key->hashCode());
+	}
+
 	/**
 	 * Returns index for hash code h.
 	 */
@@ -2356,6 +2458,34 @@ public:
 		return h & (length - 1);
 	}
 
+	/**
+	 * Changes the hashing policy, the present entries are rehashed.
+	 *
+	 * @see EHashing
+	 */
+	void setHashPolicy(EHashing::Policy policy) {
+		llong seed = EHashing::seedOf(policy);
+		if (seed == _hashSeed) {
+			return;
+		}
+		_hashSeed = seed;
+
+		Entry **newTable = new Entry*[_capacity]();
+		for (int j = 0; j < (int)_capacity; j++) {
+			Entry *e = _table[j];
+			while (e != null) {
+				Entry *next = e->next;
+				e->hash = (e->key == null) ? 0 : hashOf(e->key);
+				int k = indexFor(e->hash, _capacity);
+				e->next = newTable[k];
+				newTable[k] = e;
+				e = next;
+			}
+		}
+		delete[] _table;
+		_table = newTable;
+	}
+
 	/**
 	 * Returns the number of key-value mappings in this map.
 	 *
@@ -2394,7 +2524,7 @@ public:
 	V get(K key) {
 		if (key == null)
 			return getForNullKey();
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		for (Entry *e = _table[indexFor(hash,
 				_capacity)]; e != null; e = e->next) {
 			K k;
@@ -2422,7 +2552,7 @@ public:
 	 * for the key.
 	 */
 	Entry* getEntry(K key) {
-		int hash = (key == null) ? 0 : hashIt(key->hashCode());
+		int hash = (key == null) ? 0 : hashOf(key);
 		for (Entry *e = _table[indexFor(hash,
 				_capacity)]; e != null; e = e->next) {
 			K k;
@@ -2449,7 +2579,7 @@ public:
 	V put(K key, V value, boolean *absent=null) {
 		if (key == null)
 			return putForNullKey(value);
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		int i = indexFor(hash, _capacity);
 		for (Entry *e = _table[i]; e != null;
 				e = e->next) {
@@ -2551,7 +2681,7 @@ public:
 	 * for this key.
 	 */
 	Entry* removeEntryForKey(K key) {
-		int hash = (key == null) ? 0 : hashIt(key->hashCode());
+		int hash = (key == null) ? 0 : hashOf(key);
 		int i = indexFor(hash, _capacity);
 		Entry *prev = _table[i];
 		Entry *e = prev;
@@ -2582,7 +2712,7 @@ public:
 	 */
 	Entry* removeMapping(EMapEntry<K,V> *entry) {
 		K key = entry->getKey();
-		int hash = (key == null) ? 0 : hashIt(key->hashCode());
+		int hash = (key == null) ? 0 : hashOf(key);
 		int i = indexFor(hash, _capacity);
 		Entry *prev = _table[i];
 		Entry *e = prev;
@@ -3038,6 +3168,11 @@ private:
 	 */
 	float _loadFactor;
 
+	/**
+	 * The seed of the hashing policy, 0 for EHashing::JAVA.
+	 */
+	llong _hashSeed;
+
 	// Views
 	ESet<EMapEntry<K, V>*>* _entrySet;
 
@@ -3061,6 +3196,7 @@ private:
 			_capacity <<= 1;
 
 		_loadFactor = loadFactor;
+		_hashSeed = EHashing::seedOf(EHashing::getDefaultPolicy());
 		_threshold = (int) (_capacity * _loadFactor);
 		_table = new Entry*[_capacity]();
 		_entrySet = null;
@@ -3182,6 +3318,7 @@ public:
 		_capacity = t->_capacity;
 		_loadFactor = t->_loadFactor;
 		_threshold = t->_threshold;
+		_hashSeed = t->_hashSeed;
 		_entrySet = null;
 	}
 
@@ -3222,6 +3359,7 @@ public:
 		_capacity = t->_capacity;
 		_loadFactor = t->_loadFactor;
 		_threshold = t->_threshold;
+		_hashSeed = t->_hashSeed;
 		_entrySet = null;
 
 		return *this;
@@ -3245,6 +3383,16 @@ public:
 		return uh ^ (uh >> 7) ^ (uh >> 4);
 	}
 
+	/**
+	 * Hash of a non-null key by the hashing policy.
+	 */
+	int hashOf(_K* key) {
+		return _hashSeed ? EHashing::hash32(key, _hashSeed) : hashIt(key->hashCode());
+	}
+	int hashOf(const K& key) {
+		return hashOf(key.get());
+	}
+
 	/**
 	 * Returns index for hash code h.
 	 */
@@ -3252,6 +3400,34 @@ public:
 		return h & (length - 1);
 	}
 
+	/**
+	 * Changes the hashing policy, the present entries are rehashed.
+	 *
+	 * @see EHashing
+	 */
+	void setHashPolicy(EHashing::Policy policy) {
+		llong seed = EHashing::seedOf(policy);
+		if (seed == _hashSeed) {
+			return;
+		}
+		_hashSeed = seed;
+
+		Entry **newTable = new Entry*[_capacity]();
+		for (int j = 0; j < (int)_capacity; j++) {
+			Entry *e = _table[j];
+			while (e != null) {
+				Entry *next = e->next;
+				e->hash = (e->key == null) ? 0 : hashOf(e->key);
+				int k = indexFor(e->hash, _capacity);
+				e->next = newTable[k];
+				newTable[k] = e;
+				e = next;
+			}
+		}
+		delete[] _table;
+		_table = newTable;
+	}
+
 	/**
 	 * Returns the number of key-value mappings in this map.
 	 *
@@ -3290,7 +3466,7 @@ public:
 	V get(_K* key) {
 		if (key == null)
 			return getForNullKey();
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		for (Entry *e = _table[indexFor(hash,
 				_capacity)]; e != null; e = e->next) {
 			K k;
@@ -3318,7 +3494,7 @@ public:
 	 * for the key.
 	 */
 	Entry* getEntry(_K* key) {
-		int hash = (key == null) ? 0 : hashIt(key->hashCode());
+		int hash = (key == null) ? 0 : hashOf(key);
 		for (Entry *e = _table[indexFor(hash,
 				_capacity)]; e != null; e = e->next) {
 			K k;
@@ -3345,7 +3521,7 @@ public:
 	V put(K key, V value, boolean *absent=null) {
 		if (key == null)
 			return putForNullKey(value);
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		int i = indexFor(hash, _capacity);
 		for (Entry *e = _table[i]; e != null;
 				e = e->next) {
@@ -3444,7 +3620,7 @@ public:
 	 * for this key.
 	 */
 	Entry* removeEntryForKey(_K* key) {
-		int hash = (key == null) ? 0 : hashIt(key->hashCode());
+		int hash = (key == null) ? 0 : hashOf(key);
 		int i = indexFor(hash, _capacity);
 		Entry *prev = _table[i];
 		Entry *e = prev;
@@ -3475,7 +3651,7 @@ public:
 	 */
 	Entry* removeMapping(EMapEntry<K,V> *entry) {
 		K key = entry->getKey();
-		int hash = (key == null) ? 0 : hashIt(key->hashCode());
+		int hash = (key == null) ? 0 : hashOf(key);
 		int i = indexFor(hash, _capacity);
 		Entry *prev = _table[i];
 		Entry *e = prev;
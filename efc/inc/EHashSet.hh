@@ -155,6 +155,15 @@ public:
 		return map_->keySet()->iterator();
 	}
 
+	/**
+	 * Changes the hashing policy of the backing map.
+	 *
+	 * @see EHashing
+	 */
+	void setHashPolicy(EHashing::Policy policy) {
+		map_->setHashPolicy(policy);
+	}
+
 	/**
 	 * Returns the number of elements in this set (its cardinality).
 	 *
@@ -321,6 +330,15 @@ public:
 		return map_->keySet()->iterator();
 	}
 
+	/**
+	 * Changes the hashing policy of the backing map.
+	 *
+	 * @see EHashing
+	 */
+	void setHashPolicy(EHashing::Policy policy) {
+		map_->setHashPolicy(policy);
+	}
+
 	/**
 	 * Returns the number of elements in this set (its cardinality).
 	 *
@@ -491,6 +509,15 @@ public:
 		return map_->keySet()->iterator();
 	}
 
+	/**
+	 * Changes the hashing policy of the backing map.
+	 *
+	 * @see EHashing
+	 */
+	void setHashPolicy(EHashing::Policy policy) {
+		map_->setHashPolicy(policy);
+	}
+
 	/**
 	 * Returns the number of elements in this set (its cardinality).
 	 *
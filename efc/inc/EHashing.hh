@@ -0,0 +1,80 @@
+/*
+ * EHashing.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EHASHING_HH_
+#define EHASHING_HH_
+
+#include "EObject.hh"
+
+namespace efc {
+
+class EString;
+
+/**
+ * Hashing policies of the hashed collections (EHashMap, EHashSet,
+ * EConcurrentHashMap), like the java7 "alternative hashing".
+ *
+ * <p>The default {@link #JAVA} policy spreads the key's
+ * <code>hashCode()</code>, so keys whose hash codes collide always share
+ * a bucket, and the string hash <code>s[0]*31^(n-1) + ... + s[n-1]</code>
+ * is easy to attack.  The wyhash policies hash the bytes of EString keys
+ * (and mix all bits of the other keys) with a 64-bit hash instead;
+ * {@link #WYHASH_SEEDED} also mixes in a random per-process seed so the
+ * bucket layout can't be predicted from outside.
+ *
+ * <p>The policy only changes where entries are stored, never the
+ * <code>hashCode()</code> results or the map semantics, but the iteration
+ * order differs between policies (and between processes if seeded).
+ */
+class EHashing : public EObject {
+public:
+	enum Policy {
+		JAVA = 0,
+		WYHASH = 1,
+		WYHASH_SEEDED = 2
+	};
+
+	/**
+	 * The policy of new collections, JAVA by default.
+	 */
+	static Policy getDefaultPolicy();
+	static void setDefaultPolicy(Policy policy);
+
+	/**
+	 * The seed the collections store for a policy, 0 for JAVA.
+	 */
+	static llong seedOf(Policy policy);
+
+	/**
+	 * 64-bit wyhash of bytes.
+	 */
+	static llong hash64(const void* data, int len, llong seed=0);
+
+	/**
+	 * 32-bit table hash of a key for a non-zero seed.
+	 */
+	static int hash32(llong key, llong seed);
+	static int hash32(EString* key, llong seed);
+	template<typename T>
+	static int hash32(T* key, llong seed) {
+		return key ? hash32((llong)key->hashCode(), seed) : 0;
+	}
+	template<typename T>
+	static int hash32(T key, llong seed) {
+		return hash32((llong)key, seed);
+	}
+
+	/**
+	 * Floating-point keys by their bits, 0.0 and -0.0 alike since they
+	 * are equal keys.
+	 */
+	static int hash32(float key, llong seed);
+	static int hash32(double key, llong seed);
+};
+
+} /* namespace efc */
+#endif /* EHASHING_HH_ */
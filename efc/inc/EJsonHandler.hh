@@ -0,0 +1,43 @@
+/*
+ * EJsonHandler.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EJSONHANDLER_HH_
+#define EJSONHANDLER_HH_
+
+#include "EObject.hh"
+
+namespace efc {
+
+/**
+ * Receives the events of a streamed json document, see
+ * {@link EJsonParser#parse(EInputStream*, EJsonHandler*)}.
+ *
+ * <p>The strings are passed unescaped, the numbers as their text which is
+ * valid json number syntax.  The pointers are only valid during the call.
+ */
+
+interface EJsonHandler : virtual public EObject {
+	virtual ~EJsonHandler(){}
+
+	virtual void startObject() = 0;
+	virtual void endObject() = 0;
+	virtual void startArray() = 0;
+	virtual void endArray() = 0;
+
+	/**
+	 * The name of the next member of the current object.
+	 */
+	virtual void key(const char *s, int len) = 0;
+
+	virtual void string(const char *s, int len) = 0;
+	virtual void number(const char *text, int len) = 0;
+	virtual void booleanValue(boolean value) = 0;
+	virtual void nullValue() = 0;
+};
+
+} /* namespace efc */
+#endif /* EJSONHANDLER_HH_ */
@@ -0,0 +1,113 @@
+/*
+ * EJsonParser.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EJSONPARSER_HH_
+#define EJSONPARSER_HH_
+
+#include "EJsonValue.hh"
+#include "EJsonHandler.hh"
+#include "EInputStream.hh"
+#include "EIOException.hh"
+
+namespace efc {
+
+/**
+ * A two-stage json parser.
+ *
+ * <p>The first stage (<code>eso_json_index</code>) classifies the text 64
+ * bytes at a time with SIMD compares and bit operations, and keeps the
+ * positions of the structural characters only: brackets, colons, commas,
+ * the opening quotes and the first byte of the numbers and literals.  The
+ * second stage walks these positions to check the grammar and to pair the
+ * brackets, so that a container can be skipped in one step.
+ *
+ * <p>There is no tree: {@link #parse(const char*, int)} returns a cursor
+ * over the index, see <code>EJsonValue</code>.  The text is copied into the
+ * parser, whose buffers are reused by the next parse.
+ *
+ * <p>For inputs larger than memory, {@link #parse(EInputStream*, EJsonHandler*)}
+ * reads and indexes the stream block by block and reports the tokens to a
+ * handler, only the unfinished token is kept between the blocks.
+ *
+ * <p>Malformed text, invalid utf-8 and bad escapes included, throws
+ * <code>EDataFormatException</code> with the offset of the error, in the
+ * three modes alike.
+ */
+
+class EJsonParser: public EObject {
+public:
+	/**
+	 * The maximum nesting of arrays and objects.
+	 */
+	static const int MAX_DEPTH = 1024;
+
+	virtual ~EJsonParser();
+
+	EJsonParser();
+
+	/**
+	 * Parses a document and returns its root value.
+	 */
+	EJsonValue parse(const char *json, int len) THROWS(EDataFormatException);
+	EJsonValue parse(const char *json) THROWS(EDataFormatException);
+
+	/**
+	 * Returns the root value of the last document, undefined if none.
+	 */
+	EJsonValue root();
+
+	/**
+	 * Returns the number of structural positions of the last document.
+	 */
+	int structurals();
+
+	/**
+	 * Streams a document through the handler.
+	 */
+	void parse(const char *json, int len, EJsonHandler *handler) THROWS(EDataFormatException);
+	void parse(EInputStream *is, EJsonHandler *handler) THROWS2(EIOException, EDataFormatException);
+
+private:
+	friend class EJsonValue;
+
+	char *text;             // the document, NUL terminated and padded
+	int textLength;
+	int textCapacity;
+	es_uint32_t *positions; // the structural positions, and textLength at last
+	es_uint32_t *match;     // for a bracket, the position of its pair
+	int count;
+	int positionCapacity;
+	boolean parsed;
+
+	// second stage
+	int state;
+	int *stack;             // (the number of the bracket << 1) | 1 if an object
+	int depth;
+	char *scratch;          // the unescaped strings
+	int scratchCapacity;
+	llong base;             // the stream offset of the text, for the errors
+
+	void reserveText(int size);
+	void reservePositions(int size);
+	char* reserveScratch(int size);
+	void walk(int from, int to, EJsonHandler *handler);
+	void pushContainer(int i, boolean object);
+	void popContainer(int i, boolean object, EJsonHandler *handler);
+	void emitString(es_uint32_t p, es_uint32_t q, boolean isKey, EJsonHandler *handler);
+	void finish(EJsonHandler *handler);
+	void fail(es_uint32_t p, const char *msg) THROWS(EDataFormatException);
+
+	static int stringEnd(const char *text, es_uint32_t p, es_uint32_t q);
+	static int numberEnd(const char *text, es_uint32_t p);
+	static int unescape(const char *s, int len, char *out);
+
+	EJsonParser(const EJsonParser& that);
+	EJsonParser& operator= (const EJsonParser& that);
+};
+
+} /* namespace efc */
+#endif /* EJSONPARSER_HH_ */
@@ -0,0 +1,161 @@
+/*
+ * EJsonValue.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EJSONVALUE_HH_
+#define EJSONVALUE_HH_
+
+#include "EObject.hh"
+#include "EString.hh"
+#include "ENoSuchElementException.hh"
+#include "ENumberFormatException.hh"
+#include "EIllegalStateException.hh"
+#include "EDataFormatException.hh"
+
+namespace efc {
+
+class EJsonParser;
+
+/**
+ * A value of the document last parsed by an <code>EJsonParser</code>.
+ *
+ * <p>A value is only a position in the parser's structural index, nothing
+ * is decoded until asked: members are looked up by skipping the siblings
+ * (containers are skipped in one step), and strings and numbers are
+ * converted by the getters.  It is cheap to copy and stays valid until the
+ * parser parses again or is deleted.
+ *
+ * <p>A missing member or element gives an undefined value, on which the
+ * getters without default throw <code>ENoSuchElementException</code>:
+ *
+ * <pre>
+ * EJsonParser parser;
+ * EJsonValue root = parser.parse(text, len);
+ * for (EJsonValue v = root["statuses"].first(); !v.isUndefined(); v = v.next()) {
+ *     llong id = v["id"].getLLong();
+ *     EString name = v["user"]["name"].getString("");
+ * }
+ * </pre>
+ */
+
+class EJsonValue: public EObject {
+public:
+	enum Type {
+		TYPE_UNDEFINED = 0,
+		TYPE_NULL,
+		TYPE_BOOLEAN,
+		TYPE_NUMBER,
+		TYPE_STRING,
+		TYPE_ARRAY,
+		TYPE_OBJECT
+	};
+
+	virtual ~EJsonValue();
+
+	/**
+	 * Creates an undefined value.
+	 */
+	EJsonValue();
+
+	Type type();
+
+	boolean isUndefined();
+	boolean isNull();
+	boolean isBoolean();
+	boolean isNumber();
+	boolean isString();
+	boolean isArray();
+	boolean isObject();
+
+	/**
+	 * Returns the member of an object, undefined if no such member or this
+	 * is not an object.  Escaped names are matched after unescaping.
+	 */
+	EJsonValue get(const char *key) THROWS(EDataFormatException);
+
+	/**
+	 * Returns the element of an array from 0, undefined if out of range or
+	 * this is not an array.
+	 */
+	EJsonValue get(int index);
+
+	EJsonValue operator[](const char *key);
+	EJsonValue operator[](int index);
+
+	boolean has(const char *key);
+
+	/**
+	 * Returns the number of elements or members, 0 if not a container.
+	 */
+	int size();
+
+	/**
+	 * Iterates the elements of an array or the member values of an object,
+	 * the end is an undefined value.
+	 */
+	EJsonValue first();
+	EJsonValue next();
+
+	/**
+	 * Returns the name of a member value (as got by get(key), first() or
+	 * next() on an object).
+	 */
+	EString key() THROWS2(EIllegalStateException, EDataFormatException);
+
+	/**
+	 * Returns the name of a member value as written, without the quotes
+	 * but not unescaped; null if not a member.
+	 */
+	const char* rawKey(int *len);
+
+	/**
+	 * Strings are unescaped, numbers and literals are returned as written,
+	 * containers as their json text.
+	 */
+	EString getString() THROWS2(ENoSuchElementException, EDataFormatException);
+
+	/**
+	 * Numbers, and strings holding a number, are converted; a number with
+	 * a fraction or an exponent is truncated.
+	 */
+	llong getLLong() THROWS2(ENoSuchElementException, ENumberFormatException);
+	int getInt() THROWS2(ENoSuchElementException, ENumberFormatException);
+	double getDouble() THROWS2(ENoSuchElementException, ENumberFormatException);
+	boolean getBoolean() THROWS2(ENoSuchElementException, EIllegalStateException);
+
+	/**
+	 * Same as above, but the default is returned if undefined or null.
+	 */
+	EString getString(const char *defaultValue) THROWS(EDataFormatException);
+	llong getLLong(llong defaultValue) THROWS(ENumberFormatException);
+	int getInt(int defaultValue) THROWS(ENumberFormatException);
+	double getDouble(double defaultValue) THROWS(ENumberFormatException);
+	boolean getBoolean(boolean defaultValue) THROWS(EIllegalStateException);
+
+	/**
+	 * Returns the json text of the value in the parser's buffer, strings
+	 * with their quotes; null if undefined.
+	 */
+	const char* raw(int *len);
+
+	virtual EString toString();
+
+private:
+	friend class EJsonParser;
+
+	EJsonParser *doc;
+	int pos;    // the structural index of the value, -1 if undefined
+	int keyPos; // the structural index of the member name, -1 if none
+
+	EJsonValue(EJsonParser *doc, int pos, int keyPos);
+
+	char firstChar();
+	int skip(int i);
+	int endOffset();
+};
+
+} /* namespace efc */
+#endif /* EJSONVALUE_HH_ */
@@ -0,0 +1,92 @@
+/*
+ * EJsonWriter.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EJSONWRITER_HH_
+#define EJSONWRITER_HH_
+
+#include "EJsonValue.hh"
+#include "EByteArrayOutputStream.hh"
+
+namespace efc {
+
+/**
+ * Writes compact json text to a byte array stream.
+ *
+ * <p>The separators are added automatically, the text is gathered in an
+ * internal buffer and written to the stream by blocks, at flush() and at
+ * last when the writer is deleted.  Strings are escaped with a table of
+ * the bytes which need it, the runs of plain bytes are copied at once;
+ * doubles are written as the shortest text which reads back the same
+ * value (NaN and infinities as null, like javascript).
+ *
+ * <pre>
+ * EByteArrayOutputStream baos;
+ * {
+ *     EJsonWriter w(&baos);
+ *     w.startObject().key("id").value(1LL).key("tags").startArray();
+ *     w.value("a").value("b").endArray().endObject();
+ * }
+ * </pre>
+ *
+ * <p>The writer doesn't check the nesting, it is the caller's job.
+ */
+
+class EJsonWriter: public EObject {
+public:
+	virtual ~EJsonWriter();
+
+	explicit
+	EJsonWriter(EByteArrayOutputStream *out);
+
+	EJsonWriter& startObject();
+	EJsonWriter& endObject();
+	EJsonWriter& startArray();
+	EJsonWriter& endArray();
+
+	/**
+	 * Writes the name of the next member.
+	 */
+	EJsonWriter& key(const char *name, int len=-1);
+
+	/**
+	 * Writes a string, or null if s is null.
+	 */
+	EJsonWriter& value(const char *s, int len=-1);
+	EJsonWriter& value(const EString& s);
+	EJsonWriter& value(int v);
+	EJsonWriter& value(llong v);
+	EJsonWriter& value(double v);
+	EJsonWriter& value(boolean v);
+
+	/**
+	 * Copies the json text of a parsed value.
+	 */
+	EJsonWriter& value(const EJsonValue& v);
+
+	EJsonWriter& nullValue();
+
+	/**
+	 * Writes the buffered text to the stream.
+	 */
+	void flush();
+
+private:
+	EByteArrayOutputStream *out;
+	char buf[4096];
+	int pos;
+	boolean comma; // the next value or name needs a comma
+
+	void separate();
+	void put(const char *s, int len);
+	void putString(const char *s, int len);
+
+	EJsonWriter(const EJsonWriter& that);
+	EJsonWriter& operator= (const EJsonWriter& that);
+};
+
+} /* namespace efc */
+#endif /* EJSONWRITER_HH_ */
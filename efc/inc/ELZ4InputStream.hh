@@ -0,0 +1,90 @@
+/*
+ * ELZ4InputStream.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ELZ4INPUTSTREAM_HH_
+#define ELZ4INPUTSTREAM_HH_
+
+#include "EFilterInputStream.hh"
+#include "EEOFException.hh"
+#include "EA.hh"
+
+namespace efc {
+
+/**
+ * This class implements a stream filter for reading compressed data in the
+ * LZ4 frame format: the frames of ELZ4OutputStream and of the lz4 command
+ * line, with independent or linked blocks, with or without the checksums.
+ * Concatenated frames are read as one stream and the skippable frames are
+ * skipped; the frames with a dictionary id are not supported.
+ *
+ * @see ELZ4OutputStream
+ */
+
+class ELZ4InputStream: public EFilterInputStream {
+public:
+	virtual ~ELZ4InputStream();
+
+	/**
+	 * Creates a new input stream and reads the first frame header.
+	 * @param in the input stream
+	 * @exception IOException if an I/O error has occurred or the input is
+	 *            not an LZ4 frame
+	 */
+	ELZ4InputStream(EInputStream* in, boolean owned=false) THROWS(EIOException);
+
+	/**
+	 * Reads uncompressed data into an array of bytes.
+	 * @param b the buffer into which the data is read
+	 * @param len the maximum number of bytes read
+	 * @return	the actual number of bytes read, or -1 if the end of the
+	 *		compressed input stream is reached
+	 * @exception IOException if an I/O error has occurred or the compressed
+	 *			      input data is corrupt
+	 */
+	virtual int read(void *b, int len) THROWS(EIOException);
+	virtual int read() THROWS(EIOException);
+
+	/**
+	 * Skips over and discards <code>n</code> bytes of uncompressed data.
+	 */
+	virtual long skip(long n) THROWS(EIOException);
+
+	/**
+	 * Returns the number of decompressed bytes which can be read without
+	 * blocking.
+	 */
+	virtual long available() THROWS(EIOException);
+
+	/**
+	 * Closes this input stream and releases any system resources associated
+	 * with the stream.
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void close() THROWS(EIOException);
+
+private:
+	es_lz4f_info_t _info;
+	EA<byte> *_buf;  // 64KB of history for the linked blocks, then the block
+	EA<byte> *_cbuf; // the compressed block and its checksum
+	int _pos;
+	int _limit;
+	int _history;
+	llong _produced;
+	boolean _eof;
+	boolean _closed;
+	es_xxh32_t _hash;
+
+	void ensureOpen() THROWS(EIOException);
+	boolean fill() THROWS(EIOException);
+	boolean readHeader() THROWS(EIOException);
+	boolean readBlock() THROWS(EIOException);
+	void readTrailer() THROWS(EIOException);
+	int readFully(void* b, int len) THROWS(EIOException);
+};
+
+} /* namespace efc */
+#endif /* ELZ4INPUTSTREAM_HH_ */
@@ -0,0 +1,88 @@
+/*
+ * ELZ4OutputStream.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ELZ4OUTPUTSTREAM_HH_
+#define ELZ4OUTPUTSTREAM_HH_
+
+#include "EFilterOutputStream.hh"
+#include "EA.hh"
+
+namespace efc {
+
+/**
+ * This class implements a stream filter for writing compressed data in the
+ * LZ4 frame format, which the lz4 command line and the other LZ4 libraries
+ * read.
+ *
+ * <p>The data is gathered into blocks which are compressed independently,
+ * a block which doesn't shrink is stored as is, and the frame ends with the
+ * xxHash32 of the content.  flush() ends the current block early, so that
+ * the reader gets all the data written so far.
+ *
+ * @see ELZ4InputStream
+ */
+
+class ELZ4OutputStream: public EFilterOutputStream {
+public:
+	static const int DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+	virtual ~ELZ4OutputStream();
+
+	/**
+	 * Creates a new output stream.
+	 * @param out the output stream
+	 * @param blockSize 64KB, 256KB, 1MB or 4MB, the others are rounded up
+	 * @param acceleration 1 for the best ratio, the larger the faster
+	 */
+	ELZ4OutputStream(EOutputStream* out, int blockSize=DEFAULT_BLOCK_SIZE,
+			int acceleration=1, boolean owned=false);
+
+	/**
+	 * Writes an array of bytes to the compressed output stream.
+	 * @param b the data to be written
+	 * @param len the length of the data
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void write(const void *b, int len) THROWS(EIOException);
+	virtual void write(const char *s) THROWS(EIOException);
+	virtual void write(int b) THROWS(EIOException);
+
+	/**
+	 * Writes the last block and the end of the frame without closing the
+	 * underlying stream.
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void finish() THROWS(EIOException);
+
+	/**
+	 * Finishes the frame and closes the underlying stream.
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void close() THROWS(EIOException);
+
+	/**
+	 * Writes the buffered data as a block and flushes the underlying stream.
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void flush() THROWS(EIOException);
+
+private:
+	EA<byte> *_buf;  // the block being filled
+	EA<byte> *_cbuf; // the length and the compressed block
+	int _count;
+	int _blockSize;
+	int _acceleration;
+	boolean _started;
+	boolean _finished;
+	es_xxh32_t _hash;
+
+	void writeHeader() THROWS(EIOException);
+	void writeBlock(const void *b, int len) THROWS(EIOException);
+};
+
+} /* namespace efc */
+#endif /* ELZ4OUTPUTSTREAM_HH_ */
@@ -0,0 +1,106 @@
+/*
+ * ELZMAInputStream.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ELZMAINPUTSTREAM_HH_
+#define ELZMAINPUTSTREAM_HH_
+
+#include "EFilterInputStream.hh"
+#include "EEOFException.hh"
+#include "EArrayDeque.hh"
+#include "EA.hh"
+#include "./concurrent/EExecutorService.hh"
+
+namespace efc {
+
+/**
+ * This class implements a stream filter for reading the compressed data
+ * written by ELZMAOutputStream.
+ *
+ * <p>With an executor the following blocks are read ahead by the caller's
+ * thread and decompressed in parallel, a few per processor at most.
+ *
+ * @see ELZMAOutputStream
+ */
+
+class ELZMAInputStream: public EFilterInputStream {
+public:
+	virtual ~ELZMAInputStream();
+
+	/**
+	 * Creates a new input stream which decompresses in the caller's thread,
+	 * the header is read by the constructor.
+	 * @param in the input stream
+	 * @exception IOException if an I/O error has occurred or the input is
+	 *            not in the format
+	 */
+	ELZMAInputStream(EInputStream* in, boolean owned=false) THROWS(EIOException);
+
+	/**
+	 * Creates a new input stream which decompresses on the executor.
+	 * @param in the input stream
+	 * @param executor runs the decompression tasks, it must outlive the stream
+	 * @exception IOException if an I/O error has occurred or the input is
+	 *            not in the format
+	 */
+	ELZMAInputStream(EInputStream* in, EExecutorService* executor,
+			boolean owned=false) THROWS(EIOException);
+
+	/**
+	 * Reads uncompressed data into an array of bytes.
+	 * @param b the buffer into which the data is read
+	 * @param len the maximum number of bytes read
+	 * @return	the actual number of bytes read, or -1 if the end of the
+	 *		compressed input stream is reached
+	 * @exception IOException if an I/O error has occurred or the compressed
+	 *			      input data is corrupt
+	 */
+	virtual int read(void *b, int len) THROWS(EIOException);
+	virtual int read() THROWS(EIOException);
+
+	/**
+	 * Skips over and discards <code>n</code> bytes of uncompressed data.
+	 */
+	virtual long skip(long n) THROWS(EIOException);
+
+	/**
+	 * Returns the number of decompressed bytes which can be read without
+	 * blocking.
+	 */
+	virtual long available() THROWS(EIOException);
+
+	/**
+	 * Closes this input stream and releases any system resources associated
+	 * with the stream.
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void close() THROWS(EIOException);
+
+private:
+	class Block;
+
+	EExecutorService* _executor;
+	int _maxPending;
+	es_uint8_t _props[ES_LZMA_PROPS_SIZE];
+	int _blockSize;
+	EArrayDeque<sp<Block> >* _pending;
+	sp<EA<byte> > _chunk;
+	int _chunkPos;
+	llong _totalOut;
+	boolean _ended;  // the end of the input is reached
+	boolean _eof;
+	boolean _closed;
+
+	void init() THROWS(EIOException);
+	void ensureOpen() THROWS(EIOException);
+	boolean fill() THROWS(EIOException);
+	sp<Block> readBlock() THROWS(EIOException);
+	sp<EA<byte> > finish(sp<Block> block) THROWS(EIOException);
+	void readFully(void* b, int len) THROWS(EIOException);
+};
+
+} /* namespace efc */
+#endif /* ELZMAINPUTSTREAM_HH_ */
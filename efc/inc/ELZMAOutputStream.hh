@@ -0,0 +1,116 @@
+/*
+ * ELZMAOutputStream.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ELZMAOUTPUTSTREAM_HH_
+#define ELZMAOUTPUTSTREAM_HH_
+
+#include "EFilterOutputStream.hh"
+#include "EArrayDeque.hh"
+#include "EA.hh"
+#include "./concurrent/EExecutorService.hh"
+
+namespace efc {
+
+/**
+ * This class implements a stream filter for writing compressed data with
+ * LZMA, in a container of independent blocks, xz style:
+ *
+ * <pre>
+ * header:  "ELZM", version 1, the 5 bytes of lzma properties, block size
+ * block:   length, compressed length (bit 31 if stored), crc32, data
+ * end:     0, total length (8 bytes)
+ * </pre>
+ *
+ * All the integers are little endian, of 4 bytes except the total length.
+ *
+ * <p>As the blocks don't depend on each other, with an executor they are
+ * compressed in parallel and written in order by the caller's thread, and
+ * ELZMAInputStream decompresses them in parallel too.  The larger the
+ * blocks the better the ratio, the dictionary never exceeds a block.
+ *
+ * @see ELZMAInputStream
+ */
+
+class ELZMAOutputStream: public EFilterOutputStream {
+public:
+	static const int DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+	static const int DEFAULT_LEVEL = 5;
+
+	virtual ~ELZMAOutputStream();
+
+	/**
+	 * Creates a new output stream which compresses in the caller's thread.
+	 * @param out the output stream
+	 * @param level the compression level, 0 to 9
+	 * @param blockSize the uncompressed size of a block, 64KB to 256MB
+	 * @exception IllegalArgumentException if blockSize is out of range
+	 */
+	ELZMAOutputStream(EOutputStream* out, int level=DEFAULT_LEVEL,
+			int blockSize=DEFAULT_BLOCK_SIZE, boolean owned=false);
+
+	/**
+	 * Creates a new output stream which compresses on the executor.
+	 * @param out the output stream
+	 * @param executor runs the compression tasks, it must outlive the stream
+	 * @param level the compression level, 0 to 9
+	 * @param blockSize the uncompressed size of a block, 64KB to 256MB
+	 * @exception IllegalArgumentException if blockSize is out of range
+	 */
+	ELZMAOutputStream(EOutputStream* out, EExecutorService* executor,
+			int level=DEFAULT_LEVEL, int blockSize=DEFAULT_BLOCK_SIZE,
+			boolean owned=false);
+
+	/**
+	 * Writes an array of bytes to the compressed output stream.
+	 * @param b the data to be written
+	 * @param len the length of the data
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void write(const void *b, int len) THROWS(EIOException);
+	virtual void write(const char *s) THROWS(EIOException);
+	virtual void write(int b) THROWS(EIOException);
+
+	/**
+	 * Writes the last block and the end of the stream without closing the
+	 * underlying stream.
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void finish() THROWS(EIOException);
+
+	/**
+	 * Finishes the stream and closes the underlying stream.
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void close() THROWS(EIOException);
+
+	/**
+	 * Ends the current block early, waits the blocks written so far and
+	 * writes them to the underlying stream, then flushes it.
+	 * @exception IOException if an I/O error has occurred
+	 */
+	virtual void flush() THROWS(EIOException);
+
+private:
+	class Block;
+
+	EExecutorService* _executor;
+	int _level;
+	int _blockSize;
+	int _maxPending;
+	sp<EA<byte> > _block;        // the data of the next block
+	int _blockLen;
+	EArrayDeque<sp<Block> >* _pending;
+	llong _totalIn;
+	boolean _finished;
+
+	void init(int level, int blockSize);
+	void submit() THROWS(EIOException);
+	void drain(int keep) THROWS(EIOException);
+};
+
+} /* namespace efc */
+#endif /* ELZMAOUTPUTSTREAM_HH_ */
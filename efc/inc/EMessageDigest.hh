@@ -0,0 +1,127 @@
+/*
+ * EMessageDigest.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EMESSAGEDIGEST_HH_
+#define EMESSAGEDIGEST_HH_
+
+#include "EA.hh"
+#include "EString.hh"
+#include "EIllegalArgumentException.hh"
+
+namespace efc {
+
+/**
+ * This MessageDigest class provides the functionality of a message digest
+ * algorithm: MD5, SHA-1, SHA-256, SHA-384 or SHA-512.
+ *
+ * <p>The data is processed through the update methods, then digest()
+ * completes the hash computation and resets the digest for a new one.
+ * SHA-1 and SHA-256 use the SHA extensions of the cpu when they are
+ * available.
+ *
+ * <p>A MessageDigest object is not thread safe.
+ */
+
+class EMessageDigest: public EObject {
+public:
+	/**
+	 * The length of the longest digest, of SHA-512.
+	 */
+	static const int MAX_DIGEST_LENGTH = 64;
+
+	virtual ~EMessageDigest();
+
+	/**
+	 * Creates a message digest of the specified algorithm.
+	 * @param algorithm "MD5", "SHA-1", "SHA-256", "SHA-384" or "SHA-512",
+	 *        the case and the dash don't matter
+	 * @exception IllegalArgumentException if the algorithm is unknown
+	 */
+	explicit EMessageDigest(const char* algorithm) THROWS(EIllegalArgumentException);
+
+	/**
+	 * Returns a new message digest of the specified algorithm, as
+	 * {@code MessageDigest.getInstance()}.
+	 */
+	static sp<EMessageDigest> getInstance(const char* algorithm) THROWS(EIllegalArgumentException);
+
+	/**
+	 * Updates the digest using the specified byte.
+	 */
+	void update(byte input);
+
+	/**
+	 * Updates the digest using the specified array of bytes.
+	 */
+	void update(const void* input, int len);
+
+	/**
+	 * Completes the hash computation into buf and resets the digest.
+	 * @return the number of bytes placed into buf
+	 * @exception IllegalArgumentException if len is less than the digest
+	 *            length
+	 */
+	int digest(void* buf, int len) THROWS(EIllegalArgumentException);
+
+	/**
+	 * Completes the hash computation and resets the digest.
+	 * @return the array of bytes for the resulting hash value
+	 */
+	sp<EA<byte> > digest();
+
+	/**
+	 * Performs a final update on the digest using the specified array of
+	 * bytes, then completes the digest computation.
+	 */
+	sp<EA<byte> > digest(const void* input, int len);
+
+	/**
+	 * Resets the digest for further use.
+	 */
+	void reset();
+
+	/**
+	 * Returns the standard name of the algorithm.
+	 */
+	const char* getAlgorithm();
+
+	/**
+	 * Returns the length of the digest in bytes.
+	 */
+	int getDigestLength();
+
+	/**
+	 * Compares two digests for equality, in a time which doesn't depend on
+	 * where they differ.
+	 */
+	static boolean isEqual(const void* digesta, int lena, const void* digestb, int lenb);
+
+	/**
+	 * Computes the SHA-256 digests of n independent messages at once, into
+	 * digests of n * 32 bytes.  For many small messages, such as the keys
+	 * of a content addressed store: without the SHA extensions they are
+	 * hashed 8 at a time in the lanes of AVX2.
+	 */
+	static void sha256(const void* const data[], const int len[], void* digests, int n);
+
+	/**
+	 * Returns a string of the algorithm name.
+	 */
+	virtual EString toString();
+
+private:
+	int _algorithm;
+	union {
+		es_md5_ctx_t md5;
+		es_sha1_ctx_t sha1;
+		es_sha256_ctx_t sha256;
+		es_sha512_ctx_t sha512;
+	} _ctx;
+};
+
+} /* namespace efc */
+#endif /* EMESSAGEDIGEST_HH_ */
@@ -133,6 +133,17 @@ interface ESocketOptions : virtual public EObject {
 
     const static int _SO_REUSEADDR;// = 0x0004;
 
+    /** Sets SO_REUSEPORT for a socket.  Several sockets bound to the same
+     * address and port with this option share the incoming connections or
+     * datagrams, the kernel balancing them across the sockets.
+     * <P>
+     * Not supported on every platform, setting it throws a
+     * {@link SocketException} where it is not.
+     * @since 9
+     */
+
+    const static int _SO_REUSEPORT;// = 0x000E;
+
     /**
      * Sets SO_BROADCAST for a socket. This option enables and disables 
      * the ability of the process to send broadcast messages. It is supported
@@ -292,6 +303,25 @@ interface ESocketOptions : virtual public EObject {
      */
     const static int _SO_OOBINLINE;// = 0x1003;
 
+    /**
+     * Sets UDP_SEGMENT (generic segmentation offload) for a datagram
+     * socket.  Takes the segment size: each datagram sent is split by the
+     * kernel, or the network card, into datagrams of that size, so that
+     * one send carries many datagrams to the same target.
+     * <P>
+     * Linux only, setting it throws a {@link SocketException} elsewhere.
+     */
+    const static int _UDP_SEGMENT;// = 0x2001;
+
+    /**
+     * Sets UDP_GRO (generic receive offload) for a datagram socket.  The
+     * datagrams of a flow received together may then be coalesced into
+     * one, and their segment size is reported along with it.
+     * <P>
+     * Linux only, setting it throws a {@link SocketException} elsewhere.
+     */
+    const static int _UDP_GRO;// = 0x2002;
+
     /* ip_mreq; add an IP group membership */
     const static int _IP_ADD_MEMBERSHIP; // = 0x0c
 
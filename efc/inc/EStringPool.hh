@@ -0,0 +1,105 @@
+/*
+ * EStringPool.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ESTRINGPOOL_HH_
+#define ESTRINGPOOL_HH_
+
+#include "EString.hh"
+#include "EA.hh"
+#include "ESharedPtr.hh"
+
+namespace efc {
+
+/**
+ * A concurrent string intern table: equal strings are stored once, and
+ * all callers get the same shared <code>EString</code> object back, so
+ * interned strings compare by pointer and their <code>hashCode()</code>
+ * is computed only once.
+ *
+ * <p>The table is split into lock striped segments in the same way as
+ * <code>EConcurrentHashMap</code>: lookups of already interned strings
+ * never lock, only inserts lock one segment.  A lookup publishes its epoch
+ * in a slot of its thread, and what the inserts unlink is freed once no
+ * lookup can still see it, so the memory stays bounded under constant
+ * lookups.
+ *
+ * <p>In the weak mode the pool doesn't keep the strings alive: a string
+ * is freed when the last handle is released, its dead entry is dropped
+ * when the segment needs room or by {@link #purge()}.
+ *
+ * <p>The returned strings are shared, so they are handed out const.
+ */
+
+class EStringPool: public EObject {
+public:
+	virtual ~EStringPool();
+
+	/**
+	 * Creates a new, empty pool.
+	 *
+	 * @param weak  the weak mode, entries nobody uses get evicted
+	 * @param concurrencyLevel the estimated number of concurrently
+	 * interning threads
+	 */
+	explicit
+	EStringPool(boolean weak=false, int concurrencyLevel=16);
+
+	/**
+	 * Returns the pooled string equal to the given chars, adding a copy of
+	 * them if there is none yet.
+	 */
+	sp<const EString> intern(const char* s);
+	sp<const EString> intern(const char* s, int len);
+	sp<const EString> intern(const EString& s);
+
+	/**
+	 * Returns the pooled string equal to the given chars, or null if
+	 * there is none; never adds.
+	 */
+	sp<const EString> lookup(const char* s, int len);
+
+	/**
+	 * Returns the number of entries, in the weak mode including the
+	 * dead ones not evicted yet.
+	 */
+	int size();
+
+	/**
+	 * Evicts the entries of strings already freed (weak mode only).
+	 *
+	 * @return the number of evicted entries
+	 */
+	int purge();
+
+	/**
+	 * Returns true if the pool is in the weak mode.
+	 */
+	boolean isWeak();
+
+private:
+	class Node;
+	struct Table;
+	class Reader;
+	class ThreadLocalReader;
+	class Epochs;
+	class Segment;
+
+	sp<Epochs> epochs_;
+	EA<Segment*>* segments_;
+	int segmentShift;
+	int segmentMask;
+	boolean weak;
+
+	static int hashOf(const char* s, int len);
+	Segment* segmentFor(int hash);
+
+	EStringPool(const EStringPool& that);
+	EStringPool& operator= (const EStringPool& that);
+};
+
+} /* namespace efc */
+#endif /* ESTRINGPOOL_HH_ */
@@ -10,6 +10,7 @@
 
 #include "../EAbstractQueue.hh"
 #include "../EA.hh"
+#include "../EMath.hh"
 #include "../EIllegalArgumentException.hh"
 #include "../EArrayIndexOutOfBoundsException.hh"
 
@@ -11,6 +11,7 @@
 #include "../EMap.hh"
 #include "../EMath.hh"
 #include "../EInteger.hh"
+#include "../EHashing.hh"
 #include "../ESet.hh"
 #include "./EConcurrentMap.hh"
 #include "../EAbstractCollection.hh"
@@ -840,6 +841,18 @@ public:
 		init(initialCapacity, loadFactor, concurrencyLevel);
 	}
 
+	/**
+	 * Creates a new, empty map with the specified initial capacity,
+	 * load factor, concurrency level and hashing policy.
+	 *
+	 * @param policy the hashing policy of the keys, see EHashing
+	 */
+	EConcurrentHashMap(int initialCapacity, float loadFactor, int concurrencyLevel,
+			EHashing::Policy policy) {
+		init(initialCapacity, loadFactor, concurrencyLevel);
+		hashSeed = EHashing::seedOf(policy);
+	}
+
 	/**
 	 * Creates a new, empty map with the specified initial capacity
 	 * and load factor and with the default concurrencyLevel (16).
@@ -888,7 +901,7 @@ public:
 	 * @param m the map
 	 */
 	EConcurrentHashMap(EMap<K, V>* m) :
-			segmentMask(0), segmentShift(0), segments_(null) {
+			segmentMask(0), segmentShift(0), hashSeed(0), segments_(null) {
 		this(EMath::max((int) (m->size() / CHM_DEFAULT_LOAD_FACTOR) + 1,
 						CHM_DEFAULT_INITIAL_CAPACITY), CHM_DEFAULT_LOAD_FACTOR,
 				CHM_DEFAULT_CONCURRENCY_LEVEL);
@@ -1003,7 +1016,7 @@ public:
 	 * @throws NullPointerException if the specified key is null
 	 */
 	sp<V> get(K* key) {
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		return segmentFor(hash)->get(key, hash);
 	}
 
@@ -1017,7 +1030,7 @@ public:
 	 * @throws NullPointerException if the specified key is null
 	 */
 	boolean containsKey(K* key) {
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		return segmentFor(hash)->containsKey(key, hash);
 	}
 
@@ -1126,7 +1139,7 @@ public:
 	sp<V> put(sp<K> key, sp<V> value) {
 		if (value == null)
 			throw ENullPointerException(__FILE__, __LINE__);
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		return segmentFor(hash)->put(key, hash, value, false);
 	}
 
@@ -1140,7 +1153,7 @@ public:
 	sp<V> putIfAbsent(sp<K> key, sp<V> value) {
 		if (value == null)
 			throw ENullPointerException(__FILE__, __LINE__);
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		return segmentFor(hash)->put(key, hash, value, true);
 	}
 
@@ -1169,7 +1182,7 @@ public:
 	 * @throws NullPointerException if the specified key is null
 	 */
 	sp<V> remove(K* key) {
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		return segmentFor(hash)->remove(key, hash, null);
 	}
 
@@ -1179,7 +1192,7 @@ public:
 	 * @throws NullPointerException if the specified key is null
 	 */
 	boolean remove(K* key, V* value) {
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		if (value == null)
 			return false;
 		return segmentFor(hash)->remove(key, hash, value) != null;
@@ -1193,7 +1206,7 @@ public:
 	boolean replace(K* key, V* oldValue, sp<V> newValue) {
 		if (oldValue == null || newValue == null)
 			throw ENullPointerException(__FILE__, __LINE__);
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		return segmentFor(hash)->replace(key, hash, oldValue, newValue);
 	}
 
@@ -1207,7 +1220,7 @@ public:
 	sp<V> replace(K* key, sp<V> value) {
 		if (value == null)
 			throw ENullPointerException(__FILE__, __LINE__);
-		int hash = hashIt(key->hashCode());
+		int hash = hashOf(key);
 		return segmentFor(hash)->replace(key, hash, value);
 	}
 
@@ -1326,6 +1339,11 @@ protected:
 	 */
 	int segmentShift;
 
+	/**
+	 * The seed of the hashing policy, 0 for EHashing::JAVA.
+	 */
+	llong hashSeed;
+
 	/**
 	 * The segments, each of which is a specialized hash table
 	 */
@@ -1355,6 +1373,7 @@ private:
 		}
 		segmentShift = 32 - sshift;
 		segmentMask = ssize - 1;
+		hashSeed = EHashing::seedOf(EHashing::getDefaultPolicy());
 		segments_ = Segment::newArray(ssize);
 		entrySet_ = null;
 		keySet_ = null;
@@ -1393,6 +1412,16 @@ private:
 		return h ^ (((unsigned)h) >> 16);
 	}
 
+	/**
+	 * Hash of a key by the hashing policy.
+	 */
+	int hashOf(K* key) {
+		return hashSeed ? EHashing::hash32(key, hashSeed) : hashIt(key->hashCode());
+	}
+	int hashOf(const sp<K>& key) {
+		return hashOf(key.get());
+	}
+
 	/**
 	 * Returns the segment that should be used for key with given hash
 	 * @param hash the hash code for the key
@@ -1938,6 +1967,12 @@ public: \
 	EConcurrentHashMap(int initialCapacity, float loadFactor, int concurrencyLevel) { \
 		init(initialCapacity, loadFactor, concurrencyLevel); \
 	} \
+ \
+	EConcurrentHashMap(int initialCapacity, float loadFactor, int concurrencyLevel, \
+			EHashing::Policy policy) { \
+		init(initialCapacity, loadFactor, concurrencyLevel); \
+		hashSeed = EHashing::seedOf(policy); \
+	} \
  \
 	EConcurrentHashMap(int initialCapacity, float loadFactor) { \
 		init(initialCapacity, loadFactor, CHM_DEFAULT_CONCURRENCY_LEVEL); \
@@ -1952,7 +1987,7 @@ public: \
 	} \
  \
 	EConcurrentHashMap(EMap<K, V>* m) : \
-			segmentMask(0), segmentShift(0), segments_(null) { \
+			segmentMask(0), segmentShift(0), hashSeed(0), segments_(null) { \
 		this(EMath::max((int) (m->size() / CHM_DEFAULT_LOAD_FACTOR) + 1, \
 						CHM_DEFAULT_INITIAL_CAPACITY), CHM_DEFAULT_LOAD_FACTOR, \
 				CHM_DEFAULT_CONCURRENCY_LEVEL); \
@@ -2030,12 +2065,12 @@ public: \
 	} \
  \
 	sp<V> get(K key) { \
-		int hash = hashIt(key); \
+		int hash = hashOf(key); \
 		return segmentFor(hash)->get(key, hash); \
 	} \
  \
 	boolean containsKey(K key) { \
-		int hash = hashIt(key); \
+		int hash = hashOf(key); \
 		return segmentFor(hash)->containsKey(key, hash); \
 	} \
  \
@@ -2101,14 +2136,14 @@ public: \
 	sp<V> put(K key, sp<V> value) { \
 		if (value == null) \
 			throw ENullPointerException(__FILE__, __LINE__); \
-		int hash = hashIt(key); \
+		int hash = hashOf(key); \
 		return segmentFor(hash)->put(key, hash, value, false); \
 	} \
  \
 	sp<V> putIfAbsent(K key, sp<V> value) { \
 		if (value == null) \
 			throw ENullPointerException(__FILE__, __LINE__); \
-		int hash = hashIt(key); \
+		int hash = hashOf(key); \
 		return segmentFor(hash)->put(key, hash, value, true); \
 	} \
  \
@@ -2121,12 +2156,12 @@ public: \
 	} \
  \
 	sp<V> remove(K key) { \
-		int hash = hashIt(key); \
+		int hash = hashOf(key); \
 		return segmentFor(hash)->remove(key, hash, null); \
 	} \
  \
 	boolean remove(K key, V* value) { \
-		int hash = hashIt(key); \
+		int hash = hashOf(key); \
 		if (value == null) \
 			return false; \
 		return segmentFor(hash)->remove(key, hash, value) != null; \
@@ -2135,14 +2170,14 @@ public: \
 	boolean replace(K key, V* oldValue, sp<V> newValue) { \
 		if (oldValue == null || newValue == null) \
 			throw ENullPointerException(__FILE__, __LINE__); \
-		int hash = hashIt(key); \
+		int hash = hashOf(key); \
 		return segmentFor(hash)->replace(key, hash, oldValue, newValue); \
 	} \
  \
 	sp<V> replace(K key, sp<V> value) { \
 		if (value == null) \
 			throw ENullPointerException(__FILE__, __LINE__); \
-		int hash = hashIt(key); \
+		int hash = hashOf(key); \
 		return segmentFor(hash)->replace(key, hash, value); \
 	} \
  \
@@ -2184,6 +2219,7 @@ protected: \
 	friend class HashIterator; \
 	int segmentMask; \
 	int segmentShift; \
+	llong hashSeed; \
 	EA<Segment*>* segments_; \
 	ESet<sp<EConcurrentMapEntry<K,V> > >* entrySet_; \
 	ESet<K>* keySet_; \
@@ -2208,6 +2244,7 @@ private: \
 		} \
 		segmentShift = 32 - sshift; \
 		segmentMask = ssize - 1; \
+		hashSeed = EHashing::seedOf(EHashing::getDefaultPolicy()); \
 		segments_ = Segment::newArray(ssize); \
 		entrySet_ = null; \
 		keySet_ = null; \
@@ -2234,6 +2271,10 @@ private: \
 		h += (h <<   2) + (h << 14); \
 		return h ^ (((unsigned)h) >> 16); \
 	} \
+ \
+	int hashOf(K key) { \
+		return hashSeed ? EHashing::hash32(key, hashSeed) : hashIt(key); \
+	} \
  \
 	Segment* segmentFor(int hash) { \
 		return (*segments_)[(((unsigned)hash) >> segmentShift) & segmentMask]; \
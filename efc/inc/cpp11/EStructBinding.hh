@@ -0,0 +1,712 @@
+/*
+ * EStructBinding.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ESTRUCTBINDING_HH_
+#define ESTRUCTBINDING_HH_
+
+#include "../../EBase.hh"
+
+#ifdef CPP11_SUPPORT
+
+#include "../EString.hh"
+#include "../EArrayList.hh"
+#include "../EHashMap.hh"
+#include "../EBson.hh"
+#include "../EBsonView.hh"
+#include "../EJsonParser.hh"
+#include "../EJsonWriter.hh"
+#include "../EByteArrayOutputStream.hh"
+
+namespace efc {
+
+/** How to use it:
+	struct Address: public EObject {
+		EString city;
+		int zip;
+	};
+	struct User: public EObject {
+		llong id;
+		EString name;
+		Address address;
+		EArrayList<int> scores;
+		EArrayList<Address*> others;
+		EHashMap<EString*, EString*> tags;
+	};
+
+	// at the global scope, after the structs
+	ES_BINDING(Address, city, zip)
+	ES_BINDING(User, id, name, address, scores, others, tags)
+
+	// json
+	EString text = EStructBinding::toJson(user);
+	User u;
+	EStructBinding::fromJson(u, text.c_str(), text.length());
+
+	// bson, a node named "user" with a child per field
+	EByteArrayOutputStream out;
+	EStructBinding::toBson(&out, "user", user);
+	EBsonView view(out.data(), out.size());
+	EStructBinding::fromBson(u, view, "/user");
+ */
+
+/*
+ * ES_BINDING(TYPE, fields...) specializes EBinding<TYPE> with the list of
+ * the fields, which is walked in order to write, and a switch on the field
+ * names to read: the case labels are the slots of a perfect hash of the
+ * names, whose seed is searched at compile time, so that a name read from
+ * a document costs one hash and one compare.
+ *
+ * The field types are the ones of EBindingCodec: boolean, byte, short, int,
+ * llong, float, double, EString, a bound struct, a pointer to one of these
+ * (null is skipped), EArrayList<E> and EHashMap<EString*, V*>; as for any
+ * list, the structs in an EArrayList<T*> are EObjects.
+ *
+ * In bson, a struct is a node with a child per field, the elements of a
+ * list are repeated nodes of the field's name, the entries of a map are the
+ * children of the field's node.  Reading adds to the lists and maps, it
+ * should be done into new objects; fields missing or null in the document
+ * are left as they are.
+ */
+
+template<typename T>
+struct EBinding;
+
+/**
+ * The hash of the field names, the same at compile time and at run time.
+ */
+struct EBindingHash {
+	static constexpr es_uint32_t step(es_uint32_t h, char c) {
+		return (h ^ (es_uint8_t)c) * 16777619u;
+	}
+	static constexpr es_uint32_t fnv(const char *s, int n, es_uint32_t h) {
+		return (n == 0) ? h : fnv(s + 1, n - 1, step(h, *s));
+	}
+	static constexpr es_uint32_t fmix(es_uint32_t h) {
+		return h ^ (h >> 16);
+	}
+	static constexpr es_uint32_t of(const char *s, int n, es_uint32_t seed) {
+		return fmix(fmix(fnv(s, n, 2166136261u ^ (seed * 0x9E3779B9u))) * 0x45D9F3Bu);
+	}
+	static constexpr int length(const char *s) {
+		return *s ? 1 + length(s + 1) : 0;
+	}
+	static constexpr es_uint32_t tableSize(int fields, es_uint32_t n) {
+		return (n >= (es_uint32_t)fields * 4) ? n : tableSize(fields, n << 1);
+	}
+
+	static inline es_uint32_t hash(const char *s, int n, es_uint32_t seed) {
+		es_uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+		for (int i = 0; i < n; i++) {
+			h = step(h, s[i]);
+		}
+		return fmix(fmix(h) * 0x45D9F3Bu);
+	}
+};
+
+/**
+ * Searches the first seed which gives the field names of B distinct slots,
+ * in a table of at least 4 slots per field.
+ */
+template<typename B>
+struct EBindingPerfectHash {
+	static constexpr es_uint32_t MASK = EBindingHash::tableSize(B::FIELDS, 4) - 1;
+
+	static constexpr es_uint32_t slotOf(int i, es_uint32_t seed) {
+		return EBindingHash::of(B::fieldName(i), EBindingHash::length(B::fieldName(i)), seed) & MASK;
+	}
+	static constexpr bool distinct(int i, int j, es_uint32_t seed) {
+		return (j >= i) ? true : (slotOf(i, seed) != slotOf(j, seed) && distinct(i, j + 1, seed));
+	}
+	static constexpr bool perfect(int i, es_uint32_t seed) {
+		return (i >= B::FIELDS) ? true : (distinct(i, 0, seed) && perfect(i + 1, seed));
+	}
+	// halving the range keeps the recursion depth low
+	static constexpr es_uint32_t search(es_uint32_t lo, es_uint32_t hi) {
+		return (lo == hi) ? (perfect(0, lo) ? lo : 0) : orSearch(search(lo, (lo + hi) / 2), (lo + hi) / 2 + 1, hi);
+	}
+	static constexpr es_uint32_t orSearch(es_uint32_t found, es_uint32_t lo, es_uint32_t hi) {
+		return found ? found : search(lo, hi);
+	}
+	static constexpr es_uint32_t seed() {
+		return search(1, 4096);
+	}
+	static constexpr es_uint32_t slot(int i) {
+		return slotOf(i, seed());
+	}
+
+	static inline es_uint32_t slot(const char *s, int n) {
+		return EBindingHash::hash(s, n, seed()) & MASK;
+	}
+};
+
+/**
+ * Writes the records of the bson export format: the name, a flag byte
+ * (first child, last sibling, data type), the varint size and the value;
+ * the last sibling is only known when its parent is closed, so its flag
+ * is patched then.
+ */
+class EBindingBsonWriter {
+public:
+	explicit EBindingBsonWriter(EByteArrayOutputStream *out) :
+			out(out), last(-1) {
+	}
+
+	void leaf(const char *name, int len, int dtype, const void *data, int size) {
+		record(name, len, dtype, data, size);
+	}
+
+	void leafLLong(const char *name, int len, int dtype, llong v, int size) {
+		es_byte_t s[8];
+		eso_llong2array(v, s, size);
+		record(name, len, dtype, s, size);
+	}
+
+	int open(const char *name, int len) {
+		record(name, len, BSON_NODE_DATA_TYPE_STRING, "", 0);
+		int parent = last;
+		last = -1;
+		return parent;
+	}
+
+	void close(int parent) {
+		if (last >= 0) {
+			out->data()[last] |= LAST;
+		}
+		last = parent;
+	}
+
+	void finish() {
+		if (last >= 0) {
+			out->data()[last] |= LAST;
+			last = -1;
+		}
+		out->write("\x0\x0\xF", 3);
+	}
+
+private:
+	enum {
+		SUB = 0x40,
+		LAST = 0x20
+	};
+
+	EByteArrayOutputStream *out;
+	int last; // the flag offset of the last record of the level, -1 if none
+
+	void record(const char *name, int len, int dtype, const void *data, int size) {
+		es_uint8_t head[1 + 5];
+		head[0] = (es_uint8_t)(((last < 0) ? SUB : 0) | dtype);
+		int n = 1 + eso_varint32ToArray(size, head + 1);
+		out->write(name, len);
+		out->write("", 1);
+		last = out->size();
+		out->write(head, n);
+		if (size > 0) {
+			out->write(data, size);
+		}
+	}
+};
+
+/**
+ * A bson node to read: of an EBsonView, or of an EBson tree.
+ */
+struct EBindingViewNode {
+	EBsonView *view;
+	int node;
+
+	EBindingViewNode(EBsonView *view, int node) : view(view), node(node) {
+	}
+	boolean valid() { return node >= 0; }
+	const char* name() { return view->nameOf(node); }
+	const void* value(es_size_t *size, int *dtype) { return view->valueOf(node, size, dtype); }
+	EBindingViewNode firstChild() { return EBindingViewNode(view, view->firstChild(node)); }
+	EBindingViewNode nextSibling() { return EBindingViewNode(view, view->nextSibling(node)); }
+
+	template<typename X> void read(X& x);
+};
+
+struct EBindingTreeNode {
+	es_bson_node_t *node;
+
+	explicit EBindingTreeNode(es_bson_node_t *node) : node(node) {
+	}
+	boolean valid() { return node != null; }
+	const char* name() { return node->name; }
+	const void* value(es_size_t *size, int *dtype) {
+		*size = node->value->len;
+		*dtype = node->dtype;
+		return node->value->data;
+	}
+	EBindingTreeNode firstChild() { return EBindingTreeNode(node->child0); }
+	EBindingTreeNode nextSibling() { return EBindingTreeNode(node->next); }
+
+	template<typename X> void read(X& x);
+};
+
+/**
+ * The visitors of the EBinding field lists.
+ */
+struct EBindingJsonFields {
+	EJsonWriter& w;
+	explicit EBindingJsonFields(EJsonWriter& w) : w(w) {
+	}
+	template<typename X> void field(const char *name, int len, X& x);
+};
+
+struct EBindingBsonFields {
+	EBindingBsonWriter& w;
+	explicit EBindingBsonFields(EBindingBsonWriter& w) : w(w) {
+	}
+	template<typename X> void field(const char *name, int len, X& x);
+};
+
+struct EBindingJsonMember {
+	EJsonValue value;
+	explicit EBindingJsonMember(const EJsonValue& value) : value(value) {
+	}
+	template<typename X> void read(X& x);
+};
+
+/**
+ * The encoding of a field type, the primary template is for bound structs.
+ */
+template<typename T>
+struct EBindingCodec {
+	static void toJson(EJsonWriter& w, T& v) {
+		EBindingJsonFields f(w);
+		w.startObject();
+		EBinding<T>::write(f, v);
+		w.endObject();
+	}
+
+	static void fromJson(T& v, EJsonValue& j) {
+		for (EJsonValue m = j.first(); !m.isUndefined(); m = m.next()) {
+			int len;
+			const char *key = m.rawKey(&len);
+			EBindingJsonMember r(m);
+			if (!memchr(key, '\\', len)) {
+				EBinding<T>::read(v, key, len, r);
+			} else {
+				EString k = m.key();
+				EBinding<T>::read(v, k.c_str(), k.length(), r);
+			}
+		}
+	}
+
+	static void toBson(EBindingBsonWriter& w, const char *name, int len, T& v) {
+		EBindingBsonFields f(w);
+		int parent = w.open(name, len);
+		EBinding<T>::write(f, v);
+		w.close(parent);
+	}
+
+	template<typename R>
+	static void fromBson(T& v, R& node) {
+		for (R c = node.firstChild(); c.valid(); c = c.nextSibling()) {
+			const char *key = c.name();
+			EBinding<T>::read(v, key, (int)eso_strlen(key), c);
+		}
+	}
+};
+
+#define ES_BINDING_NUMBER_CODEC(TYPE, DTYPE, GET) \
+template<> \
+struct EBindingCodec<TYPE> { \
+	static void toJson(EJsonWriter& w, TYPE& v) { \
+		w.value(v); \
+	} \
+	static void fromJson(TYPE& v, EJsonValue& j) { \
+		v = (TYPE)j.GET(v); \
+	} \
+	static void toBson(EBindingBsonWriter& w, const char *name, int len, TYPE& v) { \
+		w.leafLLong(name, len, DTYPE, (llong)v, sizeof(TYPE)); \
+	} \
+	template<typename R> \
+	static void fromBson(TYPE& v, R& node) { \
+		es_size_t size; \
+		int dtype; \
+		const void *data = node.value(&size, &dtype); \
+		v = (TYPE)EBson::valueGetLLong(dtype, data, size); \
+	} \
+};
+
+ES_BINDING_NUMBER_CODEC(byte, BSON_NODE_DATA_TYPE_I8, getInt)
+ES_BINDING_NUMBER_CODEC(short, BSON_NODE_DATA_TYPE_I16, getInt)
+ES_BINDING_NUMBER_CODEC(int, BSON_NODE_DATA_TYPE_I32, getInt)
+ES_BINDING_NUMBER_CODEC(llong, BSON_NODE_DATA_TYPE_I64, getLLong)
+
+template<>
+struct EBindingCodec<boolean> {
+	static void toJson(EJsonWriter& w, boolean& v) {
+		w.value(v);
+	}
+	static void fromJson(boolean& v, EJsonValue& j) {
+		v = j.isNumber() ? (j.getLLong() != 0) : j.getBoolean(v);
+	}
+	static void toBson(EBindingBsonWriter& w, const char *name, int len, boolean& v) {
+		w.leafLLong(name, len, BSON_NODE_DATA_TYPE_I8, v ? 1 : 0, 1);
+	}
+	template<typename R>
+	static void fromBson(boolean& v, R& node) {
+		es_size_t size;
+		int dtype;
+		const void *data = node.value(&size, &dtype);
+		v = (EBson::valueGetLLong(dtype, data, size) != 0);
+	}
+};
+
+template<>
+struct EBindingCodec<float> {
+	static void toJson(EJsonWriter& w, float& v) {
+		w.value((double)v);
+	}
+	static void fromJson(float& v, EJsonValue& j) {
+		v = (float)j.getDouble(v);
+	}
+	static void toBson(EBindingBsonWriter& w, const char *name, int len, float& v) {
+		w.leafLLong(name, len, BSON_NODE_DATA_TYPE_FLOAT, eso_float2intBits(v), 4);
+	}
+	template<typename R>
+	static void fromBson(float& v, R& node) {
+		es_size_t size;
+		int dtype;
+		const void *data = node.value(&size, &dtype);
+		v = (float)EBson::valueGetDouble(dtype, data, size);
+	}
+};
+
+template<>
+struct EBindingCodec<double> {
+	static void toJson(EJsonWriter& w, double& v) {
+		w.value(v);
+	}
+	static void fromJson(double& v, EJsonValue& j) {
+		v = j.getDouble(v);
+	}
+	static void toBson(EBindingBsonWriter& w, const char *name, int len, double& v) {
+		w.leafLLong(name, len, BSON_NODE_DATA_TYPE_DOUBLE, eso_double2llongBits(v), 8);
+	}
+	template<typename R>
+	static void fromBson(double& v, R& node) {
+		es_size_t size;
+		int dtype;
+		const void *data = node.value(&size, &dtype);
+		v = EBson::valueGetDouble(dtype, data, size);
+	}
+};
+
+template<>
+struct EBindingCodec<EString> {
+	static void toJson(EJsonWriter& w, EString& v) {
+		w.value(v.c_str(), v.length());
+	}
+	static void fromJson(EString& v, EJsonValue& j) {
+		if (!j.isUndefined() && !j.isNull()) {
+			v = j.getString();
+		}
+	}
+	static void toBson(EBindingBsonWriter& w, const char *name, int len, EString& v) {
+		// with the '\0', as the strings of EBson
+		w.leaf(name, len, BSON_NODE_DATA_TYPE_STRING, v.c_str(), v.length() + 1);
+	}
+	template<typename R>
+	static void fromBson(EString& v, R& node) {
+		es_size_t size;
+		int dtype;
+		const void *data = node.value(&size, &dtype);
+		if (dtype == BSON_NODE_DATA_TYPE_STRING) {
+			v = EString((const char*)data, (size > 0) ? (int)size - 1 : 0);
+		} else {
+			v = EBson::valueGetString(dtype, data, size);
+		}
+	}
+};
+
+template<typename T>
+struct EBindingCodec<T*> {
+	static void toJson(EJsonWriter& w, T*& v) {
+		if (v) EBindingCodec<T>::toJson(w, *v);
+		else w.nullValue();
+	}
+	static void fromJson(T*& v, EJsonValue& j) {
+		if (j.isUndefined() || j.isNull()) {
+			return;
+		}
+		if (!v) {
+			v = new T();
+		}
+		EBindingCodec<T>::fromJson(*v, j);
+	}
+	static void toBson(EBindingBsonWriter& w, const char *name, int len, T*& v) {
+		if (v) {
+			EBindingCodec<T>::toBson(w, name, len, *v);
+		}
+	}
+	template<typename R>
+	static void fromBson(T*& v, R& node) {
+		if (!v) {
+			v = new T();
+		}
+		EBindingCodec<T>::fromBson(*v, node);
+	}
+};
+
+template<typename E>
+struct EBindingCodec<EArrayList<E> > {
+	static void toJson(EJsonWriter& w, EArrayList<E>& v) {
+		w.startArray();
+		int n = v.size();
+		for (int i = 0; i < n; i++) {
+			E e = v.getAt(i);
+			EBindingCodec<E>::toJson(w, e);
+		}
+		w.endArray();
+	}
+	static void fromJson(EArrayList<E>& v, EJsonValue& j) {
+		for (EJsonValue m = j.first(); !m.isUndefined(); m = m.next()) {
+			E e = E();
+			EBindingCodec<E>::fromJson(e, m);
+			v.add(e);
+		}
+	}
+	static void toBson(EBindingBsonWriter& w, const char *name, int len, EArrayList<E>& v) {
+		int n = v.size();
+		for (int i = 0; i < n; i++) {
+			E e = v.getAt(i);
+			EBindingCodec<E>::toBson(w, name, len, e);
+		}
+	}
+	template<typename R>
+	static void fromBson(EArrayList<E>& v, R& node) {
+		// one node per element
+		E e = E();
+		EBindingCodec<E>::fromBson(e, node);
+		v.add(e);
+	}
+};
+
+template<typename V>
+struct EBindingCodec<EHashMap<EString*, V*> > {
+	static void toJson(EJsonWriter& w, EHashMap<EString*, V*>& v) {
+		w.startObject();
+		sp<EIterator<EMapEntry<EString*, V*>*> > it = v.entrySet()->iterator();
+		while (it->hasNext()) {
+			EMapEntry<EString*, V*> *e = it->next();
+			EString *key = e->getKey();
+			V *value = e->getValue();
+			w.key(key->c_str(), key->length());
+			EBindingCodec<V*>::toJson(w, value);
+		}
+		w.endObject();
+	}
+	static void fromJson(EHashMap<EString*, V*>& v, EJsonValue& j) {
+		for (EJsonValue m = j.first(); !m.isUndefined(); m = m.next()) {
+			V *value = null;
+			EBindingCodec<V*>::fromJson(value, m);
+			delete v.put(new EString(m.key()), value);
+		}
+	}
+	static void toBson(EBindingBsonWriter& w, const char *name, int len, EHashMap<EString*, V*>& v) {
+		int parent = w.open(name, len);
+		sp<EIterator<EMapEntry<EString*, V*>*> > it = v.entrySet()->iterator();
+		while (it->hasNext()) {
+			EMapEntry<EString*, V*> *e = it->next();
+			EString *key = e->getKey();
+			V *value = e->getValue();
+			EBindingCodec<V*>::toBson(w, key->c_str(), key->length(), value);
+		}
+		w.close(parent);
+	}
+	template<typename R>
+	static void fromBson(EHashMap<EString*, V*>& v, R& node) {
+		for (R c = node.firstChild(); c.valid(); c = c.nextSibling()) {
+			V *value = null;
+			EBindingCodec<V*>::fromBson(value, c);
+			delete v.put(new EString(c.name()), value);
+		}
+	}
+};
+
+template<typename X>
+void EBindingViewNode::read(X& x) {
+	EBindingCodec<X>::fromBson(x, *this);
+}
+
+template<typename X>
+void EBindingTreeNode::read(X& x) {
+	EBindingCodec<X>::fromBson(x, *this);
+}
+
+template<typename X>
+void EBindingJsonFields::field(const char *name, int len, X& x) {
+	w.key(name, len);
+	EBindingCodec<X>::toJson(w, x);
+}
+
+template<typename X>
+void EBindingBsonFields::field(const char *name, int len, X& x) {
+	EBindingCodec<X>::toBson(w, name, len, x);
+}
+
+template<typename X>
+void EBindingJsonMember::read(X& x) {
+	EBindingCodec<X>::fromJson(x, value);
+}
+
+/**
+ * The entries of the bindings.
+ */
+class EStructBinding {
+public:
+	template<typename T>
+	static void toJson(EJsonWriter& w, T& o) {
+		EBindingCodec<T>::toJson(w, o);
+	}
+
+	template<typename T>
+	static EString toJson(T& o) {
+		EByteArrayOutputStream out(256, false);
+		{
+			EJsonWriter w(&out);
+			EBindingCodec<T>::toJson(w, o);
+		}
+		return EString((const char*)out.data(), out.size());
+	}
+
+	template<typename T>
+	static void fromJson(T& o, EJsonValue v) {
+		EBindingCodec<T>::fromJson(o, v);
+	}
+
+	template<typename T>
+	static void fromJson(T& o, const char *json, int len) THROWS(EDataFormatException) {
+		EJsonParser parser;
+		EJsonValue v = parser.parse(json, len);
+		EBindingCodec<T>::fromJson(o, v);
+	}
+
+	/**
+	 * Appends a bson document holding the node name for o, in the export
+	 * format of EBson (without head).
+	 */
+	template<typename T>
+	static void toBson(EByteArrayOutputStream *out, const char *name, T& o) {
+		EBindingBsonWriter w(out);
+		EBindingCodec<T>::toBson(w, name, (int)eso_strlen(name), o);
+		w.finish();
+	}
+
+	/**
+	 * Reads the node of the path, false if not found.
+	 */
+	template<typename T>
+	static boolean fromBson(T& o, EBsonView& view, const char *path) {
+		int node = view.find(path);
+		if (node < 0) {
+			return false;
+		}
+		EBindingViewNode n(&view, node);
+		EBindingCodec<T>::fromBson(o, n);
+		return true;
+	}
+
+	template<typename T>
+	static boolean fromBson(T& o, EBson& bson, const char *path) {
+		es_bson_node_t *node = bson.find(path);
+		if (!node) {
+			return false;
+		}
+		EBindingTreeNode n(node);
+		EBindingCodec<T>::fromBson(o, n);
+		return true;
+	}
+};
+
+//==============================================================================
+
+#define ES_BINDING_EXPAND(x) x
+#define ES_BINDING_CAT_(a, b) a ## b
+#define ES_BINDING_CAT(a, b) ES_BINDING_CAT_(a, b)
+#define ES_BINDING_NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+#define ES_BINDING_NARGS(...) ES_BINDING_EXPAND(ES_BINDING_NARGS_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define ES_BINDING_EACH(M, ...) \
+	ES_BINDING_EXPAND(ES_BINDING_CAT(ES_BINDING_EACH_, ES_BINDING_NARGS(__VA_ARGS__))(M, 0, __VA_ARGS__))
+#define ES_BINDING_EACH_1(M, i, f) M(i, f)
+#define ES_BINDING_EACH_2(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_1(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_3(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_2(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_4(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_3(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_5(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_4(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_6(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_5(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_7(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_6(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_8(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_7(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_9(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_8(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_10(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_9(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_11(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_10(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_12(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_11(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_13(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_12(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_14(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_13(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_15(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_14(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_16(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_15(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_17(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_16(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_18(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_17(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_19(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_18(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_20(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_19(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_21(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_20(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_22(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_21(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_23(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_22(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_24(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_23(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_25(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_24(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_26(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_25(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_27(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_26(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_28(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_27(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_29(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_28(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_30(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_29(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_31(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_30(M, i + 1, __VA_ARGS__))
+#define ES_BINDING_EACH_32(M, i, f, ...) M(i, f) ES_BINDING_EXPAND(ES_BINDING_EACH_31(M, i + 1, __VA_ARGS__))
+
+#define ES_BINDING_NAME_(i, f) ((n) == (i)) ? #f :
+#define ES_BINDING_WRITE_(i, f) v.field(#f, (int)sizeof(#f) - 1, o.f);
+#define ES_BINDING_CASE_(i, f) \
+		case P::slot(i): \
+			if (len == (int)sizeof(#f) - 1 && memcmp(key, #f, len) == 0) { \
+				r.read(o.f); \
+				return true; \
+			} \
+			return false;
+
+/**
+ * Binds the fields of a struct, at the global scope, up to 32 fields.
+ */
+#define ES_BINDING(TYPE, ...) \
+namespace efc { \
+template<> \
+struct EBinding<TYPE> { \
+	enum { FIELDS = ES_BINDING_NARGS(__VA_ARGS__) }; \
+	static constexpr const char* fieldName(int n) { \
+		return ES_BINDING_EACH(ES_BINDING_NAME_, __VA_ARGS__) ""; \
+	} \
+	template<typename V> \
+	static void write(V& v, TYPE& o) { \
+		ES_BINDING_EACH(ES_BINDING_WRITE_, __VA_ARGS__) \
+	} \
+	template<typename R> \
+	static boolean read(TYPE& o, const char *key, int len, R& r) { \
+		typedef EBindingPerfectHash<EBinding<TYPE> > P; \
+		static_assert(P::seed() != 0, "duplicate field names, or too many fields"); \
+		switch (P::slot(key, len)) { \
+		ES_BINDING_EACH(ES_BINDING_CASE_, __VA_ARGS__) \
+		default: \
+			return false; \
+		} \
+	} \
+}; \
+}
+
+} /* namespace efc */
+
+#endif //!CPP11_SUPPORT
+
+#endif /* ESTRUCTBINDING_HH_ */
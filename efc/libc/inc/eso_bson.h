@@ -132,6 +132,9 @@ typedef struct
 	/* private, don't to change it. */
 	es_buffer_t *_cache_;
 	es_bool_t _bsondone_;
+	es_bool_t _started_;
+	es_bson_node_t *_parent_;
+	es_bson_node_t *_prev_;
 } es_bson_stream_t;
 
 void eso_bson_parser_init(es_bson_stream_t *parser,
@@ -140,6 +143,22 @@ void eso_bson_parser_init(es_bson_stream_t *parser,
 
 es_status_t eso_bson_parse(es_bson_t *bson, es_bson_stream_t *parser);
 
+/**
+ * Push parsing: the bytes are fed by the caller instead of read, the
+ * parser->read function is not used.
+ * eso_bson_parser_feed() appends the next bytes of the stream,
+ * eso_bson_parse_next() parses the fed bytes and resumes the bson of the
+ * previous call if it's not done yet.
+ * @return ES_SUCCESS if one bson is done, ES_FAILURE if more bytes needed, or ES_BADARG.
+ */
+void eso_bson_parser_feed(es_bson_stream_t *parser, const void *data, es_size_t size);
+es_status_t eso_bson_parse_next(es_bson_t *bson, es_bson_stream_t *parser);
+
+/**
+ * Returns the number of fed bytes not parsed yet.
+ */
+es_size_t eso_bson_parser_cached(es_bson_stream_t *parser);
+
 void eso_bson_parser_uninit(es_bson_stream_t *parser);
 
 /**
@@ -0,0 +1,71 @@
+/**
+ * @file  eso_cpu.h
+ * @brief ES runtime cpu features detection
+ */
+
+#ifndef __ESO_CPU_H__
+#define __ESO_CPU_H__
+
+#include "es_comm.h"
+#include "es_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * x86 instruction set extensions.
+ */
+#define ES_CPU_SSE2       (1 << 0)
+#define ES_CPU_SSSE3      (1 << 1)
+#define ES_CPU_SSE41      (1 << 2)
+#define ES_CPU_SSE42      (1 << 3)
+#define ES_CPU_PCLMUL     (1 << 4)
+#define ES_CPU_AVX        (1 << 5)
+#define ES_CPU_AVX2       (1 << 6)
+#define ES_CPU_BMI2       (1 << 7)
+#define ES_CPU_SHA        (1 << 8)
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define ES_CPU_X86        1
+#else
+#define ES_CPU_X86        0
+#endif
+
+/*
+ * Compile a single function for an extension the whole file isn't built for,
+ * the caller must check eso_cpu_features() before calling it.
+ */
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)) || defined(__clang__)
+#define ES_CPU_TARGET(x)  __attribute__((target(x)))
+#define ES_CPU_DISPATCH   ES_CPU_X86
+#elif defined(_MSC_VER) && _MSC_VER >= 1700
+#define ES_CPU_TARGET(x)
+#define ES_CPU_DISPATCH   ES_CPU_X86
+#else
+#define ES_CPU_TARGET(x)
+#define ES_CPU_DISPATCH   0
+#endif
+
+/**
+ * Get the supported extensions of the running cpu (and os for avx),
+ * the result is cached after the first call.
+ * @return ES_CPU_XXX bit flags
+ */
+es_uint32_t eso_cpu_features(void);
+
+/**
+ * Turn off some extensions, e.g. to test or benchmark the portable paths.
+ */
+void eso_cpu_disable(es_uint32_t features);
+
+/**
+ * Check a feature is supported.
+ */
+#define eso_cpu_has(f)    ((eso_cpu_features() & (f)) == (f))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESO_CPU_H__ */
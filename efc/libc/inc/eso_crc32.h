@@ -1,6 +1,6 @@
 /**
  * @file  eso_crc32.h
- * @brief CRC-32 Calculation
+ * @brief CRC-32, CRC-32C and Adler-32 checksums with runtime dispatch
  */
 
 #ifndef __ESO_CRC32_H__
@@ -31,6 +31,35 @@ void eso_crc32_update(es_uint32_t *crc, es_byte_t *p, es_size_t len);
 #define eso_crc32_final(crc)                                                  \
     crc ^= 0xffffffff
 
+/*
+ * The updates pick the fastest kernel of the running cpu: pclmulqdq folding
+ * for CRC-32, the sse4.2 crc32 instruction for CRC-32C, avx2 for Adler-32,
+ * and slicing-by-16/8 tables otherwise.
+ */
+
+/**
+ * CRC-32C (Castagnoli, as iSCSI and ext4) routine
+ */
+es_uint32_t eso_crc32c_calc(es_byte_t *p, es_size_t len);
+
+/**
+ * CRC-32C advanced routine
+ */
+#define eso_crc32c_init(crc)                                                  \
+    crc = 0xffffffff
+
+void eso_crc32c_update(es_uint32_t *crc, es_byte_t *p, es_size_t len);
+
+#define eso_crc32c_final(crc)                                                 \
+    crc ^= 0xffffffff
+
+/**
+ * Adler-32 routine, the same as zlib's adler32().
+ * @param adler 1 at the beginning
+ * @return the updated checksum
+ */
+es_uint32_t eso_adler32_update(es_uint32_t adler, const es_byte_t *p, es_size_t len);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,58 @@
+/**
+ * @file  eso_dtoa.h
+ * @brief ES floating-point <--> decimal string conversion
+ */
+
+#ifndef __ESO_DTOA_H__
+#define __ESO_DTOA_H__
+
+#include "es_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * The max buffer size needed by eso_dtoa_xxx/eso_ftoa_xxx (with '\0').
+ */
+#define ES_DTOA_BUFSIZE    32
+
+/**
+ * Format the double to the shortest decimal string which
+ * parses back to exactly the same value (Ryu algorithm).
+ * The output layout is the same as javascript Number.toString(),
+ * e.g. "0.1", "123", "1.5e-7", "1e+21"; NaN and infinities
+ * are written as "NaN", "Infinity" and "-Infinity".
+ * @limit  buf size >= ES_DTOA_BUFSIZE
+ * @return the string length
+ */
+int eso_dtoa_shortest(double d, char *buf);
+int eso_ftoa_shortest(float f, char *buf);
+
+/**
+ * Same shortest digits as eso_dtoa_shortest(), but with the java
+ * Double.toString()/Float.toString() layout, e.g. "1.0", "0.001", "1.0E7".
+ * Like java, at least two significant digits are kept, the second one
+ * the nearest to the exact value: Double.MIN_VALUE is "4.9E-324", not "5.0E-324".
+ * @limit  buf size >= ES_DTOA_BUFSIZE
+ * @return the string length
+ */
+int eso_dtoa_java(double d, char *buf);
+int eso_ftoa_java(float f, char *buf);
+
+/**
+ * Parse a decimal string to the nearest double (round-half-even),
+ * the same result as strtod() but using the Clinger fast path and
+ * the Eisel-Lemire algorithm, inputs that can't be decided by them
+ * (hex, inf/nan, ambiguous rounding) fall back to strtod().
+ * @param endptr  if not null, set to the char after the last one used
+ * @return the parsed value, 0.0 if no conversion (endptr == s)
+ */
+double eso_parse_double(const char *s, char **endptr);
+float eso_parse_float(const char *s, char **endptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESO_DTOA_H__ */
@@ -141,6 +141,37 @@ void eso_hash_clear(es_hash_t *ht, void (*freeCall)(const void* value));
  */
 void eso_hash_free(es_hash_t **ht);
 
+/**
+ * Built-in es_hashfunc_t: 64-bit wyhash seeded with eso_hash_seed(),
+ * folded to 32 bits; pass it to eso_hash_make() for string keys that
+ * come from untrusted input.
+ */
+es_uint32_t eso_hashfunc_wyhash(const char *key, es_ssize_t *klen);
+
+/**
+ * 64-bit wyhash of len bytes.
+ * @param seed  0 for a fixed hash, eso_hash_seed() against hash flooding
+ */
+es_uint64_t eso_hash64(const void *key, es_size_t len, es_uint64_t seed);
+
+/**
+ * 64-bit mix of an integer key, same quality as eso_hash64().
+ */
+es_uint64_t eso_hash64_int(es_uint64_t v, es_uint64_t seed);
+
+/**
+ * Get the per-process random hash seed (never 0), generated on the
+ * first call from the os random source.
+ */
+es_uint64_t eso_hash_seed(void);
+
+/**
+ * Replace the per-process seed, e.g. to reproduce a run; must be called
+ * before any seeded table is filled.
+ * @param seed  0 to generate a new random seed on the next eso_hash_seed()
+ */
+void eso_hash_seed_set(es_uint64_t seed);
+
 #ifdef __cplusplus
 }
 #endif
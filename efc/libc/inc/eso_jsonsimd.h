@@ -0,0 +1,55 @@
+/**
+ * @file  eso_jsonsimd.h
+ * @brief ES JSON structural indexing with SSE2/AVX2 runtime dispatch
+ */
+
+#ifndef __ESO_JSONSIMD_H__
+#define __ESO_JSONSIMD_H__
+
+#include "es_comm.h"
+#include "es_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The first stage of a two-stage JSON parser: classify 64 bytes at once
+ * into bit masks and keep the positions of the structural bytes, i.e.
+ * the {}[]:, and the opening quotes outside strings, and the first byte
+ * of the other values.  The second stage only visits these positions.
+ */
+
+#define ES_JSON_BLOCK_SIZE   64
+
+typedef struct es_json_scanner_t es_json_scanner_t;
+struct es_json_scanner_t {
+	es_uint64_t in_string; /* all ones if the last block ended in a string */
+	es_uint64_t escaped;   /* 1 if the last block ended with an odd backslash run */
+	es_uint64_t scalar;    /* 1 if the last block ended in a scalar */
+	es_uint64_t error;     /* not zero if a control character was found */
+};
+
+void eso_json_scanner_init(es_json_scanner_t *scanner);
+
+/**
+ * Index the next n bytes of the text.
+ * The text may be given in pieces, all of them but the last one must be
+ * multiple of ES_JSON_BLOCK_SIZE.
+ * @param base	The offset of s in the whole text, added to the positions.
+ * @param out	The positions found, room for n entries is needed.
+ * @return the number of positions.
+ */
+es_size_t eso_json_index(es_json_scanner_t *scanner, const char *s,
+		es_size_t n, es_uint32_t base, es_uint32_t *out);
+
+/**
+ * Check the scanner met nothing but whitespace as control characters.
+ */
+#define eso_json_scanner_ok(sc)   ((sc)->error == 0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESO_JSONSIMD_H__ */
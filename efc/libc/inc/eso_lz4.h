@@ -0,0 +1,138 @@
+/**
+ * @file  eso_lz4.h
+ * @brief LZ4 block and frame codec, and xxHash32
+ */
+
+#ifndef __ESO_LZ4_H__
+#define __ESO_LZ4_H__
+
+#include "es_comm.h"
+#include "es_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The blocks and frames are those of the LZ4 format (lz4 command line,
+ * liblz4 and the other implementations read and write them): a block is a
+ * sequence of literal runs and matches within 64KB back, a frame is a
+ * magic number, a descriptor, length prefixed blocks and an optional
+ * xxHash32 of the content.
+ */
+
+#define ES_LZ4_MAX_INPUT_SIZE     0x7E000000
+#define ES_LZ4_FRAME_MAGIC        0x184D2204
+#define ES_LZ4_FRAME_HEADER_MAX   19
+
+/**
+ * The most bytes the compression of srclen bytes can produce.
+ */
+#define eso_lz4_compress_bound(srclen)                                        \
+    ((es_uint32_t)(srclen) > ES_LZ4_MAX_INPUT_SIZE ? 0 :                      \
+        (srclen) + (srclen) / 255 + 16)
+
+/**
+ * Compresses a block.
+ * @param acceleration 1 for the best ratio, larger values skip faster on
+ *        the incompressible data
+ * @return the compressed size, 0 if dst is too small
+ */
+es_int32_t eso_lz4_compress(const void *src, es_int32_t srclen,
+		void *dst, es_int32_t dstcap, es_int32_t acceleration);
+
+/**
+ * Decompresses a block, the compressed size must be exact.
+ * @return the decompressed size, -1 if the block is malformed or dst is
+ *         too small
+ */
+es_int32_t eso_lz4_decompress(const void *src, es_int32_t srclen,
+		void *dst, es_int32_t dstcap);
+
+/**
+ * Decompresses a block whose matches may reach into the dict bytes, the
+ * data which preceded it (linked blocks).  dict may be just before dst.
+ */
+es_int32_t eso_lz4_decompress_dict(const void *src, es_int32_t srclen,
+		void *dst, es_int32_t dstcap, const void *dict, es_int32_t dictlen);
+
+
+/**
+ * The frame descriptor.
+ */
+typedef struct es_lz4f_info_t {
+	es_int32_t  block_size;        /* the maximum: 64KB, 256KB, 1MB or 4MB */
+	es_bool_t   block_linked;      /* matches may reach the previous blocks */
+	es_bool_t   block_checksum;    /* each block is followed by its xxh32 */
+	es_bool_t   content_checksum;  /* the frame ends with the content xxh32 */
+	es_int64_t  content_size;      /* -1 if not given */
+	es_uint32_t dict_id;           /* 0 if none */
+} es_lz4f_info_t;
+
+/**
+ * The block size id (4..7) of the smallest frame block size >= size.
+ */
+es_int32_t eso_lz4f_block_id(es_int32_t size);
+
+/**
+ * Writes the magic and the descriptor.
+ * @param dst at least ES_LZ4_FRAME_HEADER_MAX bytes
+ * @return the header size
+ */
+es_int32_t eso_lz4f_write_header(void *dst, const es_lz4f_info_t *info);
+
+/**
+ * Reads the magic and the descriptor.
+ * @return the header size, 0 if more than len bytes are needed, or -1 if
+ *         the header is invalid.  For a skippable frame block_size is 0 and
+ *         content_size is the number of bytes to skip after the header.
+ */
+es_int32_t eso_lz4f_read_header(const void *src, es_int32_t len, es_lz4f_info_t *info);
+
+/**
+ * The most bytes the compression of srclen bytes to a frame can produce.
+ */
+es_int64_t eso_lz4f_compress_bound(es_int64_t srclen);
+
+/**
+ * Compresses to a frame of independent 64KB blocks with the content size
+ * and checksum.
+ * @return the frame size, 0 if dst is too small
+ */
+es_int64_t eso_lz4f_compress(const void *src, es_int64_t srclen,
+		void *dst, es_int64_t dstcap);
+
+/**
+ * Decompresses the frames of src, the skippable frames are skipped.
+ * @return the decompressed size, -1 if a frame is malformed, truncated,
+ *         fails its checksums or doesn't fit in dst
+ */
+es_int64_t eso_lz4f_decompress(const void *src, es_int64_t srclen,
+		void *dst, es_int64_t dstcap);
+
+
+/**
+ * xxHash32 routine
+ */
+es_uint32_t eso_xxh32(const void *p, es_size_t len, es_uint32_t seed);
+
+/**
+ * xxHash32 advanced routine
+ */
+typedef struct es_xxh32_t {
+	es_uint64_t total;
+	es_uint32_t v[4];
+	es_uint32_t seed;
+	es_uint32_t memsize;
+	es_uint8_t  mem[16];
+} es_xxh32_t;
+
+void eso_xxh32_init(es_xxh32_t *state, es_uint32_t seed);
+void eso_xxh32_update(es_xxh32_t *state, const void *p, es_size_t len);
+es_uint32_t eso_xxh32_digest(const es_xxh32_t *state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESO_LZ4_H__ */
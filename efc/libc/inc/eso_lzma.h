@@ -36,6 +36,28 @@ extern "C" {
 
 //==============================================================================
 
+#define ES_LZMA_PROPS_SIZE 5
+
+//LZMA block properties of the level (0..9), the dictionary is shrunk to
+//reduceSize, the block length (0 for no limit).
+es_int32_t eso_lzma_props(es_uint8_t props[ES_LZMA_PROPS_SIZE],
+                          es_int32_t level,
+                          es_uint32_t reduceSize);
+
+//LZMA block compression without header or end mark, dstLen is the capacity
+//on input and the compressed length on output, ES_SZ_ERROR_OUTPUT_EOF if
+//it doesn't fit.
+es_int32_t eso_lzma_compress(void *dst, es_size_t *dstLen,
+                             const void *src, es_size_t srcLen,
+                             es_int32_t level,
+                             es_uint32_t reduceSize);
+
+//LZMA block decompression, dstLen is the exact uncompressed length and
+//srcLen the compressed length, the both are updated to the lengths used.
+es_int32_t eso_lzma_decompress(void *dst, es_size_t *dstLen,
+                               const void *src, es_size_t *srcLen,
+                               const es_uint8_t props[ES_LZMA_PROPS_SIZE]);
+
 //LZMA ziped
 es_int32_t eso_lzma_zip(es_ostream_t *outStream,
                         es_istream_t *inStream,
@@ -55,6 +55,11 @@ char* eso_sha256_end(es_sha256_ctx_t *, char [SHA256_DIGEST_STRING_LENGTH]);
 char* eso_sha256_data(const es_byte_t *, es_size_t,
                   char [SHA256_DIGEST_STRING_LENGTH]);
 
+/* Hash n independent messages at once, for many small ones: one after
+ * another with the sha extensions, else 8 at a time in the avx2 lanes. */
+void eso_sha256_mb(const es_byte_t *data[], const es_size_t len[],
+                   es_byte_t digest[][SHA256_DIGEST_LENGTH], int n);
+
 void eso_sha384_init(es_sha384_ctx_t *);
 void eso_sha384_update(es_sha384_ctx_t *, const es_byte_t *, es_size_t);
 void eso_sha384_final(es_byte_t [SHA384_DIGEST_LENGTH], es_sha384_ctx_t *);
@@ -0,0 +1,81 @@
+/**
+ * @file  eso_strsimd.h
+ * @brief ES byte string kernels with SSE2/SSE4.2/AVX2 runtime dispatch
+ */
+
+#ifndef __ESO_STRSIMD_H__
+#define __ESO_STRSIMD_H__
+
+#include "es_comm.h"
+#include "es_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * All functions work on (ptr, len) byte ranges, '\0' is an ordinary byte,
+ * the ignore case and case mapping functions are ASCII only (same as
+ * eso_tolower()/eso_toupper()).
+ */
+
+/**
+ * Find the first occurrence of pattern p in s.
+ * @return the offset in s, 0 if m == 0, -1 if not found.
+ */
+es_ssize_t eso_strsimd_find(const char *s, es_size_t n, const char *p, es_size_t m);
+
+/**
+ * Find the last occurrence of pattern p in s.
+ * @return the offset in s, n if m == 0, -1 if not found.
+ */
+es_ssize_t eso_strsimd_rfind(const char *s, es_size_t n, const char *p, es_size_t m);
+
+/**
+ * Find the first/last byte c in s.
+ * @return the offset in s, -1 if not found.
+ */
+es_ssize_t eso_strsimd_findchr(const char *s, es_size_t n, int c);
+es_ssize_t eso_strsimd_rfindchr(const char *s, es_size_t n, int c);
+
+/**
+ * Find the first byte of s which is (in_set=TRUE) or is not (in_set=FALSE)
+ * one of the setlen bytes of set.
+ * @return the offset in s, -1 if not found.
+ */
+es_ssize_t eso_strsimd_findset(const char *s, es_size_t n,
+		const char *set, es_size_t setlen, es_bool_t in_set);
+
+/**
+ * Ignore case compare n bytes.
+ * @return 0 if equals, else the difference of the first mismatch lower case bytes.
+ */
+int eso_strsimd_compare_icase(const char *a, const char *b, es_size_t n);
+
+/**
+ * Ignore case equals n bytes.
+ */
+es_bool_t eso_strsimd_equals_icase(const char *a, const char *b, es_size_t n);
+
+/**
+ * In place ASCII case mapping of n bytes.
+ */
+void eso_strsimd_tolower(char *s, es_size_t n);
+void eso_strsimd_toupper(char *s, es_size_t n);
+
+/**
+ * Check s is well-formed UTF-8 (no overlong form, no surrogate, <= U+10FFFF).
+ */
+es_bool_t eso_strsimd_utf8_valid(const char *s, es_size_t n);
+
+/**
+ * Continue the java String.hashCode() loop "h = 31 * h + c" from h over
+ * the (signed char) bytes of s.
+ */
+es_int32_t eso_strsimd_hash31(es_int32_t h, const char *s, es_size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESO_STRSIMD_H__ */
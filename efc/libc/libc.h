@@ -21,10 +21,12 @@ extern "C" {
 #include "./inc/eso_buffer.h"
 #include "./inc/eso_canonicalize.h"
 #include "./inc/eso_conf.h"
+#include "./inc/eso_cpu.h"
 #include "./inc/eso_crc32.h"
 #include "./inc/eso_datetime.h"
 #include "./inc/eso_dso.h"
 #include "./inc/eso_debug.h"
+#include "./inc/eso_dtoa.h"
 #include "./inc/eso_encode.h"
 #include "./inc/eso_file.h"
 #include "./inc/eso_flip_buffer.h"
@@ -32,8 +34,10 @@ extern "C" {
 #include "./inc/eso_hash.h"
 #include "./inc/eso_ini.h"
 #include "./inc/eso_json.h"
+#include "./inc/eso_jsonsimd.h"
 #include "./inc/eso_libc.h"
 #include "./inc/eso_locale_str.h"
+#include "./inc/eso_lz4.h"
 #include "./inc/eso_lz77.h"
 #include "./inc/eso_lzma.h"
 #include "./inc/eso_map.h"
@@ -60,6 +64,7 @@ extern "C" {
 #include "./inc/eso_sigsegv.h"
 #include "./inc/eso_stack.h"
 #include "./inc/eso_string.h"
+#include "./inc/eso_strsimd.h"
 #include "./inc/eso_sys.h"
 #include "./inc/eso_thread.h"
 #include "./inc/eso_thread_cond.h"
@@ -213,27 +213,28 @@ static es_bson_node_t* find_prev_sib_node(es_bson_node_t *prev_node)
 }
 
 
-static es_bool_t bson_array_to_varint(es_uint8_t** pcurr, es_uint8_t* pend, es_uint32_t* value)
+static es_bool_t bson_array_to_varint(char** pcurr, char* pend, es_uint32_t* value)
 {
-	es_uint8_t* ptr = *pcurr;
+	es_uint8_t* ptr = (es_uint8_t*)*pcurr;
+	es_uint8_t* end = (es_uint8_t*)pend;
 	es_uint32_t b;
 	es_uint32_t result;
 	int i;
 	
-	if (pend > ptr) {
+	if (end > ptr) {
 		b = *(ptr++); result  = (b & 0x7F)      ; if (!(b & 0x80)) goto done;
-		if (pend > ptr) {
+		if (end > ptr) {
 			b = *(ptr++); result |= (b & 0x7F) <<  7; if (!(b & 0x80)) goto done;
-			if (pend > ptr) {
+			if (end > ptr) {
 				b = *(ptr++); result |= (b & 0x7F) << 14; if (!(b & 0x80)) goto done;
-				if (pend > ptr) {
+				if (end > ptr) {
 					b = *(ptr++); result |= (b & 0x7F) << 21; if (!(b & 0x80)) goto done;
-					if (pend > ptr) {
+					if (end > ptr) {
 						b = *(ptr++); result |=  b         << 28; if (!(b & 0x80)) goto done;
 
 						// If the input is larger than 32 bits, we still need to read it all
 						// and discard the high-order bits.
-						for (i = 0; ((i < MAX_VARINT64_BYTES - MAX_VARINT32_BYTES) && (pend > ptr)); i++) {
+						for (i = 0; ((i < MAX_VARINT64_BYTES - MAX_VARINT32_BYTES) && (end > ptr)); i++) {
 							b = *(ptr++); if (!(b & 0x80)) goto done;
 						}
 					}
@@ -246,7 +247,7 @@ static es_bool_t bson_array_to_varint(es_uint8_t** pcurr, es_uint8_t* pend, es_u
 	
 done:
 	*value = result;
-	*pcurr = ptr;
+	*pcurr = (char*)ptr;
 	return TRUE;
 }
 
@@ -272,8 +273,7 @@ static const char* bson_node_import(es_bson_t *bson,
 	es_bson_node_t *new_node;
 	es_bool_t ret = FALSE;
 
-	if (bson_size == 0) {
-		if (parser) parser->_bsondone_ = TRUE;
+	if (bson_size == 0) { //more data maybe.
 		ES_NODE_IMP_RET;
 	}
 
@@ -310,7 +310,7 @@ static const char* bson_node_import(es_bson_t *bson,
 	new_node->_last_ = (node_flag & NODE_TYPE_IS_LAST) ? 1 : 0;
 
 	if (new_node->isattr) {
-		ret = bson_array_to_varint((es_uint8_t**)&pcurr, (es_uint8_t*)pend, &size_text);
+		ret = bson_array_to_varint(&pcurr, pend, &size_text);
 		text_val = pcurr;
 		pcurr += size_text;
 		if (!ret || pend - pcurr < 1) {
@@ -321,7 +321,7 @@ static const char* bson_node_import(es_bson_t *bson,
 		eso_buffer_append(new_node->value, text_val, size_text);
 
 		if (new_node->_last_) {
-			ret = bson_array_to_varint((es_uint8_t**)&pcurr, (es_uint8_t*)pend, &size_text);
+			ret = bson_array_to_varint(&pcurr, pend, &size_text);
 			text_val = pcurr;
 			pcurr += size_text;
 			if (!ret || pend - pcurr < 0) {
@@ -357,14 +357,31 @@ static const char* bson_node_import(es_bson_t *bson,
 	else {
 		es_bool_t has_attr = node_flag & NODE_TYPE_HAS_ATTR;
 		if (has_attr) {
-			prev_node->next = new_node;
-			new_node->prev = prev_node;
-			new_node->parent = prev_node->parent;
+			//link it as the value-less nodes below, the value follows the attributes.
+			if (!prev_node) {
+				parent_node->child0 = new_node;
+				new_node->parent = parent_node;
+			}
+			else if (node_flag & NODE_TYPE_IS_SUB) {
+				prev_node->child0 = new_node;
+				new_node->parent = prev_node;
+			}
+			else {
+				es_bson_node_t *sib_node = find_prev_sib_node(prev_node);
+				if (!sib_node) {
+					bson_node_free(&new_node);
+					if (parser) parser->_bsondone_ = TRUE;
+					return bson_data;
+				}
+				new_node->prev = sib_node;
+				sib_node->next = new_node;
+				new_node->parent = sib_node->parent;
+			}
 			
 			return bson_node_import(bson, new_node, NULL, pcurr, pend-pcurr, last_parent_node, last_prev_node, parser);
 		}
 		else {
-			ret = bson_array_to_varint((es_uint8_t**)&pcurr, (es_uint8_t*)pend, &size_text);
+			ret = bson_array_to_varint(&pcurr, pend, &size_text);
 			text_val = pcurr;
 			pcurr += size_text;
 			if (!ret || pend - pcurr < 0) {
@@ -971,6 +988,10 @@ void eso_bson_parser_init(es_bson_stream_t *parser,
 	parser->finished = FALSE;
 	parser->parsed = parsed;
 	parser->_cache_ = eso_buffer_make(0, 0);
+	parser->_bsondone_ = FALSE;
+	parser->_started_ = FALSE;
+	parser->_parent_ = NULL;
+	parser->_prev_ = NULL;
 }
 
 void eso_bson_parser_uninit(es_bson_stream_t *parser) {
@@ -1065,6 +1086,75 @@ PARSE:
 	return ES_FAILURE;
 }
 
+void eso_bson_parser_feed(es_bson_stream_t *parser, const void *data, es_size_t size)
+{
+	if (parser && data && size > 0) {
+		eso_buffer_append(parser->_cache_, data, size);
+	}
+}
+
+es_size_t eso_bson_parser_cached(es_bson_stream_t *parser)
+{
+	return parser ? parser->_cache_->len : 0;
+}
+
+es_status_t eso_bson_parse_next(es_bson_t *bson, es_bson_stream_t *parser)
+{
+	char *value_data;
+	es_size_t value_size;
+	es_size_t done_size;
+	const char* pcurr;
+
+	if (!bson || !parser) {
+		return ES_BADARG;
+	}
+
+	value_data = parser->_cache_->data;
+	value_size = parser->_cache_->len;
+
+	if (!parser->_started_) {
+		if (value_size < 2) {
+			return ES_FAILURE;
+		}
+		if (eso_memcmp(value_data, "<?", 2) == 0) {
+			es_size_t head_len;
+			char *p;
+
+			p = eso_strnstr(value_data, value_size, "?>");
+			if (!p || value_data + value_size < p+3) {
+				return ES_FAILURE;
+			}
+
+			head_len = bson_reset_head(bson, value_data);
+			eso_buffer_delete(parser->_cache_, 0, head_len);
+			bson->length += head_len;
+			if (parser->parsed) parser->parsed(parser, bson, NULL);
+
+			value_data = parser->_cache_->data;
+			value_size = parser->_cache_->len;
+		}
+		parser->_parent_ = bson->root;
+		parser->_prev_ = NULL;
+		parser->_started_ = TRUE;
+	}
+
+	if (value_size == 0) {
+		return ES_FAILURE;
+	}
+
+	//resume at the last incomplete node.
+	parser->_bsondone_ = FALSE;
+	pcurr = bson_node_import(bson, parser->_parent_, parser->_prev_, value_data, value_size, &parser->_parent_, &parser->_prev_, parser);
+	done_size = pcurr - value_data;
+	eso_buffer_delete(parser->_cache_, 0, done_size);
+	bson->length += done_size;
+	if (parser->_bsondone_) {
+		parser->_started_ = FALSE;
+		return ES_SUCCESS;
+	}
+	return ES_FAILURE;
+}
+
 es_status_t eso_bson_clone(es_bson_t *bson_dst,
                                       const char *path_dst,
                                       es_bson_t *bson_src,
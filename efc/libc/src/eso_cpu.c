@@ -0,0 +1,97 @@
+/**
+ * @file  eso_cpu.c
+ * @brief ES runtime cpu features detection
+ */
+
+#include "eso_cpu.h"
+
+#if ES_CPU_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#define CPU_FEATURES_UNKNOWN  0x80000000
+
+static volatile es_uint32_t cpu_features = CPU_FEATURES_UNKNOWN;
+static volatile es_uint32_t cpu_disabled = 0;
+
+#if ES_CPU_X86
+static void cpuid(es_uint32_t leaf, es_uint32_t subleaf, es_uint32_t r[4])
+{
+#ifdef _MSC_VER
+	int regs[4];
+	__cpuidex(regs, (int)leaf, (int)subleaf);
+	r[0] = regs[0]; r[1] = regs[1]; r[2] = regs[2]; r[3] = regs[3];
+#else
+	__cpuid_count(leaf, subleaf, r[0], r[1], r[2], r[3]);
+#endif
+}
+
+static es_uint64_t xgetbv0(void)
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	es_uint32_t eax, edx;
+	__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((es_uint64_t)edx << 32) | eax;
+#endif
+}
+
+static es_uint32_t detect(void)
+{
+	es_uint32_t r[4];
+	es_uint32_t f = 0;
+	es_uint32_t max_leaf;
+
+	cpuid(0, 0, r);
+	max_leaf = r[0];
+	if (max_leaf < 1) {
+		return 0;
+	}
+
+	cpuid(1, 0, r);
+	if (r[3] & (1u << 26)) f |= ES_CPU_SSE2;
+	if (r[2] & (1u << 9))  f |= ES_CPU_SSSE3;
+	if (r[2] & (1u << 19)) f |= ES_CPU_SSE41;
+	if (r[2] & (1u << 20)) f |= ES_CPU_SSE42;
+	if (r[2] & (1u << 1))  f |= ES_CPU_PCLMUL;
+
+	// avx needs the os to save the ymm registers
+	if ((r[2] & (1u << 27)) && (r[2] & (1u << 28)) && (xgetbv0() & 6) == 6) {
+		f |= ES_CPU_AVX;
+	}
+
+	if (max_leaf >= 7) {
+		cpuid(7, 0, r);
+		if ((f & ES_CPU_AVX) && (r[1] & (1u << 5))) f |= ES_CPU_AVX2;
+		if (r[1] & (1u << 8))  f |= ES_CPU_BMI2;
+		if (r[1] & (1u << 29)) f |= ES_CPU_SHA;
+	}
+	return f;
+}
+#else
+static es_uint32_t detect(void)
+{
+	return 0;
+}
+#endif
+
+es_uint32_t eso_cpu_features(void)
+{
+	es_uint32_t f = cpu_features;
+	if (f == CPU_FEATURES_UNKNOWN) {
+		// racing threads compute the same value
+		f = detect();
+		cpu_features = f;
+	}
+	return f & ~cpu_disabled;
+}
+
+void eso_cpu_disable(es_uint32_t features)
+{
+	cpu_disabled = features;
+}
@@ -1,9 +1,22 @@
 /**
  * @file  eso_crc32.c
- * @brief CRC-32 Calculation
+ * @brief CRC-32, CRC-32C and Adler-32 checksums with runtime dispatch
  */
 
 #include "eso_crc32.h"
+#include "eso_cpu.h"
+#include "eso_atomic.h"
+#include <string.h>
+
+#if ES_CPU_DISPATCH
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <emmintrin.h>
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+#include <immintrin.h>
+#endif
 
 /*
  * The code and lookup tables are based on the algorithm
@@ -86,29 +99,462 @@ static es_uint32_t const crc32_table256[] = {
 };
 
 //==============================================================================
+// slicing tables
 
-es_uint32_t eso_crc32_calc(es_byte_t *p, es_size_t len)
+/*
+ * slice[k][n] is the crc of the byte n followed by k zero bytes, so that 16
+ * (or 8) input bytes are folded with 16 independent lookups per step.  The
+ * tables of both polynomials are filled at the first call.
+ */
+
+#define CRC32C_POLY      0x82f63b78
+
+/* the lengths of the crc32c hardware lanes, see crc32c_sse42() */
+#define CRC32C_LONG      8192
+#define CRC32C_SHORT     256
+
+static es_uint32_t crc32_slice[16][256];
+static es_uint32_t crc32c_slice[16][256];
+static es_uint32_t crc32c_long[4][256];
+static es_uint32_t crc32c_short[4][256];
+static volatile int tables_ready = 0;
+
+static void fill_slices(es_uint32_t t[16][256])
+{
+	int k, n;
+
+	for (k = 1; k < 16; k++) {
+		for (n = 0; n < 256; n++) {
+			es_uint32_t c = t[k - 1][n];
+			t[k][n] = (c >> 8) ^ t[0][c & 0xff];
+		}
+	}
+}
+
+/*
+ * The crc of len zero bytes is linear in the starting crc: it's a 32x32
+ * matrix over GF(2), built by repeated squaring (as zlib's crc32_combine()).
+ */
+
+static es_uint32_t gf2_times(const es_uint32_t *mat, es_uint32_t vec)
+{
+	es_uint32_t sum = 0;
+
+	while (vec) {
+		if (vec & 1) {
+			sum ^= *mat;
+		}
+		vec >>= 1;
+		mat++;
+	}
+	return sum;
+}
+
+static void gf2_square(es_uint32_t *square, const es_uint32_t *mat)
+{
+	int n;
+
+	for (n = 0; n < 32; n++) {
+		square[n] = gf2_times(mat, mat[n]);
+	}
+}
+
+static void fill_zeros(es_uint32_t zeros[4][256], es_uint32_t poly, es_size_t len)
+{
+	es_uint32_t even[32], odd[32], *op;
+	es_uint32_t row = 1;
+	int n;
+
+	// the operator of one zero bit
+	odd[0] = poly;
+	for (n = 1; n < 32; n++) {
+		odd[n] = row;
+		row <<= 1;
+	}
+	gf2_square(even, odd);  // 2 bits
+	gf2_square(odd, even);  // 4 bits
+	op = odd;
+	// len is a power of 2
+	while (len) {
+		gf2_square(even, odd);
+		op = even;
+		len >>= 1;
+		if (len == 0) {
+			break;
+		}
+		gf2_square(odd, even);
+		op = odd;
+		len >>= 1;
+	}
+
+	for (n = 0; n < 256; n++) {
+		zeros[0][n] = gf2_times(op, n);
+		zeros[1][n] = gf2_times(op, n << 8);
+		zeros[2][n] = gf2_times(op, n << 16);
+		zeros[3][n] = gf2_times(op, (es_uint32_t)n << 24);
+	}
+}
+
+static void make_tables(void)
+{
+	int n, k;
+
+	if (tables_ready) {
+		return;
+	}
+
+	// racing threads write the same values
+	memcpy(crc32_slice[0], crc32_table256, sizeof(crc32_table256));
+	for (n = 0; n < 256; n++) {
+		es_uint32_t c = n;
+		for (k = 0; k < 8; k++) {
+			c = (c & 1) ? (c >> 1) ^ CRC32C_POLY : c >> 1;
+		}
+		crc32c_slice[0][n] = c;
+	}
+	fill_slices(crc32_slice);
+	fill_slices(crc32c_slice);
+	fill_zeros(crc32c_long, CRC32C_POLY, CRC32C_LONG);
+	fill_zeros(crc32c_short, CRC32C_POLY, CRC32C_SHORT);
+
+	eso_atomic_synchronize();
+	tables_ready = 1;
+}
+
+#define LOAD32LE(p) \
+	((es_uint32_t)(p)[0] | ((es_uint32_t)(p)[1] << 8) | \
+	((es_uint32_t)(p)[2] << 16) | ((es_uint32_t)(p)[3] << 24))
+
+static es_uint32_t crc_slicing(es_uint32_t t[16][256], es_uint32_t c,
+		const es_uint8_t *p, es_size_t len)
+{
+	// slicing-by-16
+	while (len >= 16) {
+		es_uint32_t a = c ^ LOAD32LE(p);
+		c = t[15][a & 0xff] ^ t[14][(a >> 8) & 0xff]
+				^ t[13][(a >> 16) & 0xff] ^ t[12][a >> 24]
+				^ t[11][p[4]] ^ t[10][p[5]] ^ t[9][p[6]] ^ t[8][p[7]]
+				^ t[7][p[8]] ^ t[6][p[9]] ^ t[5][p[10]] ^ t[4][p[11]]
+				^ t[3][p[12]] ^ t[2][p[13]] ^ t[1][p[14]] ^ t[0][p[15]];
+		p += 16;
+		len -= 16;
+	}
+
+	// slicing-by-8
+	if (len >= 8) {
+		es_uint32_t a = c ^ LOAD32LE(p);
+		c = t[7][a & 0xff] ^ t[6][(a >> 8) & 0xff]
+				^ t[5][(a >> 16) & 0xff] ^ t[4][a >> 24]
+				^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+		p += 8;
+		len -= 8;
+	}
+
+	while (len--) {
+		c = t[0][(c ^ *p++) & 0xff] ^ (c >> 8);
+	}
+	return c;
+}
+
+//==============================================================================
+// x86 kernels
+
+#if ES_CPU_DISPATCH
+
+/*
+ * CRC-32 by carry-less multiplication, after Intel's "Fast CRC Computation
+ * for Generic Polynomials Using PCLMULQDQ Instruction": four 128 bits
+ * accumulators are folded forward over 64 bytes per step, then into one,
+ * then reduced to 32 bits with a Barrett reduction.  len >= 64 and is a
+ * multiple of 16.
+ */
+
+#define FOLD(x, k, d) \
+	_mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), \
+			_mm_clmulepi64_si128(x, k, 0x11)), d)
+
+ES_CPU_TARGET("pclmul")
+static es_uint32_t crc32_pclmul(es_uint32_t crc, const es_uint8_t *p, es_size_t len)
+{
+	const __m128i k1k2 = _mm_set_epi64x(LLONG(0x1c6e41596), LLONG(0x154442bd4));
+	const __m128i k3k4 = _mm_set_epi64x(LLONG(0x0ccaa009e), LLONG(0x1751997d0));
+	const __m128i k5 = _mm_set_epi64x(0, LLONG(0x163cd6124));
+	const __m128i poly = _mm_set_epi64x(LLONG(0x1f7011641), LLONG(0x1db710641));
+	const __m128i mask32 = _mm_set_epi32(0, 0, 0, -1);
+	__m128i x0, x1, x2, x3;
+
+	x0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), _mm_cvtsi32_si128((int)crc));
+	x1 = _mm_loadu_si128((const __m128i *)(p + 16));
+	x2 = _mm_loadu_si128((const __m128i *)(p + 32));
+	x3 = _mm_loadu_si128((const __m128i *)(p + 48));
+	p += 64;
+	len -= 64;
+
+	while (len >= 64) {
+		x0 = FOLD(x0, k1k2, _mm_loadu_si128((const __m128i *)p));
+		x1 = FOLD(x1, k1k2, _mm_loadu_si128((const __m128i *)(p + 16)));
+		x2 = FOLD(x2, k1k2, _mm_loadu_si128((const __m128i *)(p + 32)));
+		x3 = FOLD(x3, k1k2, _mm_loadu_si128((const __m128i *)(p + 48)));
+		p += 64;
+		len -= 64;
+	}
+
+	x0 = FOLD(x0, k3k4, x1);
+	x0 = FOLD(x0, k3k4, x2);
+	x0 = FOLD(x0, k3k4, x3);
+	while (len >= 16) {
+		x0 = FOLD(x0, k3k4, _mm_loadu_si128((const __m128i *)p));
+		p += 16;
+		len -= 16;
+	}
+
+	// 128 to 64 bits
+	x1 = _mm_clmulepi64_si128(x0, k3k4, 0x10);
+	x0 = _mm_xor_si128(_mm_srli_si128(x0, 8), x1);
+
+	// 64 to 32 bits
+	x1 = _mm_srli_si128(x0, 4);
+	x0 = _mm_clmulepi64_si128(_mm_and_si128(x0, mask32), k5, 0x00);
+	x0 = _mm_xor_si128(x0, x1);
+
+	// Barrett reduction
+	x1 = _mm_clmulepi64_si128(_mm_and_si128(x0, mask32), poly, 0x10);
+	x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), poly, 0x00);
+	x0 = _mm_xor_si128(x0, x1);
+	return (es_uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(x0, 4));
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CRC32C_WORD      8
+#define CRC32C_STEP(c, p) (es_uint32_t)_mm_crc32_u64(c, *(const es_uint64_t *)(p))
+#else
+#define CRC32C_WORD      4
+#define CRC32C_STEP(c, p) _mm_crc32_u32(c, *(const es_uint32_t *)(p))
+#endif
+
+static ES_INLINE es_uint32_t crc32c_shift(es_uint32_t zeros[4][256], es_uint32_t crc)
+{
+	return zeros[0][crc & 0xff] ^ zeros[1][(crc >> 8) & 0xff]
+			^ zeros[2][(crc >> 16) & 0xff] ^ zeros[3][crc >> 24];
+}
+
+/*
+ * CRC-32C with the SSE4.2 crc32 instruction.  Its latency is 3 cycles and
+ * its throughput 1, so three independent lanes are run at once and their
+ * crcs combined with the zero bytes tables (as Mark Adler's crc32c.c).
+ */
+
+ES_CPU_TARGET("sse4.2")
+static es_uint32_t crc32c_sse42(es_uint32_t crc0, const es_uint8_t *p, es_size_t len)
 {
-    es_uint32_t  crc;
+	es_uint32_t crc1, crc2;
+	const es_uint8_t *end;
+
+	while (len && ((es_size_t)p & (CRC32C_WORD - 1))) {
+		crc0 = _mm_crc32_u8(crc0, *p++);
+		len--;
+	}
 
-    crc = 0xffffffff;
+	while (len >= CRC32C_LONG * 3) {
+		crc1 = crc2 = 0;
+		end = p + CRC32C_LONG;
+		do {
+			crc0 = CRC32C_STEP(crc0, p);
+			crc1 = CRC32C_STEP(crc1, p + CRC32C_LONG);
+			crc2 = CRC32C_STEP(crc2, p + CRC32C_LONG * 2);
+			p += CRC32C_WORD;
+		} while (p < end);
+		crc0 = crc32c_shift(crc32c_long, crc0) ^ crc1;
+		crc0 = crc32c_shift(crc32c_long, crc0) ^ crc2;
+		p += CRC32C_LONG * 2;
+		len -= CRC32C_LONG * 3;
+	}
 
-    while (len--) {
-        crc = crc32_table256[(crc ^ *p++) & 0xff] ^ (crc >> 8);
-    }
+	while (len >= CRC32C_SHORT * 3) {
+		crc1 = crc2 = 0;
+		end = p + CRC32C_SHORT;
+		do {
+			crc0 = CRC32C_STEP(crc0, p);
+			crc1 = CRC32C_STEP(crc1, p + CRC32C_SHORT);
+			crc2 = CRC32C_STEP(crc2, p + CRC32C_SHORT * 2);
+			p += CRC32C_WORD;
+		} while (p < end);
+		crc0 = crc32c_shift(crc32c_short, crc0) ^ crc1;
+		crc0 = crc32c_shift(crc32c_short, crc0) ^ crc2;
+		p += CRC32C_SHORT * 2;
+		len -= CRC32C_SHORT * 3;
+	}
 
-    return crc ^ 0xffffffff;
+	while (len >= CRC32C_WORD) {
+		crc0 = CRC32C_STEP(crc0, p);
+		p += CRC32C_WORD;
+		len -= CRC32C_WORD;
+	}
+	while (len--) {
+		crc0 = _mm_crc32_u8(crc0, *p++);
+	}
+	return crc0;
+}
+
+#endif //!ES_CPU_DISPATCH
+
+//==============================================================================
+
+es_uint32_t eso_crc32_calc(es_byte_t *p, es_size_t len)
+{
+	es_uint32_t  crc;
+
+	eso_crc32_init(crc);
+	eso_crc32_update(&crc, p, len);
+	return eso_crc32_final(crc);
 }
 
 void eso_crc32_update(es_uint32_t *crc, es_byte_t *p, es_size_t len)
 {
-    es_uint32_t  c;
+	es_uint32_t  c;
+
+	c = *crc;
+
+	if (len < 16) {
+		while (len--) {
+			c = crc32_table256[(c ^ *p++) & 0xff] ^ (c >> 8);
+		}
+		*crc = c;
+		return;
+	}
 
-    c = *crc;
+#if ES_CPU_DISPATCH
+	if (len >= 64 && eso_cpu_has(ES_CPU_PCLMUL)) {
+		es_size_t n = len & ~(es_size_t)15;
+		c = crc32_pclmul(c, (const es_uint8_t *)p, n);
+		p += n;
+		len -= n;
+	}
+#endif
+
+	make_tables();
+	*crc = crc_slicing(crc32_slice, c, (const es_uint8_t *)p, len);
+}
+
+es_uint32_t eso_crc32c_calc(es_byte_t *p, es_size_t len)
+{
+	es_uint32_t  crc;
+
+	eso_crc32c_init(crc);
+	eso_crc32c_update(&crc, p, len);
+	return eso_crc32c_final(crc);
+}
 
-    while (len--) {
-        c = crc32_table256[(c ^ *p++) & 0xff] ^ (c >> 8);
-    }
+void eso_crc32c_update(es_uint32_t *crc, es_byte_t *p, es_size_t len)
+{
+	make_tables();
+
+#if ES_CPU_DISPATCH
+	if (eso_cpu_has(ES_CPU_SSE42)) {
+		*crc = crc32c_sse42(*crc, (const es_uint8_t *)p, len);
+		return;
+	}
+#endif
+
+	*crc = crc_slicing(crc32c_slice, *crc, (const es_uint8_t *)p, len);
+}
+
+//==============================================================================
+// Adler-32
+
+#define ADLER_BASE       65521  // largest prime smaller than 65536
+#define ADLER_NMAX       5552   // largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1
+
+#define DO1(i)  {s1 += p[i]; s2 += s1;}
+#define DO4(i)  DO1(i); DO1(i + 1); DO1(i + 2); DO1(i + 3);
+#define DO16    DO4(0); DO4(4); DO4(8); DO4(12);
+
+static es_uint32_t adler32_scalar(es_uint32_t s1, es_uint32_t s2,
+		const es_uint8_t *p, es_size_t len)
+{
+	while (len > 0) {
+		es_size_t n = ES_MIN(len, ADLER_NMAX);
+		len -= n;
+		while (n >= 16) {
+			DO16;
+			p += 16;
+			n -= 16;
+		}
+		while (n--) {
+			s1 += *p++;
+			s2 += s1;
+		}
+		s1 %= ADLER_BASE;
+		s2 %= ADLER_BASE;
+	}
+	return (s2 << 16) | s1;
+}
+
+#if ES_CPU_DISPATCH
+
+/*
+ * 32 bytes per step: s1 gets the byte sums (vpsadbw), s2 the bytes weighted
+ * by their distance to the end of the block (vpmaddubsw with 32..1) plus 32
+ * times the s1 of the previous blocks, which are summed apart in ps.
+ */
+
+ES_CPU_TARGET("avx2")
+static es_uint32_t adler32_avx2(es_uint32_t s1, es_uint32_t s2,
+		const es_uint8_t *p, es_size_t len)
+{
+	const __m256i taps = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+			24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9,
+			8, 7, 6, 5, 4, 3, 2, 1);
+	const __m256i ones = _mm256_set1_epi16(1);
+	const __m256i zero = _mm256_setzero_si256();
+	es_size_t blocks = len / 32;
+
+	len -= blocks * 32;
+	while (blocks > 0) {
+		es_size_t n = ES_MIN(blocks, ADLER_NMAX / 32);
+		__m256i vs1 = _mm256_setzero_si256();
+		__m256i vs2 = _mm256_setzero_si256();
+		__m256i vps = _mm256_setzero_si256();
+		__m128i h;
+
+		blocks -= n;
+		s2 += s1 * 32 * (es_uint32_t)n;
+		do {
+			__m256i d = _mm256_loadu_si256((const __m256i *)p);
+			vps = _mm256_add_epi32(vps, vs1);
+			vs1 = _mm256_add_epi32(vs1, _mm256_sad_epu8(d, zero));
+			vs2 = _mm256_add_epi32(vs2,
+					_mm256_madd_epi16(_mm256_maddubs_epi16(d, taps), ones));
+			p += 32;
+		} while (--n);
+		vs2 = _mm256_add_epi32(vs2, _mm256_slli_epi32(vps, 5));
+
+		h = _mm_add_epi32(_mm256_castsi256_si128(vs1), _mm256_extracti128_si256(vs1, 1));
+		h = _mm_add_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(1, 0, 3, 2)));
+		s1 += (es_uint32_t)_mm_cvtsi128_si32(h);
+
+		h = _mm_add_epi32(_mm256_castsi256_si128(vs2), _mm256_extracti128_si256(vs2, 1));
+		h = _mm_add_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(1, 0, 3, 2)));
+		h = _mm_add_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(2, 3, 0, 1)));
+		s2 += (es_uint32_t)_mm_cvtsi128_si32(h);
+
+		s1 %= ADLER_BASE;
+		s2 %= ADLER_BASE;
+	}
+	return adler32_scalar(s1, s2, p, len);
+}
+
+#endif //!ES_CPU_DISPATCH
+
+es_uint32_t eso_adler32_update(es_uint32_t adler, const es_byte_t *p, es_size_t len)
+{
+	es_uint32_t s1 = adler & 0xffff;
+	es_uint32_t s2 = adler >> 16;
 
-    *crc = c;
+#if ES_CPU_DISPATCH
+	if (len >= 64 && eso_cpu_has(ES_CPU_AVX2)) {
+		return adler32_avx2(s1, s2, (const es_uint8_t *)p, len);
+	}
+#endif
+	return adler32_scalar(s1, s2, (const es_uint8_t *)p, len);
 }
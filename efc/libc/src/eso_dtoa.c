@@ -0,0 +1,797 @@
+/**
+ * @file  eso_dtoa.c
+ * @brief ES floating-point <--> decimal string conversion
+ */
+
+#include "eso_dtoa.h"
+#include "eso_util.h"
+#include "eso_libc.h"
+#include <float.h>
+
+//@see: https://github.com/ulfjack/ryu (formatting)
+//@see: https://github.com/fastfloat/fast_float (parsing)
+
+#include "eso_dtoa_tables.inl"
+
+#define DOUBLE_MANTISSA_BITS    52
+#define DOUBLE_EXPONENT_BITS    11
+#define DOUBLE_BIAS             1023
+#define FLOAT_MANTISSA_BITS     23
+#define FLOAT_EXPONENT_BITS     8
+#define FLOAT_BIAS              127
+#define DOUBLE_POW5_INV_BITCOUNT 125
+#define DOUBLE_POW5_BITCOUNT    125
+
+/* the Clinger fast path needs plain IEEE double/float arithmetic (no x87 extended precision) */
+#if (defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0) || defined(_M_X64) || defined(_M_ARM64)
+#define CLINGER_FAST_PATH       1
+#else
+#define CLINGER_FAST_PATH       0
+#endif
+
+//==============================================================================
+// 128-bit helpers
+
+static ES_INLINE es_uint64_t umul128(es_uint64_t a, es_uint64_t b, es_uint64_t *hi)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 p = (unsigned __int128)a * b;
+	*hi = (es_uint64_t)(p >> 64);
+	return (es_uint64_t)p;
+#else
+	es_uint64_t a_lo = (es_uint32_t)a, a_hi = a >> 32;
+	es_uint64_t b_lo = (es_uint32_t)b, b_hi = b >> 32;
+	es_uint64_t b00 = a_lo * b_lo;
+	es_uint64_t b01 = a_lo * b_hi;
+	es_uint64_t b10 = a_hi * b_lo;
+	es_uint64_t b11 = a_hi * b_hi;
+	es_uint64_t mid1 = b10 + (b00 >> 32);
+	es_uint64_t mid2 = b01 + (es_uint32_t)mid1;
+	*hi = b11 + (mid1 >> 32) + (mid2 >> 32);
+	return (mid2 << 32) | (es_uint32_t)b00;
+#endif
+}
+
+/* 0 < dist < 64 */
+static ES_INLINE es_uint64_t shiftright128(es_uint64_t lo, es_uint64_t hi, es_uint32_t dist)
+{
+	return (hi << (64 - dist)) | (lo >> dist);
+}
+
+static ES_INLINE int clz64(es_uint64_t x)
+{
+#if defined(__GNUC__)
+	return __builtin_clzll(x);
+#else
+	int n = 0;
+	while (!(x & ULLONG(0x8000000000000000))) {
+		x <<= 1;
+		n++;
+	}
+	return n;
+#endif
+}
+
+//==============================================================================
+// Ryu: shortest round-trip formatting
+
+/* Returns e == 0 ? 1 : ceil(log_2(5^e)); requires 0 <= e <= 3528. */
+static ES_INLINE es_int32_t pow5bits(es_int32_t e)
+{
+	return (es_int32_t)(((es_uint32_t)e * 1217359) >> 19) + 1;
+}
+
+/* Returns floor(log_10(2^e)); requires 0 <= e <= 1650. */
+static ES_INLINE es_uint32_t log10Pow2(es_int32_t e)
+{
+	return ((es_uint32_t)e * 78913) >> 18;
+}
+
+/* Returns floor(log_10(5^e)); requires 0 <= e <= 2620. */
+static ES_INLINE es_uint32_t log10Pow5(es_int32_t e)
+{
+	return ((es_uint32_t)e * 732923) >> 20;
+}
+
+static ES_INLINE es_uint32_t pow5Factor(es_uint64_t value)
+{
+	es_uint32_t count = 0;
+	for (;;) {
+		es_uint64_t q = value / 5;
+		if (value != 5 * q) break;
+		value = q;
+		++count;
+	}
+	return count;
+}
+
+static ES_INLINE int multipleOfPowerOf5(es_uint64_t value, es_uint32_t p)
+{
+	return pow5Factor(value) >= p;
+}
+
+static ES_INLINE int multipleOfPowerOf2(es_uint64_t value, es_uint32_t p)
+{
+	return (value & ((ULLONG(1) << p) - 1)) == 0;
+}
+
+/* (m * mul) >> j, with mul a 125-bit {low, high} multiplier and 64 < j < 128 */
+static ES_INLINE es_uint64_t mulShift64(es_uint64_t m, const es_uint64_t *mul, es_int32_t j)
+{
+	es_uint64_t high0, high1, sum;
+	es_uint64_t low1 = umul128(m, mul[1], &high1);
+	umul128(m, mul[0], &high0);
+	sum = high0 + low1;
+	if (sum < high0) {
+		++high1;
+	}
+	return shiftright128(sum, high1, (es_uint32_t)(j - 64));
+}
+
+static ES_INLINE es_uint32_t decimalLength17(es_uint64_t v)
+{
+	if (v >= ULLONG(10000000000000000)) return 17;
+	if (v >= ULLONG(1000000000000000)) return 16;
+	if (v >= ULLONG(100000000000000)) return 15;
+	if (v >= ULLONG(10000000000000)) return 14;
+	if (v >= ULLONG(1000000000000)) return 13;
+	if (v >= ULLONG(100000000000)) return 12;
+	if (v >= ULLONG(10000000000)) return 11;
+	if (v >= ULLONG(1000000000)) return 10;
+	if (v >= 100000000) return 9;
+	if (v >= 10000000) return 8;
+	if (v >= 1000000) return 7;
+	if (v >= 100000) return 6;
+	if (v >= 10000) return 5;
+	if (v >= 1000) return 4;
+	if (v >= 100) return 3;
+	if (v >= 10) return 2;
+	return 1;
+}
+
+/*
+ * Shortest decimal (output * 10^exponent) inside the rounding interval
+ * of the binary value m2 * 2^e2. The interval is [4*m2 - 1 - mmShift, 4*m2 + 2]
+ * in units of 2^(e2-2); a float is passed in with its own m2/e2/mmShift,
+ * the double tables cover it. Digits are only removed while at least
+ * minDigits (1 or 2) are left, the last one rounded to nearest, then
+ * trailing zeros are dropped.
+ */
+static void ryu_shortest(es_uint64_t m2, es_int32_t e2, es_uint32_t mmShift, int minDigits,
+		es_uint64_t *output, es_int32_t *exponent)
+{
+	es_uint64_t minOutput = (minDigits > 1) ? 10 : 0;
+	int acceptBounds = (m2 & 1) == 0;
+	es_uint64_t mv = 4 * m2;
+	es_uint64_t vr, vp, vm;
+	es_int32_t e10;
+	int vmIsTrailingZeros = 0;
+	int vrIsTrailingZeros = 0;
+	es_int32_t removed = 0;
+	es_uint32_t lastRemovedDigit = 0;
+
+	// Step 2: Determine the interval of valid decimal representations.
+	if (e2 >= 0) {
+		es_uint32_t q = log10Pow2(e2) - (e2 > 3);
+		es_int32_t k = DOUBLE_POW5_INV_BITCOUNT + pow5bits((es_int32_t)q) - 1;
+		es_int32_t i = -e2 + (es_int32_t)q + k;
+		e10 = (es_int32_t)q;
+		vr = mulShift64(mv, DOUBLE_POW5_INV_SPLIT[q], i);
+		vp = mulShift64(mv + 2, DOUBLE_POW5_INV_SPLIT[q], i);
+		vm = mulShift64(mv - 1 - mmShift, DOUBLE_POW5_INV_SPLIT[q], i);
+		if (q <= 21) {
+			// Only one of mp, mv, and mm can be a multiple of 5, if any.
+			if (mv % 5 == 0) {
+				vrIsTrailingZeros = multipleOfPowerOf5(mv, q);
+			} else if (acceptBounds) {
+				vmIsTrailingZeros = multipleOfPowerOf5(mv - 1 - mmShift, q);
+			} else {
+				vp -= multipleOfPowerOf5(mv + 2, q);
+			}
+		}
+	} else {
+		es_uint32_t q = log10Pow5(-e2) - (-e2 > 1);
+		es_int32_t i = -e2 - (es_int32_t)q;
+		es_int32_t k = pow5bits(i) - DOUBLE_POW5_BITCOUNT;
+		es_int32_t j = (es_int32_t)q - k;
+		e10 = (es_int32_t)q + e2;
+		vr = mulShift64(mv, DOUBLE_POW5_SPLIT[i], j);
+		vp = mulShift64(mv + 2, DOUBLE_POW5_SPLIT[i], j);
+		vm = mulShift64(mv - 1 - mmShift, DOUBLE_POW5_SPLIT[i], j);
+		if (q <= 1) {
+			// {vr,vp,vm} is trailing zeros if {mv,mp,mm} has at least q trailing 0 bits.
+			vrIsTrailingZeros = 1;
+			if (acceptBounds) {
+				vmIsTrailingZeros = mmShift == 1;
+			} else {
+				--vp;
+			}
+		} else if (q < 63) {
+			vrIsTrailingZeros = multipleOfPowerOf2(mv, q);
+		}
+	}
+
+	// Step 3: Find the shortest decimal representation in the interval.
+	if (vmIsTrailingZeros || vrIsTrailingZeros) {
+		// General case, which happens rarely (~0.7%).
+		for (;;) {
+			es_uint64_t vpDiv10 = vp / 10;
+			es_uint64_t vmDiv10 = vm / 10;
+			es_uint64_t vrDiv10;
+			if (vpDiv10 <= vmDiv10 || vr / 10 < minOutput) break;
+			vmIsTrailingZeros &= (vm - vmDiv10 * 10) == 0;
+			vrIsTrailingZeros &= lastRemovedDigit == 0;
+			vrDiv10 = vr / 10;
+			lastRemovedDigit = (es_uint32_t)(vr - vrDiv10 * 10);
+			vr = vrDiv10;
+			vp = vpDiv10;
+			vm = vmDiv10;
+			++removed;
+		}
+		if (vmIsTrailingZeros) {
+			for (;;) {
+				es_uint64_t vmDiv10 = vm / 10;
+				es_uint64_t vrDiv10;
+				if (vm - vmDiv10 * 10 != 0 || vr / 10 < minOutput) break;
+				vrIsTrailingZeros &= lastRemovedDigit == 0;
+				vrDiv10 = vr / 10;
+				lastRemovedDigit = (es_uint32_t)(vr - vrDiv10 * 10);
+				vr = vrDiv10;
+				vp = vp / 10;
+				vm = vmDiv10;
+				++removed;
+			}
+		}
+		if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+			// Round even if the exact number is .....50..0.
+			lastRemovedDigit = 4;
+		}
+		*output = vr + (((vr == vm) && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+	} else {
+		// Specialized for the common case (~99.3%).
+		int roundUp = 0;
+		if (vp / 100 > vm / 100 && vr / 100 >= minOutput) {
+			// Optimization: remove two digits at a time (~86.2%).
+			es_uint64_t vrDiv100 = vr / 100;
+			roundUp = (vr - vrDiv100 * 100) >= 50;
+			vr = vrDiv100;
+			vp = vp / 100;
+			vm = vm / 100;
+			removed += 2;
+		}
+		for (;;) {
+			es_uint64_t vpDiv10 = vp / 10;
+			es_uint64_t vmDiv10 = vm / 10;
+			es_uint64_t vrDiv10;
+			if (vpDiv10 <= vmDiv10 || vr / 10 < minOutput) break;
+			vrDiv10 = vr / 10;
+			roundUp = (vr - vrDiv10 * 10) >= 5;
+			vr = vrDiv10;
+			vp = vpDiv10;
+			vm = vmDiv10;
+			++removed;
+		}
+		*output = vr + (vr == vm || roundUp);
+	}
+	// the second digit may be a zero, as in 0.0010 or 99.5 rounded up to 100
+	while (minOutput && *output >= 10 && *output % 10 == 0) {
+		*output /= 10;
+		++removed;
+	}
+	*exponent = e10 + removed;
+}
+
+/*
+ * Layout of the shortest digits.
+ */
+#define LAYOUT_SHORTEST  0
+#define LAYOUT_JAVA      1
+
+static int write_special(int sign, int is_nan, char *buf)
+{
+	char *p = buf;
+	if (is_nan) {
+		eso_memcpy(p, "NaN", 4);
+		return 3;
+	}
+	if (sign) *p++ = '-';
+	eso_memcpy(p, "Infinity", 9);
+	return (int)(p - buf) + 8;
+}
+
+static int write_zero(int sign, int layout, char *buf)
+{
+	char *p = buf;
+	if (sign) *p++ = '-';
+	*p++ = '0';
+	if (layout == LAYOUT_JAVA) {
+		*p++ = '.';
+		*p++ = '0';
+	}
+	*p = '\0';
+	return (int)(p - buf);
+}
+
+static char* write_exponent(char *p, es_int32_t exp, int java)
+{
+	if (exp < 0) {
+		*p++ = '-';
+		exp = -exp;
+	} else if (!java) {
+		*p++ = '+';
+	}
+	if (exp >= 100) {
+		*p++ = (char)('0' + exp / 100);
+		exp %= 100;
+		*p++ = (char)('0' + exp / 10);
+	} else if (exp >= 10) {
+		*p++ = (char)('0' + exp / 10);
+	}
+	*p++ = (char)('0' + exp % 10);
+	return p;
+}
+
+static int write_decimal(int sign, es_uint64_t output, es_int32_t exponent, int layout, char *buf)
+{
+	char digits[20];
+	es_uint32_t olength = decimalLength17(output);
+	es_int32_t n = (es_int32_t)olength + exponent; // decimal point position: 0.digits * 10^n
+	es_uint32_t i;
+	char *p = buf;
+
+	for (i = 0; i < olength; i++) {
+		digits[olength - 1 - i] = (char)('0' + output % 10);
+		output /= 10;
+	}
+
+	if (sign) *p++ = '-';
+
+	if (layout == LAYOUT_JAVA) {
+		if (n >= -2 && n <= 7) {
+			// 10^-3 <= |d| < 10^7
+			if (n <= 0) {
+				*p++ = '0';
+				*p++ = '.';
+				for (i = 0; i < (es_uint32_t)-n; i++) *p++ = '0';
+				eso_memcpy(p, digits, olength);
+				p += olength;
+			} else if ((es_uint32_t)n >= olength) {
+				eso_memcpy(p, digits, olength);
+				p += olength;
+				for (i = olength; i < (es_uint32_t)n; i++) *p++ = '0';
+				*p++ = '.';
+				*p++ = '0';
+			} else {
+				eso_memcpy(p, digits, n);
+				p += n;
+				*p++ = '.';
+				eso_memcpy(p, digits + n, olength - n);
+				p += olength - n;
+			}
+		} else {
+			*p++ = digits[0];
+			*p++ = '.';
+			if (olength > 1) {
+				eso_memcpy(p, digits + 1, olength - 1);
+				p += olength - 1;
+			} else {
+				*p++ = '0';
+			}
+			*p++ = 'E';
+			p = write_exponent(p, n - 1, 1);
+		}
+	} else {
+		if ((es_int32_t)olength <= n && n <= 21) {
+			eso_memcpy(p, digits, olength);
+			p += olength;
+			for (i = olength; i < (es_uint32_t)n; i++) *p++ = '0';
+		} else if (0 < n && n <= 21) {
+			eso_memcpy(p, digits, n);
+			p += n;
+			*p++ = '.';
+			eso_memcpy(p, digits + n, olength - n);
+			p += olength - n;
+		} else if (-6 < n && n <= 0) {
+			*p++ = '0';
+			*p++ = '.';
+			for (i = 0; i < (es_uint32_t)-n; i++) *p++ = '0';
+			eso_memcpy(p, digits, olength);
+			p += olength;
+		} else {
+			*p++ = digits[0];
+			if (olength > 1) {
+				*p++ = '.';
+				eso_memcpy(p, digits + 1, olength - 1);
+				p += olength - 1;
+			}
+			*p++ = 'e';
+			p = write_exponent(p, n - 1, 0);
+		}
+	}
+
+	*p = '\0';
+	return (int)(p - buf);
+}
+
+static int dtoa_layout(double d, int layout, char *buf)
+{
+	es_uint64_t bits = (es_uint64_t)eso_double2llongBits(d);
+	int sign = (int)(bits >> (DOUBLE_MANTISSA_BITS + DOUBLE_EXPONENT_BITS));
+	es_uint64_t ieeeMantissa = bits & ((ULLONG(1) << DOUBLE_MANTISSA_BITS) - 1);
+	es_uint32_t ieeeExponent = (es_uint32_t)((bits >> DOUBLE_MANTISSA_BITS) & ((1u << DOUBLE_EXPONENT_BITS) - 1));
+	es_uint64_t m2, output;
+	es_int32_t e2, exponent;
+
+	if (ieeeExponent == ((1u << DOUBLE_EXPONENT_BITS) - 1u)) {
+		return write_special(sign, ieeeMantissa != 0, buf);
+	}
+	if (ieeeExponent == 0 && ieeeMantissa == 0) {
+		return write_zero(sign, layout, buf);
+	}
+
+	if (ieeeExponent == 0) {
+		// We subtract 2 so that the bounds computation has 2 additional bits.
+		e2 = 1 - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+		m2 = ieeeMantissa;
+	} else {
+		e2 = (es_int32_t)ieeeExponent - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+		m2 = (ULLONG(1) << DOUBLE_MANTISSA_BITS) | ieeeMantissa;
+	}
+	ryu_shortest(m2, e2, (ieeeMantissa != 0 || ieeeExponent <= 1),
+			(layout == LAYOUT_JAVA) ? 2 : 1, &output, &exponent);
+	return write_decimal(sign, output, exponent, layout, buf);
+}
+
+static int ftoa_layout(float f, int layout, char *buf)
+{
+	es_uint32_t bits = (es_uint32_t)eso_float2intBits(f);
+	int sign = (int)(bits >> (FLOAT_MANTISSA_BITS + FLOAT_EXPONENT_BITS));
+	es_uint32_t ieeeMantissa = bits & ((1u << FLOAT_MANTISSA_BITS) - 1);
+	es_uint32_t ieeeExponent = (bits >> FLOAT_MANTISSA_BITS) & ((1u << FLOAT_EXPONENT_BITS) - 1);
+	es_uint64_t m2, output;
+	es_int32_t e2, exponent;
+
+	if (ieeeExponent == ((1u << FLOAT_EXPONENT_BITS) - 1u)) {
+		return write_special(sign, ieeeMantissa != 0, buf);
+	}
+	if (ieeeExponent == 0 && ieeeMantissa == 0) {
+		return write_zero(sign, layout, buf);
+	}
+
+	if (ieeeExponent == 0) {
+		e2 = 1 - FLOAT_BIAS - FLOAT_MANTISSA_BITS - 2;
+		m2 = ieeeMantissa;
+	} else {
+		e2 = (es_int32_t)ieeeExponent - FLOAT_BIAS - FLOAT_MANTISSA_BITS - 2;
+		m2 = (1u << FLOAT_MANTISSA_BITS) | ieeeMantissa;
+	}
+	ryu_shortest(m2, e2, (ieeeMantissa != 0 || ieeeExponent <= 1),
+			(layout == LAYOUT_JAVA) ? 2 : 1, &output, &exponent);
+	return write_decimal(sign, output, exponent, layout, buf);
+}
+
+int eso_dtoa_shortest(double d, char *buf)
+{
+	return dtoa_layout(d, LAYOUT_SHORTEST, buf);
+}
+
+int eso_ftoa_shortest(float f, char *buf)
+{
+	return ftoa_layout(f, LAYOUT_SHORTEST, buf);
+}
+
+int eso_dtoa_java(double d, char *buf)
+{
+	return dtoa_layout(d, LAYOUT_JAVA, buf);
+}
+
+int eso_ftoa_java(float f, char *buf)
+{
+	return ftoa_layout(f, LAYOUT_JAVA, buf);
+}
+
+//==============================================================================
+// Eisel-Lemire: exact decimal parsing
+
+typedef struct {
+	int mantissa_bits;
+	int minimum_exponent;
+	int infinite_power;
+	int smallest_power_of_ten;
+	int largest_power_of_ten;
+	int min_exponent_round_to_even;
+	int max_exponent_round_to_even;
+} binary_format_t;
+
+static const binary_format_t binary64 = { 52, -1023, 0x7FF, -342, 308, -4, 23 };
+static const binary_format_t binary32 = { 23, -127, 0xFF, -65, 38, -17, 10 };
+
+typedef struct {
+	es_int64_t exponent;
+	es_uint64_t mantissa;
+	int negative;
+	int many_digits; /* more than 19 significant digits, mantissa is truncated */
+} decimal_t;
+
+#define IS_DIGIT(c)  ((unsigned char)((c) - '0') < 10)
+
+/*
+ * Parse [sign] digits [. digits] [(e|E) [sign] digits].
+ * @return the end of the number, or null if it isn't a plain decimal.
+ */
+static const char* parse_decimal(const char *p, decimal_t *n)
+{
+	const es_uint64_t minimal_nineteen_digit_integer = ULLONG(1000000000000000000);
+	const char *int_start, *int_end, *frac_start = NULL, *frac_end = NULL;
+	es_uint64_t i = 0;
+	es_int64_t exponent = 0;
+	es_int64_t exp_number = 0;
+	es_int64_t digit_count;
+
+	n->negative = (*p == '-');
+	if (*p == '-' || *p == '+') {
+		p++;
+	}
+	if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+		return NULL; //hex float
+	}
+
+	int_start = p;
+	while (IS_DIGIT(*p)) {
+		i = 10 * i + (es_uint64_t)(*p - '0'); // might overflow, handled below
+		p++;
+	}
+	int_end = p;
+	digit_count = int_end - int_start;
+	if (*p == '.') {
+		p++;
+		frac_start = p;
+		while (IS_DIGIT(*p)) {
+			i = 10 * i + (es_uint64_t)(*p - '0');
+			p++;
+		}
+		frac_end = p;
+		exponent = frac_start - frac_end;
+		digit_count += frac_end - frac_start;
+	}
+	if (digit_count == 0) {
+		return NULL;
+	}
+
+	if (*p == 'e' || *p == 'E') {
+		const char *e = p + 1;
+		int neg_exp = 0;
+		if (*e == '-') {
+			neg_exp = 1;
+			e++;
+		} else if (*e == '+') {
+			e++;
+		}
+		if (IS_DIGIT(*e)) {
+			while (IS_DIGIT(*e)) {
+				if (exp_number < 0x10000000) {
+					exp_number = 10 * exp_number + (*e - '0');
+				}
+				e++;
+			}
+			if (neg_exp) exp_number = -exp_number;
+			exponent += exp_number;
+			p = e;
+		}
+	}
+
+	n->many_digits = 0;
+	if (digit_count > 19) {
+		// leading zeros are not significant
+		const char *s = int_start;
+		while (*s == '0' || *s == '.') {
+			if (*s == '0') digit_count--;
+			s++;
+		}
+		if (digit_count > 19) {
+			const char *q = int_start;
+			n->many_digits = 1;
+			i = 0;
+			while (i < minimal_nineteen_digit_integer && q != int_end) {
+				i = i * 10 + (es_uint64_t)(*q - '0');
+				++q;
+			}
+			if (i >= minimal_nineteen_digit_integer) {
+				exponent = (int_end - q) + exp_number;
+			} else {
+				q = frac_start;
+				while (i < minimal_nineteen_digit_integer && q != frac_end) {
+					i = i * 10 + (es_uint64_t)(*q - '0');
+					++q;
+				}
+				exponent = (frac_start - q) + exp_number;
+			}
+		}
+	}
+
+	n->exponent = exponent;
+	n->mantissa = i;
+	return p;
+}
+
+/*
+ * w * 10^q to binary.
+ * @return 0 if the result can't be decided here.
+ */
+static int compute_float(const binary_format_t *f, es_int64_t q, es_uint64_t w,
+		es_uint64_t *mantissa, es_int32_t *power2)
+{
+	es_uint64_t lo, hi, m, precision_mask;
+	es_int32_t lz, upperbit, p2;
+	int shift;
+
+	if (w == 0 || q < f->smallest_power_of_ten) {
+		*mantissa = 0;
+		*power2 = 0;
+		return 1;
+	}
+	if (q > f->largest_power_of_ten) {
+		*mantissa = 0;
+		*power2 = f->infinite_power;
+		return 1;
+	}
+
+	lz = clz64(w);
+	w <<= lz;
+
+	// 128-bit approximation of w * 5^q, a second product only when the first one is inexact
+	lo = umul128(w, POW5_128[q + 342][0], &hi);
+	precision_mask = ULLONG(0xFFFFFFFFFFFFFFFF) >> (f->mantissa_bits + 3);
+	if ((hi & precision_mask) == precision_mask) {
+		es_uint64_t hi2;
+		umul128(w, POW5_128[q + 342][1], &hi2);
+		lo += hi2;
+		if (hi2 > lo) {
+			++hi;
+		}
+	}
+	if (lo == ULLONG(0xFFFFFFFFFFFFFFFF) && (q < -27 || q > 55)) {
+		return 0;
+	}
+
+	upperbit = (es_int32_t)(hi >> 63);
+	shift = upperbit + 64 - f->mantissa_bits - 3;
+	m = hi >> shift;
+	// power(q) = floor(log2(10^q)) + 63
+	p2 = (es_int32_t)((((152170 + 65536) * q) >> 16) + 63) + upperbit - lz - f->minimum_exponent;
+
+	if (p2 <= 0) {
+		// subnormal
+		if (-p2 + 1 >= 64) {
+			*mantissa = 0;
+			*power2 = 0;
+			return 1;
+		}
+		m >>= -p2 + 1;
+		m += (m & 1);
+		m >>= 1;
+		*mantissa = m;
+		*power2 = (m < (ULLONG(1) << f->mantissa_bits)) ? 0 : 1;
+		return 1;
+	}
+
+	// exactly halfway between two floats: round to even
+	if (lo <= 1 && q >= f->min_exponent_round_to_even && q <= f->max_exponent_round_to_even
+			&& (m & 3) == 1) {
+		if ((m << shift) == hi) {
+			m &= ~ULLONG(1);
+		}
+	}
+
+	m += (m & 1);
+	m >>= 1;
+	if (m >= (ULLONG(2) << f->mantissa_bits)) {
+		m = ULLONG(1) << f->mantissa_bits;
+		p2++;
+	}
+	m &= ~(ULLONG(1) << f->mantissa_bits);
+	if (p2 >= f->infinite_power) {
+		p2 = f->infinite_power;
+		m = 0;
+	}
+	*mantissa = m;
+	*power2 = p2;
+	return 1;
+}
+
+/*
+ * @return 0 if the result can't be decided here.
+ */
+static int decimal_to_bits(const binary_format_t *f, const decimal_t *n, es_uint64_t *bits)
+{
+	es_uint64_t m;
+	es_int32_t p2;
+
+	if (!compute_float(f, n->exponent, n->mantissa, &m, &p2)) {
+		return 0;
+	}
+	if (n->many_digits) {
+		// the truncated digits must not change the rounding
+		es_uint64_t m1;
+		es_int32_t p21;
+		if (!compute_float(f, n->exponent, n->mantissa + 1, &m1, &p21) || m != m1 || p2 != p21) {
+			return 0;
+		}
+	}
+	*bits = m | ((es_uint64_t)p2 << f->mantissa_bits);
+	if (n->negative) {
+		*bits |= ULLONG(1) << (f->mantissa_bits + (f == &binary64 ? DOUBLE_EXPONENT_BITS : FLOAT_EXPONENT_BITS));
+	}
+	return 1;
+}
+
+#if CLINGER_FAST_PATH
+static const double pow10_double[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const float pow10_float[] = {
+	1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+#endif
+
+double eso_parse_double(const char *s, char **endptr)
+{
+	const char *p = s;
+	const char *end;
+	decimal_t n;
+	es_uint64_t bits;
+
+	while (eso_isspace((unsigned char)*p)) p++;
+	end = parse_decimal(p, &n);
+	if (!end) {
+		return strtod(s, endptr);
+	}
+
+#if CLINGER_FAST_PATH
+	if (!n.many_digits && n.exponent >= -22 && n.exponent <= 22
+			&& n.mantissa <= (ULLONG(1) << 53)) {
+		double d = (double)n.mantissa;
+		d = (n.exponent < 0) ? d / pow10_double[-n.exponent] : d * pow10_double[n.exponent];
+		if (endptr) *endptr = (char*)end;
+		return n.negative ? -d : d;
+	}
+#endif
+
+	if (!decimal_to_bits(&binary64, &n, &bits)) {
+		return strtod(s, endptr);
+	}
+	if (endptr) *endptr = (char*)end;
+	return eso_llongBits2double((es_int64_t)bits);
+}
+
+float eso_parse_float(const char *s, char **endptr)
+{
+	const char *p = s;
+	const char *end;
+	decimal_t n;
+	es_uint64_t bits;
+
+	while (eso_isspace((unsigned char)*p)) p++;
+	end = parse_decimal(p, &n);
+	if (!end) {
+		return strtof(s, endptr);
+	}
+
+#if CLINGER_FAST_PATH
+	if (!n.many_digits && n.exponent >= -10 && n.exponent <= 10
+			&& n.mantissa <= (ULLONG(1) << 24)) {
+		float f = (float)n.mantissa;
+		f = (n.exponent < 0) ? f / pow10_float[-n.exponent] : f * pow10_float[n.exponent];
+		if (endptr) *endptr = (char*)end;
+		return n.negative ? -f : f;
+	}
+#endif
+
+	if (!decimal_to_bits(&binary32, &n, &bits)) {
+		return strtof(s, endptr);
+	}
+	if (endptr) *endptr = (char*)end;
+	return eso_intBits2float((es_int32_t)(es_uint32_t)bits);
+}
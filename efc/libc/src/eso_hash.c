@@ -6,6 +6,14 @@
 #include "eso_hash.h"
 #include "eso_util.h"
 #include "eso_libc.h"
+#include "eso_atomic.h"
+#include <time.h>
+#ifdef WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 /*
  * The internal form of a hash table.
@@ -370,3 +378,168 @@ void eso_hash_free(es_hash_t **ht)
     /* free self-node */
     ESO_FREE(ht);
 }
+
+
+/*
+ * 64-bit wyhash (final version 4, public domain, by Wang Yi):
+ * 128-bit multiply-xor mixing of 16 bytes per step, 3 independent
+ * lanes for long keys.
+ */
+
+static const es_uint64_t wyp[4] = {
+	ULLONG(0x2d358dccaa6c78a5), ULLONG(0x8bb84b93962eacc9),
+	ULLONG(0x4b33a62ed433d4a3), ULLONG(0x4d5a2da51de1aa47)
+};
+
+static ES_INLINE void wymum(es_uint64_t *a, es_uint64_t *b)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 r = (unsigned __int128)(*a) * (*b);
+	*a = (es_uint64_t)r;
+	*b = (es_uint64_t)(r >> 64);
+#else
+	es_uint64_t ha = *a >> 32, hb = *b >> 32;
+	es_uint64_t la = (es_uint32_t)*a, lb = (es_uint32_t)*b;
+	es_uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	es_uint64_t t = rl + (rm0 << 32), c = t < rl, lo, hi;
+	lo = t + (rm1 << 32);
+	c += lo < t;
+	hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+	*a = lo;
+	*b = hi;
+#endif
+}
+
+static ES_INLINE es_uint64_t wymix(es_uint64_t a, es_uint64_t b)
+{
+	wymum(&a, &b);
+	return a ^ b;
+}
+
+static ES_INLINE es_uint64_t wyr8(const es_uint8_t *p)
+{
+	es_uint64_t v;
+	memcpy(&v, p, 8);
+	return v;
+}
+
+static ES_INLINE es_uint64_t wyr4(const es_uint8_t *p)
+{
+	es_uint32_t v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+static ES_INLINE es_uint64_t wyr3(const es_uint8_t *p, es_size_t k)
+{
+	return (((es_uint64_t)p[0]) << 16) | (((es_uint64_t)p[k >> 1]) << 8) | p[k - 1];
+}
+
+es_uint64_t eso_hash64(const void *key, es_size_t len, es_uint64_t seed)
+{
+	const es_uint8_t *p = (const es_uint8_t *)key;
+	es_uint64_t a, b;
+
+	seed ^= wymix(seed ^ wyp[0], wyp[1]);
+	if (len <= 16) {
+		if (len >= 4) {
+			a = (wyr4(p) << 32) | wyr4(p + ((len >> 3) << 2));
+			b = (wyr4(p + len - 4) << 32) | wyr4(p + len - 4 - ((len >> 3) << 2));
+		} else if (len > 0) {
+			a = wyr3(p, len);
+			b = 0;
+		} else {
+			a = b = 0;
+		}
+	} else {
+		es_size_t i = len;
+		if (i >= 48) {
+			es_uint64_t see1 = seed, see2 = seed;
+			do {
+				seed = wymix(wyr8(p) ^ wyp[1], wyr8(p + 8) ^ seed);
+				see1 = wymix(wyr8(p + 16) ^ wyp[2], wyr8(p + 24) ^ see1);
+				see2 = wymix(wyr8(p + 32) ^ wyp[3], wyr8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i >= 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16) {
+			seed = wymix(wyr8(p) ^ wyp[1], wyr8(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+		a = wyr8(p + i - 16);
+		b = wyr8(p + i - 8);
+	}
+	a ^= wyp[1];
+	b ^= seed;
+	wymum(&a, &b);
+	return wymix(a ^ wyp[0] ^ len, b ^ wyp[1]);
+}
+
+es_uint64_t eso_hash64_int(es_uint64_t v, es_uint64_t seed)
+{
+	es_uint64_t a = v ^ wyp[0];
+	es_uint64_t b = seed ^ wyp[1];
+	wymum(&a, &b);
+	return wymix(a ^ wyp[0], b ^ wyp[1]);
+}
+
+es_uint32_t eso_hashfunc_wyhash(const char *key, es_ssize_t *klen)
+{
+	es_uint64_t h;
+
+	if (*klen == ES_HASH_KEY_STRING) {
+		*klen = strlen(key);
+	}
+	h = eso_hash64(key, *klen, eso_hash_seed());
+	return (es_uint32_t)(h ^ (h >> 32));
+}
+
+/*
+ * Per-process seed, 0 means not generated yet.
+ */
+static volatile es_int64_t hash_seed = 0;
+
+static es_uint64_t random_seed(void)
+{
+	es_uint64_t seed = 0;
+	int local;
+
+#ifndef WIN32
+	int fd = open("/dev/urandom", O_RDONLY);
+	if (fd >= 0) {
+		if (read(fd, &seed, sizeof(seed)) != sizeof(seed)) {
+			seed = 0;
+		}
+		close(fd);
+	}
+	seed ^= (es_uint64_t)getpid();
+#else
+	seed ^= (es_uint64_t)_getpid();
+#endif
+
+	// also mix in time and addresses in case there is no random device
+	seed = eso_hash64_int(seed, (es_uint64_t)time(NULL));
+	seed = eso_hash64_int(seed, (es_uint64_t)clock());
+	seed = eso_hash64_int(seed, (es_uint64_t)(es_uintptr_t)&local);
+	seed = eso_hash64_int(seed, (es_uint64_t)(es_uintptr_t)&hash_seed);
+	return seed ? seed : wyp[2];
+}
+
+es_uint64_t eso_hash_seed(void)
+{
+	es_int64_t seed = hash_seed;
+	if (seed == 0) {
+		// the first winner decides for all threads
+		eso_atomic_compare_and_swap64(&hash_seed, 0, (es_int64_t)random_seed());
+		seed = hash_seed;
+	}
+	return (es_uint64_t)seed;
+}
+
+void eso_hash_seed_set(es_uint64_t seed)
+{
+	eso_atomic_test_and_set64(&hash_seed, (es_int64_t)seed);
+}
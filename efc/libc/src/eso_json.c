@@ -5,6 +5,7 @@
 
 #include "eso_json.h"
 #include "eso_util.h"
+#include "eso_dtoa.h"
 #include "eso_string.h"
 #include <math.h>
 #include <float.h>
@@ -63,26 +64,17 @@ static es_json_t *create_reference(es_json_t *item) {
 /* Parse the input text to generate a number, and populate the result into item. */
 static const char *parse_number(es_json_t *item, const char *num)
 {
-	double n=0,sign=1,scale=0;int subscale=0,signsubscale=1;
-
-	/* Could use sscanf for this? */
-	if (*num=='-') sign=-1,num++;	/* Has sign? */
-	if (*num=='0') num++;			/* is zero */
-	if (*num>='1' && *num<='9')	{
-		do n=(n*10.0)+(*num++ -'0'); while (*num>='0' && *num<='9');
-	}	/* Number? */
-	if (*num=='.' && num[1]>='0' && num[1]<='9') {
-		num++;
-		do n=(n*10.0)+(*num++ -'0'),scale--; while (*num>='0' && *num<='9');
-	}	/* Fractional part? */
-	if (*num=='e' || *num=='E') {
-		num++;
-		if (*num=='+') num++; else if (*num=='-') signsubscale=-1,num++;		/* With sign? */
-		while (*num>='0' && *num<='9') subscale=(subscale*10)+(*num++ - '0');	/* Number? */
-	}	/* Exponent? */
-
-	n = sign*n*pow(10.0,(scale+subscale*signsubscale));	/* number = +/- number.fraction * 10^+/- exponent */
-	
+	double n;
+	char *end;
+	const char *p = (*num=='-') ? num+1 : num;
+
+	if (*p<'0' || *p>'9' || (p[0]=='0' && (p[1]=='x' || p[1]=='X'))) return 0;	/* Decimal only */
+
+	/* Exact conversion, number = +/- number.fraction * 10^+/- exponent */
+	n = eso_parse_double(num, &end);
+	if (end == num) return 0;
+	num = end;
+
 	item->valuedouble = n;
 	item->valueint = (int)n;
 	item->type = ES_JSON_NUMBER;
@@ -99,11 +91,11 @@ static char *print_number(es_json_t *item)
 		if (str)                                      eso_sprintf(str,"%d",item->valueint);
 	}
 	else {
-		str=(char*)eso_malloc(64);	/* This is a nice tradeoff. */
+		str=(char*)eso_malloc(ES_DTOA_BUFSIZE);
 		if (str) {
-			if (fabs(floor(d)-d)<=DBL_EPSILON && fabs(d)<1.0e60) eso_sprintf(str,"%.0f",d);
-			else if (fabs(d)<1.0e-6 || fabs(d)>1.0e9) eso_sprintf(str,"%e",d);
-			else                                      eso_sprintf(str,"%f",d);
+			/* Shortest round-trip form, JSON has no NaN or Infinity. */
+			if (d!=d || d-d!=0)                        eso_strcpy(str,"null");
+			else                                      eso_dtoa_shortest(d,str);
 		}
 	}
 	return str;
@@ -0,0 +1,297 @@
+/**
+ * @file  eso_jsonsimd.c
+ * @brief ES JSON structural indexing with SSE2/AVX2 runtime dispatch
+ */
+
+#include "eso_jsonsimd.h"
+#include "eso_cpu.h"
+#include <string.h>
+
+#if ES_CPU_DISPATCH
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+#define EVEN_BITS  ULLONG(0x5555555555555555)
+
+/* byte classes of the portable classifier */
+#define C_QUOTE    0x01
+#define C_SLASH    0x02
+#define C_OP       0x04
+#define C_WS       0x08
+#define C_CTRL     0x10
+
+typedef struct {
+	es_uint64_t quote;
+	es_uint64_t slash;
+	es_uint64_t op;
+	es_uint64_t ws;
+	es_uint64_t ctrl;
+} block_masks_t;
+
+static es_uint8_t byte_class[256];
+static volatile int byte_class_inited = 0;
+
+static void init_byte_class(void)
+{
+	int i;
+	for (i = 0; i < 0x20; i++) {
+		byte_class[i] = C_CTRL;
+	}
+	byte_class['"'] = C_QUOTE;
+	byte_class['\\'] = C_SLASH;
+	byte_class['{'] = byte_class['}'] = C_OP;
+	byte_class['['] = byte_class[']'] = C_OP;
+	byte_class[':'] = byte_class[','] = C_OP;
+	byte_class[' '] = C_WS;
+	byte_class['\t'] = byte_class['\n'] = byte_class['\r'] = C_WS | C_CTRL;
+	byte_class_inited = 1;
+}
+
+static ES_INLINE int ctz64(es_uint64_t x)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long r;
+	_BitScanForward64(&r, x);
+	return (int)r;
+#elif defined(_MSC_VER)
+	unsigned long r;
+	if ((es_uint32_t)x) {
+		_BitScanForward(&r, (es_uint32_t)x);
+		return (int)r;
+	}
+	_BitScanForward(&r, (es_uint32_t)(x >> 32));
+	return (int)r + 32;
+#else
+	return __builtin_ctzll(x);
+#endif
+}
+
+/* bit i = xor of the bits 0..i, i.e. 1 from an opening quote to before the closing one */
+static ES_INLINE es_uint64_t prefix_xor(es_uint64_t x)
+{
+	x ^= x << 1;
+	x ^= x << 2;
+	x ^= x << 4;
+	x ^= x << 8;
+	x ^= x << 16;
+	x ^= x << 32;
+	return x;
+}
+
+/*
+ * The bytes after an odd length backslash run, which are escaped: a run
+ * starting at an even position ends at an odd one when its length is odd,
+ * the additions carry the starts through the runs.
+ */
+static ES_INLINE es_uint64_t escaped_bytes(es_uint64_t slash, es_uint64_t *carry)
+{
+	es_uint64_t starts = slash & ~(slash << 1);
+	es_uint64_t even_start_mask = EVEN_BITS ^ *carry;
+	es_uint64_t even_starts = starts & even_start_mask;
+	es_uint64_t odd_starts = starts & ~even_start_mask;
+	es_uint64_t even_carries = slash + even_starts;
+	es_uint64_t odd_carries = slash + odd_starts;
+	es_uint64_t overflow = (odd_carries < slash) ? 1 : 0;
+	es_uint64_t even_ends, odd_ends;
+
+	odd_carries |= *carry;
+	*carry = overflow;
+	even_ends = even_carries & ~slash & ~EVEN_BITS;
+	odd_ends = odd_carries & ~slash & EVEN_BITS;
+	return even_ends | odd_ends;
+}
+
+static ES_INLINE es_size_t index_block(es_json_scanner_t *sc,
+		const block_masks_t *m, es_uint32_t pos, es_uint32_t *out)
+{
+	es_uint64_t quote = m->quote & ~escaped_bytes(m->slash, &sc->escaped);
+	es_uint64_t in_string = prefix_xor(quote) ^ sc->in_string;
+	es_uint64_t scalar, starts, bits;
+	es_size_t n = 0;
+
+	sc->in_string = (es_uint64_t)((es_int64_t)in_string >> 63);
+	sc->error |= m->ctrl & (in_string | ~m->ws);
+
+	scalar = ~(m->op | m->ws | quote);
+	starts = scalar & ~((scalar << 1) | sc->scalar);
+	sc->scalar = scalar >> 63;
+
+	bits = ((m->op | starts) & ~in_string) | (quote & in_string);
+	while (bits) {
+		out[n++] = pos + ctz64(bits);
+		bits &= bits - 1;
+	}
+	return n;
+}
+
+static void classify_scalar(const char *s, block_masks_t *m)
+{
+	es_uint64_t quote = 0, slash = 0, op = 0, ws = 0, ctrl = 0;
+	int i;
+
+	for (i = 0; i < ES_JSON_BLOCK_SIZE; i++) {
+		es_uint64_t bit = ULLONG(1) << i;
+		int c = byte_class[(unsigned char)s[i]];
+		if (c) {
+			if (c & C_QUOTE) quote |= bit;
+			if (c & C_SLASH) slash |= bit;
+			if (c & C_OP) op |= bit;
+			if (c & C_WS) ws |= bit;
+			if (c & C_CTRL) ctrl |= bit;
+		}
+	}
+	m->quote = quote;
+	m->slash = slash;
+	m->op = op;
+	m->ws = ws;
+	m->ctrl = ctrl;
+}
+
+static es_size_t index_scalar(es_json_scanner_t *sc, const char *s,
+		es_size_t n, es_uint32_t base, es_uint32_t *out)
+{
+	block_masks_t m;
+	es_size_t i, count = 0;
+
+	for (i = 0; i + ES_JSON_BLOCK_SIZE <= n; i += ES_JSON_BLOCK_SIZE) {
+		classify_scalar(s + i, &m);
+		count += index_block(sc, &m, base + (es_uint32_t)i, out + count);
+	}
+	return count;
+}
+
+//==============================================================================
+// x86 kernels
+
+#if ES_CPU_DISPATCH
+
+ES_CPU_TARGET("sse2")
+static ES_INLINE es_uint64_t movemask_sse2(__m128i v0, __m128i v1, __m128i v2, __m128i v3)
+{
+	return (es_uint64_t)(es_uint32_t)_mm_movemask_epi8(v0)
+			| ((es_uint64_t)(es_uint32_t)_mm_movemask_epi8(v1) << 16)
+			| ((es_uint64_t)(es_uint32_t)_mm_movemask_epi8(v2) << 32)
+			| ((es_uint64_t)(es_uint32_t)_mm_movemask_epi8(v3) << 48);
+}
+
+#define SSE2_CLASSIFY(v, quote, slash, op, ws, ctrl) do { \
+	quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"')); \
+	slash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')); \
+	op = _mm_or_si128( \
+			_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('{')), _mm_cmpeq_epi8(v, _mm_set1_epi8('}'))), \
+			_mm_or_si128( \
+				_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('[')), _mm_cmpeq_epi8(v, _mm_set1_epi8(']'))), \
+				_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))))); \
+	ws = _mm_or_si128( \
+			_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))), \
+			_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')))); \
+	ctrl = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1F)), v); \
+} while (0)
+
+ES_CPU_TARGET("sse2")
+static es_size_t index_sse2(es_json_scanner_t *sc, const char *s,
+		es_size_t n, es_uint32_t base, es_uint32_t *out)
+{
+	block_masks_t m;
+	es_size_t i, count = 0;
+
+	for (i = 0; i + ES_JSON_BLOCK_SIZE <= n; i += ES_JSON_BLOCK_SIZE) {
+		__m128i q[4], b[4], o[4], w[4], c[4];
+		int k;
+		for (k = 0; k < 4; k++) {
+			__m128i v = _mm_loadu_si128((const __m128i *)(s + i + 16 * k));
+			SSE2_CLASSIFY(v, q[k], b[k], o[k], w[k], c[k]);
+		}
+		m.quote = movemask_sse2(q[0], q[1], q[2], q[3]);
+		m.slash = movemask_sse2(b[0], b[1], b[2], b[3]);
+		m.op = movemask_sse2(o[0], o[1], o[2], o[3]);
+		m.ws = movemask_sse2(w[0], w[1], w[2], w[3]);
+		m.ctrl = movemask_sse2(c[0], c[1], c[2], c[3]);
+		count += index_block(sc, &m, base + (es_uint32_t)i, out + count);
+	}
+	return count;
+}
+
+#define AVX2_CLASSIFY(v, quote, slash, op, ws, ctrl) do { \
+	quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')); \
+	slash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')); \
+	op = _mm256_or_si256( \
+			_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('}'))), \
+			_mm256_or_si256( \
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('[')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(']'))), \
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))))); \
+	ws = _mm256_or_si256( \
+			_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))), \
+			_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')))); \
+	ctrl = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1F)), v); \
+} while (0)
+
+#define AVX2_MASK(lo, hi) \
+	((es_uint64_t)(es_uint32_t)_mm256_movemask_epi8(lo) \
+			| ((es_uint64_t)(es_uint32_t)_mm256_movemask_epi8(hi) << 32))
+
+ES_CPU_TARGET("avx2")
+static es_size_t index_avx2(es_json_scanner_t *sc, const char *s,
+		es_size_t n, es_uint32_t base, es_uint32_t *out)
+{
+	block_masks_t m;
+	es_size_t i, count = 0;
+
+	for (i = 0; i + ES_JSON_BLOCK_SIZE <= n; i += ES_JSON_BLOCK_SIZE) {
+		__m256i v0 = _mm256_loadu_si256((const __m256i *)(s + i));
+		__m256i v1 = _mm256_loadu_si256((const __m256i *)(s + i + 32));
+		__m256i q0, b0, o0, w0, c0, q1, b1, o1, w1, c1;
+		AVX2_CLASSIFY(v0, q0, b0, o0, w0, c0);
+		AVX2_CLASSIFY(v1, q1, b1, o1, w1, c1);
+		m.quote = AVX2_MASK(q0, q1);
+		m.slash = AVX2_MASK(b0, b1);
+		m.op = AVX2_MASK(o0, o1);
+		m.ws = AVX2_MASK(w0, w1);
+		m.ctrl = AVX2_MASK(c0, c1);
+		count += index_block(sc, &m, base + (es_uint32_t)i, out + count);
+	}
+	return count;
+}
+
+#endif //!ES_CPU_DISPATCH
+
+//==============================================================================
+
+void eso_json_scanner_init(es_json_scanner_t *scanner)
+{
+	memset(scanner, 0, sizeof(*scanner));
+	if (!byte_class_inited) {
+		init_byte_class();
+	}
+}
+
+es_size_t eso_json_index(es_json_scanner_t *scanner, const char *s,
+		es_size_t n, es_uint32_t base, es_uint32_t *out)
+{
+	char tail[ES_JSON_BLOCK_SIZE];
+	es_size_t whole = n & ~(es_size_t)(ES_JSON_BLOCK_SIZE - 1);
+	es_size_t count;
+
+#if ES_CPU_DISPATCH
+	es_uint32_t f = eso_cpu_features();
+	if (f & ES_CPU_AVX2) {
+		count = index_avx2(scanner, s, whole, base, out);
+	} else if (f & ES_CPU_SSE2) {
+		count = index_sse2(scanner, s, whole, base, out);
+	} else
+#endif
+	count = index_scalar(scanner, s, whole, base, out);
+
+	// the last partial block padded with spaces
+	if (whole < n) {
+		memset(tail, ' ', sizeof(tail));
+		memcpy(tail, s + whole, n - whole);
+		count += index_scalar(scanner, tail, ES_JSON_BLOCK_SIZE,
+				base + (es_uint32_t)whole, out + count);
+	}
+	return count;
+}
@@ -0,0 +1,813 @@
+/**
+ * @file  eso_lz4.c
+ * @brief LZ4 block and frame codec, and xxHash32
+ */
+
+#include "eso_lz4.h"
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#define MINMATCH       4
+#define LASTLITERALS   5   /* the last 5 bytes of a block are literals */
+#define MFLIMIT        12  /* no match starts in the last 12 bytes */
+#define MAX_DISTANCE   65535
+#define ML_BITS        4
+#define ML_MASK        15
+#define RUN_MASK       15
+#define HASH_LOG       12  /* 13 for the blocks up to 64KB */
+#define SKIP_TRIGGER   6   /* the search step grows every 64 misses */
+
+#define PRIME32_1      2654435761U
+#define PRIME32_2      2246822519U
+#define PRIME32_3      3266489917U
+#define PRIME32_4      668265263U
+#define PRIME32_5      374761393U
+
+#define SKIPPABLE_MAGIC 0x184D2A50
+#define FRAME_BLOCK     (64 * 1024)
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define LZ4_BIG_ENDIAN 1
+#else
+#define LZ4_BIG_ENDIAN 0
+#endif
+
+static ES_INLINE es_uint32_t read32(const es_uint8_t *p)
+{
+	es_uint32_t v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+static ES_INLINE es_uint32_t read16le(const es_uint8_t *p)
+{
+	return (es_uint32_t)p[0] | ((es_uint32_t)p[1] << 8);
+}
+
+static ES_INLINE es_uint32_t read32le(const es_uint8_t *p)
+{
+#if LZ4_BIG_ENDIAN
+	return (es_uint32_t)p[0] | ((es_uint32_t)p[1] << 8) |
+			((es_uint32_t)p[2] << 16) | ((es_uint32_t)p[3] << 24);
+#else
+	return read32(p);
+#endif
+}
+
+static ES_INLINE void write16le(es_uint8_t *p, es_uint32_t v)
+{
+	p[0] = (es_uint8_t)v;
+	p[1] = (es_uint8_t)(v >> 8);
+}
+
+static ES_INLINE void write32le(es_uint8_t *p, es_uint32_t v)
+{
+	p[0] = (es_uint8_t)v;
+	p[1] = (es_uint8_t)(v >> 8);
+	p[2] = (es_uint8_t)(v >> 16);
+	p[3] = (es_uint8_t)(v >> 24);
+}
+
+#if !LZ4_BIG_ENDIAN
+static ES_INLINE int ctz64(es_uint64_t x)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long r;
+	_BitScanForward64(&r, x);
+	return (int)r;
+#elif defined(_MSC_VER)
+	unsigned long r;
+	if ((es_uint32_t)x) {
+		_BitScanForward(&r, (es_uint32_t)x);
+		return (int)r;
+	}
+	_BitScanForward(&r, (es_uint32_t)(x >> 32));
+	return (int)r + 32;
+#else
+	return __builtin_ctzll(x);
+#endif
+}
+#endif
+
+/* hashes the 5 bytes at p on 64-bit targets, 4 bytes otherwise */
+static ES_INLINE es_uint32_t hash_at(const es_uint8_t *p, int shift)
+{
+#if !LZ4_BIG_ENDIAN && (defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__))
+	es_uint64_t v;
+	memcpy(&v, p, 8);
+	return (es_uint32_t)(((v << 24) * ULLONG(889523592379)) >> (32 + shift));
+#else
+	return (read32(p) * PRIME32_1) >> shift;
+#endif
+}
+
+/* the number of equal bytes at p and m, p stops at limit */
+static ES_INLINE es_uint32_t count_match(const es_uint8_t *p,
+		const es_uint8_t *m, const es_uint8_t *limit)
+{
+	const es_uint8_t *start = p;
+#if !LZ4_BIG_ENDIAN
+	while (limit - p >= 8) {
+		es_uint64_t a, b;
+		memcpy(&a, p, 8);
+		memcpy(&b, m, 8);
+		if (a != b) {
+			return (es_uint32_t)(p - start) + (ctz64(a ^ b) >> 3);
+		}
+		p += 8;
+		m += 8;
+	}
+#endif
+	while (p < limit && *p == *m) {
+		p++;
+		m++;
+	}
+	return (es_uint32_t)(p - start);
+}
+
+/* copies 8 bytes at a time, up to 7 bytes past e */
+static ES_INLINE void wild_copy8(es_uint8_t *d, const es_uint8_t *s, es_uint8_t *e)
+{
+	do {
+		memcpy(d, s, 8);
+		d += 8;
+		s += 8;
+	} while (d < e);
+}
+
+static ES_INLINE es_uint8_t* put_length(es_uint8_t *op, es_int32_t n)
+{
+	for (; n >= 255; n -= 255) {
+		*op++ = 255;
+	}
+	*op++ = (es_uint8_t)n;
+	return op;
+}
+
+es_int32_t eso_lz4_compress(const void *src, es_int32_t srclen,
+		void *dst, es_int32_t dstcap, es_int32_t acceleration)
+{
+	es_uint32_t table[1 << (HASH_LOG + 1)];
+	const es_uint8_t *base = (const es_uint8_t *)src;
+	const es_uint8_t *ip = base;
+	const es_uint8_t *anchor = base;
+	const es_uint8_t *iend = base + srclen;
+	const es_uint8_t *mflimit = iend - MFLIMIT;
+	const es_uint8_t *matchlimit = iend - LASTLITERALS;
+	es_uint8_t *op = (es_uint8_t *)dst;
+	es_uint8_t *oend = op + dstcap;
+	es_uint32_t forward_hash;
+	es_int32_t run;
+	int hash_log = HASH_LOG;
+	int shift;
+
+	if (srclen < 0 || (es_uint32_t)srclen > ES_LZ4_MAX_INPUT_SIZE || dstcap <= 0) {
+		return 0;
+	}
+	if (acceleration < 1) {
+		acceleration = 1;
+	}
+	if (srclen < MFLIMIT + 1) {
+		goto last_literals;
+	}
+
+	/* a larger table for the 64KB blocks, a smaller one for the short
+	 * inputs so that clearing it doesn't cost more than the compression */
+	if (srclen <= 65536) {
+		hash_log++;
+	}
+	while (hash_log > 8 && (1 << (hash_log + 1)) > srclen) {
+		hash_log--;
+	}
+	shift = 32 - hash_log;
+	memset(table, 0, sizeof(es_uint32_t) << hash_log);
+	ip++;
+	forward_hash = hash_at(ip, shift);
+
+	for (;;) {
+		const es_uint8_t *match;
+		const es_uint8_t *forward = ip;
+		es_uint8_t *token;
+		es_uint32_t step = 1;
+		es_uint32_t misses = (es_uint32_t)acceleration << SKIP_TRIGGER;
+		es_int32_t len;
+
+		/* find a match, skipping faster and faster while there is none */
+		do {
+			es_uint32_t h = forward_hash;
+			ip = forward;
+			forward += step;
+			step = misses++ >> SKIP_TRIGGER;
+			if (forward > mflimit) {
+				goto last_literals;
+			}
+			match = base + table[h];
+			forward_hash = hash_at(forward, shift);
+			table[h] = (es_uint32_t)(ip - base);
+		} while (match + MAX_DISTANCE < ip || read32(match) != read32(ip));
+
+		/* extend it backwards */
+		while (ip > anchor && match > base && ip[-1] == match[-1]) {
+			ip--;
+			match--;
+		}
+
+		/* the literals */
+		run = (es_int32_t)(ip - anchor);
+		if (1 + run + run / 255 + 2 + 1 + LASTLITERALS > oend - op) {
+			return 0;
+		}
+		token = op++;
+		if (run >= RUN_MASK) {
+			*token = RUN_MASK << ML_BITS;
+			op = put_length(op, run - RUN_MASK);
+		} else {
+			*token = (es_uint8_t)(run << ML_BITS);
+		}
+		wild_copy8(op, anchor, op + run);
+		op += run;
+
+next_match:
+		/* the offset and the length of the match */
+		write16le(op, (es_uint32_t)(ip - match));
+		op += 2;
+		len = (es_int32_t)count_match(ip + MINMATCH, match + MINMATCH, matchlimit);
+		ip += MINMATCH + len;
+		if (len / 255 + 1 + 1 + LASTLITERALS > oend - op) {
+			return 0;
+		}
+		if (len >= ML_MASK) {
+			*token += ML_MASK;
+			op = put_length(op, len - ML_MASK);
+		} else {
+			*token += (es_uint8_t)len;
+		}
+		anchor = ip;
+		if (ip > mflimit) {
+			break;
+		}
+
+		table[hash_at(ip - 2, shift)] = (es_uint32_t)(ip - 2 - base);
+
+		/* another match right away, without literals */
+		{
+			es_uint32_t h = hash_at(ip, shift);
+			match = base + table[h];
+			table[h] = (es_uint32_t)(ip - base);
+			if (match + MAX_DISTANCE >= ip && read32(match) == read32(ip)) {
+				token = op++;
+				*token = 0;
+				goto next_match;
+			}
+		}
+
+		forward_hash = hash_at(++ip, shift);
+	}
+
+last_literals:
+	run = (es_int32_t)(iend - anchor);
+	if (1 + run + (run + 255 - RUN_MASK) / 255 > oend - op) {
+		return 0;
+	}
+	if (run >= RUN_MASK) {
+		*op++ = RUN_MASK << ML_BITS;
+		op = put_length(op, run - RUN_MASK);
+	} else {
+		*op++ = (es_uint8_t)(run << ML_BITS);
+	}
+	memcpy(op, anchor, run);
+	op += run;
+	return (es_int32_t)(op - (es_uint8_t *)dst);
+}
+
+static ES_INLINE int get_length(const es_uint8_t **pp, const es_uint8_t *iend,
+		es_uint32_t *len)
+{
+	const es_uint8_t *p = *pp;
+	es_uint32_t s;
+	do {
+		if (p >= iend) {
+			return -1;
+		}
+		s = *p++;
+		*len += s;
+		if (*len > ES_LZ4_MAX_INPUT_SIZE) {
+			return -1;
+		}
+	} while (s == 255);
+	*pp = p;
+	return 0;
+}
+
+/* copies 16 bytes at a time, up to 15 bytes past e */
+static ES_INLINE void wild_copy16(es_uint8_t *d, const es_uint8_t *s, es_uint8_t *e)
+{
+	do {
+		memcpy(d, s, 16);
+		d += 16;
+		s += 16;
+	} while (d < e);
+}
+
+/* copies len bytes from offset back, by chunks when they don't overlap */
+static ES_INLINE void copy_match(es_uint8_t *op, const es_uint8_t *match,
+		es_uint32_t len, const es_uint8_t *oend)
+{
+	es_uint8_t *end = op + len;
+	es_uint32_t offset = (es_uint32_t)(op - match);
+
+	if (offset >= 16 && oend - end >= 16) {
+		wild_copy16(op, match, end);
+	} else if (offset == 1) {
+		memset(op, *match, len);
+	} else if (oend - end >= 8) {
+		/* a short period is doubled until the chunks don't overlap */
+		while (offset < 8) {
+			if (len <= offset) {
+				memcpy(op, match, len);
+				return;
+			}
+			memcpy(op, match, offset);
+			op += offset;
+			len -= offset;
+			offset <<= 1;
+		}
+		wild_copy8(op, match, op + len);
+	} else {
+		while (op < end) {
+			*op++ = *match++;
+		}
+	}
+}
+
+static es_int32_t decompress_block(const es_uint8_t *ip, es_int32_t srclen,
+		es_uint8_t *dst, es_int32_t dstcap, const es_uint8_t *dict, es_int32_t dictlen)
+{
+	const es_uint8_t *iend = ip + srclen;
+	es_uint8_t *op = dst;
+	es_uint8_t *oend = dst + dstcap;
+
+	if (srclen <= 0 || dstcap < 0) {
+		return -1;
+	}
+
+	for (;;) {
+		es_uint32_t token, run, len, offset;
+		const es_uint8_t *match;
+
+		if (ip >= iend) {
+			return -1; /* a block ends with literals */
+		}
+		token = *ip++;
+		run = token >> ML_BITS;
+
+		/* a short sequence far from the ends: fixed size copies */
+		if (run != RUN_MASK && (token & ML_MASK) != ML_MASK &&
+				iend - ip >= 32 && oend - op >= 64) {
+			memcpy(op, ip, 16);
+			ip += run;
+			op += run;
+			offset = read16le(ip);
+			match = op - offset;
+			if (offset >= 8 && offset <= (es_uint32_t)(op - dst)) {
+				ip += 2;
+				memcpy(op, match, 8);
+				memcpy(op + 8, match + 8, 8);
+				memcpy(op + 16, match + 16, 2);
+				op += (token & ML_MASK) + MINMATCH;
+				continue;
+			}
+			goto read_match;
+		}
+
+		/* the literals */
+		if (run == RUN_MASK && get_length(&ip, iend, &run) < 0) {
+			return -1;
+		}
+		if (run > (es_uint32_t)(iend - ip) || run > (es_uint32_t)(oend - op)) {
+			return -1;
+		}
+		if (run <= 16 && iend - ip >= 16 && oend - op >= 16) {
+			memcpy(op, ip, 16);
+		} else if (iend - ip >= run + 16 && oend - op >= run + 16) {
+			wild_copy16(op, ip, op + run);
+		} else {
+			memcpy(op, ip, run);
+		}
+		ip += run;
+		op += run;
+		if (ip == iend) {
+			break;
+		}
+
+read_match:
+		/* the match */
+		if (iend - ip < 2) {
+			return -1;
+		}
+		offset = read16le(ip);
+		ip += 2;
+		len = token & ML_MASK;
+		if (len == ML_MASK && get_length(&ip, iend, &len) < 0) {
+			return -1;
+		}
+		len += MINMATCH;
+		if (offset == 0 || len > (es_uint32_t)(oend - op)) {
+			return -1;
+		}
+		if (offset > (es_uint32_t)(op - dst)) {
+			/* starts in the dictionary */
+			es_uint32_t back = offset - (es_uint32_t)(op - dst);
+			es_uint32_t n = (back < len) ? back : len;
+			if (back > (es_uint32_t)dictlen) {
+				return -1;
+			}
+			memcpy(op, dict + dictlen - back, n);
+			op += n;
+			len -= n;
+			if (len == 0) {
+				continue;
+			}
+		}
+		match = op - offset;
+		copy_match(op, match, len, oend);
+		op += len;
+	}
+
+	return (es_int32_t)(op - dst);
+}
+
+es_int32_t eso_lz4_decompress(const void *src, es_int32_t srclen,
+		void *dst, es_int32_t dstcap)
+{
+	return decompress_block((const es_uint8_t *)src, srclen,
+			(es_uint8_t *)dst, dstcap, NULL, 0);
+}
+
+es_int32_t eso_lz4_decompress_dict(const void *src, es_int32_t srclen,
+		void *dst, es_int32_t dstcap, const void *dict, es_int32_t dictlen)
+{
+	return decompress_block((const es_uint8_t *)src, srclen,
+			(es_uint8_t *)dst, dstcap, (const es_uint8_t *)dict, dict ? dictlen : 0);
+}
+
+//==============================================================================
+// frame
+
+es_int32_t eso_lz4f_block_id(es_int32_t size)
+{
+	es_int32_t id = 4;
+	while (id < 7 && size > (1 << (8 + 2 * id))) {
+		id++;
+	}
+	return id;
+}
+
+es_int32_t eso_lz4f_write_header(void *dst, const es_lz4f_info_t *info)
+{
+	es_uint8_t *p = (es_uint8_t *)dst;
+	es_uint8_t flg = 0x40; /* version 01 */
+	es_int32_t n = 6;
+
+	if (!info->block_linked) flg |= 0x20;
+	if (info->block_checksum) flg |= 0x10;
+	if (info->content_size >= 0) flg |= 0x08;
+	if (info->content_checksum) flg |= 0x04;
+	if (info->dict_id) flg |= 0x01;
+
+	write32le(p, ES_LZ4_FRAME_MAGIC);
+	p[4] = flg;
+	p[5] = (es_uint8_t)(eso_lz4f_block_id(info->block_size) << 4);
+	if (info->content_size >= 0) {
+		write32le(p + n, (es_uint32_t)info->content_size);
+		write32le(p + n + 4, (es_uint32_t)((es_uint64_t)info->content_size >> 32));
+		n += 8;
+	}
+	if (info->dict_id) {
+		write32le(p + n, info->dict_id);
+		n += 4;
+	}
+	p[n] = (es_uint8_t)(eso_xxh32(p + 4, n - 4, 0) >> 8);
+	return n + 1;
+}
+
+es_int32_t eso_lz4f_read_header(const void *src, es_int32_t len, es_lz4f_info_t *info)
+{
+	const es_uint8_t *p = (const es_uint8_t *)src;
+	es_uint32_t magic;
+	es_uint8_t flg, bd;
+	es_int32_t n;
+
+	if (len < 4) {
+		return 0;
+	}
+	magic = read32le(p);
+	if ((magic & 0xFFFFFFF0) == SKIPPABLE_MAGIC) {
+		if (len < 8) {
+			return 0;
+		}
+		memset(info, 0, sizeof(*info));
+		info->content_size = read32le(p + 4);
+		return 8;
+	}
+	if (magic != ES_LZ4_FRAME_MAGIC) {
+		return -1;
+	}
+	if (len < 7) {
+		return 0;
+	}
+	flg = p[4];
+	bd = p[5];
+	if ((flg >> 6) != 1 || (flg & 0x02) || (bd & 0x8F) || ((bd >> 4) & 7) < 4) {
+		return -1;
+	}
+	n = 6 + ((flg & 0x08) ? 8 : 0) + ((flg & 0x01) ? 4 : 0);
+	if (len < n + 1) {
+		return 0;
+	}
+	if (p[n] != (es_uint8_t)(eso_xxh32(p + 4, n - 4, 0) >> 8)) {
+		return -1;
+	}
+
+	info->block_size = 1 << (8 + 2 * ((bd >> 4) & 7));
+	info->block_linked = !(flg & 0x20);
+	info->block_checksum = (flg & 0x10) ? TRUE : FALSE;
+	info->content_checksum = (flg & 0x04) ? TRUE : FALSE;
+	info->content_size = -1;
+	info->dict_id = 0;
+	n = 6;
+	if (flg & 0x08) {
+		info->content_size = (es_int64_t)(((es_uint64_t)read32le(p + n + 4) << 32) | read32le(p + n));
+		n += 8;
+	}
+	if (flg & 0x01) {
+		info->dict_id = read32le(p + n);
+		n += 4;
+	}
+	return n + 1;
+}
+
+es_int64_t eso_lz4f_compress_bound(es_int64_t srclen)
+{
+	/* the blocks which don't shrink are stored */
+	return ES_LZ4_FRAME_HEADER_MAX + srclen + (srclen / FRAME_BLOCK + 1) * 4 + 8;
+}
+
+es_int64_t eso_lz4f_compress(const void *src, es_int64_t srclen,
+		void *dst, es_int64_t dstcap)
+{
+	const es_uint8_t *ip = (const es_uint8_t *)src;
+	const es_uint8_t *iend = ip + srclen;
+	es_uint8_t *op = (es_uint8_t *)dst;
+	es_uint8_t *oend = op + dstcap;
+	es_lz4f_info_t info;
+
+	if (srclen < 0 || dstcap < ES_LZ4_FRAME_HEADER_MAX) {
+		return 0;
+	}
+	info.block_size = FRAME_BLOCK;
+	info.block_linked = FALSE;
+	info.block_checksum = FALSE;
+	info.content_checksum = TRUE;
+	info.content_size = srclen;
+	info.dict_id = 0;
+	op += eso_lz4f_write_header(op, &info);
+
+	while (ip < iend) {
+		es_int32_t n = (iend - ip > FRAME_BLOCK) ? FRAME_BLOCK : (es_int32_t)(iend - ip);
+		es_int64_t room = oend - op - 4;
+		es_int32_t c = 0;
+		if (room > 0) {
+			c = eso_lz4_compress(ip, n, op + 4, (es_int32_t)((room < n) ? room : n - 1), 1);
+		}
+		if (c > 0) {
+			write32le(op, (es_uint32_t)c);
+			op += 4 + c;
+		} else {
+			if (room < n) {
+				return 0;
+			}
+			write32le(op, (es_uint32_t)n | 0x80000000U);
+			memcpy(op + 4, ip, n);
+			op += 4 + n;
+		}
+		ip += n;
+	}
+
+	if (oend - op < 8) {
+		return 0;
+	}
+	write32le(op, 0);
+	write32le(op + 4, eso_xxh32(src, (es_size_t)srclen, 0));
+	op += 8;
+	return op - (es_uint8_t *)dst;
+}
+
+es_int64_t eso_lz4f_decompress(const void *src, es_int64_t srclen,
+		void *dst, es_int64_t dstcap)
+{
+	const es_uint8_t *ip = (const es_uint8_t *)src;
+	const es_uint8_t *iend = ip + srclen;
+	es_uint8_t *op = (es_uint8_t *)dst;
+	es_uint8_t *oend = op + dstcap;
+
+	while (ip < iend) {
+		es_lz4f_info_t info;
+		es_uint8_t *start = op;
+		es_int32_t h = eso_lz4f_read_header(ip,
+				(es_int32_t)((iend - ip > 64) ? 64 : iend - ip), &info);
+
+		if (h <= 0) {
+			return -1;
+		}
+		ip += h;
+		if (info.block_size == 0) {
+			if (info.content_size > iend - ip) {
+				return -1;
+			}
+			ip += info.content_size;
+			continue;
+		}
+		if (info.dict_id) {
+			return -1;
+		}
+
+		for (;;) {
+			es_uint32_t size;
+			es_int32_t n, cap;
+			es_int32_t tail = info.block_checksum ? 4 : 0;
+
+			if (iend - ip < 4) {
+				return -1;
+			}
+			size = read32le(ip);
+			ip += 4;
+			if (size == 0) {
+				break;
+			}
+			n = (es_int32_t)(size & 0x7FFFFFFF);
+			if (n > info.block_size || n + tail > iend - ip) {
+				return -1;
+			}
+			if (tail && eso_xxh32(ip, n, 0) != read32le(ip + n)) {
+				return -1;
+			}
+			cap = (oend - op > info.block_size) ? info.block_size : (es_int32_t)(oend - op);
+			if (size & 0x80000000U) {
+				if (n > cap) {
+					return -1;
+				}
+				memcpy(op, ip, n);
+			} else if (info.block_linked) {
+				es_int32_t d = (op - start > MAX_DISTANCE) ? MAX_DISTANCE : (es_int32_t)(op - start);
+				n = decompress_block(ip, n, op, cap, op - d, d);
+			} else {
+				n = decompress_block(ip, n, op, cap, NULL, 0);
+			}
+			if (n < 0) {
+				return -1;
+			}
+			ip += (size & 0x7FFFFFFF) + tail;
+			op += n;
+		}
+
+		if (info.content_checksum) {
+			if (iend - ip < 4 || eso_xxh32(start, (es_size_t)(op - start), 0) != read32le(ip)) {
+				return -1;
+			}
+			ip += 4;
+		}
+		if (info.content_size >= 0 && info.content_size != op - start) {
+			return -1;
+		}
+	}
+
+	return op - (es_uint8_t *)dst;
+}
+
+//==============================================================================
+// xxHash32
+
+static ES_INLINE es_uint32_t rotl32(es_uint32_t x, int r)
+{
+	return (x << r) | (x >> (32 - r));
+}
+
+static ES_INLINE es_uint32_t xxh_round(es_uint32_t acc, es_uint32_t input)
+{
+	acc += input * PRIME32_2;
+	acc = rotl32(acc, 13);
+	return acc * PRIME32_1;
+}
+
+static es_uint32_t xxh_finish(es_uint32_t h, const es_uint8_t *p, es_size_t len)
+{
+	while (len >= 4) {
+		h += read32le(p) * PRIME32_3;
+		h = rotl32(h, 17) * PRIME32_4;
+		p += 4;
+		len -= 4;
+	}
+	while (len > 0) {
+		h += (*p++) * PRIME32_5;
+		h = rotl32(h, 11) * PRIME32_1;
+		len--;
+	}
+	h ^= h >> 15;
+	h *= PRIME32_2;
+	h ^= h >> 13;
+	h *= PRIME32_3;
+	h ^= h >> 16;
+	return h;
+}
+
+es_uint32_t eso_xxh32(const void *p, es_size_t len, es_uint32_t seed)
+{
+	const es_uint8_t *b = (const es_uint8_t *)p;
+	es_uint32_t h;
+
+	if (len >= 16) {
+		const es_uint8_t *limit = b + len - 16;
+		es_uint32_t v1 = seed + PRIME32_1 + PRIME32_2;
+		es_uint32_t v2 = seed + PRIME32_2;
+		es_uint32_t v3 = seed;
+		es_uint32_t v4 = seed - PRIME32_1;
+		do {
+			v1 = xxh_round(v1, read32le(b));
+			v2 = xxh_round(v2, read32le(b + 4));
+			v3 = xxh_round(v3, read32le(b + 8));
+			v4 = xxh_round(v4, read32le(b + 12));
+			b += 16;
+		} while (b <= limit);
+		h = rotl32(v1, 1) + rotl32(v2, 7) + rotl32(v3, 12) + rotl32(v4, 18);
+	} else {
+		h = seed + PRIME32_5;
+	}
+	h += (es_uint32_t)len;
+	return xxh_finish(h, b, len & 15);
+}
+
+void eso_xxh32_init(es_xxh32_t *state, es_uint32_t seed)
+{
+	state->total = 0;
+	state->v[0] = seed + PRIME32_1 + PRIME32_2;
+	state->v[1] = seed + PRIME32_2;
+	state->v[2] = seed;
+	state->v[3] = seed - PRIME32_1;
+	state->seed = seed;
+	state->memsize = 0;
+}
+
+static ES_INLINE void xxh_stripe(es_uint32_t v[4], const es_uint8_t *b)
+{
+	v[0] = xxh_round(v[0], read32le(b));
+	v[1] = xxh_round(v[1], read32le(b + 4));
+	v[2] = xxh_round(v[2], read32le(b + 8));
+	v[3] = xxh_round(v[3], read32le(b + 12));
+}
+
+void eso_xxh32_update(es_xxh32_t *state, const void *p, es_size_t len)
+{
+	const es_uint8_t *b = (const es_uint8_t *)p;
+
+	state->total += len;
+	if (state->memsize + len < 16) {
+		memcpy(state->mem + state->memsize, b, len);
+		state->memsize += (es_uint32_t)len;
+		return;
+	}
+	if (state->memsize) {
+		es_uint32_t fill = 16 - state->memsize;
+		memcpy(state->mem + state->memsize, b, fill);
+		xxh_stripe(state->v, state->mem);
+		b += fill;
+		len -= fill;
+		state->memsize = 0;
+	}
+	while (len >= 16) {
+		xxh_stripe(state->v, b);
+		b += 16;
+		len -= 16;
+	}
+	if (len) {
+		memcpy(state->mem, b, len);
+		state->memsize = (es_uint32_t)len;
+	}
+}
+
+es_uint32_t eso_xxh32_digest(const es_xxh32_t *state)
+{
+	es_uint32_t h;
+
+	if (state->total >= 16) {
+		h = rotl32(state->v[0], 1) + rotl32(state->v[1], 7) +
+				rotl32(state->v[2], 12) + rotl32(state->v[3], 18);
+	} else {
+		h = state->seed + PRIME32_5;
+	}
+	h += (es_uint32_t)state->total;
+	return xxh_finish(h, state->mem, state->memsize);
+}
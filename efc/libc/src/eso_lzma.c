@@ -175,6 +175,99 @@ es_int32_t eso_lzma_unzip(es_ostream_t *outStream,
 
 //==============================================================================
 
+/* thread safe, unlike g_Alloc which is set by each call */
+static ISzAlloc g_BlockAlloc = {SzAlloc, SzFree};
+
+static void lzma_block_props(CLzmaEncProps *props, es_int32_t level,
+		es_uint32_t reduceSize)
+{
+	int i;
+
+	LzmaEncProps_Init(props);
+	props->level = ES_MAX(0, ES_MIN(level, 9));
+	props->numThreads = 1;
+	LzmaEncProps_Normalize(props);
+
+	/* no need of a dictionary larger than the data, as the newer sdk */
+	if (reduceSize > 0) {
+		for (i = 11; i <= 30; i++) {
+			if (reduceSize <= ((es_uint32_t)2 << i)) {
+				reduceSize = (es_uint32_t)2 << i;
+				break;
+			}
+			if (reduceSize <= ((es_uint32_t)3 << i)) {
+				reduceSize = (es_uint32_t)3 << i;
+				break;
+			}
+		}
+		if (props->dictSize > reduceSize) {
+			props->dictSize = reduceSize;
+		}
+	}
+}
+
+es_int32_t eso_lzma_props(es_uint8_t props[ES_LZMA_PROPS_SIZE],
+                          es_int32_t level,
+                          es_uint32_t reduceSize)
+{
+	CLzmaEncProps p;
+	CLzmaEncHandle enc;
+	SizeT size = ES_LZMA_PROPS_SIZE;
+	SRes res;
+
+	lzma_block_props(&p, level, reduceSize);
+	enc = LzmaEnc_Create(&g_BlockAlloc);
+	if (enc == 0)
+		return ES_SZ_ERROR_MEM;
+	res = LzmaEnc_SetProps(enc, &p);
+	if (res == SZ_OK)
+		res = LzmaEnc_WriteProperties(enc, props, &size);
+	LzmaEnc_Destroy(enc, &g_BlockAlloc, &g_BlockAlloc);
+	return res;
+}
+
+es_int32_t eso_lzma_compress(void *dst, es_size_t *dstLen,
+                             const void *src, es_size_t srcLen,
+                             es_int32_t level,
+                             es_uint32_t reduceSize)
+{
+	CLzmaEncProps p;
+	Byte props[ES_LZMA_PROPS_SIZE];
+	SizeT propsSize = ES_LZMA_PROPS_SIZE;
+	SizeT outLen = *dstLen;
+	SRes res;
+
+	lzma_block_props(&p, level, reduceSize);
+	res = LzmaEncode((Byte*)dst, &outLen, (const Byte*)src, srcLen, &p,
+			props, &propsSize, 0, NULL, &g_BlockAlloc, &g_BlockAlloc);
+	*dstLen = (es_size_t)outLen;
+	return res;
+}
+
+es_int32_t eso_lzma_decompress(void *dst, es_size_t *dstLen,
+                               const void *src, es_size_t *srcLen,
+                               const es_uint8_t props[ES_LZMA_PROPS_SIZE])
+{
+	SizeT outLen = *dstLen;
+	SizeT inLen = *srcLen;
+	ELzmaStatus status;
+	SRes res;
+
+	res = LzmaDecode((Byte*)dst, &outLen, (const Byte*)src, &inLen, props,
+			ES_LZMA_PROPS_SIZE, LZMA_FINISH_END, &status, &g_BlockAlloc);
+	if (res == SZ_OK && outLen != *dstLen) {
+		res = ES_SZ_ERROR_DATA;
+	}
+	if (res == SZ_OK && status == LZMA_STATUS_NEEDS_MORE_INPUT) {
+		res = ES_SZ_ERROR_INPUT_EOF;
+	}
+	*dstLen = (es_size_t)outLen;
+	*srcLen = (es_size_t)inLen;
+	return res;
+}
+
+//==============================================================================
+
 typedef struct {
 	es_istream_t s;
 	es_file_t *file;
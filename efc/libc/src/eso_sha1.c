@@ -32,6 +32,14 @@
 #include "eso_sha1.h"
 #include "eso_base64.h"
 #include "eso_libc.h"
+#include "eso_cpu.h"
+
+#if ES_CPU_DISPATCH
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#endif
 
 /* a bit faster & bigger, if defined */
 #define UNROLL_LOOPS
@@ -62,14 +70,17 @@
 #define SHA_BLOCKSIZE           64
 
 
+#define GET_BE32(p)	(((es_uint32_t)(p)[0] << 24) | ((es_uint32_t)(p)[1] << 16) | \
+			 ((es_uint32_t)(p)[2] << 8) | (es_uint32_t)(p)[3])
+
 /* do SHA transformation */
-static void sha_transform(es_sha1_ctx_t *sha_info)
+static void sha_transform(es_uint32_t digest[5], const es_uint8_t *data)
 {
     int i;
     es_uint32_t temp, A, B, C, D, E, W[80];
 
     for (i = 0; i < 16; ++i) {
-	W[i] = sha_info->data[i];
+	W[i] = GET_BE32(data + 4 * i);
     }
     for (i = 16; i < 80; ++i) {
 	W[i] = W[i-3] ^ W[i-8] ^ W[i-14] ^ W[i-16];
@@ -77,11 +88,11 @@ static void sha_transform(es_sha1_ctx_t *sha_info)
 	W[i] = ROT32(W[i], 1);
 #endif /* USE_MODIFIED_SHA */
     }
-    A = sha_info->digest[0];
-    B = sha_info->digest[1];
-    C = sha_info->digest[2];
-    D = sha_info->digest[3];
-    E = sha_info->digest[4];
+    A = digest[0];
+    B = digest[1];
+    C = digest[2];
+    D = digest[3];
+    E = digest[4];
 #ifdef UNROLL_LOOPS
     FUNC(1, 0);  FUNC(1, 1);  FUNC(1, 2);  FUNC(1, 3);  FUNC(1, 4);
     FUNC(1, 5);  FUNC(1, 6);  FUNC(1, 7);  FUNC(1, 8);  FUNC(1, 9);
@@ -116,48 +127,102 @@ static void sha_transform(es_sha1_ctx_t *sha_info)
 	FUNC(4,i);
     }
 #endif /* !UNROLL_LOOPS */
-    sha_info->digest[0] += A;
-    sha_info->digest[1] += B;
-    sha_info->digest[2] += C;
-    sha_info->digest[3] += D;
-    sha_info->digest[4] += E;
+    digest[0] += A;
+    digest[1] += B;
+    digest[2] += C;
+    digest[3] += D;
+    digest[4] += E;
 }
 
-union endianTest {
-    long Long;
-    char Char[sizeof(long)];
-};
+#if ES_CPU_DISPATCH
+
+/*
+ * SHA-1 with the SHA extensions: sha1rnds4 does 4 rounds, sha1nexte
+ * derives E of the next 4 rounds, sha1msg1/sha1msg2 expand the message
+ * 4 words at a time.
+ */
+
+/* the next 4 words of the schedule into w0, from the previous 16 */
+#define SHANI_SCHED(w0, w1, w2, w3) \
+	w0 = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w0, w1), w2), w3)
+
+/* 4 rounds, e is the E of the rounds, next gets the A for the next E */
+#define SHANI_ROUNDS(f, w, e, next) \
+	e = _mm_sha1nexte_epu32(e, w); \
+	next = abcd; \
+	abcd = _mm_sha1rnds4_epu32(abcd, e, f)
 
-static char isLittleEndian(void)
+ES_CPU_TARGET("sha,sse4.1")
+static void sha1_shani(es_uint32_t digest[5], const es_uint8_t *p, es_size_t blocks)
 {
-    static union endianTest u;
-    u.Long = 1;
-    return (u.Char[0] == 1);
+	const __m128i mask = _mm_set_epi64x(ULLONG(0x0001020304050607), ULLONG(0x08090a0b0c0d0e0f));
+	__m128i abcd, abcd_save, e0, e0_save, e1, w0, w1, w2, w3;
+
+	abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)digest), 0x1B);
+	e0 = _mm_set_epi32((int)digest[4], 0, 0, 0);
+
+	while (blocks--) {
+		abcd_save = abcd;
+		e0_save = e0;
+
+		w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)p), mask);
+		w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 16)), mask);
+		w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 32)), mask);
+		w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 48)), mask);
+
+		/* rounds 0-3, E is given */
+		e0 = _mm_add_epi32(e0, w0);
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+		SHANI_ROUNDS(0, w1, e1, e0);
+		SHANI_ROUNDS(0, w2, e0, e1);
+		SHANI_ROUNDS(0, w3, e1, e0);
+		SHANI_SCHED(w0, w1, w2, w3); SHANI_ROUNDS(0, w0, e0, e1);
+
+		SHANI_SCHED(w1, w2, w3, w0); SHANI_ROUNDS(1, w1, e1, e0);
+		SHANI_SCHED(w2, w3, w0, w1); SHANI_ROUNDS(1, w2, e0, e1);
+		SHANI_SCHED(w3, w0, w1, w2); SHANI_ROUNDS(1, w3, e1, e0);
+		SHANI_SCHED(w0, w1, w2, w3); SHANI_ROUNDS(1, w0, e0, e1);
+		SHANI_SCHED(w1, w2, w3, w0); SHANI_ROUNDS(1, w1, e1, e0);
+
+		SHANI_SCHED(w2, w3, w0, w1); SHANI_ROUNDS(2, w2, e0, e1);
+		SHANI_SCHED(w3, w0, w1, w2); SHANI_ROUNDS(2, w3, e1, e0);
+		SHANI_SCHED(w0, w1, w2, w3); SHANI_ROUNDS(2, w0, e0, e1);
+		SHANI_SCHED(w1, w2, w3, w0); SHANI_ROUNDS(2, w1, e1, e0);
+		SHANI_SCHED(w2, w3, w0, w1); SHANI_ROUNDS(2, w2, e0, e1);
+
+		SHANI_SCHED(w3, w0, w1, w2); SHANI_ROUNDS(3, w3, e1, e0);
+		SHANI_SCHED(w0, w1, w2, w3); SHANI_ROUNDS(3, w0, e0, e1);
+		SHANI_SCHED(w1, w2, w3, w0); SHANI_ROUNDS(3, w1, e1, e0);
+		SHANI_SCHED(w2, w3, w0, w1); SHANI_ROUNDS(3, w2, e0, e1);
+		SHANI_SCHED(w3, w0, w1, w2); SHANI_ROUNDS(3, w3, e1, e0);
+
+		/* E of the next block from the A before the last 4 rounds */
+		e0 = _mm_sha1nexte_epu32(e0, e0_save);
+		abcd = _mm_add_epi32(abcd, abcd_save);
+		p += SHA_BLOCKSIZE;
+	}
+
+	_mm_storeu_si128((__m128i *)digest, _mm_shuffle_epi32(abcd, 0x1B));
+	digest[4] = (es_uint32_t)_mm_extract_epi32(e0, 3);
 }
 
-/* change endianness of data */
+#endif /* ES_CPU_DISPATCH */
 
-/* count is the number of bytes to do an endian flip */
-static void maybe_byte_reverse(es_uint32_t *buffer, int count)
+/* process whole blocks of big endian data */
+static void sha1_blocks(es_uint32_t digest[5], const es_uint8_t *p, es_size_t blocks)
 {
-    int i;
-    es_byte_t ct[4], *cp;
-
-    if (isLittleEndian()) {	/* do the swap only if it is little endian */
-	count /= sizeof(es_uint32_t);
-	cp = (es_byte_t *) buffer;
-	for (i = 0; i < count; ++i) {
-	    ct[0] = cp[0];
-	    ct[1] = cp[1];
-	    ct[2] = cp[2];
-	    ct[3] = cp[3];
-	    cp[0] = ct[3];
-	    cp[1] = ct[2];
-	    cp[2] = ct[1];
-	    cp[3] = ct[0];
-	    cp += sizeof(es_uint32_t);
+#if ES_CPU_DISPATCH
+	if (eso_cpu_has(ES_CPU_SHA | ES_CPU_SSE41)) {
+		sha1_shani(digest, p, blocks);
+		return;
+	}
+#endif
+	while (blocks--) {
+		sha_transform(digest, p);
+		p += SHA_BLOCKSIZE;
 	}
-    }
 }
 
 /* initialize the SHA digest */
@@ -198,18 +263,17 @@ void eso_sha1_update_binary(es_sha1_ctx_t *sha_info,
 		buffer += i;
 		sha_info->local += i;
 		if (sha_info->local == SHA_BLOCKSIZE) {
-			maybe_byte_reverse(sha_info->data, SHA_BLOCKSIZE);
-			sha_transform(sha_info);
+			sha1_blocks(sha_info->digest, (es_uint8_t *) sha_info->data, 1);
 		} else {
 			return;
 		}
 	}
-	while (count >= SHA_BLOCKSIZE) {
-		memcpy(sha_info->data, buffer, SHA_BLOCKSIZE);
-		buffer += SHA_BLOCKSIZE;
-		count -= SHA_BLOCKSIZE;
-		maybe_byte_reverse(sha_info->data, SHA_BLOCKSIZE);
-		sha_transform(sha_info);
+	if (count >= SHA_BLOCKSIZE) {
+		/* straight from the input, no copy */
+		i = count / SHA_BLOCKSIZE;
+		sha1_blocks(sha_info->digest, buffer, i);
+		buffer += i * SHA_BLOCKSIZE;
+		count -= i * SHA_BLOCKSIZE;
 	}
 	memcpy(sha_info->data, buffer, count);
 	sha_info->local = count;
@@ -227,25 +291,24 @@ void eso_sha1_final(unsigned char digest[ES_SHA1_DIGESTSIZE],
  {
 	int count, i, j;
 	es_uint32_t lo_bit_count, hi_bit_count, k;
+	es_uint8_t *data = (es_uint8_t *) sha_info->data;
 
 	lo_bit_count = sha_info->count_lo;
 	hi_bit_count = sha_info->count_hi;
 	count = (int) ((lo_bit_count >> 3) & 0x3f);
-	((es_byte_t *) sha_info->data)[count++] = 0x80;
+	data[count++] = 0x80;
 	if (count > SHA_BLOCKSIZE - 8) {
-		memset(((es_byte_t *) sha_info->data) + count, 0,
-				SHA_BLOCKSIZE - count);
-		maybe_byte_reverse(sha_info->data, SHA_BLOCKSIZE);
-		sha_transform(sha_info);
-		memset((es_byte_t *) sha_info->data, 0, SHA_BLOCKSIZE - 8);
+		memset(data + count, 0, SHA_BLOCKSIZE - count);
+		sha1_blocks(sha_info->digest, data, 1);
+		memset(data, 0, SHA_BLOCKSIZE - 8);
 	} else {
-		memset(((es_byte_t *) sha_info->data) + count, 0,
-				SHA_BLOCKSIZE - 8 - count);
+		memset(data + count, 0, SHA_BLOCKSIZE - 8 - count);
+	}
+	for (i = 0; i < 4; i++) {
+		data[56 + i] = (es_uint8_t) (hi_bit_count >> (24 - 8 * i));
+		data[60 + i] = (es_uint8_t) (lo_bit_count >> (24 - 8 * i));
 	}
-	maybe_byte_reverse(sha_info->data, SHA_BLOCKSIZE);
-	sha_info->data[14] = hi_bit_count;
-	sha_info->data[15] = lo_bit_count;
-	sha_transform(sha_info);
+	sha1_blocks(sha_info->digest, data, 1);
 
 	for (i = 0, j = 0; j < ES_SHA1_DIGESTSIZE; i++) {
 		k = sha_info->digest[i];
@@ -12,6 +12,14 @@
 
 #include "eso_sha2.h"
 #include "eso_libc.h"
+#include "eso_cpu.h"
+
+#if ES_CPU_DISPATCH
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#endif
 
 /*
  * ASSERT NOTE:
@@ -437,6 +445,83 @@ void SHA256_Transform(es_sha256_ctx_t* context, const sha2_word32* data) {
 
 #endif /* SHA2_UNROLL_TRANSFORM */
 
+#if ES_CPU_DISPATCH
+
+/*
+ * SHA-256 with the SHA extensions: the state is kept as ABEF and CDGH for
+ * sha256rnds2, which does 2 rounds, and sha256msg1/sha256msg2 expand the
+ * message 4 words at a time.
+ */
+
+/* the next 4 words of the schedule into w0, from the previous 16 */
+#define SHANI_SCHED(w0, w1, w2, w3) \
+        w0 = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w0, w1), \
+                _mm_alignr_epi8(w3, w2, 4)), w3)
+
+/* the rounds 4 * i to 4 * i + 3 */
+#define SHANI_ROUNDS(i, w) \
+        msg = _mm_add_epi32(w, _mm_loadu_si128((const __m128i *)&K256[4 * (i)])); \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg); \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E))
+
+ES_CPU_TARGET("sha,sse4.1")
+static void SHA256_Transform_SHANI(sha2_word32 state[8], const sha2_byte *p, es_size_t blocks) {
+        const __m128i mask = _mm_set_epi64x(ULLONG(0x0c0d0e0f08090a0b), ULLONG(0x0405060700010203));
+        __m128i state0, state1, save0, save1, msg, tmp, w0, w1, w2, w3;
+        int i;
+
+        tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xB1);    /* CDAB */
+        state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1B); /* EFGH */
+        state0 = _mm_alignr_epi8(tmp, state1, 8);                                       /* ABEF */
+        state1 = _mm_blend_epi16(state1, tmp, 0xF0);                                    /* CDGH */
+
+        while (blocks--) {
+                save0 = state0;
+                save1 = state1;
+
+                w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)p), mask);
+                w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 16)), mask);
+                w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 32)), mask);
+                w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 48)), mask);
+
+                SHANI_ROUNDS(0, w0);
+                SHANI_ROUNDS(1, w1);
+                SHANI_ROUNDS(2, w2);
+                SHANI_ROUNDS(3, w3);
+                for (i = 4; i < 16; i += 4) {
+                        SHANI_SCHED(w0, w1, w2, w3); SHANI_ROUNDS(i, w0);
+                        SHANI_SCHED(w1, w2, w3, w0); SHANI_ROUNDS(i + 1, w1);
+                        SHANI_SCHED(w2, w3, w0, w1); SHANI_ROUNDS(i + 2, w2);
+                        SHANI_SCHED(w3, w0, w1, w2); SHANI_ROUNDS(i + 3, w3);
+                }
+
+                state0 = _mm_add_epi32(state0, save0);
+                state1 = _mm_add_epi32(state1, save1);
+                p += SHA256_BLOCK_LENGTH;
+        }
+
+        tmp = _mm_shuffle_epi32(state0, 0x1B);                                          /* FEBA */
+        state1 = _mm_shuffle_epi32(state1, 0xB1);                                       /* DCHG */
+        _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(tmp, state1, 0xF0));    /* DCBA */
+        _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(state1, tmp, 8));       /* HGFE */
+}
+
+#endif /* ES_CPU_DISPATCH */
+
+/* Process whole blocks, from the buffer or straight from the input: */
+static void SHA256_Blocks(es_sha256_ctx_t* context, const sha2_byte *data, es_size_t blocks) {
+#if ES_CPU_DISPATCH
+        if (eso_cpu_has(ES_CPU_SHA | ES_CPU_SSE41)) {
+                SHA256_Transform_SHANI(context->state, data, blocks);
+                return;
+        }
+#endif
+        while (blocks--) {
+                SHA256_Transform(context, (const sha2_word32*)data);
+                data += SHA256_BLOCK_LENGTH;
+        }
+}
+
 void eso_sha256_update(es_sha256_ctx_t* context, const sha2_byte *data, es_size_t len) {
         unsigned int    freespace, usedspace;
 
@@ -460,7 +545,7 @@ void eso_sha256_update(es_sha256_ctx_t* context, const sha2_byte *data, es_size_
                         context->bitcount += freespace << 3;
                         len -= freespace;
                         data += freespace;
-                        SHA256_Transform(context, (sha2_word32*)context->buffer);
+                        SHA256_Blocks(context, context->buffer, 1);
                 } else {
                         /* The buffer is not yet full */
                         MEMCPY_BCOPY(&context->buffer[usedspace], data, len);
@@ -470,12 +555,13 @@ void eso_sha256_update(es_sha256_ctx_t* context, const sha2_byte *data, es_size_
                         return;
                 }
         }
-        while (len >= SHA256_BLOCK_LENGTH) {
+        if (len >= SHA256_BLOCK_LENGTH) {
                 /* Process as many complete blocks as we can */
-                SHA256_Transform(context, (sha2_word32*)data);
-                context->bitcount += SHA256_BLOCK_LENGTH << 3;
-                len -= SHA256_BLOCK_LENGTH;
-                data += SHA256_BLOCK_LENGTH;
+                es_size_t blocks = len / SHA256_BLOCK_LENGTH;
+                SHA256_Blocks(context, data, blocks);
+                context->bitcount += (sha2_word64)blocks * SHA256_BLOCK_LENGTH << 3;
+                len -= blocks * SHA256_BLOCK_LENGTH;
+                data += blocks * SHA256_BLOCK_LENGTH;
         }
         if (len > 0) {
                 /* There's left-overs, so save 'em */
@@ -513,7 +599,7 @@ void eso_sha256_final(sha2_byte digest[], es_sha256_ctx_t* context) {
                                         MEMSET_BZERO(&context->buffer[usedspace], SHA256_BLOCK_LENGTH - usedspace);
                                 }
                                 /* Do second-to-last transform: */
-                                SHA256_Transform(context, (sha2_word32*)context->buffer);
+                                SHA256_Blocks(context, context->buffer, 1);
 
                                 /* And set-up for the last transform: */
                                 MEMSET_BZERO(context->buffer, SHA256_SHORT_BLOCK_LENGTH);
@@ -529,7 +615,7 @@ void eso_sha256_final(sha2_byte digest[], es_sha256_ctx_t* context) {
                 *(sha2_word64*)&context->buffer[SHA256_SHORT_BLOCK_LENGTH] = context->bitcount;
 
                 /* Final transform: */
-                SHA256_Transform(context, (sha2_word32*)context->buffer);
+                SHA256_Blocks(context, context->buffer, 1);
 
 #ifndef __BIG_ENDIAN__
                 {
@@ -581,6 +667,222 @@ char* eso_sha256_data(const sha2_byte* data, es_size_t len, char digest[SHA256_D
         return eso_sha256_end(&context, digest);
 }
 
+/*** SHA-256 multi-buffer: ********************************************/
+#define MB_LANES        8
+
+#if ES_CPU_DISPATCH
+
+/*
+ * 8 independent messages in the 8 lanes of avx2 registers: the rounds are
+ * the plain ones on vectors, each lane working on its own block.
+ */
+
+#define V_ROTR(x, n)    _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define V_XOR3(x, y, z) _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+#define V_ADD(x, y)     _mm256_add_epi32(x, y)
+
+#define V_Sigma0(x)     V_XOR3(V_ROTR(x, 2), V_ROTR(x, 13), V_ROTR(x, 22))
+#define V_Sigma1(x)     V_XOR3(V_ROTR(x, 6), V_ROTR(x, 11), V_ROTR(x, 25))
+#define V_sigma0(x)     V_XOR3(V_ROTR(x, 7), V_ROTR(x, 18), _mm256_srli_epi32(x, 3))
+#define V_sigma1(x)     V_XOR3(V_ROTR(x, 17), V_ROTR(x, 19), _mm256_srli_epi32(x, 10))
+#define V_Ch(x, y, z)   _mm256_xor_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z))
+#define V_Maj(x, y, z)  _mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(z, _mm256_or_si256(x, y)))
+
+/* rows of 8 words to columns, the word i of every row into r[i] */
+ES_CPU_TARGET("avx2")
+static void transpose8x8(__m256i r[8]) {
+        __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+        __m256i u0, u1, u2, u3, u4, u5, u6, u7;
+
+        t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+        t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+        t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+        t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+        t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+        t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+        t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+        t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+        u0 = _mm256_unpacklo_epi64(t0, t2);
+        u1 = _mm256_unpackhi_epi64(t0, t2);
+        u2 = _mm256_unpacklo_epi64(t1, t3);
+        u3 = _mm256_unpackhi_epi64(t1, t3);
+        u4 = _mm256_unpacklo_epi64(t4, t6);
+        u5 = _mm256_unpackhi_epi64(t4, t6);
+        u6 = _mm256_unpacklo_epi64(t5, t7);
+        u7 = _mm256_unpackhi_epi64(t5, t7);
+        r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+        r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+        r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+        r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+        r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+        r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+        r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+        r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+/* one block of each lane, state[i] holds the word i of the 8 lanes */
+ES_CPU_TARGET("avx2")
+static void SHA256_Transform_AVX2_x8(sha2_word32 state[8][MB_LANES], const sha2_byte *p[MB_LANES]) {
+        const __m256i bswap = _mm256_set_epi8(
+                        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+        __m256i W[16], a, b, c, d, e, f, g, h, T1, T2, w;
+        int i, j;
+
+        for (j = 0; j < 2; j++) {
+                for (i = 0; i < MB_LANES; i++) {
+                        W[8 * j + i] = _mm256_loadu_si256((const __m256i *)(p[i] + 32 * j));
+                }
+                transpose8x8(W + 8 * j);
+                for (i = 0; i < 8; i++) {
+                        W[8 * j + i] = _mm256_shuffle_epi8(W[8 * j + i], bswap);
+                }
+        }
+
+        a = _mm256_loadu_si256((const __m256i *)state[0]);
+        b = _mm256_loadu_si256((const __m256i *)state[1]);
+        c = _mm256_loadu_si256((const __m256i *)state[2]);
+        d = _mm256_loadu_si256((const __m256i *)state[3]);
+        e = _mm256_loadu_si256((const __m256i *)state[4]);
+        f = _mm256_loadu_si256((const __m256i *)state[5]);
+        g = _mm256_loadu_si256((const __m256i *)state[6]);
+        h = _mm256_loadu_si256((const __m256i *)state[7]);
+
+        for (j = 0; j < 64; j++) {
+                if (j < 16) {
+                        w = W[j];
+                } else {
+                        w = W[j & 0x0f] = V_ADD(V_ADD(W[j & 0x0f], V_sigma0(W[(j + 1) & 0x0f])),
+                                        V_ADD(W[(j + 9) & 0x0f], V_sigma1(W[(j + 14) & 0x0f])));
+                }
+                T1 = V_ADD(V_ADD(V_ADD(h, V_Sigma1(e)), V_ADD(V_Ch(e, f, g), w)),
+                                _mm256_set1_epi32((int)K256[j]));
+                T2 = V_ADD(V_Sigma0(a), V_Maj(a, b, c));
+                h = g;
+                g = f;
+                f = e;
+                e = V_ADD(d, T1);
+                d = c;
+                c = b;
+                b = a;
+                a = V_ADD(T1, T2);
+        }
+
+#define V_STORE_ADD(i, x) \
+        _mm256_storeu_si256((__m256i *)state[i], V_ADD(x, _mm256_loadu_si256((const __m256i *)state[i])))
+        V_STORE_ADD(0, a);
+        V_STORE_ADD(1, b);
+        V_STORE_ADD(2, c);
+        V_STORE_ADD(3, d);
+        V_STORE_ADD(4, e);
+        V_STORE_ADD(5, f);
+        V_STORE_ADD(6, g);
+        V_STORE_ADD(7, h);
+#undef V_STORE_ADD
+}
+
+typedef struct {
+        int             msg;            /* the message, -1 if the lane is idle */
+        const sha2_byte *p;             /* the next block of the message */
+        es_size_t       blocks;         /* the whole blocks left */
+        int             tail;           /* the padding blocks left */
+        int             tails;
+        sha2_byte       buffer[2 * SHA256_BLOCK_LENGTH];
+} sha256_lane_t;
+
+static void sha256_lane_start(sha256_lane_t *lane, int msg, const sha2_byte *data, es_size_t len) {
+        es_size_t rest = len % SHA256_BLOCK_LENGTH;
+        sha2_word64 bits = (sha2_word64)len << 3;
+        int end, i;
+
+        lane->msg = msg;
+        lane->p = data;
+        lane->blocks = len / SHA256_BLOCK_LENGTH;
+        lane->tails = lane->tail = (rest < SHA256_SHORT_BLOCK_LENGTH) ? 1 : 2;
+
+        /* the rest of the message and the padding */
+        end = lane->tails * SHA256_BLOCK_LENGTH;
+        MEMCPY_BCOPY(lane->buffer, data + len - rest, rest);
+        lane->buffer[rest] = 0x80;
+        MEMSET_BZERO(lane->buffer + rest + 1, end - 8 - (rest + 1));
+        for (i = 0; i < 8; i++) {
+                lane->buffer[end - 1 - i] = (sha2_byte)(bits >> (8 * i));
+        }
+}
+
+static void sha256_mb_avx2(const es_byte_t *data[], const es_size_t len[],
+                es_byte_t digest[][SHA256_DIGEST_LENGTH], int n) {
+        static const sha2_byte idle[SHA256_BLOCK_LENGTH] = {0};
+        sha2_word32 state[8][MB_LANES];
+        sha256_lane_t lanes[MB_LANES];
+        const sha2_byte *p[MB_LANES];
+        int next = 0, active = 0, i, j;
+
+        for (i = 0; i < MB_LANES; i++) {
+                lanes[i].msg = -1;
+        }
+        for (;;) {
+                for (i = 0; i < MB_LANES; i++) {
+                        sha256_lane_t *lane = &lanes[i];
+                        if (lane->msg >= 0 && lane->blocks == 0 && lane->tail == 0) {
+                                for (j = 0; j < 8; j++) {
+                                        sha2_byte *d = digest[lane->msg] + 4 * j;
+                                        d[0] = (sha2_byte)(state[j][i] >> 24);
+                                        d[1] = (sha2_byte)(state[j][i] >> 16);
+                                        d[2] = (sha2_byte)(state[j][i] >> 8);
+                                        d[3] = (sha2_byte)state[j][i];
+                                }
+                                lane->msg = -1;
+                                active--;
+                        }
+                        if (lane->msg < 0 && next < n) {
+                                sha256_lane_start(lane, next, data[next], len[next]);
+                                for (j = 0; j < 8; j++) {
+                                        state[j][i] = sha256_initial_hash_value[j];
+                                }
+                                next++;
+                                active++;
+                        }
+                        if (lane->msg < 0) {
+                                p[i] = idle;
+                        } else if (lane->blocks > 0) {
+                                p[i] = lane->p;
+                                lane->p += SHA256_BLOCK_LENGTH;
+                                lane->blocks--;
+                        } else {
+                                p[i] = lane->buffer + (lane->tails - lane->tail) * SHA256_BLOCK_LENGTH;
+                                lane->tail--;
+                        }
+                }
+                if (active == 0) {
+                        break;
+                }
+                SHA256_Transform_AVX2_x8(state, p);
+        }
+}
+
+#endif /* ES_CPU_DISPATCH */
+
+void eso_sha256_mb(const es_byte_t *data[], const es_size_t len[],
+                   es_byte_t digest[][SHA256_DIGEST_LENGTH], int n) {
+        es_sha256_ctx_t context;
+        int             i;
+
+#if ES_CPU_DISPATCH
+        /* the sha extensions are faster on a single message */
+        if (n >= MB_LANES / 2 && !eso_cpu_has(ES_CPU_SHA | ES_CPU_SSE41) &&
+                        eso_cpu_has(ES_CPU_AVX2)) {
+                sha256_mb_avx2(data, len, digest, n);
+                return;
+        }
+#endif
+        for (i = 0; i < n; i++) {
+                eso_sha256_init(&context);
+                eso_sha256_update(&context, data[i], len[i]);
+                eso_sha256_final(digest[i], &context);
+        }
+}
+
 
 /*** SHA-512: *********************************************************/
 void eso_sha512_init(es_sha512_ctx_t* context) {
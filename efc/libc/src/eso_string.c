@@ -7,6 +7,7 @@
 #include "eso_libc.h"
 #include "eso_mem.h"
 #include "eso_printf_upper_bound.h"
+#include "eso_strsimd.h"
 
 /**
  * All possible chars for representing a number as a String
@@ -515,7 +516,8 @@ es_string_t* eso_mstrreplace_off(es_string_t **string,
 es_string_t* eso_mstrsplit(char *from, const char *separators,
                            es_size_t pos, es_string_t **to)
 {
-	char *pstart, *pend, *p;
+	es_size_t len, slen, start;
+	es_ssize_t r;
 	es_uint32_t i;
 
 	if (!from) {
@@ -527,28 +529,20 @@ es_string_t* eso_mstrsplit(char *from, const char *separators,
 		return NULL;
 	}
 	
-	pstart = from;
-	pend = from + eso_strlen(from);
+	len = eso_strlen(from);
+	slen = eso_strlen(separators);
+	start = 0;
 
-	i = 0;
-	while (pstart) {
-		i++;
-		p = eso_strstr(pstart, separators);
-		if (!p) {
-			if (i == pos) {
-				eso_mstrcpy(to, pstart);
-
-				break;
-			}
-			else
-				return NULL;
-		}
+	for (i = 1; ; i++) {
+		r = eso_strsimd_find(from + start, len - start, separators, slen);
 		if (i == pos) {
-			eso_mstrncpy(to, pstart, ES_MIN(p-pstart, pend-pstart));
-
+			eso_mstrncpy(to, from + start, (r < 0) ? len - start : (es_size_t)r);
 			break;
 		}
-		pstart = p + eso_strlen(separators);
+		if (r < 0) {
+			return NULL;
+		}
+		start += r + slen;
 	}
 	
 	if (*to)
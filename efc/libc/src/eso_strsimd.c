@@ -0,0 +1,730 @@
+/**
+ * @file  eso_strsimd.c
+ * @brief ES byte string kernels with SSE2/SSE4.2/AVX2 runtime dispatch
+ */
+
+#include "eso_strsimd.h"
+#include "eso_cpu.h"
+#include <string.h>
+
+#if ES_CPU_DISPATCH
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <emmintrin.h>
+#include <nmmintrin.h>
+#include <immintrin.h>
+#endif
+
+/* short inputs aren't worth the vector setup */
+#define SIMD_MIN_LEN     16
+
+#define ASCII_LOWER(c)   ((unsigned int)((c) - 'A') < 26u ? (c) + ('a' - 'A') : (c))
+#define ASCII_UPPER(c)   ((unsigned int)((c) - 'a') < 26u ? (c) - ('a' - 'A') : (c))
+
+//==============================================================================
+// portable kernels
+
+static es_ssize_t find_scalar(const char *s, es_size_t n, const char *p,
+		es_size_t m, es_size_t from)
+{
+	const char *e = s + n - m;
+	const char *q = s + from;
+
+	while (q <= e) {
+		q = (const char *)memchr(q, p[0], e - q + 1);
+		if (!q) {
+			return -1;
+		}
+		if (memcmp(q + 1, p + 1, m - 1) == 0) {
+			return q - s;
+		}
+		q++;
+	}
+	return -1;
+}
+
+/* search the start positions [0, end) backward */
+static es_ssize_t rfind_scalar(const char *s, const char *p, es_size_t m,
+		es_size_t end)
+{
+	while (end-- > 0) {
+		if (s[end] == p[0] && memcmp(s + end + 1, p + 1, m - 1) == 0) {
+			return end;
+		}
+	}
+	return -1;
+}
+
+static es_ssize_t rfindchr_scalar(const char *s, es_size_t end, char c)
+{
+	while (end-- > 0) {
+		if (s[end] == c) {
+			return end;
+		}
+	}
+	return -1;
+}
+
+static es_ssize_t findset_scalar(const char *s, es_size_t n,
+		const char *set, es_size_t setlen, es_bool_t in_set, es_size_t from)
+{
+	es_uint32_t bits[8] = {0};
+	es_uint32_t want = in_set ? 1 : 0;
+	es_size_t i;
+
+	for (i = 0; i < setlen; i++) {
+		unsigned char c = (unsigned char)set[i];
+		bits[c >> 5] |= (1u << (c & 31));
+	}
+	for (i = from; i < n; i++) {
+		unsigned char c = (unsigned char)s[i];
+		if (((bits[c >> 5] >> (c & 31)) & 1) == want) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/* first index where the lower case bytes differ, n if none */
+static es_size_t mismatch_icase_scalar(const char *a, const char *b,
+		es_size_t n, es_size_t from)
+{
+	es_size_t i;
+	for (i = from; i < n; i++) {
+		unsigned char c1 = (unsigned char)a[i];
+		unsigned char c2 = (unsigned char)b[i];
+		if (c1 != c2 && ASCII_LOWER(c1) != ASCII_LOWER(c2)) {
+			return i;
+		}
+	}
+	return n;
+}
+
+static void tolower_scalar(char *s, es_size_t n)
+{
+	es_size_t i;
+	for (i = 0; i < n; i++) {
+		unsigned char c = (unsigned char)s[i];
+		s[i] = (char)ASCII_LOWER(c);
+	}
+}
+
+static void toupper_scalar(char *s, es_size_t n)
+{
+	es_size_t i;
+	for (i = 0; i < n; i++) {
+		unsigned char c = (unsigned char)s[i];
+		s[i] = (char)ASCII_UPPER(c);
+	}
+}
+
+/* length of the valid multi-byte sequence at s[i], 0 if malformed */
+static es_size_t utf8_sequence(const unsigned char *s, es_size_t n, es_size_t i)
+{
+	unsigned char c = s[i];
+	unsigned char lo = 0x80, hi = 0xBF;
+	es_size_t len, k;
+
+	if (c < 0xC2) {
+		return 0; // continuation byte or overlong 2 bytes form
+	} else if (c < 0xE0) {
+		len = 2;
+	} else if (c < 0xF0) {
+		len = 3;
+		if (c == 0xE0) lo = 0xA0;      // overlong
+		else if (c == 0xED) hi = 0x9F; // surrogates
+	} else if (c < 0xF5) {
+		len = 4;
+		if (c == 0xF0) lo = 0x90;      // overlong
+		else if (c == 0xF4) hi = 0x8F; // > U+10FFFF
+	} else {
+		return 0;
+	}
+
+	if (n - i < len) {
+		return 0;
+	}
+	if (s[i + 1] < lo || s[i + 1] > hi) {
+		return 0;
+	}
+	for (k = 2; k < len; k++) {
+		if ((s[i + k] & 0xC0) != 0x80) {
+			return 0;
+		}
+	}
+	return len;
+}
+
+static es_uint32_t hash31_scalar(es_uint32_t h, const char *s, es_size_t n)
+{
+	const es_uint32_t p2 = 31 * 31, p3 = p2 * 31, p4 = p3 * 31;
+	es_size_t i = 0;
+
+	// 4 bytes per multiply chain step
+	for (; i + 4 <= n; i += 4) {
+		h = h * p4 + (es_uint32_t)(es_int32_t)(signed char)s[i] * p3
+				+ (es_uint32_t)(es_int32_t)(signed char)s[i + 1] * p2
+				+ (es_uint32_t)(es_int32_t)(signed char)s[i + 2] * 31
+				+ (es_uint32_t)(es_int32_t)(signed char)s[i + 3];
+	}
+	for (; i < n; i++) {
+		h = h * 31 + (es_uint32_t)(es_int32_t)(signed char)s[i];
+	}
+	return h;
+}
+
+//==============================================================================
+// x86 kernels
+
+#if ES_CPU_DISPATCH
+
+static ES_INLINE int ctz32(es_uint32_t x)
+{
+#ifdef _MSC_VER
+	unsigned long r;
+	_BitScanForward(&r, x);
+	return (int)r;
+#else
+	return __builtin_ctz(x);
+#endif
+}
+
+static ES_INLINE int bsr32(es_uint32_t x)
+{
+#ifdef _MSC_VER
+	unsigned long r;
+	_BitScanReverse(&r, x);
+	return (int)r;
+#else
+	return 31 - __builtin_clz(x);
+#endif
+}
+
+/*
+ * Substring search: compare the first and the last pattern byte at 16/32
+ * positions at once, memcmp() only the candidates.
+ */
+
+ES_CPU_TARGET("sse2")
+static es_ssize_t find_sse2(const char *s, es_size_t n, const char *p, es_size_t m)
+{
+	const __m128i first = _mm_set1_epi8(p[0]);
+	const __m128i last = _mm_set1_epi8(p[m - 1]);
+	es_size_t i;
+
+	for (i = 0; i + m + 15 <= n; i += 16) {
+		__m128i bf = _mm_loadu_si128((const __m128i *)(s + i));
+		__m128i bl = _mm_loadu_si128((const __m128i *)(s + i + m - 1));
+		es_uint32_t mask = (es_uint32_t)_mm_movemask_epi8(
+				_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl)));
+		while (mask) {
+			int bit = ctz32(mask);
+			if (memcmp(s + i + bit + 1, p + 1, m - 2) == 0) {
+				return i + bit;
+			}
+			mask &= mask - 1;
+		}
+	}
+	return find_scalar(s, n, p, m, i);
+}
+
+ES_CPU_TARGET("avx2")
+static es_ssize_t find_avx2(const char *s, es_size_t n, const char *p, es_size_t m)
+{
+	const __m256i first = _mm256_set1_epi8(p[0]);
+	const __m256i last = _mm256_set1_epi8(p[m - 1]);
+	es_size_t i;
+
+	for (i = 0; i + m + 31 <= n; i += 32) {
+		__m256i bf = _mm256_loadu_si256((const __m256i *)(s + i));
+		__m256i bl = _mm256_loadu_si256((const __m256i *)(s + i + m - 1));
+		es_uint32_t mask = (es_uint32_t)_mm256_movemask_epi8(
+				_mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(last, bl)));
+		while (mask) {
+			int bit = ctz32(mask);
+			if (memcmp(s + i + bit + 1, p + 1, m - 2) == 0) {
+				return i + bit;
+			}
+			mask &= mask - 1;
+		}
+	}
+	return find_scalar(s, n, p, m, i);
+}
+
+ES_CPU_TARGET("sse2")
+static es_ssize_t rfind_sse2(const char *s, es_size_t n, const char *p, es_size_t m)
+{
+	const __m128i first = _mm_set1_epi8(p[0]);
+	const __m128i last = _mm_set1_epi8(p[m - 1]);
+	es_size_t end = n - m + 1;
+
+	while (end >= 16) {
+		es_size_t base = end - 16;
+		__m128i bf = _mm_loadu_si128((const __m128i *)(s + base));
+		__m128i bl = _mm_loadu_si128((const __m128i *)(s + base + m - 1));
+		es_uint32_t mask = (es_uint32_t)_mm_movemask_epi8(
+				_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl)));
+		while (mask) {
+			int bit = bsr32(mask);
+			if (memcmp(s + base + bit + 1, p + 1, m - 2) == 0) {
+				return base + bit;
+			}
+			mask &= ~(1u << bit);
+		}
+		end = base;
+	}
+	return rfind_scalar(s, p, m, end);
+}
+
+ES_CPU_TARGET("avx2")
+static es_ssize_t rfind_avx2(const char *s, es_size_t n, const char *p, es_size_t m)
+{
+	const __m256i first = _mm256_set1_epi8(p[0]);
+	const __m256i last = _mm256_set1_epi8(p[m - 1]);
+	es_size_t end = n - m + 1;
+
+	while (end >= 32) {
+		es_size_t base = end - 32;
+		__m256i bf = _mm256_loadu_si256((const __m256i *)(s + base));
+		__m256i bl = _mm256_loadu_si256((const __m256i *)(s + base + m - 1));
+		es_uint32_t mask = (es_uint32_t)_mm256_movemask_epi8(
+				_mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(last, bl)));
+		while (mask) {
+			int bit = bsr32(mask);
+			if (memcmp(s + base + bit + 1, p + 1, m - 2) == 0) {
+				return base + bit;
+			}
+			mask &= ~(1u << bit);
+		}
+		end = base;
+	}
+	return rfind_scalar(s, p, m, end);
+}
+
+ES_CPU_TARGET("sse2")
+static es_ssize_t rfindchr_sse2(const char *s, es_size_t n, char c)
+{
+	const __m128i vc = _mm_set1_epi8(c);
+
+	while (n >= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(s + n - 16));
+		es_uint32_t mask = (es_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, vc));
+		if (mask) {
+			return n - 16 + bsr32(mask);
+		}
+		n -= 16;
+	}
+	return rfindchr_scalar(s, n, c);
+}
+
+ES_CPU_TARGET("avx2")
+static es_ssize_t rfindchr_avx2(const char *s, es_size_t n, char c)
+{
+	const __m256i vc = _mm256_set1_epi8(c);
+
+	while (n >= 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(s + n - 32));
+		es_uint32_t mask = (es_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, vc));
+		if (mask) {
+			return n - 32 + bsr32(mask);
+		}
+		n -= 32;
+	}
+	return rfindchr_scalar(s, n, c);
+}
+
+/*
+ * Delimiter set scanning with pcmpestri, up to 16 set bytes.
+ */
+ES_CPU_TARGET("sse4.2")
+static es_ssize_t findset_sse42(const char *s, es_size_t n,
+		const char *set, es_size_t setlen, es_bool_t in_set)
+{
+	char buf[16] = {0};
+	__m128i vset;
+	es_size_t i = 0;
+
+	memcpy(buf, set, setlen);
+	vset = _mm_loadu_si128((const __m128i *)buf);
+
+	if (in_set) {
+		for (; i + 16 <= n; i += 16) {
+			__m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+			int r = _mm_cmpestri(vset, (int)setlen, v, 16,
+					_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+			if (r < 16) {
+				return i + r;
+			}
+		}
+	} else {
+		for (; i + 16 <= n; i += 16) {
+			__m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+			int r = _mm_cmpestri(vset, (int)setlen, v, 16,
+					_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_NEGATIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT);
+			if (r < 16) {
+				return i + r;
+			}
+		}
+	}
+	return findset_scalar(s, n, set, setlen, in_set, i);
+}
+
+/*
+ * ASCII case folding: (x - 'A') < 26 unsigned is tested as a signed compare
+ * of (x + 0x80 - 'A') < (0x80 + 26 - 256).
+ */
+#define CASE_OFFSET_LOWER  ((char)(0x80 - 'A'))
+#define CASE_OFFSET_UPPER  ((char)(0x80 - 'a'))
+#define CASE_LIMIT         ((char)(-128 + 26))
+
+ES_CPU_TARGET("sse2")
+static es_size_t mismatch_icase_sse2(const char *a, const char *b, es_size_t n)
+{
+	const __m128i off = _mm_set1_epi8(CASE_OFFSET_LOWER);
+	const __m128i lim = _mm_set1_epi8(CASE_LIMIT);
+	const __m128i bit = _mm_set1_epi8(0x20);
+	es_size_t i;
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		__m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+		__m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+		__m128i la = _mm_add_epi8(va, _mm_and_si128(_mm_cmpgt_epi8(lim, _mm_add_epi8(va, off)), bit));
+		__m128i lb = _mm_add_epi8(vb, _mm_and_si128(_mm_cmpgt_epi8(lim, _mm_add_epi8(vb, off)), bit));
+		es_uint32_t mask = (es_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(la, lb)) ^ 0xFFFF;
+		if (mask) {
+			return i + ctz32(mask);
+		}
+	}
+	return mismatch_icase_scalar(a, b, n, i);
+}
+
+ES_CPU_TARGET("avx2")
+static es_size_t mismatch_icase_avx2(const char *a, const char *b, es_size_t n)
+{
+	const __m256i off = _mm256_set1_epi8(CASE_OFFSET_LOWER);
+	const __m256i lim = _mm256_set1_epi8(CASE_LIMIT);
+	const __m256i bit = _mm256_set1_epi8(0x20);
+	es_size_t i;
+
+	for (i = 0; i + 32 <= n; i += 32) {
+		__m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+		__m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+		__m256i la = _mm256_add_epi8(va, _mm256_and_si256(_mm256_cmpgt_epi8(lim, _mm256_add_epi8(va, off)), bit));
+		__m256i lb = _mm256_add_epi8(vb, _mm256_and_si256(_mm256_cmpgt_epi8(lim, _mm256_add_epi8(vb, off)), bit));
+		es_uint32_t mask = ~(es_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(la, lb));
+		if (mask) {
+			return i + ctz32(mask);
+		}
+	}
+	return mismatch_icase_scalar(a, b, n, i);
+}
+
+ES_CPU_TARGET("sse2")
+static es_size_t casemap_sse2(char *s, es_size_t n, char offset, int upper)
+{
+	const __m128i off = _mm_set1_epi8(offset);
+	const __m128i lim = _mm_set1_epi8(CASE_LIMIT);
+	const __m128i bit = _mm_set1_epi8(0x20);
+	es_size_t i;
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+		__m128i d = _mm_and_si128(_mm_cmpgt_epi8(lim, _mm_add_epi8(v, off)), bit);
+		v = upper ? _mm_sub_epi8(v, d) : _mm_add_epi8(v, d);
+		_mm_storeu_si128((__m128i *)(s + i), v);
+	}
+	return i;
+}
+
+ES_CPU_TARGET("avx2")
+static es_size_t casemap_avx2(char *s, es_size_t n, char offset, int upper)
+{
+	const __m256i off = _mm256_set1_epi8(offset);
+	const __m256i lim = _mm256_set1_epi8(CASE_LIMIT);
+	const __m256i bit = _mm256_set1_epi8(0x20);
+	es_size_t i;
+
+	for (i = 0; i + 32 <= n; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(s + i));
+		__m256i d = _mm256_and_si256(_mm256_cmpgt_epi8(lim, _mm256_add_epi8(v, off)), bit);
+		v = upper ? _mm256_sub_epi8(v, d) : _mm256_add_epi8(v, d);
+		_mm256_storeu_si256((__m256i *)(s + i), v);
+	}
+	return i;
+}
+
+/* length of the leading ASCII run, scanned in whole blocks only */
+ES_CPU_TARGET("sse2")
+static es_size_t ascii_prefix_sse2(const char *s, es_size_t n)
+{
+	es_size_t i;
+	for (i = 0; i + 16 <= n; i += 16) {
+		es_uint32_t mask = (es_uint32_t)_mm_movemask_epi8(
+				_mm_loadu_si128((const __m128i *)(s + i)));
+		if (mask) {
+			return i + ctz32(mask);
+		}
+	}
+	return i;
+}
+
+ES_CPU_TARGET("avx2")
+static es_size_t ascii_prefix_avx2(const char *s, es_size_t n)
+{
+	es_size_t i;
+	for (i = 0; i + 32 <= n; i += 32) {
+		es_uint32_t mask = (es_uint32_t)_mm256_movemask_epi8(
+				_mm256_loadu_si256((const __m256i *)(s + i)));
+		if (mask) {
+			return i + ctz32(mask);
+		}
+	}
+	return i;
+}
+
+/*
+ * 16 lanes of the hash loop in two vectors: after k rounds lane j holds
+ * sum(c[16r+j] * 31^(16(k-1-r))), finally weighted by 31^(15-j).
+ */
+ES_CPU_TARGET("avx2")
+static es_uint32_t hash31_avx2(es_uint32_t h, const char *s, es_size_t n, es_size_t *done)
+{
+	es_uint32_t pw[16];
+	es_uint32_t p16, sum;
+	__m256i acc0 = _mm256_setzero_si256();
+	__m256i acc1 = _mm256_setzero_si256();
+	__m256i vp16, t;
+	__m128i x;
+	es_size_t i;
+	int j;
+
+	pw[15] = 1;
+	for (j = 14; j >= 0; j--) {
+		pw[j] = pw[j + 1] * 31;
+	}
+	p16 = pw[0] * 31;
+	vp16 = _mm256_set1_epi32((int)p16);
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		__m128i b = _mm_loadu_si128((const __m128i *)(s + i));
+		acc0 = _mm256_add_epi32(_mm256_mullo_epi32(acc0, vp16), _mm256_cvtepi8_epi32(b));
+		acc1 = _mm256_add_epi32(_mm256_mullo_epi32(acc1, vp16),
+				_mm256_cvtepi8_epi32(_mm_srli_si128(b, 8)));
+		h *= p16;
+	}
+
+	acc0 = _mm256_mullo_epi32(acc0, _mm256_loadu_si256((const __m256i *)pw));
+	acc1 = _mm256_mullo_epi32(acc1, _mm256_loadu_si256((const __m256i *)(pw + 8)));
+	t = _mm256_add_epi32(acc0, acc1);
+	x = _mm_add_epi32(_mm256_castsi256_si128(t), _mm256_extracti128_si256(t, 1));
+	x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+	x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+	sum = (es_uint32_t)_mm_cvtsi128_si32(x);
+
+	*done = i;
+	return h + sum;
+}
+
+#endif //!ES_CPU_DISPATCH
+
+//==============================================================================
+
+es_ssize_t eso_strsimd_find(const char *s, es_size_t n, const char *p, es_size_t m)
+{
+	if (m == 0) {
+		return 0;
+	}
+	if (m > n) {
+		return -1;
+	}
+	if (m == 1) {
+		return eso_strsimd_findchr(s, n, p[0]);
+	}
+#if ES_CPU_DISPATCH
+	if (n >= SIMD_MIN_LEN + m) {
+		es_uint32_t f = eso_cpu_features();
+		if (f & ES_CPU_AVX2) {
+			return find_avx2(s, n, p, m);
+		}
+		if (f & ES_CPU_SSE2) {
+			return find_sse2(s, n, p, m);
+		}
+	}
+#endif
+	return find_scalar(s, n, p, m, 0);
+}
+
+es_ssize_t eso_strsimd_rfind(const char *s, es_size_t n, const char *p, es_size_t m)
+{
+	if (m == 0) {
+		return n;
+	}
+	if (m > n) {
+		return -1;
+	}
+	if (m == 1) {
+		return eso_strsimd_rfindchr(s, n, p[0]);
+	}
+#if ES_CPU_DISPATCH
+	if (n >= SIMD_MIN_LEN + m) {
+		es_uint32_t f = eso_cpu_features();
+		if (f & ES_CPU_AVX2) {
+			return rfind_avx2(s, n, p, m);
+		}
+		if (f & ES_CPU_SSE2) {
+			return rfind_sse2(s, n, p, m);
+		}
+	}
+#endif
+	return rfind_scalar(s, p, m, n - m + 1);
+}
+
+es_ssize_t eso_strsimd_findchr(const char *s, es_size_t n, int c)
+{
+	// the libc memchr() is already vectorized
+	const char *q = (const char *)memchr(s, c, n);
+	return q ? (q - s) : -1;
+}
+
+es_ssize_t eso_strsimd_rfindchr(const char *s, es_size_t n, int c)
+{
+#if ES_CPU_DISPATCH
+	if (n >= SIMD_MIN_LEN) {
+		es_uint32_t f = eso_cpu_features();
+		if (f & ES_CPU_AVX2) {
+			return rfindchr_avx2(s, n, (char)c);
+		}
+		if (f & ES_CPU_SSE2) {
+			return rfindchr_sse2(s, n, (char)c);
+		}
+	}
+#endif
+	return rfindchr_scalar(s, n, (char)c);
+}
+
+es_ssize_t eso_strsimd_findset(const char *s, es_size_t n,
+		const char *set, es_size_t setlen, es_bool_t in_set)
+{
+	if (setlen == 0) {
+		return (in_set || n == 0) ? -1 : 0;
+	}
+	if (setlen == 1 && in_set) {
+		return eso_strsimd_findchr(s, n, set[0]);
+	}
+#if ES_CPU_DISPATCH
+	if (n >= SIMD_MIN_LEN && setlen <= 16 && eso_cpu_has(ES_CPU_SSE42)) {
+		return findset_sse42(s, n, set, setlen, in_set);
+	}
+#endif
+	return findset_scalar(s, n, set, setlen, in_set, 0);
+}
+
+static es_size_t mismatch_icase(const char *a, const char *b, es_size_t n)
+{
+#if ES_CPU_DISPATCH
+	if (n >= SIMD_MIN_LEN) {
+		es_uint32_t f = eso_cpu_features();
+		if (f & ES_CPU_AVX2) {
+			return mismatch_icase_avx2(a, b, n);
+		}
+		if (f & ES_CPU_SSE2) {
+			return mismatch_icase_sse2(a, b, n);
+		}
+	}
+#endif
+	return mismatch_icase_scalar(a, b, n, 0);
+}
+
+int eso_strsimd_compare_icase(const char *a, const char *b, es_size_t n)
+{
+	es_size_t i = mismatch_icase(a, b, n);
+	if (i == n) {
+		return 0;
+	}
+	return (int)(char)ASCII_LOWER((unsigned char)a[i])
+			- (int)(char)ASCII_LOWER((unsigned char)b[i]);
+}
+
+es_bool_t eso_strsimd_equals_icase(const char *a, const char *b, es_size_t n)
+{
+	return (mismatch_icase(a, b, n) == n);
+}
+
+void eso_strsimd_tolower(char *s, es_size_t n)
+{
+	es_size_t i = 0;
+#if ES_CPU_DISPATCH
+	if (n >= SIMD_MIN_LEN) {
+		es_uint32_t f = eso_cpu_features();
+		if (f & ES_CPU_AVX2) {
+			i = casemap_avx2(s, n, CASE_OFFSET_LOWER, 0);
+		} else if (f & ES_CPU_SSE2) {
+			i = casemap_sse2(s, n, CASE_OFFSET_LOWER, 0);
+		}
+	}
+#endif
+	tolower_scalar(s + i, n - i);
+}
+
+void eso_strsimd_toupper(char *s, es_size_t n)
+{
+	es_size_t i = 0;
+#if ES_CPU_DISPATCH
+	if (n >= SIMD_MIN_LEN) {
+		es_uint32_t f = eso_cpu_features();
+		if (f & ES_CPU_AVX2) {
+			i = casemap_avx2(s, n, CASE_OFFSET_UPPER, 1);
+		} else if (f & ES_CPU_SSE2) {
+			i = casemap_sse2(s, n, CASE_OFFSET_UPPER, 1);
+		}
+	}
+#endif
+	toupper_scalar(s + i, n - i);
+}
+
+es_bool_t eso_strsimd_utf8_valid(const char *s, es_size_t n)
+{
+	const unsigned char *u = (const unsigned char *)s;
+	es_size_t i = 0;
+#if ES_CPU_DISPATCH
+	es_uint32_t f = eso_cpu_features();
+#endif
+
+	while (i < n) {
+		if (u[i] < 0x80) {
+			// skip the ascii run by blocks, then the tail
+#if ES_CPU_DISPATCH
+			if (f & ES_CPU_AVX2) {
+				i += ascii_prefix_avx2(s + i, n - i);
+			} else if (f & ES_CPU_SSE2) {
+				i += ascii_prefix_sse2(s + i, n - i);
+			}
+#endif
+			while (i < n && u[i] < 0x80) {
+				i++;
+			}
+		} else {
+			es_size_t len = utf8_sequence(u, n, i);
+			if (len == 0) {
+				return FALSE;
+			}
+			i += len;
+		}
+	}
+	return TRUE;
+}
+
+es_int32_t eso_strsimd_hash31(es_int32_t h, const char *s, es_size_t n)
+{
+	es_uint32_t uh = (es_uint32_t)h;
+#if ES_CPU_DISPATCH
+	if (n >= 64 && eso_cpu_has(ES_CPU_AVX2)) {
+		es_size_t done;
+		uh = hash31_avx2(uh, s, n, &done);
+		s += done;
+		n -= done;
+	}
+#endif
+	return (es_int32_t)hash31_scalar(uh, s, n);
+}
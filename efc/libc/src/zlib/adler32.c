@@ -6,6 +6,9 @@
 /* @(#) $Id$ */
 
 #include "zutil.h"
+#ifndef ZLIB_NO_SIMD
+#include "../../inc/eso_crc32.h"
+#endif
 
 #define local static
 
@@ -96,6 +99,11 @@ uLong ZEXPORT adler32(adler, buf, len)
         return adler | (sum2 << 16);
     }
 
+#ifndef ZLIB_NO_SIMD
+    /* the long runs go to the vectorized sums of the library */
+    return (uLong)eso_adler32_update((es_uint32_t)(adler | (sum2 << 16)),
+                                     (const es_byte_t *)buf, (es_size_t)len);
+#else
     /* do length NMAX blocks -- requires just one modulo operation */
     while (len >= NMAX) {
         len -= NMAX;
@@ -125,6 +133,7 @@ uLong ZEXPORT adler32(adler, buf, len)
 
     /* return recombined sums */
     return adler | (sum2 << 16);
+#endif
 }
 
 /* ========================================================================= */
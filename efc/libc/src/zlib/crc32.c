@@ -27,6 +27,9 @@
 #endif /* MAKECRCH */
 
 #include "zutil.h"      /* for STDC and FAR definitions */
+#ifndef ZLIB_NO_SIMD
+#include "../../inc/eso_crc32.h"
+#endif
 
 #define local static
 
@@ -225,6 +228,15 @@ unsigned long ZEXPORT crc32(crc, buf, len)
 {
     if (buf == Z_NULL) return 0UL;
 
+#ifndef ZLIB_NO_SIMD
+    /* slicing-by-16 or carry-less multiply folding, chosen at run time */
+    {
+        es_uint32_t c = (es_uint32_t)crc ^ 0xffffffffUL;
+        eso_crc32_update(&c, (es_byte_t *)buf, (es_size_t)len);
+        return (unsigned long)(c ^ 0xffffffffUL);
+    }
+#endif
+
 #ifdef DYNAMIC_CRC_TABLE
     if (crc_table_empty)
         make_crc_table();
@@ -1056,6 +1056,65 @@ local void lm_init (s)
  *   string (strstart) and its distance is <= MAX_DIST, and prev_length >= 1
  * OUT assertion: the match length is not greater than s->lookahead.
  */
+#if !defined(ASMV) && !defined(UNALIGNED_OK) && !defined(ZLIB_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define WIDE_MATCH 16
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+      __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && \
+      (defined(__aarch64__) || defined(__x86_64__) || defined(__i386__))
+#  define WIDE_MATCH 8
+#endif
+#endif
+
+#ifdef WIDE_MATCH
+#ifdef _MSC_VER
+#  include <intrin.h>
+local int first_bit(unsigned long v)
+{
+    unsigned long i;
+    _BitScanForward(&i, v);
+    return (int)i;
+}
+#else
+#  define first_bit(v) __builtin_ctzll(v)
+#endif
+
+/* ===========================================================================
+ * Return the length of the match between scan and match, given that the
+ * first three bytes are equal, comparing WIDE_MATCH bytes at a time. The
+ * loads stop at scan+258, as far as the bytewise loop reads.
+ */
+local int match_tail(scan, match)
+    const Bytef *scan;
+    const Bytef *match;
+{
+    int n;
+
+    for (n = 3; n < MAX_MATCH; n += WIDE_MATCH) {
+#if WIDE_MATCH == 16
+        __m128i a = _mm_loadu_si128((const __m128i *)(scan + n));
+        __m128i b = _mm_loadu_si128((const __m128i *)(match + n));
+        unsigned long m = 0xffff ^ (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+#else
+        unsigned long long a, b, m;
+        zmemcpy(&a, scan + n, 8);
+        zmemcpy(&b, match + n, 8);
+        m = a ^ b;
+#endif
+        if (m != 0) {
+#if WIDE_MATCH == 16
+            n += first_bit(m);
+#else
+            n += first_bit(m) >> 3;
+#endif
+            return n < MAX_MATCH ? n : MAX_MATCH;
+        }
+    }
+    return MAX_MATCH;
+}
+#endif /* WIDE_MATCH */
+
 #ifndef ASMV
 /* For 80x86 and 680x0, an optimized version will be provided in match.asm or
  * match.S. The code will be functionally equivalent.
@@ -1086,7 +1145,9 @@ local uInt longest_match(s, cur_match)
     register ush scan_start = *(ushf*)scan;
     register ush scan_end   = *(ushf*)(scan+best_len-1);
 #else
+#ifndef WIDE_MATCH
     register Bytef *strend = s->window + s->strstart + MAX_MATCH;
+#endif
     register Byte scan_end1  = scan[best_len-1];
     register Byte scan_end   = scan[best_len];
 #endif
@@ -1165,6 +1226,10 @@ local uInt longest_match(s, cur_match)
          * are always equal when the other bytes match, given that
          * the hash keys are equal and that HASH_BITS >= 8.
          */
+#ifdef WIDE_MATCH
+        Assert(scan[2] == match[1], "match[2]?");
+        len = match_tail(scan, match - 1);
+#else
         scan += 2, match++;
         Assert(*scan == *match, "match[2]?");
 
@@ -1182,6 +1247,7 @@ local uInt longest_match(s, cur_match)
 
         len = MAX_MATCH - (int)(strend - scan);
         scan = strend - MAX_MATCH;
+#endif /* WIDE_MATCH */
 
 #endif /* UNALIGNED_OK */
 
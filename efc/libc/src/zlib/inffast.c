@@ -29,6 +29,18 @@
 #  define PUP(a) *++(a)
 #endif
 
+/*
+   With a 64-bit little-endian bit buffer, the input is refilled eight bytes
+   at once without branches, to at least 56 bits, which is enough for a whole
+   length/distance pair.  The bits above `bits' in hold are then the next
+   input bits instead of zeros, hold is masked on return.
+ */
+#if !defined(ZLIB_NO_SIMD) && defined(__GNUC__) && defined(__SIZEOF_LONG__) && \
+    __SIZEOF_LONG__ == 8 && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define INFLATE_FAST64
+#endif
+
 /*
    Decode literal, length, and distance codes and write out the resulting
    literal and match bytes until either not enough input or output is
@@ -93,14 +105,17 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     unsigned len;               /* match length, unused bytes */
     unsigned dist;              /* match distance */
     unsigned char FAR *from;    /* where to copy match from */
+#ifdef INFLATE_FAST64
+    unsigned long next;         /* the next eight bytes of input */
+#endif
 
     /* copy state to local variables */
     state = (struct inflate_state FAR *)strm->state;
     in = strm->next_in - OFF;
-    last = in + (strm->avail_in - 5);
+    last = in + (strm->avail_in - (INFLATE_FAST_MIN_INPUT - 1));
     out = strm->next_out - OFF;
     beg = out - (start - strm->avail_out);
-    end = out + (strm->avail_out - 257);
+    end = out + (strm->avail_out - (INFLATE_FAST_MIN_OUTPUT - 1));
 #ifdef INFLATE_STRICT
     dmax = state->dmax;
 #endif
@@ -118,12 +133,19 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     /* decode literals and length/distances until end-of-block or not enough
        input data or output space */
     do {
+#ifdef INFLATE_FAST64
+        zmemcpy(&next, in + OFF, 8);
+        hold |= next << bits;
+        in += (63 - bits) >> 3;
+        bits |= 56;
+#else
         if (bits < 15) {
             hold += (unsigned long)(PUP(in)) << bits;
             bits += 8;
             hold += (unsigned long)(PUP(in)) << bits;
             bits += 8;
         }
+#endif
         here = lcode[hold & lmask];
       dolen:
         op = (unsigned)(here.bits);
@@ -140,21 +162,25 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
             len = (unsigned)(here.val);
             op &= 15;                           /* number of extra bits */
             if (op) {
+#ifndef INFLATE_FAST64
                 if (bits < op) {
                     hold += (unsigned long)(PUP(in)) << bits;
                     bits += 8;
                 }
+#endif
                 len += (unsigned)hold & ((1U << op) - 1);
                 hold >>= op;
                 bits -= op;
             }
             Tracevv((stderr, "inflate:         length %u\n", len));
+#ifndef INFLATE_FAST64
             if (bits < 15) {
                 hold += (unsigned long)(PUP(in)) << bits;
                 bits += 8;
                 hold += (unsigned long)(PUP(in)) << bits;
                 bits += 8;
             }
+#endif
             here = dcode[hold & dmask];
           dodist:
             op = (unsigned)(here.bits);
@@ -164,6 +190,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
             if (op & 16) {                      /* distance base */
                 dist = (unsigned)(here.val);
                 op &= 15;                       /* number of extra bits */
+#ifndef INFLATE_FAST64
                 if (bits < op) {
                     hold += (unsigned long)(PUP(in)) << bits;
                     bits += 8;
@@ -172,6 +199,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         bits += 8;
                     }
                 }
+#endif
                 dist += (unsigned)hold & ((1U << op) - 1);
 #ifdef INFLATE_STRICT
                 if (dist > dmax) {
@@ -266,6 +294,37 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                     }
                 }
                 else {
+#ifndef ZLIB_NO_SIMD
+                    /* copy direct from output by chunks, which may write up
+                       to 15 bytes past the match, see INFLATE_FAST_MIN_OUTPUT */
+                    unsigned char FAR *to = out + OFF;
+                    unsigned char FAR *stop = to + len;
+
+                    from = to - dist;
+                    if (dist >= 16) {
+                        do {
+                            zmemcpy(to, from, 16);
+                            to += 16;
+                            from += 16;
+                        } while (to < stop);
+                    }
+                    else if (dist == 1) {
+                        memset(to, *from, len);
+                    }
+                    else if (dist >= 8) {
+                        do {
+                            zmemcpy(to, from, 8);
+                            to += 8;
+                            from += 8;
+                        } while (to < stop);
+                    }
+                    else {
+                        do {
+                            *to++ = *from++;
+                        } while (to < stop);
+                    }
+                    out = stop - OFF;
+#else
                     from = out - dist;          /* copy direct from output */
                     do {                        /* minimum length is three */
                         PUP(out) = PUP(from);
@@ -278,6 +337,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         if (len > 1)
                             PUP(out) = PUP(from);
                     }
+#endif
                 }
             }
             else if ((op & 64) == 0) {          /* 2nd level distance code */
@@ -315,9 +375,12 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     /* update state and return */
     strm->next_in = in + OFF;
     strm->next_out = out + OFF;
-    strm->avail_in = (unsigned)(in < last ? 5 + (last - in) : 5 - (in - last));
+    strm->avail_in = (unsigned)(in < last ?
+                                (INFLATE_FAST_MIN_INPUT - 1) + (last - in) :
+                                (INFLATE_FAST_MIN_INPUT - 1) - (in - last));
     strm->avail_out = (unsigned)(out < end ?
-                                 257 + (end - out) : 257 - (out - end));
+                                 (INFLATE_FAST_MIN_OUTPUT - 1) + (end - out) :
+                                 (INFLATE_FAST_MIN_OUTPUT - 1) - (out - end));
     state->hold = hold;
     state->bits = bits;
     return;
@@ -8,4 +8,15 @@
    subject to change. Applications should only use zlib.h.
  */
 
+/* the least input and output space left for inflate_fast() to be called:
+   with the wide refill and copies it reads up to 8 bytes of input at once
+   and writes up to 15 bytes past the end of a match */
+#ifndef ZLIB_NO_SIMD
+#  define INFLATE_FAST_MIN_INPUT 8
+#  define INFLATE_FAST_MIN_OUTPUT 274
+#else
+#  define INFLATE_FAST_MIN_INPUT 6
+#  define INFLATE_FAST_MIN_OUTPUT 258
+#endif
+
 void ZLIB_INTERNAL inflate_fast OF((z_streamp strm, unsigned start));
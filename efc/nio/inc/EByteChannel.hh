@@ -10,6 +10,7 @@
 
 #include "./EChannel.hh"
 #include "./EIOByteBuffer.hh"
+#include "../../inc/EA.hh"
 #include "../../inc/EIOException.hh"
 
 namespace efc {
@@ -17,8 +18,8 @@ namespace nio {
 
 /**
  * A channel that can read and write bytes.  This interface simply unifies
- * {@link ReadableByteChannel} and {@link WritableByteChannel}; it does not
- * specify any new operations.
+ * {@link ReadableByteChannel} and {@link WritableByteChannel}, with their
+ * scattering and gathering forms; it does not specify any new operations.
  *
  * @since 1.4
  */
@@ -26,6 +27,8 @@ namespace nio {
 //ByteChannel extends ReadableByteChannel, WritableByteChannel
 //ReadableByteChannel extends Channel
 //WritableByteChannel extends Channel
+//ScatteringByteChannel extends ReadableByteChannel
+//GatheringByteChannel extends WritableByteChannel
 //Channel extends Closeable
 
 interface EByteChannel : virtual public EChannel {
@@ -90,6 +93,21 @@ public:
 	 */
 	virtual int read(EIOByteBuffer* dst) THROWS(EIOException) = 0;
 
+	/**
+	 * Reads a sequence of bytes from this channel into a subsequence of the
+	 * given buffers, as by one {@link #read(EIOByteBuffer*) read} into a
+	 * buffer made of their remaining bytes in turn.
+	 *
+	 * @return The number of bytes read, possibly zero,
+	 *         or <tt>-1</tt> if the channel has reached end-of-stream
+	 *
+	 * @throws  IndexOutOfBoundsException
+	 *          If the preconditions on the <tt>offset</tt> and <tt>length</tt>
+	 *          parameters do not hold
+	 */
+	virtual long read(EA<EIOByteBuffer*>* dsts, int offset, int length) THROWS(EIOException) = 0;
+	virtual long read(EA<EIOByteBuffer*>* dsts) THROWS(EIOException) = 0;
+
 	/**
 	 * Writes a sequence of bytes to this channel from the given buffer.
 	 *
@@ -142,6 +160,20 @@ public:
 	 *          If some other I/O error occurs
 	 */
 	virtual int write(EIOByteBuffer* src) THROWS(EIOException) = 0;
+
+	/**
+	 * Writes a sequence of bytes to this channel from a subsequence of the
+	 * given buffers, as by one {@link #write(EIOByteBuffer*) write} from a
+	 * buffer made of their remaining bytes in turn.
+	 *
+	 * @return The number of bytes written, possibly zero
+	 *
+	 * @throws  IndexOutOfBoundsException
+	 *          If the preconditions on the <tt>offset</tt> and <tt>length</tt>
+	 *          parameters do not hold
+	 */
+	virtual long write(EA<EIOByteBuffer*>* srcs, int offset, int length) THROWS(EIOException) = 0;
+	virtual long write(EA<EIOByteBuffer*>* srcs) THROWS(EIOException) = 0;
 };
 
 } /* namespace nio */
@@ -0,0 +1,56 @@
+/*
+ * ECompletionHandler.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ECOMPLETIONHANDLER_HH_
+#define ECOMPLETIONHANDLER_HH_
+
+#include "../../inc/EObject.hh"
+#include "../../inc/EIOException.hh"
+
+namespace efc {
+namespace nio {
+
+/**
+ * A handler for consuming the result of an asynchronous I/O operation.
+ *
+ * <p> The operations queued on an {@link EIOUring} take a completion handler
+ * that is invoked when the operation completes, in the thread which polls
+ * the ring.  The handler should not block: it runs before the ring can
+ * deliver the next completion.
+ *
+ * @see EIOUring
+ */
+
+interface ECompletionHandler : virtual public EObject {
+	virtual ~ECompletionHandler(){}
+
+	/**
+	 * Invoked when an operation has completed.
+	 *
+	 * @param   result
+	 *          The result of the I/O operation: the number of bytes
+	 *          transferred, the descriptor of an accepted connection or the
+	 *          ready events of a poll
+	 * @param   flags
+	 *          The completion flags, see {@link EIOUring#hasMore} and
+	 *          {@link EIOUring#getBufferId}
+	 */
+	virtual void completed(int result, int flags) = 0;
+
+	/**
+	 * Invoked when an operation fails, or when it was cancelled.
+	 *
+	 * @param   exc
+	 *          The exception to indicate why the I/O operation failed,
+	 *          its errno is the error of the operation
+	 */
+	virtual void failed(EIOException* exc) = 0;
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* ECOMPLETIONHANDLER_HH_ */
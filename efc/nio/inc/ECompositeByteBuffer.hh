@@ -0,0 +1,191 @@
+/*
+ * ECompositeByteBuffer.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ECOMPOSITEBYTEBUFFER_HH_
+#define ECOMPOSITEBYTEBUFFER_HH_
+
+#include "./EIOByteBuffer.hh"
+#include "./EByteChannel.hh"
+#include "../../inc/EArrayList.hh"
+#include "../../inc/ESharedPtr.hh"
+
+namespace efc {
+namespace nio {
+
+/**
+ * A byte buffer made of the contents of other buffers, its components,
+ * without copying them.
+ *
+ * <p> Each component adds the remaining bytes of a buffer, as they were
+ * when it was added, at the end of the composite buffer: a protocol frame
+ * is built from a header buffer and its payload buffers as they are.
+ * Relative and absolute <i>get</i> and <i>put</i> operations, and
+ * {@link #indexOf indexOf}, work across the components' boundaries, on
+ * the components' memory.
+ *
+ * <p> The composite buffer has a position, a limit and a capacity as a
+ * buffer has, the capacity being the total length of the components and
+ * the limit following the capacity while at it.  {@link #write} writes
+ * the remaining bytes to a channel with one gathering write, a single
+ * <tt>writev</tt> for a socket channel:
+ *
+ * <blockquote><pre>
+ * ECompositeByteBuffer frame;
+ * frame.addComponent(header);
+ * frame.addComponent(payload);
+ * while (frame.hasRemaining()) {
+ *     frame.write(channel);
+ * }
+ * </pre></blockquote>
+ *
+ * <p> The components are shared with their buffers, whose positions and
+ * limits are not changed.  A composite buffer is not safe for use by
+ * multiple concurrent threads.
+ */
+
+class ECompositeByteBuffer: public EObject {
+public:
+	virtual ~ECompositeByteBuffer();
+
+	/**
+	 * Creates an empty composite buffer.
+	 */
+	ECompositeByteBuffer();
+
+	/**
+	 * Adds the remaining bytes of a buffer, which is held until the
+	 * composite buffer is deleted or the component discarded.
+	 *
+	 * @return  This buffer
+	 */
+	ECompositeByteBuffer* addComponent(sp<EIOByteBuffer> buffer);
+
+	/**
+	 * Adds external memory, which must outlive the component.
+	 *
+	 * @return  This buffer
+	 */
+	ECompositeByteBuffer* addComponent(const void* address, int length);
+
+	/**
+	 * Returns the number of components.
+	 */
+	int numComponents();
+
+	/**
+	 * Returns the buffer of a component.
+	 */
+	EIOByteBuffer* component(int index);
+
+	/**
+	 * Removes the components before the position, which becomes the
+	 * position in the first component left.
+	 *
+	 * @return  This buffer
+	 */
+	ECompositeByteBuffer* discardReadComponents();
+
+	int capacity();
+	int position();
+	ECompositeByteBuffer* position(int newPosition);
+	int limit();
+	ECompositeByteBuffer* limit(int newLimit);
+	int remaining();
+	boolean hasRemaining();
+	ECompositeByteBuffer* clear();
+	ECompositeByteBuffer* flip();
+	ECompositeByteBuffer* rewind();
+	ECompositeByteBuffer* skip(int size);
+
+	/**
+	 * Relative and absolute <i>get</i> methods, across the components.
+	 *
+	 * @throws  BufferUnderflowException
+	 *          If fewer bytes than asked remain before the limit
+	 */
+	byte get();
+	byte get(int index);
+	ECompositeByteBuffer* get(void* dst, int length);
+	ECompositeByteBuffer* get(int index, void* dst, int length);
+
+	short getShort();
+	short getShort(int index);
+	int getInt();
+	int getInt(int index);
+	llong getLLong();
+	llong getLLong(int index);
+
+	/**
+	 * Relative and absolute <i>put</i> methods, into the components'
+	 * memory.
+	 *
+	 * @throws  BufferOverflowException
+	 *          If fewer bytes than given remain before the limit
+	 */
+	ECompositeByteBuffer* put(byte b);
+	ECompositeByteBuffer* put(int index, byte b);
+	ECompositeByteBuffer* put(const void* src, int length);
+	ECompositeByteBuffer* put(int index, const void* src, int length);
+
+	ECompositeByteBuffer* putShort(short value);
+	ECompositeByteBuffer* putInt(int value);
+	ECompositeByteBuffer* putLLong(llong value);
+
+	/**
+	 * Returns the index of the first byte of the given value between the
+	 * position and the limit, or -1.
+	 */
+	int indexOf(byte value);
+
+	/**
+	 * Returns the index of the first byte of the given value in
+	 * [<tt>fromIndex</tt>, <tt>toIndex</tt>), or -1.
+	 */
+	int indexOf(int fromIndex, int toIndex, byte value);
+
+	/**
+	 * Returns the index of the first occurrence of a sequence of bytes,
+	 * a delimiter say, between the position and the limit, or -1.
+	 */
+	int indexOf(const void* pattern, int length);
+
+	/**
+	 * Returns buffers over the remaining bytes, one per component, which
+	 * share the components' memory.
+	 */
+	sp<EA<EIOByteBuffer*> > nioBuffers();
+
+	/**
+	 * Writes the remaining bytes to a channel with one gathering write,
+	 * and advances the position by the number of bytes written.
+	 *
+	 * @return  The number of bytes written, possibly zero
+	 */
+	long write(EByteChannel* channel) THROWS(EIOException);
+
+	virtual EString toString();
+
+private:
+	class Component;
+
+	EArrayList<Component*> components_;
+	int position_;
+	int limit_;
+	int capacity_;
+	int last_;         // the component accessed last
+
+	/**
+	 * Returns the index of the component holding the byte at index.
+	 */
+	int componentOf(int index);
+
+	void copy(int index, void* buf, int length, boolean toComponents);
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* ECOMPOSITEBYTEBUFFER_HH_ */
@@ -0,0 +1,69 @@
+/*
+ * EConnectionHandler.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ECONNECTIONHANDLER_HH_
+#define ECONNECTIONHANDLER_HH_
+
+#include "../../inc/EObject.hh"
+#include "./EIOByteBuffer.hh"
+
+namespace efc {
+namespace nio {
+
+class EReactorConnection;
+
+/**
+ * The handler of the events of one connection of an {@link EReactorGroup}.
+ *
+ * <p> A handler is created for each accepted connection by the group's
+ * {@link EConnectionHandlerFactory}, and is owned by the connection, which
+ * deletes it once closed.  All the methods are invoked in the thread of the
+ * event loop the connection is bound to, so a handler needs no
+ * synchronization for its own state; they should not block.
+ */
+
+interface EConnectionHandler : virtual public EObject {
+	virtual ~EConnectionHandler(){}
+
+	/**
+	 * Invoked once the connection is registered with its event loop.
+	 */
+	virtual void opened(EReactorConnection* conn) = 0;
+
+	/**
+	 * Invoked when data were received.
+	 *
+	 * @param   conn
+	 *          The connection
+	 * @param   data
+	 *          The data, between the position and the limit of the buffer,
+	 *          which is reused by the event loop once this method returns
+	 */
+	virtual void received(EReactorConnection* conn, EIOByteBuffer* data) = 0;
+
+	/**
+	 * Invoked once when the connection is closed, by either side.
+	 */
+	virtual void closed(EReactorConnection* conn) = 0;
+};
+
+/**
+ * Creates the handler of each accepted connection.
+ */
+
+interface EConnectionHandlerFactory : virtual public EObject {
+	virtual ~EConnectionHandlerFactory(){}
+
+	/**
+	 * Returns a new handler, owned by the connection.
+	 */
+	virtual EConnectionHandler* newHandler() = 0;
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* ECONNECTIONHANDLER_HH_ */
@@ -386,6 +386,91 @@ public:
 	virtual int send(EIOByteBuffer* src, EInetSocketAddress* target) THROWS(EIOException);
 	virtual int send(EIOByteBuffer* src, const char* hostname, int port) THROWS(EIOException);
 
+	// -- Batch operations --
+
+	/**
+	 * Receives several datagrams at once, one into each buffer.
+	 *
+	 * <p> Where supported the datagrams are received by <tt>recvmmsg</tt>,
+	 * many per system call.  If this channel is in blocking mode this method
+	 * waits for the first datagram only, then takes those already queued.
+	 * Each datagram is transferred into its buffer as by {@link
+	 * #receive(EIOByteBuffer*) receive}, the excess of a datagram larger
+	 * than the remaining bytes of its buffer being discarded.
+	 *
+	 * <p> If UDP_GRO is enabled on the socket, a buffer may receive several
+	 * datagrams of one flow coalesced, whose size is reported in
+	 * <tt>segments</tt>: the buffers should then be large enough to hold
+	 * 64KB.
+	 *
+	 * @param  dsts
+	 *         The buffers into which the datagrams are to be transferred
+	 *
+	 * @param  sources
+	 *         If not <tt>null</tt>, receives the source address of each
+	 *         datagram; the addresses in place are reused when equal
+	 *
+	 * @param  segments
+	 *         If not <tt>null</tt>, receives the segment size of the
+	 *         datagrams coalesced by UDP_GRO into each buffer, 0 if not
+	 *         coalesced
+	 *
+	 * @return  The number of datagrams received, the first buffers, possibly
+	 *          zero if this channel is in non-blocking mode
+	 *
+	 * @throws  IllegalArgumentException
+	 *          If <tt>sources</tt> or <tt>segments</tt> is shorter than
+	 *          <tt>dsts</tt>, or a buffer is read-only
+	 *
+	 * @throws  ClosedChannelException
+	 *          If this channel is closed
+	 *
+	 * @throws  IOException
+	 *          If some other I/O error occurs
+	 */
+	virtual int receiveBatch(EA<EIOByteBuffer*>* dsts,
+			EA<sp<EInetSocketAddress> >* sources=null,
+			EA<int>* segments=null) THROWS(EIOException);
+
+	/**
+	 * Sends several datagrams at once, the remaining bytes of each buffer
+	 * as one datagram.
+	 *
+	 * <p> Where supported the datagrams are sent by <tt>sendmmsg</tt>, many
+	 * per system call.  If UDP_SEGMENT is set on the socket, each buffer is
+	 * further split into datagrams of the segment size.
+	 *
+	 * @param  srcs
+	 *         The buffers containing the datagrams to be sent
+	 *
+	 * @param  targets
+	 *         The address of each datagram, or <tt>null</tt> to send them
+	 *         all to the peer of this connected channel
+	 *
+	 * @return  The number of datagrams sent, the first buffers, possibly
+	 *          zero if this channel is in non-blocking mode
+	 *
+	 * @throws  NotYetConnectedException
+	 *          If <tt>targets</tt> is <tt>null</tt> and this channel is not
+	 *          connected
+	 *
+	 * @throws  ClosedChannelException
+	 *          If this channel is closed
+	 *
+	 * @throws  IOException
+	 *          If some other I/O error occurs
+	 */
+	virtual int sendBatch(EA<EIOByteBuffer*>* srcs,
+			EA<EInetSocketAddress*>* targets=null) THROWS(EIOException);
+
+	/**
+	 * Sends several datagrams at once, all to the same address.
+	 *
+	 * @see #sendBatch(EA<EIOByteBuffer*>*, EA<EInetSocketAddress*>*)
+	 */
+	virtual int sendBatch(EA<EIOByteBuffer*>* srcs,
+			EInetSocketAddress* target) THROWS(EIOException);
+
 
 	// -- ByteChannel operations --
 
@@ -602,6 +687,9 @@ private:
 	void ensureOpen() THROWS(EClosedChannelException);
 	void ensureOpenAndUnconnected() THROWS(EIOException);
 
+	int sendBatch(EA<EIOByteBuffer*>* srcs, EInetSocketAddress* target,
+			EA<EInetSocketAddress*>* targets) THROWS(EIOException);
+
 	/**
 	 * Translates native poll revent set into a ready operation set
 	 */
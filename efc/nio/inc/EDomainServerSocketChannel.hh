@@ -0,0 +1,141 @@
+/*
+ * EDomainServerSocketChannel.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EDOMAINSERVERSOCKETCHANNEL_HH_
+#define EDOMAINSERVERSOCKETCHANNEL_HH_
+
+#include "../../inc/EString.hh"
+#include "../../inc/ESocketOptions.hh"
+#include "../../inc/concurrent/EReentrantLock.hh"
+#include "../../inc/EIOException.hh"
+#include "./EDomainSocketChannel.hh"
+#include "./ESelectableChannel.hh"
+#include "./ESelectionKey.hh"
+#include "./ESelector.hh"
+
+namespace efc {
+namespace nio {
+
+/**
+ * A selectable channel for listening Unix domain sockets.
+ *
+ * <p> A domain server-socket channel is created by invoking the {@link
+ * #open open} method of this class, and bound to a path by {@link #bind
+ * bind}, which first removes a socket file left at that path.  In
+ * non-blocking mode {@link #accept accept} returns <tt>null</tt> when no
+ * connection is pending, and the channel is registered with a selector for
+ * <tt>OP_ACCEPT</tt> as a server-socket channel is.  The accepted channels
+ * have the type of this channel, stream or sequenced packet.
+ *
+ * <p> The socket file is not removed when the channel is closed.  Domain
+ * server-socket channels are safe for use by multiple concurrent threads.
+ * They are not supported on Windows, where {@link #open} throws an
+ * <tt>UnsupportedOperationException</tt>.
+ */
+
+class EDomainServerSocketChannel: public ESelectableChannel, virtual public ESocketOptions {
+public:
+	virtual ~EDomainServerSocketChannel();
+
+	/**
+	 * Opens an unbound domain server-socket channel.
+	 *
+	 * @param seqpacket  true for a <tt>SOCK_SEQPACKET</tt> socket
+	 */
+	static EDomainServerSocketChannel* open(boolean seqpacket=false) THROWS(EIOException);
+
+	/**
+	 * Returns <tt>OP_ACCEPT</tt>.
+	 */
+	virtual int validOps();
+
+	/**
+	 * Binds this channel's socket to a path and listens on it.
+	 *
+	 * @throws  AlreadyBoundException
+	 *          If this channel is already bound
+	 * @throws  BindException
+	 *          If the path is in use by something else than a socket
+	 */
+	void bind(const char* path, int backlog=50) THROWS(EIOException);
+
+	boolean isBound();
+
+	/**
+	 * Returns the path this channel is bound to, or an empty string.
+	 */
+	EString localPath();
+
+	boolean isSeqPacket();
+
+	/**
+	 * Accepts a connection made to this channel's socket.
+	 *
+	 * @return  The channel for the new connection, in blocking mode, or
+	 *          <tt>null</tt> if this channel is in non-blocking mode and no
+	 *          connection is available to be accepted
+	 *
+	 * @throws  ClosedChannelException
+	 *          If this channel is closed
+	 * @throws  SocketException
+	 *          If this channel's socket has not yet been bound
+	 */
+	EDomainSocketChannel* accept() THROWS(EIOException);
+
+	virtual int getFDVal();
+
+	virtual EString toString();
+
+	/*
+	 * {@inheritDoc}
+	 */
+	virtual void setOption(int optID, const void* optval, int optlen) THROWS(ESocketException);
+	virtual void getOption(int optID, void* optval, int* optlen) THROWS(ESocketException);
+
+protected:
+	boolean translateAndUpdateReadyOps(int ops, ESelectionKey* sk);
+	boolean translateAndSetReadyOps(int ops, ESelectionKey* sk);
+	void translateAndSetInterestOps(int ops, ESelectionKey* sk);
+
+	void implCloseSelectableChannel() THROWS(EIOException);
+	void implConfigureBlocking(boolean block) THROWS(EIOException);
+
+	virtual void kill() THROWS(EIOException);
+
+private:
+	// Our file descriptor
+	int _fd;
+
+	boolean _seqpacket;
+
+	// The path bound to, empty => unbound
+	EString _localPath;
+
+	// ID of native thread currently blocked in this channel, for signalling
+	volatile es_os_thread_t _thread;
+
+	// Lock held by thread currently blocked in this channel
+	EReentrantLock _lock;
+
+	// Lock held by any thread that modifies the state fields declared below
+	// DO NOT invoke a blocking I/O operation while holding this lock!
+	EReentrantLock _stateLock;
+
+	// Channel state, increases monotonically
+	static const int ST_UNINITIALIZED = -1;
+	static const int ST_INUSE = 0;
+	static const int ST_KILLED = 1;
+	byte _state;
+
+	EDomainServerSocketChannel(boolean seqpacket);
+
+	boolean translateReadyOps(int ops, int initialOps, ESelectionKey* sk);
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* EDOMAINSERVERSOCKETCHANNEL_HH_ */
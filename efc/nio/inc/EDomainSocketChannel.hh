@@ -0,0 +1,219 @@
+/*
+ * EDomainSocketChannel.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EDOMAINSOCKETCHANNEL_HH_
+#define EDOMAINSOCKETCHANNEL_HH_
+
+#include "../../inc/EA.hh"
+#include "../../inc/EString.hh"
+#include "../../inc/ESocketOptions.hh"
+#include "../../inc/concurrent/EReentrantLock.hh"
+#include "../../inc/EIOException.hh"
+#include "./EByteChannel.hh"
+#include "./ESelectableChannel.hh"
+#include "./ESelectionKey.hh"
+#include "./ESelector.hh"
+
+namespace efc {
+namespace nio {
+
+/**
+ * A selectable channel for Unix domain sockets.
+ *
+ * <p> A domain socket channel is created by invoking one of the {@link
+ * #open open} methods of this class, or accepted by an {@link
+ * EDomainServerSocketChannel}.  It is the channel counterpart of
+ * <tt>utils::EDomainSocket</tt>: in non-blocking mode it is registered with
+ * a selector as a socket channel is, so that local IPC runs in the same
+ * event loop as TCP.
+ *
+ * <p> A channel is either a stream, <tt>SOCK_STREAM</tt>, or a sequenced
+ * packet socket, <tt>SOCK_SEQPACKET</tt>, that keeps message boundaries:
+ * each write sends one message and each read receives one, a message
+ * longer than the buffers being truncated.
+ *
+ * <p> File descriptors are passed with the bytes as <tt>SCM_RIGHTS</tt>
+ * ancillary data, by the {@link #write(EA<EIOByteBuffer*>*, int, int, EA<int>*)
+ * write} and {@link #read(EA<EIOByteBuffer*>*, int, int, EA<int>*) read}
+ * methods taking an array of descriptors.  Connecting to a path completes
+ * at once, there is no connection pending as with TCP.
+ *
+ * <p> Domain socket channels are safe for use by multiple concurrent
+ * threads, one read and one write at a time.  They are not supported on
+ * Windows, where {@link #open} throws an <tt>UnsupportedOperationException</tt>.
+ */
+
+class EDomainSocketChannel: public ESelectableChannel, virtual public ESocketOptions, virtual public EByteChannel {
+public:
+	/**
+	 * The largest number of descriptors passed with one message.
+	 */
+	static const int MAX_FDS = 253;
+
+	virtual ~EDomainSocketChannel();
+
+	/**
+	 * Opens an unconnected domain socket channel.
+	 *
+	 * @param seqpacket  true for a <tt>SOCK_SEQPACKET</tt> socket
+	 */
+	static EDomainSocketChannel* open(boolean seqpacket=false) THROWS(EIOException);
+
+	/**
+	 * Opens a domain socket channel and connects it to a path.
+	 */
+	static EDomainSocketChannel* open(const char* path, boolean seqpacket=false) THROWS(EIOException);
+
+	/**
+	 * Returns <tt>OP_READ</tt> and <tt>OP_WRITE</tt>.
+	 */
+	virtual int validOps();
+
+	/**
+	 * Connects this channel to the listening socket bound to a path.
+	 *
+	 * <p> The connection is made at once, even in non-blocking mode.  A
+	 * non-blocking channel fails with an <tt>IOException</tt> if the
+	 * listener's backlog is full, a blocking one waits for room.
+	 *
+	 * @throws  AlreadyConnectedException
+	 *          If this channel is already connected
+	 * @throws  ConnectException
+	 *          If no socket listens on the path
+	 */
+	void connect(const char* path) THROWS(EIOException);
+
+	boolean isConnected();
+
+	/**
+	 * Tells whether this channel keeps message boundaries.
+	 */
+	boolean isSeqPacket();
+
+	/**
+	 * Returns the path this channel connected to, or an empty string for
+	 * an accepted or unconnected channel.
+	 */
+	EString remotePath();
+
+	// -- EByteChannel --
+
+	virtual int read(EIOByteBuffer* dst) THROWS(EIOException);
+	virtual long read(EA<EIOByteBuffer*>* dsts, int offset, int length) THROWS(EIOException);
+	virtual long read(EA<EIOByteBuffer*>* dsts) THROWS(EIOException);
+	virtual int write(EIOByteBuffer* src) THROWS(EIOException);
+	virtual long write(EA<EIOByteBuffer*>* srcs, int offset, int length) THROWS(EIOException);
+	virtual long write(EA<EIOByteBuffer*>* srcs) THROWS(EIOException);
+
+	// -- Descriptor passing --
+
+	/**
+	 * Reads into the given buffers with one <tt>recvmsg</tt>, and receives
+	 * the descriptors passed with the bytes read.
+	 *
+	 * <p> The descriptors received are stored from the start of
+	 * <tt>fds</tt>, the other elements being set to -1.  At most
+	 * {@link #MAX_FDS} are received, however long <tt>fds</tt> is; the
+	 * descriptors passed that do not fit are closed.  The caller owns the
+	 * descriptors, which are close-on-exec.
+	 *
+	 * @return  The number of bytes read, possibly zero, or <tt>-1</tt> if
+	 *          the channel has reached end-of-stream
+	 */
+	int read(EIOByteBuffer* dst, EA<int>* fds) THROWS(EIOException);
+	long read(EA<EIOByteBuffer*>* dsts, int offset, int length, EA<int>* fds) THROWS(EIOException);
+
+	/**
+	 * Writes from the given buffers with one <tt>sendmsg</tt>, passing the
+	 * given descriptors with the first byte written.
+	 *
+	 * <p> The descriptors stay open in this process.  At least one byte
+	 * must be written with them.
+	 *
+	 * @return  The number of bytes written, possibly zero, in which case
+	 *          the descriptors were not passed
+	 *
+	 * @throws  IllegalArgumentException
+	 *          If there are more than {@link #MAX_FDS} descriptors, or no
+	 *          bytes to carry them
+	 */
+	int write(EIOByteBuffer* src, EA<int>* fds) THROWS(EIOException);
+	long write(EA<EIOByteBuffer*>* srcs, int offset, int length, EA<int>* fds) THROWS(EIOException);
+
+	void shutdownInput() THROWS(EIOException);
+	void shutdownOutput() THROWS(EIOException);
+	boolean isInputOpen();
+	boolean isOutputOpen();
+
+	virtual int getFDVal();
+
+	virtual EString toString();
+
+	/*
+	 * {@inheritDoc}
+	 */
+	virtual void setOption(int optID, const void* optval, int optlen) THROWS(ESocketException);
+	virtual void getOption(int optID, void* optval, int* optlen) THROWS(ESocketException);
+
+protected:
+	boolean translateAndUpdateReadyOps(int ops, ESelectionKey* sk);
+	boolean translateAndSetReadyOps(int ops, ESelectionKey* sk);
+	void translateAndSetInterestOps(int ops, ESelectionKey* sk);
+
+	void implCloseSelectableChannel() THROWS(EIOException);
+	void implConfigureBlocking(boolean block) THROWS(EIOException);
+
+	virtual void kill() THROWS(EIOException);
+
+private:
+	friend class EDomainServerSocketChannel;
+
+	// Our file descriptor
+	int _fd;
+
+	boolean _seqpacket;
+
+	// The path connected to
+	EString _remotePath;
+
+	// IDs of native threads doing reads and writes, for signalling
+	volatile es_os_thread_t _readerThread;
+	volatile es_os_thread_t _writerThread;
+
+	// Locks held by threads reading and writing
+	EReentrantLock _readLock;
+	EReentrantLock _writeLock;
+
+	// Lock held by any thread that modifies the state fields declared below
+	// DO NOT invoke a blocking I/O operation while holding this lock!
+	EReentrantLock _stateLock;
+
+	// Input and output open, protected by stateLock
+	boolean _isInputOpen;
+	boolean _isOutputOpen;
+
+	// State, increases monotonically
+	int _state;
+
+	/**
+	 * Initializes a new instance of this class, unconnected or for an
+	 * accepted connection.
+	 */
+	EDomainSocketChannel(boolean seqpacket);
+	EDomainSocketChannel(int fd, boolean seqpacket);
+
+	boolean translateReadyOps(int ops, int initialOps, ESelectionKey* sk);
+
+	boolean ensureReadOpen() THROWS(EClosedChannelException);
+	void ensureWriteOpen() THROWS(EClosedChannelException);
+	void readerCleanup() THROWS(EIOException);
+	void writerCleanup() THROWS(EIOException);
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* EDOMAINSOCKETCHANNEL_HH_ */
@@ -13,6 +13,7 @@
 #include "./EByteChannel.hh"
 #include "./ENativeThreadSet.hh"
 #include "./EInterruptibleChannel.hh"
+#include "./EIOUring.hh"
 #include "../../inc/EA.hh"
 #include "../../inc/concurrent/EReentrantLock.hh"
 
@@ -580,6 +581,29 @@ public:
 	 */
 	virtual int write(EIOByteBuffer* src, long position) THROWS(EIOException);
 
+	// -- Completion-based operations --
+
+	/**
+	 * Queues a read into dst from the given file position on the given
+	 * io_uring, see {@link EIOUring#read}.  The fixed buffer variant is used
+	 * if dst lies in a buffer registered with the ring.
+	 *
+	 * @return  The id of the operation
+	 *
+	 * @throws  NonReadableChannelException
+	 *          If this channel was not opened for reading
+	 */
+	llong read(EIOByteBuffer* dst, long position, EIOUring* ring, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Queues a write of src at the given file position on the given
+	 * io_uring, see {@link EIOUring#write}.
+	 *
+	 * @throws  NonWritableChannelException
+	 *          If this channel was not opened for writing
+	 */
+	llong write(EIOByteBuffer* src, long position, EIOUring* ring, ECompletionHandler* handler) THROWS(EIOException);
+
 	/**
 	 *
 	 */
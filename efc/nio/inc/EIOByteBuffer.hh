@@ -361,6 +361,42 @@ public:
 	EIOByteBuffer* putDouble(double value);
 	EIOByteBuffer* putDouble(int index, double value);
 
+	/**
+	 * Compresses the remaining bytes of this buffer to one LZ4 block, which
+	 * is put into <tt>dst</tt> at its position.  The positions of both
+	 * buffers are advanced.
+	 *
+	 * @param  dst
+	 *         The buffer of the block, {@link #lz4CompressBound(int)}
+	 *         remaining bytes are always enough
+	 * @param  acceleration
+	 *         1 for the best ratio, the larger the faster
+	 *
+	 * @return  The size of the block
+	 *
+	 * @throws  BufferOverflowException
+	 *          If the block doesn't fit in the remaining bytes of dst
+	 */
+	int lz4Compress(EIOByteBuffer* dst, int acceleration=1);
+
+	/**
+	 * Decompresses the remaining bytes of this buffer, one whole LZ4 block,
+	 * into <tt>dst</tt> at its position.  The positions of both buffers are
+	 * advanced.
+	 *
+	 * @return  The number of decompressed bytes
+	 *
+	 * @throws  DataFormatException
+	 *          If the block is malformed or doesn't fit in the remaining
+	 *          bytes of dst
+	 */
+	int lz4Decompress(EIOByteBuffer* dst);
+
+	/**
+	 * Returns the largest size of the LZ4 block of <tt>size</tt> bytes.
+	 */
+	static int lz4CompressBound(int size);
+
 	/**
 	 * Returns the current hash code of this buffer.
 	 *
@@ -0,0 +1,219 @@
+/*
+ * EIOByteBufferPool.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EIOBYTEBUFFERPOOL_HH_
+#define EIOBYTEBUFFERPOOL_HH_
+
+#include "./EIOByteBuffer.hh"
+#include "./EByteChannel.hh"
+#include "../../inc/EA.hh"
+#include "../../inc/ESharedPtr.hh"
+#include "../../inc/concurrent/EAtomicInteger.hh"
+
+namespace efc {
+namespace nio {
+
+class EPooledByteBuffer;
+
+/**
+ * A pool of page-aligned direct buffers.
+ *
+ * <p> Buffers are served from size classes, the powers of two from
+ * {@link #MIN_SIZE} to {@link #MAX_SIZE}: a buffer's memory is a chunk of
+ * its class, carved from slabs of memory mapped by the pool's arena and
+ * never unmapped before the pool's end.  Each thread has its own cache of
+ * chunks per class, so that most allocations and releases take no lock;
+ * a cache refills from the arena and flushes back to it by batches of
+ * half its size.  Larger buffers are mapped and unmapped one by one.
+ *
+ * <p> With huge pages the slabs are 2MB huge pages where the system has
+ * some reserved, and otherwise are advised to be backed by transparent
+ * huge pages, to spare TLB misses on large transfers.
+ *
+ * <p> Pooled buffers are reference counted: a buffer is freed when its
+ * last reference is {@link EPooledByteBuffer#release released}, its chunk
+ * going back to the cache of the releasing thread.
+ *
+ * <blockquote><pre>
+ * EPooledByteBuffer* buf = pool.allocate(16384);
+ * channel->read(buf);
+ * ...
+ * buf->release();
+ * </pre></blockquote>
+ *
+ * <p> Pools are safe for use by multiple concurrent threads.  The chunks
+ * cached by a thread go back to the arena when the thread ends; the
+ * memory is unmapped once the pool, its buffers and the caches are gone.
+ */
+
+class EIOByteBufferPool: public EObject {
+public:
+	/**
+	 * The smallest size class.
+	 */
+	static const int MIN_SIZE = 512;
+
+	/**
+	 * The largest size class, larger buffers are not pooled.
+	 */
+	static const int MAX_SIZE = 1024 * 1024;
+
+	virtual ~EIOByteBufferPool();
+
+	/**
+	 * Creates a pool.
+	 *
+	 * @param hugePages  true to back the slabs with huge pages
+	 * @param cacheSize  the number of chunks per class a thread may cache,
+	 *                   0 for no thread caches
+	 */
+	EIOByteBufferPool(boolean hugePages=false, int cacheSize=64);
+
+	/**
+	 * Allocates a buffer of the given capacity, its position zero and its
+	 * limit its capacity, with one reference.  Its content is undefined.
+	 */
+	EPooledByteBuffer* allocate(int capacity);
+
+	/**
+	 * Reads from a channel into pooled buffers, with one scattering read.
+	 *
+	 * <p> Each null element of <tt>dsts</tt> is given a buffer of
+	 * <tt>bufferSize</tt> bytes before the read; those left empty by the
+	 * read are released after it and their elements set back to null.
+	 * The caller releases the others, or deletes them with the array.
+	 *
+	 * @return  The number of bytes read, possibly zero, or <tt>-1</tt> if
+	 *          the channel has reached end-of-stream
+	 */
+	long read(EByteChannel* channel, EA<EIOByteBuffer*>* dsts, int bufferSize) THROWS(EIOException);
+
+	/**
+	 * Returns the chunks cached by the current thread to the arena.
+	 */
+	void trim();
+
+	// -- Metrics --
+
+	/**
+	 * Returns the number of buffers allocated.
+	 */
+	llong allocations();
+
+	/**
+	 * Returns the number of allocations served by a thread cache.
+	 */
+	llong cacheHits();
+
+	/**
+	 * Returns the number of allocations too large to be pooled.
+	 */
+	llong unpooledAllocations();
+
+	/**
+	 * Returns the number of bytes of the buffers in use, counted by size
+	 * class.
+	 */
+	llong usedBytes();
+
+	/**
+	 * Returns the number of bytes of the slabs.
+	 */
+	llong reservedBytes();
+
+	/**
+	 * Returns the number of slabs backed by huge pages.
+	 */
+	int hugePageSlabs();
+
+	/**
+	 * Returns the number of threads with a cache.
+	 */
+	int threadCaches();
+
+	virtual EString toString();
+
+private:
+	friend class EPooledByteBuffer;
+
+	class Arena;
+	class Cache;
+	class ThreadLocalCache;
+
+	sp<Arena> arena_;
+};
+
+/**
+ * A buffer of an {@link EIOByteBufferPool}.
+ *
+ * <p> A buffer is freed when its reference count drops to zero.  A
+ * retained slice shares the content of its buffer and holds a reference
+ * to it, the buffer then outliving its own release until the slice is
+ * released.  Deleting a buffer drops it as its last release would.
+ */
+
+class EPooledByteBuffer: public EIOByteBuffer {
+public:
+	virtual ~EPooledByteBuffer();
+
+	/**
+	 * Adds a reference.
+	 *
+	 * @return  This buffer
+	 */
+	EPooledByteBuffer* retain();
+
+	/**
+	 * Drops a reference, freeing the buffer with the last one.
+	 *
+	 * @return  <tt>true</tt> if the buffer was freed
+	 */
+	boolean release();
+
+	/**
+	 * Returns the number of references.
+	 */
+	int refCnt();
+
+	/**
+	 * Creates a slice of the remaining bytes of this buffer, sharing its
+	 * content and holding a reference to it, with one reference.
+	 */
+	EPooledByteBuffer* retainedSlice();
+
+	/**
+	 * Creates a slice of <tt>length</tt> bytes of this buffer at the
+	 * absolute <tt>index</tt>, sharing its content and holding a
+	 * reference to it, with one reference.
+	 *
+	 * @throws  IndexOutOfBoundsException
+	 *          If the slice is not within the capacity of this buffer
+	 */
+	EPooledByteBuffer* retainedSlice(int index, int length);
+
+	virtual EString toString();
+
+private:
+	friend class EIOByteBufferPool;
+
+	EAtomicInteger refs_;
+	EPooledByteBuffer* parent_;    // the buffer of a slice
+	sp<EIOByteBufferPool::Arena> arena_;
+	int sizeClass_;                // -1 if not pooled
+	long mapped_;                  // the length of an unpooled mapping
+
+	EPooledByteBuffer(void* address, int capacity);
+
+	/**
+	 * Frees the memory or the reference to the parent.
+	 */
+	void free();
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* EIOBYTEBUFFERPOOL_HH_ */
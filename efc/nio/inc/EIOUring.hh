@@ -0,0 +1,286 @@
+/*
+ * EIOUring.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EIOURING_HH_
+#define EIOURING_HH_
+
+#include "./EIOByteBuffer.hh"
+#include "./ECompletionHandler.hh"
+#include "../../inc/EIOException.hh"
+
+namespace efc {
+namespace nio {
+
+/**
+ * A completion ring on the Linux io_uring interface.
+ *
+ * <p> Operations are queued in the submission ring and handed to the kernel
+ * in batches: all of the operations queued since the previous call go in the
+ * single system call made by {@link #poll poll}, which also waits for and
+ * reaps the completions.  The result of each operation is delivered to its
+ * {@link ECompletionHandler}, in the thread which polls the ring.
+ *
+ * <p> A ring is driven by one thread: the operations must be queued and the
+ * ring polled from the same thread, only {@link #wakeup wakeup} may be
+ * invoked from any thread.  The buffer and the handler of an operation must
+ * stay valid until its last completion, i.e. until the handler is invoked
+ * with a result whose flags have no {@link #hasMore more} bit, or until
+ * {@link ECompletionHandler#failed failed} is invoked.
+ *
+ * <p> A read or write whose buffer lies in one of the {@link #registerBuffers
+ * registered buffers} uses the fixed buffer variant of the operation, which
+ * saves the kernel pinning the pages on each request.  Multishot accept and
+ * multishot recv into a {@link #setupBufferRing provided buffer ring} keep
+ * one request armed for many completions on the kernels which support them
+ * (5.19+); accept falls back to rearming itself on older kernels.
+ *
+ * <p> The ring is only available on Linux 5.11+, see {@link #isAvailable}.
+ */
+
+class EIOUring : public EObject {
+public:
+	virtual ~EIOUring();
+
+	/**
+	 * Creates a ring.
+	 *
+	 * @param  entries
+	 *         The size of the submission ring, the completion ring is twice
+	 *         as large
+	 *
+	 * @throws  IOException
+	 *          If io_uring isn't available or the ring can't be created
+	 */
+	explicit EIOUring(int entries=256) THROWS(EIOException);
+
+	/**
+	 * Tells whether io_uring is supported by the platform and the kernel.
+	 */
+	static boolean isAvailable();
+
+	// -- Operations --
+
+	/**
+	 * Queues a read of up to len bytes from the file at the given offset,
+	 * or at the file position if offset is -1.
+	 *
+	 * @return  The id of the operation, for {@link #cancel cancel}
+	 */
+	llong read(int fd, void* buf, int len, llong offset, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Queues a write of len bytes to the file at the given offset, or at the
+	 * file position if offset is -1.
+	 */
+	llong write(int fd, const void* buf, int len, llong offset, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Queues a read into the remaining bytes of dst.  When it completes, the
+	 * position of dst is advanced by the number of bytes read, and -1 is
+	 * reported at end-of-file.
+	 */
+	llong read(int fd, EIOByteBuffer* dst, llong offset, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Queues a write of the remaining bytes of src.  When it completes, the
+	 * position of src is advanced by the number of bytes written.
+	 */
+	llong write(int fd, EIOByteBuffer* src, llong offset, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Queues a receive into the remaining bytes of dst from a socket.  When
+	 * it completes, the position of dst is advanced by the number of bytes
+	 * received, and -1 is reported at end-of-stream.
+	 */
+	llong recv(int fd, EIOByteBuffer* dst, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Queues a send of the remaining bytes of src to a socket.
+	 */
+	llong send(int fd, EIOByteBuffer* src, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Queues a multishot receive from a socket into the buffers of the given
+	 * provided buffer ring: each completion carries the number of bytes
+	 * received into the buffer of {@link #getBufferId getBufferId(flags)},
+	 * which must be given back with {@link #recycleBuffer recycleBuffer}.
+	 * The receive ends at end-of-stream (a result of 0), on an error, or with
+	 * -ENOBUFS reported to failed() when the ring ran out of buffers.
+	 */
+	llong recvMultishot(int fd, int group, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Queues an accept on a listening socket, the result is the descriptor
+	 * of the new connection.  A multishot accept keeps accepting until it is
+	 * cancelled.
+	 */
+	llong accept(int fd, boolean multishot, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Queues a one shot poll of the given poll(2) events, the result is the
+	 * ready events.
+	 */
+	llong pollAdd(int fd, int events, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Changes the events of a pending poll in place.  If the poll has
+	 * completed already, this has no effect.
+	 */
+	void updatePoll(llong id, int events) THROWS(EIOException);
+
+	/**
+	 * Cancels a pending operation, whose handler will then fail with
+	 * ECANCELED unless it has completed already.
+	 */
+	void cancel(llong id) THROWS(EIOException);
+
+	// -- Buffers --
+
+	/**
+	 * Registers buffers with the kernel, replacing the ones registered
+	 * before.  The buffers must not be freed before they are unregistered or
+	 * the ring is closed.
+	 */
+	void registerBuffers(EIOByteBuffer* buffers[], int n) THROWS(EIOException);
+
+	/**
+	 * Unregisters the registered buffers.
+	 */
+	void unregisterBuffers();
+
+	/**
+	 * Creates a provided buffer ring of count buffers of the given size for
+	 * multishot receives, count is rounded up to a power of 2.
+	 *
+	 * @throws  IOException
+	 *          If the kernel doesn't support provided buffer rings
+	 */
+	void setupBufferRing(int group, int count, int size) THROWS(EIOException);
+
+	/**
+	 * Returns the address of a buffer of a provided buffer ring.
+	 */
+	void* getBuffer(int group, int bid);
+
+	/**
+	 * Gives a buffer back to its provided buffer ring, once the data
+	 * received into it has been consumed.
+	 */
+	void recycleBuffer(int group, int bid);
+
+	// -- Completion --
+
+	/**
+	 * Submits the queued operations without waiting.
+	 *
+	 * @return  The number of operations submitted
+	 */
+	int submit() THROWS(EIOException);
+
+	/**
+	 * Submits the queued operations and waits for at least one completion,
+	 * then invokes the handlers of all the completions available.
+	 *
+	 * @param  timeout
+	 *         If positive, wait for up to timeout milliseconds; if zero,
+	 *         don't wait; if negative, wait indefinitely
+	 *
+	 * @return  The number of completions delivered to the handlers, plus
+	 *          one if the ring was woken up
+	 */
+	int poll(llong timeout) THROWS(EIOException);
+
+	/**
+	 * Causes the current or the next {@link #poll poll} to return.
+	 */
+	void wakeup() THROWS(EIOException);
+
+	/**
+	 * Tells whether the last poll was woken up.
+	 */
+	boolean isWokenUp();
+
+	/**
+	 * Closes the ring: the pending operations are dropped without
+	 * completion.
+	 */
+	void close();
+
+	/**
+	 * Tells whether more completions will follow for the same multishot
+	 * operation.
+	 */
+	static boolean hasMore(int flags);
+
+	/**
+	 * Returns the id of the provided buffer that the data was received into,
+	 * or -1.
+	 */
+	static int getBufferId(int flags);
+
+	virtual EString toString();
+
+private:
+	struct Op;
+	struct BufferRing;
+
+	int ringFd_;
+	int eventFd_;
+	int features_;
+	void* sqRing_;
+	void* cqRing_;
+	void* sqes_;
+	int sqRingSize_;
+	int cqRingSize_;
+	int sqesSize_;
+
+	// submission ring
+	unsigned* sqHead_;
+	unsigned* sqTail_;
+	unsigned* sqFlags_;
+	unsigned sqMask_;
+	unsigned sqEntries_;
+	unsigned* sqArray_;
+	unsigned sqLocalTail_;
+
+	// completion ring
+	unsigned* cqHead_;
+	unsigned* cqTail_;
+	unsigned cqMask_;
+	void* cqes_;
+
+	// operations, recycled through the free list
+	Op* freeOps_;
+	Op* allOps_;
+
+	// registered buffers and provided buffer rings
+	void* iovecs_;
+	int iovecCount_;
+	BufferRing* bufferRings_;
+
+	llong wakeupValue_;
+	boolean woken_;
+	boolean wakeupArmed_;
+	boolean closed_;
+
+	void* getSqe() THROWS(EIOException);
+	Op* newOp(int kind, int fd, int len, ECompletionHandler* handler, EIOByteBuffer* buffer);
+	void freeOp(Op* op);
+	llong queueRw(int opcode, int kind, int fd, const void* buf, int len,
+			llong offset, ECompletionHandler* handler, EIOByteBuffer* buffer) THROWS(EIOException);
+	void queueAccept(Op* op) THROWS(EIOException);
+	void queueWakeup() THROWS(EIOException);
+	int enter(unsigned toSubmit, unsigned minComplete, unsigned flags, llong timeout) THROWS(EIOException);
+	int reap();
+	int dispatch(ullong userData, int res, unsigned flags);
+	int findRegistered(const void* buf, int len);
+	BufferRing* findBufferRing(int group);
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* EIOURING_HH_ */
@@ -0,0 +1,125 @@
+/*
+ * EPipeChannel.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EPIPECHANNEL_HH_
+#define EPIPECHANNEL_HH_
+
+#include "./EByteChannel.hh"
+#include "../../inc/EByteBuffer.hh"
+
+namespace efc {
+namespace nio {
+
+class ESocketChannel;
+
+/**
+ * A kernel buffer to move bytes between channels without copying them to
+ * user space.
+ *
+ * <p> On Linux a pipe channel is a pipe, filled from a socket and drained
+ * to a socket by <tt>splice</tt>: the pages move from one socket to the
+ * other in the kernel.  {@link #tee tee} duplicates the bytes held into
+ * another pipe without consuming them, to relay the same stream to several
+ * sockets.  Elsewhere the pipe channel is a user-space buffer of the same
+ * capacity, with the same behavior.
+ *
+ * <p> Bytes are moved in with {@link ESocketChannel#transferTo(EPipeChannel*, long)
+ * ESocketChannel::transferTo} or {@link #write write}, and out with {@link
+ * ESocketChannel#transferFrom ESocketChannel::transferFrom} or {@link #read
+ * read}; the pipe never blocks, a transfer moving what fits.  A pipe
+ * channel is not safe for use by multiple concurrent threads.
+ */
+
+class EPipeChannel: virtual public EByteChannel {
+public:
+	virtual ~EPipeChannel();
+
+	/**
+	 * Opens a pipe channel.
+	 *
+	 * @param capacity  the capacity in bytes, rounded up by the kernel,
+	 *                  0 for the default one
+	 */
+	static EPipeChannel* open(int capacity=0) THROWS(EIOException);
+
+	/**
+	 * Copies bytes held by this pipe into the target pipe, without
+	 * consuming them.
+	 *
+	 * @return the number of bytes copied, possibly zero
+	 */
+	long tee(EPipeChannel* target, long count) THROWS(EIOException);
+
+	/**
+	 * Returns the number of bytes held.
+	 */
+	int available();
+
+	/**
+	 * Returns the number of bytes the pipe can hold.
+	 */
+	int capacity();
+
+	/**
+	 * Reads the bytes held into dst, at most its remaining bytes.
+	 *
+	 * @return the number of bytes read, possibly zero
+	 */
+	virtual int read(EIOByteBuffer* dst) THROWS(EIOException);
+	virtual long read(EA<EIOByteBuffer*>* dsts, int offset, int length) THROWS(EIOException);
+	virtual long read(EA<EIOByteBuffer*>* dsts) THROWS(EIOException);
+
+	/**
+	 * Writes the remaining bytes of src, at most as many as the pipe
+	 * still has room for.
+	 *
+	 * @return the number of bytes written, possibly zero
+	 */
+	virtual int write(EIOByteBuffer* src) THROWS(EIOException);
+	virtual long write(EA<EIOByteBuffer*>* srcs, int offset, int length) THROWS(EIOException);
+	virtual long write(EA<EIOByteBuffer*>* srcs) THROWS(EIOException);
+
+	virtual boolean isOpen();
+	virtual void close() THROWS(EIOException);
+
+	virtual EString toString();
+
+private:
+	friend class ESocketChannel;
+
+#ifdef __linux__
+	int source_;
+	int sink_;
+#else
+	EByteBuffer buffer_;
+#endif
+	int capacity_;
+	int available_;
+	boolean open_;
+
+	EPipeChannel(int capacity) THROWS(EIOException);
+
+	void ensureOpen() THROWS(EClosedChannelException);
+
+	/**
+	 * Moves up to count bytes from the socket fd into this pipe.
+	 *
+	 * @return the number of bytes, 0 at end of stream, or an EIOStatus
+	 */
+	long fill(int fd, long count) THROWS(EIOException);
+
+	/**
+	 * Moves up to count bytes from this pipe to the socket fd.
+	 *
+	 * @return the number of bytes or an EIOStatus
+	 */
+	long drain(int fd, long count) THROWS(EIOException);
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* EPIPECHANNEL_HH_ */
@@ -0,0 +1,183 @@
+/*
+ * EReactor.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EREACTOR_HH_
+#define EREACTOR_HH_
+
+#include "../../inc/EThread.hh"
+#include "../../inc/EByteBuffer.hh"
+#include "../../inc/EArrayList.hh"
+#include "../../inc/concurrent/EReentrantLock.hh"
+#include "../../inc/concurrent/EAtomicInteger.hh"
+#include "./ESelector.hh"
+#include "./ESocketChannel.hh"
+#include "./EServerSocketChannel.hh"
+#include "./ETimerWheel.hh"
+#include "./EConnectionHandler.hh"
+
+namespace efc {
+namespace nio {
+
+class EReactor;
+class EReactorGroup;
+
+/**
+ * A connection served by an {@link EReactor}.
+ *
+ * <p> A connection is bound to one event loop for its life: its methods
+ * must be invoked in the thread of that loop, from the handler's callbacks,
+ * its timeouts or the tasks {@link EReactor#execute executed} by the loop.
+ * The connection is owned by its selection key, it must not be used once
+ * the handler's {@link EConnectionHandler#closed closed} method returned.
+ */
+
+class EReactorConnection: public EObject {
+public:
+	virtual ~EReactorConnection();
+
+	/**
+	 * Writes data, the bytes the socket does not take at once are kept
+	 * and written as the socket becomes writable, in order.
+	 *
+	 * @throws ClosedChannelException  If the connection is closed
+	 */
+	void write(const void* data, int len) THROWS(EClosedChannelException);
+
+	/**
+	 * Closes the connection, after writing the pending bytes if
+	 * <tt>flush</tt> is true.
+	 */
+	void close(boolean flush=false);
+
+	boolean isOpen();
+
+	/**
+	 * Returns the number of bytes written but not yet taken by the socket.
+	 */
+	int pendingBytes();
+
+	ESocketChannel* channel();
+	EReactor* reactor();
+	EConnectionHandler* handler();
+
+	virtual EString toString();
+
+private:
+	friend class EReactor;
+
+	EReactor* reactor_;
+	sp<ESocketChannel> channel_;
+	EConnectionHandler* handler_;
+	ESelectionKey* key_;  // owns this connection
+	EByteBuffer out_;
+	boolean open_;
+	boolean closing_;
+
+	EReactorConnection(EReactor* reactor, sp<ESocketChannel> channel,
+			EConnectionHandler* handler);
+
+	void readReady();
+	void writeReady();
+	void flush();
+};
+
+/**
+ * An event loop of an {@link EReactorGroup}.
+ *
+ * <p> Each loop is a thread, optionally pinned to a processor, with its own
+ * selector and {@link ETimerWheel timer wheel}, which serves the connections
+ * accepted by its own listening channel or handed over by the other loops.
+ * The loop selects, runs the queued tasks, then the expired timeouts:
+ * everything bound to a loop runs in its thread, without locks.
+ *
+ * <p> Other threads talk to a loop through {@link #execute execute}, which
+ * queues a task and wakes the loop up, the wakeups coalesced so that a loop
+ * costs at most one system call per iteration however many tasks it is
+ * handed.
+ */
+
+class EReactor: public EThread {
+public:
+	virtual ~EReactor();
+
+	/**
+	 * Queues a task to run in this loop, may be invoked from any thread.
+	 * The task is dropped once the loop has closed.
+	 */
+	void execute(sp<ERunnable> task);
+
+#ifdef CPP11_SUPPORT
+	void executeX(std::function<void()> func) {
+		execute(new ERunnableTarget(func));
+	}
+#endif
+
+	/**
+	 * Schedules a task to run in this loop after a delay, must be invoked
+	 * in the thread of this loop.
+	 *
+	 * @throws IllegalStateException  If invoked from another thread
+	 */
+	sp<ETimerWheel::Timeout> schedule(sp<ERunnable> task, llong delayMillis);
+
+	/**
+	 * Tells whether the current thread is the thread of this loop.
+	 */
+	boolean inLoop();
+
+	/**
+	 * Returns the number of connections bound to this loop, the ones handed
+	 * over to it included.
+	 */
+	int connectionCount();
+
+	int getIndex();
+	EReactorGroup* reactorGroup();
+	ESelector* selector();
+	ETimerWheel* timers();
+
+	virtual void run();
+
+	virtual EString toString();
+
+private:
+	friend class EReactorGroup;
+	friend class EReactorConnection;
+	class Dispatcher;
+	class Adoption;
+
+	EReactorGroup* group_;
+	int index_;
+	int cpu_;          // the processor to pin the thread to, or -1
+	ESelector* selector_;
+	ETimerWheel timers_;
+	sp<EServerSocketChannel> listener_;
+	EIOByteBuffer readBuffer_;
+	EAtomicInteger connections_;
+	volatile boolean stopped_;
+
+	// Tasks queued by the other threads, swapped out by the loop
+	EReentrantLock taskLock_;
+	EArrayList<sp<ERunnable> >* tasks_;
+	EArrayList<sp<ERunnable> >* running_;
+	volatile boolean hasTasks_;
+	boolean closed_;   // no more tasks, under taskLock_
+
+	EReactor(EReactorGroup* group, int index, int cpu);
+
+	void listen(sp<EServerSocketChannel> listener);
+	void acceptReady();
+	void bind(sp<ESocketChannel> channel);
+	void runTasks();
+	void discard(sp<ERunnable> task);
+	void closeAll();
+	void stop();
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* EREACTOR_HH_ */
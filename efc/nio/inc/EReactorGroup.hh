@@ -0,0 +1,135 @@
+/*
+ * EReactorGroup.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef EREACTORGROUP_HH_
+#define EREACTORGROUP_HH_
+
+#include "./EReactor.hh"
+#include "../../inc/EInetSocketAddress.hh"
+
+namespace efc {
+namespace nio {
+
+/**
+ * A TCP server run by several event loops.
+ *
+ * <p> The group runs one {@link EReactor} per thread, each pinned to a
+ * processor when the platform allows it.  Where SO_REUSEPORT is supported
+ * every loop has its own listening channel bound to the same address, the
+ * kernel spreading the incoming connections among them, so that there is
+ * no single accepting thread; elsewhere the first loop listens alone and
+ * hands the connections over.
+ *
+ * <p> Connections are balanced by count: a loop which accepts a connection
+ * while serving more than <tt>balanceThreshold</tt> connections above the
+ * least loaded loop hands it over to that loop.
+ *
+ * <p> Each accepted connection is given its own {@link EConnectionHandler},
+ * created by the group's factory, and is served by one loop for its life.
+ *
+ * <blockquote><pre>
+ * EReactorGroup group(&factory, 4);
+ * EInetSocketAddress isa(8080);
+ * group.bind(&isa);
+ * group.start();
+ * ...
+ * group.shutdown();
+ * </pre></blockquote>
+ */
+
+class EReactorGroup: public EObject {
+public:
+	virtual ~EReactorGroup();
+
+	/**
+	 * Creates a group.
+	 *
+	 * @param factory   the factory of the connection handlers, not owned
+	 * @param nThreads  the number of event loops, 0 for one per processor
+	 * @param pinning   true to pin the loops to the processors
+	 */
+	EReactorGroup(EConnectionHandlerFactory* factory, int nThreads=0,
+			boolean pinning=true);
+
+	/**
+	 * Binds the listening channels, before {@link #start start}.
+	 *
+	 * @param local     the address, its port may be 0
+	 * @param backlog   the backlog of each listening channel
+	 *
+	 * @throws IOException  If a channel cannot be bound
+	 */
+	void bind(EInetSocketAddress* local, int backlog=128) THROWS(EIOException);
+
+	/**
+	 * Starts the event loops.
+	 */
+	void start();
+
+	/**
+	 * Stops the event loops and closes the listening channels and the
+	 * connections, then waits for the loops' threads to end.
+	 */
+	void shutdown();
+
+	/**
+	 * Sets by how many connections a loop may exceed the least loaded
+	 * loop before handing the connections it accepts over, 0 to hand
+	 * every connection over to the least loaded loop.
+	 */
+	void setBalanceThreshold(int threshold);
+
+	/**
+	 * Tells whether every loop listens on its own channel.
+	 */
+	boolean isSharded();
+
+	/**
+	 * Returns the port the group listens on, or -1 if not bound.
+	 */
+	int getLocalPort();
+
+	int size();
+	EReactor* getReactor(int index);
+
+	/**
+	 * Returns the loops in turn, to spread work among them.
+	 */
+	EReactor* next();
+
+	/**
+	 * Returns the loop serving the fewest connections.
+	 */
+	EReactor* leastLoaded();
+
+	/**
+	 * Returns the number of connections served by the group.
+	 */
+	int connectionCount();
+
+	virtual EString toString();
+
+private:
+	friend class EReactor;
+
+	EConnectionHandlerFactory* factory_;
+	EA<EReactor*> reactors_;
+	EAtomicInteger next_;
+	int balanceThreshold_;
+	boolean sharded_;
+	int localPort_;
+	boolean started_;
+
+	/**
+	 * Returns the loop to serve a connection accepted by the given loop.
+	 */
+	EReactor* balance(EReactor* acceptor);
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* EREACTORGROUP_HH_ */
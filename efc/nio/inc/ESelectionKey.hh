@@ -370,9 +370,11 @@ public:
 	void nioInterestOps(int ops);
 	int nioInterestOps();
 	void invalidate();
+	ESelectableChannel* nioChannel();
 
 protected:
 	friend class ESelector;
+	friend class ESelectedKeySet;
 
 	ESelectionKey(sp<ESelectableChannel> ch, ESelector* sel);
 
@@ -387,7 +389,15 @@ private:
 	// Index for a pollfd array in Selector that this key is registered with
 	int index_;
 
-	boolean binded_;
+	// Set once the selector has registered this key, the interest set
+	// is only handed to the selector from then on
+	volatile boolean binded_;
+
+	// Link in the selector's queue of keys waiting to be registered
+	ESelectionKey* nextNew_;
+
+	// Slot of this key in the selected-key set, or -1
+	int selectedIndex_;
 
 	void ensureValid();
 };
@@ -0,0 +1,60 @@
+/*
+ * ESelectionKeyConsumer.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ESELECTIONKEYCONSUMER_HH_
+#define ESELECTIONKEYCONSUMER_HH_
+
+#include "../../inc/EObject.hh"
+
+namespace efc {
+namespace nio {
+
+class ESelectionKey;
+
+/**
+ * An action performed upon the keys selected by a selection operation.
+ *
+ * <p> The action is invoked by {@link ESelector#select(ESelectionKeyConsumer*,llong)}
+ * and {@link ESelector#selectNow(ESelectionKeyConsumer*)} in the selecting
+ * thread, once for each key whose channel is ready for at least one of the
+ * operations of its interest set, while the selector is locked as for any
+ * selection operation.  The key is not added to the selected-key set.
+ *
+ * @see ESelector
+ */
+
+interface ESelectionKeyConsumer : virtual public EObject {
+	virtual ~ESelectionKeyConsumer(){}
+
+	/**
+	 * Performs this action upon a ready key.
+	 *
+	 * @param   key
+	 *          The selected key, its ready set is the set of the operations
+	 *          the channel was reported to be ready for
+	 */
+	virtual void accept(ESelectionKey* key) = 0;
+};
+
+#ifdef CPP11_SUPPORT
+class ESelectionKeyConsumerTarget: public ESelectionKeyConsumer {
+public:
+	virtual ~ESelectionKeyConsumerTarget(){}
+
+	ESelectionKeyConsumerTarget(std::function<void(ESelectionKey*)>& f) : f(f) {
+	}
+	virtual void accept(ESelectionKey* key) {
+		f(key);
+	}
+private:
+	std::function<void(ESelectionKey*)>& f;
+};
+#endif
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* ESELECTIONKEYCONSUMER_HH_ */
@@ -13,13 +13,17 @@
 #include "../../inc/EHashMap.hh"
 #include "../../inc/ESynchronizeable.hh"
 #include "../../inc/concurrent/EAtomicBoolean.hh"
+#include "../../inc/concurrent/EAtomicReference.hh"
 #include "../../inc/EIOException.hh"
 #include "./ESelectableChannel.hh"
 #include "./EClosedSelectorException.hh"
+#include "./ESelectionKeyConsumer.hh"
 
 namespace efc {
 namespace nio {
 
+class ESelectedKeySet;
+
 //@see: openjdk-8/src/share/classes/java/nio/channels/Selector.java
 
 /**
@@ -362,6 +366,68 @@ public:
 	 */
 	int selectNow() THROWS(EIOException);
 
+	/**
+	 * Selects and performs an action on the keys whose corresponding
+	 * channels are ready for I/O operations.
+	 *
+	 * <p> This method performs a blocking <a href="#selop">selection
+	 * operation</a> as {@link #select(llong)} does, except that the ready
+	 * keys are not added to the selected-key set: the given action is
+	 * invoked once for each key whose channel is ready for at least one of
+	 * the operations of its interest set, with the key's ready set holding
+	 * exactly the operations the channel was reported to be ready for.
+	 * The selected-key set is neither used nor changed.
+	 *
+	 * <p> The action is invoked while the selector is locked, it may cancel
+	 * keys or change their interest sets, but must not close the selector
+	 * nor start another selection operation on it.
+	 *
+	 * @param  action   The action to perform
+	 *
+	 * @param  timeout  As for {@link #select(llong)}
+	 *
+	 * @return  The number of unique keys consumed, possibly zero
+	 *
+	 * @throws  IOException
+	 *          If an I/O error occurs
+	 *
+	 * @throws  ClosedSelectorException
+	 *          If this selector is closed or is closed by the action
+	 *
+	 * @throws  IllegalArgumentException
+	 *          If the value of the timeout argument is negative
+	 */
+	int select(ESelectionKeyConsumer* action, llong timeout=0) THROWS(EIOException);
+
+	/**
+	 * Selects and performs an action on the keys whose corresponding
+	 * channels are ready for I/O operations, as {@link
+	 * #select(ESelectionKeyConsumer*,llong)} does, without blocking.
+	 *
+	 * @param  action   The action to perform
+	 *
+	 * @return  The number of unique keys consumed, possibly zero
+	 *
+	 * @throws  IOException
+	 *          If an I/O error occurs
+	 *
+	 * @throws  ClosedSelectorException
+	 *          If this selector is closed or is closed by the action
+	 */
+	int selectNow(ESelectionKeyConsumer* action) THROWS(EIOException);
+
+#ifdef CPP11_SUPPORT
+	int selectX(std::function<void(ESelectionKey*)> action, llong timeout=0) {
+		ESelectionKeyConsumerTarget target(action);
+		return select(&target, timeout);
+	}
+
+	int selectNowX(std::function<void(ESelectionKey*)> action) {
+		ESelectionKeyConsumerTarget target(action);
+		return selectNow(&target);
+	}
+#endif
+
 	/**
 	 * Causes the first selection operation that has not yet returned to return
 	 * immediately.
@@ -478,9 +544,13 @@ protected:
 	ELock* keysLock_;
 
 	// Reference views of the key sets
-	EHashSet<sp<ESelectionKey> >* selectedKeys_; // Removal allowed, but not addition
+	ESelectedKeySet* selectedKeys_; // Removal allowed, but not addition
 	ELock* selectedKeysLock_;
 
+	// The action of the selection operation in progress, null when the
+	// ready keys are added to the selected-key set
+	ESelectionKeyConsumer* action_;
+
 	//@see: openjdk-8/src/share/classes/java/nio/channels/spi/AbstractSelector.java
     EHashSet<sp<ESelectionKey> >* cancelledKeys_;// = new HashSet();
     ELock* cancelledKeysLock_;
@@ -496,8 +566,23 @@ protected:
 	virtual void implClose() THROWS(EIOException) = 0;
 	virtual int doSelect(llong timeout) THROWS(EIOException) = 0;
 
+	/**
+	 * Sets the ready set of a key whose channel the operating system
+	 * reported ready for the given events, and adds the key to the
+	 * selected-key set or passes it to the action of the selection
+	 * operation.  Invoked by the implementations for each ready channel.
+	 *
+	 * @return  1 if the key was updated, 0 otherwise
+	 */
+	int processReadyEvents(int rOps, ESelectionKey* ski);
+
 private:
-	int lockAndDoSelect(llong timeout) THROWS(EIOException);
+	// The keys registered since the last selection operation, a stack
+	// linked through the keys, replaced by a sentinel when closed
+	EAtomicReference<ESelectionKey*> newKeys_;
+
+	int lockAndDoSelect(ESelectionKeyConsumer* action, llong timeout) THROWS(EIOException);
+	void processRegistrationQueue(ESelectionKey* head);
 };
 
 } /* namespace nio */
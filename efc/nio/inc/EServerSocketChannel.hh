@@ -168,6 +168,24 @@ public:
 	 */
 	ESocketChannel* accept() THROWS(EIOException);
 
+	/**
+	 * Queues an accept on the given io_uring, see {@link EIOUring#accept}.
+	 * The result handed to the handler is the descriptor of the new
+	 * connection, to be wrapped with {@link #accept(int)}.
+	 *
+	 * @param  multishot
+	 *         Whether to keep accepting until the operation is cancelled
+	 *
+	 * @return  The id of the operation
+	 */
+	llong accept(EIOUring* ring, ECompletionHandler* handler, boolean multishot=false) THROWS(EIOException);
+
+	/**
+	 * Returns a socket channel, in blocking mode, for a connection accepted
+	 * on an io_uring.
+	 */
+	ESocketChannel* accept(int fd) THROWS(EIOException);
+
 	/**
 	 *
 	 */
@@ -20,6 +20,9 @@
 #include "../../inc/EAlreadyBoundException.hh"
 #include "./EByteChannel.hh"
 #include "./EIOByteBuffer.hh"
+#include "./EIOUring.hh"
+#include "./EPipeChannel.hh"
+#include "./ECompletionHandler.hh"
 #include "./ESelectionKey.hh"
 #include "./ESelector.hh"
 #include "./ESocketChannel.hh"
@@ -379,6 +382,135 @@ public:
 	 */
 	virtual long write(EA<EIOByteBuffer*>* srcs) THROWS(EIOException);
 
+	// -- Completion-based operations --
+
+	/**
+	 * Queues a read into dst on the given io_uring, see {@link EIOUring#recv}.
+	 * The channel should be in non-blocking mode, and dst and the handler
+	 * must stay valid until the handler is invoked.
+	 *
+	 * @return  The id of the operation, or -1 if the input side of the
+	 *          channel is shut down
+	 *
+	 * @throws  NotYetConnectedException
+	 *          If this channel is not yet connected
+	 */
+	llong read(EIOByteBuffer* dst, EIOUring* ring, ECompletionHandler* handler) THROWS(EIOException);
+
+	/**
+	 * Queues a write of src on the given io_uring, see {@link EIOUring#send}.
+	 *
+	 * @throws  NotYetConnectedException
+	 *          If this channel is not yet connected
+	 */
+	llong write(EIOByteBuffer* src, EIOUring* ring, ECompletionHandler* handler) THROWS(EIOException);
+
+	// -- Zero-copy transfers --
+
+	/**
+	 * Transfers bytes read from this channel to the given channel without
+	 * copying them to user space, through a pipe held by this channel and
+	 * <tt>splice</tt> on Linux, to relay a stream between sockets.
+	 *
+	 * <p> The bytes read but not yet taken by a non-blocking target are
+	 * kept, see {@link #pendingTransfer}, and written first by the next
+	 * invocation, which should then be given the same target.  If this
+	 * channel is in blocking mode this method waits for the first bytes
+	 * only.
+	 *
+	 * @param  target
+	 *         The channel to write the bytes to
+	 * @param  count
+	 *         The maximum number of bytes to transfer
+	 *
+	 * @return  The number of bytes written to the target, possibly zero,
+	 *          or -1 if this channel has reached end-of-stream and no byte
+	 *          is pending
+	 *
+	 * @throws  NotYetConnectedException
+	 *          If either channel is not yet connected
+	 */
+	long transferTo(ESocketChannel* target, long count) THROWS(EIOException);
+	long transferTo(ESocketChannel* target) THROWS(EIOException);
+
+	/**
+	 * Returns the number of bytes read by {@link #transferTo(ESocketChannel*, long)
+	 * transferTo} but not yet written to the target.
+	 */
+	int pendingTransfer();
+
+	/**
+	 * Reads at most count bytes from this channel into the given pipe,
+	 * as much as it has room for.
+	 *
+	 * @return  The number of bytes read, possibly zero, or -1 if this
+	 *          channel has reached end-of-stream
+	 */
+	long transferTo(EPipeChannel* target, long count) THROWS(EIOException);
+
+	/**
+	 * Writes at most count bytes held by the given pipe to this channel.
+	 *
+	 * @return  The number of bytes written, possibly zero
+	 */
+	long transferFrom(EPipeChannel* src, long count) THROWS(EIOException);
+
+	// -- Zero-copy sends --
+
+	/**
+	 * The completion flag of a zero-copy send whose bytes were copied
+	 * after all, by the kernel or because the send was too small.
+	 */
+	static const int ZEROCOPY_COPIED = 1;
+
+	/**
+	 * Writes with MSG_ZEROCOPY on Linux: the kernel sends the pages of
+	 * the buffer instead of copying them, so that the buffer must not be
+	 * modified until the send has completed.  The channel holds the buffer
+	 * until then, and invokes the handler's {@link ECompletionHandler#completed
+	 * completed} method with the number of bytes of this send, and
+	 * {@link #ZEROCOPY_COPIED} if they were copied after all.
+	 *
+	 * <p> Completions are collected by {@link #reapZeroCopy}, which a
+	 * selector invokes when the channel is registered with it: the
+	 * completions then make the key ready for <tt>OP_WRITE</tt>, if in its
+	 * interest set, and the handlers run in the selecting thread.  Sends
+	 * smaller than 16KB, where pinning costs more than copying, and sends on
+	 * systems without MSG_ZEROCOPY are plain writes, completed at once.
+	 *
+	 * <p> Over loopback the kernel always copies; zero-copy pays off for
+	 * large writes to a network card.  Sends still pending when the
+	 * channel is destroyed are dropped without invoking their handlers.
+	 *
+	 * @param  src      the buffer, written from its position as by write
+	 * @param  handler  invoked once the buffer may be reused, or null
+	 *
+	 * @return  The number of bytes written, possibly zero
+	 *
+	 * @throws  NotYetConnectedException
+	 *          If this channel is not yet connected
+	 */
+	int writeZeroCopy(sp<EIOByteBuffer> src, ECompletionHandler* handler=null) THROWS(EIOException);
+
+	/**
+	 * Collects the completions of the zero-copy sends from the socket's
+	 * error queue, releasing their buffers and invoking their handlers in
+	 * the order of the sends.
+	 *
+	 * @return  The number of sends completed
+	 */
+	int reapZeroCopy() THROWS(EIOException);
+
+	/**
+	 * Returns the number of zero-copy sends not yet completed.
+	 */
+	int zeroCopyPending();
+
+	/**
+	 * Returns the number of zero-copy sends the kernel copied after all.
+	 */
+	llong zeroCopyCopied();
+
 	/**
 	 *
 	 */
@@ -452,6 +584,13 @@ private:
 	// State, increases monotonically
 	byte _state;	// = ST_UNINITIALIZED;
 
+	// Holds the bytes in flight of transferTo, created on demand
+	EPipeChannel* _transferPipe;// = null;
+
+	// The sends pinned by writeZeroCopy, created on demand
+	class ZeroCopyState;
+	ZeroCopyState* volatile _zeroCopy;// = null;
+
 	/**
 	 * Initializes a new instance of this class.
 	 */
@@ -472,6 +611,8 @@ private:
 	 * Translates native poll revent ops into a ready operation ops
 	 */
 	boolean translateReadyOps(int ops, int initialOps, ESelectionKey* sk);
+
+	ZeroCopyState* zeroCopyState();
 };
 
 } /* namespace nio */
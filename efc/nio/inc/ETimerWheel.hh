@@ -0,0 +1,113 @@
+/*
+ * ETimerWheel.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ETIMERWHEEL_HH_
+#define ETIMERWHEEL_HH_
+
+#include "../../inc/EObject.hh"
+#include "../../inc/ERunnable.hh"
+#include "../../inc/EArrayList.hh"
+
+namespace efc {
+namespace nio {
+
+/**
+ * A hashed timing wheel, for the timeouts of an event loop.
+ *
+ * <p> The time is divided in ticks of a fixed duration and the timeouts are
+ * hashed by the tick of their deadline into a ring of buckets, so that
+ * scheduling and cancelling a timeout cost a constant time however many
+ * are pending, at the price of a precision of one tick.  Timeouts are
+ * never run early; they run at the first {@link #expire expire} after
+ * the tick of their deadline.
+ *
+ * <p> A wheel is not thread-safe: it is driven by the thread of its event
+ * loop, which schedules and cancels the timeouts, asks for the time it
+ * may wait, and expires the timeouts once done waiting.
+ */
+
+class ETimerWheel: public EObject {
+public:
+	/**
+	 * A handle to a scheduled task.
+	 */
+	class Timeout: public EObject {
+	public:
+		/**
+		 * Cancels the task, returns false if it was already run or cancelled.
+		 */
+		boolean cancel();
+		boolean isCancelled();
+		boolean isExpired();
+
+	private:
+		friend class ETimerWheel;
+		sp<ERunnable> task;
+		llong tick;   // the tick of the deadline
+		int state;    // 0 pending, 1 expired, 2 cancelled
+
+		Timeout(sp<ERunnable> task, llong tick);
+	};
+
+public:
+	virtual ~ETimerWheel();
+
+	/**
+	 * Creates a wheel.
+	 *
+	 * @param tickMillis    the duration of a tick, in milliseconds
+	 * @param ticksPerWheel the number of buckets, rounded up to a power of 2
+	 */
+	ETimerWheel(llong tickMillis=10, int ticksPerWheel=512);
+
+	/**
+	 * Schedules a task to run after a delay.
+	 *
+	 * @param task        the task
+	 * @param delayMillis the delay, in milliseconds
+	 * @return the handle to cancel the task
+	 */
+	sp<Timeout> schedule(sp<ERunnable> task, llong delayMillis);
+
+	/**
+	 * Runs the tasks whose deadline is reached.
+	 *
+	 * @return the number of tasks run
+	 */
+	int expire();
+
+	/**
+	 * Returns the time the caller may wait before the next task is due,
+	 * in milliseconds, 0 if a task is due, or -1 if no task is pending.
+	 */
+	llong nextDelay();
+
+	/**
+	 * Returns the number of pending tasks, cancelled ones included until
+	 * their bucket is visited.
+	 */
+	int size();
+
+	virtual EString toString();
+
+private:
+	llong tickMillis_;
+	int mask_;
+	EArrayList<sp<Timeout> >** buckets_;
+	llong startMillis_;
+	llong currentTick_;  // the last tick expired
+	llong nextTick_;     // no pending task is due before this tick
+	int size_;
+
+	static llong now();
+	llong tickOf(llong millis);
+	void updateNextTick();
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* ETIMERWHEEL_HH_ */
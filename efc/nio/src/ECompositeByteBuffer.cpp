@@ -0,0 +1,401 @@
+/*
+ * ECompositeByteBuffer.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "../inc/ECompositeByteBuffer.hh"
+#include "../inc/EBufferOverflowException.hh"
+#include "../../inc/EStream.hh"
+#include "../../inc/ENullPointerException.hh"
+
+namespace efc {
+namespace nio {
+
+/*
+ * A range of a buffer, at an index of the composite buffer.
+ */
+class ECompositeByteBuffer::Component: public EObject {
+public:
+	sp<EIOByteBuffer> buffer; // null for external memory
+	char* address;
+	int length;
+	int offset;
+
+	Component(sp<EIOByteBuffer> buffer, const void* address, int length, int offset) :
+			buffer(buffer), address((char*)address), length(length), offset(offset) {
+	}
+
+	int end() {
+		return offset + length;
+	}
+};
+
+ECompositeByteBuffer::~ECompositeByteBuffer() {
+	//
+}
+
+ECompositeByteBuffer::ECompositeByteBuffer() :
+		position_(0), limit_(0), capacity_(0), last_(0) {
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::addComponent(sp<EIOByteBuffer> buffer) {
+	if (buffer == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	int length = buffer->remaining();
+	if (length > 0) {
+		components_.add(new Component(buffer, buffer->current(), length, capacity_));
+		if (limit_ == capacity_) {
+			limit_ += length;
+		}
+		capacity_ += length;
+	}
+	return this;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::addComponent(const void* address, int length) {
+	if (address == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	if (length < 0) {
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+	}
+	if (length > 0) {
+		components_.add(new Component(null, address, length, capacity_));
+		if (limit_ == capacity_) {
+			limit_ += length;
+		}
+		capacity_ += length;
+	}
+	return this;
+}
+
+int ECompositeByteBuffer::numComponents() {
+	return components_.size();
+}
+
+EIOByteBuffer* ECompositeByteBuffer::component(int index) {
+	return components_.getAt(index)->buffer.get();
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::discardReadComponents() {
+	int n = 0;
+	while (n < components_.size() && components_.getAt(n)->end() <= position_) {
+		n++;
+	}
+	if (n == 0) {
+		return this;
+	}
+	int discarded = components_.getAt(n - 1)->end();
+	for (int i = 0; i < n; i++) {
+		delete components_.removeAt(0);
+	}
+	for (int i = 0; i < components_.size(); i++) {
+		components_.getAt(i)->offset -= discarded;
+	}
+	position_ -= discarded;
+	limit_ -= discarded;
+	capacity_ -= discarded;
+	last_ = 0;
+	return this;
+}
+
+int ECompositeByteBuffer::capacity() {
+	return capacity_;
+}
+
+int ECompositeByteBuffer::position() {
+	return position_;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::position(int newPosition) {
+	if ((newPosition > limit_) || (newPosition < 0))
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+	position_ = newPosition;
+	return this;
+}
+
+int ECompositeByteBuffer::limit() {
+	return limit_;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::limit(int newLimit) {
+	if ((newLimit > capacity_) || (newLimit < 0))
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+	limit_ = newLimit;
+	if (position_ > limit_)
+		position_ = limit_;
+	return this;
+}
+
+int ECompositeByteBuffer::remaining() {
+	return limit_ - position_;
+}
+
+boolean ECompositeByteBuffer::hasRemaining() {
+	return position_ < limit_;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::clear() {
+	position_ = 0;
+	limit_ = capacity_;
+	return this;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::flip() {
+	limit_ = position_;
+	position_ = 0;
+	return this;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::rewind() {
+	position_ = 0;
+	return this;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::skip(int size) {
+	return position(position_ + size);
+}
+
+byte ECompositeByteBuffer::get() {
+	if (position_ >= limit_)
+		throw EBUFFERUNDERFLOWEXCEPTION;
+	byte b = get(position_);
+	position_++;
+	return b;
+}
+
+byte ECompositeByteBuffer::get(int index) {
+	if (index < 0 || index >= limit_)
+		throw EBUFFERUNDERFLOWEXCEPTION;
+	Component* c = components_.getAt(componentOf(index));
+	return c->address[index - c->offset];
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::get(void* dst, int length) {
+	get(position_, dst, length);
+	position_ += length;
+	return this;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::get(int index, void* dst, int length) {
+	if (index < 0 || length < 0 || index > limit_ - length)
+		throw EBUFFERUNDERFLOWEXCEPTION;
+	copy(index, dst, length, false);
+	return this;
+}
+
+short ECompositeByteBuffer::getShort() {
+	byte v[2];
+	get(v, 2);
+	return EStream::readShort(v);
+}
+
+short ECompositeByteBuffer::getShort(int index) {
+	byte v[2];
+	get(index, v, 2);
+	return EStream::readShort(v);
+}
+
+int ECompositeByteBuffer::getInt() {
+	byte v[4];
+	get(v, 4);
+	return EStream::readInt(v);
+}
+
+int ECompositeByteBuffer::getInt(int index) {
+	byte v[4];
+	get(index, v, 4);
+	return EStream::readInt(v);
+}
+
+llong ECompositeByteBuffer::getLLong() {
+	byte v[8];
+	get(v, 8);
+	return EStream::readLLong(v);
+}
+
+llong ECompositeByteBuffer::getLLong(int index) {
+	byte v[8];
+	get(index, v, 8);
+	return EStream::readLLong(v);
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::put(byte b) {
+	if (position_ >= limit_)
+		throw EBufferOverflowException(__FILE__, __LINE__);
+	put(position_, b);
+	position_++;
+	return this;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::put(int index, byte b) {
+	if (index < 0 || index >= limit_)
+		throw EBufferOverflowException(__FILE__, __LINE__);
+	Component* c = components_.getAt(componentOf(index));
+	c->address[index - c->offset] = b;
+	return this;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::put(const void* src, int length) {
+	put(position_, src, length);
+	position_ += length;
+	return this;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::put(int index, const void* src, int length) {
+	if (index < 0 || length < 0 || index > limit_ - length)
+		throw EBufferOverflowException(__FILE__, __LINE__);
+	copy(index, (void*)src, length, true);
+	return this;
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::putShort(short value) {
+	byte v[2];
+	EStream::writeShort(v, value);
+	return put(v, 2);
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::putInt(int value) {
+	byte v[4];
+	EStream::writeInt(v, value);
+	return put(v, 4);
+}
+
+ECompositeByteBuffer* ECompositeByteBuffer::putLLong(llong value) {
+	byte v[8];
+	EStream::writeLLong(v, value);
+	return put(v, 8);
+}
+
+int ECompositeByteBuffer::indexOf(byte value) {
+	return indexOf(position_, limit_, value);
+}
+
+int ECompositeByteBuffer::indexOf(int fromIndex, int toIndex, byte value) {
+	fromIndex = ES_MAX(fromIndex, 0);
+	toIndex = ES_MIN(toIndex, limit_);
+	if (fromIndex >= toIndex) {
+		return -1;
+	}
+	// memchr over each component in turn
+	for (int i = componentOf(fromIndex); i < components_.size(); i++) {
+		Component* c = components_.getAt(i);
+		if (c->offset >= toIndex) {
+			break;
+		}
+		int from = ES_MAX(fromIndex, c->offset);
+		int to = ES_MIN(toIndex, c->end());
+		char* p = (char*)memchr(c->address + (from - c->offset), value, to - from);
+		if (p != NULL) {
+			return c->offset + (int)(p - c->address);
+		}
+	}
+	return -1;
+}
+
+int ECompositeByteBuffer::indexOf(const void* pattern, int length) {
+	if (pattern == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	if (length <= 0) {
+		return (length == 0) ? position_ : -1;
+	}
+	const byte* p = (const byte*)pattern;
+	int last = limit_ - length;
+	int i = position_;
+	while (i <= last) {
+		// candidates by their first byte, then compared across components
+		i = indexOf(i, last + 1, p[0]);
+		if (i < 0) {
+			return -1;
+		}
+		int j = 1;
+		while (j < length && get(i + j) == p[j]) {
+			j++;
+		}
+		if (j == length) {
+			return i;
+		}
+		i++;
+	}
+	return -1;
+}
+
+sp<EA<EIOByteBuffer*> > ECompositeByteBuffer::nioBuffers() {
+	if (!hasRemaining()) {
+		return new EA<EIOByteBuffer*>(0);
+	}
+	int first = componentOf(position_);
+	int count = componentOf(limit_ - 1) - first + 1;
+	sp<EA<EIOByteBuffer*> > buffers = new EA<EIOByteBuffer*>(count);
+	for (int i = 0; i < count; i++) {
+		Component* c = components_.getAt(first + i);
+		int from = ES_MAX(position_, c->offset);
+		int to = ES_MIN(limit_, c->end());
+		(*buffers)[i] = new EIOByteBuffer(c->address + (from - c->offset), to - from);
+	}
+	return buffers;
+}
+
+long ECompositeByteBuffer::write(EByteChannel* channel) {
+	if (channel == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	if (!hasRemaining()) {
+		return 0;
+	}
+	sp<EA<EIOByteBuffer*> > buffers = nioBuffers();
+	long n = channel->write(buffers.get());
+	if (n > 0) {
+		position_ += (int)n;
+	}
+	return n;
+}
+
+EString ECompositeByteBuffer::toString() {
+	return EString::formatOf("ECompositeByteBuffer[pos=%d lim=%d cap=%d components=%d]",
+			position_, limit_, capacity_, components_.size());
+}
+
+int ECompositeByteBuffer::componentOf(int index) {
+	Component* c = components_.getAt(last_);
+	if (index >= c->offset && index < c->end()) {
+		return last_;
+	}
+	// binary search on the offsets
+	int lo = 0;
+	int hi = components_.size() - 1;
+	while (lo < hi) {
+		int mid = (lo + hi + 1) >> 1;
+		if (components_.getAt(mid)->offset <= index) {
+			lo = mid;
+		} else {
+			hi = mid - 1;
+		}
+	}
+	last_ = lo;
+	return lo;
+}
+
+void ECompositeByteBuffer::copy(int index, void* buf, int length, boolean toComponents) {
+	char* p = (char*)buf;
+	while (length > 0) {
+		Component* c = components_.getAt(componentOf(index));
+		int off = index - c->offset;
+		int n = ES_MIN(length, c->length - off);
+		if (toComponents) {
+			memcpy(c->address + off, p, n);
+		} else {
+			memcpy(p, c->address + off, n);
+		}
+		index += n;
+		p += n;
+		length -= n;
+	}
+}
+
+} /* namespace nio */
+} /* namespace efc */
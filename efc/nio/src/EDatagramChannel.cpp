@@ -707,6 +707,199 @@ int EDatagramChannel::send(EIOByteBuffer* src, const char* hostname, int port) {
 	return this->send(src, &isa);
 }
 
+int EDatagramChannel::receiveBatch(EA<EIOByteBuffer*>* dsts,
+		EA<sp<EInetSocketAddress> >* sources, EA<int>* segments) {
+	if (dsts == null)
+		throw ENullPointerException(__FILE__, __LINE__);
+	int length = dsts->length();
+	if ((sources != null && sources->length() < length)
+			|| (segments != null && segments->length() < length))
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Array shorter than the buffers");
+	for (int i = 0; i < length; i++) {
+		EIOByteBuffer* dst = (*dsts)[i];
+		if (dst == null)
+			throw ENullPointerException(__FILE__, __LINE__);
+		if (dst->isReadOnly())
+			throw EIllegalArgumentException(__FILE__, __LINE__, "Read-only buffer");
+	}
+
+	SYNCBLOCK(&_readLock) {
+		ensureOpen();
+		// Socket was not bound before attempting receive
+		if (_localAddress == null)
+			bind(null);
+		EDatagramDispatcher::Peer peers[EDatagramDispatcher::MAX_BATCH];
+		int n = 0;
+		int total = 0;
+		try {
+			begin();
+			if (!isOpen()) {
+				goto FINALLY;
+			}
+			_readerThread = ENativeThread::current();
+			while (total < length) {
+				int count = length - total;
+				if (count > EDatagramDispatcher::MAX_BATCH)
+					count = EDatagramDispatcher::MAX_BATCH;
+				// only the first call may block
+				do {
+					n = EDatagramDispatcher::recvmmsg(_fd, dsts, total, count,
+							isConnected(), (total > 0), peers);
+				} while ((n == EIOStatus::INTERRUPTED) && isOpen() && (total == 0));
+				if (n <= 0)
+					break;
+				for (int i = 0; i < n; i++) {
+					if (sources != null) {
+						// the source of a flow is mostly the same as before
+						sp<EInetSocketAddress>& isa = (*sources)[total + i];
+						if (isa == null || isa->getPort() != peers[i].port
+								|| isa->getAddress() == null
+								|| isa->getAddress()->getAddress() != peers[i].addr) {
+							isa = new EInetSocketAddress(peers[i].addr, peers[i].port);
+						}
+					}
+					if (segments != null) {
+						(*segments)[total + i] = peers[i].segSize;
+					}
+				}
+				_sender.addr = peers[n - 1].addr;
+				_sender.port = peers[n - 1].port;
+				total += n;
+				if (n < count)
+					break;
+			}
+		} catch (...) {
+			finally {
+				_readerThread = 0;
+				end((total > 0) || (n == EIOStatus::UNAVAILABLE));
+				ES_ASSERT(EIOStatus::check(n));
+			}
+			throw; //!
+		}
+		FINALLY:
+		finally {
+			_readerThread = 0;
+			end((total > 0) || (n == EIOStatus::UNAVAILABLE));
+			ES_ASSERT(EIOStatus::check(n));
+		}
+		return total;
+    }}
+}
+
+int EDatagramChannel::sendBatch(EA<EIOByteBuffer*>* srcs, EA<EInetSocketAddress*>* targets) {
+	return sendBatch(srcs, null, targets);
+}
+
+int EDatagramChannel::sendBatch(EA<EIOByteBuffer*>* srcs, EInetSocketAddress* target) {
+	if (target == null)
+		throw ENullPointerException(__FILE__, __LINE__);
+	return sendBatch(srcs, target, null);
+}
+
+int EDatagramChannel::sendBatch(EA<EIOByteBuffer*>* srcs, EInetSocketAddress* target,
+		EA<EInetSocketAddress*>* targets) {
+	if (srcs == null)
+		throw ENullPointerException(__FILE__, __LINE__);
+	int length = srcs->length();
+	if (targets != null && targets->length() < length)
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Array shorter than the buffers");
+	for (int i = 0; i < length; i++) {
+		if ((*srcs)[i] == null)
+			throw ENullPointerException(__FILE__, __LINE__);
+	}
+
+	SYNCBLOCK(&_writeLock) {
+		ensureOpen();
+		boolean connected;
+		SYNCBLOCK(&_stateLock) {
+			connected = isConnected();
+			if (!connected && target == null && targets == null)
+				throw ENotYetConnectedException(__FILE__, __LINE__);
+        }}
+		// checked once for all before anything is sent
+		for (int i = 0; i < length; i++) {
+			EInetSocketAddress* isa = (targets != null) ? (*targets)[i] : target;
+			if (isa == null) {
+				if (connected && targets == null)
+					break;
+				throw ENullPointerException(__FILE__, __LINE__);
+			}
+			if (connected) {
+				if (!isa->equals(_remoteAddress.get()))
+					throw EIllegalArgumentException(__FILE__, __LINE__,
+						"Connected address not equal to target address");
+			} else {
+				ENetWrapper::checkAddress(isa);
+				if (isa->getAddress() == null)
+					throw EIOException(__FILE__, __LINE__, "Target address not resolved");
+			}
+			if (targets == null)
+				break;
+		}
+
+		EDatagramDispatcher::Peer peers[EDatagramDispatcher::MAX_BATCH];
+		int n = 0;
+		int total = 0;
+		try {
+			begin();
+			if (!isOpen()) {
+				goto FINALLY;
+			}
+			_writerThread = ENativeThread::current();
+			while (total < length) {
+				int count = length - total;
+				if (count > EDatagramDispatcher::MAX_BATCH)
+					count = EDatagramDispatcher::MAX_BATCH;
+				if (!connected) {
+					for (int i = 0; i < count; i++) {
+						EInetSocketAddress* isa = (targets != null) ? (*targets)[total + i] : target;
+						peers[i].addr = isa->getAddress()->getAddress();
+						peers[i].port = isa->getPort();
+					}
+				}
+				do {
+					try {
+						n = EDatagramDispatcher::sendmmsg(_fd, srcs, total, count,
+								connected ? null : peers);
+					} catch (EPortUnreachableException& pue) {
+						if (connected)
+							throw pue;
+						// refused earlier, the datagram is dropped as by send
+						EIOByteBuffer* src = (*srcs)[total];
+						src->position(src->limit());
+						n = 1;
+					}
+				} while ((n == EIOStatus::INTERRUPTED) && isOpen() && (total == 0));
+				if (n <= 0)
+					break;
+				total += n;
+				if (n < count)
+					break;
+			}
+
+			SYNCBLOCK(&_stateLock) {
+				if (isOpen() && (_localAddress == null)) {
+					_localAddress = ENetWrapper::SocketToInetSocketAddress(_fd);
+				}
+            }}
+		} catch (...) {
+			finally {
+				_writerThread = 0;
+				end((total > 0) || (n == EIOStatus::UNAVAILABLE));
+				ES_ASSERT(EIOStatus::check(n));
+			}
+			throw; //!
+		}
+		FINALLY:
+		finally {
+			_writerThread = 0;
+			end((total > 0) || (n == EIOStatus::UNAVAILABLE));
+			ES_ASSERT(EIOStatus::check(n));
+		}
+		return total;
+    }}
+}
+
 int EDatagramChannel::read(EIOByteBuffer* buf) {
 	if (buf == null)
 		throw ENullPointerException(__FILE__, __LINE__);
@@ -13,6 +13,10 @@
 #include "../../inc/EPortUnreachableException.hh"
 #include "../../inc/EIndexOutOfBoundsException.hh"
 
+#ifdef __linux__
+#include <netinet/udp.h>
+#endif
+
 namespace efc {
 namespace nio {
 
@@ -460,8 +464,181 @@ int EDatagramDispatcher::sendto(int fd, void* address, int len, int raddr, int r
 
 	return n;
 }
+
+#ifdef __linux__
+
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+int EDatagramDispatcher::recvmmsg(int fd, EA<EIOByteBuffer*>* dsts, int offset, int length,
+		boolean connected, boolean nowait, Peer* peers) {
+	struct mmsghdr msgs[MAX_BATCH];
+	struct iovec iovs[MAX_BATCH];
+	struct sockaddr_in addrs[MAX_BATCH];
+	char controls[MAX_BATCH][CMSG_SPACE(sizeof(int))];
+	boolean retry = false;
+	int n = 0;
+
+	if (length > MAX_BATCH) {
+		length = MAX_BATCH;
+	}
+
+	memset(msgs, 0, sizeof(msgs[0]) * length);
+	for (int i = 0; i < length; i++) {
+		EIOByteBuffer* bb = (*dsts)[i + offset];
+		iovs[i].iov_base = bb->current();
+		iovs[i].iov_len = bb->remaining();
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+		msgs[i].msg_hdr.msg_control = controls[i];
+		msgs[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+	}
+
+	do {
+		retry = false;
+		// blocks for the first datagram only, if ever
+		n = ::recvmmsg(fd, msgs, length, nowait ? MSG_DONTWAIT : MSG_WAITFORONE, NULL);
+		if (n < 0) {
+			if (errno == EWOULDBLOCK) {
+				return EIOStatus::UNAVAILABLE;
+			}
+			if (errno == EINTR) {
+				return EIOStatus::INTERRUPTED;
+			}
+			if (errno == ECONNREFUSED) {
+				if (connected == false) {
+					retry = true;
+				} else {
+					throw EPortUnreachableException(__FILE__, __LINE__);
+					return EIOStatus::THROWN;
+				}
+			} else {
+				return ENetWrapper::handleSocketError(errno);
+			}
+		}
+	} while (retry == true);
+
+	for (int i = 0; i < n; i++) {
+		EIOByteBuffer* bb = (*dsts)[i + offset];
+		int len = ES_MIN((int)msgs[i].msg_len, (int)iovs[i].iov_len);
+		bb->position(bb->position() + len);
+		peers[i].addr = addrs[i].sin_addr.s_addr;
+		peers[i].port = ntohs(addrs[i].sin_port);
+		peers[i].segSize = 0;
+		struct cmsghdr* cmsg;
+		for (cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg != NULL;
+				cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+			if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+				memcpy(&peers[i].segSize, CMSG_DATA(cmsg), sizeof(int));
+			}
+		}
+	}
+
+	return n;
+}
+
+int EDatagramDispatcher::sendmmsg(int fd, EA<EIOByteBuffer*>* srcs, int offset, int length,
+		Peer* peers) {
+	struct mmsghdr msgs[MAX_BATCH];
+	struct iovec iovs[MAX_BATCH];
+	struct sockaddr_in addrs[MAX_BATCH];
+	int n = 0;
+
+	if (length > MAX_BATCH) {
+		length = MAX_BATCH;
+	}
+
+	memset(msgs, 0, sizeof(msgs[0]) * length);
+	for (int i = 0; i < length; i++) {
+		EIOByteBuffer* bb = (*srcs)[i + offset];
+		iovs[i].iov_base = bb->current();
+		iovs[i].iov_len = bb->remaining();
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		if (peers != null) {
+			memset(&addrs[i], 0, sizeof(addrs[i]));
+			addrs[i].sin_family = AF_INET;
+			addrs[i].sin_addr.s_addr = peers[i].addr;
+			addrs[i].sin_port = htons((unsigned short)peers[i].port);
+			msgs[i].msg_hdr.msg_name = &addrs[i];
+			msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+		}
+	}
+
+	n = ::sendmmsg(fd, msgs, length, 0);
+	if (n < 0) {
+		if (errno == EAGAIN) {
+			return EIOStatus::UNAVAILABLE;
+		}
+		if (errno == EINTR) {
+			return EIOStatus::INTERRUPTED;
+		}
+		if (errno == ECONNREFUSED) {
+			throw EPortUnreachableException(__FILE__, __LINE__);
+			return EIOStatus::THROWN;
+		}
+		return ENetWrapper::handleSocketError(errno);
+	}
+
+	for (int i = 0; i < n; i++) {
+		EIOByteBuffer* bb = (*srcs)[i + offset];
+		bb->position(bb->position() + (int)msgs[i].msg_len);
+	}
+
+	return n;
+}
+
+#endif //!__linux__
 #endif //!WIN32
 
+#ifndef __linux__
+int EDatagramDispatcher::recvmmsg(int fd, EA<EIOByteBuffer*>* dsts, int offset, int length,
+		boolean connected, boolean nowait, Peer* peers) {
+	if (length <= 0 || nowait) {
+		// not a datagram more than asked without recvmmsg
+		return (length <= 0) ? 0 : EIOStatus::UNAVAILABLE;
+	}
+	EIOByteBuffer* bb = (*dsts)[offset];
+	byte buf[1];
+	int rem = bb->remaining();
+	int n = recvfrom(fd, (rem > 0) ? bb->current() : buf, (rem > 0) ? rem : 1,
+			connected, &peers[0].addr, &peers[0].port);
+	if (n < 0) {
+		return n;
+	}
+	if (rem > 0) {
+		bb->position(bb->position() + ES_MIN(n, rem));
+	}
+	peers[0].segSize = 0;
+	return 1;
+}
+
+int EDatagramDispatcher::sendmmsg(int fd, EA<EIOByteBuffer*>* srcs, int offset, int length,
+		Peer* peers) {
+	if (length > MAX_BATCH) {
+		length = MAX_BATCH;
+	}
+	int i;
+	for (i = 0; i < length; i++) {
+		EIOByteBuffer* bb = (*srcs)[i + offset];
+		int n = (peers != null) ?
+				sendto(fd, bb->current(), bb->remaining(), peers[i].addr, peers[i].port) :
+				write(fd, bb->current(), bb->remaining());
+		if (n < 0) {
+			if (i == 0) {
+				return n;
+			}
+			break;
+		}
+		bb->position(bb->position() + n);
+	}
+	return i;
+}
+#endif //!__linux__
+
 int EDatagramDispatcher::read(int fd, EIOByteBuffer* bb) {
 	int pos = bb->position();
 	int lim = bb->limit();
@@ -480,7 +657,7 @@ int EDatagramDispatcher::read(int fd, EA<EIOByteBuffer*>* dsts, int offset, int
 	if ((offset < 0) || (length < 0) || (offset > dsts->length() - length))
 		throw EINDEXOUTOFBOUNDSEXCEPTION;
 
-	struct iovec *iovBase = (struct iovec *)eso_calloc(sizeof(struct iovec));
+	struct iovec *iovBase = (struct iovec *)eso_calloc(sizeof(struct iovec) * length);
 	struct iovec *iov = iovBase;
 	long bytesRead = 0;
 	try {
@@ -499,7 +676,18 @@ int EDatagramDispatcher::read(int fd, EA<EIOByteBuffer*>* dsts, int offset, int
 	} finally {
 		eso_free(iovBase);
 	}
-	return bytesRead;
+
+	long returnVal = bytesRead;
+	// Notify the buffers how many bytes were put
+	for (int i=0; i<length && bytesRead > 0; i++) {
+		EIOByteBuffer* nextBuffer = (*dsts)[i + offset];
+		int pos = nextBuffer->position();
+		int rem = nextBuffer->remaining();
+		int n = (int)ES_MIN(bytesRead, (long)rem);
+		nextBuffer->position(pos + n);
+		bytesRead -= n;
+	}
+	return returnVal;
 }
 
 int EDatagramDispatcher::write(int fd, EIOByteBuffer* bb) {
@@ -543,7 +731,7 @@ int EDatagramDispatcher::write(int fd, EA<EIOByteBuffer*>* srcs, int offset, int
 	long returnVal = bytesWritten;
 	// Notify the buffers how many bytes were taken
 	for (int i=0; i<length; i++) {
-		EIOByteBuffer* nextBuffer = (*srcs)[i];
+		EIOByteBuffer* nextBuffer = (*srcs)[i + offset];
 		int pos = nextBuffer->position();
 		int lim = nextBuffer->limit();
 		ES_ASSERT(pos <= lim);
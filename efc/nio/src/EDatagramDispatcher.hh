@@ -35,6 +35,38 @@ public:
 	static int recvfrom(int fd, void* address, int len, boolean connected, int* raddr, int* rport) THROWS(EIOException);
 	static int sendto(int fd, void* address, int len, int raddr, int rport) THROWS(EIOException);
 
+	/**
+	 * The peer of a datagram of a batch, with the segment size of the
+	 * datagrams coalesced by UDP_GRO, 0 if not coalesced.
+	 */
+	struct Peer {
+		int addr;
+		int port;
+		int segSize;
+	};
+
+	// The most datagrams moved by one batch call
+	static const int MAX_BATCH = 64;
+
+	/**
+	 * Receives up to MAX_BATCH datagrams, one per buffer, by recvmmsg
+	 * where available and one datagram per call elsewhere.
+	 *
+	 * @param nowait  true not to block even if the channel is blocking
+	 * @return the number of datagrams or an EIOStatus
+	 */
+	static int recvmmsg(int fd, EA<EIOByteBuffer*>* dsts, int offset, int length,
+			boolean connected, boolean nowait, Peer* peers) THROWS(EIOException);
+
+	/**
+	 * Sends up to MAX_BATCH datagrams, one per buffer, by sendmmsg where
+	 * available; to the connected peer if <tt>peers</tt> is null.
+	 *
+	 * @return the number of datagrams or an EIOStatus
+	 */
+	static int sendmmsg(int fd, EA<EIOByteBuffer*>* srcs, int offset, int length,
+			Peer* peers) THROWS(EIOException);
+
 	static void close(int fd) THROWS(EIOException);
 	static void preClose(int fd) THROWS(EIOException);
 };
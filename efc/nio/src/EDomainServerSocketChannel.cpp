@@ -0,0 +1,262 @@
+/*
+ * EDomainServerSocketChannel.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "../inc/EDomainServerSocketChannel.hh"
+#include "./ENativeThread.hh"
+#include "./ESocketDispatcher.hh"
+#include "./ENIOUtil.hh"
+#include "../../inc/ENetWrapper.hh"
+#include "../../inc/EIOStatus.hh"
+#include "../../inc/EBindException.hh"
+#include "../../inc/EAlreadyBoundException.hh"
+#include "../../inc/EUnsupportedOperationException.hh"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#endif
+
+namespace efc {
+namespace nio {
+
+#ifdef WIN32
+
+EDomainServerSocketChannel* EDomainServerSocketChannel::open(boolean seqpacket) {
+	throw EUnsupportedOperationException(__FILE__, __LINE__);
+}
+
+#else //!
+
+EDomainServerSocketChannel::~EDomainServerSocketChannel() {
+	//
+}
+
+EDomainServerSocketChannel::EDomainServerSocketChannel(boolean seqpacket) :
+		_fd(-1), _seqpacket(seqpacket), _thread(0), _state(ST_UNINITIALIZED) {
+	_fd = ENetWrapper::socket(PF_LOCAL, seqpacket ? SOCK_SEQPACKET : SOCK_STREAM, 0);
+	_state = ST_INUSE;
+}
+
+EDomainServerSocketChannel* EDomainServerSocketChannel::open(boolean seqpacket) {
+	return new EDomainServerSocketChannel(seqpacket);
+}
+
+int EDomainServerSocketChannel::validOps() {
+	return ESelectionKey::OP_ACCEPT;
+}
+
+void EDomainServerSocketChannel::bind(const char* path, int backlog) {
+	struct sockaddr_un sau;
+	int len = ENIOUtil::unixAddress(path, &sau);
+
+	SYNCBLOCK(&_lock) {
+		if (!isOpen())
+			throw ECLOSEDCHANNELEXCEPTION;
+		if (isBound())
+			throw EALREADYBOUNDEXCEPTION;
+
+		/* in case it already exists */
+		struct stat statbuf;
+		if ((::stat(path, &statbuf) == 0) && (S_ISSOCK(statbuf.st_mode))) {
+			::unlink(path);
+		}
+
+		if (::bind(_fd, (struct sockaddr *)&sau, len) != 0) {
+			throw EBindException(__FILE__, __LINE__, "Bind failed", errno);
+		}
+		ENetWrapper::listen(_fd, backlog < 1 ? 50 : backlog);
+		SYNCBLOCK (&_stateLock) {
+			_localPath = path;
+        }}
+    }}
+}
+
+boolean EDomainServerSocketChannel::isBound() {
+	SYNCBLOCK(&_stateLock) {
+		return !_localPath.isEmpty();
+    }}
+}
+
+EString EDomainServerSocketChannel::localPath() {
+	SYNCBLOCK(&_stateLock) {
+		return _localPath;
+    }}
+}
+
+boolean EDomainServerSocketChannel::isSeqPacket() {
+	return _seqpacket;
+}
+
+EDomainSocketChannel* EDomainServerSocketChannel::accept() {
+	SYNCBLOCK(&_lock) {
+		if (!isOpen())
+			throw ECLOSEDCHANNELEXCEPTION;
+		if (!isBound())
+			throw ESocketException(__FILE__, __LINE__, "Socket is not bound yet");
+
+		int newfd = -1;
+		int n = 0;
+		try {
+			begin();
+			if (!isOpen()) {
+				n = 0;
+				goto FINALLY;
+			}
+			_thread = ENativeThread::current();
+			for (;;) {
+#ifdef __linux__
+				newfd = ::accept4(_fd, NULL, NULL, SOCK_CLOEXEC);
+#else
+				newfd = ::accept(_fd, NULL, NULL);
+				if (newfd >= 0)
+					::fcntl(newfd, F_SETFD, FD_CLOEXEC);
+#endif
+				if (newfd >= 0) {
+					n = 1;
+				} else if (errno == ECONNABORTED) {
+					continue;
+				} else if (errno == EAGAIN) {
+					n = EIOStatus::UNAVAILABLE;
+				} else if (errno == EINTR) {
+					n = EIOStatus::INTERRUPTED;
+				} else {
+					throw EIOException(__FILE__, __LINE__, "Accept failed", errno);
+				}
+				if ((n == EIOStatus::INTERRUPTED) && isOpen())
+					continue;
+				break;
+			}
+		} catch (...) {
+			finally {
+				_thread = 0;
+				end(n > 0);
+				ES_ASSERT(EIOStatus::check(n));
+			}
+			throw; //!
+		}
+		FINALLY:
+		finally {
+			_thread = 0;
+			end(n > 0);
+			ES_ASSERT(EIOStatus::check(n));
+		}
+
+		if (n < 1)
+			return null;
+
+		ENetWrapper::configureBlocking(newfd, true);
+		return new EDomainSocketChannel(newfd, _seqpacket);
+    }}
+}
+
+int EDomainServerSocketChannel::getFDVal() {
+	return _fd;
+}
+
+EString EDomainServerSocketChannel::toString() {
+	EString sb;
+	sb << "EDomainServerSocketChannel";
+	sb << '[';
+	if (!isOpen())
+		sb << "closed";
+	else {
+		SYNCBLOCK (&_stateLock) {
+			if (_localPath.isEmpty()) {
+				sb << "unbound";
+			} else {
+				sb << _localPath;
+			}
+        }}
+	}
+	sb << ']';
+	return sb;
+}
+
+void EDomainServerSocketChannel::setOption(int optID, const void* optval, int optlen) {
+	ENetWrapper::setOption(_fd, optID, (char*)optval, optlen);
+}
+
+void EDomainServerSocketChannel::getOption(int optID, void* optval, int* optlen) {
+	ENetWrapper::getOption(_fd, optID, optval, optlen);
+}
+
+boolean EDomainServerSocketChannel::translateAndUpdateReadyOps(int ops, ESelectionKey* sk) {
+	return translateReadyOps(ops, sk->nioReadyOps(), sk);
+}
+
+boolean EDomainServerSocketChannel::translateAndSetReadyOps(int ops, ESelectionKey* sk) {
+	return translateReadyOps(ops, 0, sk);
+}
+
+boolean EDomainServerSocketChannel::translateReadyOps(int ops, int initialOps,
+		ESelectionKey* sk) {
+	int intOps = sk->nioInterestOps(); // Do this just once, it synchronizes
+	int oldOps = sk->nioReadyOps();
+	int newOps = initialOps;
+
+	if ((ops & ENetWrapper::POLLNVAL_) != 0) {
+		// This should only happen if this channel is pre-closed while a
+		// selection operation is in progress
+		return false;
+	}
+
+	if ((ops & (ENetWrapper::POLLERR_ | ENetWrapper::POLLHUP_)) != 0) {
+		newOps = intOps;
+		sk->nioReadyOps(newOps);
+		return (newOps & ~oldOps) != 0;
+	}
+
+	if (((ops & ENetWrapper::POLLIN_) != 0)
+			&& ((intOps & ESelectionKey::OP_ACCEPT) != 0))
+		newOps |= ESelectionKey::OP_ACCEPT;
+
+	sk->nioReadyOps(newOps);
+	return (newOps & ~oldOps) != 0;
+}
+
+void EDomainServerSocketChannel::translateAndSetInterestOps(int ops, ESelectionKey* sk) {
+	int newOps = 0;
+	if ((ops & ESelectionKey::OP_ACCEPT) != 0)
+		newOps |= ENetWrapper::POLLIN_;
+	sk->selector()->putEventOps(sk, newOps);
+}
+
+void EDomainServerSocketChannel::implCloseSelectableChannel() {
+	SYNCBLOCK (&_stateLock) {
+		ESocketDispatcher::preClose(_fd);
+		es_os_thread_t th = _thread;
+		if (_thread != 0)
+			ENativeThread::signal(th);
+		if (!isRegistered())
+			kill();
+    }}
+}
+
+void EDomainServerSocketChannel::implConfigureBlocking(boolean block) {
+	ENetWrapper::configureBlocking(_fd, block);
+}
+
+void EDomainServerSocketChannel::kill() {
+	SYNCBLOCK (&_stateLock) {
+		if (_state == ST_KILLED)
+			return;
+		if (_state == ST_UNINITIALIZED) {
+			_state = ST_KILLED;
+			return;
+		}
+		ES_ASSERT(!isOpen() && !isRegistered());
+		ESocketDispatcher::close(_fd);
+		_state = ST_KILLED;
+    }}
+}
+
+#endif //!WIN32
+
+} /* namespace nio */
+} /* namespace efc */
@@ -0,0 +1,659 @@
+/*
+ * EDomainSocketChannel.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "../inc/EDomainSocketChannel.hh"
+#include "../inc/EAsynchronousCloseException.hh"
+#include "./ENativeThread.hh"
+#include "./ESocketDispatcher.hh"
+#include "./ENIOUtil.hh"
+#include "../../inc/ENetWrapper.hh"
+#include "../../inc/EIOStatus.hh"
+#include "../../inc/EConnectException.hh"
+#include "../../inc/ENullPointerException.hh"
+#include "../../inc/EIllegalArgumentException.hh"
+#include "../../inc/EIndexOutOfBoundsException.hh"
+#include "../../inc/EUnsupportedOperationException.hh"
+#include "../../inc/EAlreadyConnectedException.hh"
+#include "../../inc/ENotYetConnectedException.hh"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/un.h>
+#include <sys/socket.h>
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+#endif
+
+namespace efc {
+namespace nio {
+
+#ifdef WIN32
+
+EDomainSocketChannel* EDomainSocketChannel::open(boolean seqpacket) {
+	throw EUnsupportedOperationException(__FILE__, __LINE__);
+}
+
+EDomainSocketChannel* EDomainSocketChannel::open(const char* path, boolean seqpacket) {
+	throw EUnsupportedOperationException(__FILE__, __LINE__);
+}
+
+#else //!
+
+// State, increases monotonically
+#define ST_UNINITIALIZED  -1
+#define ST_UNCONNECTED     0
+#define ST_CONNECTED       2
+#define ST_KILLPENDING     3
+#define ST_KILLED          4
+
+// Vectors of up to so many buffers are built on the stack
+#define IOV_STACK 16
+
+/*
+ * Advances the positions of the buffers over n bytes transferred.
+ */
+static void advance(EA<EIOByteBuffer*>* bufs, int offset, int length, long n) {
+	for (int i = 0; i < length && n > 0; i++) {
+		EIOByteBuffer* bb = (*bufs)[offset + i];
+		int k = (int)ES_MIN(n, (long)bb->remaining());
+		bb->position(bb->position() + k);
+		n -= k;
+	}
+}
+
+/*
+ * One sendmsg or recvmsg of the remaining bytes of the buffers, with
+ * descriptors as SCM_RIGHTS ancillary data.
+ */
+static long transfer(int fd, EA<EIOByteBuffer*>* bufs, int offset, int length,
+		EA<int>* fds, boolean reading) {
+	union {
+		struct cmsghdr align;
+		char buf[CMSG_SPACE(sizeof(int) * EDomainSocketChannel::MAX_FDS)];
+	} control;
+	struct iovec stackIov[IOV_STACK];
+	struct iovec* iov = (length <= IOV_STACK) ? stackIov
+			: (struct iovec*)eso_calloc(sizeof(struct iovec) * length);
+	for (int i = 0; i < length; i++) {
+		EIOByteBuffer* bb = (*bufs)[offset + i];
+		iov[i].iov_base = bb->current();
+		iov[i].iov_len = bb->remaining();
+	}
+	// no more than the control buffer holds, the system closes the others
+	int nfds = ES_MIN(fds->length(), EDomainSocketChannel::MAX_FDS);
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = iov;
+	msg.msg_iovlen = length;
+	if (nfds > 0) {
+		msg.msg_control = control.buf;
+		msg.msg_controllen = CMSG_SPACE(sizeof(int) * nfds);
+	}
+
+	long n;
+	if (reading) {
+#ifdef MSG_CMSG_CLOEXEC
+		n = ::recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+#else
+		n = ::recvmsg(fd, &msg, 0);
+#endif
+	} else {
+		if (nfds > 0) {
+			struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+			cmsg->cmsg_level = SOL_SOCKET;
+			cmsg->cmsg_type = SCM_RIGHTS;
+			cmsg->cmsg_len = CMSG_LEN(sizeof(int) * nfds);
+			memcpy(CMSG_DATA(cmsg), fds->address(), sizeof(int) * nfds);
+		}
+		n = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+	}
+	int err = errno;
+	if (iov != stackIov) {
+		eso_free(iov);
+	}
+	if (n < 0) {
+		errno = err;
+		return ENIOUtil::convertReturnVal(n, reading);
+	}
+
+	if (reading) {
+		// the descriptors come with the first bytes read
+		int count = 0;
+		for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+				cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+			if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+				continue;
+			}
+			int k = (int)((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+			int* p = (int*)CMSG_DATA(cmsg);
+			for (int i = 0; i < k; i++) {
+#ifndef MSG_CMSG_CLOEXEC
+				::fcntl(p[i], F_SETFD, FD_CLOEXEC);
+#endif
+				if (count < nfds) {
+					(*fds)[count++] = p[i];
+				} else {
+					::close(p[i]);
+				}
+			}
+		}
+		if (n == 0) {
+			return EIOStatus::EOF_;
+		}
+	}
+	advance(bufs, offset, length, n);
+	return n;
+}
+
+EDomainSocketChannel::~EDomainSocketChannel() {
+	//
+}
+
+EDomainSocketChannel::EDomainSocketChannel(boolean seqpacket) :
+		_fd(-1), _seqpacket(seqpacket), _readerThread(0), _writerThread(0),
+		_isInputOpen(true), _isOutputOpen(true), _state(ST_UNINITIALIZED) {
+	_fd = ENetWrapper::socket(PF_LOCAL, seqpacket ? SOCK_SEQPACKET : SOCK_STREAM, 0);
+	_state = ST_UNCONNECTED;
+}
+
+EDomainSocketChannel::EDomainSocketChannel(int fd, boolean seqpacket) :
+		_fd(fd), _seqpacket(seqpacket), _readerThread(0), _writerThread(0),
+		_isInputOpen(true), _isOutputOpen(true), _state(ST_CONNECTED) {
+}
+
+EDomainSocketChannel* EDomainSocketChannel::open(boolean seqpacket) {
+	return new EDomainSocketChannel(seqpacket);
+}
+
+EDomainSocketChannel* EDomainSocketChannel::open(const char* path, boolean seqpacket) {
+	EDomainSocketChannel* sc = open(seqpacket);
+	try {
+		sc->connect(path);
+	} catch (...) {
+		try {
+			sc->close();
+		} catch (...) {
+		}
+		delete sc;
+		throw;
+	}
+	return sc;
+}
+
+int EDomainSocketChannel::validOps() {
+	return (ESelectionKey::OP_READ | ESelectionKey::OP_WRITE);
+}
+
+void EDomainSocketChannel::connect(const char* path) {
+	struct sockaddr_un sau;
+	int len = ENIOUtil::unixAddress(path, &sau);
+
+	SYNCBLOCK (&_readLock) {
+		SYNCBLOCK (&_writeLock) {
+			SYNCBLOCK (&_stateLock) {
+				if (!isOpen())
+					throw ECLOSEDCHANNELEXCEPTION;
+				if (_state == ST_CONNECTED)
+					throw EALREADYCONNECTEDEXCEPTION;
+            }}
+			int rv = -1;
+			int err = 0;
+			try {
+				begin();
+				SYNCBLOCK (&_stateLock) {
+					if (!isOpen()) {
+						goto FINALLY;
+					}
+					_readerThread = ENativeThread::current();
+                }}
+				for (;;) {
+					// a local connect completes or fails at once
+					rv = ::connect(_fd, (struct sockaddr *)&sau, len);
+					err = (rv < 0) ? errno : 0;
+					if ((err == EINTR) && isOpen())
+						continue;
+					break;
+				}
+			} catch (...) {
+				finally {
+					readerCleanup();
+					end(rv == 0);
+				}
+				throw; //!
+			}
+			FINALLY:
+			finally {
+				readerCleanup();
+				end(rv == 0);
+			}
+			if (rv != 0) {
+				if (err == ENOENT || err == ECONNREFUSED)
+					throw EConnectException(__FILE__, __LINE__, "Connection refused", err);
+				if (err == EAGAIN)
+					throw EIOException(__FILE__, __LINE__, "Listener backlog full", err);
+				throw EIOException(__FILE__, __LINE__, "connect failed", err);
+			}
+			SYNCBLOCK (&_stateLock) {
+				_remotePath = path;
+				_state = ST_CONNECTED;
+            }}
+        }}
+    }}
+}
+
+boolean EDomainSocketChannel::isConnected() {
+	SYNCBLOCK (&_stateLock) {
+		return (_state == ST_CONNECTED);
+    }}
+}
+
+boolean EDomainSocketChannel::isSeqPacket() {
+	return _seqpacket;
+}
+
+EString EDomainSocketChannel::remotePath() {
+	SYNCBLOCK (&_stateLock) {
+		return _remotePath;
+    }}
+}
+
+int EDomainSocketChannel::read(EIOByteBuffer* dst) {
+	return read(dst, null);
+}
+
+long EDomainSocketChannel::read(EA<EIOByteBuffer*>* dsts) {
+	if (dsts == null)
+		throw ENULLPOINTEREXCEPTION;
+	return read(dsts, 0, dsts->length(), null);
+}
+
+long EDomainSocketChannel::read(EA<EIOByteBuffer*>* dsts, int offset, int length) {
+	return read(dsts, offset, length, null);
+}
+
+int EDomainSocketChannel::read(EIOByteBuffer* dst, EA<int>* fds) {
+	if (dst == null)
+		throw ENULLPOINTEREXCEPTION;
+	EA<EIOByteBuffer*> dsts(1, false);
+	dsts[0] = dst;
+	return (int)read(&dsts, 0, 1, fds);
+}
+
+long EDomainSocketChannel::read(EA<EIOByteBuffer*>* dsts, int offset, int length, EA<int>* fds) {
+	if (dsts == null)
+		throw ENULLPOINTEREXCEPTION;
+	if ((offset < 0) || (length < 0) || (offset > dsts->length() - length))
+		throw EINDEXOUTOFBOUNDSEXCEPTION;
+	if (fds != null) {
+		for (int i = 0; i < fds->length(); i++) {
+			(*fds)[i] = -1;
+		}
+		if (fds->length() == 0) {
+			fds = null;
+		}
+	}
+
+	SYNCBLOCK (&_readLock) {
+		if (!ensureReadOpen())
+			return -1;
+		long n = 0;
+		long rv = -1;
+		try {
+			begin();
+			SYNCBLOCK (&_stateLock) {
+				if (!isOpen()) {
+					rv = 0;
+					goto FINALLY;
+				}
+				_readerThread = ENativeThread::current();
+            }}
+			for (;;) {
+				// a read of a seqpacket socket receives one message
+				if (fds == null)
+					n = ESocketDispatcher::read(_fd, dsts, offset, length);
+				else
+					n = transfer(_fd, dsts, offset, ES_MIN(length, IOV_MAX), fds, true);
+				if ((n == EIOStatus::INTERRUPTED) && isOpen())
+					continue;
+				rv = EIOStatus::normalize(n);
+				goto FINALLY;
+			}
+		} catch (...) {
+			finally {
+				readerCleanup();
+				end(n > 0 || (n == EIOStatus::UNAVAILABLE));
+				SYNCBLOCK (&_stateLock) {
+					if ((n <= 0) && (!_isInputOpen))
+						return EIOStatus::EOF_;
+                }}
+				ES_ASSERT(EIOStatus::check(n));
+			}
+			throw; //!
+		}
+		FINALLY:
+		finally {
+			readerCleanup();
+			end(n > 0 || (n == EIOStatus::UNAVAILABLE));
+			SYNCBLOCK (&_stateLock) {
+				if ((n <= 0) && (!_isInputOpen))
+					return EIOStatus::EOF_;
+            }}
+			ES_ASSERT(EIOStatus::check(n));
+		}
+		return rv; //!
+    }}
+}
+
+int EDomainSocketChannel::write(EIOByteBuffer* src) {
+	return write(src, null);
+}
+
+long EDomainSocketChannel::write(EA<EIOByteBuffer*>* srcs) {
+	if (srcs == null)
+		throw ENULLPOINTEREXCEPTION;
+	return write(srcs, 0, srcs->length(), null);
+}
+
+long EDomainSocketChannel::write(EA<EIOByteBuffer*>* srcs, int offset, int length) {
+	return write(srcs, offset, length, null);
+}
+
+int EDomainSocketChannel::write(EIOByteBuffer* src, EA<int>* fds) {
+	if (src == null)
+		throw ENULLPOINTEREXCEPTION;
+	EA<EIOByteBuffer*> srcs(1, false);
+	srcs[0] = src;
+	return (int)write(&srcs, 0, 1, fds);
+}
+
+long EDomainSocketChannel::write(EA<EIOByteBuffer*>* srcs, int offset, int length, EA<int>* fds) {
+	if (srcs == null)
+		throw ENULLPOINTEREXCEPTION;
+	if ((offset < 0) || (length < 0) || (offset > srcs->length() - length))
+		throw EINDEXOUTOFBOUNDSEXCEPTION;
+	if (fds != null && fds->length() == 0) {
+		fds = null;
+	}
+	if (fds != null) {
+		if (fds->length() > MAX_FDS)
+			throw EIllegalArgumentException(__FILE__, __LINE__, "Too many descriptors");
+		long remaining = 0;
+		for (int i = 0; i < length; i++) {
+			remaining += (*srcs)[offset + i]->remaining();
+		}
+		if (remaining == 0)
+			throw EIllegalArgumentException(__FILE__, __LINE__, "No bytes to pass the descriptors with");
+	}
+
+	SYNCBLOCK (&_writeLock) {
+		ensureWriteOpen();
+		long n = 0;
+		long rv = -1;
+		try {
+			begin();
+			SYNCBLOCK (&_stateLock) {
+				if (!isOpen()) {
+					rv = 0;
+					goto FINALLY;
+				}
+				_writerThread = ENativeThread::current();
+            }}
+			for (;;) {
+				// a write to a seqpacket socket sends one message
+				if (fds == null)
+					n = ESocketDispatcher::write(_fd, srcs, offset, length);
+				else
+					n = transfer(_fd, srcs, offset, ES_MIN(length, IOV_MAX), fds, false);
+				if ((n == EIOStatus::INTERRUPTED) && isOpen())
+					continue;
+				rv = EIOStatus::normalize(n);
+				goto FINALLY;
+			}
+		} catch (...) {
+			finally {
+				writerCleanup();
+				end((n > 0) || (n == EIOStatus::UNAVAILABLE));
+				SYNCBLOCK (&_stateLock) {
+					if ((n <= 0) && (!_isOutputOpen))
+						throw EASYNCHRONOUSCLOSEEXCEPTION;
+                }}
+				ES_ASSERT(EIOStatus::check(n));
+			}
+			throw; //!
+		}
+		FINALLY:
+		finally {
+			writerCleanup();
+			end((n > 0) || (n == EIOStatus::UNAVAILABLE));
+			SYNCBLOCK (&_stateLock) {
+				if ((n <= 0) && (!_isOutputOpen))
+					throw EASYNCHRONOUSCLOSEEXCEPTION;
+            }}
+			ES_ASSERT(EIOStatus::check(n));
+		}
+		return rv; //!
+    }}
+}
+
+void EDomainSocketChannel::shutdownInput() {
+	SYNCBLOCK (&_stateLock) {
+		if (!isOpen())
+			throw ECLOSEDCHANNELEXCEPTION;
+		if (_isInputOpen) {
+			ENetWrapper::shutdown(_fd, SHUT_RD);
+			es_os_thread_t th = _readerThread;
+			if (th != 0) {
+				ENativeThread::signal(th);
+			}
+			_isInputOpen = false;
+		}
+    }}
+}
+
+void EDomainSocketChannel::shutdownOutput() {
+	SYNCBLOCK (&_stateLock) {
+		if (!isOpen())
+			throw ECLOSEDCHANNELEXCEPTION;
+		_isOutputOpen = false;
+		ENetWrapper::shutdown(_fd, SHUT_WR);
+		es_os_thread_t th = _writerThread;
+		if (th != 0) {
+			ENativeThread::signal(th);
+		}
+    }}
+}
+
+boolean EDomainSocketChannel::isInputOpen() {
+	SYNCBLOCK (&_stateLock) {
+		return _isInputOpen;
+    }}
+}
+
+boolean EDomainSocketChannel::isOutputOpen() {
+	SYNCBLOCK (&_stateLock) {
+		return _isOutputOpen;
+    }}
+}
+
+int EDomainSocketChannel::getFDVal() {
+	return _fd;
+}
+
+EString EDomainSocketChannel::toString() {
+	EString sb;
+	sb.append("EDomainSocketChannel[");
+	if (!isOpen())
+		sb.append("closed");
+	else {
+		SYNCBLOCK (&_stateLock) {
+			sb.append(_seqpacket ? "seqpacket " : "stream ");
+			if (_state == ST_CONNECTED) {
+				sb.append("connected");
+				if (!_isInputOpen)
+					sb.append(" ishut");
+				if (!_isOutputOpen)
+					sb.append(" oshut");
+			} else {
+				sb.append("unconnected");
+			}
+			if (!_remotePath.isEmpty()) {
+				sb.append(" remote=");
+				sb.append(_remotePath);
+			}
+        }}
+	}
+	sb.append(']');
+	return sb;
+}
+
+void EDomainSocketChannel::setOption(int optID, const void* optval, int optlen) {
+	ENetWrapper::setOption(_fd, optID, (char*)optval, optlen);
+}
+
+void EDomainSocketChannel::getOption(int optID, void* optval, int* optlen) {
+	ENetWrapper::getOption(_fd, optID, optval, optlen);
+}
+
+boolean EDomainSocketChannel::translateAndUpdateReadyOps(int ops, ESelectionKey* sk) {
+	return translateReadyOps(ops, sk->nioReadyOps(), sk);
+}
+
+boolean EDomainSocketChannel::translateAndSetReadyOps(int ops, ESelectionKey* sk) {
+	return translateReadyOps(ops, 0, sk);
+}
+
+boolean EDomainSocketChannel::translateReadyOps(int ops, int initialOps,
+		ESelectionKey* sk) {
+	int intOps = sk->nioInterestOps(); // Do this just once, it synchronizes
+	int oldOps = sk->nioReadyOps();
+	int newOps = initialOps;
+
+	if ((ops & ENetWrapper::POLLNVAL_) != 0) {
+		// This should only happen if this channel is pre-closed while a
+		// selection operation is in progress
+		return false;
+	}
+
+	if ((ops & (ENetWrapper::POLLERR_ | ENetWrapper::POLLHUP_)) != 0) {
+		newOps = intOps;
+		sk->nioReadyOps(newOps);
+		return (newOps & ~oldOps) != 0;
+	}
+
+	if (((ops & ENetWrapper::POLLIN_) != 0)
+			&& ((intOps & ESelectionKey::OP_READ) != 0)
+			&& (_state == ST_CONNECTED))
+		newOps |= ESelectionKey::OP_READ;
+
+	if (((ops & ENetWrapper::POLLOUT_) != 0)
+			&& ((intOps & ESelectionKey::OP_WRITE) != 0)
+			&& (_state == ST_CONNECTED))
+		newOps |= ESelectionKey::OP_WRITE;
+
+	sk->nioReadyOps(newOps);
+	return (newOps & ~oldOps) != 0;
+}
+
+void EDomainSocketChannel::translateAndSetInterestOps(int ops, ESelectionKey* sk) {
+	int newOps = 0;
+	if ((ops & ESelectionKey::OP_READ) != 0)
+		newOps |= ENetWrapper::POLLIN_;
+	if ((ops & ESelectionKey::OP_WRITE) != 0)
+		newOps |= ENetWrapper::POLLOUT_;
+	sk->selector()->putEventOps(sk, newOps);
+}
+
+void EDomainSocketChannel::implConfigureBlocking(boolean block) {
+	ENetWrapper::configureBlocking(_fd, block);
+}
+
+void EDomainSocketChannel::implCloseSelectableChannel() {
+	SYNCBLOCK (&_stateLock) {
+		_isInputOpen = false;
+		_isOutputOpen = false;
+
+		// see ESocketChannel: the fd is dup'ed over until the last reader,
+		// writer or selector lets go of it
+		ESocketDispatcher::preClose(_fd);
+
+		es_os_thread_t th;
+		if ((th = _readerThread) != 0)
+			ENativeThread::signal(th);
+		if ((th = _writerThread) != 0)
+			ENativeThread::signal(th);
+
+		if (!isRegistered())
+			kill();
+    }}
+}
+
+void EDomainSocketChannel::kill() {
+	SYNCBLOCK (&_stateLock) {
+		if (_state == ST_KILLED)
+			return;
+		if (_state == ST_UNINITIALIZED) {
+			_state = ST_KILLED;
+			return;
+		}
+		ES_ASSERT(!isOpen() && !isRegistered());
+
+		// Postpone the kill if there is a waiting reader or writer thread
+		if (_readerThread == 0 && _writerThread == 0) {
+			ESocketDispatcher::close(_fd);
+			_state = ST_KILLED;
+		} else {
+			_state = ST_KILLPENDING;
+		}
+    }}
+}
+
+boolean EDomainSocketChannel::ensureReadOpen() {
+	SYNCBLOCK (&_stateLock) {
+		if (!isOpen())
+			throw ECLOSEDCHANNELEXCEPTION;
+		if (_state != ST_CONNECTED)
+			throw ENOTYETCONNECTEDEXCEPTION;
+		return _isInputOpen;
+    }}
+}
+
+void EDomainSocketChannel::ensureWriteOpen() {
+	SYNCBLOCK (&_stateLock) {
+		if (!isOpen())
+			throw ECLOSEDCHANNELEXCEPTION;
+		if (!_isOutputOpen)
+			throw ECLOSEDCHANNELEXCEPTION;
+		if (_state != ST_CONNECTED)
+			throw ENOTYETCONNECTEDEXCEPTION;
+    }}
+}
+
+void EDomainSocketChannel::readerCleanup() {
+	SYNCBLOCK (&_stateLock) {
+		_readerThread = 0;
+		if (_state == ST_KILLPENDING)
+			kill();
+    }}
+}
+
+void EDomainSocketChannel::writerCleanup() {
+	SYNCBLOCK (&_stateLock) {
+		_writerThread = 0;
+		if (_state == ST_KILLPENDING)
+			kill();
+    }}
+}
+
+#endif //!WIN32
+
+} /* namespace nio */
+} /* namespace efc */
@@ -91,8 +91,9 @@ EEPollArrayWrapper::~EEPollArrayWrapper() {
 }
 
 void EEPollArrayWrapper::interrupt() {
-	char c = 1;
-	if (1 != ::write(outgoingInterruptFD_, &c, 1)) {
+	// the interrupt line is an eventfd, written 8 bytes at a time
+	ullong one = 1;
+	if (sizeof(one) != ::write(outgoingInterruptFD_, &one, sizeof(one))) {
 		throw EIOException(__FILE__, __LINE__, "EPollArrayWrapper: interrupt failed");
 	}
 }
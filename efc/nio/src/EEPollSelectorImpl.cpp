@@ -11,33 +11,47 @@
 
 #include "./EEPollSelectorImpl.hh"
 #include "./ENIOUtil.hh"
+#include "./ESelectedKeySet.hh"
 #include "../inc/EClosedSelectorException.hh"
 
+#include <sys/eventfd.h>
+
 namespace efc {
 namespace nio {
 
 EEPollSelectorImpl::~EEPollSelectorImpl() {
-	delete fdToKey_;
+	eso_free(fdToKey_);
 	delete pollWrapper_;
-	delete pipeWrapper_;
+	if (eventFd_ >= 0) {
+		::close(eventFd_);
+	}
 }
 
 EEPollSelectorImpl::EEPollSelectorImpl() : closed_(false),
 		interruptTriggered_(false) {
 	pollWrapper_ = new EEPollArrayWrapper();
-	pipeWrapper_ = new EPipeWrapper();
-	pollWrapper_->initInterrupt(pipeWrapper_->inFD(), pipeWrapper_->outFD());
+	// one descriptor and a single write however many wakeups are pending,
+	// where a pipe needs two
+	eventFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (eventFd_ < 0) {
+		int err = errno;
+		delete pollWrapper_;
+		throw EIOException(__FILE__, __LINE__, "eventfd failed", err);
+	}
+	pollWrapper_->initInterrupt(eventFd_, eventFd_);
 
-	fdToKey_ = new EHashMap<int, sp<ESelectionKey> >();
+	fdToKeySize_ = 1024;
+	fdToKey_ = (ESelectionKey**)eso_calloc(fdToKeySize_ * sizeof(ESelectionKey*));
 }
 
 ESelector* EEPollSelectorImpl::wakeup() {
-	SYNCBLOCK (&interruptLock_) {
-		if (!interruptTriggered_) {
-			pollWrapper_->interrupt();
-			interruptTriggered_ = true;
-		}
-    }}
+	if (!interruptTriggered_.get() && interruptTriggered_.compareAndSet(false, true)) {
+		SYNCBLOCK (&interruptLock_) {
+			if (eventFd_ >= 0) {
+				pollWrapper_->interrupt();
+			}
+        }}
+	}
 	return this;
 }
 
@@ -52,7 +66,16 @@ void EEPollSelectorImpl::implRegister(sp<ESelectionKey> ski) {
 		throw EClosedSelectorException(__FILE__, __LINE__);
 	sp<ESelectableChannel> ch = ski->channel();
 	int fd = ch->getFDVal();
-	fdToKey_->put(fd, ski);
+	if (fd >= fdToKeySize_) {
+		int newSize = fdToKeySize_;
+		while (fd >= newSize) {
+			newSize <<= 1;
+		}
+		fdToKey_ = (ESelectionKey**)eso_realloc(fdToKey_, newSize * sizeof(ESelectionKey*));
+		eso_memset(fdToKey_ + fdToKeySize_, 0, (newSize - fdToKeySize_) * sizeof(ESelectionKey*));
+		fdToKeySize_ = newSize;
+	}
+	fdToKey_[fd] = ski.get();
 	pollWrapper_->add(fd);
 	keys_->add(ski);
 }
@@ -62,7 +85,9 @@ void EEPollSelectorImpl::implDereg(sp<ESelectionKey> ski) {
 
 	sp<ESelectableChannel> ch = ski->channel();
 	int fd = ch->getFDVal();
-	fdToKey_->remove(fd);
+	if (fd < fdToKeySize_ && fdToKey_[fd] == ski.get()) {
+		fdToKey_[fd] = null;
+	}
 	pollWrapper_->remove(fd);
 	ski->setIndex(-1);
 	keys_->remove(ski.get());
@@ -90,15 +115,12 @@ void EEPollSelectorImpl::implClose() {
 	closed_ = true;
 
 	// prevent further wakeup
+	interruptTriggered_.set(true);
 	SYNCBLOCK (&interruptLock_) {
-		interruptTriggered_ = true;
+		::close(eventFd_);
+		eventFd_ = -1;
     }}
 
-	if (pipeWrapper_ != null) {
-		delete pipeWrapper_;
-		pipeWrapper_ = null;
-	}
-
 	if (pollWrapper_ != null) {
 		pollWrapper_->close();
 
@@ -123,6 +145,7 @@ void EEPollSelectorImpl::implClose() {
 
 			i->remove();
 		}
+		eso_memset(fdToKey_, 0, fdToKeySize_ * sizeof(ESelectionKey*));
 
 		delete pollWrapper_;
 		pollWrapper_ = null;
@@ -145,14 +168,14 @@ int EEPollSelectorImpl::doSelect(llong timeout) {
 	processDeregisterQueue();
 	int numKeysUpdated = updateSelectedKeys(entries);
 	if (pollWrapper_->interrupted()) {
-		// Clear the wakeup pipe
+		// Clear the wakeup eventfd
 		pollWrapper_->putEventOps(pollWrapper_->interruptedIndex(), 0);
-		SYNCBLOCK (&interruptLock_) {
-			pollWrapper_->clearInterrupted();
-			//@see: IOUtil.drain(fd0);
-			ENIOUtil::drain(pipeWrapper_->inFD());
-			interruptTriggered_ = false;
-        }}
+		pollWrapper_->clearInterrupted();
+		//@see: IOUtil.drain(fd0);
+		ENIOUtil::drain(eventFd_);
+		// a wakeup between the drain and here is dropped, this selection
+		// being the one it was to wake up
+		interruptTriggered_.set(false);
 	}
 	return numKeysUpdated;
 }
@@ -161,23 +184,10 @@ int EEPollSelectorImpl::updateSelectedKeys(int entries) {
 	int numKeysUpdated = 0;
 	for (int i = 0; i < entries; i++) {
 		int nextFD = pollWrapper_->getDescriptor(i);
-		{
-			sp<ESelectionKey> ski = fdToKey_->get(nextFD);
-			// ski is null in the case of an interrupt
-			if (ski != null) {
-				int rOps = pollWrapper_->getEventOps(i);
-				if (selectedKeys_->contains(ski.get())) {
-					if (ski->channel()->translateAndSetReadyOps(rOps, ski.get())) {
-						numKeysUpdated++;
-					}
-				} else {
-					ski->channel()->translateAndSetReadyOps(rOps, ski.get());
-					if ((ski->nioReadyOps() & ski->nioInterestOps()) != 0) {
-						selectedKeys_->add(ski);
-						numKeysUpdated++;
-					}
-				}
-			}
+		ESelectionKey* ski = (nextFD < fdToKeySize_) ? fdToKey_[nextFD] : null;
+		// ski is null in the case of an interrupt
+		if (ski != null) {
+			numKeysUpdated += processReadyEvents(pollWrapper_->getEventOps(i), ski);
 		}
 	}
 	return numKeysUpdated;
@@ -14,7 +14,6 @@
 
 #include "../inc/ESelector.hh"
 #include "./EEPollArrayWrapper.hh"
-#include "./EPipeWrapper.hh"
 #include "../../inc/concurrent/EAtomicBoolean.hh"
 
 namespace efc {
@@ -41,8 +40,8 @@ public:
 	virtual void putEventOps(ESelectionKey* sk, int ops);
 
 protected:
-	// pipe used for interrupt
-	EPipeWrapper* pipeWrapper_;
+	// eventfd used for interrupt
+	int eventFd_;
 
 	// The poll object
 	EEPollArrayWrapper *pollWrapper_;
@@ -53,15 +52,20 @@ protected:
 	virtual int doSelect(llong timeout) THROWS(EIOException);
 
 private:
-	// Maps from file descriptors to keys
-	EHashMap<int, sp<ESelectionKey> >* fdToKey_;
+	// Maps from file descriptors to keys, indexed by the descriptor and
+	// grown on demand; the keys are held by the key set
+	ESelectionKey** fdToKey_;
+	int fdToKeySize_;
 
 	// True if this Selector has been closed
 	volatile boolean closed_;// = false;
 
-	// Lock for interrupt triggering and clearing
+	// Set by the wakeup which writes to the eventfd, the wakeups which
+	// find it set have nothing to do
+	EAtomicBoolean interruptTriggered_;// = false;
+
+	// Lock for the eventfd write against its closing
 	EReentrantLock interruptLock_;
-	boolean interruptTriggered_;// = false;
 
     /**
 	 * Update the keys whose fd's have been selected by the epoll.
@@ -552,6 +552,28 @@ int EFileChannel::write(EIOByteBuffer* src, long position) {
 	return rv;
 }
 
+llong EFileChannel::read(EIOByteBuffer* dst, long position, EIOUring* ring, ECompletionHandler* handler) {
+	if (dst == null || ring == null || handler == null)
+		throw ENullPointerException(__FILE__, __LINE__);
+	if (position < 0)
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Negative position");
+	if (!readable_)
+		throw ENonReadableChannelException(__FILE__, __LINE__);
+	ensureOpen();
+	return ring->read(fd_, dst, position, handler);
+}
+
+llong EFileChannel::write(EIOByteBuffer* src, long position, EIOUring* ring, ECompletionHandler* handler) {
+	if (src == null || ring == null || handler == null)
+		throw ENullPointerException(__FILE__, __LINE__);
+	if (position < 0)
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Negative position");
+	if (!writable_)
+		throw ENonWritableChannelException(__FILE__, __LINE__);
+	ensureOpen();
+	return ring->write(fd_, src, position, handler);
+}
+
 int EFileChannel::getFDVal() {
 	return fd_;
 }
@@ -19,6 +19,7 @@
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
+#include <limits.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #if !defined(__APPLE__)
@@ -749,13 +750,26 @@ int EFileDispatcher::write(int fd, EIOByteBuffer* bb) {
 	return n;
 }
 
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+// Vectors of up to so many buffers are built on the stack
+#define IOV_STACK 16
+
 long EFileDispatcher::read(int fd, EA<EIOByteBuffer*>* dsts, int offset, int length) {
 	//@see: openjdk-6/jdk/src/share/classes/sun/nio/ch/IOUtil.java
 
 	if ((offset < 0) || (length < 0) || (offset > dsts->length() - length))
 		throw EINDEXOUTOFBOUNDSEXCEPTION;
 
-	struct iovec *iovBase = (struct iovec *)eso_calloc(sizeof(struct iovec));
+	// one system call, the buffers beyond IOV_MAX are left as they are
+	if (length > IOV_MAX)
+		length = IOV_MAX;
+
+	struct iovec stackIov[IOV_STACK];
+	struct iovec *iovBase = (length <= IOV_STACK) ? stackIov
+			: (struct iovec *)eso_calloc(sizeof(struct iovec) * length);
     struct iovec *iov = iovBase;
 	long bytesRead = 0;
 	try {
@@ -768,13 +782,26 @@ long EFileDispatcher::read(int fd, EA<EIOByteBuffer*>* dsts, int offset, int len
 		bytesRead = readv(fd, iovBase, length);
 	} catch (...) {
 		finally {
-			eso_free(iovBase);
+			if (iovBase != stackIov)
+				eso_free(iovBase);
 		}
 		throw;
 	} finally {
-		eso_free(iovBase);
+		if (iovBase != stackIov)
+			eso_free(iovBase);
 	}
-	return bytesRead;
+
+	long returnVal = bytesRead;
+	// Notify the buffers how many bytes were put
+	for (int i=0; i<length && bytesRead > 0; i++) {
+		EIOByteBuffer* nextBuffer = (*dsts)[i + offset];
+		int pos = nextBuffer->position();
+		int rem = nextBuffer->remaining();
+		int n = (int)ES_MIN(bytesRead, (long)rem);
+		nextBuffer->position(pos + n);
+		bytesRead -= n;
+	}
+	return returnVal;
 }
 
 long EFileDispatcher::write(int fd, EA<EIOByteBuffer*>* srcs, int offset, int length) {
@@ -783,7 +810,13 @@ long EFileDispatcher::write(int fd, EA<EIOByteBuffer*>* srcs, int offset, int le
 	if ((offset < 0) || (length < 0) || (offset > srcs->length() - length))
 		throw EINDEXOUTOFBOUNDSEXCEPTION;
 
-	struct iovec *iovBase = (struct iovec *) eso_calloc(sizeof(struct iovec) * length);
+	// one system call, the buffers beyond IOV_MAX are left as they are
+	if (length > IOV_MAX)
+		length = IOV_MAX;
+
+	struct iovec stackIov[IOV_STACK];
+	struct iovec *iovBase = (length <= IOV_STACK) ? stackIov
+			: (struct iovec *)eso_calloc(sizeof(struct iovec) * length);
     struct iovec *iov = iovBase;
 	long bytesWritten = 0;
 	try {
@@ -796,17 +829,19 @@ long EFileDispatcher::write(int fd, EA<EIOByteBuffer*>* srcs, int offset, int le
 		bytesWritten = writev(fd, iovBase, length);
 	} catch (...) {
 		finally {
-			eso_free(iovBase);
+			if (iovBase != stackIov)
+				eso_free(iovBase);
 		}
 		throw;
 	} finally {
-		eso_free(iovBase);
+		if (iovBase != stackIov)
+			eso_free(iovBase);
 	}
 
 	long returnVal = bytesWritten;
 	// Notify the buffers how many bytes were taken
 	for (int i=0; i<length; i++) {
-		EIOByteBuffer* nextBuffer = (*srcs)[i];
+		EIOByteBuffer* nextBuffer = (*srcs)[i + offset];
 		int pos = nextBuffer->position();
 		int lim = nextBuffer->limit();
 		ES_ASSERT(pos <= lim);
@@ -10,6 +10,7 @@
 #include "../../inc/EMath.hh"
 #include "../inc/EInvalidMarkException.hh"
 #include "../inc/EBufferOverflowException.hh"
+#include "../../inc/EDataFormatException.hh"
 
 namespace efc {
 namespace nio {
@@ -159,10 +160,10 @@ EIOByteBuffer* EIOByteBuffer::compact() {
 	int rem = (_position < _limit ? _limit - _position : 0);
 	if (rem > 0) {
 		eso_memmove(_address, (char*)_address + _position, rem);
-		_position = rem;
-		_limit = _capacity;
-		_mark = -1;
 	}
+	_position = rem;
+	_limit = _capacity;
+	_mark = -1;
 	return this;
 }
 
@@ -233,6 +234,34 @@ EIOByteBuffer* EIOByteBuffer::put(EIOByteBuffer* src) {
 	return this;
 }
 
+int EIOByteBuffer::lz4Compress(EIOByteBuffer* dst, int acceleration) {
+	if (!dst || dst == this)
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+	int n = eso_lz4_compress(current(), remaining(), dst->current(),
+			dst->remaining(), acceleration);
+	if (n <= 0)
+		throw EBufferOverflowException(__FILE__, __LINE__);
+	_position = _limit;
+	dst->_position += n;
+	return n;
+}
+
+int EIOByteBuffer::lz4Decompress(EIOByteBuffer* dst) {
+	if (!dst || dst == this)
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+	int n = eso_lz4_decompress(current(), remaining(), dst->current(),
+			dst->remaining());
+	if (n < 0)
+		throw EDataFormatException(__FILE__, __LINE__, "malformed LZ4 block or buffer overflow");
+	_position = _limit;
+	dst->_position += n;
+	return n;
+}
+
+int EIOByteBuffer::lz4CompressBound(int size) {
+	return eso_lz4_compress_bound(size);
+}
+
 char EIOByteBuffer::getChar() {
 	return this->get();
 }
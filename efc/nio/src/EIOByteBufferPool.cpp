@@ -0,0 +1,533 @@
+/*
+ * EIOByteBufferPool.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "../inc/EIOByteBufferPool.hh"
+#include "../../inc/EThreadLocal.hh"
+#include "../../inc/ESpinLock.hh"
+#include "../../inc/EOutOfMemoryError.hh"
+#include "../../inc/ENullPointerException.hh"
+#include "../../inc/EIllegalStateException.hh"
+#include "../../inc/concurrent/EAtomicLLong.hh"
+
+#ifdef WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+namespace efc {
+namespace nio {
+
+#define SIZE_CLASSES   12          // 512B to 1MB
+#define PAGE_SIZE_     4096
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define SLAB_CHUNKS    16
+#define SLAB_MIN_SIZE  (64 * 1024)
+
+static int sizeOf(int sizeClass) {
+	return EIOByteBufferPool::MIN_SIZE << sizeClass;
+}
+
+static int classOf(int capacity) {
+	int c = 0;
+	while (sizeOf(c) < capacity) {
+		c++;
+	}
+	return c;
+}
+
+static long roundUp(long size, long unit) {
+	return (size + unit - 1) & ~(unit - 1);
+}
+
+/*
+ * Maps page-aligned memory, from the reserved huge pages if asked and
+ * possible.
+ */
+static void* mapMemory(long size, boolean hugePages, boolean* huge) {
+	*huge = false;
+#ifdef WIN32
+	void* p = _aligned_malloc(size, PAGE_SIZE_);
+	if (p == NULL) {
+		throw EOutOfMemoryError(__FILE__, __LINE__, "Map failed");
+	}
+	return p;
+#else
+	void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+	if (hugePages && (size % HUGE_PAGE_SIZE) == 0) {
+		p = ::mmap(NULL, size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		*huge = (p != MAP_FAILED);
+	}
+#endif
+	if (p == MAP_FAILED) {
+		p = ::mmap(NULL, size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p == MAP_FAILED) {
+			throw EOutOfMemoryError(__FILE__, __LINE__, "Map failed");
+		}
+#ifdef MADV_HUGEPAGE
+		if (hugePages) {
+			// transparent huge pages, best effort
+			::madvise(p, size, MADV_HUGEPAGE);
+		}
+#endif
+	}
+	return p;
+#endif
+}
+
+static void unmapMemory(void* address, long size) {
+#ifdef WIN32
+	_aligned_free(address);
+#else
+	::munmap(address, size);
+#endif
+}
+
+/*
+ * The free chunks are linked through their first word.
+ */
+static inline void push(void** head, void* chunk) {
+	*(void**)chunk = *head;
+	*head = chunk;
+}
+
+static inline void* pop(void** head) {
+	void* chunk = *head;
+	*head = *(void**)chunk;
+	return chunk;
+}
+
+/*
+ * The chunks of a thread, per size class, and its share of the metrics.
+ */
+class EIOByteBufferPool::Cache: public EObject {
+public:
+	sp<Arena> arena; // null until first used
+	void* heads[SIZE_CLASSES];
+	int counts[SIZE_CLASSES];
+	llong allocations;
+	llong hits;
+	llong used;      // less what the thread released of other threads'
+	Cache* prev;     // the caches of the arena, under its lock
+	Cache* next;
+
+	Cache() : allocations(0), hits(0), used(0), prev(null), next(null) {
+		memset(heads, 0, sizeof(heads));
+		memset(counts, 0, sizeof(counts));
+	}
+
+	virtual ~Cache();
+};
+
+class EIOByteBufferPool::ThreadLocalCache: public EThreadLocal {
+public:
+	virtual EObject* initialValue() {
+		return new Cache();
+	}
+};
+
+/*
+ * The slabs and the free chunks shared by the threads.
+ */
+class EIOByteBufferPool::Arena: public EObject {
+public:
+	struct Slab {
+		void* base;
+		long size;
+		Slab* next;
+	};
+
+#ifdef CPP11_SUPPORT
+	// the cache the thread used last, spares the thread-local lookup
+	static THREAD_TLS Cache* last;
+#endif
+
+	boolean hugePages;
+	int cacheSize;
+	int batch;
+	EThreadLocalVariable<ThreadLocalCache, Cache>* caches;
+
+	ESpinLock lock;
+	void* heads[SIZE_CLASSES];
+	int counts[SIZE_CLASSES];
+	Slab* slabs;
+	Cache* live;
+	llong reserved;
+	int hugeSlabs;
+	int threads;
+	llong allocations; // of the caches gone
+	llong hits;
+	llong used;
+
+	EAtomicLLong unpooled;
+	EAtomicLLong unpooledUsed;
+
+	Arena(boolean hugePages, int cacheSize) : hugePages(hugePages),
+			cacheSize(cacheSize), batch(ES_MAX(cacheSize / 2, 1)),
+			slabs(null), live(null), reserved(0), hugeSlabs(0), threads(0),
+			allocations(0), hits(0), used(0) {
+		memset(heads, 0, sizeof(heads));
+		memset(counts, 0, sizeof(counts));
+		caches = new EThreadLocalVariable<ThreadLocalCache, Cache>();
+	}
+
+	virtual ~Arena() {
+		delete caches;
+		while (slabs != null) {
+			Slab* s = slabs;
+			slabs = s->next;
+			unmapMemory(s->base, s->size);
+			delete s;
+		}
+	}
+
+	Cache* cacheOf(sp<Arena>& self) {
+#ifdef CPP11_SUPPORT
+		Cache* cache = last;
+		if (cache != null && cache->arena.get() == this) {
+			return cache;
+		}
+#endif
+		cache = caches->get();
+		if (cache->arena == null) {
+			cache->arena = self;
+			SYNCBLOCK (&lock) {
+				cache->next = live;
+				if (live != null) {
+					live->prev = cache;
+				}
+				live = cache;
+				threads++;
+            }}
+		}
+#ifdef CPP11_SUPPORT
+		last = cache;
+#endif
+		return cache;
+	}
+
+	/*
+	 * Moves a batch of chunks of the class into the cache, carving a slab
+	 * if the arena has none.
+	 */
+	void refill(Cache* cache, int c) {
+		SYNCBLOCK (&lock) {
+			if (counts[c] == 0) {
+				carve(c);
+			}
+			for (int n = ES_MIN(batch, counts[c]); n > 0; n--) {
+				push(&cache->heads[c], pop(&heads[c]));
+				counts[c]--;
+				cache->counts[c]++;
+			}
+        }}
+	}
+
+	/*
+	 * Moves n chunks of the class from the cache to the arena.
+	 */
+	void flush(Cache* cache, int c, int n) {
+		SYNCBLOCK (&lock) {
+			for (; n > 0; n--) {
+				push(&heads[c], pop(&cache->heads[c]));
+				cache->counts[c]--;
+				counts[c]++;
+			}
+        }}
+	}
+
+	void carve(int c) {
+		long chunk = sizeOf(c);
+		long size = hugePages ? HUGE_PAGE_SIZE
+				: ES_MIN(ES_MAX(chunk * SLAB_CHUNKS, SLAB_MIN_SIZE), HUGE_PAGE_SIZE);
+		boolean huge;
+		char* base = (char*)mapMemory(size, hugePages, &huge);
+		Slab* s = new Slab();
+		s->base = base;
+		s->size = size;
+		s->next = slabs;
+		slabs = s;
+		reserved += size;
+		if (huge) {
+			hugeSlabs++;
+		}
+		// in reverse, the first chunks are served first
+		for (long off = size - chunk; off >= 0; off -= chunk) {
+			push(&heads[c], base + off);
+			counts[c]++;
+		}
+	}
+
+	/*
+	 * Sums a metric of the live caches and of the caches gone.
+	 */
+	llong sum(llong Cache::*metric, llong& gone) {
+		SYNCBLOCK (&lock) {
+			llong n = gone;
+			for (Cache* cache = live; cache != null; cache = cache->next) {
+				n += cache->*metric;
+			}
+			return n;
+        }}
+	}
+};
+
+#ifdef CPP11_SUPPORT
+THREAD_TLS EIOByteBufferPool::Cache* EIOByteBufferPool::Arena::last = null;
+#endif
+
+EIOByteBufferPool::Cache::~Cache() {
+#ifdef CPP11_SUPPORT
+	if (Arena::last == this) {
+		Arena::last = null;
+	}
+#endif
+	if (arena == null) {
+		return;
+	}
+	for (int c = 0; c < SIZE_CLASSES; c++) {
+		if (counts[c] > 0) {
+			arena->flush(this, c, counts[c]);
+		}
+	}
+	SYNCBLOCK (&arena->lock) {
+		if (prev != null) {
+			prev->next = next;
+		} else {
+			arena->live = next;
+		}
+		if (next != null) {
+			next->prev = prev;
+		}
+		arena->threads--;
+		arena->allocations += allocations;
+		arena->hits += hits;
+		arena->used += used;
+    }}
+}
+
+//=============================================================================
+
+EIOByteBufferPool::~EIOByteBufferPool() {
+	// the other threads return their chunks when they end
+	arena_->caches->remove();
+}
+
+EIOByteBufferPool::EIOByteBufferPool(boolean hugePages, int cacheSize) {
+	if (cacheSize < 0) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Negative cache size");
+	}
+	arena_ = new Arena(hugePages, cacheSize);
+}
+
+EPooledByteBuffer* EIOByteBufferPool::allocate(int capacity) {
+	if (capacity < 0) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Negative capacity");
+	}
+	Arena* arena = arena_.get();
+	if (capacity > MAX_SIZE) {
+		long size = roundUp(capacity, PAGE_SIZE_);
+		if (arena->hugePages) {
+			size = roundUp(size, HUGE_PAGE_SIZE);
+		}
+		boolean huge;
+		void* address = mapMemory(size, arena->hugePages, &huge);
+		EPooledByteBuffer* buf = new EPooledByteBuffer(address, capacity);
+		buf->arena_ = arena_;
+		buf->mapped_ = size;
+		arena->unpooled.incrementAndGet();
+		arena->unpooledUsed.addAndGet(size);
+		return buf;
+	}
+
+	int c = classOf(capacity);
+	Cache* cache = arena->cacheOf(arena_);
+	cache->allocations++;
+	if (cache->counts[c] > 0) {
+		cache->hits++;
+	} else {
+		arena->refill(cache, c);
+	}
+	EPooledByteBuffer* buf = new EPooledByteBuffer(pop(&cache->heads[c]), capacity);
+	cache->counts[c]--;
+	cache->used += sizeOf(c);
+	buf->arena_ = arena_;
+	buf->sizeClass_ = c;
+	return buf;
+}
+
+long EIOByteBufferPool::read(EByteChannel* channel, EA<EIOByteBuffer*>* dsts, int bufferSize) {
+	if (channel == null || dsts == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	EA<boolean> given(dsts->length());
+	for (int i = 0; i < dsts->length(); i++) {
+		if ((*dsts)[i] == null) {
+			(*dsts)[i] = allocate(bufferSize);
+			given[i] = true;
+		}
+	}
+
+	long n = -1;
+	try {
+		n = channel->read(dsts);
+	} catch (...) {
+		for (int i = 0; i < dsts->length(); i++) {
+			if (given[i]) {
+				((EPooledByteBuffer*)(*dsts)[i])->release();
+				(*dsts)[i] = null;
+			}
+		}
+		throw;
+	}
+	for (int i = 0; i < dsts->length(); i++) {
+		if (given[i] && (*dsts)[i]->position() == 0) {
+			((EPooledByteBuffer*)(*dsts)[i])->release();
+			(*dsts)[i] = null;
+		}
+	}
+	return n;
+}
+
+void EIOByteBufferPool::trim() {
+	Cache* cache = arena_->caches->get();
+	if (cache->arena == null) {
+		return;
+	}
+	for (int c = 0; c < SIZE_CLASSES; c++) {
+		if (cache->counts[c] > 0) {
+			arena_->flush(cache, c, cache->counts[c]);
+		}
+	}
+}
+
+llong EIOByteBufferPool::allocations() {
+	return arena_->sum(&Cache::allocations, arena_->allocations) + unpooledAllocations();
+}
+
+llong EIOByteBufferPool::cacheHits() {
+	return arena_->sum(&Cache::hits, arena_->hits);
+}
+
+llong EIOByteBufferPool::unpooledAllocations() {
+	return arena_->unpooled.get();
+}
+
+llong EIOByteBufferPool::usedBytes() {
+	return arena_->sum(&Cache::used, arena_->used) + arena_->unpooledUsed.get();
+}
+
+llong EIOByteBufferPool::reservedBytes() {
+	SYNCBLOCK (&arena_->lock) {
+		return arena_->reserved;
+    }}
+}
+
+int EIOByteBufferPool::hugePageSlabs() {
+	SYNCBLOCK (&arena_->lock) {
+		return arena_->hugeSlabs;
+    }}
+}
+
+int EIOByteBufferPool::threadCaches() {
+	SYNCBLOCK (&arena_->lock) {
+		return arena_->threads;
+    }}
+}
+
+EString EIOByteBufferPool::toString() {
+	return EString::formatOf("EIOByteBufferPool[allocations=%lld, cacheHits=%lld, unpooled=%lld, used=%lld, reserved=%lld, hugePageSlabs=%d, threadCaches=%d]",
+			allocations(), cacheHits(), unpooledAllocations(), usedBytes(),
+			reservedBytes(), hugePageSlabs(), threadCaches());
+}
+
+//=============================================================================
+
+EPooledByteBuffer::~EPooledByteBuffer() {
+	if (refs_.get() > 0) {
+		free();
+	}
+}
+
+EPooledByteBuffer::EPooledByteBuffer(void* address, int capacity) :
+		refs_(1), parent_(null), sizeClass_(-1), mapped_(0) {
+	_address = address;
+	_capacity = capacity;
+	_limit = capacity;
+}
+
+EPooledByteBuffer* EPooledByteBuffer::retain() {
+	refs_.incrementAndGet();
+	return this;
+}
+
+boolean EPooledByteBuffer::release() {
+	int n = refs_.decrementAndGet();
+	if (n > 0) {
+		return false;
+	}
+	if (n < 0) {
+		throw EIllegalStateException(__FILE__, __LINE__, "Released too many times");
+	}
+	free();
+	delete this;
+	return true;
+}
+
+int EPooledByteBuffer::refCnt() {
+	return refs_.get();
+}
+
+EPooledByteBuffer* EPooledByteBuffer::retainedSlice() {
+	return retainedSlice(position(), remaining());
+}
+
+EPooledByteBuffer* EPooledByteBuffer::retainedSlice(int index, int length) {
+	if (index < 0 || length < 0 || index > capacity() - length) {
+		throw EINDEXOUTOFBOUNDSEXCEPTION;
+	}
+	EPooledByteBuffer* slice = new EPooledByteBuffer((char*)address() + index, length);
+	slice->parent_ = retain();
+	return slice;
+}
+
+EString EPooledByteBuffer::toString() {
+	return EString::formatOf("EPooledByteBuffer[pos=%d lim=%d cap=%d refs=%d%s]",
+			position(), limit(), capacity(), refs_.get(),
+			(parent_ != null) ? " slice" : "");
+}
+
+void EPooledByteBuffer::free() {
+	if (parent_ != null) {
+		parent_->release();
+		parent_ = null;
+		return;
+	}
+	EIOByteBufferPool::Arena* arena = arena_.get();
+	if (sizeClass_ < 0) {
+		unmapMemory(_address, mapped_);
+		arena->unpooledUsed.addAndGet(-mapped_);
+	} else {
+		// back to the cache of the releasing thread
+		EIOByteBufferPool::Cache* cache = arena->cacheOf(arena_);
+		push(&cache->heads[sizeClass_], _address);
+		if (++cache->counts[sizeClass_] > arena->cacheSize) {
+			arena->flush(cache, sizeClass_, cache->counts[sizeClass_] - arena->cacheSize / 2);
+		}
+		cache->used -= sizeOf(sizeClass_);
+	}
+	_address = null;
+}
+
+} /* namespace nio */
+} /* namespace efc */
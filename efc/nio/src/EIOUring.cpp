@@ -0,0 +1,733 @@
+/*
+ * EIOUring.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "es_config.h"
+#include "../inc/EIOUring.hh"
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <signal.h>
+#include <endian.h>
+#endif
+
+namespace efc {
+namespace nio {
+
+#ifdef HAVE_IO_URING
+
+// kinds of operations
+#define OP_READ          1
+#define OP_WRITE         2
+#define OP_RECV          3
+#define OP_SEND          4
+#define OP_RECV_MULTI    5
+#define OP_ACCEPT        6
+#define OP_ACCEPT_MULTI  7
+#define OP_ACCEPT_LOOP   8  // multishot accept emulated by rearming
+#define OP_POLL          9
+
+// user data of the internal requests
+#define TAG_IGNORE       0
+#define TAG_WAKEUP       1
+
+struct EIOUring::Op {
+	ECompletionHandler* handler;
+	EIOByteBuffer* buffer;
+	Op* next; // in the free list
+	Op* link; // in the list of all operations
+	int kind;
+	int fd;
+	int len;
+};
+
+struct EIOUring::BufferRing {
+	BufferRing* next;
+	struct io_uring_buf_ring* ring;
+	char* base;
+	int group;
+	int count;
+	int size;
+	unsigned short tail;
+};
+
+static int io_uring_setup(unsigned entries, struct io_uring_params* p) {
+	return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete,
+		unsigned flags, void* arg, size_t argsz) {
+	return (int)syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argsz);
+}
+
+static int io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr) {
+	return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr);
+}
+
+static inline unsigned load_acquire(unsigned* p) {
+	return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void store_release(unsigned* p, unsigned v) {
+	__atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+static inline unsigned poll_events(int events) {
+#if __BYTE_ORDER == __BIG_ENDIAN
+	return ((unsigned)events << 16) | ((unsigned)events >> 16);
+#else
+	return (unsigned)events;
+#endif
+}
+
+// the kernel features required: the wait with a timeout in io_uring_enter
+// and no completion ever dropped
+#define REQUIRED_FEATURES (IORING_FEAT_EXT_ARG | IORING_FEAT_NODROP)
+
+static volatile int available = -1;
+
+boolean EIOUring::isAvailable() {
+	if (available < 0) {
+		struct io_uring_params p;
+		memset(&p, 0, sizeof(p));
+		int fd = io_uring_setup(2, &p);
+		if (fd >= 0) {
+			::close(fd);
+		}
+		available = (fd >= 0 && (p.features & REQUIRED_FEATURES) == REQUIRED_FEATURES);
+	}
+	return available == 1;
+}
+
+EIOUring::~EIOUring() {
+	close();
+}
+
+EIOUring::EIOUring(int entries) : ringFd_(-1), eventFd_(-1), features_(0),
+		sqRing_(MAP_FAILED), cqRing_(MAP_FAILED), sqes_(MAP_FAILED),
+		sqRingSize_(0), cqRingSize_(0), sqesSize_(0),
+		sqHead_(null), sqTail_(null), sqFlags_(null), sqMask_(0), sqEntries_(0),
+		sqArray_(null), sqLocalTail_(0), cqHead_(null), cqTail_(null), cqMask_(0),
+		cqes_(null), freeOps_(null), allOps_(null), iovecs_(null), iovecCount_(0),
+		bufferRings_(null), wakeupValue_(0), woken_(false), wakeupArmed_(false),
+		closed_(false) {
+	struct io_uring_params p;
+	memset(&p, 0, sizeof(p));
+	ringFd_ = io_uring_setup(entries, &p);
+	if (ringFd_ < 0) {
+		int err = errno;
+		closed_ = true;
+		throw EIOException(__FILE__, __LINE__, "io_uring_setup failed", err);
+	}
+	features_ = p.features;
+	if ((features_ & REQUIRED_FEATURES) != REQUIRED_FEATURES) {
+		close();
+		throw EIOException(__FILE__, __LINE__, "io_uring needs Linux 5.11+");
+	}
+
+	sqRingSize_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	cqRingSize_ = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	if (features_ & IORING_FEAT_SINGLE_MMAP) {
+		sqRingSize_ = cqRingSize_ = ES_MAX(sqRingSize_, cqRingSize_);
+	}
+	sqRing_ = mmap(0, sqRingSize_, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+	if (sqRing_ != MAP_FAILED) {
+		if (features_ & IORING_FEAT_SINGLE_MMAP) {
+			cqRing_ = sqRing_;
+		} else {
+			cqRing_ = mmap(0, cqRingSize_, PROT_READ | PROT_WRITE,
+					MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_CQ_RING);
+		}
+	}
+	sqesSize_ = p.sq_entries * sizeof(struct io_uring_sqe);
+	if (cqRing_ != MAP_FAILED) {
+		sqes_ = mmap(0, sqesSize_, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+	}
+	if (sqes_ == MAP_FAILED) {
+		int err = errno;
+		close();
+		throw EIOException(__FILE__, __LINE__, "io_uring mmap failed", err);
+	}
+
+	char* sq = (char*)sqRing_;
+	sqHead_ = (unsigned*)(sq + p.sq_off.head);
+	sqTail_ = (unsigned*)(sq + p.sq_off.tail);
+	sqFlags_ = (unsigned*)(sq + p.sq_off.flags);
+	sqMask_ = *(unsigned*)(sq + p.sq_off.ring_mask);
+	sqEntries_ = *(unsigned*)(sq + p.sq_off.ring_entries);
+	sqArray_ = (unsigned*)(sq + p.sq_off.array);
+	sqLocalTail_ = *sqTail_;
+	for (unsigned i = 0; i < sqEntries_; i++) {
+		sqArray_[i] = i; // the sqes are used in ring order
+	}
+
+	char* cq = (char*)cqRing_;
+	cqHead_ = (unsigned*)(cq + p.cq_off.head);
+	cqTail_ = (unsigned*)(cq + p.cq_off.tail);
+	cqMask_ = *(unsigned*)(cq + p.cq_off.ring_mask);
+	cqes_ = cq + p.cq_off.cqes;
+
+	eventFd_ = eventfd(0, EFD_CLOEXEC);
+	if (eventFd_ < 0) {
+		int err = errno;
+		close();
+		throw EIOException(__FILE__, __LINE__, "eventfd failed", err);
+	}
+	queueWakeup();
+}
+
+llong EIOUring::read(int fd, void* buf, int len, llong offset, ECompletionHandler* handler) {
+	return queueRw(IORING_OP_READ, OP_READ, fd, buf, len, offset, handler, null);
+}
+
+llong EIOUring::write(int fd, const void* buf, int len, llong offset, ECompletionHandler* handler) {
+	return queueRw(IORING_OP_WRITE, OP_WRITE, fd, buf, len, offset, handler, null);
+}
+
+llong EIOUring::read(int fd, EIOByteBuffer* dst, llong offset, ECompletionHandler* handler) {
+	return queueRw(IORING_OP_READ, OP_READ, fd, dst->current(), dst->remaining(), offset, handler, dst);
+}
+
+llong EIOUring::write(int fd, EIOByteBuffer* src, llong offset, ECompletionHandler* handler) {
+	return queueRw(IORING_OP_WRITE, OP_WRITE, fd, src->current(), src->remaining(), offset, handler, src);
+}
+
+llong EIOUring::recv(int fd, EIOByteBuffer* dst, ECompletionHandler* handler) {
+	return queueRw(IORING_OP_RECV, OP_RECV, fd, dst->current(), dst->remaining(), 0, handler, dst);
+}
+
+llong EIOUring::send(int fd, EIOByteBuffer* src, ECompletionHandler* handler) {
+	return queueRw(IORING_OP_SEND, OP_SEND, fd, src->current(), src->remaining(), 0, handler, src);
+}
+
+llong EIOUring::recvMultishot(int fd, int group, ECompletionHandler* handler) {
+#ifdef IORING_RECV_MULTISHOT
+	if (!findBufferRing(group)) {
+		throw EIOException(__FILE__, __LINE__, "No such buffer ring");
+	}
+	struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+	Op* op = newOp(OP_RECV_MULTI, fd, 0, handler, null);
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = fd;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = group;
+	sqe->user_data = (ullong)(uintptr_t)op;
+	return (llong)(uintptr_t)op;
+#else
+	throw EIOException(__FILE__, __LINE__, "Multishot recv not supported");
+#endif
+}
+
+llong EIOUring::accept(int fd, boolean multishot, ECompletionHandler* handler) {
+	Op* op = newOp(multishot ? OP_ACCEPT_MULTI : OP_ACCEPT, fd, 0, handler, null);
+	try {
+		queueAccept(op);
+	} catch (...) {
+		freeOp(op);
+		throw;
+	}
+	return (llong)(uintptr_t)op;
+}
+
+llong EIOUring::pollAdd(int fd, int events, ECompletionHandler* handler) {
+	struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+	Op* op = newOp(OP_POLL, fd, 0, handler, null);
+	sqe->opcode = IORING_OP_POLL_ADD;
+	sqe->fd = fd;
+	sqe->poll32_events = poll_events(events);
+	sqe->user_data = (ullong)(uintptr_t)op;
+	return (llong)(uintptr_t)op;
+}
+
+void EIOUring::updatePoll(llong id, int events) {
+	struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+	sqe->opcode = IORING_OP_POLL_REMOVE;
+	sqe->fd = -1;
+	sqe->addr = (ullong)id;
+	sqe->len = IORING_POLL_UPDATE_EVENTS;
+	sqe->poll32_events = poll_events(events);
+	if (features_ & IORING_FEAT_CQE_SKIP) {
+		sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+	}
+	sqe->user_data = TAG_IGNORE;
+}
+
+void EIOUring::cancel(llong id) {
+	struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->fd = -1;
+	sqe->addr = (ullong)id;
+	if (features_ & IORING_FEAT_CQE_SKIP) {
+		sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+	}
+	sqe->user_data = TAG_IGNORE;
+}
+
+void EIOUring::registerBuffers(EIOByteBuffer* buffers[], int n) {
+	ES_ASSERT(n > 0);
+
+	unregisterBuffers();
+	struct iovec* iov = (struct iovec*)eso_calloc(n * sizeof(struct iovec));
+	for (int i = 0; i < n; i++) {
+		iov[i].iov_base = buffers[i]->address();
+		iov[i].iov_len = buffers[i]->capacity();
+	}
+	if (io_uring_register(ringFd_, IORING_REGISTER_BUFFERS, iov, n) < 0) {
+		int err = errno;
+		eso_free(iov);
+		throw EIOException(__FILE__, __LINE__, "Register buffers failed", err);
+	}
+	iovecs_ = iov;
+	iovecCount_ = n;
+}
+
+void EIOUring::unregisterBuffers() {
+	if (iovecs_) {
+		io_uring_register(ringFd_, IORING_UNREGISTER_BUFFERS, NULL, 0);
+		eso_free(iovecs_);
+		iovecs_ = null;
+		iovecCount_ = 0;
+	}
+}
+
+void EIOUring::setupBufferRing(int group, int count, int size) {
+	ES_ASSERT(count > 0 && count <= 32768 && size > 0);
+
+#ifdef IORING_RECV_MULTISHOT
+	if (findBufferRing(group)) {
+		throw EIOException(__FILE__, __LINE__, "Buffer ring exists");
+	}
+	int n = 1;
+	while (n < count) n <<= 1;
+
+	BufferRing* br = new BufferRing();
+	br->group = group;
+	br->count = n;
+	br->size = size;
+	br->tail = 0;
+	br->ring = (struct io_uring_buf_ring*)mmap(0, n * sizeof(struct io_uring_buf),
+			PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	br->base = (char*)mmap(0, (size_t)n * size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (br->ring == MAP_FAILED || br->base == MAP_FAILED) {
+		int err = errno;
+		if (br->ring != MAP_FAILED) munmap(br->ring, n * sizeof(struct io_uring_buf));
+		if (br->base != MAP_FAILED) munmap(br->base, (size_t)n * size);
+		delete br;
+		throw EIOException(__FILE__, __LINE__, "Buffer ring mmap failed", err);
+	}
+
+	struct io_uring_buf_reg reg;
+	memset(&reg, 0, sizeof(reg));
+	reg.ring_addr = (ullong)(uintptr_t)br->ring;
+	reg.ring_entries = n;
+	reg.bgid = group;
+	if (io_uring_register(ringFd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+		int err = errno;
+		munmap(br->ring, n * sizeof(struct io_uring_buf));
+		munmap(br->base, (size_t)n * size);
+		delete br;
+		throw EIOException(__FILE__, __LINE__, "Provided buffer ring not supported", err);
+	}
+	br->next = bufferRings_;
+	bufferRings_ = br;
+
+	for (int bid = 0; bid < n; bid++) {
+		recycleBuffer(group, bid);
+	}
+#else
+	throw EIOException(__FILE__, __LINE__, "Provided buffer ring not supported");
+#endif
+}
+
+void* EIOUring::getBuffer(int group, int bid) {
+	BufferRing* br = findBufferRing(group);
+	ES_ASSERT(br && bid >= 0 && bid < br->count);
+	return br->base + (size_t)bid * br->size;
+}
+
+void EIOUring::recycleBuffer(int group, int bid) {
+	BufferRing* br = findBufferRing(group);
+	ES_ASSERT(br && bid >= 0 && bid < br->count);
+
+	// the tail overlays the reserved field of the first entry, so the
+	// fields are set one by one; the entries start at the ring itself (the
+	// bufs member of the kernel header is padded when compiled as C++)
+	struct io_uring_buf* buf = (struct io_uring_buf*)br->ring + (br->tail & (br->count - 1));
+	buf->addr = (ullong)(uintptr_t)(br->base + (size_t)bid * br->size);
+	buf->len = br->size;
+	buf->bid = bid;
+	br->tail++;
+	__atomic_store_n(&br->ring->tail, br->tail, __ATOMIC_RELEASE);
+}
+
+int EIOUring::submit() {
+	if (closed_) {
+		throw EIOException(__FILE__, __LINE__, "Ring closed");
+	}
+	return enter(sqLocalTail_ - load_acquire(sqHead_), 0, 0, 0);
+}
+
+int EIOUring::poll(llong timeout) {
+	if (closed_) {
+		throw EIOException(__FILE__, __LINE__, "Ring closed");
+	}
+	woken_ = false;
+
+	unsigned toSubmit = sqLocalTail_ - load_acquire(sqHead_);
+	unsigned flags = 0;
+	unsigned minComplete = 0;
+	if (load_acquire(cqTail_) == *cqHead_ && timeout != 0) {
+		flags = IORING_ENTER_GETEVENTS;
+		minComplete = 1;
+	} else if (load_acquire(sqFlags_) & IORING_SQ_CQ_OVERFLOW) {
+		// flushes the completions which overflowed the ring
+		flags = IORING_ENTER_GETEVENTS;
+	}
+	enter(toSubmit, minComplete, flags, timeout);
+	return reap();
+}
+
+void EIOUring::wakeup() {
+	if (eventFd_ >= 0) {
+		ullong one = 1;
+		if (::write(eventFd_, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+			throw EIOException(__FILE__, __LINE__, "EIOUring: wakeup failed", errno);
+		}
+	}
+}
+
+boolean EIOUring::isWokenUp() {
+	return woken_;
+}
+
+void EIOUring::close() {
+	if (ringFd_ >= 0) {
+		// the kernel releases the registered and provided buffers
+		::close(ringFd_);
+		ringFd_ = -1;
+	}
+	closed_ = true;
+	if (sqes_ != MAP_FAILED) {
+		munmap(sqes_, sqesSize_);
+		sqes_ = MAP_FAILED;
+	}
+	if (cqRing_ != MAP_FAILED && cqRing_ != sqRing_) {
+		munmap(cqRing_, cqRingSize_);
+	}
+	cqRing_ = MAP_FAILED;
+	if (sqRing_ != MAP_FAILED) {
+		munmap(sqRing_, sqRingSize_);
+		sqRing_ = MAP_FAILED;
+	}
+	if (eventFd_ >= 0) {
+		::close(eventFd_);
+		eventFd_ = -1;
+	}
+	if (iovecs_) {
+		eso_free(iovecs_);
+		iovecs_ = null;
+		iovecCount_ = 0;
+	}
+	while (bufferRings_) {
+		BufferRing* br = bufferRings_;
+		bufferRings_ = br->next;
+		munmap(br->ring, br->count * sizeof(struct io_uring_buf));
+		munmap(br->base, (size_t)br->count * br->size);
+		delete br;
+	}
+	while (allOps_) {
+		Op* op = allOps_;
+		allOps_ = op->link;
+		delete op;
+	}
+	freeOps_ = null;
+}
+
+boolean EIOUring::hasMore(int flags) {
+	return (flags & IORING_CQE_F_MORE) != 0;
+}
+
+int EIOUring::getBufferId(int flags) {
+	return (flags & IORING_CQE_F_BUFFER) ? (int)((unsigned)flags >> IORING_CQE_BUFFER_SHIFT) : -1;
+}
+
+EString EIOUring::toString() {
+	return EString::formatOf("EIOUring[fd=%d, entries=%u]", ringFd_, sqEntries_);
+}
+
+void* EIOUring::getSqe() {
+	if (closed_) {
+		throw EIOException(__FILE__, __LINE__, "Ring closed");
+	}
+	if (sqLocalTail_ - load_acquire(sqHead_) >= sqEntries_) {
+		// full, hands the queue to the kernel now
+		enter(sqLocalTail_ - load_acquire(sqHead_), 0, 0, 0);
+		if (sqLocalTail_ - load_acquire(sqHead_) >= sqEntries_) {
+			throw EIOException(__FILE__, __LINE__, "io_uring submission queue full");
+		}
+	}
+	struct io_uring_sqe* sqe = (struct io_uring_sqe*)sqes_ + (sqLocalTail_ & sqMask_);
+	memset(sqe, 0, sizeof(*sqe));
+	sqLocalTail_++;
+	return sqe;
+}
+
+EIOUring::Op* EIOUring::newOp(int kind, int fd, int len,
+		ECompletionHandler* handler, EIOByteBuffer* buffer) {
+	ES_ASSERT(handler);
+
+	Op* op = freeOps_;
+	if (op) {
+		freeOps_ = op->next;
+	} else {
+		op = new Op();
+		op->link = allOps_;
+		allOps_ = op;
+	}
+	op->handler = handler;
+	op->buffer = buffer;
+	op->next = null;
+	op->kind = kind;
+	op->fd = fd;
+	op->len = len;
+	return op;
+}
+
+void EIOUring::freeOp(Op* op) {
+	op->handler = null;
+	op->buffer = null;
+	op->next = freeOps_;
+	freeOps_ = op;
+}
+
+llong EIOUring::queueRw(int opcode, int kind, int fd, const void* buf, int len,
+		llong offset, ECompletionHandler* handler, EIOByteBuffer* buffer) {
+	ES_ASSERT(buf || len == 0);
+	ES_ASSERT(len >= 0);
+
+	struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+	Op* op = newOp(kind, fd, len, handler, buffer);
+	int index = (kind == OP_READ || kind == OP_WRITE) ? findRegistered(buf, len) : -1;
+	if (index >= 0) {
+		opcode = (kind == OP_READ) ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+		sqe->buf_index = index;
+	}
+	sqe->opcode = opcode;
+	sqe->fd = fd;
+	sqe->addr = (ullong)(uintptr_t)buf;
+	sqe->len = len;
+	sqe->off = (ullong)offset;
+	if (kind == OP_SEND) {
+		sqe->msg_flags = MSG_NOSIGNAL;
+	}
+	sqe->user_data = (ullong)(uintptr_t)op;
+	return (llong)(uintptr_t)op;
+}
+
+void EIOUring::queueAccept(Op* op) {
+	struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+	sqe->opcode = IORING_OP_ACCEPT;
+	sqe->fd = op->fd;
+	sqe->accept_flags = SOCK_CLOEXEC;
+#ifdef IORING_ACCEPT_MULTISHOT
+	if (op->kind == OP_ACCEPT_MULTI) {
+		sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+	}
+#else
+	if (op->kind == OP_ACCEPT_MULTI) {
+		op->kind = OP_ACCEPT_LOOP;
+	}
+#endif
+	sqe->user_data = (ullong)(uintptr_t)op;
+}
+
+void EIOUring::queueWakeup() {
+	struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+	sqe->opcode = IORING_OP_READ;
+	sqe->fd = eventFd_;
+	sqe->addr = (ullong)(uintptr_t)&wakeupValue_;
+	sqe->len = sizeof(wakeupValue_);
+	sqe->user_data = TAG_WAKEUP;
+	wakeupArmed_ = true;
+}
+
+int EIOUring::enter(unsigned toSubmit, unsigned minComplete, unsigned flags, llong timeout) {
+	store_release(sqTail_, sqLocalTail_);
+	if (toSubmit == 0 && flags == 0) {
+		return 0;
+	}
+
+	struct io_uring_getevents_arg arg;
+	struct __kernel_timespec ts;
+	void* argp = NULL;
+	size_t argsz = 0;
+	if (minComplete > 0 && timeout > 0) {
+		ts.tv_sec = timeout / 1000;
+		ts.tv_nsec = (timeout % 1000) * 1000000;
+		memset(&arg, 0, sizeof(arg));
+		arg.sigmask_sz = _NSIG / 8;
+		arg.ts = (ullong)(uintptr_t)&ts;
+		flags |= IORING_ENTER_EXT_ARG;
+		argp = &arg;
+		argsz = sizeof(arg);
+	}
+	int r = io_uring_enter(ringFd_, toSubmit, minComplete, flags, argp, argsz);
+	if (r < 0) {
+		// interrupted, timed out, or the completions are to be reaped first
+		if (errno == EINTR || errno == ETIME || errno == EBUSY || errno == EAGAIN) {
+			return 0;
+		}
+		throw EIOException(__FILE__, __LINE__, "io_uring_enter failed", errno);
+	}
+	return r;
+}
+
+int EIOUring::reap() {
+	int n = 0;
+	unsigned head = *cqHead_;
+	for (;;) {
+		unsigned tail = load_acquire(cqTail_);
+		if (head == tail) {
+			break;
+		}
+		struct io_uring_cqe* cqe = (struct io_uring_cqe*)cqes_ + (head & cqMask_);
+		ullong userData = cqe->user_data;
+		int res = cqe->res;
+		unsigned flags = cqe->flags;
+
+		// frees the slot before the handler runs, it may queue more
+		store_release(cqHead_, ++head);
+		n += dispatch(userData, res, flags);
+		if (closed_) {
+			break; // closed by the handler
+		}
+	}
+	return n;
+}
+
+int EIOUring::dispatch(ullong userData, int res, unsigned flags) {
+	if (userData == TAG_IGNORE) {
+		return 0;
+	}
+	if (userData == TAG_WAKEUP) {
+		wakeupArmed_ = false;
+		woken_ = true;
+		queueWakeup();
+		return 1;
+	}
+
+	Op* op = (Op*)(uintptr_t)userData;
+	ECompletionHandler* handler = op->handler;
+	EIOByteBuffer* buffer = op->buffer;
+	int kind = op->kind;
+	int len = op->len;
+
+	if (kind == OP_ACCEPT_MULTI && res == -EINVAL) {
+		// no multishot accept in this kernel, the op rearms itself instead
+		op->kind = OP_ACCEPT_LOOP;
+		queueAccept(op);
+		return 0;
+	}
+	if (kind == OP_ACCEPT_LOOP && res >= 0) {
+		queueAccept(op);
+		flags |= IORING_CQE_F_MORE;
+	} else if (!(flags & IORING_CQE_F_MORE)) {
+		freeOp(op);
+	}
+
+	if (res < 0) {
+		EIOException e(__FILE__, __LINE__, strerror(-res), -res);
+		handler->failed(&e);
+	} else {
+		if (buffer) {
+			if (res > 0) {
+				buffer->position(buffer->position() + res);
+			} else if (len > 0 && (kind == OP_READ || kind == OP_RECV)) {
+				res = -1; // end-of-stream
+			}
+		}
+		handler->completed(res, flags);
+	}
+	return 1;
+}
+
+int EIOUring::findRegistered(const void* buf, int len) {
+	struct iovec* iov = (struct iovec*)iovecs_;
+	for (int i = 0; i < iovecCount_; i++) {
+		char* base = (char*)iov[i].iov_base;
+		if ((char*)buf >= base && (char*)buf + len <= base + iov[i].iov_len) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+EIOUring::BufferRing* EIOUring::findBufferRing(int group) {
+	for (BufferRing* br = bufferRings_; br; br = br->next) {
+		if (br->group == group) {
+			return br;
+		}
+	}
+	return null;
+}
+
+#else //!HAVE_IO_URING
+
+struct EIOUring::Op {
+};
+
+struct EIOUring::BufferRing {
+};
+
+boolean EIOUring::isAvailable() {
+	return false;
+}
+
+EIOUring::~EIOUring() {
+}
+
+EIOUring::EIOUring(int entries) {
+	throw EIOException(__FILE__, __LINE__, "io_uring not supported");
+}
+
+llong EIOUring::read(int fd, void* buf, int len, llong offset, ECompletionHandler* handler) { return 0; }
+llong EIOUring::write(int fd, const void* buf, int len, llong offset, ECompletionHandler* handler) { return 0; }
+llong EIOUring::read(int fd, EIOByteBuffer* dst, llong offset, ECompletionHandler* handler) { return 0; }
+llong EIOUring::write(int fd, EIOByteBuffer* src, llong offset, ECompletionHandler* handler) { return 0; }
+llong EIOUring::recv(int fd, EIOByteBuffer* dst, ECompletionHandler* handler) { return 0; }
+llong EIOUring::send(int fd, EIOByteBuffer* src, ECompletionHandler* handler) { return 0; }
+llong EIOUring::recvMultishot(int fd, int group, ECompletionHandler* handler) { return 0; }
+llong EIOUring::accept(int fd, boolean multishot, ECompletionHandler* handler) { return 0; }
+llong EIOUring::pollAdd(int fd, int events, ECompletionHandler* handler) { return 0; }
+void EIOUring::updatePoll(llong id, int events) {}
+void EIOUring::cancel(llong id) {}
+void EIOUring::registerBuffers(EIOByteBuffer* buffers[], int n) {}
+void EIOUring::unregisterBuffers() {}
+void EIOUring::setupBufferRing(int group, int count, int size) {}
+void* EIOUring::getBuffer(int group, int bid) { return null; }
+void EIOUring::recycleBuffer(int group, int bid) {}
+int EIOUring::submit() { return 0; }
+int EIOUring::poll(llong timeout) { return 0; }
+void EIOUring::wakeup() {}
+boolean EIOUring::isWokenUp() { return false; }
+void EIOUring::close() {}
+boolean EIOUring::hasMore(int flags) { return false; }
+int EIOUring::getBufferId(int flags) { return -1; }
+EString EIOUring::toString() { return "EIOUring[]"; }
+
+#endif //!HAVE_IO_URING
+
+} /* namespace nio */
+} /* namespace efc */
@@ -0,0 +1,272 @@
+/*
+ * EIOUringSelectorImpl.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "es_config.h"
+
+#ifdef HAVE_IO_URING
+
+#include "./EIOUringSelectorImpl.hh"
+#include "./ESelectedKeySet.hh"
+#include "../inc/ESelectionKey.hh"
+#include "../inc/ESelectableChannel.hh"
+#include "../inc/EClosedSelectorException.hh"
+#include "../../inc/ESystem.hh"
+
+namespace efc {
+namespace nio {
+
+/*
+ * The poll of a registered channel.
+ */
+class EIOUringSelectorImpl::Registration: public ECompletionHandler {
+public:
+	EIOUringSelectorImpl* selector;
+	sp<ESelectionKey> key; // null once deregistered
+	int fd;
+	int interest;   // the events wanted
+	int events;     // the events of the poll in flight
+	int ready;      // the events reported since the last selection
+	llong id;       // the poll in flight
+	boolean pending;
+	boolean fired;
+
+	Registration(EIOUringSelectorImpl* selector, sp<ESelectionKey> key, int fd) :
+			selector(selector), key(key), fd(fd), interest(0), events(0),
+			ready(0), id(0), pending(false), fired(false) {
+	}
+
+	virtual void completed(int result, int flags) {
+		pending = false;
+		if (key != null) {
+			ready |= result;
+			if (!fired) {
+				fired = true;
+				selector->firedFds_.add(fd);
+			}
+		}
+	}
+
+	virtual void failed(EIOException* exc) {
+		// cancelled, or the descriptor is closed
+		pending = false;
+	}
+};
+
+EIOUringSelectorImpl::~EIOUringSelectorImpl() {
+	delete fdToReg_;
+	delete zombies_;
+	delete ring_;
+}
+
+EIOUringSelectorImpl::EIOUringSelectorImpl() : closed_(false),
+		interruptTriggered_(false) {
+	ring_ = new EIOUring();
+	fdToReg_ = new EHashMap<int, sp<Registration> >();
+	zombies_ = new EArrayList<sp<Registration> >();
+}
+
+ESelector* EIOUringSelectorImpl::wakeup() {
+	if (!interruptTriggered_.get() && interruptTriggered_.compareAndSet(false, true)) {
+		SYNCBLOCK (&interruptLock_) {
+			if (!closed_) {
+				ring_->wakeup();
+			}
+        }}
+	}
+	return this;
+}
+
+void EIOUringSelectorImpl::putEventOps(ESelectionKey* sk, int ops) {
+	if (closed_)
+		throw EClosedSelectorException(__FILE__, __LINE__);
+	SYNCBLOCK (&updateLock_) {
+		updateFds_.add(sk->channel()->getFDVal());
+		updateEvents_.add(ops);
+    }}
+}
+
+void EIOUringSelectorImpl::implRegister(sp<ESelectionKey> ski) {
+	if (closed_)
+		throw EClosedSelectorException(__FILE__, __LINE__);
+	sp<ESelectableChannel> ch = ski->channel();
+	int fd = ch->getFDVal();
+	fdToReg_->put(fd, new Registration(this, ski, fd));
+	keys_->add(ski);
+}
+
+void EIOUringSelectorImpl::implDereg(sp<ESelectionKey> ski) {
+	ES_ASSERT (ski->getIndex() >= 0);
+
+	sp<ESelectableChannel> ch = ski->channel();
+	int fd = ch->getFDVal();
+	sp<Registration> reg = fdToReg_->remove(fd);
+	if (reg != null) {
+		reg->key = null;
+		if (reg->pending) {
+			// kept alive until the cancelled poll completes
+			ring_->cancel(reg->id);
+			zombies_->add(reg);
+		}
+	}
+	ski->setIndex(-1);
+	keys_->remove(ski.get());
+	selectedKeys_->remove(ski.get());
+
+	/**
+	 * Must be locked, but not used SYNCHRONIZED(ch),
+	 * otherwise if channel is registered on two selector's,
+	 * access channel is dangerous.
+	 */
+	sp<ESelectableChannel> c = null;
+	SCOPED_SLOCK1(ch.get()) {
+		deregister(ski);
+		if (!ch->isOpen() && !ch->isRegistered()) {
+			ch->kill();
+			c = ch;
+		}
+    }}
+}
+
+void EIOUringSelectorImpl::implClose() {
+	if (closed_)
+		return;
+
+	closed_ = true;
+
+	// prevent further wakeup
+	interruptTriggered_.set(true);
+
+	// the polls in flight are dropped with the ring
+	SYNCBLOCK (&interruptLock_) {
+		ring_->close();
+    }}
+	zombies_->clear();
+
+	// it is possible
+	delete selectedKeys_;
+	selectedKeys_ = null;
+
+	// Deregister channels
+	sp<EIterator<sp<ESelectionKey> > > i = keys_->iterator();
+	while (i->hasNext()) {
+		sp<ESelectionKey> ski = i->next();
+
+		sp<ESelectableChannel> c = null;
+		sp<ESelectableChannel> selch = ski->channel();
+		SCOPED_SLOCK1(selch.get()) {
+			deregister(ski);
+			if (!selch->isOpen() && !selch->isRegistered()) {
+				selch->kill();
+				c = selch;
+			}
+        }}
+
+		i->remove();
+	}
+	fdToReg_->clear();
+}
+
+int EIOUringSelectorImpl::doSelect(llong timeout) {
+	if (closed_)
+		throw EClosedSelectorException(__FILE__, __LINE__);
+	processDeregisterQueue();
+
+	llong deadline = (timeout > 0) ? ESystem::currentTimeMillis() + timeout : 0;
+	int numKeysUpdated = 0;
+	for (;;) {
+		applyUpdates();
+		int n = 0;
+		try {
+			begin();
+			n = ring_->poll(timeout);
+		} catch (...) {
+			end();
+			throw;
+		}
+		end();
+		processDeregisterQueue();
+		numKeysUpdated = updateSelectedKeys();
+		if (ring_->isWokenUp()) {
+			interruptTriggered_.set(false);
+			break;
+		}
+		if (n > 0 || timeout == 0) {
+			break;
+		}
+		// only the results of the internal requests, waits again
+		if (timeout > 0) {
+			timeout = deadline - ESystem::currentTimeMillis();
+			if (timeout <= 0) {
+				break;
+			}
+		}
+	}
+
+	for (int i = zombies_->size() - 1; i >= 0; i--) {
+		if (!zombies_->getAt(i)->pending) {
+			zombies_->removeAt(i);
+		}
+	}
+	return numKeysUpdated;
+}
+
+void EIOUringSelectorImpl::applyUpdates() {
+	SYNCBLOCK (&updateLock_) {
+		for (int i = 0; i < updateFds_.size(); i++) {
+			sp<Registration> reg = fdToReg_->get(updateFds_.getAt(i));
+			if (reg == null) {
+				continue;
+			}
+			int mask = updateEvents_.getAt(i);
+			if (mask >= 0) {
+				reg->interest = mask;
+			}
+			if (!reg->pending) {
+				if (reg->interest != 0) {
+					reg->id = ring_->pollAdd(reg->fd, reg->interest, reg.get());
+					reg->events = reg->interest;
+					reg->pending = true;
+				}
+			} else if (reg->events != reg->interest) {
+				// changed in place, a poll of no events only reports errors
+				ring_->updatePoll(reg->id, reg->interest);
+				reg->events = reg->interest;
+			}
+		}
+		updateFds_.clear();
+		updateEvents_.clear();
+    }}
+}
+
+int EIOUringSelectorImpl::updateSelectedKeys() {
+	int numKeysUpdated = 0;
+	for (int i = 0; i < firedFds_.size(); i++) {
+		int fd = firedFds_.getAt(i);
+		sp<Registration> reg = fdToReg_->get(fd);
+		if (reg == null || !reg->fired) {
+			continue;
+		}
+		reg->fired = false;
+		int rOps = reg->ready;
+		reg->ready = 0;
+
+		// rearms the poll with the next selection
+		SYNCBLOCK (&updateLock_) {
+			updateFds_.add(fd);
+			updateEvents_.add(-1);
+        }}
+
+		numKeysUpdated += processReadyEvents(rOps, reg->key.get());
+	}
+	firedFds_.clear();
+	return numKeysUpdated;
+}
+
+} /* namespace nio */
+} /* namespace efc */
+
+#endif //!HAVE_IO_URING
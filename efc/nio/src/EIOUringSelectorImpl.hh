@@ -0,0 +1,100 @@
+/*
+ * EIOUringSelectorImpl.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "es_config.h"
+
+#ifdef HAVE_IO_URING
+
+#ifndef EIOURINGSELECTORIMPL_HH_
+#define EIOURINGSELECTORIMPL_HH_
+
+#include "../inc/ESelector.hh"
+#include "../inc/EIOUring.hh"
+#include "../../inc/EArrayList.hh"
+#include "../../inc/concurrent/EReentrantLock.hh"
+#include "../../inc/concurrent/EAtomicBoolean.hh"
+
+namespace efc {
+namespace nio {
+
+/**
+ * An implementation of Selector for Linux 5.11+ kernels that uses the
+ * io_uring interface.
+ *
+ * <p> Each registered channel has one one-shot poll request in flight for
+ * its interest set.  The requests rearming the polls which fired and the
+ * interest set changes are queued in the submission ring, and handed to the
+ * kernel in the same system call which waits for the next completions, so a
+ * select costs one system call however many registrations changed.
+ */
+
+class EIOUringSelectorImpl: public ESelector {
+public:
+	virtual ~EIOUringSelectorImpl();
+
+	/**
+	 * Package private constructor called by factory method in
+	 * the abstract superclass Selector.
+	 */
+	EIOUringSelectorImpl() THROWS(EIOException);
+
+	virtual ESelector* wakeup();
+	virtual void putEventOps(ESelectionKey* sk, int ops);
+
+protected:
+	// The ring
+	EIOUring* ring_;
+
+	virtual void implRegister(sp<ESelectionKey> ski);
+	virtual void implDereg(sp<ESelectionKey> ski) THROWS(EIOException);
+	virtual void implClose() THROWS(EIOException);
+	virtual int doSelect(llong timeout) THROWS(EIOException);
+
+private:
+	class Registration;
+
+	// Maps from file descriptors to registrations
+	EHashMap<int, sp<Registration> >* fdToReg_;
+
+	// Deregistered while their poll was in flight
+	EArrayList<sp<Registration> >* zombies_;
+
+	// Descriptors whose poll completed since the last selection
+	EArrayList<int> firedFds_;
+
+	// Pending interest changes, an event mask of -1 to rearm a fired poll
+	EReentrantLock updateLock_;
+	EArrayList<int> updateFds_;
+	EArrayList<int> updateEvents_;
+
+	// True if this Selector has been closed
+	volatile boolean closed_;// = false;
+
+	// Set by the wakeup which signals the ring, the wakeups which find
+	// it set have nothing to do
+	EAtomicBoolean interruptTriggered_;// = false;
+
+	// Lock for the ring signal against the ring closing
+	EReentrantLock interruptLock_;
+
+	/**
+	 * Queues the polls of the pending interest changes.
+	 */
+	void applyUpdates();
+
+	/**
+	 * Update the keys whose polls have completed.
+	 * Add the ready keys to the ready queue.
+	 */
+	int updateSelectedKeys();
+};
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* EIOURINGSELECTORIMPL_HH_ */
+
+#endif //!HAVE_IO_URING
@@ -11,6 +11,7 @@
 
 #include "./EKQueueSelectorImpl.hh"
 #include "./ENIOUtil.hh"
+#include "./ESelectedKeySet.hh"
 
 namespace efc {
 namespace nio {
@@ -169,26 +170,20 @@ int EKQueueSelectorImpl::updateSelectedKeys(int entries) {
 			// entry is null in the case of an interrupt
 			if (me != null) {
 				int rOps = kqueueWrapper_->getReventOps(i);
-				sp<ESelectionKey> ski = me->ski;
-				if (selectedKeys_->contains(ski.get())) {
-					// first time this file descriptor has been encountered on this
-					// update?
-					if (me->updateCount != updateCount_) {
-						if (ski->channel()->translateAndSetReadyOps(rOps, ski.get())) {
-							numKeysUpdated++;
-							me->updateCount = updateCount_;
-						}
-					} else {
-						// ready ops have already been set on this update
-						ski->channel()->translateAndUpdateReadyOps(rOps, ski.get());
-					}
-				} else {
-					ski->channel()->translateAndSetReadyOps(rOps, ski.get());
-					if ((ski->nioReadyOps() & ski->nioInterestOps()) != 0) {
-						selectedKeys_->add(ski);
+				ESelectionKey* ski = me->ski.get();
+				// first time this file descriptor has been encountered on this
+				// update?
+				if (me->updateCount != updateCount_) {
+					if (processReadyEvents(rOps, ski) > 0) {
 						numKeysUpdated++;
 						me->updateCount = updateCount_;
 					}
+				} else if (action_ != null) {
+					// the action is passed the ready ops of each filter
+					processReadyEvents(rOps, ski);
+				} else {
+					// ready ops have already been set on this update
+					ski->nioChannel()->translateAndUpdateReadyOps(rOps, ski);
 				}
 			}
 		}
@@ -8,11 +8,14 @@
 #include "./ENIOUtil.hh"
 #include "../../inc/EIOStatus.hh"
 #include "./ESocketDispatcher.hh"
+#include "../../inc/EIllegalArgumentException.hh"
 
 #ifdef WIN32
 #include <io.h> //read
 #else
 #include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #endif
 
 namespace efc {
@@ -99,6 +102,20 @@ int ENIOUtil::fdLimit() {
 		return (int)rlp.rlim_max;
 	}
 }
+
+int ENIOUtil::unixAddress(const char* path, struct sockaddr_un* sau) {
+	if (path == null || *path == 0) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Empty path");
+	}
+	int len = (int)strlen(path);
+	if (len >= (int)sizeof(sau->sun_path)) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Path too long");
+	}
+	memset(sau, 0, sizeof(struct sockaddr_un));
+	sau->sun_family = AF_UNIX;
+	memcpy(sau->sun_path, path, len);
+	return (int)(offsetof(struct sockaddr_un, sun_path) + len + 1);
+}
 #endif //!
 
 } /* namespace nio */
@@ -12,6 +12,10 @@
 #include "../inc/EIOByteBuffer.hh"
 #include "../../inc/EIOException.hh"
 
+#ifndef WIN32
+struct sockaddr_un;
+#endif
+
 namespace efc {
 namespace nio {
 
@@ -31,6 +35,11 @@ public:
 	//
 #else
 	static int fdLimit();
+
+	/*
+	 * Fills a Unix domain address with a path, and returns its length
+	 */
+	static int unixAddress(const char* path, struct sockaddr_un* sau);
 #endif
 };
 
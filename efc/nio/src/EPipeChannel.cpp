@@ -0,0 +1,305 @@
+/*
+ * EPipeChannel.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "../inc/EPipeChannel.hh"
+#include "../inc/EClosedChannelException.hh"
+#include "./ESocketDispatcher.hh"
+#include "./ENIOUtil.hh"
+#include "../../inc/EIOStatus.hh"
+#include "../../inc/ENullPointerException.hh"
+#include "../../inc/EIllegalArgumentException.hh"
+#include "../../inc/EIndexOutOfBoundsException.hh"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace efc {
+namespace nio {
+
+#ifdef __linux__
+#ifndef F_SETPIPE_SZ
+#define F_SETPIPE_SZ 1031
+#define F_GETPIPE_SZ 1032
+#endif
+
+/*
+ * Maps a failed splice, tee, read or write on a non-blocking descriptor.
+ */
+static long spliceStatus(const char* what) {
+	if (errno == EAGAIN) {
+		return EIOStatus::UNAVAILABLE;
+	}
+	if (errno == EINTR) {
+		return EIOStatus::INTERRUPTED;
+	}
+	throw EIOException(__FILE__, __LINE__, what, errno);
+}
+#else
+#define DEFAULT_PIPE_CAPACITY 65536
+#define BOUNCE_SIZE 16384
+#endif
+
+EPipeChannel::~EPipeChannel() {
+	try {
+		close();
+	} catch (...) {
+	}
+}
+
+EPipeChannel* EPipeChannel::open(int capacity) {
+	if (capacity < 0) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Negative capacity");
+	}
+	return new EPipeChannel(capacity);
+}
+
+EPipeChannel::EPipeChannel(int capacity) : available_(0), open_(true) {
+#ifdef __linux__
+	int fds[2];
+	// both ends non-blocking: the pipe never blocks a transfer
+	if (::pipe2(fds, O_NONBLOCK | O_CLOEXEC) < 0) {
+		throw EIOException(__FILE__, __LINE__, "pipe2 failed", errno);
+	}
+	source_ = fds[0];
+	sink_ = fds[1];
+	if (capacity > 0) {
+		// best effort, limited by /proc/sys/fs/pipe-max-size
+		::fcntl(sink_, F_SETPIPE_SZ, capacity);
+	}
+	capacity_ = ::fcntl(sink_, F_GETPIPE_SZ);
+	if (capacity_ <= 0) {
+		capacity_ = 65536;
+	}
+#else
+	capacity_ = (capacity > 0) ? capacity : DEFAULT_PIPE_CAPACITY;
+	buffer_.resize(capacity_);
+#endif
+}
+
+long EPipeChannel::tee(EPipeChannel* target, long count) {
+	if (target == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	if (target == this || count < 0) {
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+	}
+	ensureOpen();
+	target->ensureOpen();
+	long n = ES_MIN(count, (long)available_);
+	n = ES_MIN(n, (long)(target->capacity_ - target->available_));
+	if (n <= 0) {
+		return 0;
+	}
+#ifdef __linux__
+	for (;;) {
+		// the pages are shared, not copied
+		long r = ::tee(source_, target->sink_, n, SPLICE_F_NONBLOCK);
+		if (r < 0) {
+			r = spliceStatus("tee failed");
+			if (r == EIOStatus::INTERRUPTED) {
+				continue;
+			}
+			return 0;
+		}
+		target->available_ += r;
+		return r;
+	}
+#else
+	target->buffer_.append(buffer_.data(), (int)n);
+	target->available_ += (int)n;
+	return n;
+#endif
+}
+
+int EPipeChannel::available() {
+	return available_;
+}
+
+int EPipeChannel::capacity() {
+	return capacity_;
+}
+
+int EPipeChannel::read(EIOByteBuffer* dst) {
+	if (dst == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	ensureOpen();
+	int n = ES_MIN(dst->remaining(), available_);
+	if (n <= 0) {
+		return 0;
+	}
+#ifdef __linux__
+	for (;;) {
+		n = ::read(source_, dst->current(), n);
+		if (n < 0) {
+			if (spliceStatus("Read failed") == EIOStatus::INTERRUPTED) {
+				continue;
+			}
+			return 0;
+		}
+		break;
+	}
+#else
+	memcpy(dst->current(), buffer_.data(), n);
+	buffer_.erase(0, n);
+#endif
+	available_ -= n;
+	dst->position(dst->position() + n);
+	return n;
+}
+
+long EPipeChannel::read(EA<EIOByteBuffer*>* dsts) {
+	if (dsts == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	return read(dsts, 0, dsts->length());
+}
+
+long EPipeChannel::read(EA<EIOByteBuffer*>* dsts, int offset, int length) {
+	if (dsts == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	if ((offset < 0) || (length < 0) || (offset > dsts->length() - length)) {
+		throw EINDEXOUTOFBOUNDSEXCEPTION;
+	}
+	long total = 0;
+	for (int i = 0; i < length && available_ > 0; i++) {
+		total += read((*dsts)[offset + i]);
+	}
+	return total;
+}
+
+int EPipeChannel::write(EIOByteBuffer* src) {
+	if (src == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	ensureOpen();
+	int n = ES_MIN(src->remaining(), capacity_ - available_);
+	if (n <= 0) {
+		return 0;
+	}
+#ifdef __linux__
+	for (;;) {
+		n = ::write(sink_, src->current(), n);
+		if (n < 0) {
+			if (spliceStatus("Write failed") == EIOStatus::INTERRUPTED) {
+				continue;
+			}
+			return 0;
+		}
+		break;
+	}
+#else
+	buffer_.append(src->current(), n);
+#endif
+	available_ += n;
+	src->position(src->position() + n);
+	return n;
+}
+
+long EPipeChannel::write(EA<EIOByteBuffer*>* srcs) {
+	if (srcs == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	return write(srcs, 0, srcs->length());
+}
+
+long EPipeChannel::write(EA<EIOByteBuffer*>* srcs, int offset, int length) {
+	if (srcs == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	if ((offset < 0) || (length < 0) || (offset > srcs->length() - length)) {
+		throw EINDEXOUTOFBOUNDSEXCEPTION;
+	}
+	long total = 0;
+	for (int i = 0; i < length && available_ < capacity_; i++) {
+		total += write((*srcs)[offset + i]);
+	}
+	return total;
+}
+
+boolean EPipeChannel::isOpen() {
+	return open_;
+}
+
+void EPipeChannel::close() {
+	if (!open_) {
+		return;
+	}
+	open_ = false;
+	available_ = 0;
+#ifdef __linux__
+	::close(source_);
+	::close(sink_);
+#else
+	buffer_.clear();
+#endif
+}
+
+EString EPipeChannel::toString() {
+	return EString::formatOf("EPipeChannel[available=%d, capacity=%d%s]",
+			available_, capacity_, open_ ? "" : ", closed");
+}
+
+void EPipeChannel::ensureOpen() {
+	if (!open_) {
+		throw ECLOSEDCHANNELEXCEPTION;
+	}
+}
+
+long EPipeChannel::fill(int fd, long count) {
+	long n = ES_MIN(count, (long)(capacity_ - available_));
+	if (n <= 0) {
+		return 0;
+	}
+#ifdef __linux__
+	// the socket's own mode tells whether to wait for data
+	n = ::splice(fd, NULL, sink_, NULL, n, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	if (n < 0) {
+		return spliceStatus("splice failed");
+	}
+#else
+	char bounce[BOUNCE_SIZE];
+	n = ESocketDispatcher::read(fd, bounce, (int)ES_MIN(n, (long)BOUNCE_SIZE));
+	if (n == EIOStatus::EOF_) {
+		return 0;
+	}
+	if (n < 0) {
+		return n;
+	}
+	buffer_.append(bounce, (int)n);
+#endif
+	available_ += (int)n;
+	return n;
+}
+
+long EPipeChannel::drain(int fd, long count) {
+	long n = ES_MIN(count, (long)available_);
+	if (n <= 0) {
+		return 0;
+	}
+#ifdef __linux__
+	n = ::splice(source_, NULL, fd, NULL, n, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	if (n < 0) {
+		return spliceStatus("splice failed");
+	}
+#else
+	n = ESocketDispatcher::write(fd, buffer_.data(), (int)n);
+	if (n < 0) {
+		return n;
+	}
+	buffer_.erase(0, (int)n);
+#endif
+	available_ -= (int)n;
+	return n;
+}
+
+} /* namespace nio */
+} /* namespace efc */
@@ -11,6 +11,7 @@
 
 #include "./EPollSelectorImpl.hh"
 #include "./ENIOUtil.hh"
+#include "./ESelectedKeySet.hh"
 #include "../inc/EClosedSelectorException.hh"
 
 namespace efc {
@@ -192,19 +193,9 @@ int EPollSelectorImpl::updateSelectedKeys() {
 	for (int i=1; i<totalChannels_; i++) {
 		int rOps = pollWrapper_->getReventOps(i);
 		if (rOps != 0) {
-			sp<ESelectionKey> sk = (*channelArray_)[i];
+			ESelectionKey* sk = (*channelArray_)[i].get();
 			pollWrapper_->putReventOps(i, 0);
-			if (selectedKeys_->contains(sk.get())) {
-				if (sk->channel()->translateAndSetReadyOps(rOps, sk.get())) {
-					numKeysUpdated++;
-				}
-			} else {
-				sk->channel()->translateAndSetReadyOps(rOps, sk.get());
-				if ((sk->nioReadyOps() & sk->nioInterestOps()) != 0) {
-					selectedKeys_->add(sk);
-					numKeysUpdated++;
-				}
-			}
+			numKeysUpdated += processReadyEvents(rOps, sk);
 		}
 	}
 	return numKeysUpdated;
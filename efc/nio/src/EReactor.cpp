@@ -0,0 +1,466 @@
+/*
+ * EReactor.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "../inc/EReactor.hh"
+#include "../inc/EReactorGroup.hh"
+#include "../inc/ESelectionKey.hh"
+#include "../inc/EClosedChannelException.hh"
+#include "../../inc/ESocketOptions.hh"
+#include "../../inc/ENullPointerException.hh"
+#include "../../inc/EIllegalStateException.hh"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace efc {
+namespace nio {
+
+/*
+ * Dispatches the ready keys of a selection.
+ */
+class EReactor::Dispatcher: public ESelectionKeyConsumer {
+public:
+	Dispatcher(EReactor* reactor) : reactor(reactor) {
+	}
+
+	virtual void accept(ESelectionKey* key) {
+		EReactorConnection* conn = (EReactorConnection*)key->attachment();
+		if (conn == null) {
+			// the listening channel
+			reactor->acceptReady();
+			return;
+		}
+		int ops = key->nioReadyOps();
+		if ((ops & ESelectionKey::OP_READ) != 0) {
+			conn->readReady();
+		}
+		if ((ops & ESelectionKey::OP_WRITE) != 0 && conn->open_) {
+			conn->writeReady();
+		}
+	}
+
+private:
+	EReactor* reactor;
+};
+
+/*
+ * Binds a connection accepted by another loop.
+ */
+class EReactor::Adoption: public ERunnable {
+public:
+	Adoption(EReactor* reactor, sp<ESocketChannel> channel) :
+			reactor(reactor), channel(channel) {
+	}
+
+	virtual void run() {
+		reactor->bind(channel);
+	}
+
+	/*
+	 * The loop is closing: the connection is counted already, uncount
+	 * it and close the channel.
+	 */
+	void discard() {
+		reactor->connections_.decrementAndGet();
+		try {
+			channel->close();
+		} catch (EIOException& e) {
+		}
+	}
+
+private:
+	EReactor* reactor;
+	sp<ESocketChannel> channel;
+};
+
+//=============================================================================
+
+EReactorConnection::~EReactorConnection() {
+	delete handler_;
+}
+
+EReactorConnection::EReactorConnection(EReactor* reactor,
+		sp<ESocketChannel> channel, EConnectionHandler* handler) :
+		reactor_(reactor), channel_(channel), handler_(handler), key_(null),
+		open_(true), closing_(false) {
+}
+
+void EReactorConnection::write(const void* data, int len) {
+	if (!open_ || closing_) {
+		throw ECLOSEDCHANNELEXCEPTION;
+	}
+	if (len <= 0) {
+		return;
+	}
+
+	const char* p = (const char*)data;
+	if (out_.size() == 0) {
+		// straight to the socket, nothing is queued before
+		EIOByteBuffer b(p, len);
+		int n;
+		try {
+			n = channel_->write(&b);
+		} catch (EIOException& e) {
+			close();
+			return;
+		}
+		if (n >= len) {
+			return;
+		}
+		p += n;
+		len -= n;
+	}
+	boolean wasEmpty = (out_.size() == 0);
+	out_.append(p, len);
+	if (wasEmpty) {
+		key_->interestOps(ESelectionKey::OP_READ | ESelectionKey::OP_WRITE);
+	}
+}
+
+void EReactorConnection::close(boolean flush) {
+	if (!open_) {
+		return;
+	}
+	if (flush && out_.size() > 0) {
+		// closed once the pending bytes are written
+		closing_ = true;
+		key_->interestOps(ESelectionKey::OP_WRITE);
+		return;
+	}
+	open_ = false;
+	reactor_->connections_.decrementAndGet();
+	try {
+		channel_->close();
+	} catch (EIOException& e) {
+	}
+	try {
+		handler_->closed(this);
+	} catch (EException& e) {
+	}
+}
+
+boolean EReactorConnection::isOpen() {
+	return open_;
+}
+
+int EReactorConnection::pendingBytes() {
+	return out_.size();
+}
+
+ESocketChannel* EReactorConnection::channel() {
+	return channel_.get();
+}
+
+EReactor* EReactorConnection::reactor() {
+	return reactor_;
+}
+
+EConnectionHandler* EReactorConnection::handler() {
+	return handler_;
+}
+
+EString EReactorConnection::toString() {
+	return EString::formatOf("EReactorConnection[reactor=%d, channel=%s, pending=%d]",
+			reactor_->getIndex(), channel_->toString().c_str(), out_.size());
+}
+
+void EReactorConnection::readReady() {
+	EIOByteBuffer* buf = &reactor_->readBuffer_;
+	buf->clear();
+	int n;
+	try {
+		n = channel_->read(buf);
+	} catch (EIOException& e) {
+		n = -1;
+	}
+	if (n < 0) {
+		close();
+		return;
+	}
+	if (n == 0 || closing_) {
+		return;
+	}
+	buf->flip();
+	try {
+		handler_->received(this, buf);
+	} catch (EClosedChannelException& e) {
+		// closed by the handler
+	} catch (EException& e) {
+		close();
+	}
+}
+
+void EReactorConnection::writeReady() {
+	flush();
+}
+
+void EReactorConnection::flush() {
+	if (out_.size() == 0) {
+		return;
+	}
+	EIOByteBuffer b(out_.data(), out_.size());
+	int n;
+	try {
+		n = channel_->write(&b);
+	} catch (EIOException& e) {
+		closing_ = false;
+		close();
+		return;
+	}
+	out_.erase(0, n);
+	if (out_.size() == 0) {
+		if (closing_) {
+			closing_ = false;
+			close();
+		} else {
+			key_->interestOps(ESelectionKey::OP_READ);
+		}
+	}
+}
+
+//=============================================================================
+
+EReactor::~EReactor() {
+	if (selector_->isOpen()) {
+		// never started
+		closeAll();
+	}
+	delete selector_;
+	delete tasks_;
+	delete running_;
+}
+
+EReactor::EReactor(EReactorGroup* group, int index, int cpu) :
+		group_(group), index_(index), cpu_(cpu), readBuffer_(65536),
+		connections_(0), stopped_(false), hasTasks_(false), closed_(false) {
+	selector_ = ESelector::open();
+	tasks_ = new EArrayList<sp<ERunnable> >();
+	running_ = new EArrayList<sp<ERunnable> >();
+	setName(EString::formatOf("reactor-%d", index).c_str());
+}
+
+void EReactor::execute(sp<ERunnable> task) {
+	if (task == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	boolean closed = false;
+	SYNCBLOCK (&taskLock_) {
+		if (closed_) {
+			closed = true;
+		} else {
+			tasks_->add(task);
+			hasTasks_ = true;
+		}
+    }}
+	if (closed) {
+		discard(task);
+		return;
+	}
+	if (!inLoop()) {
+		// coalesced by the selector while a wakeup is pending
+		selector_->wakeup();
+	}
+}
+
+sp<ETimerWheel::Timeout> EReactor::schedule(sp<ERunnable> task, llong delayMillis) {
+	if (!inLoop()) {
+		throw EIllegalStateException(__FILE__, __LINE__, "Not in the event loop");
+	}
+	return timers_.schedule(task, delayMillis);
+}
+
+boolean EReactor::inLoop() {
+	return EThread::currentThread() == this;
+}
+
+int EReactor::connectionCount() {
+	return connections_.get();
+}
+
+int EReactor::getIndex() {
+	return index_;
+}
+
+EReactorGroup* EReactor::reactorGroup() {
+	return group_;
+}
+
+ESelector* EReactor::selector() {
+	return selector_;
+}
+
+ETimerWheel* EReactor::timers() {
+	return &timers_;
+}
+
+void EReactor::run() {
+#ifdef __linux__
+	if (cpu_ >= 0) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu_, &set);
+		// best effort, the loop runs unpinned if refused
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+	}
+#endif
+
+	Dispatcher dispatcher(this);
+	while (!stopped_) {
+		try {
+			llong delay = timers_.nextDelay();
+			if (hasTasks_ || delay == 0) {
+				selector_->selectNow(&dispatcher);
+			} else {
+				selector_->select(&dispatcher, (delay < 0) ? 0 : delay);
+			}
+			runTasks();
+			timers_.expire();
+		} catch (EClosedSelectorException& e) {
+			break;
+		} catch (EException& e) {
+			// a failed task or timeout does not stop the loop
+		}
+	}
+	closeAll();
+}
+
+EString EReactor::toString() {
+	return EString::formatOf("EReactor[index=%d, cpu=%d, connections=%d, timers=%d]",
+			index_, cpu_, connections_.get(), timers_.size());
+}
+
+void EReactor::listen(sp<EServerSocketChannel> listener) {
+	listener_ = listener;
+	listener_->configureBlocking(false);
+	listener_->register_(selector_, ESelectionKey::OP_ACCEPT);
+}
+
+void EReactor::acceptReady() {
+	// a batch at a time, the other keys are not starved by a storm
+	for (int i = 0; i < 64; i++) {
+		ESocketChannel* ch;
+		try {
+			ch = listener_->accept();
+		} catch (EIOException& e) {
+			break; // out of descriptors, say
+		}
+		if (ch == null) {
+			break;
+		}
+		sp<ESocketChannel> channel(ch);
+		EReactor* target = group_->balance(this);
+		target->connections_.incrementAndGet();
+		if (target == this) {
+			bind(channel);
+		} else {
+			target->execute(new Adoption(target, channel));
+		}
+	}
+}
+
+void EReactor::bind(sp<ESocketChannel> channel) {
+	EReactorConnection* conn = null;
+	try {
+		channel->configureBlocking(false);
+		int on = 1;
+		channel->setOption(ESocketOptions::_TCP_NODELAY, &on, sizeof(on));
+		conn = new EReactorConnection(this, channel, group_->factory_->newHandler());
+		sp<ESelectionKey> key = channel->register_(selector_, ESelectionKey::OP_READ, conn);
+		conn->key_ = key.get();
+	} catch (EException& e) {
+		// the key owns the connection once registered
+		delete conn;
+		connections_.decrementAndGet();
+		try {
+			channel->close();
+		} catch (EIOException& e) {
+		}
+		return;
+	}
+	try {
+		conn->handler_->opened(conn);
+	} catch (EException& e) {
+		conn->close();
+	}
+}
+
+void EReactor::runTasks() {
+	if (!hasTasks_) {
+		return;
+	}
+	SYNCBLOCK (&taskLock_) {
+		EArrayList<sp<ERunnable> >* t = tasks_;
+		tasks_ = running_;
+		running_ = t;
+		hasTasks_ = false;
+    }}
+	for (int i = 0; i < running_->size(); i++) {
+		sp<ERunnable> task = running_->getAt(i);
+		try {
+			task->run();
+		} catch (EException& e) {
+		}
+	}
+	running_->clear();
+}
+
+void EReactor::discard(sp<ERunnable> task) {
+	sp<Adoption> adoption = dynamic_pointer_cast<Adoption>(task);
+	if (adoption != null) {
+		adoption->discard();
+	}
+}
+
+void EReactor::closeAll() {
+	if (listener_ != null) {
+		try {
+			listener_->close();
+		} catch (EIOException& e) {
+		}
+	}
+
+	// registers the connections still queued
+	try {
+		selector_->selectNow();
+	} catch (EException& e) {
+	}
+
+	EArrayList<sp<ESelectionKey> > keys;
+	sp<EIterator<sp<ESelectionKey> > > iter = selector_->keys()->iterator();
+	while (iter->hasNext()) {
+		keys.add(iter->next());
+	}
+	for (int i = 0; i < keys.size(); i++) {
+		EReactorConnection* conn = (EReactorConnection*)keys.getAt(i)->attachment();
+		if (conn != null) {
+			conn->close();
+		}
+	}
+
+	// the queued hand-overs are dropped with their channels
+	SYNCBLOCK (&taskLock_) {
+		for (int i = 0; i < tasks_->size(); i++) {
+			discard(tasks_->getAt(i));
+		}
+		tasks_->clear();
+		hasTasks_ = false;
+		closed_ = true;
+    }}
+
+	// deregisters the keys, which delete their connections
+	selector_->close();
+}
+
+void EReactor::stop() {
+	stopped_ = true;
+	selector_->wakeup();
+}
+
+} /* namespace nio */
+} /* namespace efc */
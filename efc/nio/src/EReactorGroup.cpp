@@ -0,0 +1,167 @@
+/*
+ * EReactorGroup.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "../inc/EReactorGroup.hh"
+#include "../../inc/ERuntime.hh"
+#include "../../inc/EServerSocket.hh"
+#include "../../inc/ESocketOptions.hh"
+#include "../../inc/ESocketException.hh"
+#include "../../inc/ENullPointerException.hh"
+#include "../../inc/EIllegalStateException.hh"
+
+namespace efc {
+namespace nio {
+
+static int loopsOf(int nThreads) {
+	if (nThreads < 0) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Negative thread count");
+	}
+	return (nThreads > 0) ? nThreads : ERuntime::getRuntime()->availableProcessors();
+}
+
+EReactorGroup::~EReactorGroup() {
+	shutdown();
+}
+
+EReactorGroup::EReactorGroup(EConnectionHandlerFactory* factory, int nThreads,
+		boolean pinning) : factory_(factory), reactors_(loopsOf(nThreads)),
+		next_(0), balanceThreshold_(16), sharded_(false), localPort_(-1),
+		started_(false) {
+	if (factory == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	int cpus = ERuntime::getRuntime()->availableProcessors();
+	for (int i = 0; i < reactors_.length(); i++) {
+		reactors_[i] = new EReactor(this, i, pinning ? i % cpus : -1);
+	}
+}
+
+void EReactorGroup::bind(EInetSocketAddress* local, int backlog) {
+	if (local == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	if (started_ || localPort_ != -1) {
+		throw EIllegalStateException(__FILE__, __LINE__, "Already bound");
+	}
+
+	int port = local->getPort();
+	sharded_ = true;
+	for (int i = 0; i < reactors_.length(); i++) {
+		sp<EServerSocketChannel> ssc = EServerSocketChannel::open();
+		if (sharded_) {
+			try {
+				int on = 1;
+				ssc->setOption(ESocketOptions::_SO_REUSEPORT, &on, sizeof(on));
+			} catch (ESocketException& e) {
+				// the first loop accepts for all
+				sharded_ = false;
+			}
+		}
+		EInetSocketAddress isa(local->getAddress(), port);
+		ssc->bind(&isa, backlog);
+		if (port == 0) {
+			// the ephemeral port of the first channel is shared
+			port = ssc->socket()->getLocalPort();
+		}
+		reactors_[i]->listen(ssc);
+		if (!sharded_) {
+			break;
+		}
+	}
+	localPort_ = port;
+}
+
+void EReactorGroup::start() {
+	if (started_) {
+		throw EIllegalStateException(__FILE__, __LINE__, "Already started");
+	}
+	started_ = true;
+	for (int i = 0; i < reactors_.length(); i++) {
+		reactors_[i]->start();
+	}
+}
+
+void EReactorGroup::shutdown() {
+	if (!started_) {
+		return;
+	}
+	started_ = false;
+	for (int i = 0; i < reactors_.length(); i++) {
+		reactors_[i]->stop();
+	}
+	for (int i = 0; i < reactors_.length(); i++) {
+		reactors_[i]->join();
+	}
+}
+
+void EReactorGroup::setBalanceThreshold(int threshold) {
+	if (threshold < 0) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Negative threshold");
+	}
+	balanceThreshold_ = threshold;
+}
+
+boolean EReactorGroup::isSharded() {
+	return sharded_;
+}
+
+int EReactorGroup::getLocalPort() {
+	return localPort_;
+}
+
+int EReactorGroup::size() {
+	return reactors_.length();
+}
+
+EReactor* EReactorGroup::getReactor(int index) {
+	return reactors_[index];
+}
+
+EReactor* EReactorGroup::next() {
+	uint i = (uint)next_.getAndIncrement();
+	return reactors_[i % reactors_.length()];
+}
+
+EReactor* EReactorGroup::leastLoaded() {
+	EReactor* least = reactors_[0];
+	int min = least->connections_.get();
+	for (int i = 1; i < reactors_.length(); i++) {
+		int n = reactors_[i]->connections_.get();
+		if (n < min) {
+			min = n;
+			least = reactors_[i];
+		}
+	}
+	return least;
+}
+
+int EReactorGroup::connectionCount() {
+	int n = 0;
+	for (int i = 0; i < reactors_.length(); i++) {
+		n += reactors_[i]->connections_.get();
+	}
+	return n;
+}
+
+EString EReactorGroup::toString() {
+	return EString::formatOf("EReactorGroup[loops=%d, port=%d, sharded=%s, connections=%d]",
+			reactors_.length(), localPort_, sharded_ ? "true" : "false", connectionCount());
+}
+
+EReactor* EReactorGroup::balance(EReactor* acceptor) {
+	EReactor* least = leastLoaded();
+	if (!sharded_) {
+		return least;
+	}
+	if (acceptor->connections_.get() - least->connections_.get() > balanceThreshold_) {
+		return least;
+	}
+	return acceptor;
+}
+
+} /* namespace nio */
+} /* namespace efc */
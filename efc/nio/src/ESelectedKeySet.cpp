@@ -0,0 +1,144 @@
+/*
+ * ESelectedKeySet.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "./ESelectedKeySet.hh"
+#include "../../inc/ENoSuchElementException.hh"
+#include "../../inc/EIllegalStateException.hh"
+
+namespace efc {
+namespace nio {
+
+class ESelectedKeySet::KeyIterator: public EIterator<sp<ESelectionKey> > {
+public:
+	KeyIterator(ESelectedKeySet* set) : set(set), cursor(0), lastRet(-1) {
+	}
+
+	virtual boolean hasNext() {
+		while (cursor < set->end_ && set->keys_[cursor] == null) {
+			cursor++;
+		}
+		return cursor < set->end_;
+	}
+
+	virtual sp<ESelectionKey> next() {
+		if (!hasNext()) {
+			throw ENoSuchElementException(__FILE__, __LINE__);
+		}
+		lastRet = cursor++;
+		return set->keys_[lastRet]->shared_from_this();
+	}
+
+	virtual void remove() {
+		if (lastRet < 0 || lastRet >= set->end_ || set->keys_[lastRet] == null) {
+			throw EIllegalStateException(__FILE__, __LINE__);
+		}
+		set->removeAt(lastRet);
+		if (set->end_ == 0) {
+			cursor = 0; // emptied, the slots are reused
+		}
+		lastRet = -1;
+	}
+
+	virtual sp<ESelectionKey> moveOut() {
+		if (lastRet < 0 || lastRet >= set->end_ || set->keys_[lastRet] == null) {
+			throw EIllegalStateException(__FILE__, __LINE__);
+		}
+		sp<ESelectionKey> k = set->keys_[lastRet]->shared_from_this();
+		remove();
+		return k;
+	}
+
+private:
+	ESelectedKeySet* set;
+	int cursor;
+	int lastRet;
+};
+
+ESelectedKeySet::~ESelectedKeySet() {
+	clear();
+	eso_free(keys_);
+}
+
+ESelectedKeySet::ESelectedKeySet() : capacity_(64), end_(0), size_(0) {
+	keys_ = (ESelectionKey**)eso_calloc(capacity_ * sizeof(ESelectionKey*));
+}
+
+boolean ESelectedKeySet::add(sp<ESelectionKey> k) {
+	return addKey(k.get());
+}
+
+boolean ESelectedKeySet::contains(ESelectionKey* k) {
+	return k != null && holds(k);
+}
+
+boolean ESelectedKeySet::remove(ESelectionKey* k) {
+	if (k == null || !holds(k)) {
+		return false;
+	}
+	removeAt(k->selectedIndex_);
+	return true;
+}
+
+void ESelectedKeySet::clear() {
+	for (int i = 0; i < end_; i++) {
+		if (keys_[i] != null) {
+			keys_[i]->selectedIndex_ = -1;
+			keys_[i] = null;
+		}
+	}
+	end_ = size_ = 0;
+}
+
+int ESelectedKeySet::size() {
+	return size_;
+}
+
+boolean ESelectedKeySet::isEmpty() {
+	return size_ == 0;
+}
+
+sp<EIterator<sp<ESelectionKey> > > ESelectedKeySet::iterator(int index) {
+	return new KeyIterator(this);
+}
+
+void ESelectedKeySet::removeAt(int i) {
+	keys_[i]->selectedIndex_ = -1;
+	keys_[i] = null;
+	if (--size_ == 0) {
+		end_ = 0;
+	} else if (i == end_ - 1) {
+		end_--;
+	}
+}
+
+void ESelectedKeySet::makeRoom() {
+	if (size_ < end_) {
+		// squeezes the holes out first
+		int j = 0;
+		for (int i = 0; i < end_; i++) {
+			ESelectionKey* k = keys_[i];
+			if (k != null) {
+				k->selectedIndex_ = j;
+				keys_[j++] = k;
+			}
+		}
+		for (int i = j; i < end_; i++) {
+			keys_[i] = null;
+		}
+		end_ = j;
+		if (end_ < capacity_) {
+			return;
+		}
+	}
+	int newCapacity = capacity_ << 1;
+	keys_ = (ESelectionKey**)eso_realloc(keys_, newCapacity * sizeof(ESelectionKey*));
+	eso_memset(keys_ + capacity_, 0, (newCapacity - capacity_) * sizeof(ESelectionKey*));
+	capacity_ = newCapacity;
+}
+
+} /* namespace nio */
+} /* namespace efc */
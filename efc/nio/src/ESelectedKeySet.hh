@@ -0,0 +1,83 @@
+/*
+ * ESelectedKeySet.hh
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#ifndef ESELECTEDKEYSET_HH_
+#define ESELECTEDKEYSET_HH_
+
+#include "../inc/ESelectionKey.hh"
+#include "../../inc/EAbstractSet.hh"
+
+namespace efc {
+namespace nio {
+
+/**
+ * The selected-key set of a selector.
+ *
+ * <p> The keys are kept in a flat array, each key remembering its own slot,
+ * so that adding, finding and removing a key costs no hashing, no node
+ * allocation and no reference counting: the set holds plain pointers, the
+ * keys being owned by the key set of the selector, which deregisters a key
+ * from both sets at once.  Removing a key leaves a hole in the array, which
+ * is reused once the set is emptied, as a selector's caller usually does by
+ * removing every key it iterates over.
+ */
+
+class ESelectedKeySet: public EAbstractSet<sp<ESelectionKey> > {
+public:
+	virtual ~ESelectedKeySet();
+
+	ESelectedKeySet();
+
+	/**
+	 * Adds a key, the key is not retained.
+	 */
+	boolean addKey(ESelectionKey* k);
+
+	virtual boolean add(sp<ESelectionKey> k);
+	virtual boolean contains(ESelectionKey* k);
+	virtual boolean remove(ESelectionKey* k);
+	virtual void clear();
+	virtual int size();
+	virtual boolean isEmpty();
+	virtual sp<EIterator<sp<ESelectionKey> > > iterator(int index=0);
+
+private:
+	class KeyIterator;
+
+	ESelectionKey** keys_;
+	int capacity_;
+	int end_;   // the slots in use are below end_, holes included
+	int size_;
+
+	boolean holds(ESelectionKey* k);
+	void removeAt(int i);
+	void makeRoom();
+};
+
+//=============================================================================
+
+inline boolean ESelectedKeySet::holds(ESelectionKey* k) {
+	int i = k->selectedIndex_;
+	return (i >= 0 && i < end_ && keys_[i] == k);
+}
+
+inline boolean ESelectedKeySet::addKey(ESelectionKey* k) {
+	if (holds(k)) {
+		return false;
+	}
+	if (end_ == capacity_) {
+		makeRoom();
+	}
+	k->selectedIndex_ = end_;
+	keys_[end_++] = k;
+	size_++;
+	return true;
+}
+
+} /* namespace nio */
+} /* namespace efc */
+#endif /* ESELECTEDKEYSET_HH_ */
@@ -15,8 +15,9 @@ ESelectionKey::~ESelectionKey() {
 }
 
 ESelectionKey::ESelectionKey(sp<ESelectableChannel> ch, ESelector* sel) :
-		channel_(ch), selector_(sel), attachment_(null), valid_(true ), readyOps_(
-				0), index_(0) {
+		channel_(ch), selector_(sel), attachment_(null), valid_(true ), interestOps_(
+				0), readyOps_(0), index_(0), binded_(false), nextNew_(null),
+				selectedIndex_(-1) {
 }
 
 sp<ESelectableChannel> ESelectionKey::channel() {
@@ -104,8 +105,18 @@ int ESelectionKey::nioReadyOps() {
 }
 
 void ESelectionKey::nioInterestOps(int ops) {
-	if ((ops & ~this->channel()->validOps()) != 0)
+	if ((ops & ~channel_->validOps()) != 0)
 		throw EILLEGALARGUMENTEXCEPTION;
+	if (!binded_) {
+		// not yet registered by the selector, which applies the
+		// interest set when it does
+		SYNCHRONIZED (this) {
+			if (!binded_) {
+				interestOps_ = ops;
+				return;
+			}
+        }}
+	}
 	channel_->translateAndSetInterestOps(ops, this);
 	interestOps_ = ops;
 }
@@ -118,5 +129,9 @@ void ESelectionKey::invalidate() {
 	valid_ = false;
 }
 
+ESelectableChannel* ESelectionKey::nioChannel() {
+	return channel_.get();
+}
+
 } /* namespace nio */
 } /* namespace efc */
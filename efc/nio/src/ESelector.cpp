@@ -11,18 +11,32 @@
 #include "../../inc/concurrent/EReentrantLock.hh"
 #include "../../inc/EIterator.hh"
 #include "../../inc/ESocketException.hh"
+#include "../../inc/ESystem.hh"
 #include "./EPipeWrapper.hh"
 #include "./ENIOUtil.hh"
+#include "./ESelectedKeySet.hh"
 
 #include "./EEPollSelectorImpl.hh"
+#include "./EIOUringSelectorImpl.hh"
 #include "./EKQueueSelectorImpl.hh"
 #include "./EPollSelectorImpl.hh"
 
 namespace efc {
 namespace nio {
 
+// Ends the registration queue of a closed selector, never dereferenced
+static char closedSentinel;
+#define CLOSED_QUEUE ((ESelectionKey*)&closedSentinel)
+
 ESelector* ESelector::open() {
 #ifdef HAVE_EPOLL
+#ifdef HAVE_IO_URING
+	// opt-in: -Defc.nio.selector=io_uring
+	if (eso_strcmp(ESystem::getProperty("efc.nio.selector", ""), "io_uring") == 0
+			&& EIOUring::isAvailable()) {
+		return new EIOUringSelectorImpl();
+	}
+#endif
 	return new EEPollSelectorImpl();
 #elif defined(HAVE_KQUEUE)
 	return new EKQueueSelectorImpl();
@@ -49,6 +63,9 @@ void ESelector::close()
 	SYNCHRONIZED (this) {
 		SYNCBLOCK (keysLock_) {
 			SYNCBLOCK (selectedKeysLock_) {
+				// registers the queued keys so that they are deregistered
+				// with the others
+				processRegistrationQueue(newKeys_.getAndSet(CLOSED_QUEUE));
 				implClose();
             }}
         }}
@@ -61,11 +78,11 @@ ESet<sp<ESelectionKey> >* ESelector::cancelledKeys() {
 }
 
 ESelector::ESelector() : interruptor_(null),
-		selectorOpen_(true) {
+		selectorOpen_(true), action_(null) {
 	keys_ = new EHashSet<sp<ESelectionKey> >();
 	keysLock_ = new EReentrantLock();
 
-	selectedKeys_ = new EHashSet<sp<ESelectionKey> >();
+	selectedKeys_ = new ESelectedKeySet();
 	selectedKeysLock_ = new EReentrantLock();
 
 	cancelledKeys_ = new EHashSet<sp<ESelectionKey> >();
@@ -74,6 +91,8 @@ ESelector::ESelector() : interruptor_(null),
 
 ESelector::~ESelector()
 {
+	newKeys_.set(null); // not owned
+
 	delete cancelledKeys_;
 	delete cancelledKeysLock_;
 
@@ -111,37 +130,133 @@ ESet<sp<ESelectionKey> >* ESelector::selectedKeys() {
 int ESelector::select(llong timeout) {
 	if (timeout < 0)
 		throw EIllegalArgumentException(__FILE__, __LINE__, "Negative timeout");
-	return lockAndDoSelect((timeout == 0) ? -1 : timeout);
+	return lockAndDoSelect(null, (timeout == 0) ? -1 : timeout);
 }
 
 int ESelector::selectNow() THROWS(EIOException) {
-	return lockAndDoSelect(0);
+	return lockAndDoSelect(null, 0);
 }
 
-int ESelector::lockAndDoSelect(llong timeout) {
+int ESelector::select(ESelectionKeyConsumer* action, llong timeout) {
+	if (!action)
+		throw ENULLPOINTEREXCEPTION;
+	if (timeout < 0)
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Negative timeout");
+	return lockAndDoSelect(action, (timeout == 0) ? -1 : timeout);
+}
+
+int ESelector::selectNow(ESelectionKeyConsumer* action) THROWS(EIOException) {
+	if (!action)
+		throw ENULLPOINTEREXCEPTION;
+	return lockAndDoSelect(action, 0);
+}
+
+int ESelector::lockAndDoSelect(ESelectionKeyConsumer* action, llong timeout) {
 	SYNCHRONIZED (this) {
 		if (!isOpen())
 			throw ECLOSEDSELECTOREXCEPTION;
 		SYNCBLOCK (keysLock_) {
 			SYNCBLOCK (selectedKeysLock_) {
-				return doSelect(timeout);
+				if (newKeys_.get() != null) {
+					processRegistrationQueue(newKeys_.getAndSet(null));
+				}
+				action_ = action;
+				int n;
+				try {
+					n = doSelect(timeout);
+				} catch (...) {
+					action_ = null;
+					throw;
+				}
+				action_ = null;
+				return n;
             }}
         }}
     }}
 }
 
 sp<ESelectionKey> ESelector::register_(sp<ESelectableChannel> ch, int ops, EObject* att) {
-	//@see: openjdk-8/jdk/src/share/classes/sun/nio/ch/SelectorImpl.java register()
+	//@see: openjdk-11/src/java.base/share/classes/sun/nio/ch/SelectorImpl.java register()
 
+	if (!isOpen())
+		throw ECLOSEDSELECTOREXCEPTION;
 	sp<ESelectionKey> k = new ESelectionKey(ch, this);
 	delete k->attach(att);
-	SYNCBLOCK (keysLock_) {
-		implRegister(k);
-    }}
+
+	// the interest set is kept by the key until the selector registers it
 	k->interestOps(ops);
+
+	// queued without taking the selector's locks, the next selection
+	// operation registers the key, the key being held by its channel
+	for (;;) {
+		ESelectionKey* head = newKeys_.get();
+		if (head == CLOSED_QUEUE)
+			throw ECLOSEDSELECTOREXCEPTION;
+		k->nextNew_ = head;
+		if (newKeys_.compareAndSet(head, k.get()))
+			break;
+	}
 	return k;
 }
 
+void ESelector::processRegistrationQueue(ESelectionKey* head) {
+	// Precondition: Synchronized on this, keys, and selectedKeys
+	if (head == null || head == CLOSED_QUEUE) {
+		return;
+	}
+
+	// the stack is in reverse order of registration
+	ESelectionKey* prev = null;
+	while (head != null) {
+		ESelectionKey* next = head->nextNew_;
+		head->nextNew_ = prev;
+		prev = head;
+		head = next;
+	}
+
+	for (ESelectionKey* k = prev; k != null; ) {
+		ESelectionKey* next = k->nextNew_;
+		k->nextNew_ = null;
+		implRegister(k->shared_from_this());
+		SYNCHRONIZED (k) {
+			if (k->isValid()) {
+				k->nioChannel()->translateAndSetInterestOps(k->interestOps_, k);
+			}
+			k->binded_ = true;
+        }}
+		k = next;
+	}
+}
+
+int ESelector::processReadyEvents(int rOps, ESelectionKey* ski) {
+	if (action_ != null) {
+		if (!ski->isValid()) {
+			return 0; // cancelled by the action
+		}
+		ski->nioChannel()->translateAndSetReadyOps(rOps, ski);
+		if ((ski->nioReadyOps() & ski->nioInterestOps()) != 0) {
+			action_->accept(ski);
+			if (!isOpen())
+				throw ECLOSEDSELECTOREXCEPTION;
+			return 1;
+		}
+		return 0;
+	}
+
+	if (selectedKeys_->contains(ski)) {
+		if (ski->nioChannel()->translateAndSetReadyOps(rOps, ski)) {
+			return 1;
+		}
+	} else {
+		ski->nioChannel()->translateAndSetReadyOps(rOps, ski);
+		if ((ski->nioReadyOps() & ski->nioInterestOps()) != 0) {
+			selectedKeys_->addKey(ski);
+			return 1;
+		}
+	}
+	return 0;
+}
+
 void ESelector::processDeregisterQueue() {
     //@see: openjdk-8/jdk/src/share/classes/sun/nio/ch/SelectorImpl.java
     
@@ -10,6 +10,7 @@
 #include "./ESocketDispatcher.hh"
 #include "./ENativeThread.hh"
 #include "../../inc/EIOStatus.hh"
+#include "../../inc/EIllegalArgumentException.hh"
 #include "../../inc/ENetWrapper.hh"
 #include "../../inc/EServerSocket.hh"
 
@@ -139,6 +140,35 @@ ESocketChannel* EServerSocketChannel::accept() {
     }}
 }
 
+llong EServerSocketChannel::accept(EIOUring* ring, ECompletionHandler* handler, boolean multishot) {
+	if (ring == null || handler == null)
+		throw ENULLPOINTEREXCEPTION;
+	SYNCBLOCK(&_lock) {
+		if (!isOpen())
+			throw ECLOSEDCHANNELEXCEPTION;
+		if (!isBound())
+			throw ESocketException(__FILE__, __LINE__, "Socket is not bound yet");
+		return ring->accept(_fd, multishot, handler);
+    }}
+}
+
+ESocketChannel* EServerSocketChannel::accept(int fd) {
+	if (fd < 0)
+		throw EIllegalArgumentException(__FILE__, __LINE__, "Invalid descriptor");
+
+	union sockaddr_union sa;
+	socklen_t sa_len = sizeof(sa);
+	if (::getpeername(fd, (struct sockaddr *)&sa, &sa_len) < 0) {
+		int err = errno;
+		ENetWrapper::close(fd);
+		throw EIOException(__FILE__, __LINE__, err);
+	}
+
+	ENetWrapper::configureBlocking(fd, true);
+	EInetSocketAddress* isa = new EInetSocketAddress(sa.sin.sin_addr.s_addr, ntohs((u_short)sa.sin.sin_port));
+	return new ESocketChannel(fd, isa);
+}
+
 void EServerSocketChannel::implCloseSelectableChannel() {
 	SYNCBLOCK (&_stateLock) {
 		ESocketDispatcher::preClose(_fd);
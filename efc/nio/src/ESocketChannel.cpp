@@ -9,8 +9,28 @@
 #include "./ESocketAdaptor.hh"
 #include "./ENativeThread.hh"
 #include "./ESocketDispatcher.hh"
+#include "./ENIOUtil.hh"
 #include "../../inc/ENetWrapper.hh"
 #include "../../inc/ESocket.hh"
+#include "../../inc/EIllegalArgumentException.hh"
+#include "../../inc/EUnsupportedOperationException.hh"
+#include "../../inc/EArrayDeque.hh"
+#include "../../inc/EArrayList.hh"
+
+#ifdef __linux__
+#include <poll.h>
+#include <linux/errqueue.h>
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+#endif
 
 namespace efc {
 namespace nio {
@@ -29,17 +49,66 @@ namespace nio {
 #define ST_KILLPENDING     3
 #define ST_KILLED          4
 
+// The smallest write worth pinning, smaller ones are copied
+#define ZEROCOPY_MIN 16384
+
+/*
+ * The zero-copy sends of a channel, pinned until the kernel completes
+ * them, in the order of their ids.
+ */
+class ESocketChannel::ZeroCopyState {
+public:
+	class Send: public EObject {
+	public:
+		uint id;
+		sp<EIOByteBuffer> buffer;
+		int length;
+		ECompletionHandler* handler;
+		boolean done;
+		boolean copied;
+
+		Send(uint id, sp<EIOByteBuffer> buffer, int length,
+				ECompletionHandler* handler) :
+				id(id), buffer(buffer), length(length), handler(handler),
+				done(false), copied(false) {
+		}
+	};
+
+	boolean enabled;       // SO_ZEROCOPY is set
+	EReentrantLock lock;
+	EArrayDeque<sp<Send> > pending;
+	uint nextId;           // the kernel numbers the sends from 0
+	llong copied;
+
+	ZeroCopyState() : enabled(false), nextId(0), copied(0) {
+	}
+};
+
+#ifdef __linux__
+/*
+ * Tells whether a socket error is pending, besides the completions
+ * queued by zero-copy sends.
+ */
+static boolean pendingSocketError(int fd) {
+	struct pollfd pfd;
+	pfd.fd = fd;
+	pfd.events = 0;
+	pfd.revents = 0;
+	return (::poll(&pfd, 1, 0) > 0) && ((pfd.revents & POLLERR) != 0);
+}
+#endif
+
 ESocketChannel::ESocketChannel() :
 		_fd(-1), _socket(null), _localAddress(null), _remoteAddress(
 				null), _readerThread(0), _writerThread(0), _isInputOpen(true ), _isOutputOpen(
-				true ), _readyToConnect(false ), _state(ST_UNCONNECTED) {
+				true ), _readyToConnect(false ), _state(ST_UNCONNECTED), _transferPipe(null), _zeroCopy(null) {
     _fd = ENetWrapper::socket(PF_INET, SOCK_STREAM, 0);
 }
 
 ESocketChannel::ESocketChannel(const int fd, EInetSocketAddress* isa) :
 		_socket(null), _localAddress(null), _readerThread(
 				0), _writerThread(0), _isInputOpen(true ), _isOutputOpen(true ), _readyToConnect(
-				false ), _state(ST_CONNECTED) {
+				false ), _state(ST_CONNECTED), _transferPipe(null), _zeroCopy(null) {
 	_fd = fd;
 	_remoteAddress = new EInetSocketAddress(isa->getAddress(), isa->getPort());
 }
@@ -48,6 +117,8 @@ ESocketChannel::~ESocketChannel() {
 	delete _localAddress;
 	delete _remoteAddress;
 	delete _socket;
+	delete _transferPipe;
+	delete _zeroCopy;
 }
 
 ESocketChannel* ESocketChannel::open() {
@@ -793,6 +864,346 @@ void ESocketChannel::readerCleanup() {
     }}
 }
 
+llong ESocketChannel::read(EIOByteBuffer* dst, EIOUring* ring, ECompletionHandler* handler) {
+	if (dst == null || ring == null || handler == null)
+		throw ENULLPOINTEREXCEPTION;
+	if (!ensureReadOpen())
+		return -1;
+	return ring->recv(_fd, dst, handler);
+}
+
+llong ESocketChannel::write(EIOByteBuffer* src, EIOUring* ring, ECompletionHandler* handler) {
+	if (src == null || ring == null || handler == null)
+		throw ENULLPOINTEREXCEPTION;
+	ensureWriteOpen();
+	return ring->send(_fd, src, handler);
+}
+
+long ESocketChannel::transferTo(ESocketChannel* target) {
+	return transferTo(target, ES_LONG_MAX_VALUE);
+}
+
+long ESocketChannel::transferTo(ESocketChannel* target, long count) {
+	if (target == null)
+		throw ENULLPOINTEREXCEPTION;
+	if (target == this || count < 0)
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+
+	SYNCBLOCK (&_readLock) {
+		if (_transferPipe == null)
+			_transferPipe = EPipeChannel::open();
+		EPipeChannel* pipe = _transferPipe;
+		long total = 0;
+		for (;;) {
+			// the bytes left over by the last transfer go first
+			if (pipe->available() > 0) {
+				total += target->transferFrom(pipe, count - total);
+				if (pipe->available() > 0 || total >= count)
+					break; // the target is full
+			}
+			if (total > 0 && isBlocking())
+				break; // not to wait for more
+			long n = transferTo(pipe, count - total);
+			if (n < 0)
+				return (total > 0) ? total : -1;
+			if (n == 0)
+				break;
+		}
+		return total;
+    }}
+}
+
+int ESocketChannel::pendingTransfer() {
+	SYNCBLOCK (&_readLock) {
+		return (_transferPipe != null) ? _transferPipe->available() : 0;
+    }}
+}
+
+long ESocketChannel::transferTo(EPipeChannel* target, long count) {
+	if (target == null)
+		throw ENULLPOINTEREXCEPTION;
+	if (count < 0)
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+
+	SYNCBLOCK (&_readLock) {
+		if (!ensureReadOpen())
+			return -1;
+		target->ensureOpen();
+		if (count == 0 || target->available() == target->capacity())
+			return 0;
+		long n = 0;
+		long rv = -1;
+		try {
+			begin();
+			SYNCBLOCK (&_stateLock) {
+				if (!isOpen()) {
+					rv = 0;
+					goto FINALLY;
+				}
+				_readerThread = ENativeThread::current();
+            }}
+			for (;;) {
+				n = target->fill(_fd, count);
+				if ((n == EIOStatus::INTERRUPTED) && isOpen())
+					continue;
+				rv = (n == 0) ? EIOStatus::EOF_ : EIOStatus::normalize(n);
+				goto FINALLY;
+			}
+		} catch (...) {
+			finally {
+				readerCleanup();
+				end(n > 0 || (n == EIOStatus::UNAVAILABLE));
+				ES_ASSERT(EIOStatus::check(n));
+			}
+			throw; //!
+		}
+		FINALLY:
+		finally {
+			readerCleanup();
+			end(n > 0 || (n == EIOStatus::UNAVAILABLE));
+			SYNCBLOCK (&_stateLock) {
+				if ((n <= 0) && (!_isInputOpen))
+					return EIOStatus::EOF_;
+            }}
+			ES_ASSERT(EIOStatus::check(n));
+		}
+		return rv; //!
+    }}
+}
+
+long ESocketChannel::transferFrom(EPipeChannel* src, long count) {
+	if (src == null)
+		throw ENULLPOINTEREXCEPTION;
+	if (count < 0)
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+
+	SYNCBLOCK (&_writeLock) {
+		ensureWriteOpen();
+		src->ensureOpen();
+		if (count == 0 || src->available() == 0)
+			return 0;
+		long n = 0;
+		long rv = -1;
+		try {
+			begin();
+			SYNCBLOCK (&_stateLock) {
+				if (!isOpen()) {
+					rv = 0;
+					goto FINALLY;
+				}
+				_writerThread = ENativeThread::current();
+            }}
+			for (;;) {
+				n = src->drain(_fd, count);
+				if ((n == EIOStatus::INTERRUPTED) && isOpen())
+					continue;
+				rv = EIOStatus::normalize(n);
+				goto FINALLY;
+			}
+		} catch (...) {
+			finally {
+				writerCleanup();
+				end(n > 0 || (n == EIOStatus::UNAVAILABLE));
+				SYNCBLOCK (&_stateLock) {
+					if ((n <= 0) && (!_isOutputOpen))
+						throw EASYNCHRONOUSCLOSEEXCEPTION;
+                }}
+				ES_ASSERT(EIOStatus::check(n));
+			}
+			throw; //!
+		}
+		FINALLY:
+		finally {
+			writerCleanup();
+			end(n > 0 || (n == EIOStatus::UNAVAILABLE));
+			SYNCBLOCK (&_stateLock) {
+				if ((n <= 0) && (!_isOutputOpen))
+					throw EASYNCHRONOUSCLOSEEXCEPTION;
+            }}
+			ES_ASSERT(EIOStatus::check(n));
+		}
+		return rv; //!
+    }}
+}
+
+int ESocketChannel::writeZeroCopy(sp<EIOByteBuffer> src, ECompletionHandler* handler) {
+	if (src == null)
+		throw ENULLPOINTEREXCEPTION;
+
+	SYNCBLOCK (&_writeLock) {
+		ensureWriteOpen();
+		ZeroCopyState* zc = zeroCopyState();
+		if (!zc->enabled || src->remaining() < ZEROCOPY_MIN) {
+			int r = write(src.get());
+			if (r > 0 && handler != null)
+				handler->completed(r, ZEROCOPY_COPIED);
+			return r;
+		}
+#ifdef __linux__
+		int n = 0;
+		int rv = -1;
+		try {
+			begin();
+			SYNCBLOCK (&_stateLock) {
+				if (!isOpen()) {
+					rv = 0;
+					goto FINALLY;
+				}
+				_writerThread = ENativeThread::current();
+            }}
+			for (;;) {
+				n = ::send(_fd, src->current(), src->remaining(), MSG_ZEROCOPY | MSG_NOSIGNAL);
+				if (n < 0 && errno == ENOBUFS) {
+					// out of the memory to track the send, copied then
+					n = ESocketDispatcher::write(_fd, src.get());
+					if (n > 0 && handler != null)
+						handler->completed(n, ZEROCOPY_COPIED);
+					if ((n == EIOStatus::INTERRUPTED) && isOpen())
+						continue;
+					rv = EIOStatus::normalize(n);
+					goto FINALLY;
+				}
+				n = (int)ENIOUtil::convertReturnVal(n, false);
+				if ((n == EIOStatus::INTERRUPTED) && isOpen())
+					continue;
+				if (n > 0) {
+					src->position(src->position() + n);
+					SYNCBLOCK (&zc->lock) {
+						zc->pending.addLast(new ZeroCopyState::Send(zc->nextId++, src, n, handler));
+                    }}
+				}
+				rv = EIOStatus::normalize(n);
+				goto FINALLY;
+			}
+		} catch (...) {
+			finally {
+				writerCleanup();
+				end(n > 0 || (n == EIOStatus::UNAVAILABLE));
+				SYNCBLOCK (&_stateLock) {
+					if ((n <= 0) && (!_isOutputOpen))
+						throw EASYNCHRONOUSCLOSEEXCEPTION;
+                }}
+				ES_ASSERT(EIOStatus::check(n));
+			}
+			throw; //!
+		}
+		FINALLY:
+		finally {
+			writerCleanup();
+			end(n > 0 || (n == EIOStatus::UNAVAILABLE));
+			SYNCBLOCK (&_stateLock) {
+				if ((n <= 0) && (!_isOutputOpen))
+					throw EASYNCHRONOUSCLOSEEXCEPTION;
+            }}
+			ES_ASSERT(EIOStatus::check(n));
+		}
+		return rv; //!
+#else
+		// SO_ZEROCOPY is never enabled here, sends are copied above
+		throw EUnsupportedOperationException(__FILE__, __LINE__);
+#endif
+    }}
+}
+
+int ESocketChannel::reapZeroCopy() {
+	ZeroCopyState* zc = _zeroCopy;
+	if (zc == null || !zc->enabled)
+		return 0;
+#ifdef __linux__
+	EArrayList<sp<ZeroCopyState::Send> > completed;
+	SYNCBLOCK (&zc->lock) {
+		if (zc->pending.isEmpty())
+			return 0;
+		for (;;) {
+			char control[128];
+			struct msghdr msg;
+			memset(&msg, 0, sizeof(msg));
+			msg.msg_control = control;
+			msg.msg_controllen = sizeof(control);
+			if (::recvmsg(_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+				if (errno == EINTR)
+					continue;
+				if (errno == EAGAIN)
+					break;
+				throw EIOException(__FILE__, __LINE__, "recvmsg(MSG_ERRQUEUE) failed", errno);
+			}
+			for (struct cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm != NULL; cm = CMSG_NXTHDR(&msg, cm)) {
+				if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR)
+						|| (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)))
+					continue;
+				struct sock_extended_err* ee = (struct sock_extended_err*)CMSG_DATA(cm);
+				if (ee->ee_errno != 0 || ee->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+					continue;
+				// the sends ee_info to ee_data, mostly in order
+				uint lo = ee->ee_info;
+				uint range = ee->ee_data - lo;
+				boolean copied = (ee->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+				sp<EIterator<sp<ZeroCopyState::Send> > > iter = zc->pending.iterator();
+				while (iter->hasNext()) {
+					sp<ZeroCopyState::Send> s = iter->next();
+					if (s->id - lo <= range) {
+						s->done = true;
+						s->copied = copied;
+					}
+				}
+			}
+		}
+		// completed in the order of the sends
+		while (!zc->pending.isEmpty() && zc->pending.peekFirst()->done) {
+			sp<ZeroCopyState::Send> s = zc->pending.pollFirst();
+			if (s->copied)
+				zc->copied++;
+			completed.add(s);
+		}
+    }}
+	for (int i = 0; i < completed.size(); i++) {
+		sp<ZeroCopyState::Send> s = completed.getAt(i);
+		if (s->handler != null) {
+			try {
+				s->handler->completed(s->length, s->copied ? ZEROCOPY_COPIED : 0);
+			} catch (EException& e) {
+			}
+		}
+	}
+	return completed.size();
+#else
+	return 0;
+#endif
+}
+
+int ESocketChannel::zeroCopyPending() {
+	ZeroCopyState* zc = _zeroCopy;
+	if (zc == null)
+		return 0;
+	SYNCBLOCK (&zc->lock) {
+		return zc->pending.size();
+    }}
+}
+
+llong ESocketChannel::zeroCopyCopied() {
+	ZeroCopyState* zc = _zeroCopy;
+	if (zc == null)
+		return 0;
+	SYNCBLOCK (&zc->lock) {
+		return zc->copied;
+    }}
+}
+
+ESocketChannel::ZeroCopyState* ESocketChannel::zeroCopyState() {
+	SYNCBLOCK (&_stateLock) {
+		if (_zeroCopy == null) {
+			ZeroCopyState* zc = new ZeroCopyState();
+#ifdef __linux__
+			int on = 1;
+			// unsupported before Linux 4.14, the sends are copied then
+			zc->enabled = (::setsockopt(_fd, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on)) == 0);
+#endif
+			_zeroCopy = zc;
+		}
+		return _zeroCopy;
+    }}
+}
+
 EInetSocketAddress* ESocketChannel::localAddress() {
 	SYNCBLOCK (&_stateLock) {
 		if (_state == ST_CONNECTED
@@ -879,6 +1290,24 @@ boolean ESocketChannel::translateReadyOps(int ops, int initialOps,
 		return false ;
 	}
 
+#ifdef __linux__
+	if ((ops & ENetWrapper::POLLERR_) != 0 && (ops & ENetWrapper::POLLHUP_) == 0
+			&& _zeroCopy != null) {
+		// the completions of zero-copy sends are queued as errors
+		int reaped = 0;
+		try {
+			reaped = reapZeroCopy();
+		} catch (EIOException& e) {
+		}
+		if (!pendingSocketError(_fd)) {
+			ops &= ~ENetWrapper::POLLERR_;
+			if ((reaped > 0) && ((intOps & ESelectionKey::OP_WRITE) != 0)
+					&& (_state == ST_CONNECTED))
+				newOps |= ESelectionKey::OP_WRITE;
+		}
+	}
+#endif
+
 	if ((ops & (ENetWrapper::POLLERR_ | ENetWrapper::POLLHUP_)) != 0) {
 		newOps = intOps;
 		sk->nioReadyOps(newOps);
@@ -181,7 +181,7 @@ int ESocketDispatcher::read(int fd, EA<EIOByteBuffer*>* dsts, int offset, int le
 	if ((offset < 0) || (length < 0) || (offset > dsts->length() - length))
 		throw EINDEXOUTOFBOUNDSEXCEPTION;
 
-	struct iovec *iovBase = (struct iovec *)eso_calloc(sizeof(struct iovec));
+	struct iovec *iovBase = (struct iovec *)eso_calloc(sizeof(struct iovec) * length);
 	struct iovec *iov = iovBase;
 	long bytesRead = 0;
 	try {
@@ -200,7 +200,18 @@ int ESocketDispatcher::read(int fd, EA<EIOByteBuffer*>* dsts, int offset, int le
 	} finally {
 		eso_free(iovBase);
 	}
-	return bytesRead;
+
+	long returnVal = bytesRead;
+	// Notify the buffers how many bytes were put
+	for (int i=0; i<length && bytesRead > 0; i++) {
+		EIOByteBuffer* nextBuffer = (*dsts)[i + offset];
+		int pos = nextBuffer->position();
+		int rem = nextBuffer->remaining();
+		int n = (int)ES_MIN(bytesRead, (long)rem);
+		nextBuffer->position(pos + n);
+		bytesRead -= n;
+	}
+	return returnVal;
 }
 
 int ESocketDispatcher::write(int fd, EIOByteBuffer* bb) {
@@ -244,7 +255,7 @@ int ESocketDispatcher::write(int fd, EA<EIOByteBuffer*>* srcs, int offset, int l
 	long returnVal = bytesWritten;
 	// Notify the buffers how many bytes were taken
 	for (int i=0; i<length; i++) {
-		EIOByteBuffer* nextBuffer = (*srcs)[i];
+		EIOByteBuffer* nextBuffer = (*srcs)[i + offset];
 		int pos = nextBuffer->position();
 		int lim = nextBuffer->limit();
 		ES_ASSERT(pos <= lim);
@@ -0,0 +1,179 @@
+/*
+ * ETimerWheel.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "../inc/ETimerWheel.hh"
+#include "../../inc/ESystem.hh"
+#include "../../inc/ELLong.hh"
+#include "../../inc/ENullPointerException.hh"
+#include "../../inc/EIllegalArgumentException.hh"
+
+namespace efc {
+namespace nio {
+
+ETimerWheel::Timeout::Timeout(sp<ERunnable> task, llong tick) :
+		task(task), tick(tick), state(0) {
+}
+
+boolean ETimerWheel::Timeout::cancel() {
+	if (state != 0) {
+		return false;
+	}
+	state = 2;
+	task = null;
+	return true;
+}
+
+boolean ETimerWheel::Timeout::isCancelled() {
+	return state == 2;
+}
+
+boolean ETimerWheel::Timeout::isExpired() {
+	return state == 1;
+}
+
+//=============================================================================
+
+ETimerWheel::~ETimerWheel() {
+	for (int i = 0; i <= mask_; i++) {
+		delete buckets_[i];
+	}
+	delete[] buckets_;
+}
+
+ETimerWheel::ETimerWheel(llong tickMillis, int ticksPerWheel) :
+		tickMillis_(tickMillis), currentTick_(0),
+		nextTick_(ELLong::MAX_VALUE), size_(0) {
+	if (tickMillis <= 0 || ticksPerWheel <= 0 || ticksPerWheel > (1 << 20)) {
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+	}
+	int n = 1;
+	while (n < ticksPerWheel) {
+		n <<= 1;
+	}
+	mask_ = n - 1;
+	buckets_ = new EArrayList<sp<Timeout> >*[n];
+	for (int i = 0; i < n; i++) {
+		buckets_[i] = new EArrayList<sp<Timeout> >(4);
+	}
+	startMillis_ = now();
+}
+
+sp<ETimerWheel::Timeout> ETimerWheel::schedule(sp<ERunnable> task, llong delayMillis) {
+	if (task == null) {
+		throw ENULLPOINTEREXCEPTION;
+	}
+	if (delayMillis < 0) {
+		delayMillis = 0;
+	}
+
+	// rounded up, a task never runs early
+	llong tick = (now() + delayMillis - startMillis_ + tickMillis_ - 1) / tickMillis_;
+	if (tick <= currentTick_) {
+		tick = currentTick_ + 1;
+	}
+	sp<Timeout> t = new Timeout(task, tick);
+	buckets_[tick & mask_]->add(t);
+	size_++;
+	if (tick < nextTick_) {
+		nextTick_ = tick;
+	}
+	return t;
+}
+
+int ETimerWheel::expire() {
+	llong target = tickOf(now());
+	if (target <= currentTick_) {
+		return 0;
+	}
+	if (size_ == 0 || target < nextTick_) {
+		currentTick_ = target;
+		return 0;
+	}
+
+	// each bucket is visited once however long the caller slept
+	int n = 0;
+	llong last = ES_MIN(target, currentTick_ + mask_ + 1);
+	for (llong tick = currentTick_ + 1; tick <= last; tick++) {
+		EArrayList<sp<Timeout> >* bucket = buckets_[tick & mask_];
+		for (int i = 0; i < bucket->size(); ) {
+			Timeout* t = bucket->getAt(i).get();
+			if (t->state == 2) {
+				bucket->removeAt(i);
+				size_--;
+			} else if (t->tick <= target) {
+				sp<Timeout> due = bucket->removeAt(i);
+				size_--;
+				due->state = 1;
+				sp<ERunnable> task = due->task;
+				due->task = null;
+				n++;
+				task->run();
+			} else {
+				i++;
+			}
+		}
+	}
+	currentTick_ = target;
+	updateNextTick();
+	return n;
+}
+
+llong ETimerWheel::nextDelay() {
+	if (size_ == 0 || nextTick_ == ELLong::MAX_VALUE) {
+		return -1;
+	}
+	llong delay = startMillis_ + nextTick_ * tickMillis_ - now();
+	return (delay > 0) ? delay : 0;
+}
+
+int ETimerWheel::size() {
+	return size_;
+}
+
+EString ETimerWheel::toString() {
+	return EString::formatOf("ETimerWheel[tick=%lldms, ticks=%d, pending=%d]",
+			tickMillis_, mask_ + 1, size_);
+}
+
+llong ETimerWheel::now() {
+	return ESystem::nanoTime() / 1000000;
+}
+
+llong ETimerWheel::tickOf(llong millis) {
+	return (millis - startMillis_) / tickMillis_;
+}
+
+void ETimerWheel::updateNextTick() {
+	if (size_ == 0) {
+		nextTick_ = ELLong::MAX_VALUE;
+		return;
+	}
+	if (nextTick_ > currentTick_) {
+		return;
+	}
+	// only when the earliest deadline passed, not per expiry; drops the
+	// cancelled tasks on the way
+	nextTick_ = ELLong::MAX_VALUE;
+	for (int i = 0; i <= mask_; i++) {
+		EArrayList<sp<Timeout> >* bucket = buckets_[i];
+		for (int j = 0; j < bucket->size(); ) {
+			Timeout* t = bucket->getAt(j).get();
+			if (t->state == 2) {
+				bucket->removeAt(j);
+				size_--;
+				continue;
+			}
+			if (t->tick < nextTick_) {
+				nextTick_ = t->tick;
+			}
+			j++;
+		}
+	}
+}
+
+} /* namespace nio */
+} /* namespace efc */
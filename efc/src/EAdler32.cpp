@@ -7,8 +7,6 @@
 
 #include "EAdler32.hh"
 
-#include "../libc/src/zlib/zlib.h"
-
 namespace efc {
 
 EAdler32::~EAdler32() {
@@ -19,11 +17,11 @@ EAdler32::EAdler32() {
 }
 
 void EAdler32::update(byte b) {
-	adler = adler32(adler, (Bytef*)&b, 1);
+	adler = eso_adler32_update((es_uint32_t)adler, (es_byte_t*)&b, 1);
 }
 
 void EAdler32::update(byte* b, int len) {
-	adler = adler32(adler, (Bytef*)b, len);
+	adler = eso_adler32_update((es_uint32_t)adler, (es_byte_t*)b, len);
 }
 
 llong EAdler32::getValue() {
@@ -567,14 +567,7 @@ int EBigDecimal::scale() {
 }
 
 EBigInteger EBigDecimal::toBigInteger() {
-	EBigInteger r(this->intVal);
-
-	EVector<int>& number = *r.getNumber();
-	for (int i = 0; i < decimalDigits; i++) {
-		number.removeAt(0);
-	}
-
-	return r;
+	return intVal.pow10(-decimalDigits);
 }
 
 int EBigDecimal::hashCode() {
@@ -17,37 +17,480 @@
 
 namespace efc {
 
-//@see: http://blueve.me/archives/215
+//@see: openjdk/jdk/src/share/classes/java/math/BigInteger.java
+//@see: Henry S. Warren, Hacker's Delight, divmnu64.c
 
-#define RADIX 10
+typedef es_uint32_t word_t;
+typedef es_uint64_t dword_t;
+
+/*
+ * Thresholds in words: schoolbook multiplication below Karatsuba, Toom-3
+ * when both factors are above it, and the radix conversions split the
+ * number in halves above theirs.
+ */
+#define KARATSUBA_THRESHOLD       40
+#define TOOM3_THRESHOLD          200
+#define TOSTRING_THRESHOLD        20
+#define PARSE_THRESHOLD          400 //digits
+
+//=============================================================================
+// magnitude arithmetic on little endian word arrays
+
+static int numberOfLeadingZeros(word_t w) {
+	int n = 0;
+	if (w == 0) return 32;
+	if (w <= 0x0000FFFF) { n += 16; w <<= 16; }
+	if (w <= 0x00FFFFFF) { n += 8; w <<= 8; }
+	if (w <= 0x0FFFFFFF) { n += 4; w <<= 4; }
+	if (w <= 0x3FFFFFFF) { n += 2; w <<= 2; }
+	if (w <= 0x7FFFFFFF) { n += 1; }
+	return n;
+}
+
+static int trimLength(const word_t* a, int n) {
+	while (n > 0 && a[n - 1] == 0) n--;
+	return n;
+}
+
+static int compareMag(const word_t* a, int an, const word_t* b, int bn) {
+	if (an != bn) return (an < bn) ? -1 : 1;
+	for (int i = an - 1; i >= 0; i--) {
+		if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
+	}
+	return 0;
+}
+
+/* r[0..an) = a + b, an >= bn, returns the carry; r may be a */
+static word_t addMag(word_t* r, const word_t* a, int an, const word_t* b, int bn) {
+	dword_t c = 0;
+	int i = 0;
+	for (; i < bn; i++) {
+		c += (dword_t)a[i] + b[i];
+		r[i] = (word_t)c;
+		c >>= 32;
+	}
+	for (; i < an; i++) {
+		c += a[i];
+		r[i] = (word_t)c;
+		c >>= 32;
+	}
+	return (word_t)c;
+}
+
+/* r[0..an) = a - b, a >= b, returns the borrow; r may be a */
+static word_t subMag(word_t* r, const word_t* a, int an, const word_t* b, int bn) {
+	dword_t borrow = 0;
+	int i = 0;
+	for (; i < bn; i++) {
+		dword_t d = (dword_t)a[i] - b[i] - borrow;
+		r[i] = (word_t)d;
+		borrow = d >> 63;
+	}
+	for (; i < an; i++) {
+		dword_t d = (dword_t)a[i] - borrow;
+		r[i] = (word_t)d;
+		borrow = d >> 63;
+	}
+	return (word_t)borrow;
+}
+
+/* a[0..n) = a * m + c, returns the carry out */
+static word_t mulAddWord(word_t* a, int n, word_t m, word_t c) {
+	dword_t carry = c;
+	for (int i = 0; i < n; i++) {
+		carry += (dword_t)a[i] * m;
+		a[i] = (word_t)carry;
+		carry >>= 32;
+	}
+	return (word_t)carry;
+}
+
+/* q[0..n) = a / d, returns the remainder; q may be a */
+static word_t divWord(word_t* q, const word_t* a, int n, word_t d) {
+	dword_t rem = 0;
+	for (int i = n - 1; i >= 0; i--) {
+		dword_t cur = (rem << 32) | a[i];
+		q[i] = (word_t)(cur / d);
+		rem = cur % d;
+	}
+	return (word_t)rem;
+}
+
+static void sqrBasecase(word_t* r, const word_t* a, int n) {
+	// the cross products once, doubled, plus the squares
+	eso_memset(r, 0, 2 * n * sizeof(word_t));
+	for (int i = 0; i < n; i++) {
+		dword_t c = 0;
+		word_t ai = a[i];
+		for (int j = i + 1; j < n; j++) {
+			c += (dword_t)ai * a[j] + r[i + j];
+			r[i + j] = (word_t)c;
+			c >>= 32;
+		}
+		r[i + n] = (word_t)c;
+	}
+	word_t top = 0;
+	for (int k = 0; k < 2 * n; k++) {
+		word_t w = r[k];
+		r[k] = (w << 1) | top;
+		top = w >> 31;
+	}
+	dword_t c = 0;
+	for (int i = 0; i < n; i++) {
+		dword_t sq = (dword_t)a[i] * a[i];
+		c += (dword_t)r[2 * i] + (word_t)sq;
+		r[2 * i] = (word_t)c;
+		c >>= 32;
+		c += (dword_t)r[2 * i + 1] + (sq >> 32);
+		r[2 * i + 1] = (word_t)c;
+		c >>= 32;
+	}
+}
+
+/* r[0..an+bn) = a * b, r must not overlap a or b */
+static void mulBasecase(word_t* r, const word_t* a, int an, const word_t* b, int bn) {
+	if (a == b && an == bn) {
+		sqrBasecase(r, a, an);
+		return;
+	}
+	dword_t c = 0;
+	word_t b0 = b[0];
+	for (int i = 0; i < an; i++) {
+		c += (dword_t)a[i] * b0;
+		r[i] = (word_t)c;
+		c >>= 32;
+	}
+	r[an] = (word_t)c;
+	for (int j = 1; j < bn; j++) {
+		c = 0;
+		word_t bj = b[j];
+		for (int i = 0; i < an; i++) {
+			c += (dword_t)a[i] * bj + r[i + j];
+			r[i + j] = (word_t)c;
+			c >>= 32;
+		}
+		r[an + j] = (word_t)c;
+	}
+}
+
+static void mulMag(word_t* r, const word_t* a, int an, const word_t* b, int bn);
+
+/*
+ * Karatsuba: a = a1*B^h + a0, b = b1*B^h + b0,
+ * a*b = a1b1*B^2h + ((a0+a1)(b0+b1) - a0b0 - a1b1)*B^h + a0b0.
+ * an >= bn > h, the top words are not zero.
+ */
+static void mulKaratsuba(word_t* r, const word_t* a, int an, const word_t* b, int bn) {
+	boolean square = (a == b && an == bn);
+	int h = (an + 1) / 2;
+	int rn = an + bn;
+
+	word_t* buf = (word_t*)eso_malloc((4 * h + 4) * sizeof(word_t));
+	word_t* sa = buf;
+	word_t* sb = buf + h + 1;
+	word_t* z1 = buf + 2 * h + 2;
+
+	// z0 = a0*b0 at r[0..2h), z2 = a1*b1 at r[2h..rn)
+	eso_memset(r, 0, rn * sizeof(word_t));
+	int a0n = trimLength(a, h);
+	int b0n = square ? a0n : trimLength(b, h);
+	if (a0n > 0 && b0n > 0) {
+		mulMag(r, a, a0n, square ? a : b, b0n);
+	}
+	mulMag(r + 2 * h, a + h, an - h, square ? a + h : b + h, bn - h);
+
+	sa[h] = addMag(sa, a, h, a + h, an - h);
+	int san = trimLength(sa, h + 1);
+	int sbn = san;
+	if (!square) {
+		sb[h] = addMag(sb, b, h, b + h, bn - h);
+		sbn = trimLength(sb, h + 1);
+	}
+	eso_memset(z1, 0, (2 * h + 2) * sizeof(word_t));
+	mulMag(z1, sa, san, square ? sa : sb, sbn);
+
+	subMag(z1, z1, 2 * h + 2, r, 2 * h);
+	subMag(z1, z1, 2 * h + 2, r + 2 * h, rn - 2 * h);
+	int z1n = trimLength(z1, 2 * h + 2);
+	addMag(r + h, r + h, rn - h, z1, z1n);
+
+	eso_free(buf);
+}
+
+static void mulMag(word_t* r, const word_t* a, int an, const word_t* b, int bn) {
+	if (an < bn) {
+		const word_t* t = a; a = b; b = t;
+		int n = an; an = bn; bn = n;
+	}
+	if (bn == 0) {
+		eso_memset(r, 0, an * sizeof(word_t));
+		return;
+	}
+	if (bn < KARATSUBA_THRESHOLD) {
+		mulBasecase(r, a, an, b, bn);
+		return;
+	}
+	if (bn <= (an + 1) / 2) {
+		// unbalanced, multiply b by bn-word slices of a
+		int rn = an + bn;
+		word_t* t = (word_t*)eso_malloc(2 * bn * sizeof(word_t));
+		eso_memset(r, 0, rn * sizeof(word_t));
+		for (int i = 0; i < an; i += bn) {
+			int n = trimLength(a + i, ES_MIN(bn, an - i));
+			if (n > 0) {
+				mulMag(t, a + i, n, b, bn);
+				addMag(r + i, r + i, rn - i, t, n + bn);
+			}
+		}
+		eso_free(t);
+		return;
+	}
+	mulKaratsuba(r, a, an, b, bn);
+}
+
+/*
+ * Knuth's algorithm D: q[0..an-bn] = a / b, r[0..bn) = a % b,
+ * an >= bn >= 2 and b[bn-1] != 0; q or r may be null.
+ */
+static void divKnuth(word_t* q, word_t* r, const word_t* a, int an, const word_t* b, int bn) {
+	const dword_t B = LLONG(0x100000000);
+	int s = numberOfLeadingZeros(b[bn - 1]);
+	word_t* vn = (word_t*)eso_malloc((bn + an + 1) * sizeof(word_t));
+	word_t* un = vn + bn;
+
+	// normalize so that the top bit of the divisor is set
+	for (int i = bn - 1; i > 0; i--) {
+		vn[i] = (b[i] << s) | (s ? (b[i - 1] >> (32 - s)) : 0);
+	}
+	vn[0] = b[0] << s;
+	un[an] = s ? (a[an - 1] >> (32 - s)) : 0;
+	for (int i = an - 1; i > 0; i--) {
+		un[i] = (a[i] << s) | (s ? (a[i - 1] >> (32 - s)) : 0);
+	}
+	un[0] = a[0] << s;
+
+	for (int j = an - bn; j >= 0; j--) {
+		dword_t num = ((dword_t)un[j + bn] << 32) | un[j + bn - 1];
+		dword_t qhat = num / vn[bn - 1];
+		dword_t rhat = num - qhat * vn[bn - 1];
+		while (qhat >= B || qhat * vn[bn - 2] > ((rhat << 32) | un[j + bn - 2])) {
+			qhat--;
+			rhat += vn[bn - 1];
+			if (rhat >= B) break;
+		}
+
+		// multiply and subtract
+		es_int64_t k = 0, t;
+		for (int i = 0; i < bn; i++) {
+			dword_t p = qhat * vn[i];
+			t = (es_int64_t)un[i + j] - k - (es_int64_t)(p & 0xFFFFFFFF);
+			un[i + j] = (word_t)t;
+			k = (es_int64_t)(p >> 32) - (t >> 32);
+		}
+		t = (es_int64_t)un[j + bn] - k;
+		un[j + bn] = (word_t)t;
+
+		if (t < 0) {
+			// add back
+			qhat--;
+			dword_t c = 0;
+			for (int i = 0; i < bn; i++) {
+				c += (dword_t)un[i + j] + vn[i];
+				un[i + j] = (word_t)c;
+				c >>= 32;
+			}
+			un[j + bn] += (word_t)c;
+		}
+		if (q) q[j] = (word_t)qhat;
+	}
+
+	if (r) {
+		for (int i = 0; i < bn - 1; i++) {
+			r[i] = (un[i] >> s) | (s ? (un[i + 1] << (32 - s)) : 0);
+		}
+		r[bn - 1] = un[bn - 1] >> s;
+	}
+	eso_free(vn);
+}
+
+/* -m^-1 mod 2^32 for odd m */
+static word_t montgomeryInverse(word_t m) {
+	word_t x = m; // correct to 3 bits, each step doubles
+	for (int i = 0; i < 4; i++) {
+		x *= 2 - m * x;
+	}
+	return (word_t)(0 - x);
+}
+
+/*
+ * Montgomery reduction of t[0..2n] (t < m*R) to t*R^-1 mod m in r[0..n).
+ */
+static void montgomeryReduce(word_t* r, word_t* t, const word_t* m, int n, word_t inv) {
+	for (int i = 0; i < n; i++) {
+		word_t u = t[i] * inv;
+		dword_t c = 0;
+		for (int j = 0; j < n; j++) {
+			c += (dword_t)u * m[j] + t[i + j];
+			t[i + j] = (word_t)c;
+			c >>= 32;
+		}
+		for (int k = i + n; c != 0; k++) {
+			c += t[k];
+			t[k] = (word_t)c;
+			c >>= 32;
+		}
+	}
+	// t[n..2n] < 2m
+	if (t[2 * n] != 0 || compareMag(t + n, n, m, n) >= 0) {
+		subMag(t + n, t + n, n, m, n);
+	}
+	eso_memcpy(r, t + n, n * sizeof(word_t));
+}
+
+/* r = a * b * R^-1 mod m, t has 2n+1 words */
+static void montgomeryMultiply(word_t* r, const word_t* a, const word_t* b,
+		const word_t* m, int n, word_t inv, word_t* t) {
+	int an = trimLength(a, n);
+	int bn = (a == b) ? an : trimLength(b, n);
+	eso_memset(t, 0, (2 * n + 1) * sizeof(word_t));
+	if (an > 0 && bn > 0) {
+		mulMag(t, a, an, b, bn);
+	}
+	montgomeryReduce(r, t, m, n, inv);
+}
+
+static int windowBits(int ebits) {
+	static const int thresholds[] = { 7, 25, 81, 241, 673, 1793 };
+	int w = 1;
+	while (w <= 6 && ebits > thresholds[w - 1]) {
+		w++;
+	}
+	return w;
+}
+
+static const char radixDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/* digits of the radix fitting a word, and radix^digits */
+static int digitsPerWord(int radix, word_t* chunk) {
+	dword_t p = radix;
+	int d = 1;
+	while (p * radix <= 0xFFFFFFFF) {
+		p *= radix;
+		d++;
+	}
+	if (chunk) *chunk = (word_t)p;
+	return d;
+}
+
+//=============================================================================
+
+/**
+ * radix^(2^i) of a conversion, computed on first use.
+ */
+class EBigInteger::RadixPowers {
+public:
+	RadixPowers(int radix) : radix(radix) {
+		eso_memset(powers, 0, sizeof(powers));
+	}
+	~RadixPowers() {
+		for (int i = 0; i < 32; i++) {
+			delete powers[i];
+		}
+	}
+	EBigInteger& get(int i) {
+		if (!powers[i]) {
+			if (i == 0) {
+				powers[i] = new EBigInteger(radix);
+			} else {
+				EBigInteger& p = get(i - 1);
+				powers[i] = new EBigInteger();
+				multiplyTo(*powers[i], p, p);
+			}
+		}
+		return *powers[i];
+	}
+private:
+	int radix;
+	EBigInteger* powers[32];
+};
+
+//=============================================================================
 
 EBigInteger::~EBigInteger() {
+	eso_free(mag);
+	delete num;
 }
 
-EBigInteger::EBigInteger(const char* s) {
-	num.setThreadSafe(false);
+EBigInteger::EBigInteger(const char* s) :
+		sign(false), mag(null), len(0), cap(0), num(null) {
 	*this = s;
 }
 
-EBigInteger::EBigInteger(llong v) {
-	num.setThreadSafe(false);
+EBigInteger::EBigInteger(const char* s, int radix) :
+		sign(false), mag(null), len(0), cap(0), num(null) {
+	parse(s, radix);
+}
+
+EBigInteger::EBigInteger(llong v) :
+		sign(false), mag(null), len(0), cap(0), num(null) {
 	*this = v;
 }
 
-EBigInteger::EBigInteger(const EBigInteger& that) {
+EBigInteger::EBigInteger(const EBigInteger& that) :
+		sign(false), mag(null), len(0), cap(0), num(null) {
 	*this = that;
 }
 
+es_uint32_t* EBigInteger::alloc(int n) {
+	if (n > cap) {
+		int ncap = ES_MAX(n, 4);
+		mag = (word_t*)eso_realloc(mag, ncap * sizeof(word_t));
+		cap = ncap;
+	}
+	return mag;
+}
+
+void EBigInteger::normalize() {
+	len = trimLength(mag, len);
+	if (len == 0) {
+		sign = false;
+	}
+}
+
+int EBigInteger::compareMagnitude(const EBigInteger& b) const {
+	return compareMag(mag, len, b.mag, b.len);
+}
+
+EBigInteger EBigInteger::slice(int from, int to) const {
+	EBigInteger r;
+	to = ES_MIN(to, len);
+	if (to > from) {
+		eso_memcpy(r.alloc(to - from), mag + from, (to - from) * sizeof(word_t));
+		r.len = to - from;
+		r.normalize();
+	}
+	return r;
+}
+
 boolean EBigInteger::getSign() {
 	return sign;
 }
 
 void EBigInteger::setSign(boolean negative) {
-	sign = negative;
+	sign = negative && (len > 0);
 }
 
 EVector<int>* EBigInteger::getNumber() {
-	return &num;
+	if (!num) {
+		num = new EStack<int>();
+		num->setThreadSafe(false);
+	}
+	num->clear();
+	EString s = abs().toString(10);
+	for (int i = s.length() - 1; i >= 0; --i) {
+		num->push(s[i] - '0');
+	}
+	return num;
 }
 
 EBigInteger EBigInteger::add(llong val) {
@@ -91,82 +534,42 @@ EBigInteger EBigInteger::remainder(EBigInteger& b) {
 }
 
 EBigInteger EBigInteger::mod(llong val) {
-	EBigInteger b = this->operator %(val);
-	b.setSign(false);
-	return b;
+	EBigInteger b(val);
+	return mod(b);
 }
 
 EBigInteger EBigInteger::mod(EBigInteger& b) {
-	EBigInteger m = this->operator %(b);
-	m.setSign(false);
+	EBigInteger m;
+	divideTo(*this, b, null, &m);
+	if (m.sign) {
+		addTo(m, m, b, false);
+	}
 	return m;
 }
 
 EBigInteger EBigInteger::abs() {
 	EBigInteger r(*this);
-	if (r.sign) {
-		r.sign = false;
-	}
+	r.sign = false;
 	return r;
 }
 
-void EBigInteger::ltrimZero(EStack<int>& num) {
-	//Clear leading zeros
-	for (int i = num.size() - 1; num[i] == 0 && i > 0; --i) {
-		num.pop();
-	}
+int EBigInteger::signum() {
+	return (len == 0) ? 0 : (sign ? -1 : 1);
 }
 
 EBigInteger& EBigInteger::operator =(const llong v) {
-	//Empty the original number
-	num.clear();
-	//Get digital symbols
-	int tmp = v;
-	if (v < 0) {
-		sign = true;
-		tmp = -tmp;
-	} else {
-		sign = false;
-	}
-	//In reverse order high precision integer storage
-	//Storing digital bits
-	while (tmp >= RADIX) {
-		num.push(tmp % RADIX);
-		tmp /= RADIX;
-	}
-	if (tmp != 0)
-		num.push(tmp);
-	else if (num.isEmpty())
-		num.push(0);
-
+	es_uint64_t x = (v < 0) ? (es_uint64_t)0 - (es_uint64_t)v : (es_uint64_t)v;
+	word_t* p = alloc(2);
+	p[0] = (word_t)x;
+	p[1] = (word_t)(x >> 32);
+	len = 2;
+	sign = (v < 0);
+	normalize();
 	return *this;
 }
-EBigInteger& EBigInteger::operator =(const char* s) {
-	//Empty the original number
-	num.clear();
-
-	if (!s || !*s) {
-		return *this;
-	}
 
-	EString sn(s);
-	sn.trim();
-
-	//In reverse order high precision integer storage
-	for (int i = sn.length() - 1; i > 0; --i) {
-		num.push(sn[i] - '0');
-	}
-	//Determine numeric symbols
-	if (sn[0] == '-') {
-		sign = true;
-	} else if (sn[0] == '+') {
-		sign = false;
-	} else {
-		sign = false;
-		num.push(sn[0] - '0');
-	}
-	//Clear leading zeros
-	ltrimZero (num);
+EBigInteger& EBigInteger::operator =(const char* s) {
+	parse(s, 10);
 	return *this;
 }
 
@@ -174,17 +577,54 @@ EBigInteger& EBigInteger::operator =(const EBigInteger& b) {
 	if (this == &b)
 		return *this;
 
-	EBigInteger* bi = (EBigInteger*) (&b);
-	num.clear();
-	//In reverse order high precision integer storage
-	for (int i = 0; i < bi->num.size(); ++i) {
-		num.push(bi->num[i]);
+	if (b.len > 0) {
+		eso_memcpy(alloc(b.len), b.mag, b.len * sizeof(word_t));
 	}
-	//Symbol transfer
-	sign = bi->sign;
+	len = b.len;
+	sign = b.sign;
 	return *this;
 }
 
+void EBigInteger::addTo(EBigInteger& r, const EBigInteger& a,
+		const EBigInteger& b, boolean bsign) {
+	if (b.len == 0) {
+		r = a;
+		return;
+	}
+	if (a.len == 0) {
+		r = b;
+		r.sign = bsign;
+		return;
+	}
+
+	if (a.sign == bsign) {
+		const EBigInteger *x = &a, *y = &b;
+		if (x->len < y->len) {
+			x = &b;
+			y = &a;
+		}
+		int n = x->len;
+		word_t* p = r.alloc(n + 1); // x or y may be r
+		p[n] = addMag(p, x->mag, n, y->mag, y->len);
+		r.len = n + 1;
+		r.sign = bsign;
+	} else {
+		int c = a.compareMagnitude(b);
+		if (c == 0) {
+			r = 0LL;
+			return;
+		}
+		const EBigInteger *x = (c > 0) ? &a : &b, *y = (c > 0) ? &b : &a;
+		boolean s = (c > 0) ? a.sign : bsign;
+		int n = x->len;
+		word_t* p = r.alloc(n);
+		subMag(p, x->mag, n, y->mag, y->len);
+		r.len = n;
+		r.sign = s;
+	}
+	r.normalize();
+}
+
 EBigInteger EBigInteger::operator +(llong v) {
 	EBigInteger b(v);
 	return this->operator +(b);
@@ -192,38 +632,7 @@ EBigInteger EBigInteger::operator +(llong v) {
 
 EBigInteger EBigInteger::operator +(EBigInteger& b) {
 	EBigInteger r;
-	if (b.sign == this->sign) {
-		//Adding the same number
-		r.sign = b.sign;
-	} else if (this->sign) {
-		//Left negative, Right positive
-		this->sign = false;
-		r = b - *this;
-		return r;
-	} else if (b.sign) {
-		//Left positive, Right negative
-		b.sign = false;
-		r = *this - b;
-		return r;
-	}
-
-	//Gets the length of the two digits added
-	int lenA = num.size();
-	int lenB = b.num.size();
-	int lng = ES_MAX(lenA, lenB);
-	//Bit by bit addition
-	for (int i = 0; i < lng; ++i) {
-		int tmp = r.num.peek(); //Gets the existing number of the current bit
-		//The sum of
-		if (i < lenA)
-			tmp += num[i];
-		if (i < lenB)
-			tmp += b.num[i];
-		r.num[r.num.size() - 1] = tmp % RADIX; //store
-		r.num.push(tmp / RADIX); //carry
-	}
-	//Clear leading zeros
-	ltrimZero(r.num);
+	addTo(r, *this, b, b.sign);
 	return r;
 }
 
@@ -233,153 +642,128 @@ EBigInteger EBigInteger::operator -(llong v) {
 }
 
 EBigInteger EBigInteger::operator -(EBigInteger& b) {
-	EBigInteger r, t1(*this), t2(b);
-	EBigInteger *big = &t1, *lit = &t2;
-	//Gets the length of the two digits added
-	int lenA = num.size();
-	int lenB = b.num.size();
-	int lng, shrt;
-	shrt = ES_MIN(lenA, lenB);
-	lng = ES_MAX(lenA, lenB);
-	//Same number subtraction
-	if (b.sign == this->sign) {
-		if (!b.sign) {
-			//Same as positive number
-			if (t1 < t2) {
-				//exchange
-				big = &t2;
-				lit = &t1;
-				r.sign = true;
-			} else {
-				r.sign = false;
-			}
-		} else {
-			//Same as negative number
-			if (t1 >= t2) {
-				//exchange
-				big = &t2;
-				lit = &t1;
-				r.sign = false;
-			} else {
-				r.sign = true;
-			}
-		}
-
-	} else {
-		//Left is negative & Right is positive || Left is positive & Right is negative
-		t2.setSign(!t2.getSign());
-		return t1 + t2;
-	}
-	//Bit by bit subtraction
-	for (int i = 0; i < lng; ++i) {
-		if (i < shrt) {
-			//subtract
-			if (big->num[i] < lit->num[i]) {
-				//Borrow
-				for (int j = i + 1;; j++) {
-					if (big->num[j] > 0) {
-						big->num[j] -= 1;
-						break;
-					} else {
-						big->num[j] = 9;
-					}
-				}
-				r.num[i] = big->num[i] + RADIX - lit->num[i]; //sub
-			} else {
-				r.num[i] = big->num[i] - lit->num[i]; //sub
-			}
-		} else {
-			r.num[i] = big->num[i];
-		}
-		r.num.push(0);
-	}
-	//Clear leading zeros
-	ltrimZero(r.num);
+	EBigInteger r;
+	addTo(r, *this, b, !b.sign && b.len > 0);
 	return r;
 }
 
 EBigInteger EBigInteger::pow10(int n) {
-	EBigInteger r(*this);
-
+	EBigInteger r;
+	EBigInteger ten(10);
 	if (n > 0) {
-		for (int i=0; i<n; i++) {
-			r.num.insertElementAt(0, 0);
-		}
+		EBigInteger p = ten.pow(n);
+		multiplyTo(r, *this, p);
 	} else if (n < 0) {
-		n = ES_MIN(-n, r.num.size());
-		for (int i=0; i<n; i++) {
-			r.num.removeAt(0);
-		}
+		EBigInteger p = ten.pow(-n);
+		divideTo(*this, p, &r, null);
+	} else {
+		r = *this;
 	}
 	return r;
 }
 
 EBigInteger EBigInteger::operator -() {
 	EBigInteger r(*this);
-	if (r != 0)
-		r.sign = !r.sign;
-
+	r.sign = !r.sign && (r.len > 0);
 	return r;
 }
 
 EBigInteger EBigInteger::operator *(llong v) {
-	if (v == 0) {
-		return EBigInteger(0LL);
-	} else if (v == 1) {
-		return *this;
-	} else if (v == -1) {
-		return -*this;
-	} else if (v % RADIX == 0) {
-		EBigInteger b(*this);
-		llong x = v < 0 ? -v : v;
-		for (x /= RADIX; x > 0; x /= RADIX) {
-			b.num.insertElementAt(0, 0);
-		}
-		if ((v < 0) && (b != 0LL)) {
-			b.sign = !b.sign;
-		}
-		return b;
-	} else {
-		EBigInteger b(v);
-		return this->operator *(b);
-	}
+	EBigInteger b(v);
+	return this->operator *(b);
 }
 
 EBigInteger EBigInteger::operator *(EBigInteger& b) {
 	EBigInteger r;
-	//Gets the length of the two digits multiplied
-	int lenA = num.size();
-	int lenB = b.num.size();
-	int len = 0;
-	//Bit by bit multiplication
-	for (int i = 0; i < lenA; ++i) {
-		for (int j = 0; j < lenB; ++j) {
-			if (r.num.size() - 1 < i + j) {
-				++len;
-				r.num.push(num[i] * b.num[j]); //Add one
-			} else {
-				r.num[i + j] += num[i] * b.num[j];
-			}
-		}
+	multiplyTo(r, *this, b);
+	return r;
+}
 
+void EBigInteger::multiplyTo(EBigInteger& r, const EBigInteger& a,
+		const EBigInteger& b) {
+	if (a.len == 0 || b.len == 0) {
+		r = 0LL;
+		return;
 	}
-
-	//carry
-	++len;
-	for (int i = 0; i < len; ++i) {
-		if (i + 1 < r.num.size()) {
-			r.num[i + 1] += r.num[i] / RADIX;
-		} else if (r.num[i] >= RADIX) {
-			r.num.push(r.num[i] / RADIX);
-			++len;
-		} else
-			break;
-		r.num[i] %= RADIX;
+	if (a.len >= TOOM3_THRESHOLD && b.len >= TOOM3_THRESHOLD) {
+		r = multiplyToomCook3(a, b);
+		return;
 	}
-	//positive when same sign &  negative when difference sign
-	r.sign = sign ^ b.sign;
-	//Clear leading zeros
-	ltrimZero(r.num);
+	int n = a.len + b.len;
+	if (&r == &a || &r == &b) {
+		EBigInteger t;
+		multiplyTo(t, a, b);
+		r = t;
+		return;
+	}
+	word_t* p = r.alloc(n);
+	if (a.mag == b.mag && a.len == b.len) {
+		mulMag(p, a.mag, a.len, a.mag, a.len);
+	} else {
+		mulMag(p, a.mag, a.len, b.mag, b.len);
+	}
+	r.len = n;
+	r.sign = a.sign ^ b.sign;
+	r.normalize();
+}
+
+/*
+ * Toom-Cook 3-way multiplication, Bodrato's sequence as in the JDK: both
+ * numbers are split in three k-word slices and evaluated at 0, 1, -1, -2
+ * and infinity.
+ */
+EBigInteger EBigInteger::multiplyToomCook3(const EBigInteger& a,
+		const EBigInteger& b) {
+	int largest = ES_MAX(a.len, b.len);
+	int k = (largest + 2) / 3;
+
+	EBigInteger a0 = a.slice(0, k), a1 = a.slice(k, 2 * k), a2 = a.slice(2 * k, largest);
+	EBigInteger b0 = b.slice(0, k), b1 = b.slice(k, 2 * k), b2 = b.slice(2 * k, largest);
+	EBigInteger v0, v1, v2, vm1, vinf, t1, t2, tm1, da1, db1, x, y;
+
+	multiplyTo(v0, a0, b0);
+	addTo(da1, a2, a0, false);
+	addTo(db1, b2, b0, false);
+	addTo(x, da1, a1, true);
+	addTo(y, db1, b1, true);
+	multiplyTo(vm1, x, y);
+	addTo(da1, da1, a1, false);
+	addTo(db1, db1, b1, false);
+	multiplyTo(v1, da1, db1);
+	addTo(x, da1, a2, false);
+	x = x.shiftLeft(1);
+	addTo(x, x, a0, true);
+	addTo(y, db1, b2, false);
+	y = y.shiftLeft(1);
+	addTo(y, y, b0, true);
+	multiplyTo(v2, x, y);
+	multiplyTo(vinf, a2, b2);
+
+	// the divisions are exact
+	addTo(t2, v2, vm1, !vm1.sign);
+	divWord(t2.mag, t2.mag, t2.len, 3);
+	t2.normalize();
+	addTo(tm1, v1, vm1, !vm1.sign);
+	tm1 = tm1.shiftRight(1);
+	addTo(t1, v1, v0, true);
+	addTo(t2, t2, t1, !t1.sign);
+	t2 = t2.shiftRight(1);
+	addTo(t1, t1, tm1, !tm1.sign);
+	addTo(t1, t1, vinf, true);
+	x = vinf.shiftLeft(1);
+	addTo(t2, t2, x, true);
+	addTo(tm1, tm1, t2, !t2.sign);
+
+	int ss = k * 32;
+	EBigInteger r = vinf.shiftLeft(ss);
+	addTo(r, r, t2, t2.sign);
+	r = r.shiftLeft(ss);
+	addTo(r, r, t1, t1.sign);
+	r = r.shiftLeft(ss);
+	addTo(r, r, tm1, tm1.sign);
+	r = r.shiftLeft(ss);
+	addTo(r, r, v0, v0.sign);
+	r.sign = (a.sign ^ b.sign) && (r.len > 0);
 	return r;
 }
 
@@ -389,223 +773,416 @@ EBigInteger EBigInteger::operator /(llong v) {
 }
 
 EBigInteger EBigInteger::operator /(EBigInteger& b) {
-	EBigInteger remainder; //Remainder
-	EBigInteger ZERO(0LL), absB(b < ZERO ? -b : b);
-	EString s;
-	if (b == ZERO)
-		return EBigInteger(0LL); //The divisor is 0 and returns 0
-
-	//Two get the length of the digital divide
-	int lenA = num.size();
-	int lenB = b.num.size();
-	int len = 0;
-	//To order read dividend
-	int n = lenA;
-	while (n--) {
-		if (remainder == ZERO)
-			remainder.num.pop();
-		remainder.num.insertElementAt(num[n], 0); //Insert a number
-		//Start trial run
-		EBigInteger tmp2; //Storing temporary results
-		int i = RADIX;
-		while (i--) //Try out operations from large to small
-		{
-			tmp2 = absB * i; //Here we make some judgments about the case where the divisor is negative.
-			                 //We must ensure that the symbols are positive in the operation
-			tmp2 = remainder - tmp2; //Subtract the test result
-			if (tmp2 >= ZERO) { //The first non negative test results
-				s += i; //Quotient
-				remainder = tmp2;
-				break;
-			}
-		}
-	}
-	EBigInteger r(s.c_str()); //result, The constructor automatically removes the leading zeros
-	//positive when same sign &  negative when difference sign
-	r.sign = sign ^ b.sign;
-	return r;
+	EBigInteger q;
+	divideTo(*this, b, &q, null);
+	return q;
 }
+
 EBigInteger EBigInteger::operator %(llong v) {
 	EBigInteger b(v);
 	return this->operator %(b);
 }
 
 EBigInteger EBigInteger::operator %(EBigInteger& b) {
-	EBigInteger remainder; //Remainder
-	EBigInteger ZERO(0LL), absB(b < ZERO ? -b : b);
-	if (b == ZERO)
-		return EBigInteger(0LL); //The divisor is 0 and returns 0
-
-	//Two get the length of the digital divide
-	int lenA = num.size();
-	int lenB = b.num.size();
-	int len = 0;
-	//To order read dividend
-	int i = lenA;
-	while (i--) {
-		if (remainder == ZERO)
-			remainder.num.pop();
-		remainder.num.insertElementAt(num[i], 0); //Insert a number
-		//Start trial run
-		EBigInteger tmp2; //Storing temporary results
-		int i = RADIX;
-		while (i--) //Try out operations from large to small
-		{
-			tmp2 = absB * i; //Here we make some judgments about the case where the divisor is negative.
-                             //We must ensure that the symbols are positive in the operation
-			tmp2 = remainder - tmp2; //Subtract the test result
-			if (tmp2 >= ZERO) { //The first non negative test results
-				remainder = tmp2;
-				break;
-			}
-		}
+	EBigInteger r;
+	divideTo(*this, b, null, &r);
+	return r;
+}
+
+void EBigInteger::divideTo(const EBigInteger& a, const EBigInteger& b,
+		EBigInteger* q, EBigInteger* r) {
+	EBigInteger qt, rt;
+
+	//The divisor is 0 and returns 0
+	if (b.len == 0 || a.compareMagnitude(b) < 0) {
+		if (r) rt = a;
+	} else if (b.len == 1) {
+		word_t* p = qt.alloc(a.len);
+		word_t rem = divWord(p, a.mag, a.len, b.mag[0]);
+		qt.len = a.len;
+		rt = (llong)rem;
+	} else {
+		word_t* qp = qt.alloc(a.len - b.len + 1);
+		word_t* rp = rt.alloc(b.len);
+		divKnuth(qp, rp, a.mag, a.len, b.mag, b.len);
+		qt.len = a.len - b.len + 1;
+		rt.len = b.len;
 	}
+
+	//positive when same sign &  negative when difference sign
+	qt.sign = a.sign ^ b.sign;
+	qt.normalize();
 	//The remainder sign is the same as the dividend symbol
-	remainder.sign = this->sign;
-	return remainder;
+	rt.sign = a.sign;
+	rt.normalize();
+	if (q) *q = qt;
+	if (r) *r = rt;
 }
+
 EA<EBigInteger*> EBigInteger::divideAndRemainder(EBigInteger& b) {
-	EBigInteger remainder; //Remainder
-	EBigInteger ZERO(0LL), absB(b < ZERO ? -b : b);
-	EString s;
-	if (b == ZERO) {
-		//The divisor is 0 and returns 0
-		EA<EBigInteger*> r(2);
-		r[0] = new EBigInteger(0LL);
-		r[1] = new EBigInteger(0LL);
-		return r;
+	EA<EBigInteger*> r(2);
+	r[0] = new EBigInteger();
+	r[1] = new EBigInteger();
+	divideTo(*this, b, r[0], r[1]);
+	return r;
+}
+
+EBigInteger EBigInteger::pow(int exponent) {
+	if (exponent < 0) {
+		throw EArithmeticException(__FILE__, __LINE__, "Negative exponent");
+	}
+	EBigInteger r(1), b(*this), t;
+	while (exponent > 0) {
+		if (exponent & 1) {
+			multiplyTo(t, r, b);
+			r = t;
+		}
+		exponent >>= 1;
+		if (exponent > 0) {
+			multiplyTo(t, b, b);
+			b = t;
+		}
+	}
+	return r;
+}
+
+EBigInteger EBigInteger::modPow(EBigInteger& exponent, EBigInteger& m) {
+	if (m.len == 0 || m.sign) {
+		throw EArithmeticException(__FILE__, __LINE__, "BigInteger: modulus not positive");
+	}
+	if (m.len == 1 && m.mag[0] == 1) {
+		return EBigInteger(0LL);
+	}
+	if (exponent.len == 0) {
+		return EBigInteger(1);
+	}
+	if (exponent.sign) {
+		EBigInteger inv = modInverse(m);
+		EBigInteger e = -exponent;
+		return inv.modPow(e, m);
+	}
+
+	EBigInteger base = mod(m);
+	if (base.len == 0) {
+		return base;
+	}
+	if (m.mag[0] & 1) {
+		return montgomeryPow(base, exponent, m);
 	}
-	//Two get the length of the digital divide
-	int lenA = num.size();
-	int lenB = b.num.size();
-	int len = 0;
-	//To order read dividend
-	int i = lenA;
-	while (i--) {
-		if (remainder == ZERO)
-			remainder.num.pop();
-		remainder.num.insertElementAt(num[i], 0); //Insert a number
-		//Start trial run
-		EBigInteger tmp2; //Storing temporary results
-		int i = RADIX;
-		while (i--) //Try out operations from large to small
-		{
-			tmp2 = absB * i; //Here we make some judgments about the case where the divisor is negative.
-                             //We must ensure that the symbols are positive in the operation
-			tmp2 = remainder - tmp2; //Subtract the test result
-			if (tmp2 >= ZERO) { //The first non negative test results
-				s += i; //Quotient
-				remainder = tmp2;
-				break;
+	return windowPow(base, exponent, m);
+}
+
+/*
+ * Sliding window exponentiation in the Montgomery domain: the odd powers
+ * base^1, base^3, ... base^(2^w-1) are precomputed, then each window of
+ * the exponent costs its squarings and one multiplication.
+ */
+EBigInteger EBigInteger::montgomeryPow(EBigInteger& base,
+		EBigInteger& exponent, EBigInteger& m) {
+	int n = m.len;
+	const word_t* mp = m.mag;
+	word_t inv = montgomeryInverse(mp[0]);
+	int ebits = exponent.bitLength();
+	int wbits = windowBits(ebits);
+	int tsize = 1 << (wbits - 1);
+
+	word_t* buf = (word_t*)eso_calloc(((tsize + 5) * n + 1) * sizeof(word_t));
+	word_t* table = buf;
+	word_t* acc = table + tsize * n;
+	word_t* g2 = acc + n;
+	word_t* tmp = g2 + n;
+	word_t* t = tmp + n;
+
+	// table[0] = base * R mod m
+	EBigInteger g = base.shiftLeft(32 * n);
+	EBigInteger gr;
+	divideTo(g, m, null, &gr);
+	eso_memcpy(table, gr.mag, gr.len * sizeof(word_t));
+	montgomeryMultiply(g2, table, table, mp, n, inv, t);
+	for (int i = 1; i < tsize; i++) {
+		montgomeryMultiply(table + i * n, table + (i - 1) * n, g2, mp, n, inv, t);
+	}
+
+	boolean started = false;
+	for (int i = ebits - 1; i >= 0;) {
+		if (!exponent.testBit(i)) {
+			montgomeryMultiply(acc, acc, acc, mp, n, inv, t);
+			i--;
+			continue;
+		}
+		int j = ES_MAX(i - wbits + 1, 0);
+		while (!exponent.testBit(j)) {
+			j++;
+		}
+		int val = 0;
+		for (int k = i; k >= j; k--) {
+			val = (val << 1) | (exponent.testBit(k) ? 1 : 0);
+		}
+		if (started) {
+			for (int k = i; k >= j; k--) {
+				montgomeryMultiply(acc, acc, acc, mp, n, inv, t);
 			}
+			montgomeryMultiply(tmp, acc, table + (val >> 1) * n, mp, n, inv, t);
+			eso_memcpy(acc, tmp, n * sizeof(word_t));
+		} else {
+			eso_memcpy(acc, table + (val >> 1) * n, n * sizeof(word_t));
+			started = true;
 		}
+		i = j - 1;
 	}
-	EBigInteger divisor(s.c_str()); //Result, The constructor automatically removes the leading zeros
-	//positive when same sign &  negative when difference sign
-	divisor.sign = sign ^ b.sign;
-	//The remainder sign is the same as the dividend symbol
-	remainder.sign = this->sign;
-	EA<EBigInteger*> r(2);
-	r[0] = new EBigInteger(divisor);
-	r[1] = new EBigInteger(remainder);
+
+	// out of the Montgomery domain
+	eso_memset(t, 0, (2 * n + 1) * sizeof(word_t));
+	eso_memcpy(t, acc, n * sizeof(word_t));
+	EBigInteger r;
+	montgomeryReduce(r.alloc(n), t, mp, n, inv);
+	r.len = n;
+	r.normalize();
+
+	eso_free(buf);
+	return r;
+}
+
+/* sliding window exponentiation with division, for even moduli */
+EBigInteger EBigInteger::windowPow(EBigInteger& base,
+		EBigInteger& exponent, EBigInteger& m) {
+	int ebits = exponent.bitLength();
+	int wbits = windowBits(ebits);
+	int tsize = 1 << (wbits - 1);
+
+	EA<EBigInteger*> table(tsize);
+	EBigInteger g2, t, acc;
+	table[0] = new EBigInteger(base);
+	multiplyTo(t, base, base);
+	divideTo(t, m, null, &g2);
+	for (int i = 1; i < tsize; i++) {
+		table[i] = new EBigInteger();
+		multiplyTo(t, *table[i - 1], g2);
+		divideTo(t, m, null, table[i]);
+	}
+
+	boolean started = false;
+	for (int i = ebits - 1; i >= 0;) {
+		if (!exponent.testBit(i)) {
+			multiplyTo(t, acc, acc);
+			divideTo(t, m, null, &acc);
+			i--;
+			continue;
+		}
+		int j = ES_MAX(i - wbits + 1, 0);
+		while (!exponent.testBit(j)) {
+			j++;
+		}
+		int val = 0;
+		for (int k = i; k >= j; k--) {
+			val = (val << 1) | (exponent.testBit(k) ? 1 : 0);
+		}
+		if (started) {
+			for (int k = i; k >= j; k--) {
+				multiplyTo(t, acc, acc);
+				divideTo(t, m, null, &acc);
+			}
+			multiplyTo(t, acc, *table[val >> 1]);
+			divideTo(t, m, null, &acc);
+		} else {
+			acc = *table[val >> 1];
+			started = true;
+		}
+		i = j - 1;
+	}
+	return acc;
+}
+
+EBigInteger EBigInteger::modInverse(EBigInteger& m) {
+	if (m.len == 0 || m.sign) {
+		throw EArithmeticException(__FILE__, __LINE__, "BigInteger: modulus not positive");
+	}
+	if (m.len == 1 && m.mag[0] == 1) {
+		return EBigInteger(0LL);
+	}
+
+	// extended Euclid, tracking the coefficient of this
+	EBigInteger a = mod(m), b(m);
+	EBigInteger x0(1), x1(0LL), q, r, t;
+	while (b.len != 0) {
+		divideTo(a, b, &q, &r);
+		a = b;
+		b = r;
+		multiplyTo(t, q, x1);
+		addTo(t, x0, t, !t.sign && t.len > 0);
+		x0 = x1;
+		x1 = t;
+	}
+	if (a.len != 1 || a.mag[0] != 1) {
+		throw EArithmeticException(__FILE__, __LINE__, "BigInteger not invertible.");
+	}
+	return x0.mod(m);
+}
+
+EBigInteger EBigInteger::shiftLeft(int n) {
+	if (n < 0) {
+		return shiftRight(-n);
+	}
+	EBigInteger r;
+	if (len == 0) {
+		return r;
+	}
+	int nw = n >> 5, nb = n & 0x1f;
+	word_t* p = r.alloc(len + nw + 1);
+	eso_memset(p, 0, nw * sizeof(word_t));
+	if (nb == 0) {
+		eso_memcpy(p + nw, mag, len * sizeof(word_t));
+		p[len + nw] = 0;
+	} else {
+		word_t carry = 0;
+		for (int i = 0; i < len; i++) {
+			p[i + nw] = (mag[i] << nb) | carry;
+			carry = mag[i] >> (32 - nb);
+		}
+		p[len + nw] = carry;
+	}
+	r.len = len + nw + 1;
+	r.sign = sign;
+	r.normalize();
 	return r;
 }
 
+EBigInteger EBigInteger::shiftRight(int n) {
+	if (n < 0) {
+		return shiftLeft(-n);
+	}
+	int nw = n >> 5, nb = n & 0x1f;
+	EBigInteger r;
+	if (nw >= len) {
+		return sign ? EBigInteger(-1) : r;
+	}
+	int rn = len - nw;
+	word_t* p = r.alloc(rn);
+	if (nb == 0) {
+		eso_memcpy(p, mag + nw, rn * sizeof(word_t));
+	} else {
+		for (int i = 0; i < rn; i++) {
+			p[i] = (mag[i + nw] >> nb) | ((i + nw + 1 < len) ? (mag[i + nw + 1] << (32 - nb)) : 0);
+		}
+	}
+	r.len = rn;
+	r.sign = sign;
+
+	if (sign) {
+		// floor: round away from zero if one bits were shifted out
+		boolean lost = (nb != 0) && (mag[nw] << (32 - nb)) != 0;
+		for (int i = 0; !lost && i < nw; i++) {
+			lost = (mag[i] != 0);
+		}
+		if (lost) {
+			word_t one = 1;
+			word_t* q = r.alloc(rn + 1);
+			q[rn] = addMag(q, q, rn, &one, 1);
+			r.len = rn + 1;
+		}
+	}
+	r.normalize();
+	return r;
+}
+
+int EBigInteger::bitLength() {
+	if (len == 0) {
+		return 0;
+	}
+	int n = (len - 1) * 32 + (32 - numberOfLeadingZeros(mag[len - 1]));
+	if (sign) {
+		// a power of two has one bit less in two's complement
+		boolean pow2 = ((mag[len - 1] & (mag[len - 1] - 1)) == 0);
+		for (int i = 0; pow2 && i < len - 1; i++) {
+			pow2 = (mag[i] == 0);
+		}
+		if (pow2) n--;
+	}
+	return n;
+}
+
+boolean EBigInteger::testBit(int n) {
+	if (n < 0) {
+		throw EArithmeticException(__FILE__, __LINE__, "Negative bit address");
+	}
+	if (!sign) {
+		int w = n >> 5;
+		return (w < len) && ((mag[w] >> (n & 0x1f)) & 1);
+	}
+	// two's complement of a negative: ~(|this| - 1)
+	EBigInteger t;
+	EBigInteger one(1);
+	addTo(t, *this, one, false);
+	t.sign = false;
+	return !t.testBit(n);
+}
+
 EBigInteger& EBigInteger::operator +=(EBigInteger& b) {
-	*this = *this + b;
+	addTo(*this, *this, b, b.sign);
 	return *this;
 }
 
 EBigInteger& EBigInteger::operator -=(EBigInteger& b) {
-	*this = *this - b;
+	addTo(*this, *this, b, !b.sign && b.len > 0);
 	return *this;
 }
 
 EBigInteger& EBigInteger::operator *=(EBigInteger& b) {
-	*this = *this * b;
+	multiplyTo(*this, *this, b);
 	return *this;
 }
 
 EBigInteger& EBigInteger::operator /=(EBigInteger& b) {
-	*this = *this / b;
+	divideTo(*this, b, this, null);
 	return *this;
 }
 
 EBigInteger& EBigInteger::operator %=(EBigInteger& b) {
-	*this = *this % b;
+	divideTo(*this, b, null, this);
 	return *this;
 }
 
 EBigInteger& EBigInteger::operator +=(llong val) {
-	*this = *this + val;
-	return *this;
+	EBigInteger b(val);
+	return this->operator +=(b);
 }
 
 EBigInteger& EBigInteger::operator -=(llong val) {
-	*this = *this - val;
-	return *this;
+	EBigInteger b(val);
+	return this->operator -=(b);
 }
 
 EBigInteger& EBigInteger::operator *=(llong val) {
-	*this = *this * val;
-	return *this;
+	EBigInteger b(val);
+	return this->operator *=(b);
 }
 
 EBigInteger& EBigInteger::operator /=(llong val) {
-	*this = *this / val;
-	return *this;
+	EBigInteger b(val);
+	return this->operator /=(b);
 }
 
 EBigInteger& EBigInteger::operator %=(llong val) {
-	*this = *this % val;
-	return *this;
+	EBigInteger b(val);
+	return this->operator %=(b);
 }
 
 boolean EBigInteger::operator <(llong v) {
-	if (v == 0) {
-		return sign;
-	} else {
-		EBigInteger b(v);
-		return this->operator <(b);
-	}
+	EBigInteger b(v);
+	return this->operator <(b);
 }
 
 boolean EBigInteger::operator <(EBigInteger& b) {
-	int bLen = (b.num.size());
-	if (!b.sign && sign)
-		return true; //Left positive, Right negative
-	else if (b.sign && !sign)
-		return false; //Left negative, Right positive
-	else if (num.size() != bLen) {
-		//The length is different, and returns the size directly
-		if (!sign)
-			return num.size() < bLen;
-		else
-			return num.size() > bLen;
-	}
-
-	//By comparison from the beginning of last
-	for (int i = (bLen - 1); i > 0; --i) {
-		if (num[i] != b.num[i]) {
-			if (!b.sign && !this->sign)
-				return num[i] < b.num[i];
-			else
-				return b.num[i] < num[i];
-		}
-	}
-
-	if (!b.sign && !sign)
-		return num[0] < b.num[0]; //Left positive, Right positive
-	else
-		return b.num[0] < num[0]; //Left negative, Right negative
+	return compareTo(&b) < 0;
 }
+
 boolean EBigInteger::operator >(llong v) {
 	EBigInteger b(v);
 	return this->operator >(b);
 }
 
 boolean EBigInteger::operator >(EBigInteger& b) {
-	return (b < *this) && !(*this == b);
+	return compareTo(&b) > 0;
 }
 
 boolean EBigInteger::operator <=(llong v) {
@@ -614,7 +1191,7 @@ boolean EBigInteger::operator <=(llong v) {
 }
 
 boolean EBigInteger::operator <=(EBigInteger& b) {
-	return !(*this > b);
+	return compareTo(&b) <= 0;
 }
 
 boolean EBigInteger::operator >=(llong v) {
@@ -623,7 +1200,7 @@ boolean EBigInteger::operator >=(llong v) {
 }
 
 boolean EBigInteger::operator >=(EBigInteger& b) {
-	return !(*this < b);
+	return compareTo(&b) >= 0;
 }
 
 boolean EBigInteger::operator !=(llong v) {
@@ -632,7 +1209,7 @@ boolean EBigInteger::operator !=(llong v) {
 }
 
 boolean EBigInteger::operator !=(EBigInteger& b) {
-	return !(*this == b);
+	return compareTo(&b) != 0;
 }
 
 boolean EBigInteger::operator ==(llong v) {
@@ -641,47 +1218,216 @@ boolean EBigInteger::operator ==(llong v) {
 }
 
 boolean EBigInteger::operator ==(EBigInteger& b) {
-	if (this->sign != b.sign || this->num.size() != b.num.size()) {
-		return false;
+	return compareTo(&b) == 0;
+}
+
+int EBigInteger::hashCode() {
+	int hashCode = 0;
+	for (int i = len - 1; i >= 0; i--) {
+		hashCode = (int) (31 * hashCode + mag[i]);
 	}
-	//By comparison from the beginning of last
-	for (int i = (b.num.size() - 1); i >= 0; --i) {
-		if (this->num[i] != b.num[i]) {
-			return false;
+
+	return hashCode * signum();
+}
+
+//=============================================================================
+// radix conversion
+
+/*
+ * Divides by the largest power of the radix fitting a word, padding the
+ * result with zeros to digits if needed.
+ */
+void EBigInteger::smallToString(EBigInteger& u, EString& sb, int radix,
+		int digits) {
+	word_t chunk;
+	int dpw = digitsPerWord(radix, &chunk);
+	int n = u.len;
+	if (n == 0) {
+		for (int i = 0; i < ES_MAX(digits, 1); i++) sb << '0';
+		return;
+	}
+
+	// at most ceil(32/log2(radix)) digits per word, less than 33
+	char* buf = (char*)eso_malloc(n * 33 + 1);
+	word_t* w = (word_t*)eso_malloc(n * sizeof(word_t));
+	eso_memcpy(w, u.mag, n * sizeof(word_t));
+	int pos = n * 33;
+	buf[pos] = 0;
+	while (n > 0) {
+		word_t rem = divWord(w, w, n, chunk);
+		n = trimLength(w, n);
+		for (int i = 0; i < dpw && (n > 0 || rem != 0); i++) {
+			buf[--pos] = radixDigits[rem % radix];
+			rem /= radix;
 		}
 	}
+	int ndigits = u.len * 33 - pos;
+	for (int i = ndigits; i < digits; i++) sb << '0';
+	sb.append(buf + pos, ndigits);
 
-	return true;
+	eso_free(w);
+	eso_free(buf);
 }
 
-int EBigInteger::hashCode() {
-	int hashCode = 0;
-	for (int i = 0; i < num.size(); i++) {
-		hashCode = (int) ((31 * hashCode + num[i]));
+/*
+ * Schoenhage's recursive conversion: u is split by radix^(2^n) close to
+ * its square root and both halves are converted in turn.
+ */
+void EBigInteger::toString(EBigInteger& u, EString& sb, int radix,
+		int digits, RadixPowers& powers) {
+	if (u.len <= TOSTRING_THRESHOLD) {
+		smallToString(u, sb, radix, digits);
+		return;
 	}
 
-	return hashCode * (sign ? -1 : 1);
+	double b = u.bitLength();
+	int n = (int)EMath::round(EMath::log(b * EMath::log(2.0) / EMath::log((double)radix)) / EMath::log(2.0) - 1.0);
+	while (n > 0 && powers.get(n).compareMagnitude(u) > 0) {
+		n--;
+	}
+	EBigInteger q, r;
+	divideTo(u, powers.get(n), &q, &r);
+
+	int expectedDigits = 1 << n;
+	toString(q, sb, radix, digits - expectedDigits, powers);
+	toString(r, sb, radix, expectedDigits, powers);
 }
 
-EString EBigInteger::toString() {
+EString EBigInteger::toString(int radix) {
+	if (radix < ECharacter::MIN_RADIX || radix > ECharacter::MAX_RADIX) {
+		radix = 10;
+	}
 	EString out;
+	if (len == 0) {
+		out << '0';
+		return out;
+	}
 	if (sign) {
 		out << '-';
 	}
-	for (int i = num.size() - 1; i >= 0; --i) {
-		out << num[i];
+	EBigInteger u(*this);
+	u.sign = false;
+	if (len <= TOSTRING_THRESHOLD) {
+		smallToString(u, out, radix, 0);
+	} else {
+		RadixPowers powers(radix);
+		toString(u, out, radix, 0, powers);
 	}
 	return out;
 }
 
+EString EBigInteger::toString() {
+	return toString(10);
+}
+
+/* r = digits of s, one word-sized chunk at a time */
+void EBigInteger::smallParse(EBigInteger& r, const char* s, int n,
+		int radix) {
+	word_t chunk;
+	int dpw = digitsPerWord(radix, &chunk);
+	int first = n % dpw;
+	if (first == 0) first = dpw;
+
+	word_t* p = r.alloc(n / dpw + 2);
+	int rn = 0;
+	for (int i = 0; i < n;) {
+		int cnt = (i == 0) ? first : dpw;
+		word_t val = 0, mul = 1;
+		for (int k = 0; k < cnt; k++, i++) {
+			val = val * radix + ECharacter::digit(s[i], radix);
+			mul *= radix;
+		}
+		word_t c = mulAddWord(p, rn, mul, val);
+		if (c != 0 || rn == 0) {
+			p[rn++] = c;
+		}
+		if (rn == 1 && p[0] == 0) {
+			rn = 0; // leading zeros
+		}
+	}
+	r.len = rn;
+	r.sign = false;
+	r.normalize();
+}
+
+/* r = high * radix^(2^i) + low, the low part has 2^i digits */
+void EBigInteger::parse(EBigInteger& r, const char* s, int n, int radix,
+		RadixPowers& powers) {
+	if (n <= PARSE_THRESHOLD) {
+		smallParse(r, s, n, radix);
+		return;
+	}
+	int i = 0;
+	while ((2 << i) < n) {
+		i++;
+	}
+	int low = 1 << i;
+	EBigInteger h, l;
+	parse(h, s, n - low, radix, powers);
+	parse(l, s + n - low, low, radix, powers);
+	multiplyTo(r, h, powers.get(i));
+	addTo(r, r, l, false);
+}
+
+void EBigInteger::parse(const char* s, int radix) {
+	len = 0;
+	sign = false;
+
+	if (!s || !*s) {
+		return;
+	}
+	if (radix < ECharacter::MIN_RADIX || radix > ECharacter::MAX_RADIX) {
+		throw ENumberFormatException(__FILE__, __LINE__, "Radix out of range");
+	}
+
+	EString sn(s);
+	sn.trim();
+	const char* p = sn.c_str();
+	int n = sn.length();
+
+	//Determine numeric symbols
+	boolean negative = false;
+	if (n > 0 && (p[0] == '-' || p[0] == '+')) {
+		negative = (p[0] == '-');
+		p++;
+		n--;
+	}
+	if (n == 0) {
+		throw ENumberFormatException(__FILE__, __LINE__, "Zero length BigInteger");
+	}
+	for (int i = 0; i < n; i++) {
+		if (ECharacter::digit(p[i], radix) < 0) {
+			throw ENumberFormatException(__FILE__, __LINE__, (EString("Illegal digit: ") + s).c_str());
+		}
+	}
+	//Skip leading zeros
+	while (n > 1 && *p == '0') {
+		p++;
+		n--;
+	}
+
+	if (n <= PARSE_THRESHOLD) {
+		smallParse(*this, p, n, radix);
+	} else {
+		RadixPowers powers(radix);
+		parse(*this, p, n, radix, powers);
+	}
+	sign = negative && (len > 0);
+}
+
+//=============================================================================
+
 int EBigInteger::compareTo(EBigInteger* val) {
 	if (!val) {
 		return 1;
 	}
-	if (*this == *val) {
-		return 0;
+	boolean sa = sign && (len > 0);
+	boolean sb = val->sign && (val->len > 0);
+	if (sa != sb) {
+		return sa ? -1 : 1;
 	}
-	return (*this < *val) ? -1 : 1;
+	int c = compareMagnitude(*val);
+	return sa ? -c : c;
 }
 
 boolean EBigInteger::equals(EObject* obj) {
@@ -693,11 +1439,14 @@ boolean EBigInteger::equals(EObject* obj) {
 }
 
 int EBigInteger::intValue() {
-	return EInteger::parseInt(this->toString().c_str());
+	return (int)llongValue();
 }
 
 llong EBigInteger::llongValue() {
-	return ELLong::parseLLong(this->toString().c_str());
+	es_uint64_t x = 0;
+	if (len > 0) x = mag[0];
+	if (len > 1) x |= (es_uint64_t)mag[1] << 32;
+	return sign ? (llong)((es_uint64_t)0 - x) : (llong)x;
 }
 
 float EBigInteger::floatValue() {
@@ -13,6 +13,22 @@
 
 namespace efc {
 
+/*
+ * Decodes a varint that must end within the value, which may be a view
+ * of a corrupted buffer.
+ */
+static es_uint64_t varintOf(const void *v, es_size_t size) {
+	const es_uint8_t *p = (const es_uint8_t*)v;
+	es_uint64_t l = 0;
+	for (es_size_t i = 0; i < size && i < 10; i++) {
+		l |= (es_uint64_t)(p[i] & 0x7F) << (7 * i);
+		if (!(p[i] & 0x80)) {
+			return l;
+		}
+	}
+	throw EDataFormatException(__FILE__, __LINE__, "bad varint");
+}
+
 EBson::~EBson() {
 	eso_bson_destroy(&m_bson);
 }
@@ -428,16 +444,17 @@ void* EBson::nodeGet(es_bson_node_t *node, es_size_t *size) {
 }
 
 EString EBson::nodeGetString(es_bson_node_t *node) {
-	es_size_t size = node->value->len;
-	int type = node->dtype;
-	void* v = node->value->data;
+	return valueGetString(node->dtype, node->value->data, node->value->len);
+}
+
+EString EBson::valueGetString(int type, const void *v, es_size_t size) {
 	if (!v) {
 		throw ENullPointerException(__FILE__, __LINE__);
 	}
 	switch (type) {
 	case BSON_NODE_DATA_TYPE_STRING:
 	case BSON_NODE_DATA_TYPE_BINARY:
-		return (node->value->len == 0) ? null : EString((char*)v, size);
+		return (size == 0) ? null : EString((char*)v, size);
 	case BSON_NODE_DATA_TYPE_I8:
 		return EString((byte)eso_array2llong((es_byte_t*)v, size));
 	case BSON_NODE_DATA_TYPE_I16:
@@ -460,8 +477,7 @@ EString EBson::nodeGetString(es_bson_node_t *node) {
 	}
 	case BSON_NODE_DATA_TYPE_VARINT:
 	{
-		es_uint64_t l;
-		eso_arrayToVarint64((es_uint8_t*)v, &l);
+		es_uint64_t l = varintOf(v, size);
 		return EString((llong)l);
 	}
 	default:
@@ -482,14 +498,19 @@ int EBson::nodeGetInt(es_bson_node_t *node) {
 }
 
 llong EBson::nodeGetLLong(es_bson_node_t *node) {
-	es_size_t size = node->value->len;
-	int type = node->dtype;
-	void* v = node->value->data;
+	return valueGetLLong(node->dtype, node->value->data, node->value->len);
+}
+
+llong EBson::valueGetLLong(int type, const void *v, es_size_t size) {
 	if (!v) {
 		throw ENumberFormatException(__FILE__, __LINE__);
 	}
 	switch (type) {
 	case BSON_NODE_DATA_TYPE_STRING:
+		// nothing to parse, the bytes after are not the value's
+		if (size == 0) {
+			throw ENumberFormatException(__FILE__, __LINE__);
+		}
 		return ELLong::parseLLong((char*)v);
 	case BSON_NODE_DATA_TYPE_BINARY:
 	{
@@ -515,8 +536,7 @@ llong EBson::nodeGetLLong(es_bson_node_t *node) {
 	}
 	case BSON_NODE_DATA_TYPE_VARINT:
 	{
-		es_uint64_t l;
-		eso_arrayToVarint64((es_uint8_t*)v, &l);
+		es_uint64_t l = varintOf(v, size);
 		return (llong)l;
 	}
 	default:
@@ -529,14 +549,18 @@ float EBson::nodeGetFloat(es_bson_node_t *node) {
 }
 
 double EBson::nodeGetDouble(es_bson_node_t *node) {
-	es_size_t size = node->value->len;
-	int type = node->dtype;
-	void* v = node->value->data;
+	return valueGetDouble(node->dtype, node->value->data, node->value->len);
+}
+
+double EBson::valueGetDouble(int type, const void *v, es_size_t size) {
 	if (!v) {
 		throw ENumberFormatException(__FILE__, __LINE__);
 	}
 	switch (type) {
 	case BSON_NODE_DATA_TYPE_STRING:
+		if (size == 0) {
+			throw ENumberFormatException(__FILE__, __LINE__);
+		}
 		return EDouble::parseDouble((char*)v);
 	case BSON_NODE_DATA_TYPE_BINARY:
 	{
@@ -563,8 +587,7 @@ double EBson::nodeGetDouble(es_bson_node_t *node) {
 	}
 	case BSON_NODE_DATA_TYPE_VARINT:
 	{
-		es_uint64_t l;
-		eso_arrayToVarint64((es_uint8_t*)v, &l);
+		es_uint64_t l = varintOf(v, size);
 		return l;
 	}
 	default:
@@ -6,6 +6,9 @@
  */
 
 #include "EBsonParser.hh"
+#include "EIllegalArgumentException.hh"
+#include "ENullPointerException.hh"
+#include "../nio/inc/EIOByteBuffer.hh"
 
 namespace efc {
 
@@ -21,6 +24,12 @@ void EBsonParser::parsed_node(void *s, es_bson_t *bson, es_bson_node_t *node)
 {
 	EBsonParser::Stream *ins = (EBsonParser::Stream*)s;
 	ins->self->parsing(node);
+
+	// bounded memory: the previous sibling and its subtree are done, and
+	// the ones before it are gone already.
+	if (ins->self->_maxBuffered > 0 && node && !node->isattr && node->prev) {
+		EBson::nodeDelete(node->prev);
+	}
 }
 
 EBsonParser::~EBsonParser() {
@@ -28,12 +37,25 @@ EBsonParser::~EBsonParser() {
 }
 
 EBsonParser::EBsonParser(EInputStream* is) :
-	_is(is), _bson(null) {
+	_is(is), _bson(null), _maxBuffered(0) {
 	eso_bson_parser_init(&_es.stm, EBsonParser::stream_read, EBsonParser::parsed_node);
 	_es.self = this;
 }
 
+EBsonParser::EBsonParser(int maxBuffered) :
+	_is(null), _bson(null), _maxBuffered(maxBuffered) {
+	if (maxBuffered < 0) {
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+	}
+	eso_bson_parser_init(&_es.stm, null, EBsonParser::parsed_node);
+	_es.self = this;
+}
+
 boolean EBsonParser::nextBson(EBson* bson) {
+	if (!_is) {
+		return nextPushed(bson);
+	}
+
 	if (bson) {
 		bson->clear();
 	}
@@ -50,4 +72,48 @@ boolean EBsonParser::nextBson(EBson* bson) {
 	return true;
 }
 
+boolean EBsonParser::nextPushed(EBson* bson) {
+	if (!bson) {
+		throw ENullPointerException(__FILE__, __LINE__);
+	}
+	if (!_es.stm._started_) {
+		bson->clear();
+	} else if (bson != _bson) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "resumed with another bson");
+	}
+	_bson = bson;
+
+	if (eso_bson_parse_next(_bson->c_bson(), &_es.stm) == ES_SUCCESS) {
+		return true;
+	}
+	if (_maxBuffered > 0 && buffered() >= _maxBuffered) {
+		throw EDataFormatException(__FILE__, __LINE__, "bson node too large");
+	}
+	return false;
+}
+
+int EBsonParser::feed(const void* data, int size) {
+	if (_is) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "not a push parser");
+	}
+	if (!data || size <= 0) {
+		return 0;
+	}
+	if (_maxBuffered > 0) {
+		size = ES_MIN(size, _maxBuffered - buffered());
+	}
+	eso_bson_parser_feed(&_es.stm, data, size);
+	return size;
+}
+
+int EBsonParser::feed(nio::EIOByteBuffer* buffer) {
+	int n = feed(buffer->current(), buffer->remaining());
+	buffer->position(buffer->position() + n);
+	return n;
+}
+
+int EBsonParser::buffered() {
+	return eso_bson_parser_cached(&_es.stm);
+}
+
 } /* namespace efc */
@@ -0,0 +1,460 @@
+/*
+ * EBsonView.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "EBsonView.hh"
+#include "../nio/inc/EIOByteBuffer.hh"
+
+namespace efc {
+
+//@see: eso_bson.c
+#define BV_FLAG_ATTR      0x80
+#define BV_FLAG_SUB       0x40
+#define BV_FLAG_LAST      0x20
+#define BV_FLAG_HASATTR   0x10
+#define BV_DTYPE_MASK     0x0F
+
+#define BV_TAIL_FLAG      "\x0\x0\xF"
+#define BV_TAIL_SIZE      3
+
+#define BV_MAX_VARINT32_BYTES  5
+#define BV_MAX_VARINT64_BYTES  10
+
+/**
+ * Index entry of a node or an attribute, all offsets are from the data.
+ */
+struct EBsonView::Entry {
+	int name;
+	int value;
+	int valueLen;
+	int parent; // the owner of an attribute, -1 at the top level
+	int next;   // -1 if none, or not indexed yet unless flagged last
+	int child0;
+	int attr0;
+	int flag;
+};
+
+EBsonView::~EBsonView() {
+	eso_free(entries);
+}
+
+EBsonView::EBsonView(const void *data, int size) {
+	init(data, size);
+}
+
+EBsonView::EBsonView(nio::EIOByteBuffer *buffer) {
+	init(buffer->current(), buffer->remaining());
+}
+
+void EBsonView::init(const void *data, int size) {
+	this->data = (const es_uint8_t*)data;
+	this->size = (data && size > 0) ? size : 0;
+	this->pos = 0;
+	this->done = false;
+	this->corrupted = false;
+	this->entries = null;
+	this->entryCount = 0;
+	this->entryCapacity = 0;
+	this->lastElement = -1;
+
+	// skip the head: <?bson version="3" encoding="UTF-8"?>\0
+	if (this->size >= 2 && this->data[0] == '<' && this->data[1] == '?') {
+		int i = 2;
+		while (i + 1 < this->size && !(this->data[i] == '?' && this->data[i + 1] == '>')) {
+			i++;
+		}
+		pos = i + 3;
+		if (pos > this->size) {
+			pos = this->size;
+			corrupted = true;
+		}
+	}
+}
+
+boolean EBsonView::isEmpty() {
+	return childOf(-1) < 0;
+}
+
+int EBsonView::find(const char *path) {
+	return locate(-1, path);
+}
+
+int EBsonView::find(int node, const char *path) {
+	return locate(node, path);
+}
+
+const char* EBsonView::nameOf(int node) {
+	return (const char*)data + entries[node].name;
+}
+
+const void* EBsonView::valueOf(int node, es_size_t *size, int *dtype) {
+	Entry *e = &entries[node];
+	if (size) *size = e->valueLen;
+	if (dtype) *dtype = e->flag & BV_DTYPE_MASK;
+	return data + e->value;
+}
+
+int EBsonView::parentOf(int node) {
+	return entries[node].parent;
+}
+
+int EBsonView::firstChild(int node) {
+	return childOf(node);
+}
+
+int EBsonView::nextSibling(int node) {
+	return siblingOf(node);
+}
+
+const char* EBsonView::get(const char *path) {
+	int node = locate(-1, path);
+	return (node < 0) ? null : (const char*)data + entries[node].value;
+}
+
+const void* EBsonView::get(const char *path, es_size_t *size, int *dtype) {
+	int node = locate(-1, path);
+	return (node < 0) ? null : valueOf(node, size, dtype);
+}
+
+EString EBsonView::getString(const char *path) {
+	int node = locate(-1, path);
+	if (node < 0) {
+		throw ENoSuchElementException(__FILE__, __LINE__);
+	}
+	Entry *e = &entries[node];
+	return EBson::valueGetString(e->flag & BV_DTYPE_MASK, data + e->value, e->valueLen);
+}
+
+byte EBsonView::getByte(const char *path) {
+	return (byte)getLLong(path);
+}
+
+short EBsonView::getShort(const char *path) {
+	return (short)getLLong(path);
+}
+
+int EBsonView::getInt(const char *path) {
+	return (int)getLLong(path);
+}
+
+llong EBsonView::getLLong(const char *path) {
+	int node = locate(-1, path);
+	if (node < 0) {
+		throw ENoSuchElementException(__FILE__, __LINE__);
+	}
+	Entry *e = &entries[node];
+	return EBson::valueGetLLong(e->flag & BV_DTYPE_MASK, data + e->value, e->valueLen);
+}
+
+float EBsonView::getFloat(const char *path) {
+	return getDouble(path);
+}
+
+double EBsonView::getDouble(const char *path) {
+	int node = locate(-1, path);
+	if (node < 0) {
+		throw ENoSuchElementException(__FILE__, __LINE__);
+	}
+	Entry *e = &entries[node];
+	return EBson::valueGetDouble(e->flag & BV_DTYPE_MASK, data + e->value, e->valueLen);
+}
+
+EString EBsonView::getString(const char *path, const char *defaultValue) {
+	try {
+		return getString(path);
+	} catch (...) {
+		return defaultValue;
+	}
+}
+
+byte EBsonView::getByte(const char *path, byte defaultValue) {
+	return (byte)getLLong(path, (llong)defaultValue);
+}
+
+short EBsonView::getShort(const char *path, short defaultValue) {
+	return (short)getLLong(path, (llong)defaultValue);
+}
+
+int EBsonView::getInt(const char *path, int defaultValue) {
+	return (int)getLLong(path, (llong)defaultValue);
+}
+
+llong EBsonView::getLLong(const char *path, llong defaultValue) {
+	try {
+		return getLLong(path);
+	} catch (...) {
+		return defaultValue;
+	}
+}
+
+float EBsonView::getFloat(const char *path, float defaultValue) {
+	return (float)getDouble(path, (double)defaultValue);
+}
+
+double EBsonView::getDouble(const char *path, double defaultValue) {
+	try {
+		return getDouble(path);
+	} catch (...) {
+		return defaultValue;
+	}
+}
+
+const void* EBsonView::attrGet(const char *path, const char *key, es_size_t *size, int *dtype) {
+	int node = locate(-1, path);
+	if (node < 0) {
+		return null;
+	}
+	int attr = findAttr(node, key);
+	return (attr < 0) ? null : valueOf(attr, size, dtype);
+}
+
+EString EBsonView::attrGetString(const char *path, const char *key) {
+	es_size_t size;
+	int dtype;
+	const void *v = attrGet(path, key, &size, &dtype);
+	if (!v) {
+		throw ENoSuchElementException(__FILE__, __LINE__);
+	}
+	return EBson::valueGetString(dtype, v, size);
+}
+
+llong EBsonView::attrGetLLong(const char *path, const char *key) {
+	es_size_t size;
+	int dtype;
+	const void *v = attrGet(path, key, &size, &dtype);
+	if (!v) {
+		throw ENoSuchElementException(__FILE__, __LINE__);
+	}
+	return EBson::valueGetLLong(dtype, v, size);
+}
+
+int EBsonView::count(const char *path) {
+	int node = locate(-1, path);
+	if (node < 0) {
+		return 0;
+	}
+	const char *name = nameOf(node);
+	int n = 1;
+	for (node = siblingOf(node); node >= 0; node = siblingOf(node)) {
+		if (eso_strcmp(name, nameOf(node)) == 0) {
+			n++;
+		}
+	}
+	return n;
+}
+
+int EBsonView::indexed() {
+	return entryCount;
+}
+
+boolean EBsonView::isCorrupted() {
+	return corrupted;
+}
+
+//=============================================================================
+
+int EBsonView::newEntry() {
+	if (entryCount == entryCapacity) {
+		entryCapacity = (entryCapacity == 0) ? 32 : entryCapacity * 2;
+		entries = (Entry*)eso_realloc(entries, entryCapacity * sizeof(Entry));
+	}
+	Entry *e = &entries[entryCount];
+	e->parent = e->next = e->child0 = e->attr0 = -1;
+	return entryCount++;
+}
+
+/*
+ * Read the name and the flag of a record, -1 if truncated.
+ */
+int EBsonView::readRecord() {
+	const es_uint8_t *p = (const es_uint8_t*)eso_memchr(data + pos, 0, size - pos);
+	if (!p || p + 1 >= data + size) {
+		return -1;
+	}
+	int e = newEntry();
+	entries[e].name = pos;
+	entries[e].flag = p[1];
+	pos = (int)(p - data) + 2;
+	return e;
+}
+
+/*
+ * Read the varint length and skip the value, a string must end in the
+ * buffer so that it can be handed out in place.
+ */
+boolean EBsonView::readValue(int e) {
+	es_uint32_t len = 0;
+	int i = 0;
+	for (;;) {
+		if (pos >= size || i == BV_MAX_VARINT64_BYTES) {
+			return false;
+		}
+		es_uint32_t b = data[pos++];
+		if (i < BV_MAX_VARINT32_BYTES) {
+			len |= (b & 0x7F) << (7 * i);
+		}
+		i++;
+		if (!(b & 0x80)) {
+			break;
+		}
+	}
+	if (len > (es_uint32_t)(size - pos)) {
+		return false;
+	}
+	Entry *entry = &entries[e];
+	if ((entry->flag & BV_DTYPE_MASK) == BSON_NODE_DATA_TYPE_STRING
+			&& len > 0 && data[pos + len - 1] != 0) {
+		return false;
+	}
+	entry->value = pos;
+	entry->valueLen = len;
+	pos += len;
+	return true;
+}
+
+/*
+ * Index the next element with its attributes, false at the end.  The
+ * records come in preorder, an element is linked the same way as by the
+ * importer: the first child of the previous element if flagged sub, or
+ * else the next sibling of the nearest element up not flagged last.
+ */
+boolean EBsonView::scanNext() {
+	if (done) {
+		return false;
+	}
+	if (pos >= size || (size - pos >= BV_TAIL_SIZE
+			&& eso_memcmp(data + pos, BV_TAIL_FLAG, BV_TAIL_SIZE) == 0)) {
+		done = true;
+		return false;
+	}
+
+	int mark = entryCount;
+	int e = readRecord();
+	if (e < 0 || (entries[e].flag & BV_FLAG_ATTR)) {
+		goto CORRUPTED;
+	}
+	if (entries[e].flag & BV_FLAG_HASATTR) {
+		int prev = -1;
+		for (;;) {
+			int a = readRecord();
+			if (a < 0 || !(entries[a].flag & BV_FLAG_ATTR) || !readValue(a)) {
+				goto CORRUPTED;
+			}
+			entries[a].parent = e;
+			if (prev < 0) entries[e].attr0 = a;
+			else entries[prev].next = a;
+			prev = a;
+			if (entries[a].flag & BV_FLAG_LAST) {
+				break;
+			}
+		}
+	}
+	if (!readValue(e)) {
+		goto CORRUPTED;
+	}
+
+	if (lastElement < 0) {
+		entries[e].parent = -1;
+	} else if (entries[e].flag & BV_FLAG_SUB) {
+		entries[lastElement].child0 = e;
+		entries[e].parent = lastElement;
+	} else {
+		int s = lastElement;
+		while (s >= 0 && (entries[s].flag & BV_FLAG_LAST)) {
+			s = entries[s].parent;
+		}
+		if (s < 0) {
+			// no open sibling list, the importer stops here too.
+			entryCount = mark;
+			done = true;
+			return false;
+		}
+		entries[s].next = e;
+		entries[e].parent = entries[s].parent;
+	}
+	lastElement = e;
+	return true;
+
+CORRUPTED:
+	entryCount = mark;
+	corrupted = true;
+	done = true;
+	return false;
+}
+
+int EBsonView::childOf(int parent) {
+	if (parent < 0) {
+		if (entryCount == 0) {
+			scanNext();
+		}
+		return (entryCount > 0) ? 0 : -1;
+	}
+	// the children follow at once, the next record tells if there is one.
+	if (parent == lastElement) {
+		scanNext();
+	}
+	return entries[parent].child0;
+}
+
+int EBsonView::siblingOf(int node) {
+	while (entries[node].next < 0 && !(entries[node].flag & BV_FLAG_LAST)
+			&& scanNext()) {
+	}
+	return entries[node].next;
+}
+
+int EBsonView::locate(int parent, const char *path) {
+	if (!path) {
+		return -1;
+	}
+	const char *p = path;
+	if (*p == '/') {
+		p++;
+	}
+	int found = -1;
+	while (*p && *p != '/') {
+		const char *end = p;
+		while (*end && *end != '/') {
+			end++;
+		}
+		const char *bar = (const char*)eso_memchr(p, '|', end - p);
+		int nlen = (int)((bar ? bar : end) - p);
+		int index = bar ? eso_atol(bar + 1) : 1;
+
+		int n = 0;
+		found = -1;
+		for (int c = childOf(parent); c >= 0; c = siblingOf(c)) {
+			const char *name = nameOf(c);
+			if (eso_strncmp(name, p, nlen) == 0 && name[nlen] == 0) {
+				n++;
+				if (index == 0) {
+					found = c;
+				} else if (n == index) {
+					found = c;
+					break;
+				}
+			}
+		}
+		if (found < 0) {
+			return -1;
+		}
+
+		parent = found;
+		p = *end ? end + 1 : end;
+	}
+	return found;
+}
+
+int EBsonView::findAttr(int node, const char *key) {
+	for (int a = entries[node].attr0; a >= 0; a = entries[a].next) {
+		if (eso_strcmp(nameOf(a), key) == 0) {
+			return a;
+		}
+	}
+	return -1;
+}
+
+} /* namespace efc */
@@ -25,7 +25,9 @@ void ECRC32::update(byte* b, int len) {
 }
 
 llong ECRC32::getValue() {
-	return eso_crc32_final(_crc);
+	es_uint32_t crc = _crc;
+	eso_crc32_final(crc);
+	return (llong)crc;
 }
 
 void ECRC32::reset() {
@@ -0,0 +1,37 @@
+/*
+ * ECRC32C.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "ECRC32C.hh"
+
+namespace efc {
+
+ECRC32C::~ECRC32C() {
+}
+
+ECRC32C::ECRC32C() {
+	eso_crc32c_init(_crc);
+}
+
+void ECRC32C::update(byte b) {
+	eso_crc32c_update(&_crc, (es_byte_t*)&b, 1);
+}
+
+void ECRC32C::update(byte* b, int len) {
+	eso_crc32c_update(&_crc, (es_byte_t*)b, len);
+}
+
+llong ECRC32C::getValue() {
+	es_uint32_t crc = _crc;
+	eso_crc32c_final(crc);
+	return (llong)crc;
+}
+
+void ECRC32C::reset() {
+	eso_crc32c_init(_crc);
+}
+
+} /* namespace efc */
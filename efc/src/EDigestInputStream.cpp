@@ -0,0 +1,51 @@
+/*
+ * EDigestInputStream.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "EDigestInputStream.hh"
+
+namespace efc {
+
+EDigestInputStream::~EDigestInputStream() {
+}
+
+EDigestInputStream::EDigestInputStream(EInputStream* in, EMessageDigest* digest, boolean owned) :
+		EFilterInputStream(in, owned), _digest(digest), _on(true) {
+}
+
+int EDigestInputStream::read() {
+	int b = _in->read();
+	if (_on && b != -1) {
+		_digest->update((byte)b);
+	}
+	return b;
+}
+
+int EDigestInputStream::read(void* b, int len) {
+	int result = _in->read(b, len);
+	if (_on && result > 0) {
+		_digest->update(b, result);
+	}
+	return result;
+}
+
+void EDigestInputStream::on(boolean on) {
+	_on = on;
+}
+
+EMessageDigest* EDigestInputStream::getMessageDigest() {
+	return _digest;
+}
+
+void EDigestInputStream::setMessageDigest(EMessageDigest* digest) {
+	_digest = digest;
+}
+
+EString EDigestInputStream::toString() {
+	return EString::formatOf("[Digest Input Stream] %s", _digest->toString().c_str());
+}
+
+} /* namespace efc */
@@ -0,0 +1,53 @@
+/*
+ * EDigestOutputStream.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "EDigestOutputStream.hh"
+
+namespace efc {
+
+EDigestOutputStream::~EDigestOutputStream() {
+}
+
+EDigestOutputStream::EDigestOutputStream(EOutputStream* out, EMessageDigest* digest, boolean owned) :
+		EFilterOutputStream(out, owned), _digest(digest), _on(true) {
+}
+
+void EDigestOutputStream::write(int b) {
+	if (_on) {
+		_digest->update((byte)b);
+	}
+	_out->write(b);
+}
+
+void EDigestOutputStream::write(const void* b, int len) {
+	if (_on) {
+		_digest->update(b, len);
+	}
+	_out->write(b, len);
+}
+
+void EDigestOutputStream::write(const char* s) {
+	EOutputStream::write(s);
+}
+
+void EDigestOutputStream::on(boolean on) {
+	_on = on;
+}
+
+EMessageDigest* EDigestOutputStream::getMessageDigest() {
+	return _digest;
+}
+
+void EDigestOutputStream::setMessageDigest(EMessageDigest* digest) {
+	_digest = digest;
+}
+
+EString EDigestOutputStream::toString() {
+	return EString::formatOf("[Digest Output Stream] %s", _digest->toString().c_str());
+}
+
+} /* namespace efc */
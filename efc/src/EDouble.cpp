@@ -22,16 +22,14 @@ EDouble::EDouble(double value) {
 
 EDouble::EDouble(const char* s) THROWS(ENumberFormatException)
 {
-	if (!s || !*s) {
-		throw ENumberFormatException(__FILE__, __LINE__, "empty String");
-	}
-
-	this->value = (double)eso_atof(s);
+	this->value = parseDouble(s);
 }
 
 EString EDouble::toString(double f)
 {
-	return EString::formatOf("%f", f);
+	char s[ES_DTOA_BUFSIZE];
+	eso_dtoa_java(f, s);
+	return EString(s);
 }
 
 EDouble EDouble::valueOf(const char* s) THROWS(ENumberFormatException)
@@ -46,8 +44,26 @@ EDouble EDouble::valueOf(double f)
 
 double EDouble::parseDouble(const char* s) THROWS(ENumberFormatException)
 {
-	EDouble d(s);
-	return d.doubleValue();
+	if (!s || !*s) {
+		throw ENumberFormatException(__FILE__, __LINE__, "empty String");
+	}
+
+	char* end = NULL;
+	double d = eso_parse_double(s, &end);
+	if (end == s) {
+		throw ENumberFormatException(__FILE__, __LINE__, s);
+	}
+	// java float type suffix and trailing whitespace are allowed
+	if (*end == 'd' || *end == 'D' || *end == 'f' || *end == 'F') {
+		end++;
+	}
+	while (*end && (unsigned char)*end <= ' ') {
+		end++;
+	}
+	if (*end) {
+		throw ENumberFormatException(__FILE__, __LINE__, s);
+	}
+	return d;
 }
 
 llong EDouble::doubleToLLongBits(double value)
@@ -77,7 +93,7 @@ int EDouble::compare(double d1, double d2)
 
 EString EDouble::toString()
 {
-	return EString::formatOf("%lf", value);
+	return toString(value);
 }
 
 byte EDouble::byteValue()
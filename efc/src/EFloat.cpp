@@ -27,16 +27,14 @@ EFloat::EFloat(double value)
 
 EFloat::EFloat(const char* s) THROWS(ENumberFormatException)
 {
-	if (!s || !*s) {
-		throw ENumberFormatException(__FILE__, __LINE__, "empty String");
-	}
-
-	this->value = (float)eso_atof(s);
+	this->value = parseFloat(s);
 }
 
 EString EFloat::toString(float f)
 {
-	return EString::formatOf("%f", f);
+	char s[ES_DTOA_BUFSIZE];
+	eso_ftoa_java(f, s);
+	return EString(s);
 }
 
 EFloat EFloat::valueOf(const char* s) THROWS(ENumberFormatException)
@@ -51,8 +49,26 @@ EFloat EFloat::valueOf(float f)
 
 float EFloat::parseFloat(const char* s) THROWS(ENumberFormatException)
 {
-	EFloat f(s);
-	return f.floatValue();
+	if (!s || !*s) {
+		throw ENumberFormatException(__FILE__, __LINE__, "empty String");
+	}
+
+	char* end = NULL;
+	float f = eso_parse_float(s, &end);
+	if (end == s) {
+		throw ENumberFormatException(__FILE__, __LINE__, s);
+	}
+	// java float type suffix and trailing whitespace are allowed
+	if (*end == 'd' || *end == 'D' || *end == 'f' || *end == 'F') {
+		end++;
+	}
+	while (*end && (unsigned char)*end <= ' ') {
+		end++;
+	}
+	if (*end) {
+		throw ENumberFormatException(__FILE__, __LINE__, s);
+	}
+	return f;
 }
 
 int EFloat::floatToIntBits(float value)
@@ -82,7 +98,7 @@ int EFloat::compare(float f1, float f2)
 
 EString EFloat::toString()
 {
-	return EString::formatOf("%f", value);
+	return toString(value);
 }
 
 byte EFloat::byteValue()
@@ -8,6 +8,7 @@
 #include "EGZIPInputStream.hh"
 #include "ECheckedInputStream.hh"
 #include "EStream.hh"
+#include "ENullPointerException.hh"
 
 namespace efc {
 
@@ -18,6 +19,9 @@ namespace efc {
 
 #define SKIP_BUFFER_SIZE 512
 
+#define READAHEAD_CHUNK_SIZE  65536
+#define READAHEAD_CHUNKS      4
+
 /*
      * File header flags.
      */
@@ -27,12 +31,69 @@ namespace efc {
 #define FNAME	  8 	// File name
 #define FCOMMENT 16 	// File comment
 
+/*
+ * Inflates the whole stream into chunks, it's the only user of the inflater
+ * in the readahead mode.
+ */
+class EGZIPInputStream::Readahead: public ERunnable {
+public:
+	Readahead(EGZIPInputStream* gz) : gz(gz) {
+	}
+
+	virtual void run() {
+		try {
+			int r = 0;
+			while (r >= 0 && !gz->_stopped) {
+				sp<EA<byte> > chunk = new EA<byte>(READAHEAD_CHUNK_SIZE);
+				int n = 0;
+				while (n < chunk->length()) {
+					r = gz->inflate((byte*)chunk->address() + n, chunk->length() - n);
+					if (r < 0) {
+						break;
+					}
+					n += r;
+				}
+				if (n == chunk->length()) {
+					gz->_chunks->put(chunk);
+				} else if (n > 0) {
+					sp<EA<byte> > last = new EA<byte>(n);
+					memcpy(last->address(), chunk->address(), n);
+					gz->_chunks->put(last);
+				}
+			}
+		} catch (EThrowable& e) {
+			const char* msg = e.getMessage();
+			gz->_error = (msg && *msg) ? msg : "readahead failed";
+		}
+		// the reader clears the queue if it stops early
+		gz->_chunks->put(new EA<byte>(0));
+	}
+
+private:
+	EGZIPInputStream* gz;
+};
+
 EGZIPInputStream::~EGZIPInputStream() {
+	stop();
 	delete _inf;
 }
 
 EGZIPInputStream::EGZIPInputStream(EInputStream* in, int size) :
-	EInflaterInputStream(in, size, false) {
+	EInflaterInputStream(in, size, false), _chunkPos(0), _stopped(false) {
+	_eos = false;
+	_closed = false;
+	_inf = new EInflater(true);
+	EInflaterInputStream::setInflater(_inf);
+	_usesDefaultInflater = true;
+	readHeader();
+	_crc.reset();
+}
+
+EGZIPInputStream::EGZIPInputStream(EInputStream* in, EExecutorService* executor, int size) :
+	EInflaterInputStream(in, size, false), _chunkPos(0), _stopped(false) {
+	if (!executor) {
+		throw ENullPointerException(__FILE__, __LINE__);
+	}
 	_eos = false;
 	_closed = false;
 	_inf = new EInflater(true);
@@ -40,6 +101,9 @@ EGZIPInputStream::EGZIPInputStream(EInputStream* in, int size) :
 	_usesDefaultInflater = true;
 	readHeader();
 	_crc.reset();
+
+	_chunks = new EArrayBlockingQueue<EA<byte> >(READAHEAD_CHUNKS);
+	_task = executor->submit<EObject>(sp<ERunnable>(new Readahead(this)));
 }
 
 int EGZIPInputStream::read(void* b, int len) {
@@ -47,18 +111,70 @@ int EGZIPInputStream::read(void* b, int len) {
 	if (_eos) {
 		return -1;
 	}
+	if (_chunks == null) {
+		len = inflate(b, len);
+		if (len == -1) {
+			_eos = true;
+		}
+		return len;
+	}
+
+	if (_chunk == null || _chunkPos == _chunk->length()) {
+		_chunk = _chunks->take();
+		_chunkPos = 0;
+		if (_chunk->length() == 0) {
+			_chunk = null;
+			_eos = true;
+			_task->get();
+			_task = null;
+			if (!_error.isEmpty()) {
+				throw EIOException(__FILE__, __LINE__, _error.c_str());
+			}
+			return -1;
+		}
+	}
+	len = ES_MIN(len, _chunk->length() - _chunkPos);
+	memcpy(b, (byte*)_chunk->address() + _chunkPos, len);
+	_chunkPos += len;
+	return len;
+}
+
+long EGZIPInputStream::available() {
+	if (_chunks == null) {
+		return EInflaterInputStream::available();
+	}
+	ensureOpen();
+	if (_eos) {
+		return 0;
+	}
+	return (_chunk != null && _chunkPos < _chunk->length()) ? _chunk->length() - _chunkPos : 1;
+}
+
+int EGZIPInputStream::inflate(void* b, int len) {
 	len = EInflaterInputStream::read(b, len);
 	if (len == -1) {
 		readTrailer();
-		_eos = true;
 	} else {
 		_crc.update((byte*)b, len);
 	}
 	return len;
 }
 
+void EGZIPInputStream::stop() {
+	if (_task != null) {
+		_stopped = true;
+		_chunks->clear();
+		try {
+			_task->get();
+		} catch (...) {
+		}
+		_task = null;
+	}
+}
+
 void EGZIPInputStream::close() {
 	if (!_closed) {
+		stop();
 		EInflaterInputStream::close();
 		_eos = true;
 		_closed = true;
@@ -6,6 +6,13 @@
  */
 
 #include "EGZIPOutputStream.hh"
+#include "EByteArrayOutputStream.hh"
+#include "ERuntime.hh"
+#include "EIllegalArgumentException.hh"
+#include "ENullPointerException.hh"
+#include "./concurrent/EExecutionException.hh"
+
+#include "../libc/src/zlib/zlib.h"
 
 namespace efc {
 
@@ -33,12 +40,90 @@ static byte header[] = {
         0                                 // Operating system (OS)
     };
 
+#define DICT_SIZE 32768
+
+/*
+ * A block of the parallel mode, deflated as a piece of a raw deflate stream.
+ */
+class EGZIPOutputStream::Block: public ECallable<EA<byte> > {
+public:
+	sp<EFuture<EA<byte> > > future;
+	es_uint32_t crc;
+	int len;
+
+	Block(sp<EA<byte> > data, int len, sp<EA<byte> > dict, int dictLen,
+			boolean last, int level, sp<EConcurrentLinkedQueue<EDeflater> > deflaters) :
+			crc(0), len(len), data(data), dict(dict), dictLen(dictLen),
+			last(last), level(level), deflaters(deflaters) {
+	}
+
+	virtual sp<EA<byte> > call() {
+		byte out[16384];
+		EByteArrayOutputStream baos(len / 2 + 64);
+		sp<EDeflater> def = deflaters->poll();
+		if (def == null) {
+			def = new EDeflater(level, true);
+		}
+
+		crc = (es_uint32_t)::crc32(0, (Bytef*)data->address(), len);
+
+		if (dict != null) {
+			int n = ES_MIN(dictLen, DICT_SIZE);
+			def->setDictionary((byte*)dict->address() + dictLen - n, n);
+		}
+		def->setInput((byte*)data->address(), len);
+		if (last) {
+			def->finish();
+			while (!def->finished()) {
+				int n = def->deflate(out, sizeof(out), EDeflater::NO_FLUSH);
+				baos.write(out, n);
+			}
+		} else {
+			while (!def->needsInput()) {
+				int n = def->deflate(out, sizeof(out), EDeflater::NO_FLUSH);
+				baos.write(out, n);
+			}
+			// byte aligned, and not the final block
+			int n;
+			do {
+				n = def->deflate(out, sizeof(out), EDeflater::SYNC_FLUSH);
+				baos.write(out, n);
+			} while (n == sizeof(out));
+		}
+
+		// the data and the dictionary are no longer needed
+		data = null;
+		dict = null;
+		def->reset();
+		deflaters->offer(def);
+		return baos.reset(false);
+	}
+
+private:
+	sp<EA<byte> > data;
+	sp<EA<byte> > dict;
+	int dictLen;
+	boolean last;
+	int level;
+	sp<EConcurrentLinkedQueue<EDeflater> > deflaters;
+};
+
 EGZIPOutputStream::~EGZIPOutputStream() {
 	delete _def;
+	if (_pending) {
+		// unfinished: the blocks are left to the executor
+		sp<Block> block;
+		while ((block = _pending->pollFirst()) != null) {
+			block->future = null;
+		}
+		delete _pending;
+	}
 }
 
 EGZIPOutputStream::EGZIPOutputStream(EOutputStream* out, int size, boolean syncFlush) :
-		EDeflaterOutputStream(out, size, syncFlush, false) {
+		EDeflaterOutputStream(out, size, syncFlush, false),
+		_executor(null), _level(EDeflater::DEFAULT_COMPRESSION), _maxPending(0),
+		_blockLen(0), _prevLen(0), _pending(null), _blockCrc(0), _totalIn(0) {
 	_def = new EDeflater(EDeflater::DEFAULT_COMPRESSION, true);
 	EDeflaterOutputStream::setDeflater(_def);
 	_usesDefaultDeflater = true;
@@ -46,9 +131,46 @@ EGZIPOutputStream::EGZIPOutputStream(EOutputStream* out, int size, boolean syncF
 	_crc.reset();
 }
 
+EGZIPOutputStream::EGZIPOutputStream(EOutputStream* out, EExecutorService* executor,
+		int blockSize, int level) :
+		EDeflaterOutputStream(out, 512, false, false),
+		_def(null), _executor(executor), _level(level),
+		_blockLen(0), _prevLen(0), _blockCrc(0), _totalIn(0) {
+	if (!executor) {
+		throw ENullPointerException(__FILE__, __LINE__);
+	}
+	if (blockSize < DICT_SIZE) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "blockSize < 32K");
+	}
+	_maxPending = ERuntime::getRuntime()->availableProcessors() * 2;
+	_block = new EA<byte>(blockSize);
+	_pending = new EArrayDeque<sp<Block> >();
+	_deflaters = new EConcurrentLinkedQueue<EDeflater>();
+	writeHeader();
+}
+
 void EGZIPOutputStream::write(const void* b, int len) {
-	EDeflaterOutputStream::write(b, len);
-	_crc.update((es_int8_t*)b, len);
+	if (!_executor) {
+		EDeflaterOutputStream::write(b, len);
+		_crc.update((es_int8_t*)b, len);
+		return;
+	}
+
+	ES_ASSERT(b); ES_ASSERT(len >= 0);
+	if (_block == null) {
+		throw EIOException(__FILE__, __LINE__, "write beyond end of stream");
+	}
+	const byte* p = (const byte*)b;
+	while (len > 0) {
+		int n = ES_MIN(len, _block->length() - _blockLen);
+		memcpy((byte*)_block->address() + _blockLen, p, n);
+		_blockLen += n;
+		p += n;
+		len -= n;
+		if (_blockLen == _block->length()) {
+			submit(false);
+		}
+	}
 }
 
 void EGZIPOutputStream::write(const char *s)
@@ -62,6 +184,17 @@ void EGZIPOutputStream::write(int b)
 }
 
 void EGZIPOutputStream::finish() {
+	if (_executor) {
+		if (_block != null) {
+			submit(true);
+			_block = null;
+			drain(0);
+			byte trailer[TRAILER_SIZE] = {0};
+			writeTrailer(trailer);
+			_out->write(trailer, sizeof(trailer));
+		}
+		return;
+	}
 	if (!_def->finished()) {
 		_def->finish();
 		while (!_def->finished()) {
@@ -84,13 +217,58 @@ void EGZIPOutputStream::finish() {
 	}
 }
 
+void EGZIPOutputStream::flush() {
+	if (!_executor) {
+		EDeflaterOutputStream::flush();
+		return;
+	}
+	if (_block != null && _blockLen > 0) {
+		submit(false);
+	}
+	drain(0);
+	_out->flush();
+}
+
+void EGZIPOutputStream::submit(boolean last) {
+	sp<Block> block = new Block(_block, _blockLen, _prev, _prevLen, last,
+			_level, _deflaters);
+	block->future = _executor->submit<EA<byte> >(block);
+	_pending->addLast(block);
+	_totalIn += _blockLen;
+
+	_prev = _block;
+	_prevLen = _blockLen;
+	if (!last) {
+		_block = new EA<byte>(_block->length());
+	}
+	_blockLen = 0;
+
+	drain(_maxPending);
+}
+
+void EGZIPOutputStream::drain(int keep) {
+	while (_pending->size() > keep) {
+		sp<Block> block = _pending->pollFirst();
+		sp<EFuture<EA<byte> > > future = block->future;
+		sp<EA<byte> > out;
+		block->future = null; // the future task refers to the block
+		try {
+			out = future->get();
+		} catch (EExecutionException& e) {
+			throw EIOException(__FILE__, __LINE__, e.getMessage());
+		}
+		_out->write(out->address(), out->length());
+		_blockCrc = (es_uint32_t)::crc32_combine(_blockCrc, block->crc, block->len);
+	}
+}
+
 void EGZIPOutputStream::writeHeader() {
 	_out->write(header, sizeof(header));
 }
 
 void EGZIPOutputStream::writeTrailer(byte buf[8]) {
-	int crc = (int)_crc.getValue();
-	int totalIn = _def->getTotalIn();
+	int crc = _executor ? (int)_blockCrc : (int)_crc.getValue();
+	int totalIn = _executor ? (int)_totalIn : _def->getTotalIn();
 
 	eso_llong2array(crc, (es_byte_t*)buf, 4); // CRC-32 of uncompr. data
 	eso_llong2array(totalIn, (es_byte_t*)buf+4, 4); // Number of uncompr. bytes
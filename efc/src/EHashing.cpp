@@ -0,0 +1,60 @@
+/*
+ * EHashing.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "EHashing.hh"
+#include "EString.hh"
+
+namespace efc {
+
+/* the fixed seed of WYHASH, any non-zero value */
+#define WYHASH_FIXED_SEED  LLONG(0x5bd1e9955bd1e995)
+
+static volatile int defaultPolicy = EHashing::JAVA;
+
+EHashing::Policy EHashing::getDefaultPolicy() {
+	return (Policy)defaultPolicy;
+}
+
+void EHashing::setDefaultPolicy(Policy policy) {
+	defaultPolicy = policy;
+}
+
+llong EHashing::seedOf(Policy policy) {
+	switch (policy) {
+	case WYHASH:
+		return WYHASH_FIXED_SEED;
+	case WYHASH_SEEDED:
+		return (llong)eso_hash_seed();
+	default:
+		return 0;
+	}
+}
+
+llong EHashing::hash64(const void* data, int len, llong seed) {
+	return (llong)eso_hash64(data, len, (es_uint64_t)seed);
+}
+
+int EHashing::hash32(llong key, llong seed) {
+	es_uint64_t h = eso_hash64_int((es_uint64_t)key, (es_uint64_t)seed);
+	return (int)(h ^ (h >> 32));
+}
+
+int EHashing::hash32(float key, llong seed) {
+	return hash32((llong)eso_float2intBits(key == 0.0f ? 0.0f : key), seed);
+}
+
+int EHashing::hash32(double key, llong seed) {
+	return hash32((llong)eso_double2llongBits(key == 0.0 ? 0.0 : key), seed);
+}
+
+int EHashing::hash32(EString* key, llong seed) {
+	if (!key) return 0;
+	es_uint64_t h = eso_hash64(key->c_str(), key->length(), (es_uint64_t)seed);
+	return (int)(h ^ (h >> 32));
+}
+
+} /* namespace efc */
@@ -0,0 +1,527 @@
+/*
+ * EJsonParser.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "EJsonParser.hh"
+
+namespace efc {
+
+#define JSON_STREAM_BLOCK   (64 * 1024)
+
+enum {
+	S_VALUE = 0,
+	S_OBJECT_FIRST,
+	S_KEY,
+	S_COLON,
+	S_OBJECT_NEXT,
+	S_ARRAY_FIRST,
+	S_ARRAY_NEXT,
+	S_END
+};
+
+static ES_INLINE boolean is_ws(char c) {
+	return (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+}
+
+/* what may follow a number or a literal */
+static ES_INLINE boolean is_delimiter(char c) {
+	switch (c) {
+	case ' ': case '\n': case '\r': case '\t':
+	case ',': case ':': case ']': case '}': case '[': case '{': case '"':
+	case '\0':
+		return true;
+	default:
+		return false;
+	}
+}
+
+static ES_INLINE boolean is_digit(char c) {
+	return (c >= '0' && c <= '9');
+}
+
+static int hex4(const char *s) {
+	int v = 0;
+	for (int i = 0; i < 4; i++) {
+		char c = s[i];
+		v <<= 4;
+		if (c >= '0' && c <= '9') v |= c - '0';
+		else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+		else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+		else return -1;
+	}
+	return v;
+}
+
+/* the first control character out of place, which the first stage reports in bulk */
+static int control_offset(const char *s, int len) {
+	boolean quoted = false;
+	for (int i = 0; i < len; i++) {
+		es_uint8_t c = (es_uint8_t)s[i];
+		if (c == '"') {
+			quoted = !quoted;
+		} else if (c == '\\' && quoted) {
+			i++;
+		} else if (c < 0x20 && (quoted || !is_ws(c))) {
+			return i;
+		}
+	}
+	return 0;
+}
+
+/* the end of the valid utf-8 prefix of s[from, to), an unfinished sequence excluded */
+static int utf8_boundary(const char *s, int from, int to) {
+	int j = to - 1;
+	while (j > from && j > to - 4 && (s[j] & 0xC0) == 0x80) {
+		j--;
+	}
+	if (j < from) {
+		return to;
+	}
+	es_uint8_t lead = (es_uint8_t)s[j];
+	int need = (lead >= 0xF0) ? 4 : (lead >= 0xE0) ? 3 : (lead >= 0xC0) ? 2 : 1;
+	return (j + need <= to) ? to : j;
+}
+
+EJsonParser::~EJsonParser() {
+	eso_free(text);
+	eso_free(positions);
+	eso_free(match);
+	eso_free(stack);
+	eso_free(scratch);
+}
+
+EJsonParser::EJsonParser() :
+		text(null), textLength(0), textCapacity(0),
+		positions(null), match(null), count(0), positionCapacity(0),
+		parsed(false), state(S_VALUE), depth(0), scratch(null),
+		scratchCapacity(0), base(0) {
+	stack = (int*)eso_malloc(MAX_DEPTH * sizeof(int));
+}
+
+void EJsonParser::reserveText(int size) {
+	// 64 bytes of padding for the block reads of the first stage and
+	// the look ahead of the second one
+	if (size + ES_JSON_BLOCK_SIZE > textCapacity) {
+		int n = ES_MAX(size + ES_JSON_BLOCK_SIZE, textCapacity + (textCapacity >> 1));
+		text = (char*)eso_realloc(text, n);
+		textCapacity = n;
+	}
+}
+
+void EJsonParser::reservePositions(int size) {
+	if (size > positionCapacity) {
+		int n = ES_MAX(size, positionCapacity + (positionCapacity >> 1));
+		positions = (es_uint32_t*)eso_realloc(positions, n * sizeof(es_uint32_t));
+		match = (es_uint32_t*)eso_realloc(match, n * sizeof(es_uint32_t));
+		positionCapacity = n;
+	}
+}
+
+char* EJsonParser::reserveScratch(int size) {
+	if (size > scratchCapacity) {
+		int n = ES_MAX(size, 256);
+		eso_free(scratch);
+		scratch = (char*)eso_malloc(n);
+		scratchCapacity = n;
+	}
+	return scratch;
+}
+
+void EJsonParser::fail(es_uint32_t p, const char *msg) {
+	parsed = false;
+	throw EDataFormatException(__FILE__, __LINE__,
+			EString::formatOf("%s at offset %lld", msg, base + p).c_str());
+}
+
+EJsonValue EJsonParser::parse(const char *json) {
+	return parse(json, json ? (int)eso_strlen(json) : 0);
+}
+
+EJsonValue EJsonParser::parse(const char *json, int len) {
+	parse(json, len, (EJsonHandler*)null);
+	parsed = true;
+	return EJsonValue(this, 0, -1);
+}
+
+void EJsonParser::parse(const char *json, int len, EJsonHandler *handler) {
+	ES_ASSERT(len >= 0);
+
+	parsed = false;
+	base = 0;
+	reserveText(len);
+	memcpy(text, json, len);
+	memset(text + len, 0, ES_JSON_BLOCK_SIZE);
+	textLength = len;
+
+	if (!eso_strsimd_utf8_valid(text, len)) {
+		fail(utf8_boundary(text, 0, len), "invalid utf-8");
+	}
+
+	// stage 1
+	es_json_scanner_t scanner;
+	eso_json_scanner_init(&scanner);
+	reservePositions(len + 1);
+	count = (int)eso_json_index(&scanner, text, len, 0, positions);
+	if (!eso_json_scanner_ok(&scanner)) {
+		fail(control_offset(text, len), "control character");
+	}
+	if (scanner.in_string) {
+		fail(count > 0 ? positions[count - 1] : 0, "unterminated string");
+	}
+	positions[count] = len;
+
+	// stage 2
+	state = S_VALUE;
+	depth = 0;
+	walk(0, count, handler);
+	finish(handler);
+}
+
+void EJsonParser::parse(EInputStream *is, EJsonHandler *handler) {
+	ES_ASSERT(is);
+	ES_ASSERT(handler);
+
+	es_json_scanner_t scanner;
+	eso_json_scanner_init(&scanner);
+
+	parsed = false;
+	base = 0;
+	textLength = 0;
+	count = 0;
+	state = S_VALUE;
+	depth = 0;
+
+	int scanned = 0;   // the text before is indexed
+	int validated = 0; // the text before is valid utf-8
+	for (;;) {
+		// keep the text from the pending position on
+		int from = ES_MIN((count > 0) ? (int)positions[0] : scanned, validated);
+		if (from > 0) {
+			memmove(text, text + from, textLength - from);
+			textLength -= from;
+			scanned -= from;
+			validated -= from;
+			base += from;
+			for (int k = 0; k < count; k++) {
+				positions[k] -= from;
+			}
+		}
+
+		reserveText(textLength + JSON_STREAM_BLOCK);
+		int n = is->read(text + textLength, JSON_STREAM_BLOCK);
+		boolean eof = (n <= 0);
+		if (!eof) {
+			textLength += n;
+		}
+
+		int end = eof ? textLength : utf8_boundary(text, validated, textLength);
+		if (!eso_strsimd_utf8_valid(text + validated, end - validated)) {
+			fail(validated, "invalid utf-8");
+		}
+		validated = end;
+
+		// the pieces but the last one are whole blocks
+		int m = textLength - scanned;
+		if (!eof) {
+			m &= ~(ES_JSON_BLOCK_SIZE - 1);
+		}
+		reservePositions(count + m + 1);
+		count += (int)eso_json_index(&scanner, text + scanned, m, scanned, positions + count);
+		scanned += m;
+		if (!eso_json_scanner_ok(&scanner)) {
+			fail(scanned - m, "control character");
+		}
+
+		if (eof) {
+			if (scanner.in_string) {
+				fail(count > 0 ? positions[count - 1] : 0, "unterminated string");
+			}
+			memset(text + textLength, 0, ES_JSON_BLOCK_SIZE);
+			positions[count] = textLength;
+			walk(0, count, handler);
+			finish(handler);
+			break;
+		}
+
+		// a token ends before the next position, so the last one waits
+		if (count > 1) {
+			walk(0, count - 1, handler);
+			positions[0] = positions[count - 1];
+			count = 1;
+		}
+	}
+}
+
+EJsonValue EJsonParser::root() {
+	return parsed ? EJsonValue(this, 0, -1) : EJsonValue();
+}
+
+int EJsonParser::structurals() {
+	return parsed ? count : 0;
+}
+
+void EJsonParser::walk(int from, int to, EJsonHandler *handler) {
+	const char *t = text;
+	const es_uint32_t *idx = positions;
+
+	for (int i = from; i < to; i++) {
+		es_uint32_t p = idx[i];
+		char c = t[p];
+
+		switch (state) {
+		case S_VALUE:
+			break;
+		case S_OBJECT_FIRST:
+			if (c == '}') {
+				popContainer(i, true, handler);
+				continue;
+			}
+			/* fall through */
+		case S_KEY:
+			if (c != '"') {
+				fail(p, "expected a member name");
+			}
+			emitString(p, idx[i + 1], true, handler);
+			state = S_COLON;
+			continue;
+		case S_COLON:
+			if (c != ':') {
+				fail(p, "expected ':'");
+			}
+			state = S_VALUE;
+			continue;
+		case S_OBJECT_NEXT:
+			if (c == ',') {
+				state = S_KEY;
+				continue;
+			}
+			if (c == '}') {
+				popContainer(i, true, handler);
+				continue;
+			}
+			fail(p, "expected ',' or '}'");
+			break;
+		case S_ARRAY_FIRST:
+			if (c == ']') {
+				popContainer(i, false, handler);
+				continue;
+			}
+			break;
+		case S_ARRAY_NEXT:
+			if (c == ',') {
+				state = S_VALUE;
+				continue;
+			}
+			if (c == ']') {
+				popContainer(i, false, handler);
+				continue;
+			}
+			fail(p, "expected ',' or ']'");
+			break;
+		default: //S_END
+			fail(p, "unexpected text after the document");
+			break;
+		}
+
+		// a value
+		switch (c) {
+		case '{':
+			pushContainer(i, true);
+			if (handler) handler->startObject();
+			state = S_OBJECT_FIRST;
+			continue;
+		case '[':
+			pushContainer(i, false);
+			if (handler) handler->startArray();
+			state = S_ARRAY_FIRST;
+			continue;
+		case '"':
+			emitString(p, idx[i + 1], false, handler);
+			break;
+		case 't':
+			if (idx[i + 1] - p < 4 || memcmp(t + p, "true", 4) != 0 || !is_delimiter(t[p + 4])) {
+				fail(p, "bad literal");
+			}
+			if (handler) handler->booleanValue(true);
+			break;
+		case 'f':
+			if (idx[i + 1] - p < 5 || memcmp(t + p, "false", 5) != 0 || !is_delimiter(t[p + 5])) {
+				fail(p, "bad literal");
+			}
+			if (handler) handler->booleanValue(false);
+			break;
+		case 'n':
+			if (idx[i + 1] - p < 4 || memcmp(t + p, "null", 4) != 0 || !is_delimiter(t[p + 4])) {
+				fail(p, "bad literal");
+			}
+			if (handler) handler->nullValue();
+			break;
+		default: {
+			int e = numberEnd(t, p);
+			if (e < 0 || !is_delimiter(t[e])) {
+				fail(p, "bad value");
+			}
+			if (handler) handler->number(t + p, e - p);
+			break;
+		}
+		}
+
+		state = (depth == 0) ? S_END : ((stack[depth - 1] & 1) ? S_OBJECT_NEXT : S_ARRAY_NEXT);
+	}
+}
+
+void EJsonParser::pushContainer(int i, boolean object) {
+	if (depth == MAX_DEPTH) {
+		fail(positions[i], "too deep");
+	}
+	stack[depth++] = (i << 1) | (object ? 1 : 0);
+}
+
+void EJsonParser::popContainer(int i, boolean object, EJsonHandler *handler) {
+	// the states of the closing bracket ensure the kind of the container
+	int open = stack[--depth];
+	if (handler) {
+		if (object) handler->endObject();
+		else handler->endArray();
+	} else {
+		match[open >> 1] = i;
+	}
+	state = (depth == 0) ? S_END : ((stack[depth - 1] & 1) ? S_OBJECT_NEXT : S_ARRAY_NEXT);
+}
+
+void EJsonParser::emitString(es_uint32_t p, es_uint32_t q, boolean isKey, EJsonHandler *handler) {
+	// checked without a handler too, the tree is read lazily but not trusted
+	int e = stringEnd(text, p, q);
+	if (e < 0) {
+		fail(p, "unterminated string");
+	}
+	const char *s = text + p + 1;
+	int len = e - p - 1;
+	if (memchr(s, '\\', len)) {
+		char *out = reserveScratch(len);
+		len = unescape(s, len, out);
+		if (len < 0) {
+			fail(p, "bad escape");
+		}
+		s = out;
+	}
+	if (!handler) {
+		return;
+	}
+	if (isKey) handler->key(s, len);
+	else handler->string(s, len);
+}
+
+void EJsonParser::finish(EJsonHandler *handler) {
+	if (state != S_END) {
+		fail(textLength, (state == S_VALUE && depth == 0) ? "empty document" : "unexpected end");
+	}
+}
+
+int EJsonParser::stringEnd(const char *text, es_uint32_t p, es_uint32_t q) {
+	// only whitespace may be between the closing quote and the next position
+	int j = (int)q - 1;
+	while (j > (int)p && is_ws(text[j])) {
+		j--;
+	}
+	return (j > (int)p && text[j] == '"') ? j : -1;
+}
+
+int EJsonParser::numberEnd(const char *text, es_uint32_t p) {
+	const char *s = text + p;
+	int i = 0;
+
+	if (s[i] == '-') {
+		i++;
+	}
+	if (s[i] == '0') {
+		i++;
+	} else if (s[i] >= '1' && s[i] <= '9') {
+		do { i++; } while (is_digit(s[i]));
+	} else {
+		return -1;
+	}
+	if (s[i] == '.') {
+		i++;
+		if (!is_digit(s[i])) return -1;
+		do { i++; } while (is_digit(s[i]));
+	}
+	if (s[i] == 'e' || s[i] == 'E') {
+		i++;
+		if (s[i] == '+' || s[i] == '-') i++;
+		if (!is_digit(s[i])) return -1;
+		do { i++; } while (is_digit(s[i]));
+	}
+	return p + i;
+}
+
+int EJsonParser::unescape(const char *s, int len, char *out) {
+	const char *e = s + len;
+	char *o = out;
+
+	while (s < e) {
+		const char *b = (const char*)memchr(s, '\\', e - s);
+		if (!b) {
+			memcpy(o, s, e - s);
+			o += e - s;
+			break;
+		}
+		memcpy(o, s, b - s);
+		o += b - s;
+		s = b + 1;
+		if (s >= e) {
+			return -1;
+		}
+		switch (*s++) {
+		case '"': *o++ = '"'; break;
+		case '\\': *o++ = '\\'; break;
+		case '/': *o++ = '/'; break;
+		case 'b': *o++ = '\b'; break;
+		case 'f': *o++ = '\f'; break;
+		case 'n': *o++ = '\n'; break;
+		case 'r': *o++ = '\r'; break;
+		case 't': *o++ = '\t'; break;
+		case 'u': {
+			int cp = (e - s >= 4) ? hex4(s) : -1;
+			if (cp < 0) {
+				return -1;
+			}
+			s += 4;
+			if (cp >= 0xD800 && cp <= 0xDBFF) {
+				int lo = (e - s >= 6 && s[0] == '\\' && s[1] == 'u') ? hex4(s + 2) : -1;
+				if (lo < 0xDC00 || lo > 0xDFFF) {
+					return -1;
+				}
+				cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+				s += 6;
+			} else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+				return -1;
+			}
+			if (cp < 0x80) {
+				*o++ = (char)cp;
+			} else if (cp < 0x800) {
+				*o++ = (char)(0xC0 | (cp >> 6));
+				*o++ = (char)(0x80 | (cp & 0x3F));
+			} else if (cp < 0x10000) {
+				*o++ = (char)(0xE0 | (cp >> 12));
+				*o++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+				*o++ = (char)(0x80 | (cp & 0x3F));
+			} else {
+				*o++ = (char)(0xF0 | (cp >> 18));
+				*o++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+				*o++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+				*o++ = (char)(0x80 | (cp & 0x3F));
+			}
+			break;
+		}
+		default:
+			return -1;
+		}
+	}
+	return (int)(o - out);
+}
+
+} /* namespace efc */
@@ -0,0 +1,376 @@
+/*
+ * EJsonValue.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "EJsonValue.hh"
+#include "EJsonParser.hh"
+#include "ELLong.hh"
+#include "EDouble.hh"
+#include "EInteger.hh"
+
+namespace efc {
+
+EJsonValue::~EJsonValue() {
+}
+
+EJsonValue::EJsonValue() :
+		doc(null), pos(-1), keyPos(-1) {
+}
+
+EJsonValue::EJsonValue(EJsonParser *doc, int pos, int keyPos) :
+		doc(doc), pos(pos), keyPos(keyPos) {
+}
+
+char EJsonValue::firstChar() {
+	return doc->text[doc->positions[pos]];
+}
+
+/* the position after the value, a comma or a closing bracket in a container */
+int EJsonValue::skip(int i) {
+	char c = doc->text[doc->positions[i]];
+	return (c == '{' || c == '[') ? (int)doc->match[i] + 1 : i + 1;
+}
+
+int EJsonValue::endOffset() {
+	const char *t = doc->text;
+	int p = doc->positions[pos];
+	switch (t[p]) {
+	case '{':
+	case '[':
+		return doc->positions[doc->match[pos]] + 1;
+	case '"':
+		return EJsonParser::stringEnd(t, p, doc->positions[pos + 1]) + 1;
+	case 't':
+	case 'n':
+		return p + 4;
+	case 'f':
+		return p + 5;
+	default:
+		return EJsonParser::numberEnd(t, p);
+	}
+}
+
+EJsonValue::Type EJsonValue::type() {
+	if (pos < 0) {
+		return TYPE_UNDEFINED;
+	}
+	switch (firstChar()) {
+	case '{': return TYPE_OBJECT;
+	case '[': return TYPE_ARRAY;
+	case '"': return TYPE_STRING;
+	case 't':
+	case 'f': return TYPE_BOOLEAN;
+	case 'n': return TYPE_NULL;
+	default: return TYPE_NUMBER;
+	}
+}
+
+boolean EJsonValue::isUndefined() {
+	return pos < 0;
+}
+
+boolean EJsonValue::isNull() {
+	return pos >= 0 && firstChar() == 'n';
+}
+
+boolean EJsonValue::isBoolean() {
+	return type() == TYPE_BOOLEAN;
+}
+
+boolean EJsonValue::isNumber() {
+	return type() == TYPE_NUMBER;
+}
+
+boolean EJsonValue::isString() {
+	return pos >= 0 && firstChar() == '"';
+}
+
+boolean EJsonValue::isArray() {
+	return pos >= 0 && firstChar() == '[';
+}
+
+boolean EJsonValue::isObject() {
+	return pos >= 0 && firstChar() == '{';
+}
+
+EJsonValue EJsonValue::get(const char *key) {
+	if (!isObject() || !key) {
+		return EJsonValue();
+	}
+
+	const char *t = doc->text;
+	const es_uint32_t *idx = doc->positions;
+	int klen = eso_strlen(key);
+	boolean slash = (eso_strchr(key, '\\') != null);
+
+	int i = pos + 1;
+	if (t[idx[i]] == '}') {
+		return EJsonValue();
+	}
+	for (;;) {
+		// i: the name, i + 1: the colon, i + 2: the value
+		const char *s = t + idx[i] + 1;
+		int len = EJsonParser::stringEnd(t, idx[i], idx[i + 1]) - idx[i] - 1;
+		if (len == klen && !slash) {
+			if (memcmp(s, key, klen) == 0) {
+				return EJsonValue(doc, i + 2, i);
+			}
+		} else if (len > klen || slash) {
+			// escaped names are longer than unescaped
+			if (memchr(s, '\\', len)) {
+				char *out = doc->reserveScratch(len);
+				int n = EJsonParser::unescape(s, len, out);
+				if (n < 0) {
+					throw EDataFormatException(__FILE__, __LINE__,
+							EString::formatOf("bad escape at offset %d", idx[i]).c_str());
+				}
+				if (n == klen && memcmp(out, key, klen) == 0) {
+					return EJsonValue(doc, i + 2, i);
+				}
+			}
+		}
+		int j = skip(i + 2);
+		if (t[idx[j]] != ',') {
+			return EJsonValue();
+		}
+		i = j + 1;
+	}
+}
+
+EJsonValue EJsonValue::get(int index) {
+	if (!isArray() || index < 0) {
+		return EJsonValue();
+	}
+
+	const char *t = doc->text;
+	const es_uint32_t *idx = doc->positions;
+
+	int i = pos + 1;
+	if (t[idx[i]] == ']') {
+		return EJsonValue();
+	}
+	for (;;) {
+		if (index-- == 0) {
+			return EJsonValue(doc, i, -1);
+		}
+		int j = skip(i);
+		if (t[idx[j]] != ',') {
+			return EJsonValue();
+		}
+		i = j + 1;
+	}
+}
+
+EJsonValue EJsonValue::operator[](const char *key) {
+	return get(key);
+}
+
+EJsonValue EJsonValue::operator[](int index) {
+	return get(index);
+}
+
+boolean EJsonValue::has(const char *key) {
+	return get(key).pos >= 0;
+}
+
+int EJsonValue::size() {
+	int n = 0;
+	for (EJsonValue v = first(); v.pos >= 0; v = v.next()) {
+		n++;
+	}
+	return n;
+}
+
+EJsonValue EJsonValue::first() {
+	if (pos < 0) {
+		return EJsonValue();
+	}
+	char c = firstChar();
+	char e = doc->text[doc->positions[pos + 1]];
+	if (c == '[' && e != ']') {
+		return EJsonValue(doc, pos + 1, -1);
+	}
+	if (c == '{' && e != '}') {
+		return EJsonValue(doc, pos + 3, pos + 1);
+	}
+	return EJsonValue();
+}
+
+EJsonValue EJsonValue::next() {
+	if (pos < 0) {
+		return EJsonValue();
+	}
+	int j = skip(pos);
+	if (doc->text[doc->positions[j]] != ',') {
+		return EJsonValue();
+	}
+	return (keyPos >= 0) ? EJsonValue(doc, j + 3, j + 1) : EJsonValue(doc, j + 1, -1);
+}
+
+EString EJsonValue::key() {
+	if (keyPos < 0) {
+		throw EIllegalStateException(__FILE__, __LINE__, "not a member");
+	}
+	return EJsonValue(doc, keyPos, -1).getString();
+}
+
+const char* EJsonValue::rawKey(int *len) {
+	if (keyPos < 0) {
+		*len = 0;
+		return null;
+	}
+	int p = doc->positions[keyPos];
+	*len = EJsonParser::stringEnd(doc->text, p, doc->positions[keyPos + 1]) - p - 1;
+	return doc->text + p + 1;
+}
+
+EString EJsonValue::getString() {
+	if (pos < 0) {
+		throw ENoSuchElementException(__FILE__, __LINE__);
+	}
+	if (firstChar() != '"') {
+		int len;
+		const char *s = raw(&len);
+		return EString(s, len);
+	}
+
+	const char *t = doc->text;
+	int p = doc->positions[pos];
+	const char *s = t + p + 1;
+	int len = EJsonParser::stringEnd(t, p, doc->positions[pos + 1]) - p - 1;
+	if (!memchr(s, '\\', len)) {
+		return EString(s, len);
+	}
+	char *out = doc->reserveScratch(len);
+	int n = EJsonParser::unescape(s, len, out);
+	if (n < 0) {
+		throw EDataFormatException(__FILE__, __LINE__,
+				EString::formatOf("bad escape at offset %d", p).c_str());
+	}
+	return EString(out, n);
+}
+
+llong EJsonValue::getLLong() {
+	if (pos < 0) {
+		throw ENoSuchElementException(__FILE__, __LINE__);
+	}
+
+	char c = firstChar();
+	if (c == '"') {
+		return ELLong::parseLLong(getString().c_str());
+	}
+	if (c != '-' && (c < '0' || c > '9')) {
+		throw ENumberFormatException(__FILE__, __LINE__, "not a number");
+	}
+
+	const char *s = doc->text + doc->positions[pos];
+	boolean neg = (*s == '-');
+	if (neg) {
+		s++;
+	}
+	ullong v = 0;
+	while (*s >= '0' && *s <= '9') {
+		ullong d = *s++ - '0';
+		if (v > (ULLONG(0x7FFFFFFFFFFFFFFF) - d) / 10) {
+			// overflow, or the min value
+			int len;
+			const char *r = raw(&len);
+			return ELLong::parseLLong(EString(r, len).c_str());
+		}
+		v = v * 10 + d;
+	}
+	if (*s == '.' || *s == 'e' || *s == 'E') {
+		return (llong)getDouble();
+	}
+	return neg ? -(llong)v : (llong)v;
+}
+
+int EJsonValue::getInt() {
+	llong v = getLLong();
+	if (v < EInteger::MIN_VALUE || v > EInteger::MAX_VALUE) {
+		throw ENumberFormatException(__FILE__, __LINE__, "out of int range");
+	}
+	return (int)v;
+}
+
+double EJsonValue::getDouble() {
+	if (pos < 0) {
+		throw ENoSuchElementException(__FILE__, __LINE__);
+	}
+
+	char c = firstChar();
+	if (c == '"') {
+		return EDouble::parseDouble(getString().c_str());
+	}
+	if (c != '-' && (c < '0' || c > '9')) {
+		throw ENumberFormatException(__FILE__, __LINE__, "not a number");
+	}
+	return eso_parse_double(doc->text + doc->positions[pos], null);
+}
+
+boolean EJsonValue::getBoolean() {
+	if (pos < 0) {
+		throw ENoSuchElementException(__FILE__, __LINE__);
+	}
+
+	char c = firstChar();
+	if (c == 't') return true;
+	if (c == 'f') return false;
+	throw EIllegalStateException(__FILE__, __LINE__, "not a boolean");
+}
+
+EString EJsonValue::getString(const char *defaultValue) {
+	if (pos < 0 || firstChar() == 'n') {
+		return EString(defaultValue);
+	}
+	return getString();
+}
+
+llong EJsonValue::getLLong(llong defaultValue) {
+	if (pos < 0 || firstChar() == 'n') {
+		return defaultValue;
+	}
+	return getLLong();
+}
+
+int EJsonValue::getInt(int defaultValue) {
+	if (pos < 0 || firstChar() == 'n') {
+		return defaultValue;
+	}
+	return getInt();
+}
+
+double EJsonValue::getDouble(double defaultValue) {
+	if (pos < 0 || firstChar() == 'n') {
+		return defaultValue;
+	}
+	return getDouble();
+}
+
+boolean EJsonValue::getBoolean(boolean defaultValue) {
+	if (pos < 0 || firstChar() == 'n') {
+		return defaultValue;
+	}
+	return getBoolean();
+}
+
+const char* EJsonValue::raw(int *len) {
+	if (pos < 0) {
+		if (len) *len = 0;
+		return null;
+	}
+	int p = doc->positions[pos];
+	if (len) *len = endOffset() - p;
+	return doc->text + p;
+}
+
+EString EJsonValue::toString() {
+	int len;
+	const char *s = raw(&len);
+	return s ? EString(s, len) : EString("undefined");
+}
+
+} /* namespace efc */
@@ -0,0 +1,198 @@
+/*
+ * EJsonWriter.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "EJsonWriter.hh"
+
+namespace efc {
+
+/*
+ * 0: as is, 'u': \u00XX, others: the letter after the backslash.
+ */
+static const char escapes[256] = {
+	'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+	'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+	0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+	/* the rest are 0 */
+};
+
+static const char hexdigits[] = "0123456789abcdef";
+
+EJsonWriter::~EJsonWriter() {
+	flush();
+}
+
+EJsonWriter::EJsonWriter(EByteArrayOutputStream *out) :
+		out(out), pos(0), comma(false) {
+	ES_ASSERT(out);
+}
+
+void EJsonWriter::flush() {
+	if (pos > 0) {
+		out->write(buf, pos);
+		pos = 0;
+	}
+}
+
+void EJsonWriter::put(const char *s, int len) {
+	if (pos + len > (int)sizeof(buf)) {
+		flush();
+		if (len > (int)sizeof(buf)) {
+			out->write(s, len);
+			return;
+		}
+	}
+	memcpy(buf + pos, s, len);
+	pos += len;
+}
+
+void EJsonWriter::separate() {
+	if (comma) {
+		if (pos == sizeof(buf)) flush();
+		buf[pos++] = ',';
+	}
+	comma = true;
+}
+
+void EJsonWriter::putString(const char *s, int len) {
+	const es_uint8_t *p = (const es_uint8_t*)s;
+	const es_uint8_t *e = p + len;
+
+	put("\"", 1);
+	while (p < e) {
+		const es_uint8_t *r = p;
+		while (r < e && !escapes[*r]) {
+			r++;
+		}
+		if (r > p) {
+			put((const char*)p, r - p);
+		}
+		if (r == e) {
+			break;
+		}
+		char c = escapes[*r];
+		if (c == 'u') {
+			char u[6] = {'\\', 'u', '0', '0', hexdigits[*r >> 4], hexdigits[*r & 0xF]};
+			put(u, 6);
+		} else {
+			char x[2] = {'\\', c};
+			put(x, 2);
+		}
+		p = r + 1;
+	}
+	put("\"", 1);
+}
+
+EJsonWriter& EJsonWriter::startObject() {
+	separate();
+	put("{", 1);
+	comma = false;
+	return *this;
+}
+
+EJsonWriter& EJsonWriter::endObject() {
+	put("}", 1);
+	comma = true;
+	return *this;
+}
+
+EJsonWriter& EJsonWriter::startArray() {
+	separate();
+	put("[", 1);
+	comma = false;
+	return *this;
+}
+
+EJsonWriter& EJsonWriter::endArray() {
+	put("]", 1);
+	comma = true;
+	return *this;
+}
+
+EJsonWriter& EJsonWriter::key(const char *name, int len) {
+	ES_ASSERT(name);
+	separate();
+	putString(name, (len < 0) ? eso_strlen(name) : len);
+	put(":", 1);
+	comma = false;
+	return *this;
+}
+
+EJsonWriter& EJsonWriter::value(const char *s, int len) {
+	if (!s) {
+		return nullValue();
+	}
+	separate();
+	putString(s, (len < 0) ? eso_strlen(s) : len);
+	return *this;
+}
+
+EJsonWriter& EJsonWriter::value(const EString& s) {
+	EString& r = (EString&)s;
+	return value(r.c_str(), r.length());
+}
+
+EJsonWriter& EJsonWriter::value(int v) {
+	return value((llong)v);
+}
+
+EJsonWriter& EJsonWriter::value(llong v) {
+	char tmp[24];
+	char *p = tmp + sizeof(tmp);
+	ullong u = (v < 0) ? (ullong)0 - (ullong)v : (ullong)v;
+
+	do {
+		*--p = (char)('0' + (u % 10));
+		u /= 10;
+	} while (u);
+	if (v < 0) {
+		*--p = '-';
+	}
+	separate();
+	put(p, (int)(tmp + sizeof(tmp) - p));
+	return *this;
+}
+
+EJsonWriter& EJsonWriter::value(double v) {
+	char tmp[ES_DTOA_BUFSIZE];
+	int n = eso_dtoa_shortest(v, tmp);
+	if (tmp[0] == 'N' || tmp[n - 1] == 'y') {
+		// NaN, Infinity
+		return nullValue();
+	}
+	separate();
+	put(tmp, n);
+	return *this;
+}
+
+EJsonWriter& EJsonWriter::value(boolean v) {
+	separate();
+	if (v) put("true", 4);
+	else put("false", 5);
+	return *this;
+}
+
+EJsonWriter& EJsonWriter::value(const EJsonValue& v) {
+	int len;
+	const char *s = ((EJsonValue&)v).raw(&len);
+	if (!s) {
+		return nullValue();
+	}
+	separate();
+	put(s, len);
+	return *this;
+}
+
+EJsonWriter& EJsonWriter::nullValue() {
+	separate();
+	put("null", 4);
+	return *this;
+}
+
+} /* namespace efc */
@@ -0,0 +1,252 @@
+/*
+ * ELZ4InputStream.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "ELZ4InputStream.hh"
+#include <limits.h>
+
+namespace efc {
+
+#define HISTORY_SIZE (64 * 1024)
+
+static es_uint32_t le32(const byte* p) {
+	const es_uint8_t* u = (const es_uint8_t*)p;
+	return (es_uint32_t)u[0] | ((es_uint32_t)u[1] << 8) |
+			((es_uint32_t)u[2] << 16) | ((es_uint32_t)u[3] << 24);
+}
+
+ELZ4InputStream::~ELZ4InputStream() {
+	delete _buf;
+	delete _cbuf;
+}
+
+ELZ4InputStream::ELZ4InputStream(EInputStream* in, boolean owned) :
+		EFilterInputStream(in, owned), _buf(null), _cbuf(null), _pos(0),
+		_limit(0), _history(0), _produced(0), _eof(false), _closed(false) {
+	boolean found;
+	try {
+		found = readHeader();
+	} catch (...) {
+		delete _buf;
+		delete _cbuf;
+		throw;
+	}
+	if (!found) {
+		delete _buf;
+		delete _cbuf;
+		throw EEOFException(__FILE__, __LINE__);
+	}
+}
+
+int ELZ4InputStream::read(void* b, int len) {
+	ES_ASSERT(b);
+	ES_ASSERT(len >= 0);
+
+	ensureOpen();
+	if (len == 0) {
+		return 0;
+	}
+	if (_pos == _limit && !fill()) {
+		return -1;
+	}
+	int n = ES_MIN(len, _limit - _pos);
+	memcpy(b, _buf->address() + _pos, n);
+	_pos += n;
+	return n;
+}
+
+int ELZ4InputStream::read() {
+	return EInputStream::read();
+}
+
+long ELZ4InputStream::skip(long n) {
+	ensureOpen();
+	long total = 0;
+	while (total < n) {
+		if (_pos == _limit && !fill()) {
+			break;
+		}
+		int k = (int)ES_MIN(n - total, (long)(_limit - _pos));
+		_pos += k;
+		total += k;
+	}
+	return total;
+}
+
+long ELZ4InputStream::available() {
+	ensureOpen();
+	return _limit - _pos;
+}
+
+void ELZ4InputStream::close() {
+	if (!_closed) {
+		_in->close();
+		_closed = true;
+	}
+}
+
+void ELZ4InputStream::ensureOpen() {
+	if (_closed) {
+		throw EIOException(__FILE__, __LINE__, "Stream closed");
+	}
+}
+
+boolean ELZ4InputStream::fill() {
+	while (!_eof) {
+		if (readBlock()) {
+			if (_pos < _limit) {
+				return true;
+			}
+		} else if (!readHeader()) {
+			_eof = true;
+		}
+	}
+	return false;
+}
+
+int ELZ4InputStream::readFully(void* b, int len) {
+	int n = 0;
+	while (n < len) {
+		int r = _in->read((byte*)b + n, len - n);
+		if (r <= 0) {
+			break;
+		}
+		n += r;
+	}
+	return n;
+}
+
+boolean ELZ4InputStream::readHeader() {
+	for (;;) {
+		byte h[ES_LZ4_FRAME_HEADER_MAX];
+		int have = readFully(h, 4);
+		if (have == 0) {
+			return false; // no more frames
+		}
+		if (have < 4) {
+			throw EEOFException(__FILE__, __LINE__);
+		}
+
+		// the descriptor length depends on its flags, it comes by bytes
+		int r;
+		while ((r = eso_lz4f_read_header(h, have, &_info)) == 0) {
+			if (readFully(h + have, 1) < 1) {
+				throw EEOFException(__FILE__, __LINE__);
+			}
+			have++;
+		}
+		if (r < 0) {
+			throw EIOException(__FILE__, __LINE__,
+					(have == 4) ? "Not in LZ4 format" : "Corrupt LZ4 header");
+		}
+
+		if (_info.block_size == 0) {
+			// a skippable frame
+			llong left = _info.content_size;
+			while (left > 0) {
+				long k = _in->skip((long)ES_MIN(left, (llong)LONG_MAX));
+				if (k <= 0) {
+					if (_in->read() < 0) {
+						throw EEOFException(__FILE__, __LINE__);
+					}
+					k = 1;
+				}
+				left -= k;
+			}
+			continue;
+		}
+		if (_info.dict_id != 0) {
+			throw EIOException(__FILE__, __LINE__, "Unsupported LZ4 dictionary");
+		}
+
+		int size = _info.block_size + (_info.block_linked ? HISTORY_SIZE : 0);
+		if (!_buf || _buf->length() < size) {
+			delete _buf;
+			_buf = new EA<byte>(size);
+		}
+		if (!_cbuf || _cbuf->length() < _info.block_size + 4) {
+			delete _cbuf;
+			_cbuf = new EA<byte>(_info.block_size + 4);
+		}
+		_pos = _limit = 0;
+		_history = 0;
+		_produced = 0;
+		eso_xxh32_init(&_hash, 0);
+		return true;
+	}
+}
+
+boolean ELZ4InputStream::readBlock() {
+	byte s[4];
+	if (readFully(s, 4) < 4) {
+		throw EEOFException(__FILE__, __LINE__);
+	}
+	es_uint32_t size = le32(s);
+	if (size == 0) {
+		readTrailer();
+		return false;
+	}
+
+	int n = (int)(size & 0x7FFFFFFF);
+	int tail = _info.block_checksum ? 4 : 0;
+	if (n > _info.block_size) {
+		throw EIOException(__FILE__, __LINE__, "Corrupt LZ4 block");
+	}
+	byte* c = _cbuf->address();
+	if (readFully(c, n + tail) < n + tail) {
+		throw EEOFException(__FILE__, __LINE__);
+	}
+	if (tail && eso_xxh32(c, n, 0) != le32(c + n)) {
+		throw EIOException(__FILE__, __LINE__, "Corrupt LZ4 block checksum");
+	}
+
+	byte* d = _buf->address();
+	int base = 0;
+	if (_info.block_linked) {
+		// keeps the last 64KB of the output just before the block
+		base = HISTORY_SIZE;
+		if (_limit > base) {
+			int keep = ES_MIN(HISTORY_SIZE, _history + (_limit - base));
+			memmove(d + base - keep, d + _limit - keep, keep);
+			_history = keep;
+		}
+	}
+	int r;
+	if (size & 0x80000000U) {
+		memcpy(d + base, c, n);
+		r = n;
+	} else {
+		r = eso_lz4_decompress_dict(c, n, d + base, _info.block_size,
+				d + base - _history, _history);
+		if (r < 0) {
+			throw EIOException(__FILE__, __LINE__, "Corrupt LZ4 block");
+		}
+	}
+	if (_info.content_checksum) {
+		eso_xxh32_update(&_hash, d + base, r);
+	}
+	_produced += r;
+	_pos = base;
+	_limit = base + r;
+	return true;
+}
+
+void ELZ4InputStream::readTrailer() {
+	if (_info.content_checksum) {
+		byte t[4];
+		if (readFully(t, 4) < 4) {
+			throw EEOFException(__FILE__, __LINE__);
+		}
+		if (le32(t) != eso_xxh32_digest(&_hash)) {
+			throw EIOException(__FILE__, __LINE__, "Corrupt LZ4 content checksum");
+		}
+	}
+	if (_info.content_size >= 0 && _info.content_size != _produced) {
+		throw EIOException(__FILE__, __LINE__, "Corrupt LZ4 content size");
+	}
+}
+
+} /* namespace efc */
@@ -0,0 +1,136 @@
+/*
+ * ELZ4OutputStream.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "ELZ4OutputStream.hh"
+
+namespace efc {
+
+ELZ4OutputStream::~ELZ4OutputStream() {
+	delete _buf;
+	delete _cbuf;
+}
+
+ELZ4OutputStream::ELZ4OutputStream(EOutputStream* out, int blockSize,
+		int acceleration, boolean owned) :
+		EFilterOutputStream(out, owned), _count(0),
+		_acceleration(acceleration), _started(false), _finished(false) {
+	_blockSize = 1 << (8 + 2 * eso_lz4f_block_id(blockSize));
+	_buf = new EA<byte>(_blockSize);
+	_cbuf = new EA<byte>(4 + _blockSize);
+	eso_xxh32_init(&_hash, 0);
+}
+
+void ELZ4OutputStream::write(const void* b, int len) {
+	ES_ASSERT(b); ES_ASSERT(len >= 0);
+
+	if (_finished) {
+		throw EIOException(__FILE__, __LINE__, "write beyond end of stream");
+	}
+	const byte* p = (const byte*)b;
+	while (len > 0) {
+		if (_count == 0 && len >= _blockSize) {
+			// a whole block, no copy
+			writeBlock(p, _blockSize);
+			p += _blockSize;
+			len -= _blockSize;
+			continue;
+		}
+		int n = ES_MIN(len, _blockSize - _count);
+		memcpy(_buf->address() + _count, p, n);
+		_count += n;
+		p += n;
+		len -= n;
+		if (_count == _blockSize) {
+			writeBlock(_buf->address(), _count);
+			_count = 0;
+		}
+	}
+}
+
+void ELZ4OutputStream::write(const char *s) {
+	EOutputStream::write(s);
+}
+
+void ELZ4OutputStream::write(int b) {
+	EOutputStream::write(b);
+}
+
+void ELZ4OutputStream::finish() {
+	if (_finished) {
+		return;
+	}
+	if (_count > 0) {
+		writeBlock(_buf->address(), _count);
+		_count = 0;
+	} else if (!_started) {
+		writeHeader();
+	}
+	// the end mark and the content checksum
+	es_uint8_t end[8] = {0};
+	es_uint32_t h = eso_xxh32_digest(&_hash);
+	end[4] = (es_uint8_t)h;
+	end[5] = (es_uint8_t)(h >> 8);
+	end[6] = (es_uint8_t)(h >> 16);
+	end[7] = (es_uint8_t)(h >> 24);
+	_out->write(end, 8);
+	_finished = true;
+}
+
+void ELZ4OutputStream::close() {
+	if (!closed) {
+		finish();
+		_out->close();
+		closed = true;
+	}
+}
+
+void ELZ4OutputStream::flush() {
+	if (!_finished && _count > 0) {
+		writeBlock(_buf->address(), _count);
+		_count = 0;
+	}
+	_out->flush();
+}
+
+void ELZ4OutputStream::writeHeader() {
+	es_lz4f_info_t info;
+	info.block_size = _blockSize;
+	info.block_linked = false;
+	info.block_checksum = false;
+	info.content_checksum = true;
+	info.content_size = -1;
+	info.dict_id = 0;
+
+	byte header[ES_LZ4_FRAME_HEADER_MAX];
+	int n = eso_lz4f_write_header(header, &info);
+	_out->write(header, n);
+	_started = true;
+}
+
+void ELZ4OutputStream::writeBlock(const void* b, int len) {
+	if (!_started) {
+		writeHeader();
+	}
+	eso_xxh32_update(&_hash, b, len);
+
+	// stored if it doesn't shrink
+	es_uint8_t* c = (es_uint8_t*)_cbuf->address();
+	int n = eso_lz4_compress(b, len, c + 4, len - 1, _acceleration);
+	es_uint32_t size = n;
+	if (n <= 0) {
+		memcpy(c + 4, b, len);
+		n = len;
+		size = (es_uint32_t)len | 0x80000000U;
+	}
+	c[0] = (es_uint8_t)size;
+	c[1] = (es_uint8_t)(size >> 8);
+	c[2] = (es_uint8_t)(size >> 16);
+	c[3] = (es_uint8_t)(size >> 24);
+	_out->write(c, 4 + n);
+}
+
+} /* namespace efc */
@@ -0,0 +1,255 @@
+/*
+ * ELZMAInputStream.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "ELZMAInputStream.hh"
+#include "ERuntime.hh"
+#include "ENullPointerException.hh"
+#include "./concurrent/EExecutionException.hh"
+
+namespace efc {
+
+#define HEADER_SIZE       14
+#define BLOCK_HEADER_SIZE 12
+#define MIN_BLOCK_SIZE    (64 * 1024)
+#define MAX_BLOCK_SIZE    (256 * 1024 * 1024)
+
+static es_uint32_t get32(const es_uint8_t* p) {
+	return (es_uint32_t)p[0] | ((es_uint32_t)p[1] << 8) |
+			((es_uint32_t)p[2] << 16) | ((es_uint32_t)p[3] << 24);
+}
+
+/*
+ * A block read ahead, decompressed by the executor or by the caller.
+ */
+class ELZMAInputStream::Block: public ECallable<EA<byte> > {
+public:
+	sp<EFuture<EA<byte> > > future;
+	const char* error;
+
+	Block(sp<EA<byte> > data, int len, boolean stored, es_uint32_t crc,
+			const es_uint8_t* props) :
+			error(null), data(data), len(len), stored(stored), crc(crc) {
+		memcpy(this->props, props, sizeof(this->props));
+	}
+
+	virtual sp<EA<byte> > call() {
+		sp<EA<byte> > out = data;
+		data = null; // no longer needed
+		if (!stored) {
+			sp<EA<byte> > in = out;
+			es_size_t ulen = len;
+			es_size_t clen = in->length();
+			out = new EA<byte>(len);
+			if (eso_lzma_decompress(out->address(), &ulen, in->address(),
+					&clen, props) != ES_SZ_OK || (int)clen != in->length()) {
+				error = "Corrupt LZMA block";
+				return null;
+			}
+		}
+		if (eso_crc32_calc((byte*)out->address(), len) != crc) {
+			error = "Corrupt LZMA block checksum";
+			return null;
+		}
+		return out;
+	}
+
+private:
+	sp<EA<byte> > data;
+	int len;
+	boolean stored;
+	es_uint32_t crc;
+	es_uint8_t props[ES_LZMA_PROPS_SIZE];
+};
+
+ELZMAInputStream::~ELZMAInputStream() {
+	if (_pending) {
+		// the blocks not read are left to the executor
+		sp<Block> block;
+		while ((block = _pending->pollFirst()) != null) {
+			block->future = null;
+		}
+		delete _pending;
+	}
+}
+
+ELZMAInputStream::ELZMAInputStream(EInputStream* in, boolean owned) :
+		EFilterInputStream(in, owned), _executor(null), _maxPending(1),
+		_pending(null) {
+	init();
+}
+
+ELZMAInputStream::ELZMAInputStream(EInputStream* in,
+		EExecutorService* executor, boolean owned) :
+		EFilterInputStream(in, owned), _executor(executor), _pending(null) {
+	if (!executor) {
+		throw ENullPointerException(__FILE__, __LINE__);
+	}
+	_maxPending = ERuntime::getRuntime()->availableProcessors() * 2;
+	init();
+}
+
+void ELZMAInputStream::init() {
+	es_uint8_t header[HEADER_SIZE];
+	readFully(header, sizeof(header));
+	if (memcmp(header, "ELZM", 4) != 0 || header[4] != 1) {
+		throw EIOException(__FILE__, __LINE__, "Not in LZMA block format");
+	}
+	memcpy(_props, header + 5, sizeof(_props));
+	_blockSize = (int)get32(header + 10);
+	if (_blockSize < MIN_BLOCK_SIZE || _blockSize > MAX_BLOCK_SIZE) {
+		throw EIOException(__FILE__, __LINE__, "Corrupt LZMA header");
+	}
+	_chunkPos = 0;
+	_totalOut = 0;
+	_ended = false;
+	_eof = false;
+	_closed = false;
+	_pending = new EArrayDeque<sp<Block> >();
+}
+
+int ELZMAInputStream::read(void* b, int len) {
+	ES_ASSERT(b);
+	ES_ASSERT(len >= 0);
+
+	ensureOpen();
+	if (len == 0) {
+		return 0;
+	}
+	if ((_chunk == null || _chunkPos == _chunk->length()) && !fill()) {
+		return -1;
+	}
+	int n = ES_MIN(len, _chunk->length() - _chunkPos);
+	memcpy(b, (byte*)_chunk->address() + _chunkPos, n);
+	_chunkPos += n;
+	return n;
+}
+
+int ELZMAInputStream::read() {
+	return EInputStream::read();
+}
+
+long ELZMAInputStream::skip(long n) {
+	ensureOpen();
+	long total = 0;
+	while (total < n) {
+		if ((_chunk == null || _chunkPos == _chunk->length()) && !fill()) {
+			break;
+		}
+		int k = (int)ES_MIN(n - total, (long)(_chunk->length() - _chunkPos));
+		_chunkPos += k;
+		total += k;
+	}
+	return total;
+}
+
+long ELZMAInputStream::available() {
+	ensureOpen();
+	return (_chunk != null) ? _chunk->length() - _chunkPos : 0;
+}
+
+void ELZMAInputStream::close() {
+	if (!_closed) {
+		sp<Block> block;
+		while ((block = _pending->pollFirst()) != null) {
+			block->future = null;
+		}
+		_chunk = null;
+		_in->close();
+		_closed = true;
+	}
+}
+
+void ELZMAInputStream::ensureOpen() {
+	if (_closed) {
+		throw EIOException(__FILE__, __LINE__, "Stream closed");
+	}
+}
+
+boolean ELZMAInputStream::fill() {
+	_chunk = null;
+	while (!_eof) {
+		// reads ahead while the executor decompresses
+		while (!_ended && _pending->size() < _maxPending) {
+			sp<Block> block = readBlock();
+			if (block == null) {
+				_ended = true;
+				break;
+			}
+			if (_executor) {
+				block->future = _executor->submit<EA<byte> >(block);
+			}
+			_pending->addLast(block);
+		}
+
+		sp<Block> block = _pending->pollFirst();
+		if (block == null) {
+			_eof = true;
+			break;
+		}
+		_chunk = finish(block);
+		_chunkPos = 0;
+		return true;
+	}
+	return false;
+}
+
+sp<ELZMAInputStream::Block> ELZMAInputStream::readBlock() {
+	es_uint8_t h[BLOCK_HEADER_SIZE];
+	readFully(h, 4);
+	int len = (int)get32(h);
+	if (len == 0) {
+		readFully(h + 4, 8);
+		llong total = (llong)get32(h + 4) | ((llong)get32(h + 8) << 32);
+		if (total != _totalOut) {
+			throw EIOException(__FILE__, __LINE__, "Corrupt LZMA stream length");
+		}
+		return null;
+	}
+	readFully(h + 4, 8);
+	es_uint32_t size = get32(h + 4);
+	boolean stored = (size & 0x80000000U) != 0;
+	int n = (int)(size & 0x7FFFFFFF);
+	if (len < 0 || len > _blockSize || n == 0 || (stored ? n != len : n >= len)) {
+		throw EIOException(__FILE__, __LINE__, "Corrupt LZMA block");
+	}
+	sp<EA<byte> > data = new EA<byte>(n);
+	readFully(data->address(), n);
+	_totalOut += len;
+	return new Block(data, len, stored, get32(h + 8), _props);
+}
+
+sp<EA<byte> > ELZMAInputStream::finish(sp<Block> block) {
+	sp<EA<byte> > out;
+	if (_executor) {
+		sp<EFuture<EA<byte> > > future = block->future;
+		block->future = null; // the future task refers to the block
+		try {
+			out = future->get();
+		} catch (EExecutionException& e) {
+			throw EIOException(__FILE__, __LINE__, e.getMessage());
+		}
+	} else {
+		out = block->call();
+	}
+	if (out == null) {
+		throw EIOException(__FILE__, __LINE__, block->error);
+	}
+	return out;
+}
+
+void ELZMAInputStream::readFully(void* b, int len) {
+	int n = 0;
+	while (n < len) {
+		int r = _in->read((byte*)b + n, len - n);
+		if (r <= 0) {
+			throw EEOFException(__FILE__, __LINE__);
+		}
+		n += r;
+	}
+}
+
+} /* namespace efc */
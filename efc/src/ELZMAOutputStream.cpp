@@ -0,0 +1,228 @@
+/*
+ * ELZMAOutputStream.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "ELZMAOutputStream.hh"
+#include "ERuntime.hh"
+#include "EIllegalArgumentException.hh"
+#include "ENullPointerException.hh"
+#include "./concurrent/EExecutionException.hh"
+
+namespace efc {
+
+#define HEADER_SIZE       14
+#define BLOCK_HEADER_SIZE 12
+#define MIN_BLOCK_SIZE    (64 * 1024)
+#define MAX_BLOCK_SIZE    (256 * 1024 * 1024)
+
+static void put32(es_uint8_t* p, es_uint32_t v) {
+	p[0] = (es_uint8_t)v;
+	p[1] = (es_uint8_t)(v >> 8);
+	p[2] = (es_uint8_t)(v >> 16);
+	p[3] = (es_uint8_t)(v >> 24);
+}
+
+/*
+ * A block, compressed with its header by the executor or by the caller.
+ */
+class ELZMAOutputStream::Block: public ECallable<EA<byte> > {
+public:
+	sp<EFuture<EA<byte> > > future;
+	es_int32_t error;
+
+	Block(sp<EA<byte> > data, int len, int level) :
+			error(ES_SZ_OK), data(data), len(len), level(level) {
+	}
+
+	virtual sp<EA<byte> > call() {
+		sp<EA<byte> > out = new EA<byte>(BLOCK_HEADER_SIZE + len);
+		es_uint8_t* p = (es_uint8_t*)out->address();
+		byte* src = (byte*)data->address();
+
+		// stored if it doesn't shrink
+		es_size_t clen = len - 1;
+		es_uint32_t size;
+		error = (len > 1) ? eso_lzma_compress(p + BLOCK_HEADER_SIZE, &clen,
+				src, len, level, len) : ES_SZ_ERROR_OUTPUT_EOF;
+		if (error == ES_SZ_OK) {
+			size = (es_uint32_t)clen;
+		} else if (error == ES_SZ_ERROR_OUTPUT_EOF) {
+			error = ES_SZ_OK;
+			memcpy(p + BLOCK_HEADER_SIZE, src, len);
+			clen = len;
+			size = (es_uint32_t)len | 0x80000000U;
+		} else {
+			return null;
+		}
+		put32(p, (es_uint32_t)len);
+		put32(p + 4, size);
+		put32(p + 8, eso_crc32_calc(src, len));
+
+		data = null; // no longer needed
+		if ((int)clen < len) {
+			sp<EA<byte> > exact = new EA<byte>(BLOCK_HEADER_SIZE + (int)clen);
+			memcpy(exact->address(), p, exact->length());
+			return exact;
+		}
+		return out;
+	}
+
+private:
+	sp<EA<byte> > data;
+	int len;
+	int level;
+};
+
+ELZMAOutputStream::~ELZMAOutputStream() {
+	if (_pending) {
+		// unfinished: the blocks are left to the executor
+		sp<Block> block;
+		while ((block = _pending->pollFirst()) != null) {
+			block->future = null;
+		}
+		delete _pending;
+	}
+}
+
+ELZMAOutputStream::ELZMAOutputStream(EOutputStream* out, int level,
+		int blockSize, boolean owned) :
+		EFilterOutputStream(out, owned), _executor(null), _maxPending(0),
+		_pending(null) {
+	init(level, blockSize);
+}
+
+ELZMAOutputStream::ELZMAOutputStream(EOutputStream* out,
+		EExecutorService* executor, int level, int blockSize, boolean owned) :
+		EFilterOutputStream(out, owned), _executor(executor), _pending(null) {
+	if (!executor) {
+		throw ENullPointerException(__FILE__, __LINE__);
+	}
+	_maxPending = ERuntime::getRuntime()->availableProcessors() * 2;
+	init(level, blockSize);
+}
+
+void ELZMAOutputStream::init(int level, int blockSize) {
+	if (blockSize < MIN_BLOCK_SIZE || blockSize > MAX_BLOCK_SIZE) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "blockSize");
+	}
+	_level = level;
+	_blockSize = blockSize;
+	_blockLen = 0;
+	_totalIn = 0;
+	_finished = false;
+	_pending = new EArrayDeque<sp<Block> >();
+
+	es_uint8_t header[HEADER_SIZE] = {'E', 'L', 'Z', 'M', 1};
+	if (eso_lzma_props(header + 5, level, blockSize) != ES_SZ_OK) {
+		throw EIllegalArgumentException(__FILE__, __LINE__, "level");
+	}
+	put32(header + 10, (es_uint32_t)blockSize);
+	_out->write(header, sizeof(header));
+}
+
+void ELZMAOutputStream::write(const void* b, int len) {
+	ES_ASSERT(b); ES_ASSERT(len >= 0);
+
+	if (_finished) {
+		throw EIOException(__FILE__, __LINE__, "write beyond end of stream");
+	}
+	const byte* p = (const byte*)b;
+	while (len > 0) {
+		if (_block == null) {
+			_block = new EA<byte>(_blockSize);
+		}
+		int n = ES_MIN(len, _blockSize - _blockLen);
+		memcpy((byte*)_block->address() + _blockLen, p, n);
+		_blockLen += n;
+		p += n;
+		len -= n;
+		if (_blockLen == _blockSize) {
+			submit();
+		}
+	}
+}
+
+void ELZMAOutputStream::write(const char *s) {
+	EOutputStream::write(s);
+}
+
+void ELZMAOutputStream::write(int b) {
+	EOutputStream::write(b);
+}
+
+void ELZMAOutputStream::finish() {
+	if (_finished) {
+		return;
+	}
+	if (_blockLen > 0) {
+		submit();
+	}
+	drain(0);
+	_block = null;
+
+	es_uint8_t end[12] = {0};
+	put32(end + 4, (es_uint32_t)_totalIn);
+	put32(end + 8, (es_uint32_t)(_totalIn >> 32));
+	_out->write(end, sizeof(end));
+	_finished = true;
+}
+
+void ELZMAOutputStream::close() {
+	if (!closed) {
+		finish();
+		_out->close();
+		closed = true;
+	}
+}
+
+void ELZMAOutputStream::flush() {
+	if (!_finished && _blockLen > 0) {
+		submit();
+	}
+	drain(0);
+	_out->flush();
+}
+
+void ELZMAOutputStream::submit() {
+	sp<Block> block = new Block(_block, _blockLen, _level);
+	_totalIn += _blockLen;
+	_block = null;
+	_blockLen = 0;
+
+	if (_executor) {
+		block->future = _executor->submit<EA<byte> >(block);
+		_pending->addLast(block);
+		drain(_maxPending);
+	} else {
+		sp<EA<byte> > out = block->call();
+		if (out == null) {
+			throw EIOException(__FILE__, __LINE__,
+					EString::formatOf("LZMA error %d", block->error).c_str());
+		}
+		_out->write(out->address(), out->length());
+	}
+}
+
+void ELZMAOutputStream::drain(int keep) {
+	while (_pending->size() > keep) {
+		sp<Block> block = _pending->pollFirst();
+		sp<EFuture<EA<byte> > > future = block->future;
+		sp<EA<byte> > out;
+		block->future = null; // the future task refers to the block
+		try {
+			out = future->get();
+		} catch (EExecutionException& e) {
+			throw EIOException(__FILE__, __LINE__, e.getMessage());
+		}
+		if (out == null) {
+			throw EIOException(__FILE__, __LINE__,
+					EString::formatOf("LZMA error %d", block->error).c_str());
+		}
+		_out->write(out->address(), out->length());
+	}
+}
+
+} /* namespace efc */
@@ -0,0 +1,185 @@
+/*
+ * EMessageDigest.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "EMessageDigest.hh"
+
+namespace efc {
+
+#define MD5     0
+#define SHA1    1
+#define SHA256  2
+#define SHA384  3
+#define SHA512  4
+
+static const struct {
+	const char* name;
+	const char* alias;
+	int length;
+} algorithms[] = {
+	{"MD5", "MD5", ES_MD5_DIGEST_LEN},
+	{"SHA-1", "SHA1", ES_SHA1_DIGESTSIZE},
+	{"SHA-256", "SHA256", SHA256_DIGEST_LENGTH},
+	{"SHA-384", "SHA384", SHA384_DIGEST_LENGTH},
+	{"SHA-512", "SHA512", SHA512_DIGEST_LENGTH}
+};
+
+EMessageDigest::~EMessageDigest() {
+	// no secrets left
+	eso_memset(&_ctx, 0, sizeof(_ctx));
+}
+
+EMessageDigest::EMessageDigest(const char* algorithm) : _algorithm(-1) {
+	for (int i = 0; i < (int)ES_ARRAY_LEN(algorithms); i++) {
+		if (algorithm && (eso_strcasecmp(algorithm, algorithms[i].name) == 0 ||
+				eso_strcasecmp(algorithm, algorithms[i].alias) == 0)) {
+			_algorithm = i;
+			break;
+		}
+	}
+	if (_algorithm < 0) {
+		throw EIllegalArgumentException(__FILE__, __LINE__,
+				EString::formatOf("%s MessageDigest not available", algorithm).c_str());
+	}
+	reset();
+}
+
+sp<EMessageDigest> EMessageDigest::getInstance(const char* algorithm) {
+	return new EMessageDigest(algorithm);
+}
+
+void EMessageDigest::update(byte input) {
+	update(&input, 1);
+}
+
+void EMessageDigest::update(const void* input, int len) {
+	ES_ASSERT(input || len == 0);
+
+	switch (_algorithm) {
+	case MD5:
+		eso_md5_update(&_ctx.md5, (const es_uint8_t*)input, len);
+		break;
+	case SHA1:
+		eso_sha1_update_binary(&_ctx.sha1, (const unsigned char*)input, len);
+		break;
+	case SHA256:
+		eso_sha256_update(&_ctx.sha256, (const es_byte_t*)input, len);
+		break;
+	case SHA384:
+		eso_sha384_update(&_ctx.sha512, (const es_byte_t*)input, len);
+		break;
+	default:
+		eso_sha512_update(&_ctx.sha512, (const es_byte_t*)input, len);
+		break;
+	}
+}
+
+int EMessageDigest::digest(void* buf, int len) {
+	int n = algorithms[_algorithm].length;
+	if (!buf || len < n) {
+		throw EIllegalArgumentException(__FILE__, __LINE__,
+				"output buffer too small for specified digest");
+	}
+
+	switch (_algorithm) {
+	case MD5:
+		eso_md5_final((es_uint8_t*)buf, &_ctx.md5);
+		break;
+	case SHA1:
+		eso_sha1_final((unsigned char*)buf, &_ctx.sha1);
+		break;
+	case SHA256:
+		eso_sha256_final((es_byte_t*)buf, &_ctx.sha256);
+		break;
+	case SHA384:
+		eso_sha384_final((es_byte_t*)buf, &_ctx.sha512);
+		break;
+	default:
+		eso_sha512_final((es_byte_t*)buf, &_ctx.sha512);
+		break;
+	}
+	reset();
+	return n;
+}
+
+sp<EA<byte> > EMessageDigest::digest() {
+	sp<EA<byte> > result = new EA<byte>(algorithms[_algorithm].length);
+	digest(result->address(), result->length());
+	return result;
+}
+
+sp<EA<byte> > EMessageDigest::digest(const void* input, int len) {
+	update(input, len);
+	return digest();
+}
+
+void EMessageDigest::reset() {
+	switch (_algorithm) {
+	case MD5:
+		eso_md5_init(&_ctx.md5);
+		break;
+	case SHA1:
+		eso_sha1_init(&_ctx.sha1);
+		break;
+	case SHA256:
+		eso_sha256_init(&_ctx.sha256);
+		break;
+	case SHA384:
+		eso_sha384_init(&_ctx.sha512);
+		break;
+	default:
+		eso_sha512_init(&_ctx.sha512);
+		break;
+	}
+}
+
+const char* EMessageDigest::getAlgorithm() {
+	return algorithms[_algorithm].name;
+}
+
+int EMessageDigest::getDigestLength() {
+	return algorithms[_algorithm].length;
+}
+
+boolean EMessageDigest::isEqual(const void* digesta, int lena,
+		const void* digestb, int lenb) {
+	if (digesta == digestb) {
+		return true;
+	}
+	if (!digesta || !digestb || lena != lenb) {
+		return false;
+	}
+	const es_uint8_t* a = (const es_uint8_t*)digesta;
+	const es_uint8_t* b = (const es_uint8_t*)digestb;
+	int result = 0;
+	for (int i = 0; i < lena; i++) {
+		result |= a[i] ^ b[i];
+	}
+	return result == 0;
+}
+
+void EMessageDigest::sha256(const void* const data[], const int len[],
+		void* digests, int n) {
+	ES_ASSERT(n >= 0);
+
+	// es_size_t lengths, in batches to bound the stack
+	const int BATCH = 256;
+	es_size_t lens[BATCH];
+	for (int i = 0; i < n; i += BATCH) {
+		int k = ES_MIN(n - i, BATCH);
+		for (int j = 0; j < k; j++) {
+			lens[j] = len[i + j];
+		}
+		eso_sha256_mb((const es_byte_t**)(data + i), lens,
+				(es_byte_t (*)[SHA256_DIGEST_LENGTH])digests + i, k);
+	}
+}
+
+EString EMessageDigest::toString() {
+	return EString::formatOf("%s Message Digest", getAlgorithm());
+}
+
+} /* namespace efc */
@@ -19,6 +19,7 @@
 
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <sys/socket.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -839,6 +840,9 @@ int ENetWrapper::mapSocketOption(int cmd, int *level, int *optname) {
 			{ ESocketOptions::_SO_RCVBUF,             SOL_SOCKET,     SO_RCVBUF },
 			{ ESocketOptions::_SO_KEEPALIVE,          SOL_SOCKET,     SO_KEEPALIVE },
 			{ ESocketOptions::_SO_REUSEADDR,          SOL_SOCKET,     SO_REUSEADDR },
+#ifdef SO_REUSEPORT
+			{ ESocketOptions::_SO_REUSEPORT,          SOL_SOCKET,     SO_REUSEPORT },
+#endif
 			{ ESocketOptions::_SO_BROADCAST,          SOL_SOCKET,     SO_BROADCAST },
 			{ ESocketOptions::_SO_TIMEOUT,            SOL_SOCKET,     SO_RCVTIMEO },
 			{ ESocketOptions::_IP_TOS,                IPPROTO_IP,     IP_TOS },
@@ -848,6 +852,10 @@ int ENetWrapper::mapSocketOption(int cmd, int *level, int *optname) {
 			{ ESocketOptions::_IP_ADD_MEMBERSHIP,     IPPROTO_IP,     IP_ADD_MEMBERSHIP },
 			{ ESocketOptions::_IP_DROP_MEMBERSHIP,    IPPROTO_IP,     IP_DROP_MEMBERSHIP },
 			{ ESocketOptions::_IP_MULTICAST_TTL,      IPPROTO_IP,     IP_MULTICAST_TTL },
+#if defined(__linux__) && defined(UDP_SEGMENT)
+			{ ESocketOptions::_UDP_SEGMENT,           SOL_UDP,        UDP_SEGMENT },
+			{ ESocketOptions::_UDP_GRO,               SOL_UDP,        UDP_GRO },
+#endif
     };
 
     int i;
@@ -10,6 +10,7 @@
 namespace efc {
 
 const int ESocketOptions::_SO_REUSEADDR = 0x0004;
+const int ESocketOptions::_SO_REUSEPORT = 0x000E;
 const int ESocketOptions::_SO_KEEPALIVE = 0x0008;
 const int ESocketOptions::_SO_BROADCAST = 0x0020;
 const int ESocketOptions::_SO_LINGER = 0x0080;
@@ -17,6 +18,8 @@ const int ESocketOptions::_SO_TIMEOUT = 0x1006;
 const int ESocketOptions::_SO_SNDBUF = 0x1001;
 const int ESocketOptions::_SO_RCVBUF = 0x1002;
 const int ESocketOptions::_SO_OOBINLINE = 0x1003;
+const int ESocketOptions::_UDP_SEGMENT = 0x2001;
+const int ESocketOptions::_UDP_GRO = 0x2002;
 
 const int ESocketOptions::_TCP_NODELAY = 0x0001;
 
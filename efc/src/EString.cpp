@@ -7,6 +7,25 @@
 
 namespace efc {
 
+/*
+ * Substring search with the std::string find()/rfind() semantics:
+ * rfind() matches start at or before fromIndex, negative means the end.
+ */
+static int indexOf0(const std::string& str, const char* s, int slen, int fromIndex) {
+	int len = (int)str.length();
+	if (fromIndex < 0) fromIndex = 0;
+	if (fromIndex > len) return -1;
+	es_ssize_t r = eso_strsimd_find(str.data() + fromIndex, len - fromIndex, s, slen);
+	return (r < 0) ? -1 : (int)r + fromIndex;
+}
+
+static int lastIndexOf0(const std::string& str, const char* s, int slen, int fromIndex) {
+	int len = (int)str.length();
+	if (slen > len) return -1;
+	if (fromIndex < 0 || fromIndex > len - slen) fromIndex = len - slen;
+	return (int)eso_strsimd_rfind(str.data(), fromIndex + slen, s, slen);
+}
+
 EString::~EString() {
 	//
 };
@@ -280,14 +299,7 @@ boolean EString::equalsIgnoreCase(std::string& anotherString) {
 		return false;
 	}
 
-	int i = 0;
-	while (len-- != 0) {
-		if (eso_toupper(str_[i]) != eso_toupper(anotherString[i])) {
-			return false;
-		}
-		i++;
-	}
-	return true;
+	return eso_strsimd_equals_icase(str_.data(), anotherString.data(), len);
 }
 
 boolean EString::equalsIgnoreCase(const char* anotherString) {
@@ -300,15 +312,7 @@ boolean EString::equalsIgnoreCase(const char* anotherString) {
 		return false;
 	}
 
-	int i = 0;
-	while (len-- != 0) {
-		if (eso_toupper(str_[i]) != eso_toupper(*anotherString)) {
-			return false;
-		}
-		i++;
-		anotherString++;
-	}
-	return true;
+	return eso_strsimd_equals_icase(str_.data(), anotherString, len);
 }
 
 boolean EString::regionMatches(boolean ignoreCase, int toffset, EString* other,
@@ -320,22 +324,17 @@ boolean EString::regionMatches(boolean ignoreCase, int toffset, EString* other,
 			|| (ooffset > other->str_.length() - len)) {
 		return false;
 	}
-	std::string& ta = str_;
+	const char* ta = str_.data();
 	int to = toffset;
-	std::string& pa = other->str_;
+	const char* pa = other->str_.data();
 	int po = ooffset;
-	while (len-- > 0) {
-		char c1 = ta[to++];
-		char c2 = pa[po++];
-		if (c1 == c2) {
-			continue;
-		}
-		if (ignoreCase && (eso_toupper(c1) == eso_toupper(c2))) {
-			continue;
-		}
-		return false;
+	if (len <= 0) {
+		return true;
 	}
-	return true;
+	if (ignoreCase) {
+		return eso_strsimd_equals_icase(ta + to, pa + po, len);
+	}
+	return (eso_memcmp(ta + to, pa + po, len) == 0);
 }
 boolean EString::regionMatches(boolean ignoreCase, int toffset,
 		const char* other, int ooffset, int len) {
@@ -350,36 +349,31 @@ boolean EString::regionMatches(boolean ignoreCase, int toffset,
 	int to = toffset;
 	const char* pa = other;
 	int po = ooffset;
-	while (len-- > 0) {
-		char c1 = ta[to++];
-		char c2 = pa[po++];
-		if (c1 == c2) {
-			continue;
-		}
-		if (ignoreCase && (eso_toupper(c1) == eso_toupper(c2))) {
-			continue;
-		}
-		return false;
+	if (len <= 0) {
+		return true;
 	}
-	return true;
+	if (ignoreCase) {
+		return eso_strsimd_equals_icase(ta + to, pa + po, len);
+	}
+	return (eso_memcmp(ta + to, pa + po, len) == 0);
 }
 
 boolean EString::contains(const char* s) {
     if (!s) return false;
-	return str_.find(s) != std::string::npos;
+	return indexOf0(str_, s, eso_strlen(s), 0) >= 0;
 }
 
 boolean EString::contains(const EString* s) {
 	if (!s) return false;
-	return str_.find(s->str_) != std::string::npos;
+	return indexOf0(str_, s->str_.data(), s->str_.length(), 0) >= 0;
 }
 
 boolean EString::contains(const EString& s) {
-	return str_.find(s.str_) != std::string::npos;
+	return indexOf0(str_, s.str_.data(), s.str_.length(), 0) >= 0;
 }
 
 boolean EString::contains(const std::string& s) {
-	return str_.find(s) != std::string::npos;
+	return indexOf0(str_, s.data(), s.length(), 0) >= 0;
 }
 
 int EString::indexOf(int ch, int fromIndex) {
@@ -388,53 +382,52 @@ int EString::indexOf(int ch, int fromIndex) {
 }
 
 int EString::indexOf(const EString& s, int fromIndex) {
-	if (fromIndex < 0) fromIndex = 0;
-	return (int)str_.find(s.str_, fromIndex);
+	return indexOf0(str_, s.str_.data(), s.str_.length(), fromIndex);
 }
 
 int EString::indexOf(const std::string& s, int fromIndex) {
-	if (fromIndex < 0) fromIndex = 0;
-	return (int)str_.find(s, fromIndex);
+	return indexOf0(str_, s.data(), s.length(), fromIndex);
 }
 
 int EString::indexOf(const char* s, int fromIndex) {
     if (!s) return -1;
-	if (fromIndex < 0) fromIndex = 0;
-	return (int)str_.find(s, fromIndex);
+	return indexOf0(str_, s, eso_strlen(s), fromIndex);
 }
 
 int EString::lastIndexOf(int ch) {
-	return (int)str_.rfind(ch);
+	return lastIndexOf(ch, -1);
 }
 
 int EString::lastIndexOf(const EString& s) {
-	return (int)str_.rfind(s.str_);
+	return lastIndexOf0(str_, s.str_.data(), s.str_.length(), -1);
 }
 
 int EString::lastIndexOf(const std::string& s) {
-	return (int)str_.rfind(s);
+	return lastIndexOf0(str_, s.data(), s.length(), -1);
 }
 
 int EString::lastIndexOf(const char* s) {
     if (!s) return -1;
-	return (int)str_.rfind(s);
+	return lastIndexOf0(str_, s, eso_strlen(s), -1);
 }
 
 int EString::lastIndexOf(int ch, int fromIndex) {
-	return (int)str_.rfind(ch, fromIndex);
+	int len = (int)str_.length();
+	if (fromIndex < 0 || fromIndex >= len) fromIndex = len - 1;
+	return (int)eso_strsimd_rfindchr(str_.data(), fromIndex + 1, ch);
 }
 
 int EString::lastIndexOf(const EString& s, int fromIndex) {
-	return (int)str_.rfind(s.str_, fromIndex);
+	return lastIndexOf0(str_, s.str_.data(), s.str_.length(), fromIndex);
 }
 
 int EString::lastIndexOf(const std::string& s, int fromIndex) {
-	return (int)str_.rfind(s, fromIndex);
+	return lastIndexOf0(str_, s.data(), s.length(), fromIndex);
 }
 
 int EString::lastIndexOf(const char* s, int fromIndex) {
     if (!s) return -1;
-	return (int)str_.rfind(s, fromIndex);
+	return lastIndexOf0(str_, s, eso_strlen(s), fromIndex);
 }
 
 EString EString::substring(int beginIndex, int endIndex) {
@@ -457,21 +450,15 @@ EString EString::substring(int beginIndex, int endIndex) {
 }
 
 EString& EString::toLowerCase() {
-		int len = (int)str_.length();
-		int i = 0;
-		while (len-- > 0) {
-			str_[i] = eso_tolower(str_[i]);
-			i++;
-		}
-		return *this;
+	if (!str_.empty()) {
+		eso_strsimd_tolower(&str_[0], str_.length());
 	}
+	return *this;
+}
 
 EString& EString::toUpperCase() {
-	int len = (int)str_.length();
-	int i = 0;
-	while (len-- > 0) {
-		str_[i] = eso_toupper(str_[i]);
-		i++;
+	if (!str_.empty()) {
+		eso_strsimd_toupper(&str_[0], str_.length());
 	}
 	return *this;
 }
@@ -547,14 +534,14 @@ EString EString::valueOf(llong l, int radix) {
 }
 
 EString EString::valueOf(float f) {
-	char s[80];
-	eso_snprintf(s, sizeof(s), "%f", f);
+	char s[ES_DTOA_BUFSIZE];
+	eso_ftoa_java(f, s);
 	return EString(s);
 }
 
 EString EString::valueOf(double d) {
-	char s[80];
-	eso_snprintf(s, sizeof(s), "%lf", d);
+	char s[ES_DTOA_BUFSIZE];
+	eso_dtoa_java(d, s);
 	return EString(s);
 }
 
@@ -695,16 +682,14 @@ EString& EString::append(ullong l, int radix) {
 }
 
 EString& EString::append(float f) {
-	char s[80];
-	eso_snprintf(s, sizeof(s), "%f", f);
-	str_.append(s);
+	char s[ES_DTOA_BUFSIZE];
+	str_.append(s, eso_ftoa_java(f, s));
 	return (*this);
 }
 
 EString& EString::append(double d) {
-	char s[80];
-	eso_snprintf(s, sizeof(s), "%lf", d);
-	str_.append(s);
+	char s[ES_DTOA_BUFSIZE];
+	str_.append(s, eso_dtoa_java(d, s));
 	return (*this);
 }
 
@@ -1042,15 +1027,7 @@ int EString::compareNoCase(const EString& s) const {
 	if (sp < sq)
 		return -1;
 
-	int diff = 0;
-	for (int i = 0; i < sp; ++i) {
-		diff = (eso_tolower(str_[i]) - eso_tolower(s.str_[i]));
-		if (diff) {
-			return diff;
-		}
-	}
-
-	return 0;
+	return eso_strsimd_compare_icase(str_.data(), s.str_.data(), sp);
 }
 
 EString& EString::reset(const char* s, int len) {
@@ -1091,14 +1068,21 @@ EString& EString::reset(const std::string& s, int offset, int len) {
 }
 
 EString EString::splitAt(const char *separators, int index) {
-	es_string_t *to = NULL;
-	to = eso_mstrsplit((char*)str_.c_str(), separators, index, &to);
-	if (!to) {
+	if (!separators || index < 1) {
 		return null;
 	}
-	EString o(to);
-	eso_mfree(to);
-	return o;
+	int slen = eso_strlen(separators);
+	int from = 0;
+	for (int i = 1; ; i++) {
+		int to = indexOf0(str_, separators, slen, from);
+		if (i == index) {
+			return EString(str_, from, (to < 0 ? (int)str_.length() : to) - from);
+		}
+		if (to < 0) {
+			return null;
+		}
+		from = to + slen;
+	}
 }
 
 EString& EString::resize(int len, char c) {
@@ -1146,14 +1130,20 @@ boolean EString::equals(EObject* obj) {
 int EString::hashCode() {
 	int h = hash;
 	if (h == 0 && !str_.empty()) {
-		for (int i=0; i<str_.length(); i++) {
-			h = h * 31 + str_[i];
-		}
+		h = eso_strsimd_hash31(0, str_.data(), str_.length());
 		hash = h;
 	}
 	return h;
 }
 
+int EString::hashCode() const {
+	int h = hash;
+	if (h == 0 && !str_.empty()) {
+		h = eso_strsimd_hash31(0, str_.data(), str_.length());
+	}
+	return h;
+}
+
 void EString::rangeCheck(int index) const THROWS(EIndexOutOfBoundsException) {
 	if (index < 0 || index >= str_.length()) {
 		EString msg("String index out of range: ");
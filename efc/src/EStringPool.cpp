@@ -0,0 +1,509 @@
+/*
+ * EStringPool.cpp
+ *
+ *  Created on: 2026-10-19
+ *      Author: agent
+ */
+
+#include "EStringPool.hh"
+#include "ESentry.hh"
+#include "EInteger.hh"
+#include "EIllegalArgumentException.hh"
+#include "EThreadLocal.hh"
+#include "ESpinLock.hh"
+#include "concurrent/EReentrantLock.hh"
+#include "concurrent/EOrderAccess.hh"
+
+namespace efc {
+
+#define SP_MAX_SEGMENTS          (1 << 16)
+#define SP_SEGMENT_CAPACITY      16
+#define SP_MAXIMUM_CAPACITY      (1 << 30)
+
+/**
+ * Pool entry.  Only the next field changes after the entry is published,
+ * when a dead entry behind it is unlinked.
+ */
+class EStringPool::Node {
+public:
+	sp<EString> str; // strong mode
+	wp<EString> ref; // weak mode
+	Node* volatile next;
+	Node* retired;
+	llong epoch;     // when retired
+	int hash;
+	int length;
+
+	Node(sp<EString>& s, int h, Node* n, boolean weak) :
+			next(n), retired(null), epoch(0), hash(h), length(s->length()) {
+		if (weak) ref = s;
+		else str = s;
+	}
+
+	Node(Node* that, Node* n) :
+			str(that->str), ref(that->ref), next(n), retired(null), epoch(0),
+			hash(that->hash), length(that->length) {
+	}
+
+	sp<EString> get() {
+		return (str != null) ? str : ref.lock();
+	}
+
+	boolean isDead() {
+		return (str == null) && ref.expired();
+	}
+};
+
+/**
+ * Bucket array, the length goes along so that a reader always indexes
+ * the table it loaded with the right mask.
+ */
+struct EStringPool::Table {
+	int length;
+	Node* volatile* buckets;
+	Table* retired;
+	llong epoch;
+
+	Table(int n) : length(n), retired(null), epoch(0) {
+		buckets = new Node* volatile[n]();
+	}
+
+	~Table() {
+		delete[] buckets;
+	}
+};
+
+/**
+ * The epoch slot of a thread, 0 outside of lookups.  Only the thread
+ * writes it, so that lookups share no written cache line.
+ */
+class EStringPool::Reader: public EObject {
+public:
+	sp<Epochs> epochs; // null until first used
+	volatile llong active;
+	Reader* prev;      // the readers of the pool, under its lock
+	Reader* next;
+
+	Reader() : active(0), prev(null), next(null) {
+	}
+
+	virtual ~Reader();
+};
+
+class EStringPool::ThreadLocalReader: public EThreadLocal {
+public:
+	virtual EObject* initialValue() {
+		return new Reader();
+	}
+};
+
+/**
+ * Epoch based reclamation.  A reader publishes the epoch it enters a
+ * lookup in; writers tag what they unlink with the epoch and advance it,
+ * and free it once no reader is still in that epoch or an earlier one.
+ * Lookups in progress keep only what they could have seen.
+ */
+class EStringPool::Epochs: public EObject {
+public:
+#ifdef CPP11_SUPPORT
+	// the reader the thread used last, spares the thread-local lookup
+	static THREAD_TLS Reader* last;
+#endif
+
+	volatile llong epoch;
+	EThreadLocalVariable<ThreadLocalReader, Reader>* readers;
+	ESpinLock lock;
+	Reader* live;
+
+	Epochs() : epoch(1), live(null) {
+		readers = new EThreadLocalVariable<ThreadLocalReader, Reader>();
+	}
+
+	virtual ~Epochs() {
+		delete readers;
+	}
+
+	Reader* readerOf(sp<Epochs>& self) {
+#ifdef CPP11_SUPPORT
+		Reader* reader = last;
+		if (reader != null && reader->epochs.get() == this) {
+			return reader;
+		}
+#endif
+		reader = readers->get();
+		if (reader->epochs == null) {
+			reader->epochs = self;
+			SYNCBLOCK (&lock) {
+				reader->next = live;
+				if (live != null) {
+					live->prev = reader;
+				}
+				live = reader;
+            }}
+		}
+#ifdef CPP11_SUPPORT
+		last = reader;
+#endif
+		return reader;
+	}
+
+	void enter(Reader* reader) {
+		// seen by the writers before the reader loads a table
+		EOrderAccess::release_store_fence(&reader->active, EOrderAccess::load_acquire(&epoch));
+	}
+
+	void exit(Reader* reader) {
+		EOrderAccess::release_store(&reader->active, (llong)0);
+	}
+
+	/*
+	 * The tag of what the caller has just unlinked; the readers that enter
+	 * later can't reach it.
+	 */
+	llong retire() {
+		return eso_atomic_fetch_and_add64(&epoch, 1);
+	}
+
+	/*
+	 * The oldest epoch a reader is in, what is retired before it is free.
+	 */
+	llong oldest() {
+		EOrderAccess::fence();
+		SYNCBLOCK (&lock) {
+			llong min = EOrderAccess::load_acquire(&epoch);
+			for (Reader* reader = live; reader != null; reader = reader->next) {
+				llong e = EOrderAccess::load_acquire(&reader->active);
+				if (e != 0 && e < min) {
+					min = e;
+				}
+			}
+			return min;
+        }}
+	}
+};
+
+#ifdef CPP11_SUPPORT
+THREAD_TLS EStringPool::Reader* EStringPool::Epochs::last = null;
+#endif
+
+EStringPool::Reader::~Reader() {
+#ifdef CPP11_SUPPORT
+	if (Epochs::last == this) {
+		Epochs::last = null;
+	}
+#endif
+	if (epochs == null) {
+		return;
+	}
+	SYNCBLOCK (&epochs->lock) {
+		if (prev != null) {
+			prev->next = next;
+		} else {
+			epochs->live = next;
+		}
+		if (next != null) {
+			next->prev = prev;
+		}
+    }}
+}
+
+/**
+ * Lock striped segment.  Readers never lock, nodes and tables replaced by
+ * writers are retired to the epochs.
+ */
+class EStringPool::Segment: public EReentrantLock {
+public:
+	volatile int count;
+	int threshold;
+	Table* volatile table;
+	Epochs* epochs;
+
+	// unlinked nodes and replaced tables, the most recent first
+	Node* retiredNodes;
+	Table* retiredTables;
+
+	Segment(Epochs* epochs, int initialCapacity) :
+			count(0), epochs(epochs), retiredNodes(null), retiredTables(null) {
+		table = new Table(initialCapacity);
+		threshold = initialCapacity * 3 / 4;
+	}
+
+	~Segment() {
+		for (int i = 0; i < table->length; i++) {
+			Node* e = table->buckets[i];
+			while (e) {
+				Node* next = e->next;
+				delete e;
+				e = next;
+			}
+		}
+		delete table;
+		reclaim(true);
+	}
+
+	sp<EString> find(const char* s, int len, int hash, Reader* reader) {
+		sp<EString> v;
+		if (count != 0) { // read-volatile
+			epochs->enter(reader);
+			Table* tab = (Table*)EOrderAccess::load_ptr_acquire(&table);
+			Node* e = (Node*)EOrderAccess::load_ptr_acquire(&tab->buckets[hash & (tab->length - 1)]);
+			while (e) {
+				if (e->hash == hash && e->length == len) {
+					sp<EString> x = e->get();
+					if (x != null && eso_memcmp(x->c_str(), s, len) == 0) {
+						v = x;
+						break;
+					}
+				}
+				e = (Node*)EOrderAccess::load_ptr_acquire(&e->next);
+			}
+			epochs->exit(reader);
+		}
+		return v;
+	}
+
+	sp<EString> add(const char* s, int len, int hash, boolean weak) {
+		SYNCBLOCK(this) {
+			// recheck, a reader may miss entries added or moved meanwhile
+			for (Node* e = table->buckets[hash & (table->length - 1)]; e; e = e->next) {
+				if (e->hash == hash && e->length == len) {
+					sp<EString> x = e->get();
+					if (x != null && eso_memcmp(x->c_str(), s, len) == 0) {
+						return x;
+					}
+				}
+			}
+
+			if (count >= threshold) {
+				// grow only if evicting the dead entries doesn't free half
+				if (weak) {
+					evict();
+				}
+				if (count >= threshold / 2) {
+					rehash();
+				}
+				reclaim(false);
+			}
+
+			sp<EString> v(new EString(s, len));
+			v->hashCode(); // cached
+			int index = hash & (table->length - 1);
+			Node* n = new Node(v, hash, table->buckets[index], weak);
+			EOrderAccess::release_store_ptr(&table->buckets[index], n);
+			count = count + 1; // write-volatile
+			return v;
+        }}
+	}
+
+	int purge() {
+		SYNCBLOCK(this) {
+			int n = evict();
+			reclaim(false);
+			return n;
+        }}
+	}
+
+private:
+	/*
+	 * Unlink the dead entries in place, the caller holds the lock.  The
+	 * next field of an unlinked node is kept for readers standing on it.
+	 */
+	int evict() {
+		int removed = 0;
+		Node* unlinked = null;
+		for (int i = 0; i < table->length; i++) {
+			Node* volatile* prev = &table->buckets[i];
+			Node* e = *prev;
+			while (e) {
+				Node* next = e->next;
+				if (e->isDead()) {
+					EOrderAccess::release_store_ptr(prev, next);
+					e->retired = unlinked;
+					unlinked = e;
+					removed++;
+				} else {
+					prev = &e->next;
+				}
+				e = next;
+			}
+		}
+		count = count - removed; // write-volatile
+		if (unlinked) {
+			llong epoch = epochs->retire();
+			Node* e = unlinked;
+			for (;;) {
+				e->epoch = epoch;
+				if (!e->retired) {
+					break;
+				}
+				e = e->retired;
+			}
+			e->retired = retiredNodes;
+			retiredNodes = unlinked;
+		}
+		return removed;
+	}
+
+	/*
+	 * Copy the live nodes into a table twice as big: readers still walking
+	 * the old table must not be moved to other chains.
+	 */
+	void rehash() {
+		Table* oldTable = table;
+		if (oldTable->length >= SP_MAXIMUM_CAPACITY) {
+			threshold = EInteger::MAX_VALUE;
+			return;
+		}
+		Table* newTable = new Table(oldTable->length << 1);
+		int mask = newTable->length - 1;
+		int live = 0;
+		for (int i = 0; i < oldTable->length; i++) {
+			for (Node* e = oldTable->buckets[i]; e; e = e->next) {
+				if (!e->isDead()) {
+					int k = e->hash & mask;
+					newTable->buckets[k] = new Node(e, newTable->buckets[k]);
+					live++;
+				}
+			}
+		}
+		EOrderAccess::release_store_ptr(&table, newTable);
+		threshold = newTable->length * 3 / 4;
+		count = live; // write-volatile
+
+		llong epoch = epochs->retire();
+		for (int i = 0; i < oldTable->length; i++) {
+			for (Node* e = oldTable->buckets[i]; e; e = e->next) {
+				e->epoch = epoch;
+				e->retired = retiredNodes;
+				retiredNodes = e;
+			}
+		}
+		oldTable->epoch = epoch;
+		oldTable->retired = retiredTables;
+		retiredTables = oldTable;
+	}
+
+	/* free the retired memory no reader can still see */
+	void reclaim(boolean force) {
+		llong oldest = force ? ES_INT64_MAX_VALUE : epochs->oldest();
+		Node** pn = &retiredNodes;
+		while (*pn && (*pn)->epoch >= oldest) {
+			pn = &(*pn)->retired;
+		}
+		Node* e = *pn;
+		*pn = null;
+		while (e) {
+			Node* next = e->retired;
+			delete e;
+			e = next;
+		}
+		Table** pt = &retiredTables;
+		while (*pt && (*pt)->epoch >= oldest) {
+			pt = &(*pt)->retired;
+		}
+		Table* t = *pt;
+		*pt = null;
+		while (t) {
+			Table* next = t->retired;
+			delete t;
+			t = next;
+		}
+	}
+};
+
+//=============================================================================
+
+EStringPool::~EStringPool() {
+	for (int i = 0; i < segments_->length(); i++) {
+		delete (*segments_)[i];
+	}
+	delete segments_;
+	// the other threads drop their readers when they end
+	epochs_->readers->remove();
+}
+
+EStringPool::EStringPool(boolean weak, int concurrencyLevel) : weak(weak) {
+	if (concurrencyLevel <= 0)
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+	if (concurrencyLevel > SP_MAX_SEGMENTS)
+		concurrencyLevel = SP_MAX_SEGMENTS;
+
+	// Find power-of-two sizes best matching arguments
+	int sshift = 0;
+	int ssize = 1;
+	while (ssize < concurrencyLevel) {
+		++sshift;
+		ssize <<= 1;
+	}
+	segmentShift = 32 - sshift;
+	segmentMask = ssize - 1;
+	epochs_ = new Epochs();
+	segments_ = new EA<Segment*>(ssize, false);
+	for (int i = 0; i < ssize; i++) {
+		(*segments_)[i] = new Segment(epochs_.get(), SP_SEGMENT_CAPACITY);
+	}
+}
+
+int EStringPool::hashOf(const char* s, int len) {
+	es_uint64_t h = eso_hash64(s, len, eso_hash_seed());
+	return (int)(h ^ (h >> 32));
+}
+
+EStringPool::Segment* EStringPool::segmentFor(int hash) {
+	// the segment from the high bits, the bucket from the low bits
+	return (*segments_)[(((unsigned)hash) >> segmentShift) & segmentMask];
+}
+
+sp<const EString> EStringPool::intern(const char* s) {
+	return intern(s, s ? eso_strlen(s) : 0);
+}
+
+sp<const EString> EStringPool::intern(const EString& s) {
+	return intern(s.c_str(), s.length());
+}
+
+sp<const EString> EStringPool::intern(const char* s, int len) {
+	if (!s) s = "";
+	if (len < 0)
+		throw EIllegalArgumentException(__FILE__, __LINE__);
+
+	int hash = hashOf(s, len);
+	Segment* seg = segmentFor(hash);
+	sp<EString> v = seg->find(s, len, hash, epochs_->readerOf(epochs_));
+	if (v != null) {
+		return v;
+	}
+	return seg->add(s, len, hash, weak);
+}
+
+sp<const EString> EStringPool::lookup(const char* s, int len) {
+	if (!s || len < 0) {
+		return null;
+	}
+	int hash = hashOf(s, len);
+	return segmentFor(hash)->find(s, len, hash, epochs_->readerOf(epochs_));
+}
+
+int EStringPool::size() {
+	int n = 0;
+	for (int i = 0; i < segments_->length(); i++) {
+		n += (*segments_)[i]->count;
+	}
+	return n;
+}
+
+int EStringPool::purge() {
+	int n = 0;
+	if (weak) {
+		for (int i = 0; i < segments_->length(); i++) {
+			n += (*segments_)[i]->purge();
+		}
+	}
+	return n;
+}
+
+boolean EStringPool::isWeak() {
+	return weak;
+}
+
+} /* namespace efc */
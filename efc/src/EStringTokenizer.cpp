@@ -33,27 +33,27 @@ boolean EStringTokenizer::isDelimiter(char codePoint) {
 }
 
 int EStringTokenizer::skipDelimiters(int startPos) {
-	int position = startPos;
-	while (!retDelims && position < maxPosition && isDelimiter(str[position])) {
-		position++;
+	if (retDelims || startPos >= maxPosition) {
+		return startPos;
 	}
-	return position;
+	es_ssize_t r = eso_strsimd_findset(str + startPos, maxPosition - startPos,
+			delimiters.c_str(), delimiters.length(), false);
+	return (r < 0) ? maxPosition : startPos + (int)r;
 }
 
 int EStringTokenizer::scanToken(int startPos) {
 	int position = startPos;
 
-	while (retDelims && position < maxPosition && isDelimiter(str[position])) {
+	if (retDelims && position < maxPosition && isDelimiter(str[position])) {
 		return ++position;
 	}
 
-	while (position < maxPosition) {
-		if (isDelimiter(str[++position])) {
-			break;
-		}
+	if (++position >= maxPosition) {
+		return maxPosition;
 	}
-
-	return position;
+	es_ssize_t r = eso_strsimd_findset(str + position, maxPosition - position,
+			delimiters.c_str(), delimiters.length(), true);
+	return (r < 0) ? maxPosition : position + (int)r;
 }
 
 /*****************************************************************************\
@@ -155,6 +155,426 @@ static void test_performance() {
 	LOG("deserialize time used:%dms", (endTime2 - endTime));
 }
 
+static void test_bson_view() {
+	EBson bs;
+	bs.add("/doc", NULL);
+	for (int i = 0; i < 300; i++) {
+		bs.addInt(EString::formatOf("/doc/f%d", i).c_str(), i);
+	}
+	bs.add("/doc/items", NULL);
+	for (int i = 0; i < 3; i++) {
+		es_bson_node_t* item = bs.add("/doc/items/item", "item");
+		EBson::attrSetInt(item, "id", 100 + i);
+		EBson::attrAdd(item, "tag", "t");
+		bs.addDouble("/doc/items/item/price", 9.5 + i);
+	}
+	bs.add("/doc/name", "efc");
+	bs.addVarint("/doc/seq", 66999888);
+
+	EByteBuffer bb;
+	bs.Export(&bb, NULL, true);
+
+	EBsonView view(bb.data(), bb.size());
+	LOG("name=%s", view.get("/doc/name"));
+	ES_ASSERT(eso_strcmp(view.getString("/doc/name").c_str(), "efc") == 0);
+	ES_ASSERT(view.getInt("/doc/f7") == 7);
+	ES_ASSERT(view.getLLong("/doc/seq") == 66999888);
+	ES_ASSERT(view.getDouble("/doc/items/item|2/price") == 10.5);
+	ES_ASSERT(view.getDouble("/doc/items/item|0/price") == 11.5);
+	ES_ASSERT(view.attrGetLLong("/doc/items/item|3", "id") == 102);
+	ES_ASSERT(eso_strcmp(view.attrGetString("/doc/items/item", "tag").c_str(), "t") == 0);
+	ES_ASSERT(view.count("/doc/items/item") == 3);
+	ES_ASSERT(view.getInt("/doc/xxx", -1) == -1);
+	ES_ASSERT(!view.isCorrupted());
+
+	// same values as the imported tree
+	for (int i = 0; i < 300; i += 17) {
+		EString path = EString::formatOf("/doc/f%d", i);
+		ES_ASSERT(view.getString(path.c_str()).equals(bs.getString(path.c_str()).c_str()));
+	}
+
+	// a few fields only index the records up to them
+	EBsonView lazy(bb.data(), bb.size());
+	lazy.getInt("/doc/f2");
+	LOG("indexed %d nodes to read f2", lazy.indexed());
+
+	// truncated data
+	EBsonView cut(bb.data(), bb.size() / 2);
+	ES_ASSERT(cut.getInt("/doc/f3") == 3);
+	ES_ASSERT(cut.get("/doc/name") == null);
+	ES_ASSERT(cut.isCorrupted());
+
+	// a varint not ending in its value, and an empty value, are no numbers
+	es_size_t seqSize;
+	int seqType;
+	const char *seq = (const char*)view.get("/doc/seq", &seqSize, &seqType);
+	ES_ASSERT(seqType == BSON_NODE_DATA_TYPE_VARINT);
+	EByteBuffer bad;
+	bad.append(bb.data(), bb.size());
+	memset((char*)bad.data() + (seq - (const char*)bb.data()), 0xFF, seqSize);
+	EBsonView badView(bad.data(), bad.size());
+	try {
+		badView.getLLong("/doc/seq");
+		ES_ASSERT(false);
+	} catch (EDataFormatException& e) {
+		LOG("bad varint: %s", e.getMessage());
+	}
+	ES_ASSERT(view.getLLong("/doc/items", -1) == -1);
+
+	llong startTime = ESystem::nanoTime();
+	llong sum = 0;
+	for (int i = 0; i < 10000; i++) {
+		EBson b;
+		b.Import(bb.data(), bb.size());
+		sum += b.getInt("/doc/f1") + b.getInt("/doc/f5") + b.getInt("/doc/f9");
+	}
+	llong midTime = ESystem::nanoTime();
+	for (int i = 0; i < 10000; i++) {
+		EBsonView v(bb.data(), bb.size());
+		sum -= v.getInt("/doc/f1") + v.getInt("/doc/f5") + v.getInt("/doc/f9");
+	}
+	llong endTime = ESystem::nanoTime();
+	ES_ASSERT(sum == 0);
+	LOG("read 3 of %d bytes x10000: import=%lldus, view=%lldus", bb.size(),
+			(midTime - startTime) / 1000, (endTime - midTime) / 1000);
+}
+
+static void test_bson_push() {
+	// a stream of documents, with and without head
+	EByteBuffer stream;
+	EArray<EString*> expected;
+	for (int i = 0; i < 20; i++) {
+		EBson bs;
+		bs.add("/doc", NULL);
+		bs.addInt("/doc/id", i);
+		es_bson_node_t* item = bs.add("/doc/item", "item");
+		EBson::attrSetInt(item, "n", i * 2);
+		for (int j = 0; j < i; j++) {
+			bs.add(EString::formatOf("/doc/item/f%d", j).c_str(), "value");
+		}
+		bs.addLLong("/doc/seq", i * 1000LL);
+		bs.Export(&stream, NULL, i % 2 == 0);
+		expected.add(new EString(bs.toString()));
+	}
+
+	// chunks of all sizes, resumed mid-record
+	for (int chunk = 1; chunk < 100; chunk += 7) {
+		EBsonParser parser;
+		EBson bson;
+		int docs = 0;
+		for (int off = 0; off < stream.size(); off += chunk) {
+			parser.feed((char*)stream.data() + off, ES_MIN(chunk, stream.size() - off));
+			while (parser.nextBson(&bson)) {
+				ES_ASSERT(bson.toString().equals(expected[docs]));
+				ES_ASSERT(bson.getInt("/doc/id") == docs);
+				ES_ASSERT(EBson::attrGetLLong(bson.find("/doc/item"), "n") == docs * 2);
+				docs++;
+			}
+		}
+		ES_ASSERT(docs == 20);
+		ES_ASSERT(parser.buffered() == 0);
+	}
+
+	// bounded memory, fed from a nio buffer
+	class Counter : public EBsonParser {
+	public:
+		int nodes;
+		Counter(int max) : EBsonParser(max), nodes(0) {
+		}
+		void parsing(es_bson_node_t* node) {
+			if (node && !node->isattr) nodes++;
+		}
+	};
+	Counter counter(64);
+	EBson bson;
+	nio::EIOByteBuffer* buffer = nio::EIOByteBuffer::allocate(40);
+	int off = 0, docs = 0;
+	while (off < stream.size() || buffer->position() > 0) {
+		int n = ES_MIN(buffer->remaining(), stream.size() - off);
+		buffer->put((char*)stream.data() + off, n);
+		off += n;
+		buffer->flip();
+		counter.feed(buffer);
+		buffer->compact();
+		while (counter.nextBson(&bson)) {
+			docs++;
+		}
+		ES_ASSERT(counter.buffered() <= 64);
+	}
+	delete buffer;
+	LOG("bounded: docs=%d, nodes=%d", docs, counter.nodes);
+	ES_ASSERT(docs == 20 && counter.nodes == 20 * 4 + 190);
+
+	// a node larger than the bound
+	EBsonParser small(8);
+	try {
+		small.feed(stream.data(), stream.size());
+		small.nextBson(&bson);
+		ES_ASSERT(false);
+	} catch (EDataFormatException& e) {
+		LOG("too large: %s", e.getMessage());
+	}
+
+	// many streams on one thread
+	const int streams = 2000;
+	EA<EBsonParser*> parsers(streams);
+	EA<EBson*> bsons(streams);
+	for (int i = 0; i < streams; i++) {
+		parsers[i] = new EBsonParser();
+		bsons[i] = new EBson();
+	}
+	llong startTime = ESystem::nanoTime();
+	int total = 0;
+	for (int off = 0; off < stream.size(); off += 64) {
+		int n = ES_MIN(64, stream.size() - off);
+		for (int i = 0; i < streams; i++) {
+			parsers[i]->feed((char*)stream.data() + off, n);
+			while (parsers[i]->nextBson(bsons[i])) {
+				total++;
+			}
+		}
+	}
+	llong endTime = ESystem::nanoTime();
+	ES_ASSERT(total == streams * 20);
+	LOG("%d streams x %d bytes in 64 byte chunks: %lldms", streams, stream.size(),
+			(endTime - startTime) / 1000000);
+}
+
+struct BindAddress: public EObject {
+	EString city;
+	int zip;
+	BindAddress() : zip(0) {}
+};
+
+struct BindUser: public EObject {
+	llong id;
+	EString name;
+	boolean active;
+	short level;
+	byte flags;
+	float ratio;
+	double score;
+	BindAddress home;
+	BindAddress *office;
+	EArrayList<int> scores;
+	EArrayList<BindAddress*> others;
+	EHashMap<EString*, EString*> tags;
+	BindUser() : id(0), active(false), level(0), flags(0), ratio(0), score(0), office(null) {}
+	~BindUser() { delete office; }
+};
+
+/* the fields read by path in the benchmark */
+struct BindSummary {
+	llong id;
+	EString name;
+	boolean active;
+	short level;
+	byte flags;
+	float ratio;
+	double score;
+	BindAddress home;
+	BindSummary() : id(0), active(false), level(0), flags(0), ratio(0), score(0) {}
+};
+
+ES_BINDING(BindAddress, city, zip)
+ES_BINDING(BindUser, id, name, active, level, flags, ratio, score, home, office, scores, others, tags)
+ES_BINDING(BindSummary, id, name, active, level, flags, ratio, score, home)
+
+static void bind_fill(BindUser& u) {
+	u.id = LLONG(1234567890123);
+	u.name = "efc \"user\"";
+	u.active = true;
+	u.level = -7;
+	u.flags = 3;
+	u.ratio = 0.5f;
+	u.score = 98.25;
+	u.home.city = "Shanghai";
+	u.home.zip = 200000;
+	u.office = new BindAddress();
+	u.office->city = "Beijing";
+	u.office->zip = 100000;
+	for (int i = 0; i < 5; i++) {
+		u.scores.add(i * 10 - 20);
+	}
+	for (int i = 0; i < 2; i++) {
+		BindAddress *a = new BindAddress();
+		a->city = EString::formatOf("city%d", i);
+		a->zip = i;
+		u.others.add(a);
+	}
+	u.tags.put(new EString("lang"), new EString("c++"));
+	u.tags.put(new EString("os"), new EString("linux"));
+}
+
+static void bind_check(BindUser& u) {
+	ES_ASSERT(u.id == LLONG(1234567890123));
+	ES_ASSERT(u.name.equals("efc \"user\""));
+	ES_ASSERT(u.active && u.level == -7 && u.flags == 3);
+	ES_ASSERT(u.ratio == 0.5f && u.score == 98.25);
+	ES_ASSERT(u.home.city.equals("Shanghai") && u.home.zip == 200000);
+	ES_ASSERT(u.office && u.office->city.equals("Beijing") && u.office->zip == 100000);
+	ES_ASSERT(u.scores.size() == 5 && u.scores.getAt(0) == -20 && u.scores.getAt(4) == 20);
+	ES_ASSERT(u.others.size() == 2 && u.others.getAt(1)->city.equals("city1"));
+	ES_ASSERT(u.tags.size() == 2);
+	EString key("os");
+	ES_ASSERT(u.tags.get(&key)->equals("linux"));
+}
+
+static void test_struct_binding() {
+	BindUser user;
+	bind_fill(user);
+
+	// json
+	EString json = EStructBinding::toJson(user);
+	LOG("json=%s", json.c_str());
+	BindUser u1;
+	EStructBinding::fromJson(u1, json.c_str(), json.length());
+	bind_check(u1);
+	ES_ASSERT(EStructBinding::toJson(u1).equals(json));
+
+	// unknown and escaped names
+	BindAddress a;
+	const char *s = "{\"zzz\": [1, {\"city\": 0}], \"ci\\u0074y\": \"x\", \"zip\": null}";
+	EStructBinding::fromJson(a, s, eso_strlen(s));
+	ES_ASSERT(a.city.equals("x") && a.zip == 0);
+
+	// bson, read by the view, by the tree and by paths
+	EByteArrayOutputStream out;
+	EStructBinding::toBson(&out, "user", user);
+	EBsonView view(out.data(), out.size());
+	BindUser u2;
+	boolean ok = EStructBinding::fromBson(u2, view, "/user");
+	ES_ASSERT(ok);
+	ES_ASSERT(!view.isCorrupted());
+	bind_check(u2);
+
+	EBson bson;
+	bson.Import(out.data(), out.size());
+	BindUser u3;
+	ok = EStructBinding::fromBson(u3, bson, "/user");
+	ES_ASSERT(ok);
+	bind_check(u3);
+	ES_ASSERT(bson.getLLong("/user/id") == user.id);
+	ES_ASSERT(bson.getInt("/user/scores|2") == -10);
+	ES_ASSERT(eso_strcmp(bson.getString("/user/others|2/city").c_str(), "city1") == 0);
+	ES_ASSERT(eso_strcmp(bson.getString("/user/tags/lang").c_str(), "c++") == 0);
+
+	// the same bytes as exported by EBson
+	EByteBuffer bb;
+	bson.Export(&bb, NULL, false);
+	ES_ASSERT(bb.size() == out.size() && memcmp(bb.data(), out.data(), out.size()) == 0);
+
+	// benchmark: the fields by path against the bindings
+	const int loops = 100000;
+	llong t0, t1;
+	llong sum = 0;
+
+	t0 = ESystem::nanoTime();
+	for (int i = 0; i < loops; i++) {
+		BindAddress h;
+		sum += bson.getLLong("/user/id") + bson.getInt("/user/level") + bson.getInt("/user/flags");
+		sum += bson.getInt("/user/active") + (llong)bson.getDouble("/user/score");
+		sum += (llong)bson.getFloat("/user/ratio") + bson.getString("/user/name").length();
+		h.city = bson.getString("/user/home/city");
+		h.zip = bson.getInt("/user/home/zip");
+		sum += h.zip;
+	}
+	t1 = ESystem::nanoTime();
+	LOG("EBson by path: %lldns/object", (t1 - t0) / loops);
+
+	t0 = ESystem::nanoTime();
+	for (int i = 0; i < loops; i++) {
+		BindSummary u;
+		EStructBinding::fromBson(u, bson, "/user");
+		sum += u.id + u.level + u.flags + u.active + (llong)u.score + (llong)u.ratio + u.name.length() + u.home.zip;
+	}
+	t1 = ESystem::nanoTime();
+	LOG("EBson bound: %lldns/object", (t1 - t0) / loops);
+
+	t0 = ESystem::nanoTime();
+	for (int i = 0; i < loops; i++) {
+		EBsonView v(out.data(), out.size());
+		BindAddress h;
+		sum += v.getLLong("/user/id") + v.getInt("/user/level") + v.getInt("/user/flags");
+		sum += v.getInt("/user/active") + (llong)v.getDouble("/user/score");
+		sum += (llong)v.getFloat("/user/ratio") + v.getString("/user/name").length();
+		h.city = v.getString("/user/home/city");
+		h.zip = v.getInt("/user/home/zip");
+		sum += h.zip;
+	}
+	t1 = ESystem::nanoTime();
+	LOG("EBsonView by path: %lldns/object", (t1 - t0) / loops);
+
+	t0 = ESystem::nanoTime();
+	for (int i = 0; i < loops; i++) {
+		EBsonView v(out.data(), out.size());
+		BindSummary u;
+		EStructBinding::fromBson(u, v, "/user");
+		sum += u.id + u.level + u.flags + u.active + (llong)u.score + (llong)u.ratio + u.name.length() + u.home.zip;
+	}
+	t1 = ESystem::nanoTime();
+	LOG("EBsonView bound: %lldns/object", (t1 - t0) / loops);
+
+	EJsonParser parser;
+	EJsonValue root = parser.parse(json.c_str(), json.length());
+	t0 = ESystem::nanoTime();
+	for (int i = 0; i < loops; i++) {
+		BindAddress h;
+		sum += root["id"].getLLong() + root["level"].getInt() + root["flags"].getInt();
+		sum += root["active"].getBoolean() + (llong)root["score"].getDouble();
+		sum += (llong)root["ratio"].getDouble() + root["name"].getString().length();
+		h.city = root["home"]["city"].getString();
+		h.zip = root["home"]["zip"].getInt();
+		sum += h.zip;
+	}
+	t1 = ESystem::nanoTime();
+	LOG("EJsonValue by name: %lldns/object", (t1 - t0) / loops);
+
+	t0 = ESystem::nanoTime();
+	for (int i = 0; i < loops; i++) {
+		BindSummary u;
+		EStructBinding::fromJson(u, root);
+		sum += u.id + u.level + u.flags + u.active + (llong)u.score + (llong)u.ratio + u.name.length() + u.home.zip;
+	}
+	t1 = ESystem::nanoTime();
+	LOG("EJsonValue bound: %lldns/object", (t1 - t0) / loops);
+
+	// encoding
+	t0 = ESystem::nanoTime();
+	for (int i = 0; i < loops / 10; i++) {
+		EBson b;
+		b.add("/user", NULL);
+		b.addLLong("/user/id", user.id);
+		b.add("/user/name", user.name.c_str());
+		b.addByte("/user/active", user.active);
+		b.addShort("/user/level", user.level);
+		b.addByte("/user/flags", user.flags);
+		b.addFloat("/user/ratio", user.ratio);
+		b.addDouble("/user/score", user.score);
+		b.add("/user/home", NULL);
+		b.add("/user/home/city", user.home.city.c_str());
+		b.addInt("/user/home/zip", user.home.zip);
+		EByteBuffer e;
+		b.Export(&e, NULL, false);
+		sum += e.size();
+	}
+	t1 = ESystem::nanoTime();
+	LOG("EBson add by path + export (9 fields): %lldns/object", (t1 - t0) / (loops / 10));
+
+	BindSummary summary;
+	EStructBinding::fromBson(summary, view, "/user");
+	t0 = ESystem::nanoTime();
+	for (int i = 0; i < loops / 10; i++) {
+		EByteArrayOutputStream e(512, false);
+		EStructBinding::toBson(&e, "user", summary);
+		sum += e.size();
+	}
+	t1 = ESystem::nanoTime();
+	LOG("toBson (9 fields): %lldns/object", (t1 - t0) / (loops / 10));
+
+	LOG("sum=%lld", sum);
+}
+
 MAIN_IMPL(testbson) {
 	printf("main()\n");
 
@@ -168,6 +588,9 @@ MAIN_IMPL(testbson) {
 //		test_bson_parser();
 //		test_bson_parser();
 		test_performance();
+//		test_bson_view();
+//		test_bson_push();
+//		test_struct_binding();
 
 		} catch (EException& e) {
 			LOG("exception: %s", e.getMessage());
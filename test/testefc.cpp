@@ -321,6 +321,418 @@ static void test_string() {
 	}
 }
 
+static void test_string_simd() {
+	es_uint32_t paths[] = {0, ES_CPU_AVX2, ES_CPU_AVX2 | ES_CPU_SSE42 | ES_CPU_SSE2};
+	const char* names[] = {"native", "no avx2", "portable"};
+
+	//1. the same results as std::string on every dispatch path
+	ERandom rnd(1);
+	for (int k = 0; k < 3; k++) {
+		eso_cpu_disable(paths[k]);
+		for (int i = 0; i < 50000; i++) {
+			char buf[200], pat[8];
+			int n = rnd.nextInt(sizeof(buf));
+			int m = rnd.nextInt(sizeof(pat));
+			for (int j = 0; j < n; j++) buf[j] = "aAbB= \0"[rnd.nextInt(7)];
+			for (int j = 0; j < m; j++) pat[j] = "aAbB= \0"[rnd.nextInt(7)];
+			EString s(buf, n);
+			std::string ss(buf, n), sp(pat, m);
+			int from = rnd.nextInt(n + 2) - 1;
+			ES_ASSERT(s.indexOf(sp, from) == (int)ss.find(sp, from < 0 ? 0 : from));
+			ES_ASSERT(s.lastIndexOf(sp) == (int)ss.rfind(sp));
+			ES_ASSERT(s.lastIndexOf(sp, from) == (int)ss.rfind(sp, from));
+			ES_ASSERT(s.lastIndexOf('b', from) == (int)ss.rfind('b', from));
+
+			EString u(s);
+			u.toUpperCase();
+			ES_ASSERT(u.equalsIgnoreCase(ss) && u.compareNoCase(s) == 0);
+			ES_ASSERT(u.length() == 0 || u.regionMatches(true, 0, &s, 0, u.length()));
+
+			int h = 0;
+			for (int j = 0; j < n; j++) h = 31 * h + buf[j];
+			ES_ASSERT(EString(buf, n).hashCode() == h);
+
+			EStringTokenizer st(s.c_str(), "= ");
+			std::string::size_type p = ss.find_first_not_of("= ");
+			while (p != std::string::npos && ss[p] != '\0') {
+				std::string::size_type e = ss.find_first_of("= ", p);
+				e = ES_MIN(e, ss.find('\0', p));
+				std::string token = ss.substr(p, e - p);
+				EString next = st.nextToken();
+				ES_ASSERT(next.equals(token));
+				p = ss.find_first_not_of("= ", e);
+			}
+			ES_ASSERT(!st.hasMoreTokens());
+
+			int idx = rnd.nextInt(4) + 1, j = 1;
+			std::string::size_type b = 0, e = ss.find("b=");
+			for (; j < idx && e != std::string::npos; j++) {
+				b = e + 2;
+				e = ss.find("b=", b);
+			}
+			std::string part = (j < idx) ? "" : ss.substr(b, (e == std::string::npos) ? e : e - b);
+			ES_ASSERT(s.splitAt("b=", idx).equals(part));
+		}
+		LOG("%s path ok.", names[k]);
+	}
+	eso_cpu_disable(0);
+
+	ES_ASSERT(eso_strsimd_utf8_valid("\xE4\xB8\xAD\xE6\x96\x87 utf-8", 12));
+	ES_ASSERT(!eso_strsimd_utf8_valid("\xED\xA0\x80", 3)); //surrogate
+	ES_ASSERT(!eso_strsimd_utf8_valid("\xC0\xAF", 2)); //overlong
+
+	//2. throughput
+	EString text;
+	for (int i = 0; i < 1024 * 16; i++) {
+		text.append("The=Java=platform=is=the=ideal=platform=for=network=computing;");
+	}
+	int len = text.length();
+	for (int k = 0; k < 3; k++) {
+		eso_cpu_disable(paths[k]);
+		llong startTime, endTime;
+		int loops = 100, r = 0;
+
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) r += text.indexOf("computingX");
+		endTime = ESystem::nanoTime();
+		LOG("[%s] indexOf: %.0f MB/s", names[k], (double)len * loops * 1000 / (endTime - startTime));
+
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) r += text.lastIndexOf("Xcomputing");
+		endTime = ESystem::nanoTime();
+		LOG("[%s] lastIndexOf: %.0f MB/s", names[k], (double)len * loops * 1000 / (endTime - startTime));
+
+		EString lower(text);
+		lower.toLowerCase();
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) r += lower.equalsIgnoreCase(text);
+		endTime = ESystem::nanoTime();
+		LOG("[%s] equalsIgnoreCase: %.0f MB/s", names[k], (double)len * loops * 1000 / (endTime - startTime));
+
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) lower.toUpperCase();
+		endTime = ESystem::nanoTime();
+		LOG("[%s] toUpperCase: %.0f MB/s", names[k], (double)len * loops * 1000 / (endTime - startTime));
+
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) r += EString(text).hashCode();
+		endTime = ESystem::nanoTime();
+		LOG("[%s] hashCode: %.0f MB/s", names[k], (double)len * loops * 1000 / (endTime - startTime));
+
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) r += eso_strsimd_utf8_valid(text.c_str(), len);
+		endTime = ESystem::nanoTime();
+		LOG("[%s] utf8 validate: %.0f MB/s", names[k], (double)len * loops * 1000 / (endTime - startTime));
+
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops / 10; i++) {
+			EStringTokenizer st(text.c_str(), ";");
+			while (st.hasMoreTokens()) r += st.nextToken().length();
+		}
+		endTime = ESystem::nanoTime();
+		LOG("[%s] tokenize: %.0f MB/s (%d)", names[k], (double)len * (loops / 10) * 1000 / (endTime - startTime), r);
+	}
+	eso_cpu_disable(0);
+}
+
+static es_uint32_t checksum_ref(es_uint32_t poly, es_uint32_t c, const byte *p, int len) {
+	while (len--) {
+		c ^= (es_uint8_t)*p++;
+		for (int k = 0; k < 8; k++) c = (c & 1) ? (c >> 1) ^ poly : c >> 1;
+	}
+	return c;
+}
+
+static void test_checksum() {
+	es_uint32_t paths[] = {0, ES_CPU_AVX2 | ES_CPU_PCLMUL | ES_CPU_SSE42};
+	const char* names[] = {"native", "portable"};
+
+	//1. known values
+	ES_ASSERT(eso_crc32_calc((es_byte_t*)"123456789", 9) == 0xCBF43926);
+	ES_ASSERT(eso_crc32c_calc((es_byte_t*)"123456789", 9) == 0xE3069283);
+	ES_ASSERT(eso_adler32_update(1, (es_byte_t*)"Wikipedia", 9) == 0x11E60398);
+
+	//2. the same results as the bitwise definitions, by pieces, on every path
+	ERandom rnd(1);
+	EA<byte> buf(70000);
+	for (int i = 0; i < buf.length(); i++) buf[i] = (byte)rnd.nextInt();
+	for (int k = 0; k < 2; k++) {
+		eso_cpu_disable(paths[k]);
+		for (int i = 0; i < 3000; i++) {
+			int off = rnd.nextInt(64);
+			int len = (i % 10 == 0) ? rnd.nextInt(buf.length() - off) : rnd.nextInt(600);
+			byte *p = buf.address() + off;
+			int cut = rnd.nextInt(len + 1);
+
+			ECRC32 crc;
+			ECRC32C crcc;
+			EAdler32 adler;
+			crc.update(p, cut);
+			crc.update(p + cut, len - cut);
+			crcc.update(p, cut);
+			crcc.update(p + cut, len - cut);
+			adler.update(p, cut);
+			adler.update(p + cut, len - cut);
+
+			ES_ASSERT(crc.getValue() == (llong)~checksum_ref(0xEDB88320, ~0, p, len));
+			ES_ASSERT(crc.getValue() == (llong)~checksum_ref(0xEDB88320, ~0, p, len)); //idempotent
+			ES_ASSERT(crcc.getValue() == (llong)~checksum_ref(0x82F63B78, ~0, p, len));
+
+			es_uint32_t s1 = 1, s2 = 0;
+			for (int j = 0; j < len; j++) {
+				s1 = (s1 + (es_uint8_t)p[j]) % 65521;
+				s2 = (s2 + s1) % 65521;
+			}
+			ES_ASSERT(adler.getValue() == (llong)((s2 << 16) | s1));
+		}
+		LOG("%s path ok.", names[k]);
+	}
+	eso_cpu_disable(0);
+
+	//3. throughput
+	int size = 1024 * 1024;
+	EA<byte> data(size);
+	for (int i = 0; i < size; i++) data[i] = (byte)rnd.nextInt();
+	int loops = 200;
+	llong startTime, endTime;
+	es_uint32_t r = 0;
+
+	// the former one byte per lookup loop
+	es_uint32_t table[256];
+	for (int n = 0; n < 256; n++) {
+		es_uint32_t c = n;
+		for (int j = 0; j < 8; j++) c = (c & 1) ? (c >> 1) ^ 0xEDB88320 : c >> 1;
+		table[n] = c;
+	}
+	startTime = ESystem::nanoTime();
+	for (int i = 0; i < loops / 10; i++) {
+		es_uint32_t c = 0xffffffff;
+		es_uint8_t *p = (es_uint8_t*)data.address();
+		for (int j = 0; j < size; j++) c = table[(c ^ p[j]) & 0xff] ^ (c >> 8);
+		r += c;
+	}
+	endTime = ESystem::nanoTime();
+	LOG("[bytewise] crc32: %.2f GB/s", (double)size * (loops / 10) / (endTime - startTime));
+
+	for (int k = 0; k < 2; k++) {
+		eso_cpu_disable(paths[k]);
+
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) r += eso_crc32_calc((es_byte_t*)data.address(), size);
+		endTime = ESystem::nanoTime();
+		LOG("[%s] crc32: %.2f GB/s", names[k], (double)size * loops / (endTime - startTime));
+
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) r += eso_crc32c_calc((es_byte_t*)data.address(), size);
+		endTime = ESystem::nanoTime();
+		LOG("[%s] crc32c: %.2f GB/s", names[k], (double)size * loops / (endTime - startTime));
+
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) r += eso_adler32_update(1, (es_byte_t*)data.address(), size);
+		endTime = ESystem::nanoTime();
+		LOG("[%s] adler32: %.2f GB/s", names[k], (double)size * loops / (endTime - startTime));
+	}
+	eso_cpu_disable(0);
+	LOG("r=%u", r);
+}
+
+static void test_stringpool() {
+	// strong mode: same chars, same object
+	{
+		EStringPool pool;
+		sp<const EString> a = pool.intern("hello");
+		sp<const EString> b = pool.intern(EString("hello"));
+		sp<const EString> c = pool.intern("hello world", 5);
+		ES_ASSERT(a.get() == b.get() && b.get() == c.get());
+		ES_ASSERT(pool.lookup("hello", 5).get() == a.get());
+		ES_ASSERT(pool.lookup("hellO", 5) == null);
+		sp<const EString> empty = pool.intern((char*)null);
+		ES_ASSERT(empty->length() == 0);
+		ES_ASSERT(pool.size() == 2);
+
+		char buf[32];
+		for (int i = 0; i < 100000; i++) {
+			eso_snprintf(buf, sizeof(buf), "key%d", i);
+			pool.intern(buf);
+		}
+		ES_ASSERT(pool.size() == 100002);
+		for (int i = 0; i < 100000; i += 7) {
+			eso_snprintf(buf, sizeof(buf), "key%d", i);
+			sp<const EString> s = pool.lookup(buf, eso_strlen(buf));
+			ES_ASSERT(s != null && *s == buf);
+		}
+		sp<const EString> d = pool.intern("hello");
+		ES_ASSERT(d.get() == a.get());
+		LOG("strong pool size=%d", pool.size());
+	}
+
+	// weak mode: entries go away with the last handle
+	{
+		EStringPool pool(true);
+		sp<const EString> keep = pool.intern("keep");
+		char buf[32];
+		for (int i = 0; i < 10000; i++) {
+			eso_snprintf(buf, sizeof(buf), "tmp%d", i);
+			pool.intern(buf);
+		}
+		LOG("weak pool size=%d before purge", pool.size());
+		int n = pool.purge();
+		LOG("weak pool purged=%d, size=%d", n, pool.size());
+		ES_ASSERT(pool.size() == 1);
+		ES_ASSERT(pool.lookup("tmp1", 4) == null);
+		ES_ASSERT(pool.lookup("keep", 4).get() == keep.get());
+	}
+
+	// concurrent interning: every thread must get the same objects
+	{
+		class Interner : public ERunnable {
+		public:
+			Interner(EStringPool* pool, int keys) : pool(pool), keys(keys) {
+				got = new sp<const EString>[keys];
+			}
+			virtual ~Interner() {
+				delete[] got;
+			}
+			virtual void run() {
+				char buf[32];
+				for (int i = 0; i < keys; i++) {
+					int k = (i * 7919) % keys;
+					eso_snprintf(buf, sizeof(buf), "k%d", k);
+					got[k] = pool->intern(buf);
+				}
+			}
+			EStringPool* pool;
+			int keys;
+			sp<const EString>* got; // handles kept so weak entries stay alive
+		};
+
+		for (int m = 0; m < 2; m++) {
+			EStringPool pool(m == 1);
+			int keys = 50000;
+			EArray<sp<Interner> > tasks;
+			EArray<EThread*> arr;
+			for (int i = 0; i < 8; i++) {
+				sp<Interner> r(new Interner(&pool, keys));
+				EThread* t = new EThread(r);
+				tasks.add(r);
+				arr.add(t);
+				t->start();
+			}
+			for (int i = 0; i < arr.length(); i++) {
+				arr.getAt(i)->join();
+			}
+			int errors = 0;
+			char buf[32];
+			for (int k = 0; k < keys; k++) {
+				eso_snprintf(buf, sizeof(buf), "k%d", k);
+				const EString* first = tasks.getAt(0)->got[k].get();
+				if (*first != buf) errors++;
+				for (int i = 1; i < tasks.length(); i++) {
+					if (tasks.getAt(i)->got[k].get() != first) errors++;
+				}
+			}
+			ES_ASSERT(pool.size() == keys);
+			ES_ASSERT(errors == 0);
+			LOG("%s concurrent intern: size=%d, errors=%d", m ? "weak" : "strong", pool.size(), errors);
+		}
+	}
+
+	// lookups going on while the entries are evicted and the tables grow
+	{
+		class Looker : public ERunnable {
+		public:
+			Looker(EStringPool* pool, const EString* keep) : pool(pool), keep(keep),
+					stop(false), lookups(0), misses(0) {
+			}
+			virtual void run() {
+				while (!stop) {
+					if (pool->lookup("keep", 4).get() != keep) misses++;
+					lookups++;
+				}
+			}
+			EStringPool* pool;
+			const EString* keep;
+			volatile boolean stop;
+			llong lookups;
+			int misses;
+		};
+
+		EStringPool pool(true, 1);
+		sp<const EString> keep = pool.intern("keep");
+		EArray<sp<Looker> > tasks;
+		EArray<EThread*> arr;
+		for (int i = 0; i < 4; i++) {
+			sp<Looker> r(new Looker(&pool, keep.get()));
+			EThread* t = new EThread(r);
+			tasks.add(r);
+			arr.add(t);
+			t->start();
+		}
+		char buf[32];
+		for (int i = 0; i < 200000; i++) {
+			eso_snprintf(buf, sizeof(buf), "tmp%d", i);
+			pool.intern(buf);
+			if (i % 1000 == 0) pool.purge();
+		}
+		llong lookups = 0;
+		int misses = 0;
+		for (int i = 0; i < arr.length(); i++) {
+			tasks.getAt(i)->stop = true;
+			arr.getAt(i)->join();
+			lookups += tasks.getAt(i)->lookups;
+			misses += tasks.getAt(i)->misses;
+		}
+		pool.purge();
+		ES_ASSERT(misses == 0 && pool.size() == 1);
+		LOG("lookups during eviction: %lld, misses=%d", lookups, misses);
+	}
+
+	// interned keys: shared storage, cached hash, pointer compare
+	{
+		EStringPool pool;
+		int keys = 10000;
+		int loops = 100;
+		EArray<EString*> names;
+		EArray<sp<const EString> > pooled;
+		char buf[64];
+		llong bytes = 0;
+		for (int i = 0; i < keys; i++) {
+			eso_snprintf(buf, sizeof(buf), "com.example.app.Property%d", i % 1000);
+			names.add(new EString(buf));
+			bytes += eso_strlen(buf) + 1;
+		}
+
+		llong startTime, midTime, endTime;
+		int r = 0;
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < keys; i++) {
+			pooled.add(pool.intern(*names.getAt(i)));
+		}
+		midTime = ESystem::nanoTime();
+		LOG("intern: %lldns/op, %d distinct of %d, %lld of %lld bytes",
+				(midTime - startTime) / keys, pool.size(), keys,
+				bytes * pool.size() / keys, bytes);
+
+		startTime = ESystem::nanoTime();
+		for (int l = 0; l < loops; l++) {
+			for (int i = 0; i < keys; i++) {
+				EString s(*names.getAt(i));
+				r += s.hashCode() + s.equals(*names.getAt((i + 1000) % keys));
+			}
+		}
+		midTime = ESystem::nanoTime();
+		for (int l = 0; l < loops; l++) {
+			for (int i = 0; i < keys; i++) {
+				const EString* s = pooled.getAt(i).get();
+				r += s->hashCode() + (s == pooled.getAt((i + 1000) % keys).get());
+			}
+		}
+		endTime = ESystem::nanoTime();
+		LOG("hash+equals, fresh strings: %lldus, interned: %lldus (%d)",
+				(midTime - startTime) / 1000, (endTime - midTime) / 1000, r);
+	}
+}
+
 static void test_simpleMap() {
 	ESimpleMap map(true, false);
 	map.put("1", new EString("aaa"));
@@ -2970,6 +3382,143 @@ static void test_hashset() {
 	}
 }
 
+static void test_hashing() {
+	EHashing::Policy policies[] = {EHashing::JAVA, EHashing::WYHASH, EHashing::WYHASH_SEEDED};
+	const char* names[] = {"java", "wyhash", "wyhash seeded"};
+
+	//1. same content with every policy, also after switching
+	{
+		EHashMap<EString*, EInteger*> map(true, true);
+		EHashSet<int> set;
+		EConcurrentHashMap<EString, EInteger> chm(16, 0.75, 16, EHashing::WYHASH_SEEDED);
+		for (int i = 0; i < 10000; i++) {
+			map.put(new EString(EString::formatOf("key%d", i)), new EInteger(i));
+			set.add(i * 7);
+			chm.put(new EString(EString::formatOf("key%d", i)), new EInteger(i));
+		}
+		for (int k = 0; k < 3; k++) {
+			map.setHashPolicy(policies[k]);
+			set.setHashPolicy(policies[k]);
+			ES_ASSERT(map.size() == 10000 && set.size() == 10000);
+			for (int i = 0; i < 10000; i++) {
+				EString key(EString::formatOf("key%d", i));
+				ES_ASSERT(map.get(&key)->intValue() == i);
+				ES_ASSERT(chm.get(&key)->intValue() == i);
+				ES_ASSERT(set.contains(i * 7) && !set.contains(i * 7 + 1));
+			}
+		}
+		LOG("seed=%llx", eso_hash_seed());
+	}
+
+	//float keys hash by their bits, not truncated to integers
+	{
+		llong seed = EHashing::seedOf(EHashing::WYHASH);
+		int h1 = EHashing::hash32(0.25, seed), h2 = EHashing::hash32(0.75, seed);
+		int h3 = EHashing::hash32(0.25f, seed), h4 = EHashing::hash32(0.75f, seed);
+		int h5 = EHashing::hash32(-0.0, seed), h6 = EHashing::hash32(0.0, seed);
+		ES_ASSERT(h1 != h2 && h3 != h4 && h5 == h6);
+		LOG("float keys: %08x %08x %08x %08x %08x %08x", h1, h2, h3, h4, h5, h6);
+	}
+
+	//2. collisions: bucket quality of url/uuid keys and a hashCode() flood
+	{
+		const int N = 1 << 16;
+		EA<EString*> urls(N), uuids(N), flood(N);
+		for (int i = 0; i < N; i++) {
+			urls[i] = new EString(EString::formatOf("http://www.example.com/item/%d/detail?page=%d", i % 256, i / 256));
+			es_uuid_t uuid;
+			char buf[ES_UUID_FORMATTED_LENGTH + 1];
+			eso_uuid_get(&uuid);
+			eso_uuid_format(buf, &uuid);
+			uuids[i] = new EString(buf);
+			// "Aa" and "BB" have the same hashCode(), so do all the 16 blocks strings
+			EString* s = new EString();
+			for (int b = 0; b < 16; b++) s->append((i >> b) & 1 ? "Aa" : "BB");
+			flood[i] = s;
+		}
+
+		EA<EString*>* keys[] = {&urls, &uuids, &flood};
+		const char* keyNames[] = {"url", "uuid", "flood"};
+		for (int t = 0; t < 3; t++) {
+			for (int k = 0; k < 3; k++) {
+				llong seed = EHashing::seedOf(policies[k]);
+				int* buckets = new int[N]();
+				int used = 0, longest = 0;
+				for (int i = 0; i < N; i++) {
+					EString* key = (*keys[t])[i];
+					int h = seed ? EHashing::hash32(key, seed)
+							: EHashMap<EString*, EString*>::hashIt(key->hashCode());
+					int c = ++buckets[h & (N - 1)];
+					if (c == 1) used++;
+					if (c > longest) longest = c;
+				}
+				delete[] buckets;
+				LOG("[%s] %s keys: %d/%d buckets used, longest chain %d", names[k], keyNames[t], used, N, longest);
+			}
+		}
+
+		for (int k = 0; k < 3; k++) {
+			EHashing::setDefaultPolicy(policies[k]);
+			EHashMap<EString*, EString*> map(false, false);
+			llong startTime = ESystem::currentTimeMillis();
+			for (int i = 0; i < N / 4; i++) {
+				map.put(flood[i], flood[i]);
+			}
+			llong endTime = ESystem::currentTimeMillis();
+			LOG("[%s] put %d flood keys: %lldms", names[k], N / 4, endTime - startTime);
+		}
+		EHashing::setDefaultPolicy(EHashing::JAVA);
+	}
+
+	//3. throughput
+	{
+		char data[1024];
+		for (int i = 0; i < (int)sizeof(data); i++) data[i] = 'a' + i % 26;
+		int lens[] = {16, 64, 1024};
+		for (int l = 0; l < 3; l++) {
+			int len = lens[l];
+			int loops = 64 * 1024 * 1024 / len;
+			llong r = 0;
+			llong startTime = ESystem::nanoTime();
+			for (int i = 0; i < loops; i++) {
+				int h = 0;
+				for (int j = 0; j < len; j++) h = 31 * h + data[j];
+				r += h;
+				data[0] = (char)r;
+			}
+			llong midTime = ESystem::nanoTime();
+			for (int i = 0; i < loops; i++) {
+				r += EHashing::hash64(data, len, r);
+				data[0] = (char)r;
+			}
+			llong endTime = ESystem::nanoTime();
+			LOG("len %d: h*31+c %.0f MB/s, wyhash %.0f MB/s (%lld)", len,
+					(double)len * loops * 1000 / (midTime - startTime),
+					(double)len * loops * 1000 / (endTime - midTime), r);
+		}
+
+		const int N = 200000;
+		EA<EString*> keys(N);
+		for (int i = 0; i < N; i++) {
+			keys[i] = new EString(EString::formatOf("http://www.example.com/item/%d", i));
+		}
+		es_hashfunc_t* funcs[] = {NULL, eso_hashfunc_wyhash};
+		for (int k = 0; k < 2; k++) {
+			es_hash_t* ht = eso_hash_make(16, funcs[k]);
+			llong startTime = ESystem::currentTimeMillis();
+			for (int i = 0; i < N; i++) {
+				eso_hash_set(ht, keys[i]->c_str(), ES_HASH_KEY_STRING, keys[i]);
+			}
+			for (int i = 0; i < N; i++) {
+				ES_ASSERT(eso_hash_get(ht, keys[i]->c_str(), ES_HASH_KEY_STRING) == keys[i]);
+			}
+			llong endTime = ESystem::currentTimeMillis();
+			LOG("eso_hash %s: %d set+get %lldms", k ? "wyhash" : "times33", N, endTime - startTime);
+			eso_hash_free(&ht);
+		}
+	}
+}
+
 static void test_treemap() {
 	ETreeMap<EInteger*,EString*> tm;
 
@@ -3379,6 +3928,23 @@ static void test_float()
 
     EFloat t1 = EFloat::valueOf(4.3434);
     LOG("f3 %d", EFloat::valueOf(4.3434).equals(&t1));
+
+    //shortest round-trip on randomized bit patterns
+    ERandom random;
+    int failed = 0;
+    for (int i = 0; i < 1000000; i++) {
+    	float v = EFloat::intBitsToFloat(random.nextInt());
+    	if (v != v) continue; //NaN
+    	EString s = EFloat::toString(v);
+    	if (EFloat::floatToIntBits(EFloat::parseFloat(s.c_str())) != EFloat::floatToIntBits(v)) {
+    		if (failed++ < 10) LOG("round-trip failed: %s", s.c_str());
+    	}
+    }
+    LOG("f4 round-trip failed=%d", failed);
+
+    EString min = EFloat::toString(EFloat::MIN_VALUE);
+    LOG("f5=%s", min.c_str()); //1.4E-45
+    ES_ASSERT(min.equals("1.4E-45"));
 }
 
 static void test_double()
@@ -3390,6 +3956,45 @@ static void test_double()
 
     EDouble t1 = EDouble::valueOf(4.3434);
     LOG("d3 %d", EDouble::valueOf(4.3434).equals(&t1));
+
+    LOG("d4=%s", EDouble::toString(1e21).c_str()); //1.0E21
+    LOG("d5=%s", EDouble::toString(0.001).c_str()); //0.001
+    LOG("d6=%s", EDouble::toString(-0.0).c_str()); //-0.0
+    LOG("d7=%lf", EDouble::parseDouble(" 1.5e-3d ")); //0.0015
+    EString min = EDouble::toString(EDouble::MIN_VALUE);
+    EString one = EString::valueOf(1.0);
+    LOG("d9=%s, %s", min.c_str(), one.c_str()); //4.9E-324, 1.0
+    ES_ASSERT(min.equals("4.9E-324") && one.equals("1.0"));
+    ES_ASSERT(EDouble::toString(1e23).equals("1.0E23") && EDouble::toString(0.001).equals("0.001"));
+
+    //shortest round-trip on randomized bit patterns
+    ERandom random;
+    int failed = 0;
+    for (int i = 0; i < 1000000; i++) {
+    	double v = EDouble::llongBitsToDouble(random.nextLLong());
+    	if (v != v) continue; //NaN
+    	EString s = EDouble::toString(v);
+    	if (EDouble::doubleToLLongBits(EDouble::parseDouble(s.c_str())) != EDouble::doubleToLLongBits(v)) {
+    		if (failed++ < 10) LOG("round-trip failed: %s", s.c_str());
+    	}
+    }
+    LOG("d8 round-trip failed=%d", failed);
+
+    //performance
+    char buf[64];
+    double sum = 0;
+    llong startTime = ESystem::nanoTime();
+    for (int i = 0; i < 1000000; i++) {
+    	eso_snprintf(buf, sizeof(buf), "%.17g", i * 1.1);
+    	sum += eso_atof(buf);
+    }
+    llong midTime = ESystem::nanoTime();
+    for (int i = 0; i < 1000000; i++) {
+    	eso_dtoa_shortest(i * 1.1, buf);
+    	sum += eso_parse_double(buf, NULL);
+    }
+    llong endTime = ESystem::nanoTime();
+    LOG("printf+atof: %lldms, dtoa+parse: %lldms (%lf)", (midTime - startTime) / 1000000, (endTime - midTime) / 1000000, sum);
 }
 
 static void test_filestream()
@@ -4127,6 +4732,763 @@ static void test_gzipstream() {
 	eso_buffer_free(&buffer);
 }
 
+static void test_gzipstream_parallel() {
+	// log like, about 40 MB
+	EByteArrayOutputStream data;
+	ERandom rnd(7);
+	while (data.size() < 40 * 1024 * 1024) {
+		EString line = EString::formatOf("2017-12-%02d 10:%02d:%02d.%03d INFO [worker-%d] request %d from 10.0.%d.%d took %d ms\n",
+				rnd.nextInt(31) + 1, rnd.nextInt(60), rnd.nextInt(60), rnd.nextInt(1000),
+				rnd.nextInt(32), rnd.nextInt(), rnd.nextInt(256), rnd.nextInt(256), rnd.nextInt(5000));
+		data.write(line.c_str(), line.length());
+	}
+	byte* d = (byte*)data.data();
+	int size = data.size();
+
+	int threads = ES_MAX(4, ERuntime::getRuntime()->availableProcessors());
+	EExecutorService* executor = EExecutors::newFixedThreadPool(threads);
+	llong startTime, endTime;
+
+	// serial
+	EByteArrayOutputStream serial;
+	startTime = ESystem::nanoTime();
+	{
+		EGZIPOutputStream gz(&serial, 8192);
+		gz.write(d, size);
+		gz.finish();
+	}
+	endTime = ESystem::nanoTime();
+	LOG("serial deflate: %.0f MB/s, %d -> %d", (double)size * 1000 / (endTime - startTime), size, serial.size());
+
+	// parallel, written by pieces, with a flush in the middle
+	EByteArrayOutputStream parallel;
+	startTime = ESystem::nanoTime();
+	{
+		EGZIPOutputStream gz(&parallel, executor);
+		int off = 0;
+		while (off < size) {
+			int n = rnd.nextInt(100000) + 1;
+			n = ES_MIN(size - off, n);
+			gz.write(d + off, n);
+			off += n;
+			if (off > size / 2 && off - n <= size / 2) gz.flush();
+		}
+		gz.finish();
+	}
+	endTime = ESystem::nanoTime();
+	EFileOutputStream("/tmp/gzparallel.gz").write(parallel.data(), parallel.size());
+	LOG("parallel deflate (%d threads, %d cpus): %.0f MB/s, %d -> %d", threads,
+			ERuntime::getRuntime()->availableProcessors(),
+			(double)size * 1000 / (endTime - startTime), size, parallel.size());
+
+	// both readers on both outputs
+	EByteArrayOutputStream* outputs[] = {&serial, &parallel};
+	EA<byte> buf(65536);
+	for (int i = 0; i < 2; i++) {
+		for (int k = 0; k < 2; k++) {
+			EByteArrayInputStream bais(outputs[i]->data(), outputs[i]->size());
+			EGZIPInputStream* gis = (k == 0) ? new EGZIPInputStream(&bais, 8192) : new EGZIPInputStream(&bais, executor);
+			int off = 0, n;
+			startTime = ESystem::nanoTime();
+			while ((n = gis->read(buf.address(), buf.length())) > 0) {
+				ES_ASSERT(off + n <= size && memcmp(buf.address(), d + off, n) == 0);
+				off += n;
+			}
+			endTime = ESystem::nanoTime();
+			ES_ASSERT(off == size);
+			gis->close();
+			delete gis;
+			LOG("%s inflate of the %s output: %.0f MB/s", (k == 0) ? "plain" : "readahead",
+					(i == 0) ? "serial" : "parallel", (double)size * 1000 / (endTime - startTime));
+		}
+	}
+
+	// empty input, and an exact number of blocks
+	for (int len = 0; len <= 2 * EGZIPOutputStream::DEFAULT_BLOCK_SIZE; len += EGZIPOutputStream::DEFAULT_BLOCK_SIZE) {
+		EByteArrayOutputStream baos;
+		{
+			EGZIPOutputStream gz(&baos, executor);
+			gz.write(d, len);
+			gz.finish();
+		}
+		EByteArrayInputStream bais(baos.data(), baos.size());
+		EGZIPInputStream gis(&bais, executor);
+		int off = 0, n;
+		while ((n = gis.read(buf.address(), buf.length())) > 0) off += n;
+		ES_ASSERT(off == len);
+	}
+
+	// a corrupt trailer is reported by read(), closing early stops the task
+	{
+		EByteArrayOutputStream baos;
+		{
+			EGZIPOutputStream gz(&baos, executor);
+			gz.write(d, 1000000);
+			gz.finish();
+		}
+		((byte*)baos.data())[baos.size() - 5] ^= 1;
+		EByteArrayInputStream bais(baos.data(), baos.size());
+		EGZIPInputStream gis(&bais, executor);
+		try {
+			while (gis.read(buf.address(), buf.length()) > 0) {
+			}
+			ES_ASSERT(false);
+		} catch (EIOException& e) {
+			LOG("expected: %s", e.getMessage());
+		}
+
+		EByteArrayInputStream bais2(parallel.data(), parallel.size());
+		EGZIPInputStream gis2(&bais2, executor);
+		gis2.read(buf.address(), 100);
+		gis2.close();
+	}
+
+	executor->shutdown();
+	executor->awaitTermination();
+	delete executor;
+}
+
+static void test_zlib_benchmark(const char* path) {
+	// the files of a corpus directory (silesia, say) if given, else 4MB
+	// of generated log lines with some random bytes between them
+	EByteArrayOutputStream corpus;
+	if (path && EFile(path).isDirectory()) {
+		EFile dir(path);
+		EArray<EFile*> files = dir.listFiles();
+		for (int i = 0; i < files.size(); i++) {
+			EFile* f = files.getAt(i);
+			if (!f->isFile()) continue;
+			EFileInputStream fis(f);
+			EA<byte> b((int)f->length());
+			int n = 0, r;
+			while (n < b.length() && (r = fis.read(b.address() + n, b.length() - n)) > 0) n += r;
+			corpus.write(b.address(), n);
+		}
+		LOG("corpus %s: %d files", path, files.size());
+	} else {
+		const char* words[] = {"GET", "POST", "/index.html", "/api/v1/users", "/static/app.js",
+				"OK", "Not Found", "timeout", "retry", "connection reset by peer"};
+		ERandom rnd(7);
+		while (corpus.size() < 4 * 1024 * 1024) {
+			EString line = EString::formatOf("2026-10-19 %02d:%02d:%02d.%03d INFO [worker-%d] %s %s from 10.0.%d.%d: %s in %dms\n",
+					rnd.nextInt(24), rnd.nextInt(60), rnd.nextInt(60), rnd.nextInt(1000), rnd.nextInt(16),
+					words[rnd.nextInt(2)], words[2 + rnd.nextInt(3)], rnd.nextInt(256), rnd.nextInt(256),
+					words[5 + rnd.nextInt(5)], rnd.nextInt(5000));
+			corpus.write(line.c_str(), line.length());
+			if (rnd.nextInt(16) == 0) {
+				byte noise[64];
+				rnd.nextBytes(noise, sizeof(noise));
+				corpus.write(noise, sizeof(noise));
+			}
+		}
+		LOG("corpus: generated");
+	}
+	byte* data = (byte*)corpus.data();
+	int size = corpus.size();
+	LOG("corpus: %d bytes", size);
+
+	int levels[] = {1, 6, 9};
+	EA<byte> packed(size + size / 100 + 1024);
+	EA<byte> unpacked(size);
+	for (int k = 0; k < 3; k++) {
+		llong startTime, endTime;
+		int loops = (levels[k] == 9) ? 2 : 4;
+		int plen = 0;
+
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) {
+			EDeflater def(levels[k]);
+			def.setInput(data, size);
+			def.finish();
+			plen = 0;
+			while (!def.finished()) {
+				plen += def.deflate(packed.address() + plen, packed.length() - plen, EDeflater::NO_FLUSH);
+			}
+		}
+		endTime = ESystem::nanoTime();
+		double deflateSpeed = (double)size * loops * 1000 / (endTime - startTime);
+
+		int ulen = 0;
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops * 4; i++) {
+			EInflater inf;
+			inf.setInput(packed.address(), plen);
+			ulen = 0;
+			while (!inf.finished()) {
+				ulen += inf.inflate(unpacked.address() + ulen, unpacked.length() - ulen);
+			}
+		}
+		endTime = ESystem::nanoTime();
+		double inflateSpeed = (double)size * loops * 4 * 1000 / (endTime - startTime);
+
+		ES_ASSERT(ulen == size && memcmp(unpacked.address(), data, size) == 0);
+		LOG("level %d: ratio %.3f, deflate %.1f MB/s, inflate %.1f MB/s",
+				levels[k], (double)size / plen, deflateSpeed, inflateSpeed);
+	}
+
+	// small output buffers go through the slow paths of inflate()
+	{
+		EDeflater def(6);
+		def.setInput(data, size);
+		def.finish();
+		int plen = 0;
+		while (!def.finished()) {
+			plen += def.deflate(packed.address() + plen, packed.length() - plen, EDeflater::NO_FLUSH);
+		}
+		ERandom rnd(3);
+		EInflater inf;
+		inf.setInput(packed.address(), plen);
+		int ulen = 0;
+		while (!inf.finished()) {
+			int n = rnd.nextInt(600) + 1;
+			n = ES_MIN(n, unpacked.length() - ulen);
+			ulen += inf.inflate(unpacked.address() + ulen, n);
+		}
+		ES_ASSERT(ulen == size && memcmp(unpacked.address(), data, size) == 0);
+	}
+}
+
+static void test_lz4() {
+	// log like, about 8 MB, then 1 MB of random bytes
+	EByteArrayOutputStream data;
+	ERandom rnd(11);
+	while (data.size() < 8 * 1024 * 1024) {
+		EString line = EString::formatOf("2017-12-%02d 10:%02d:%02d.%03d INFO [worker-%d] request %d from 10.0.%d.%d took %d ms\n",
+				rnd.nextInt(31) + 1, rnd.nextInt(60), rnd.nextInt(60), rnd.nextInt(1000),
+				rnd.nextInt(32), rnd.nextInt(), rnd.nextInt(256), rnd.nextInt(256), rnd.nextInt(5000));
+		data.write(line.c_str(), line.length());
+	}
+	int textSize = data.size();
+	for (int i = 0; i < 1024 * 1024 / 4; i++) {
+		int v = rnd.nextInt();
+		data.write(&v, 4);
+	}
+	byte* d = (byte*)data.data();
+	int size = data.size();
+	llong startTime, endTime;
+
+	// blocks around the limits of the format
+	int lens[] = {0, 1, 12, 13, 14, 100, 65535, 65536, 65537, 1000000};
+	for (int i = 0; i < (int)ES_ARRAY_LEN(lens); i++) {
+		int len = lens[i];
+		EA<byte> c(eso_lz4_compress_bound(len));
+		EA<byte> u(len + 16);
+		int clen = eso_lz4_compress(d, len, c.address(), c.length(), 1);
+		ES_ASSERT(clen > 0);
+		int ulen = eso_lz4_decompress(c.address(), clen, u.address(), len);
+		ES_ASSERT(ulen == len);
+		ES_ASSERT(memcmp(u.address(), d, len) == 0);
+		if (len > 0) {
+			ulen = eso_lz4_decompress(c.address(), clen, u.address(), len - 1);
+			ES_ASSERT(ulen < 0);
+		}
+		// the random part doesn't shrink, the bound holds
+		clen = eso_lz4_compress(d + size - len, len, c.address(), c.length(), 1);
+		ES_ASSERT(clen > 0 && clen <= eso_lz4_compress_bound(len));
+	}
+
+	// 64KB blocks of the text
+	for (int accel = 1; accel <= 8; accel *= 8) {
+		int blocks = (textSize + 65535) / 65536;
+		EA<byte> packed(eso_lz4_compress_bound(65536) * blocks);
+		EA<int> sizes(blocks);
+		EA<byte> unpacked(textSize);
+		int loops = 8, plen = 0;
+
+		startTime = ESystem::nanoTime();
+		for (int k = 0; k < loops; k++) {
+			plen = 0;
+			for (int i = 0; i < blocks; i++) {
+				int n = ES_MIN(65536, textSize - i * 65536);
+				sizes[i] = eso_lz4_compress(d + i * 65536, n, packed.address() + plen, packed.length() - plen, accel);
+				plen += sizes[i];
+			}
+		}
+		endTime = ESystem::nanoTime();
+		double compressSpeed = (double)textSize * loops * 1000 / (endTime - startTime);
+
+		startTime = ESystem::nanoTime();
+		for (int k = 0; k < loops * 4; k++) {
+			int off = 0;
+			for (int i = 0; i < blocks; i++) {
+				int n = ES_MIN(65536, textSize - i * 65536);
+				int r = eso_lz4_decompress(packed.address() + off, sizes[i], unpacked.address() + i * 65536, n);
+				ES_ASSERT(r == n);
+				off += sizes[i];
+			}
+		}
+		endTime = ESystem::nanoTime();
+		double decompressSpeed = (double)textSize * loops * 4 * 1000 / (endTime - startTime);
+
+		ES_ASSERT(memcmp(unpacked.address(), d, textSize) == 0);
+		LOG("lz4 acceleration %d: ratio %.3f, compress %.0f MB/s, decompress %.0f MB/s",
+				accel, (double)textSize / plen, compressSpeed, decompressSpeed);
+	}
+
+	// corrupt blocks fail, never overrun
+	{
+		EA<byte> c(eso_lz4_compress_bound(100000));
+		EA<byte> u(100000);
+		int clen = eso_lz4_compress(d, 100000, c.address(), c.length(), 1);
+		for (int i = 0; i < 2000; i++) {
+			int k = rnd.nextInt(clen);
+			byte old = c[k];
+			c[k] = (byte)(old ^ (rnd.nextInt(255) + 1));
+			int n = eso_lz4_decompress(c.address(), clen, u.address(), u.length());
+			ES_ASSERT(n <= u.length());
+			c[k] = old;
+		}
+	}
+
+	// frames
+	{
+		EA<byte> f((int)eso_lz4f_compress_bound(size));
+		EA<byte> u(size);
+		llong flen = eso_lz4f_compress(d, size, f.address(), f.length());
+		ES_ASSERT(flen > 0);
+		llong ulen = eso_lz4f_decompress(f.address(), flen, u.address(), size);
+		ES_ASSERT(ulen == size);
+		ES_ASSERT(memcmp(u.address(), d, size) == 0);
+		f[flen - 1] ^= 1; // the content checksum
+		ulen = eso_lz4f_decompress(f.address(), flen, u.address(), size);
+		ES_ASSERT(ulen < 0);
+	}
+
+	// streams, written and read by pieces, with a flush in the middle
+	int blockSizes[] = {ELZ4OutputStream::DEFAULT_BLOCK_SIZE, 4 * 1024 * 1024};
+	for (int b = 0; b < 2; b++) {
+		EByteArrayOutputStream baos;
+		startTime = ESystem::nanoTime();
+		{
+			ELZ4OutputStream lz(&baos, blockSizes[b]);
+			int off = 0;
+			while (off < size) {
+				int n = rnd.nextInt(200000) + 1;
+				n = ES_MIN(size - off, n);
+				lz.write(d + off, n);
+				off += n;
+				if (off > size / 2 && off - n <= size / 2) lz.flush();
+			}
+			lz.finish();
+		}
+		endTime = ESystem::nanoTime();
+		LOG("lz4 stream, %d KB blocks: %.0f MB/s, %d -> %d", blockSizes[b] / 1024,
+				(double)size * 1000 / (endTime - startTime), size, baos.size());
+		if (b == 0) {
+			// lz4 -t /tmp/lz4stream.lz4
+			EFileOutputStream("/tmp/lz4stream.lz4").write(baos.data(), baos.size());
+		}
+
+		EByteArrayInputStream bais(baos.data(), baos.size());
+		ELZ4InputStream lis(&bais);
+		EA<byte> buf(300000);
+		int off = 0, n;
+		while ((n = lis.read(buf.address(), rnd.nextInt(buf.length()) + 1)) > 0) {
+			ES_ASSERT(off + n <= size && memcmp(buf.address(), d + off, n) == 0);
+			off += n;
+		}
+		ES_ASSERT(off == size);
+
+		// a corrupt stream
+		((byte*)baos.data())[baos.size() / 2] ^= 0x55;
+		EByteArrayInputStream bais2(baos.data(), baos.size());
+		ELZ4InputStream lis2(&bais2);
+		try {
+			while (lis2.read(buf.address(), buf.length()) > 0) {
+			}
+			ES_ASSERT(false);
+		} catch (EIOException& e) {
+			LOG("expected: %s", e.getMessage());
+		}
+	}
+
+	// empty stream, and two concatenated frames
+	{
+		EByteArrayOutputStream baos;
+		{
+			ELZ4OutputStream lz(&baos);
+			lz.finish();
+		}
+		{
+			ELZ4OutputStream lz(&baos);
+			lz.write("abc", 3);
+			lz.finish();
+		}
+		EByteArrayInputStream bais(baos.data(), baos.size());
+		ELZ4InputStream lis(&bais);
+		char c[8];
+		int n = lis.read(c, sizeof(c));
+		ES_ASSERT(n == 3 && memcmp(c, "abc", 3) == 0);
+		n = lis.read(c, sizeof(c));
+		ES_ASSERT(n == -1);
+	}
+
+	// byte buffers
+	{
+		nio::EIOByteBuffer* src = nio::EIOByteBuffer::wrap(d, 100000);
+		nio::EIOByteBuffer* packed = nio::EIOByteBuffer::allocate(nio::EIOByteBuffer::lz4CompressBound(100000));
+		nio::EIOByteBuffer* unpacked = nio::EIOByteBuffer::allocate(100000);
+		int clen = src->lz4Compress(packed);
+		ES_ASSERT(!src->hasRemaining() && packed->position() == clen);
+		packed->flip();
+		int ulen = packed->lz4Decompress(unpacked);
+		ES_ASSERT(ulen == 100000);
+		ES_ASSERT(memcmp(unpacked->address(), d, 100000) == 0);
+		src->clear();
+		packed->clear();
+		packed->limit(100);
+		try {
+			src->lz4Compress(packed);
+			ES_ASSERT(false);
+		} catch (nio::EBufferOverflowException& e) {
+		}
+		delete src;
+		delete packed;
+		delete unpacked;
+	}
+}
+
+static void test_lzmastream() {
+	// log like, about 8 MB, then 1 MB of random bytes
+	EByteArrayOutputStream data;
+	ERandom rnd(13);
+	while (data.size() < 8 * 1024 * 1024) {
+		EString line = EString::formatOf("2017-12-%02d 10:%02d:%02d.%03d INFO [worker-%d] request %d from 10.0.%d.%d took %d ms\n",
+				rnd.nextInt(31) + 1, rnd.nextInt(60), rnd.nextInt(60), rnd.nextInt(1000),
+				rnd.nextInt(32), rnd.nextInt(), rnd.nextInt(256), rnd.nextInt(256), rnd.nextInt(5000));
+		data.write(line.c_str(), line.length());
+	}
+	for (int i = 0; i < 1024 * 1024 / 4; i++) {
+		int v = rnd.nextInt();
+		data.write(&v, 4);
+	}
+	byte* d = (byte*)data.data();
+	int size = data.size();
+	int blockSize = 1024 * 1024;
+	llong startTime, endTime;
+
+	// the block api
+	{
+		es_uint8_t props[ES_LZMA_PROPS_SIZE];
+		int rc = eso_lzma_props(props, 5, 65536);
+		ES_ASSERT(rc == ES_SZ_OK);
+		EA<byte> c(65536);
+		EA<byte> u(65536);
+		es_size_t clen = c.length();
+		rc = eso_lzma_compress(c.address(), &clen, d, 65536, 5, 65536);
+		ES_ASSERT(rc == ES_SZ_OK);
+		es_size_t ulen = 65536;
+		rc = eso_lzma_decompress(u.address(), &ulen, c.address(), &clen, props);
+		ES_ASSERT(rc == ES_SZ_OK);
+		ES_ASSERT(ulen == 65536 && memcmp(u.address(), d, ulen) == 0);
+		clen = 100;
+		rc = eso_lzma_compress(c.address(), &clen, d + size - 65536, 65536, 5, 65536);
+		ES_ASSERT(rc == ES_SZ_ERROR_OUTPUT_EOF);
+	}
+
+	// serial
+	EByteArrayOutputStream serial;
+	startTime = ESystem::nanoTime();
+	{
+		ELZMAOutputStream lz(&serial, ELZMAOutputStream::DEFAULT_LEVEL, blockSize);
+		int off = 0;
+		while (off < size) {
+			int n = rnd.nextInt(300000) + 1;
+			n = ES_MIN(size - off, n);
+			lz.write(d + off, n);
+			off += n;
+		}
+		lz.finish();
+	}
+	endTime = ESystem::nanoTime();
+	double serialRate = (double)size * 1000 / (endTime - startTime);
+	LOG("lzma serial compress: %.1f MB/s, %d -> %d", serialRate, size, serial.size());
+
+	startTime = ESystem::nanoTime();
+	{
+		EByteArrayInputStream bais(serial.data(), serial.size());
+		ELZMAInputStream lis(&bais);
+		EA<byte> buf(200000);
+		int off = 0, n;
+		while ((n = lis.read(buf.address(), buf.length())) > 0) {
+			ES_ASSERT(off + n <= size && memcmp(buf.address(), d + off, n) == 0);
+			off += n;
+		}
+		ES_ASSERT(off == size);
+	}
+	endTime = ESystem::nanoTime();
+	double serialDecRate = (double)size * 1000 / (endTime - startTime);
+	LOG("lzma serial decompress: %.1f MB/s", serialDecRate);
+
+	// parallel, the speedup by the number of threads
+	int cpus = ERuntime::getRuntime()->availableProcessors();
+	for (int threads = 1; threads <= ES_MAX(4, cpus); threads *= 2) {
+		EExecutorService* executor = EExecutors::newFixedThreadPool(threads);
+
+		EByteArrayOutputStream parallel;
+		startTime = ESystem::nanoTime();
+		{
+			ELZMAOutputStream lz(&parallel, executor, ELZMAOutputStream::DEFAULT_LEVEL, blockSize);
+			lz.write(d, size);
+			lz.finish();
+		}
+		endTime = ESystem::nanoTime();
+		double rate = (double)size * 1000 / (endTime - startTime);
+
+		// the blocks are the same whoever compresses them
+		ES_ASSERT(parallel.size() == serial.size());
+		ES_ASSERT(memcmp(parallel.data(), serial.data(), serial.size()) == 0);
+
+		startTime = ESystem::nanoTime();
+		{
+			EByteArrayInputStream bais(parallel.data(), parallel.size());
+			ELZMAInputStream lis(&bais, executor);
+			EA<byte> buf(100000);
+			int off = 0, n;
+			while ((n = lis.read(buf.address(), rnd.nextInt(buf.length()) + 1)) > 0) {
+				ES_ASSERT(off + n <= size && memcmp(buf.address(), d + off, n) == 0);
+				off += n;
+			}
+			ES_ASSERT(off == size);
+		}
+		endTime = ESystem::nanoTime();
+		double decRate = (double)size * 1000 / (endTime - startTime);
+		LOG("lzma %d threads (%d cpus): compress %.1f MB/s (x%.2f), decompress %.1f MB/s (x%.2f)",
+				threads, cpus, rate, rate / serialRate, decRate, decRate / serialDecRate);
+
+		executor->shutdown();
+		executor->awaitTermination();
+		delete executor;
+	}
+
+	EExecutorService* executor = EExecutors::newFixedThreadPool(2);
+
+	// a flush in the middle, and an empty stream
+	{
+		EByteArrayOutputStream baos;
+		{
+			ELZMAOutputStream lz(&baos, executor, 1, 65536);
+			lz.write(d, 1000);
+			lz.flush();
+			lz.write(d + 1000, 100000);
+			lz.close();
+		}
+		EByteArrayInputStream bais(baos.data(), baos.size());
+		ELZMAInputStream lis(&bais);
+		EA<byte> buf(101000);
+		int off = 0, n;
+		while ((n = lis.read(buf.address() + off, buf.length() - off)) > 0) {
+			off += n;
+		}
+		ES_ASSERT(off == 101000 && memcmp(buf.address(), d, off) == 0);
+
+		EByteArrayOutputStream empty;
+		ELZMAOutputStream(&empty).finish();
+		EByteArrayInputStream bais2(empty.data(), empty.size());
+		ELZMAInputStream lis2(&bais2, executor);
+		int b = lis2.read();
+		ES_ASSERT(b == -1);
+	}
+
+	// corrupt and truncated streams
+	{
+		byte* s = (byte*)serial.data();
+		int n = serial.size();
+		int offsets[] = {n / 3, n - 20};
+		EA<byte> buf(65536);
+		for (int i = 0; i < (int)ES_ARRAY_LEN(offsets); i++) {
+			s[offsets[i]] ^= 0x10;
+			EByteArrayInputStream bais(s, n);
+			ELZMAInputStream lis(&bais, executor);
+			try {
+				while (lis.read(buf.address(), buf.length()) > 0) {
+				}
+				ES_ASSERT(false);
+			} catch (EIOException& e) {
+				LOG("expected: %s", e.getMessage());
+			}
+			s[offsets[i]] ^= 0x10;
+		}
+
+		EByteArrayInputStream bais(s, n - 5);
+		ELZMAInputStream lis(&bais);
+		try {
+			while (lis.read(buf.address(), buf.length()) > 0) {
+			}
+			ES_ASSERT(false);
+		} catch (EEOFException& e) {
+			LOG("expected: truncated");
+		}
+	}
+
+	executor->shutdown();
+	executor->awaitTermination();
+	delete executor;
+}
+
+static void test_messagedigest() {
+	struct {
+		const char* algorithm;
+		const char* input;
+		const char* hex;
+	} vectors[] = {
+		{"MD5", "abc", "900150983cd24fb0d6963f7d28e17f72"},
+		{"SHA-1", "", "da39a3ee5e6b4b0d3255bfef95601890afd80709"},
+		{"SHA1", "abc", "a9993e364706816aba3e25717850c26c9cd0d89d"},
+		{"SHA-1", "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "84983e441c3bd26ebaae4aa1f95129e5e54670f1"},
+		{"SHA-256", "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+		{"sha256", "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+		{"SHA-256", "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+		{"SHA-384", "abc", "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7"},
+		{"SHA-512", "abc", "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f"}
+	};
+	const char* paths[] = {"native", "no sha"};
+
+	for (int k = 0; k < 2; k++) {
+		if (k == 1) {
+			eso_cpu_disable(ES_CPU_SHA);
+		}
+
+		//1. the known answers, whole and byte by byte
+		for (int i = 0; i < (int)ES_ARRAY_LEN(vectors); i++) {
+			EMessageDigest md(vectors[i].algorithm);
+			sp<EA<byte> > d = md.digest(vectors[i].input, eso_strlen(vectors[i].input));
+			ES_ASSERT(d->length() == md.getDigestLength());
+			char hex[EMessageDigest::MAX_DIGEST_LENGTH * 2 + 1];
+			for (int j = 0; j < d->length(); j++) {
+				eso_sprintf(hex + j * 2, "%02x", (*d)[j] & 0xff);
+			}
+			ES_ASSERT(eso_strcmp(hex, vectors[i].hex) == 0);
+
+			for (const char* p = vectors[i].input; *p; p++) {
+				md.update((byte)*p);
+			}
+			sp<EA<byte> > e = md.digest();
+			ES_ASSERT(EMessageDigest::isEqual(d->address(), d->length(), e->address(), e->length()));
+			LOG("%s(\"%.8s\")=%s", md.getAlgorithm(), vectors[i].input, hex);
+		}
+
+		//2. a million 'a', in odd sized pieces across the block boundaries
+		{
+			EA<byte> a(1000000);
+			eso_memset(a.address(), 'a', a.length());
+			EMessageDigest sha1("SHA-1"), sha256("SHA-256");
+			for (int off = 0, n = 1; off < a.length(); off += n, n = n * 3 % 997 + 1) {
+				n = ES_MIN(n, a.length() - off);
+				sha1.update(a.address() + off, n);
+				sha256.update(a.address() + off, n);
+			}
+			byte d1[20], d2[32];
+			sha1.digest(d1, sizeof(d1));
+			sha256.digest(d2, sizeof(d2));
+			ES_ASSERT(memcmp(d1, "\x34\xaa\x97\x3c\xd4\xc4\xda\xa4\xf6\x1e\xeb\x2b\xdb\xad\x27\x31\x65\x34\x01\x6f", 20) == 0);
+			ES_ASSERT(memcmp(d2, "\xcd\xc7\x6e\x5c\x99\x14\xfb\x92\x81\xa1\xc7\xe2\x84\xd7\x3e\x67\xf1\x80\x9a\x48\xa4\x97\x20\x0e\x04\x6d\x39\xcc\xc7\x11\x2c\xd0", 32) == 0);
+		}
+
+		//3. the batch of sha256 as hashed one by one
+		{
+			const int N = 300;
+			ERandom rnd(k);
+			EA<byte> pool(N * 200);
+			for (int i = 0; i < pool.length(); i++) pool[i] = (byte)rnd.nextInt();
+			const void* data[N];
+			int len[N];
+			for (int i = 0; i < N; i++) {
+				data[i] = pool.address() + rnd.nextInt(N * 100);
+				len[i] = rnd.nextInt(200);
+			}
+			EA<byte> digests(N * 32);
+			EMessageDigest::sha256(data, len, digests.address(), N);
+			EMessageDigest md("SHA-256");
+			for (int i = 0; i < N; i++) {
+				sp<EA<byte> > d = md.digest(data[i], len[i]);
+				ES_ASSERT(memcmp(d->address(), digests.address() + i * 32, 32) == 0);
+			}
+		}
+
+		//4. throughput
+		{
+			EA<byte> buf(1024 * 1024);
+			const char* names[] = {"SHA-1", "SHA-256", "SHA-512"};
+			for (int i = 0; i < 3; i++) {
+				EMessageDigest md(names[i]);
+				llong t1 = ESystem::nanoTime();
+				for (int j = 0; j < 64; j++) {
+					md.update(buf.address(), buf.length());
+				}
+				md.digest();
+				llong t2 = ESystem::nanoTime();
+				LOG("%s %s: %lld MB/s", paths[k], names[i], 64LL * 1000000000LL / ES_MAX(t2 - t1, 1));
+			}
+
+			const int N = 64 * 1024;
+			EA<byte> small(N * 64);
+			const void** data = new const void*[N];
+			int* len = new int[N];
+			for (int i = 0; i < N; i++) {
+				data[i] = small.address() + i * 64;
+				len[i] = 64;
+			}
+			EA<byte> digests(N * 32);
+			llong t1 = ESystem::nanoTime();
+			EMessageDigest::sha256(data, len, digests.address(), N);
+			llong t2 = ESystem::nanoTime();
+			EMessageDigest md("SHA-256");
+			for (int i = 0; i < N; i++) {
+				md.update(data[i], len[i]);
+				md.digest(digests.address() + i * 32, 32);
+			}
+			llong t3 = ESystem::nanoTime();
+			LOG("%s SHA-256 of 64 bytes x %d: batch %lld MB/s, one by one %lld MB/s", paths[k], N,
+					(llong)N * 64 * 1000 / ES_MAX(t2 - t1, 1), (llong)N * 64 * 1000 / ES_MAX(t3 - t2, 1));
+			delete[] data;
+			delete[] len;
+		}
+	}
+
+	//5. the digest streams
+	{
+		EByteArrayOutputStream baos;
+		EMessageDigest mdo("SHA-256"), mdi("SHA-256");
+		EDigestOutputStream dos(&baos, &mdo);
+		dos.write("hello ");
+		dos.on(false);
+		dos.write("not digested ");
+		dos.on(true);
+		dos.write('w');
+		dos.write("orld");
+		dos.flush();
+		sp<EA<byte> > d = mdo.digest();
+		sp<EA<byte> > e = EMessageDigest("SHA-256").digest("hello world", 11);
+		ES_ASSERT(EMessageDigest::isEqual(d->address(), d->length(), e->address(), e->length()));
+
+		EByteArrayInputStream bais(baos.data(), baos.size());
+		EDigestInputStream dis(&bais, &mdi);
+		char buf[32];
+		int n = dis.read(buf, 6);
+		ES_ASSERT(n == 6);
+		dis.on(false);
+		n = dis.read(buf, 13);
+		ES_ASSERT(n == 13);
+		dis.on(true);
+		n = dis.read();
+		ES_ASSERT(n == 'w');
+		while (dis.read(buf, sizeof(buf)) > 0) {
+		}
+		sp<EA<byte> > f = mdi.digest();
+		ES_ASSERT(EMessageDigest::isEqual(d->address(), d->length(), f->address(), f->length()));
+		ES_ASSERT(!EMessageDigest::isEqual(d->address(), d->length(), f->address(), f->length() - 1));
+		LOG("%s", dis.toString().c_str());
+	}
+
+	try {
+		EMessageDigest md("SHA-3");
+		ES_ASSERT(false);
+	} catch (EIllegalArgumentException& e) {
+		LOG("expected: %s", e.getMessage());
+	}
+}
+
 static void test_sequencestream() {
 	EByteArrayInputStream bis1((void*)"1234567890", 10);
 	EByteArrayInputStream bis2((void*)"0987654321", 10);
@@ -8817,6 +10179,229 @@ static void test_bson() {
 	bson__.save("/tmp/bson2.txt", NULL);
 }
 
+static void test_json_parser() {
+	EJsonParser parser;
+
+	// values and lookups
+	const char *s = "{\"a\": 1, \"b\": [true, false, null, -2.5e3, \"x\\\"y\"],"
+			" \"c\": {\"d\\u0065\": \"\\u6211\\ud83d\\ude00\"}, \"e\": {}, \"f\": [], \"g\": 9223372036854775807}";
+	EJsonValue root = parser.parse(s);
+	ES_ASSERT(root.isObject() && root.size() == 6);
+	ES_ASSERT(root["a"].getInt() == 1);
+	ES_ASSERT(root["b"].size() == 5);
+	ES_ASSERT(root["b"][0].getBoolean() && !root["b"][1].getBoolean());
+	ES_ASSERT(root["b"][2].isNull() && root["b"][2].getLLong(7) == 7);
+	ES_ASSERT(root["b"][3].getDouble() == -2500.0 && root["b"][3].getLLong() == -2500);
+	ES_ASSERT(eso_strcmp(root["b"][4].getString().c_str(), "x\"y") == 0);
+	ES_ASSERT(root["b"][5].isUndefined() && root["zz"].isUndefined());
+	ES_ASSERT(eso_strcmp(root["c"]["de"].getString().c_str(), "\xe6\x88\x91\xf0\x9f\x98\x80") == 0);
+	ES_ASSERT(root["e"].isObject() && root["e"].size() == 0 && root["f"].size() == 0);
+	ES_ASSERT(root["g"].getLLong() == LLONG(9223372036854775807));
+	ES_ASSERT(eso_strcmp(root["f"].toString().c_str(), "[]") == 0);
+	EString keys;
+	for (EJsonValue v = root.first(); !v.isUndefined(); v = v.next()) {
+		keys << v.key();
+	}
+	ES_ASSERT(eso_strcmp(keys.c_str(), "abcefg") == 0);
+	LOG("c=%s", root["c"].toString().c_str());
+
+	// malformed
+	const char *bad[] = { "", " ", "{", "[1,]", "{\"a\" 1}", "{\"a\":1,}", "[1 2]", "01", "1.",
+			"-", "tru", "nulll", "\"abc", "[\"a\tb\"]", "{\"a\":1}}", "[1]x", "{1:2}",
+			"\"\\x\"", "\"\xff\"", "[\x01]", "[\"\\d83d\"]", "{\"a\": \"\\u42d\"}",
+			"{\"\\ud83d\": 1}", "[1, {\"b\": [\"\\ude00\"]}]" };
+	for (int i = 0; i < (int)ES_ARRAY_LEN(bad); i++) {
+		boolean failed = false;
+		try {
+			parser.parse(bad[i]);
+		} catch (EDataFormatException& e) {
+			failed = true;
+		}
+		ES_ASSERT(failed);
+	}
+
+	// writer
+	root = parser.parse(s);
+	EByteArrayOutputStream baos;
+	{
+		EJsonWriter w(&baos);
+		w.startObject().key("s").value("t\"\\\n\x01").key("n").value(-12345LL).key("d").value(0.1);
+		w.key("b").value(true).key("z").nullValue().key("a").startArray().value(1).value(2).endArray();
+		w.key("raw").value(root["c"]).endObject();
+	}
+	EString out((char*)baos.data(), baos.size());
+	LOG("writer=%s", out.c_str());
+	ES_ASSERT(eso_strcmp(out.c_str(), "{\"s\":\"t\\\"\\\\\\n\\u0001\",\"n\":-12345,\"d\":0.1,"
+			"\"b\":true,\"z\":null,\"a\":[1,2],\"raw\":{\"d\\u0065\": \"\\u6211\\ud83d\\ude00\"}}") == 0);
+	EJsonValue r2 = parser.parse(out.c_str(), out.length());
+	ES_ASSERT(eso_strcmp(r2["s"].getString().c_str(), "t\"\\\n\x01") == 0);
+	ES_ASSERT(r2["d"].getDouble() == 0.1);
+}
+
+class JsonCounter: public EJsonHandler {
+public:
+	int objects, arrays, keys, strings, numbers, literals, depth, maxDepth;
+	llong sum;
+	JsonCounter() : objects(0), arrays(0), keys(0), strings(0), numbers(0),
+			literals(0), depth(0), maxDepth(0), sum(0) {
+	}
+	virtual void startObject() { objects++; if (++depth > maxDepth) maxDepth = depth; }
+	virtual void endObject() { depth--; }
+	virtual void startArray() { arrays++; if (++depth > maxDepth) maxDepth = depth; }
+	virtual void endArray() { depth--; }
+	virtual void key(const char *s, int len) { keys++; }
+	virtual void string(const char *s, int len) { strings++; sum += len; }
+	virtual void number(const char *text, int len) { numbers++; }
+	virtual void booleanValue(boolean value) { literals++; }
+	virtual void nullValue() { literals++; }
+};
+
+/* copies a value with the getters, to check they give back what was written */
+static void json_copy(EJsonValue v, EJsonWriter& w) {
+	switch (v.type()) {
+	case EJsonValue::TYPE_OBJECT:
+		w.startObject();
+		for (EJsonValue m = v.first(); !m.isUndefined(); m = m.next()) {
+			w.key(m.key().c_str());
+			json_copy(m, w);
+		}
+		w.endObject();
+		break;
+	case EJsonValue::TYPE_ARRAY:
+		w.startArray();
+		for (EJsonValue e = v.first(); !e.isUndefined(); e = e.next()) {
+			json_copy(e, w);
+		}
+		w.endArray();
+		break;
+	case EJsonValue::TYPE_STRING:
+		w.value(v.getString());
+		break;
+	case EJsonValue::TYPE_NUMBER: {
+		int len;
+		const char *raw = v.raw(&len);
+		if (memchr(raw, '.', len) || memchr(raw, 'e', len)) w.value(v.getDouble());
+		else w.value(v.getLLong());
+		break;
+	}
+	case EJsonValue::TYPE_BOOLEAN:
+		w.value(v.getBoolean());
+		break;
+	default:
+		w.nullValue();
+		break;
+	}
+}
+
+static void test_json_benchmark() {
+	// a twitter-like document
+	EByteArrayOutputStream doc(16 * 1024 * 1024, false);
+	int users = 30000;
+	llong idSum = 0;
+	{
+		EJsonWriter w(&doc);
+		ullong x = 88172645463325252LL;
+		w.startObject().key("statuses").startArray();
+		for (int i = 0; i < users; i++) {
+			x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+			llong id = (llong)(x >> 8);
+			idSum += id;
+			char text[128];
+			eso_sprintf(text, "RT @user%d: \"quoted\" \xe4\xbd\xa0\xe5\xa5\xbd #tag%d\nhttp://t.co/%llx", i, (int)(x % 100), x);
+			w.startObject();
+			w.key("id").value(id).key("id_str").value(EString(id));
+			w.key("text").value(text);
+			w.key("user").startObject();
+			w.key("id").value((llong)(x % 1000000)).key("name").value("name\\with/escapes");
+			w.key("followers_count").value((int)(x % 50000)).key("verified").value(i % 7 == 0);
+			w.key("profile").value("http://a0.twimg.com/profile_images/1/normal.jpg");
+			w.endObject();
+			w.key("entities").startObject().key("hashtags").startArray();
+			for (int k = 0; k < (int)(x % 4); k++) {
+				w.startObject().key("text").value("tag").key("indices").startArray().value(k).value(k + 4).endArray().endObject();
+			}
+			w.endArray().endObject();
+			w.key("retweet_count").value((int)(x % 300)).key("favorited").value(false);
+			w.key("coordinates").nullValue().key("score").value((double)(x % 100000) / 1024.0);
+			w.endObject();
+		}
+		w.endArray().key("count").value(users).endObject();
+	}
+	const char *text = (const char*)doc.data();
+	int len = doc.size();
+	LOG("document: %d bytes", len);
+
+	EJsonParser parser;
+	llong t0, t1;
+	llong sum = 0;
+	int loops = 10;
+
+	// parse and read all ids
+	t0 = ESystem::nanoTime();
+	for (int n = 0; n < loops; n++) {
+		EJsonValue root = parser.parse(text, len);
+		sum = 0;
+		for (EJsonValue s = root["statuses"].first(); !s.isUndefined(); s = s.next()) {
+			sum += s["id"].getLLong();
+		}
+	}
+	t1 = ESystem::nanoTime();
+	ES_ASSERT(sum == idSum);
+	LOG("EJsonParser parse+ids: %.2f ms, %.0f MB/s, structurals=%d",
+			(t1 - t0) / 1e6 / loops, (double)len * loops / ((t1 - t0) / 1e3), parser.structurals());
+
+	// parse only
+	t0 = ESystem::nanoTime();
+	for (int n = 0; n < loops; n++) {
+		parser.parse(text, len);
+	}
+	t1 = ESystem::nanoTime();
+	LOG("EJsonParser parse: %.2f ms, %.0f MB/s",
+			(t1 - t0) / 1e6 / loops, (double)len * loops / ((t1 - t0) / 1e3));
+
+	// the recursive one, which builds a node per value
+	EString copy(text, len);
+	t0 = ESystem::nanoTime();
+	for (int n = 0; n < loops; n++) {
+		es_json_t *json = eso_json_make(copy.c_str());
+		ES_ASSERT(json);
+		es_json_t *st = eso_json_get_object_item(json, "statuses");
+		ES_ASSERT(eso_json_get_array_size(st) == users);
+		eso_json_free(&json);
+	}
+	t1 = ESystem::nanoTime();
+	LOG("eso_json_make: %.2f ms, %.0f MB/s",
+			(t1 - t0) / 1e6 / loops, (double)len * loops / ((t1 - t0) / 1e3));
+
+	// streaming
+	JsonCounter counter;
+	t0 = ESystem::nanoTime();
+	EByteArrayInputStream bais((void*)text, len, false);
+	parser.parse(&bais, &counter);
+	t1 = ESystem::nanoTime();
+	ES_ASSERT(counter.depth == 0 && counter.maxDepth == 7);
+	ES_ASSERT(counter.literals == users * 3);
+	LOG("EJsonParser stream: %.2f ms, objects=%d, arrays=%d, keys=%d, strings=%d, numbers=%d",
+			(t1 - t0) / 1e6, counter.objects, counter.arrays, counter.keys, counter.strings, counter.numbers);
+
+	// the same events from memory
+	JsonCounter counter2;
+	parser.parse(text, len, &counter2);
+	ES_ASSERT(counter2.keys == counter.keys && counter2.numbers == counter.numbers && counter2.sum == counter.sum);
+
+	// write back through the getters, the text is the same
+	EJsonValue root = parser.parse(text, len);
+	EByteArrayOutputStream back(len + 1024, false);
+	t0 = ESystem::nanoTime();
+	{
+		EJsonWriter w(&back);
+		json_copy(root, w);
+	}
+	t1 = ESystem::nanoTime();
+	ES_ASSERT(back.size() == len && memcmp(back.data(), text, len) == 0);
+	LOG("EJsonWriter copy: %.2f ms, %.0f MB/s", (t1 - t0) / 1e6, (double)len / ((t1 - t0) / 1e3));
+}
+
 static void test_threadPoolExecutor()
 {
 	class XXX : public ERunnable {
@@ -9790,6 +11375,108 @@ static void test_biginteger() {
 	LOG("hashcode=%d", bi1.hashCode());
 }
 
+static void test_biginteger_benchmark() {
+	// deterministic big numbers from a 64-bit LCG, in hex
+	class Gen {
+	public:
+		static EBigInteger make(int bits, ullong seed) {
+			EString hex;
+			ullong x = seed;
+			for (int i = 0; i < (bits + 3) / 4; i++) {
+				x = x * LLONG(6364136223846793005) + LLONG(1442695040888963407);
+				hex << "0123456789abcdef"[(i == 0) ? (1 + (x >> 60) % 15) : (x >> 60)];
+			}
+			return EBigInteger(hex.c_str(), 16);
+		}
+	};
+
+	llong startTime, endTime;
+
+	// multiply: check against (a*b)/b, (a*b)%b and the distributive law
+	int sizes[] = { 512, 2048, 8192, 32768, 131072 };
+	for (int k = 0; k < 5; k++) {
+		int bits = sizes[k];
+		EBigInteger a = Gen::make(bits, k + 1);
+		EBigInteger b = Gen::make(bits - 33, k + 100);
+		EBigInteger c = Gen::make(bits / 3, k + 200);
+		int loops = ES_MAX(1, (1 << 22) / bits);
+
+		EBigInteger p;
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) p = a * b;
+		endTime = ESystem::nanoTime();
+		LOG("multiply %d bits: %lldns", bits, (endTime - startTime) / loops);
+
+		EBigInteger q = p / b, r = p % b;
+		ES_ASSERT(q == a && r == 0);
+		EBigInteger bc = b + c, x = a * bc, y = a * c;
+		EBigInteger z = p + y;
+		ES_ASSERT(x == z);
+		EBigInteger a2(a);
+		EBigInteger sq = a * a, sq2 = a * a2;
+		ES_ASSERT(sq == sq2);
+	}
+
+	// radix conversion round trips
+	for (int k = 0; k < 5; k++) {
+		EBigInteger a = Gen::make(sizes[k], k + 300);
+		a = -a;
+
+		startTime = ESystem::nanoTime();
+		EString s = a.toString();
+		endTime = ESystem::nanoTime();
+		LOG("toString %d bits (%d digits): %lldus", sizes[k], s.length(), (endTime - startTime) / 1000);
+
+		startTime = ESystem::nanoTime();
+		EBigInteger b(s.c_str());
+		endTime = ESystem::nanoTime();
+		LOG("parse %d digits: %lldus", s.length(), (endTime - startTime) / 1000);
+		ES_ASSERT(a == b);
+
+		EString h = a.toString(16);
+		EBigInteger c(h.c_str(), 16);
+		ES_ASSERT(a == c);
+		EString t = a.toString(7);
+		EBigInteger d(t.c_str(), 7);
+		ES_ASSERT(a == d);
+	}
+	EBigInteger big = EBigInteger(10).pow(5000);
+	EString bs = big.toString();
+	ES_ASSERT(bs.length() == 5001 && bs[0] == '1' && bs.indexOf('1', 1) < 0);
+
+	// modPow: RSA round trips with Mersenne primes
+	int mexp[][2] = { { 521, 607 }, { 1279, 2203 } };
+	for (int k = 0; k < 2; k++) {
+		EBigInteger one(1);
+		EBigInteger p = EBigInteger(1).shiftLeft(mexp[k][0]) - one;
+		EBigInteger q = EBigInteger(1).shiftLeft(mexp[k][1]) - one;
+		EBigInteger n = p * q;
+		EBigInteger p1 = p - one, q1 = q - one;
+		EBigInteger phi = p1 * q1;
+		EBigInteger e(65537);
+		EBigInteger d = e.modInverse(phi);
+		EBigInteger m = Gen::make(n.bitLength() - 8, k + 400);
+
+		EBigInteger c = m.modPow(e, n);
+		int loops = (k == 0) ? 20 : 2;
+		EBigInteger m2;
+		startTime = ESystem::nanoTime();
+		for (int i = 0; i < loops; i++) m2 = c.modPow(d, n);
+		endTime = ESystem::nanoTime();
+		LOG("modPow %d bits: %lldus", n.bitLength(), (endTime - startTime) / 1000 / loops);
+		ES_ASSERT(m == m2);
+
+		// Fermat, and the even modulus path agrees
+		EBigInteger f = m.modPow(p1, p);
+		ES_ASSERT(f == 1);
+		EBigInteger n2 = n * 2;
+		EBigInteger x = c.modPow(d, n2) % n;
+		ES_ASSERT(x == m2);
+	}
+	EBigInteger b3(3), e3(-1), m7(7);
+	ES_ASSERT(b3.modPow(e3, m7) == 5);
+}
+
 static void test_bigdecimal() {
 	EBigDecimal d1("+9999343343.2004384010000");
 	EBigDecimal d2("9999343343.9004384340000");
@@ -10338,6 +12025,9 @@ static void test_test(int argc, const char** argv) {
 //	test_delete();
 //	test_traits();
 //	test_string();
+//	test_string_simd();
+//	test_checksum();
+//	test_stringpool();
 //	test_simpleMap();
 //	test_random();
 //	test_secureRandom();
@@ -10378,6 +12068,7 @@ static void test_test(int argc, const char** argv) {
 //	test_class2();
 //	test_hashmap();
 //	test_hashset();
+//	test_hashing();
 //	test_treemap();
 //	test_treeset();
 //	test_math();
@@ -10404,6 +12095,11 @@ static void test_test(int argc, const char** argv) {
 //	test_urlstring();
 //	test_datastream();
 //	test_gzipstream();
+//	test_gzipstream_parallel();
+//	test_zlib_benchmark(argc > 1 ? argv[1] : NULL);
+//	test_lz4();
+//	test_lzmastream();
+//	test_messagedigest();
 //	test_sequencestream();
 //	test_pattern();
 //	test_atomic();
@@ -10445,6 +12141,8 @@ static void test_test(int argc, const char** argv) {
 //	test_timer();
 //	test_priorityQueue();
 //	test_bson();
+//	test_json_parser();
+//	test_json_benchmark();
 //	test_threadPoolExecutor();
 //	test_file_read_write(argc > 1 ? argv[1] : "/tmp/f.out");
 //	test_buffered_stream();
@@ -10458,6 +12156,7 @@ static void test_test(int argc, const char** argv) {
 //	test_multicastSocket();
 	test_c_thread();
 //	test_biginteger();
+//	test_biginteger_benchmark();
 //	test_bigdecimal();
 //	test_pushbackInputStream();
 //	test_proterties();
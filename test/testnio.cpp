@@ -438,6 +438,1033 @@ static void test_nioudpserver() {
 	delete selector;
 }
 
+//===========================================================================
+
+#define IOURING_ECHO_CONNS 8
+#define IOURING_ECHO_MSG   64
+
+class IOUringResult: public ECompletionHandler {
+public:
+	int result;
+	int done;
+	IOUringResult(): result(0), done(0) {}
+	virtual void completed(int result, int flags) {
+		this->result = result;
+		done++;
+	}
+	virtual void failed(EIOException* exc) {
+		LOG("failed: %s", exc->getMessage());
+		result = -1;
+		done++;
+	}
+};
+
+static void test_iouring_file(EIOUring* ring) {
+	EFileChannel* fc = EFileChannel::open("./test_iouring.dat", true, true, false);
+	EIOByteBuffer* src = EIOByteBuffer::allocate(8192);
+	EIOByteBuffer* dst = EIOByteBuffer::allocate(8192);
+	EIOByteBuffer* buffers[] = {src, dst};
+	ring->registerBuffers(buffers, 2);
+
+	for (int i = 0; i < 8192; i++) {
+		src->put((byte)(i * 7));
+	}
+	src->flip();
+
+	IOUringResult h;
+	fc->write(src, 4096, ring, &h);
+	while (h.done < 1) ring->poll(-1);
+	ES_ASSERT(h.result == 8192 && src->remaining() == 0);
+
+	fc->read(dst, 4096, ring, &h);
+	while (h.done < 2) ring->poll(-1);
+	ES_ASSERT(h.result == 8192);
+	dst->flip();
+	for (int i = 0; i < 8192; i++) {
+		ES_ASSERT(dst->get() == (byte)(i * 7));
+	}
+
+	// at end-of-file
+	dst->clear();
+	fc->read(dst, 4096 + 8192, ring, &h);
+	while (h.done < 3) ring->poll(-1);
+	ES_ASSERT(h.result == -1);
+
+	ring->unregisterBuffers();
+	delete src;
+	delete dst;
+	delete fc;
+	EFile("./test_iouring.dat").remove();
+	LOG("io_uring file read/write ok");
+}
+
+/*
+ * Echo server on a selector.
+ */
+class IOUringSelectorServer: public EThread {
+public:
+	IOUringSelectorServer(EServerSocketChannel* ssc) :
+			ssc(ssc), stopped(false) {
+		selector = ESelector::open();
+	}
+	virtual ~IOUringSelectorServer() {
+		selector->close();
+		delete selector;
+	}
+	virtual void run() {
+		EIOByteBuffer buf(4096);
+		ssc->configureBlocking(false);
+		ssc->register_(selector, ESelectionKey::OP_ACCEPT);
+		while (!stopped) {
+			if (selector->select() == 0) continue;
+			sp<EIterator<sp<ESelectionKey> > > iter = selector->selectedKeys()->iterator();
+			while (iter->hasNext()) {
+				sp<ESelectionKey> key = iter->next();
+				iter->remove();
+				if (key->isAcceptable()) {
+					sp<ESocketChannel> client = ssc->accept();
+					if (client != null) {
+						client->configureBlocking(false);
+						client->register_(selector, ESelectionKey::OP_READ);
+					}
+				} else if (key->isReadable()) {
+					sp<ESocketChannel> client = dynamic_pointer_cast<ESocketChannel>(key->channel());
+					buf.clear();
+					if (client->read(&buf) < 0) {
+						client->close();
+						continue;
+					}
+					buf.flip();
+					while (buf.hasRemaining()) {
+						client->write(&buf);
+					}
+				}
+			}
+		}
+	}
+	void stop() {
+		stopped = true;
+		selector->wakeup();
+	}
+private:
+	EServerSocketChannel* ssc;
+	ESelector* selector;
+	volatile boolean stopped;
+};
+
+/*
+ * Echo server on the completion-based operations, with a multishot accept,
+ * and a read per message or a multishot receive into a provided buffer ring.
+ */
+class IOUringCompletionServer: public EThread {
+public:
+	IOUringCompletionServer(EServerSocketChannel* ssc, boolean multishot) :
+			ssc(ssc), multishot(multishot), stopped(false), acceptor(this) {
+		ring = new EIOUring();
+		if (multishot) {
+			ring->setupBufferRing(1, 64, 4096);
+		}
+	}
+	virtual ~IOUringCompletionServer() {
+		delete ring;
+	}
+	virtual void run() {
+		ssc->accept(ring, &acceptor, true);
+		while (!stopped) {
+			ring->poll(-1);
+		}
+		ring->close();
+	}
+	void stop() {
+		stopped = true;
+		ring->wakeup();
+	}
+
+private:
+	class Conn: public ECompletionHandler {
+	public:
+		IOUringCompletionServer* server;
+		sp<ESocketChannel> channel;
+		EIOByteBuffer buf;
+		boolean reading;
+		Conn(IOUringCompletionServer* server, ESocketChannel* channel) :
+				server(server), channel(channel), buf(4096), reading(true) {
+		}
+		void start() {
+			if (server->multishot) {
+				server->ring->recvMultishot(channel->getFDVal(), 1, this);
+			} else {
+				channel->read(&buf, server->ring, this);
+			}
+		}
+		virtual void completed(int result, int flags) {
+			if (reading && result <= 0) {
+				channel->close();
+			} else if (server->multishot) {
+				// sent from the provided buffer, which the send recycles
+				new Send(this, EIOUring::getBufferId(flags), result);
+			} else if (reading) {
+				reading = false;
+				buf.flip();
+				channel->write(&buf, server->ring, this);
+			} else if (buf.hasRemaining()) {
+				channel->write(&buf, server->ring, this);
+			} else {
+				reading = true;
+				buf.clear();
+				channel->read(&buf, server->ring, this);
+			}
+		}
+		virtual void failed(EIOException* exc) {
+			if (server->multishot && exc->getErrno() == ENOBUFS) {
+				start();
+			} else {
+				channel->close();
+			}
+		}
+	};
+
+	class Send: public ECompletionHandler {
+	public:
+		Conn* conn;
+		int bid;
+		EIOByteBuffer buf;
+		Send(Conn* conn, int bid, int len) : conn(conn), bid(bid),
+				buf(conn->server->ring->getBuffer(1, bid), len) {
+			conn->channel->write(&buf, conn->server->ring, this);
+		}
+		virtual void completed(int result, int flags) {
+			if (buf.hasRemaining()) {
+				conn->channel->write(&buf, conn->server->ring, this);
+				return;
+			}
+			conn->server->ring->recycleBuffer(1, bid);
+			delete this;
+		}
+		virtual void failed(EIOException* exc) {
+			conn->server->ring->recycleBuffer(1, bid);
+			delete this;
+		}
+	};
+
+	class Acceptor: public ECompletionHandler {
+	public:
+		IOUringCompletionServer* server;
+		Acceptor(IOUringCompletionServer* server) : server(server) {}
+		virtual void completed(int result, int flags) {
+			ESocketChannel* channel = server->ssc->accept(result);
+			channel->configureBlocking(false);
+			Conn* conn = new Conn(server, channel);
+			server->conns.add(conn);
+			conn->start();
+		}
+		virtual void failed(EIOException* exc) {
+		}
+	};
+
+	EServerSocketChannel* ssc;
+	EIOUring* ring;
+	boolean multishot;
+	volatile boolean stopped;
+	Acceptor acceptor;
+	EArrayList<Conn*> conns; // owns the connections
+};
+
+/*
+ * Ping-pongs 64 bytes messages on several connections for a second.
+ */
+template<typename S>
+static void test_iouring_echo(S* server, int port, const char* name) {
+	server->start();
+
+	EInetSocketAddress isa("127.0.0.1", port);
+	EArrayList<sp<ESocketChannel> > clients;
+	for (int i = 0; i < IOURING_ECHO_CONNS; i++) {
+		clients.add(ESocketChannel::open(&isa));
+	}
+
+	char msg[IOURING_ECHO_MSG];
+	eso_memset(msg, 'x', sizeof(msg));
+	EIOByteBuffer out((void*)msg, sizeof(msg));
+	EIOByteBuffer in(IOURING_ECHO_MSG);
+
+	llong messages = 0;
+	llong t1 = ESystem::currentTimeMillis();
+	llong t2 = t1;
+	while (t2 - t1 < 1000) {
+		for (int i = 0; i < clients.size(); i++) {
+			out.clear();
+			clients.getAt(i)->write(&out);
+		}
+		for (int i = 0; i < clients.size(); i++) {
+			in.clear();
+			while (in.hasRemaining()) {
+				int n = clients.getAt(i)->read(&in);
+				ES_ASSERT(n > 0);
+			}
+			ES_ASSERT(eso_memcmp(in.address(), msg, sizeof(msg)) == 0);
+		}
+		messages += clients.size();
+		t2 = ESystem::currentTimeMillis();
+	}
+
+	LOG("echo on %s: %d connections, %lld messages/s",
+			name, clients.size(), messages * 1000 / (t2 - t1));
+
+	for (int i = 0; i < clients.size(); i++) {
+		clients.getAt(i)->close();
+	}
+	server->stop();
+	server->join();
+}
+
+static void test_iouring() {
+	if (!EIOUring::isAvailable()) {
+		LOG("io_uring not available");
+		return;
+	}
+
+	EIOUring ring;
+	LOG("%s", ring.toString().c_str());
+	test_iouring_file(&ring);
+
+	for (int i = 0; i < 4; i++) {
+		int port = 8897 + i;
+		sp<EServerSocketChannel> ssc = EServerSocketChannel::open();
+		ssc->socket()->setReuseAddress(true);
+		EInetSocketAddress isa(port);
+		ssc->bind(&isa, 128);
+
+		if (i < 2) {
+			ESystem::setProperty("efc.nio.selector", i == 0 ? "epoll" : "io_uring");
+			sp<IOUringSelectorServer> server = new IOUringSelectorServer(ssc.get());
+			test_iouring_echo(server.get(), port, i == 0 ? "epoll selector" : "io_uring selector");
+		} else {
+			sp<IOUringCompletionServer> server = new IOUringCompletionServer(ssc.get(), i == 3);
+			test_iouring_echo(server.get(), port, i == 3 ? "completion, multishot recv" : "completion");
+		}
+		ssc->close();
+	}
+	ESystem::setProperty("efc.nio.selector", "");
+}
+
+#define SELECTOR_KEYS 256
+
+class ReadyCounter: public ESelectionKeyConsumer {
+public:
+	int count;
+	ReadyCounter() : count(0) {}
+	virtual void accept(ESelectionKey* key) {
+		if (key->isReadable()) {
+			count++;
+		}
+	}
+};
+
+class LateRegistration: public EThread {
+public:
+	ESelector* selector;
+	sp<ESocketChannel> channel;
+	LateRegistration(ESelector* selector, sp<ESocketChannel> channel) :
+			selector(selector), channel(channel) {
+	}
+	virtual void run() {
+		EThread::sleep(100);
+		channel->register_(selector, ESelectionKey::OP_READ);
+		selector->wakeup();
+	}
+};
+
+/*
+ * Selects a second long connections which are always readable, through the
+ * selected-key set and through an action.
+ */
+static void test_selector_consumer() {
+	sp<EServerSocketChannel> ssc = EServerSocketChannel::open();
+	ssc->socket()->setReuseAddress(true);
+	EInetSocketAddress isa(8901);
+	ssc->bind(&isa, SELECTOR_KEYS);
+	EInetSocketAddress local("127.0.0.1", 8901);
+
+	ESelector* selector = ESelector::open();
+	EArrayList<sp<ESocketChannel> > channels;
+	char c = 'x';
+	for (int i = 0; i <= SELECTOR_KEYS; i++) {
+		sp<ESocketChannel> client = ESocketChannel::open(&local);
+		sp<ESocketChannel> peer = ssc->accept();
+		EIOByteBuffer b((void*)&c, 1);
+		client->write(&b); // never read, the peer stays readable
+		peer->configureBlocking(false);
+		if (i < SELECTOR_KEYS) {
+			peer->register_(selector, ESelectionKey::OP_READ);
+		}
+		channels.add(client);
+		channels.add(peer);
+	}
+
+	// the registrations are applied by the next selection
+	int selected = selector->selectNow();
+	ES_ASSERT(selected == SELECTOR_KEYS);
+	ES_ASSERT(selector->keys()->size() == SELECTOR_KEYS);
+	selector->selectedKeys()->clear();
+
+	llong selections = 0;
+	llong t1 = ESystem::currentTimeMillis();
+	llong t2 = t1;
+	while (t2 - t1 < 1000) {
+		selected = selector->selectNow();
+		ES_ASSERT(selected == SELECTOR_KEYS);
+		int n = 0;
+		sp<EIterator<sp<ESelectionKey> > > iter = selector->selectedKeys()->iterator();
+		while (iter->hasNext()) {
+			sp<ESelectionKey> key = iter->next();
+			iter->remove();
+			if (key->isReadable()) {
+				n++;
+			}
+		}
+		ES_ASSERT(n == SELECTOR_KEYS);
+		selections++;
+		t2 = ESystem::currentTimeMillis();
+	}
+	LOG("selectNow() and selectedKeys(): %d keys, %lld selections/s",
+			SELECTOR_KEYS, selections * 1000 / (t2 - t1));
+
+	ReadyCounter counter;
+	selections = 0;
+	t1 = ESystem::currentTimeMillis();
+	t2 = t1;
+	while (t2 - t1 < 1000) {
+		counter.count = 0;
+		selected = selector->selectNow(&counter);
+		ES_ASSERT(selected == SELECTOR_KEYS);
+		ES_ASSERT(counter.count == SELECTOR_KEYS);
+		selections++;
+		t2 = ESystem::currentTimeMillis();
+	}
+	ES_ASSERT(selector->selectedKeys()->isEmpty());
+	LOG("selectNow(consumer): %d keys, %lld selections/s",
+			SELECTOR_KEYS, selections * 1000 / (t2 - t1));
+
+	// registered by another thread while the selector waits
+	sp<ESocketChannel> late = channels.getAt(channels.size() - 1);
+	LateRegistration registrar(selector, late);
+	registrar.start();
+	ESet<sp<ESelectionKey> >* keys = selector->keys();
+	t1 = ESystem::currentTimeMillis();
+	while (keys->size() == SELECTOR_KEYS) {
+		counter.count = 0;
+		selector->select(&counter, 5000);
+	}
+	t2 = ESystem::currentTimeMillis();
+	registrar.join();
+	ES_ASSERT(t2 - t1 < 5000);
+	counter.count = 0;
+	selected = selector->selectNow(&counter);
+	ES_ASSERT(selected == SELECTOR_KEYS + 1);
+	ES_ASSERT(late->keyFor(selector)->isReadable());
+
+	for (int i = 0; i < channels.size(); i++) {
+		channels.getAt(i)->close();
+	}
+	selector->close();
+	delete selector;
+	ssc->close();
+}
+
+#define WAKEUP_HANDOFFS 20000
+
+class WakeupLoop: public EThread {
+public:
+	ESelector* selector;
+	volatile llong submitted; // the time of the pending hand-off, or 0
+	volatile llong latency;   // the sum of the hand-off latencies
+	volatile int handoffs;
+	volatile boolean stopped;
+	WakeupLoop(ESelector* selector) : selector(selector), submitted(0),
+			latency(0), handoffs(0), stopped(false) {
+	}
+	virtual void run() {
+		while (!stopped) {
+			selector->select();
+			llong t = submitted;
+			if (t != 0) {
+				latency += ESystem::nanoTime() - t;
+				submitted = 0;
+				handoffs++;
+			}
+		}
+	}
+};
+
+/*
+ * Hands tasks over to a thread blocked in select(), one at a time, then
+ * floods the selector with wakeups.
+ */
+static void test_selector_wakeup() {
+	ESelector* selector = ESelector::open();
+	WakeupLoop loop(selector);
+	loop.start();
+
+	for (int i = 0; i < WAKEUP_HANDOFFS; i++) {
+		loop.submitted = ESystem::nanoTime();
+		selector->wakeup();
+		while (loop.submitted != 0) {
+			EThread::yield();
+		}
+	}
+	LOG("hand-off through wakeup(): %lld ns on average",
+			loop.latency / loop.handoffs);
+
+	llong wakeups = 0;
+	llong t1 = ESystem::currentTimeMillis();
+	llong t2 = t1;
+	while (t2 - t1 < 1000) {
+		for (int i = 0; i < 1000; i++) {
+			selector->wakeup();
+		}
+		wakeups += 1000;
+		t2 = ESystem::currentTimeMillis();
+	}
+	LOG("wakeup() flood: %lld wakeups/s", wakeups * 1000 / (t2 - t1));
+
+	loop.stopped = true;
+	selector->wakeup();
+	loop.join();
+	selector->close();
+	delete selector;
+}
+
+class EchoHandler: public EConnectionHandler {
+public:
+	virtual void opened(EReactorConnection* conn) {
+	}
+	virtual void received(EReactorConnection* conn, EIOByteBuffer* data) {
+		conn->write((char*)data->current(), data->remaining());
+	}
+	virtual void closed(EReactorConnection* conn) {
+	}
+};
+
+class EchoHandlerFactory: public EConnectionHandlerFactory {
+public:
+	virtual EConnectionHandler* newHandler() {
+		return new EchoHandler();
+	}
+};
+
+static void test_reactor_group() {
+	EchoHandlerFactory factory;
+	EReactorGroup group(&factory);
+	EInetSocketAddress isa("127.0.0.1", 0);
+	group.bind(&isa);
+	group.start();
+	LOG("%s", group.toString().c_str());
+
+	EInetSocketAddress remote("127.0.0.1", group.getLocalPort());
+	char msg[64] = {0};
+	EIOByteBuffer in(64);
+
+	// connections/s: connect, echo one byte, close
+	llong connections = 0;
+	llong t1 = ESystem::currentTimeMillis();
+	llong t2 = t1;
+	while (t2 - t1 < 1000) {
+		sp<ESocketChannel> sc(ESocketChannel::open(&remote));
+		EIOByteBuffer out(msg, 1);
+		sc->write(&out);
+		in.clear();
+		in.limit(1);
+		while (in.hasRemaining() && sc->read(&in) >= 0) {
+		}
+		sc->close();
+		connections++;
+		t2 = ESystem::currentTimeMillis();
+	}
+	LOG("connect/echo/close: %lld connections/s", connections * 1000 / (t2 - t1));
+
+	// echo throughput: 64-byte ping-pong over several connections
+	EA<ESocketChannel*> clients(8);
+	for (int i = 0; i < clients.length(); i++) {
+		clients[i] = ESocketChannel::open(&remote);
+	}
+	llong echoes = 0;
+	t1 = ESystem::currentTimeMillis();
+	t2 = t1;
+	while (t2 - t1 < 1000) {
+		for (int i = 0; i < clients.length(); i++) {
+			EIOByteBuffer out(msg, sizeof(msg));
+			clients[i]->write(&out);
+		}
+		for (int i = 0; i < clients.length(); i++) {
+			in.clear();
+			while (in.hasRemaining() && clients[i]->read(&in) >= 0) {
+			}
+		}
+		echoes += clients.length();
+		t2 = ESystem::currentTimeMillis();
+	}
+	LOG("echo: %lld messages/s, %d connections served", echoes * 1000 / (t2 - t1),
+			group.connectionCount());
+	for (int i = 0; i < clients.length(); i++) {
+		clients[i]->close();
+	}
+
+	// open and queued connections are all uncounted once closed
+	EA<ESocketChannel*> idle(8);
+	for (int i = 0; i < idle.length(); i++) {
+		idle[i] = ESocketChannel::open(&remote);
+	}
+	group.shutdown();
+	int left = group.connectionCount();
+	LOG("after shutdown: %d connections", left);
+	ES_ASSERT(left == 0);
+	for (int i = 0; i < idle.length(); i++) {
+		idle[i]->close();
+	}
+}
+
+#define UDP_BATCH 64
+
+static void test_udp_batch() {
+	sp<EDatagramChannel> rx(EDatagramChannel::open());
+	sp<EDatagramChannel> tx(EDatagramChannel::open());
+	EInetSocketAddress any("127.0.0.1", 0);
+	rx->bind(&any);
+	tx->bind(&any);
+	int rcvbuf = 8 * 1024 * 1024;
+	rx->setOption(ESocketOptions::_SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+	rx->configureBlocking(false);
+	EInetSocketAddress target("127.0.0.1", rx->getLocalAddress()->getPort());
+
+	EA<EIOByteBuffer*> out(UDP_BATCH);
+	EA<EIOByteBuffer*> in(UDP_BATCH);
+	for (int i = 0; i < UDP_BATCH; i++) {
+		out[i] = EIOByteBuffer::allocate(64);
+		in[i] = EIOByteBuffer::allocate(65536);
+	}
+	EA<sp<EInetSocketAddress> > sources(UDP_BATCH);
+	EA<int> segments(UDP_BATCH);
+
+	// one datagram per system call
+	llong packets = 0;
+	llong t1 = ESystem::currentTimeMillis();
+	llong t2 = t1;
+	while (t2 - t1 < 1000) {
+		for (int i = 0; i < UDP_BATCH; i++) {
+			out[i]->clear();
+			tx->send(out[i], &target);
+		}
+		for (int i = 0; i < UDP_BATCH; i++) {
+			in[i]->clear();
+			if (rx->receive(in[i]) == null) {
+				break;
+			}
+			packets++;
+		}
+		t2 = ESystem::currentTimeMillis();
+	}
+	LOG("send/receive: %lld packets/s", packets * 1000 / (t2 - t1));
+
+	// a batch per system call
+	packets = 0;
+	t1 = ESystem::currentTimeMillis();
+	t2 = t1;
+	while (t2 - t1 < 1000) {
+		for (int i = 0; i < UDP_BATCH; i++) {
+			out[i]->clear();
+			in[i]->clear();
+		}
+		tx->sendBatch(&out, &target);
+		packets += rx->receiveBatch(&in, &sources);
+		t2 = ESystem::currentTimeMillis();
+	}
+	LOG("sendBatch/receiveBatch: %lld packets/s", packets * 1000 / (t2 - t1));
+	ES_ASSERT(sources[0]->getPort() == tx->getLocalAddress()->getPort());
+
+	// segmentation and receive offloads
+	try {
+		int segment = 64;
+		tx->setOption(ESocketOptions::_UDP_SEGMENT, &segment, sizeof(segment));
+		int on = 1;
+		rx->setOption(ESocketOptions::_UDP_GRO, &on, sizeof(on));
+	} catch (ESocketException& e) {
+		LOG("UDP_SEGMENT/UDP_GRO not supported");
+		return;
+	}
+	EA<EIOByteBuffer*> super(1);
+	super[0] = EIOByteBuffer::allocate(64 * UDP_BATCH);
+	packets = 0;
+	t1 = ESystem::currentTimeMillis();
+	t2 = t1;
+	while (t2 - t1 < 1000) {
+		for (int i = 0; i < UDP_BATCH; i++) {
+			in[i]->clear();
+		}
+		super[0]->clear();
+		tx->sendBatch(&super, &target);
+		int n = rx->receiveBatch(&in, null, &segments);
+		for (int i = 0; i < n; i++) {
+			in[i]->flip();
+			packets += (segments[i] > 0) ? (in[i]->remaining() + segments[i] - 1) / segments[i] : 1;
+		}
+		t2 = ESystem::currentTimeMillis();
+	}
+	LOG("UDP_SEGMENT/UDP_GRO: %lld packets/s", packets * 1000 / (t2 - t1));
+}
+
+static llong proxy_relay(boolean splice) {
+	sp<EServerSocketChannel> ssc(EServerSocketChannel::open());
+	EInetSocketAddress any("127.0.0.1", 0);
+	ssc->bind(&any);
+	EInetSocketAddress isa("127.0.0.1", ssc->socket()->getLocalPort());
+	// client -> (in, proxy, out) -> server
+	sp<ESocketChannel> client(ESocketChannel::open(&isa));
+	sp<ESocketChannel> in(ssc->accept());
+	sp<ESocketChannel> out(ESocketChannel::open(&isa));
+	sp<ESocketChannel> server(ssc->accept());
+	client->configureBlocking(false);
+	in->configureBlocking(false);
+	out->configureBlocking(false);
+	server->configureBlocking(false);
+
+	EIOByteBuffer* src = EIOByteBuffer::allocate(65536);
+	EIOByteBuffer* dst = EIOByteBuffer::allocate(65536);
+	EIOByteBuffer* relay = EIOByteBuffer::allocate(65536);
+	relay->limit(0);
+	llong bytes = 0;
+	llong t1 = ESystem::currentTimeMillis();
+	llong t2 = t1;
+	while (t2 - t1 < 1000) {
+		src->clear();
+		client->write(src);
+		if (splice) {
+			in->transferTo(out.get());
+		} else {
+			// the read/write loop through user space
+			if (!relay->hasRemaining()) {
+				relay->clear();
+				in->read(relay);
+				relay->flip();
+			}
+			out->write(relay);
+		}
+		int n;
+		do {
+			dst->clear();
+			n = server->read(dst);
+			if (n > 0) {
+				bytes += n;
+			}
+		} while (n > 0);
+		t2 = ESystem::currentTimeMillis();
+	}
+	delete src;
+	delete dst;
+	delete relay;
+	return bytes * 1000 / (t2 - t1);
+}
+
+static void test_splice_proxy() {
+	LOG("read/write relay: %lld MB/s", proxy_relay(false) >> 20);
+	LOG("transferTo relay: %lld MB/s", proxy_relay(true) >> 20);
+
+	// tee: the same bytes held twice, read out of both pipes
+	sp<EPipeChannel> p1(EPipeChannel::open());
+	sp<EPipeChannel> p2(EPipeChannel::open());
+	EIOByteBuffer b((void*)"hello", 5);
+	p1->write(&b);
+	long teed = p1->tee(p2.get(), 5);
+	ES_ASSERT(teed == 5);
+	char c1[5], c2[5];
+	EIOByteBuffer r1(c1, 5), r2(c2, 5);
+	int n1 = p1->read(&r1);
+	int n2 = p2->read(&r2);
+	ES_ASSERT(n1 == 5 && n2 == 5);
+	ES_ASSERT(memcmp(c1, "hello", 5) == 0 && memcmp(c2, "hello", 5) == 0);
+	LOG("%s", p1->toString().c_str());
+}
+
+static llong zerocopy_drain(ESocketChannel* rx, EIOByteBuffer* dst) {
+	llong bytes = 0;
+	int n;
+	do {
+		dst->clear();
+		n = rx->read(dst);
+		if (n > 0) {
+			bytes += n;
+		}
+	} while (n > 0);
+	return bytes;
+}
+
+static void zerocopy_run(int size, boolean zerocopy) {
+	sp<EServerSocketChannel> ssc(EServerSocketChannel::open());
+	EInetSocketAddress any("127.0.0.1", 0);
+	ssc->bind(&any);
+	EInetSocketAddress isa("127.0.0.1", ssc->socket()->getLocalPort());
+	sp<ESocketChannel> tx(ESocketChannel::open(&isa));
+	sp<ESocketChannel> rx(ssc->accept());
+	tx->configureBlocking(false);
+	rx->configureBlocking(false);
+	ESelector* selector = ESelector::open();
+	tx->register_(selector, ESelectionKey::OP_WRITE);
+
+	sp<EIOByteBuffer> src(EIOByteBuffer::allocate(size));
+	EIOByteBuffer* dst = EIOByteBuffer::allocate(1024 * 1024);
+	llong bytes = 0;
+	clock_t c1 = clock();
+	llong t1 = ESystem::currentTimeMillis();
+	llong t2 = t1;
+	while (t2 - t1 < 1000) {
+		src->clear();
+		while (src->hasRemaining()) {
+			if (zerocopy) {
+				tx->writeZeroCopy(src);
+			} else {
+				tx->write(src.get());
+			}
+			bytes += zerocopy_drain(rx.get(), dst);
+		}
+		// the buffer is reused once the kernel is done with it, which on
+		// loopback is once the receiver has read the bytes
+		while (tx->zeroCopyPending() > 0) {
+			bytes += zerocopy_drain(rx.get(), dst);
+			selector->select(10);
+			selector->selectedKeys()->clear();
+		}
+		t2 = ESystem::currentTimeMillis();
+	}
+	double cpu = (double)(clock() - c1) / CLOCKS_PER_SEC;
+	LOG("%s %8d: %lld MB/s, %.2f cpu-s/GB, copied=%lld",
+			zerocopy ? "writeZeroCopy" : "write        ", size,
+			(bytes * 1000 / (t2 - t1)) >> 20, cpu * (1 << 30) / ES_MAX(bytes, 1),
+			tx->zeroCopyCopied());
+	selector->close();
+	delete selector;
+	delete dst;
+}
+
+static void test_zerocopy() {
+	int sizes[] = {64 * 1024, 1024 * 1024, 16 * 1024 * 1024};
+	for (int i = 0; i < 3; i++) {
+		zerocopy_run(sizes[i], false);
+		zerocopy_run(sizes[i], true);
+	}
+}
+
+static void test_buffer_pool() {
+	EIOByteBufferPool pool(true);
+
+	int sizes[] = {16 * 1024, 1024 * 1024};
+	for (int k = 0; k < 2; k++) {
+		int size = sizes[k];
+		int N = (k == 0) ? 1000000 : 20000;
+		llong t1 = ESystem::currentTimeMillis();
+		for (int i = 0; i < N; i++) {
+			EIOByteBuffer* b = EIOByteBuffer::allocate(size);
+			b->put(0, (byte)i)->put(size - 1, (byte)i);
+			delete b;
+		}
+		llong t2 = ESystem::currentTimeMillis();
+		LOG("allocate/delete %d: %lld ns", size, (t2 - t1) * 1000000 / N);
+
+		t1 = ESystem::currentTimeMillis();
+		for (int i = 0; i < N; i++) {
+			EPooledByteBuffer* b = pool.allocate(size);
+			b->put(0, (byte)i)->put(size - 1, (byte)i);
+			b->release();
+		}
+		t2 = ESystem::currentTimeMillis();
+		LOG("pool allocate/release %d: %lld ns", size, (t2 - t1) * 1000000 / N);
+	}
+
+	// page-aligned, slices keep their buffer alive
+	EPooledByteBuffer* b = pool.allocate(8192);
+	ES_ASSERT(((long)b->address() & 4095) == 0);
+	b->putInt(0, 0x12345678);
+	EPooledByteBuffer* s = b->retainedSlice(0, 4);
+	ES_ASSERT(b->refCnt() == 2);
+	boolean freed = b->release();
+	ES_ASSERT(!freed);
+	ES_ASSERT(s->getInt(0) == 0x12345678);
+	freed = s->release();
+	ES_ASSERT(freed);
+
+	// scattering reads into pooled buffers
+	sp<EServerSocketChannel> ssc(EServerSocketChannel::open());
+	EInetSocketAddress any("127.0.0.1", 0);
+	ssc->bind(&any);
+	EInetSocketAddress isa("127.0.0.1", ssc->socket()->getLocalPort());
+	sp<ESocketChannel> tx(ESocketChannel::open(&isa));
+	sp<ESocketChannel> rx(ssc->accept());
+	EIOByteBuffer data(6000);
+	tx->write(&data);
+	EA<EIOByteBuffer*> dsts(4);
+	int n = 0;
+	while (n < 6000) {
+		n += (int)pool.read(rx.get(), &dsts, 4096);
+	}
+	ES_ASSERT(dsts[0] != null && dsts[1] != null && dsts[3] == null);
+	LOG("%s", pool.toString().c_str());
+}
+
+static void test_composite_buffer() {
+	// a frame of a length-prefixed header and two payload slices
+	const char* line = "GET / HTTP/1.1\r";
+	const char* rest = "\nHost: localhost\r\n\r\n";
+	int payload = (int)(strlen(line) + strlen(rest));
+	sp<EIOByteBuffer> header = EIOByteBuffer::allocate(6);
+	header->putShort(0x4142)->putInt(payload)->flip();
+
+	ECompositeByteBuffer frame;
+	frame.addComponent(header);
+	frame.addComponent(line, strlen(line));
+	frame.addComponent(rest, strlen(rest));
+	ES_ASSERT(frame.numComponents() == 3);
+	ES_ASSERT(frame.capacity() == 6 + payload);
+
+	// reads and searches across the boundaries
+	ES_ASSERT(frame.getInt(2) == payload);
+	ES_ASSERT(frame.indexOf("\r\n", 2) == 6 + (int)strlen(line) - 1);
+	ES_ASSERT(frame.indexOf("\r\n\r\n", 4) == frame.limit() - 4);
+	ES_ASSERT(frame.indexOf((byte)'H') == 6 + 6);
+	short magic = frame.getShort();
+	int length = frame.getInt();
+	ES_ASSERT(magic == 0x4142 && length == payload);
+	frame.rewind();
+
+	// writes into the components' memory
+	char copy[64];
+	strcpy(copy, line);
+	ECompositeByteBuffer patched;
+	patched.addComponent(copy, 4)->addComponent(copy + 4, strlen(line) - 4);
+	patched.position(2)->put("XYZ", 3);
+	ES_ASSERT(memcmp(copy, "GEXYZ", 5) == 0);
+
+	// one gathering write to a socket channel
+	sp<EServerSocketChannel> ssc(EServerSocketChannel::open());
+	EInetSocketAddress any("127.0.0.1", 0);
+	ssc->bind(&any);
+	EInetSocketAddress isa("127.0.0.1", ssc->socket()->getLocalPort());
+	sp<ESocketChannel> tx(ESocketChannel::open(&isa));
+	sp<ESocketChannel> rx(ssc->accept());
+	while (frame.hasRemaining()) {
+		frame.write(tx.get());
+	}
+	EIOByteBuffer received(frame.capacity());
+	while (received.hasRemaining()) {
+		rx->read(&received);
+	}
+	ES_ASSERT(received.getInt(2) == payload);
+	ES_ASSERT(memcmp((char*)received.address() + 6, line, strlen(line)) == 0);
+	ES_ASSERT(memcmp((char*)received.address() + 6 + strlen(line), rest, strlen(rest)) == 0);
+
+	frame.discardReadComponents();
+	ES_ASSERT(frame.numComponents() == 0 && frame.capacity() == 0);
+	LOG("%s", frame.toString().c_str());
+}
+
+static void test_domain_socket() {
+	const char* path = "/tmp/testnio.sock";
+
+	for (int seqpacket = 0; seqpacket < 2; seqpacket++) {
+		sp<EDomainServerSocketChannel> server(EDomainServerSocketChannel::open(seqpacket));
+		server->bind(path);
+		server->configureBlocking(false);
+		ESelector* selector = ESelector::open();
+		server->register_(selector, ESelectionKey::OP_ACCEPT);
+
+		sp<EDomainSocketChannel> client(EDomainSocketChannel::open(path, seqpacket));
+		sp<EDomainSocketChannel> peer;
+
+		// a gathering write passing the write end of a pipe
+		int pfd[2];
+		int rc = ::pipe(pfd);
+		ES_ASSERT(rc == 0);
+		EIOByteBuffer hello(5), world(6);
+		hello.put("hello", 5)->flip();
+		world.put(" world", 6)->flip();
+		EA<EIOByteBuffer*> srcs(2, false);
+		srcs[0] = &hello;
+		srcs[1] = &world;
+		EA<int> fds(1);
+		fds[0] = pfd[1];
+		long written = client->write(&srcs, 0, 2, &fds);
+		ES_ASSERT(written == 11);
+		EIOByteBuffer again(3);
+		again.put("!!!", 3)->flip();
+		client->write(&again);
+
+		// accepted and read in the same selector loop
+		EIOByteBuffer first(4), rest(60);
+		EA<EIOByteBuffer*> dsts(2, false);
+		dsts[0] = &first;
+		dsts[1] = &rest;
+		// longer than the descriptors one message can carry
+		EA<int> received(EDomainSocketChannel::MAX_FDS + 3);
+		long n = 0;
+		while (n == 0) {
+			selector->select();
+			sp<EIterator<sp<ESelectionKey> > > iterator = selector->selectedKeys()->iterator();
+			while (iterator->hasNext()) {
+				sp<ESelectionKey> key = iterator->next();
+				iterator->remove();
+				if (key->isAcceptable()) {
+					peer = server->accept();
+					peer->configureBlocking(false);
+					peer->register_(selector, ESelectionKey::OP_READ);
+				} else if (key->isReadable()) {
+					n = peer->read(&dsts, 0, 2, &received);
+				}
+			}
+		}
+		ES_ASSERT(first.position() == 4 && memcmp(first.address(), "hell", 4) == 0);
+		ES_ASSERT(received[0] >= 0 && received[0] != pfd[1] && received[1] == -1);
+		if (seqpacket) {
+			// one message per read
+			ES_ASSERT(n == 11);
+		}
+
+		// the descriptor received writes to the same pipe
+		rc = ::write(received[0], "x", 1);
+		ES_ASSERT(rc == 1);
+		char c = 0;
+		rc = ::read(pfd[0], &c, 1);
+		ES_ASSERT(rc == 1 && c == 'x');
+		::close(received[0]);
+		::close(pfd[0]);
+		::close(pfd[1]);
+
+		// message rate of small writes and reads, blocking
+		selector->close();
+		delete selector;
+		peer->configureBlocking(true);
+		EIOByteBuffer msg(64), in(64);
+		int left = seqpacket ? 3 : (int)(14 - n);
+		while (in.position() < left) {
+			peer->read(&in);
+		}
+		int N = 100000;
+		llong t1 = ESystem::currentTimeMillis();
+		for (int i = 0; i < N; i++) {
+			msg.clear();
+			client->write(&msg);
+			in.clear();
+			while (in.hasRemaining()) {
+				peer->read(&in);
+			}
+		}
+		llong t2 = ESystem::currentTimeMillis();
+		LOG("%s: %lld msgs/s", client->toString().c_str(), (llong)N * 1000 / ES_MAX(t2 - t1, 1));
+
+		client->close();
+		peer->close();
+		server->close();
+	}
+	::unlink(path);
+}
+
 MAIN_IMPL(testnio) {
 	ESystem::init(argc, argv);
 
@@ -451,6 +1478,16 @@ MAIN_IMPL(testnio) {
 //		test_filechannel();
 //		test_nioudpserver();
 //		test_nioudpclient();
+//		test_iouring();
+//		test_selector_consumer();
+//		test_selector_wakeup();
+//		test_reactor_group();
+//		test_udp_batch();
+//		test_splice_proxy();
+//		test_zerocopy();
+//		test_buffer_pool();
+//		test_composite_buffer();
+//		test_domain_socket();
 
 		} while (1);
 	}